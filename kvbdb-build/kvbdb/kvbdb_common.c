@@ -78,6 +78,10 @@ int kvbdbGetInitialCursorBuffersCapacities(KVBdb * kvbdb, u_int32_t * pnKeyBuffe
 /* global static instance of BerkeleyDB dictionary*/
 std::mutex s_bdb_dict_mutex;
 static bdb_dict_t * s_bdb_dict_p = NULL;
+static std::atomic<bool> s_bdb_dict_ready(false);
+
+/* Write transactions committed by all connections, see SQLITE4_KVCTRL_DATA_VERSION */
+static std::atomic<unsigned long long> s_nDataVersion(0);
 
 /* 
 ** initialize the global static BerkeleyDB dictionary, 
@@ -87,12 +91,23 @@ static bdb_dict_t * s_bdb_dict_p = NULL;
 */
 int init_global_bdb_dict()
 {
+   // fast path, taken by every open once the dictionary exists,
+   // avoids the global mutex
+   if (s_bdb_dict_ready.load(std::memory_order_acquire))
+   {
+      return SQLITE4_OK;
+   }
+
    std::lock_guard<std::mutex> oGuard(s_bdb_dict_mutex);
 
    if (!s_bdb_dict_p)
    {
       // not initialized yet
       int ret = init_bdb_dict(&s_bdb_dict_p);
+      if (ret == SQLITE4_OK)
+      {
+         s_bdb_dict_ready.store(true, std::memory_order_release);
+      }
       return(ret);
    }
    else
@@ -137,6 +152,25 @@ int init_bdb_dict(bdb_dict_t ** a_bdb_dict_pp)
    }
 }
 
+/*
+** Return the shard of given bdb_dict_t
+** holding the node for given node_name
+** (FNV-1a hash of the name).
+*/
+static bdb_dict_shard_t * get_dict_shard
+                  ( bdb_dict_t * a_bdb_dict_p,
+                    const char * node_name )
+{
+   uint32_t h = 2166136261u;
+   const unsigned char * p = (const unsigned char *)node_name;
+   while (*p)
+   {
+      h ^= *p++;
+      h *= 16777619u;
+   }
+   return &(a_bdb_dict_p->shards[h % BDB_DICT_NSHARD]);
+}
+
 /*
 ** Acquire 
 ** (i.e. get existing or register and return new) 
@@ -156,15 +190,16 @@ bdb_dict_node_t * acquire_locked_dict_node
     assert(strlen(node_name) > 0);
     assert(strlen(node_name) < 127);
 
-    // lock dictionary 
-    // on dictionary's own mutex
-   a_bdb_dict_p->mutex.lock();
+    // lock the dictionary shard
+    // holding node_name
+    bdb_dict_shard_t * pShard = get_dict_shard(a_bdb_dict_p, node_name);
+   pShard->mutex.lock();
     
     // initialize ptr to dict node
-    bdb_dict_node_t * pCurrDictNode = a_bdb_dict_p->nodes;
+    bdb_dict_node_t * pCurrDictNode = pShard->nodes;
     
     // initialize target ptr-to-ptr / insertion point 
-    bdb_dict_node_t ** pInsertionPoint = &(a_bdb_dict_p->nodes);
+    bdb_dict_node_t ** pInsertionPoint = &(pShard->nodes);
     
     // search among existing nodes
     while(pCurrDictNode)
@@ -192,7 +227,7 @@ bdb_dict_node_t * acquire_locked_dict_node
        pCurrDictNode->mutex.lock();
 
        // unlock dictionary
-       a_bdb_dict_p->mutex.unlock();
+       pShard->mutex.unlock();
 
        return pCurrDictNode;
     }
@@ -209,7 +244,7 @@ bdb_dict_node_t * acquire_locked_dict_node
        //printf("acquire_locked_dict_node() : cannot allocate new bdb_dict_node_t\n");
 
        // unlock dictionary
-       a_bdb_dict_p->mutex.unlock();
+       pShard->mutex.unlock();
 
        return 0;
     }
@@ -225,7 +260,7 @@ bdb_dict_node_t * acquire_locked_dict_node
    pNew->mutex.lock();
 	
 	// unlock dictionary
-   a_bdb_dict_p->mutex.unlock();
+   pShard->mutex.unlock();
     
     return pNew;
 }
@@ -270,15 +305,16 @@ bdb_dict_node_t * get_locked_existing_dict_node_or_null
     assert(strlen(node_name) > 0);
     assert(strlen(node_name) < 127);
 
-    // lock dictionary 
-    // on dictionary's own mutex
-   a_bdb_dict_p->mutex.lock();
+    // lock the dictionary shard
+    // holding node_name
+    bdb_dict_shard_t * pShard = get_dict_shard(a_bdb_dict_p, node_name);
+   pShard->mutex.lock();
     
     // initialize ptr to dict node
-    bdb_dict_node_t * pCurrDictNode = a_bdb_dict_p->nodes;
+    bdb_dict_node_t * pCurrDictNode = pShard->nodes;
     
     // initialize target ptr-to-ptr / insertion point 
-    bdb_dict_node_t ** pInsertionPoint = &(a_bdb_dict_p->nodes);
+    bdb_dict_node_t ** pInsertionPoint = &(pShard->nodes);
     
     // search among existing nodes
     while(pCurrDictNode)
@@ -306,7 +342,7 @@ bdb_dict_node_t * get_locked_existing_dict_node_or_null
        pCurrDictNode->mutex.lock();
 
        // unlock dictionary
-       a_bdb_dict_p->mutex.unlock();
+       pShard->mutex.unlock();
 
        return pCurrDictNode;
     }
@@ -314,7 +350,7 @@ bdb_dict_node_t * get_locked_existing_dict_node_or_null
     // not found
 	
 	// unlock dictionary
-   a_bdb_dict_p->mutex.unlock();
+   pShard->mutex.unlock();
 		
     return NULL;
 }
@@ -430,6 +466,474 @@ int unlock_kvbdb_config(kvbdb_config_t * a_kvbdb_config_p)
 }
 
 
+// Cursor pool -- begin ---------------------------------------------
+
+/*
+** Capacity for a new key or data buffer of a cursor: 
+** the configured initial capacity until anything has been read, 
+** then the smallest power of 2, not below 64, 
+** holding the largest item read so far.
+*/
+static u_int32_t kvbdbBufferCapacity(u_int32_t nSeen, u_int32_t nInitial)
+{
+   u_int32_t nCapacity = 64;
+   if (nSeen == 0)
+   {
+      return nInitial;
+   }
+   while (nCapacity < nSeen && nCapacity < 0x80000000)
+   {
+      nCapacity *= 2;
+   }
+   return nCapacity;
+} // end of kvbdbBufferCapacity(...){...}
+
+/*
+** Record the sizes of the key and data just cached by cursor pCur.
+*/
+static void kvbdbNoteCachedSizes(KVBdb * p, KVBdbCursor * pCur)
+{
+   if (pCur->nCachedKeySize > p->nKeySizeSeen)
+   {
+      p->nKeySizeSeen = pCur->nCachedKeySize;
+   }
+   if (pCur->nCachedDataSize > p->nDataSizeSeen)
+   {
+      p->nDataSizeSeen = pCur->nCachedDataSize;
+   }
+} // end of kvbdbNoteCachedSizes(...){...}
+
+/*
+** Take a cursor object from the free list, keeping its buffers, 
+** or allocate a new one. All other fields are zeroed.
+** Returns NULL if out of memory.
+*/
+static KVBdbCursor * kvbdbAllocCursor(KVBdb * p)
+{
+   KVBdbCursor * pCsr = p->pFreeCsr;
+   if (pCsr != NULL)
+   {
+      void * pCachedKey = pCsr->pCachedKey;
+      u_int32_t nCachedKeyCapacity = pCsr->nCachedKeyCapacity;
+      void * pCachedData = pCsr->pCachedData;
+      u_int32_t nCachedDataCapacity = pCsr->nCachedDataCapacity;
+
+      p->pFreeCsr = pCsr->pNextFree;
+      p->nFreeCsr -= 1;
+      memset(pCsr, 0, sizeof(KVBdbCursor));
+      pCsr->pCachedKey = pCachedKey;
+      pCsr->nCachedKeyCapacity = nCachedKeyCapacity;
+      pCsr->pCachedData = pCachedData;
+      pCsr->nCachedDataCapacity = nCachedDataCapacity;
+   }
+   else
+   {
+      pCsr = (KVBdbCursor*)sqlite4_malloc(p->base.pEnv, sizeof(KVBdbCursor));
+      if (pCsr != NULL)
+      {
+         memset(pCsr, 0, sizeof(KVBdbCursor));
+      }
+   }
+   return pCsr;
+} // end of kvbdbAllocCursor(...){...}
+
+/*
+** Free a key or data buffer of a cursor if it is over 4 times 
+** the capacity a new one would get, see kvbdbBufferCapacity().
+*/
+static void kvbdbTrimBuffer(void ** ppBuf, u_int32_t * pnCapacity, u_int32_t nSeen, u_int32_t nInitial)
+{
+   if (*ppBuf != NULL && *pnCapacity / 4 > kvbdbBufferCapacity(nSeen, nInitial))
+   {
+      free(*ppBuf);
+      *ppBuf = NULL;
+      *pnCapacity = 0;
+   }
+} // end of kvbdbTrimBuffer(...){...}
+
+/*
+** Put a closed cursor on the free list, with its buffers 
+** trimmed to the sizes seen so far, or free it if the list is full.
+*/
+static void kvbdbReleaseCursor(KVBdb * p, KVBdbCursor * pCsr)
+{
+   pCsr->iMagicKVBdbCur = 0;
+   pCsr->nHasKeyAndDataCached = 0;
+   pCsr->nCachedKeySize = 0;
+   pCsr->nCachedDataSize = 0;
+   if (p->nFreeCsr < SQLITE4_KV_BDB_MAX_FREE_CURSOR)
+   {
+      kvbdbTrimBuffer(&pCsr->pCachedKey, &pCsr->nCachedKeyCapacity, p->nKeySizeSeen, p->nInitialCursorKeyBufferCapacity);
+      kvbdbTrimBuffer(&pCsr->pCachedData, &pCsr->nCachedDataCapacity, p->nDataSizeSeen, p->nInitialCursorDataBufferCapacity);
+      pCsr->pNextFree = p->pFreeCsr;
+      p->pFreeCsr = pCsr;
+      p->nFreeCsr += 1;
+   }
+   else
+   {
+      free(pCsr->pCachedKey);
+      free(pCsr->pCachedData);
+      sqlite4_free(p->base.pEnv, pCsr);
+   }
+} // end of kvbdbReleaseCursor(...){...}
+
+/*
+** Free all cursors on the free list.
+*/
+static void kvbdbFreeCursorPool(KVBdb * p)
+{
+   while (p->pFreeCsr != NULL)
+   {
+      KVBdbCursor * pCsr = p->pFreeCsr;
+      p->pFreeCsr = pCsr->pNextFree;
+      free(pCsr->pCachedKey);
+      free(pCsr->pCachedData);
+      sqlite4_free(p->base.pEnv, pCsr);
+   }
+   p->nFreeCsr = 0;
+} // end of kvbdbFreeCursorPool(...){...}
+
+// Cursor pool -- end -----------------------------------------------
+
+// Partitions -- begin ----------------------------------------------
+
+/*
+** Translate a BerkeleyDB error code, returned by a cursor operation,
+** into a SQLite error code.
+*/
+static int kvbdbCursorErrorCode(int ret)
+{
+   switch (ret)
+   {
+   case 0:
+      return SQLITE4_OK;
+   case DB_NOTFOUND:
+   case DB_KEYEMPTY:
+   case DB_SECONDARY_BAD:
+      return SQLITE4_NOTFOUND;
+   case DB_LOCK_DEADLOCK:
+   case DB_LOCK_NOTGRANTED:
+   case DB_REP_HANDLE_DEAD:
+   case DB_REP_LEASE_EXPIRED:
+   case DB_REP_LOCKOUT:
+      return SQLITE4_LOCKED; // or: SQLITE4_BUSY
+   case EINVAL:
+      return SQLITE4_MISUSE; // Library used incorrectly
+   default:
+      return SQLITE4_ERROR;
+   }
+} // end of kvbdbCursorErrorCode(...){...}
+
+/*
+** Begin the DB_TXN_SNAPSHOT transaction for reads in MVCC mode,
+** unless already begun.
+** Returns a BerkeleyDB error code.
+*/
+static int kvbdbBeginReadTxn(KVBdb * p)
+{
+   int ret = 0;
+   if (p->pReadTxn == NULL)
+   {
+      ret = p->envp->txn_begin(p->envp, NULL, &p->pReadTxn, DB_TXN_SNAPSHOT);
+   }
+   return ret;
+} // end of kvbdbBeginReadTxn(...){...}
+
+/*
+** Return the index root of a key, i.e. the value of the varint 
+** the key starts with, decoded as sqlite4GetVarint64() does 
+** (which is not exported by SQLite4).
+** A key too short for its varint, 
+** such as { 0xFF, 0xFF } sought by OP_NewIdxid, 
+** is taken to sort after every partition.
+*/
+static u64 kvbdbKeyRoot(const KVByteArray * aKey, KVSize nKey)
+{
+   u64 iRoot = 0;
+   int i;
+
+   if (nKey < 1)
+   {
+      return 0;
+   }
+   if (aKey[0] <= 240)
+   {
+      return aKey[0];
+   }
+   if (aKey[0] <= 248)
+   {
+      if (nKey < 2)
+      {
+         return ~(u64)0;
+      }
+      return (aKey[0] - 241) * 256 + aKey[1] + 240;
+   }
+   if (nKey < aKey[0] - 246)
+   {
+      return ~(u64)0;
+   }
+   if (aKey[0] == 249)
+   {
+      return 2288 + 256 * aKey[1] + aKey[2];
+   }
+   for (i = 1; i < aKey[0] - 246; ++i)
+   {
+      iRoot = (iRoot << 8) + aKey[i];
+   }
+   return iRoot;
+} // end of kvbdbKeyRoot(...){...}
+
+/*
+** Create and open the partition for index root iRoot
+** of the database of given dictionary node,
+** which must be locked by the caller.
+** An in-memory database has in-memory partitions named "NAME.ROOT",
+** an on-disk one keeps each in a file of that name.
+** Returns a BerkeleyDB error code.
+*/
+static int kvbdbOpenPartitionDB(bdb_dict_node_t * pNode, u64 iRoot, DB ** pdbp)
+{
+   char zPart[160];
+   DB * dbp = NULL;
+   int ret;
+
+   sprintf(zPart, "%s.%llu", pNode->name, (unsigned long long)iRoot);
+
+   ret = db_create(&dbp, pNode->envp, 0);
+   if (ret == 0 && pNode->bPartInMemory)
+   {
+      // Keep Temporary Overflow Pages in Memory, as for the main database
+      DB_MPOOLFILE * mpf = dbp->get_mpf(dbp);
+      ret = mpf->set_flags(mpf, DB_MPOOL_NOFILE, 1);
+   }
+   if (ret == 0)
+   {
+      // the partition is created outside of any transaction (DB_AUTO_COMMIT), 
+      // as its handle is shared by all connections
+      ret = dbp->open(dbp,
+         NULL,
+         pNode->bPartInMemory ? NULL : zPart,  /* File name */
+         pNode->bPartInMemory ? zPart : NULL,  /* Logical db name */
+         DB_BTREE,
+         pNode->nPartOpenFlags,
+         0);
+   }
+   if (ret != 0 && dbp != NULL)
+   {
+      dbp->close(dbp, 0);
+      dbp = NULL;
+   }
+   *pdbp = dbp;
+   return ret;
+} // end of kvbdbOpenPartitionDB(...){...}
+
+/*
+** Find the partition of p for index root iRoot, 
+** creating it if bCreate is true.
+** *pdbp is set to NULL, if the partition does not exist.
+** Partitions are created once per database and shared
+** via its dictionary node; each connection caches those
+** it has used in KVBdb.apPart[], so that the node's mutex
+** is only taken on a connection's first use of a partition.
+*/
+static int kvbdbPartition(KVBdb * p, u64 iRoot, int bCreate, DB ** pdbp)
+{
+   bdb_dict_node_t * pNode = p->pDictNode;
+   DB * dbp = NULL;
+   int rc = SQLITE4_OK;
+
+   if (iRoot < p->nPart && p->apPart[iRoot] != NULL)
+   {
+      *pdbp = p->apPart[iRoot];
+      return SQLITE4_OK;
+   }
+
+   pNode->mutex.lock();
+   if (iRoot < pNode->nPart)
+   {
+      dbp = pNode->apPart[iRoot];
+   }
+   if (dbp == NULL && bCreate)
+   {
+      if (iRoot >= SQLITE4_KV_BDB_MAX_PARTITION)
+      {
+         rc = SQLITE4_FULL;
+      }
+      else if (iRoot >= pNode->nPart)
+      {
+         uint32_t nNew = pNode->nPart * 2;
+         if (nNew <= iRoot)
+         {
+            nNew = (uint32_t)iRoot + 1;
+         }
+         DB ** apNew = (DB**)realloc(pNode->apPart, nNew * sizeof(DB*));
+         if (apNew == NULL)
+         {
+            rc = SQLITE4_NOMEM;
+         }
+         else
+         {
+            memset(&apNew[pNode->nPart], 0, (nNew - pNode->nPart) * sizeof(DB*));
+            pNode->apPart = apNew;
+            pNode->nPart = nNew;
+         }
+      }
+      if (rc == SQLITE4_OK)
+      {
+         int ret = kvbdbOpenPartitionDB(pNode, iRoot, &dbp);
+         if (ret != 0)
+         {
+            //printf("Error opening partition %llu of database '%s': %s\n", iRoot, pNode->name, db_strerror(ret));
+            rc = SQLITE4_ERROR;
+         }
+         else
+         {
+            pNode->apPart[iRoot] = dbp;
+         }
+      }
+   }
+   pNode->mutex.unlock();
+
+   if (dbp != NULL && iRoot < SQLITE4_KV_BDB_MAX_PARTITION)
+   {
+      // cache the partition for this connection
+      if (iRoot >= p->nPart)
+      {
+         u_int32_t nNew = p->nPart * 2;
+         if (nNew <= iRoot)
+         {
+            nNew = (u_int32_t)iRoot + 1;
+         }
+         DB ** apNew = (DB**)sqlite4_realloc(p->base.pEnv, p->apPart, nNew * sizeof(DB*));
+         if (apNew != NULL)
+         {
+            memset(&apNew[p->nPart], 0, (nNew - p->nPart) * sizeof(DB*));
+            p->apPart = apNew;
+            p->nPart = nNew;
+         }
+      }
+      if (iRoot < p->nPart)
+      {
+         p->apPart[iRoot] = dbp;
+      }
+   }
+
+   *pdbp = dbp;
+   return rc;
+} // end of kvbdbPartition(...){...}
+
+/*
+** Find the nearest existing partition after (bForward) 
+** or before index root iRoot.
+** Returns SQLITE4_NOTFOUND if there is none.
+*/
+static int kvbdbAdjacentPartition(KVBdb * p, u64 iRoot, int bForward, u64 * piRoot, DB ** pdbp)
+{
+   bdb_dict_node_t * pNode = p->pDictNode;
+   DB * dbp = NULL;
+   u64 i;
+
+   pNode->mutex.lock();
+   if (bForward)
+   {
+      for (i = iRoot + 1; iRoot < pNode->nPart && i < pNode->nPart; ++i)
+      {
+         if ((dbp = pNode->apPart[i]) != NULL) break;
+      }
+   }
+   else
+   {
+      for (i = (iRoot < pNode->nPart ? iRoot : pNode->nPart); i > 0; --i)
+      {
+         if ((dbp = pNode->apPart[i - 1]) != NULL)
+         {
+            --i;
+            break;
+         }
+      }
+   }
+   pNode->mutex.unlock();
+
+   if (dbp == NULL)
+   {
+      return SQLITE4_NOTFOUND;
+   }
+   *piRoot = i;
+   *pdbp = dbp;
+   return SQLITE4_OK;
+} // end of kvbdbAdjacentPartition(...){...}
+
+/*
+** Make the BerkeleyDB cursor of pCur a cursor on partition dbp, 
+** of index root iRoot, unless it already is one.
+** Returns a BerkeleyDB error code.
+*/
+static int kvbdbPartitionCursor(KVBdbCursor * pCur, DB * dbp, u64 iRoot)
+{
+   int ret = 0;
+
+   if (pCur->pCsr != NULL)
+   {
+      if (pCur->iPart == iRoot)
+      {
+         return 0;
+      }
+      DBC * pOldCsr = pCur->pCsr;
+      pCur->pCsr = NULL;
+      pOldCsr->close(pOldCsr);
+   }
+
+   DBC * pNewCsr = NULL;
+   ret = dbp->cursor(dbp, pCur->pCsrTxn, &pNewCsr, pCur->nCsrFlags);
+   if (ret == 0)
+   {
+      pCur->pCsr = pNewCsr;
+      pCur->iPart = iRoot;
+   }
+   return ret;
+} // end of kvbdbPartitionCursor(...){...}
+
+/*
+** Move pCur to the first (bForward) or last entry 
+** of the nearest non-empty partition after, or before, index root iRoot.
+** Returns SQLITE4_NOTFOUND if there is none.
+*/
+static int kvbdbPartitionStep(KVBdbCursor * pCur, u64 iRoot, int bForward)
+{
+   int rc = SQLITE4_OK;
+
+   for (;;)
+   {
+      DB * dbp = NULL;
+      rc = kvbdbAdjacentPartition(pCur->pOwner, iRoot, bForward, &iRoot, &dbp);
+      if (rc != SQLITE4_OK)
+      {
+         break;
+      }
+      int ret = kvbdbPartitionCursor(pCur, dbp, iRoot);
+      if (ret == 0)
+      {
+         DBT keyDBT;
+         DBT dataDBT;
+         memset(&keyDBT, 0, sizeof(DBT));
+         memset(&dataDBT, 0, sizeof(DBT));
+         ret = pCur->pCsr->get(pCur->pCsr,
+            &keyDBT, &dataDBT, (bForward ? DB_FIRST : DB_LAST) | DB_READ_COMMITTED);
+      }
+      if (ret != DB_NOTFOUND)
+      {
+         // positioned, or failed
+         rc = kvbdbCursorErrorCode(ret);
+         break;
+      }
+      // empty partition -- skip it
+   }
+   return rc;
+} // end of kvbdbPartitionStep(...){...}
+
+// Partitions -- end ------------------------------------------------
+
+
 // API impl -- begin ------------------------------------------------
 /*
 ** Implementation of the xReplace(X, aKey, nKey, aData, nData) method.
@@ -487,6 +991,13 @@ int kvbdbReplace(
    }
    // Cross-checks -- end
 
+   if (rc == SQLITE4_OK && p->bPartition)
+   {
+      // write to the partition of the key's index root, 
+      // creating it, if it is the first write there
+      rc = kvbdbPartition(p, kvbdbKeyRoot(aKey, nKey), 1, &dbp);
+   }
+
    if (rc == SQLITE4_OK)
    {
       // So far OK
@@ -542,6 +1053,65 @@ int kvbdbReplace(
    return rc;
 } // end of kvbdbReplace(...){...}
 
+  /*
+  ** Open the cursor for read-only ops, i.e. KVBdb.pCsr.
+  ** By default the cursor has no transaction and reads
+  ** with degree 2 isolation, taking page locks.
+  ** In MVCC mode the cursor belongs to a DB_TXN_SNAPSHOT transaction,
+  ** KVBdb.pReadTxn, begun by the first read of a SQLite transaction
+  ** and ended with it, so reads are served from a consistent snapshot
+  ** and never wait for, nor block, writers.
+  */
+static int kvbdbOpenReadCursor(KVBdb * p, DBC ** ppCsr)
+{
+   DB * dbp = p->dbp;
+   int ret = 0;
+
+   if (p->bMvcc)
+   {
+      ret = kvbdbBeginReadTxn(p);
+      if (ret == 0)
+      {
+         ret = dbp->cursor(dbp, p->pReadTxn, ppCsr, DB_TXN_SNAPSHOT);
+      }
+   }
+   else
+   {
+      ret = dbp->cursor(dbp, NULL, ppCsr, DB_READ_COMMITTED);
+   }
+   return ret;
+} // end of kvbdbOpenReadCursor(...){...}
+
+  /*
+  ** Close the cursor for read-only ops, if any,
+  ** and end its snapshot transaction, if any.
+  ** Returns a BerkeleyDB error code.
+  */
+static int kvbdbCloseReadCursor(KVBdb * p)
+{
+   int ret = 0;
+
+   if (p->pCsr != NULL)
+   {
+      DBC * pCsr = p->pCsr;
+      p->pCsr = NULL;
+      ret = pCsr->close(pCsr);
+   }
+   if (p->pReadTxn != NULL)
+   {
+      // a snapshot transaction only reads, 
+      // so there is nothing to make durable
+      DB_TXN * pReadTxn = p->pReadTxn;
+      p->pReadTxn = NULL;
+      int ret1 = pReadTxn->commit(pReadTxn, DB_TXN_NOSYNC);
+      if (ret == 0)
+      {
+         ret = ret1;
+      }
+   }
+   return ret;
+} // end of kvbdbCloseReadCursor(...){...}
+
   /*
   ** Create a new cursor object.
   */
@@ -557,7 +1127,7 @@ int kvbdbOpenCursor(KVStore *pKVStore, KVCursor **ppKVCursor) {
    int rc = SQLITE4_OK;
 
    KVBdbCursor * pCsr = NULL;
-   pCsr = (KVBdbCursor*)sqlite4_malloc(pKVStore->pEnv, sizeof(KVBdbCursor));
+   pCsr = kvbdbAllocCursor(p); // from the free list, or sqlite4_malloc'ed
    if (pCsr == 0)
    {
       // sqlite4_malloc failed
@@ -565,8 +1135,7 @@ int kvbdbOpenCursor(KVStore *pKVStore, KVCursor **ppKVCursor) {
    }
    else
    {
-      // sqlite4_malloc succeeded
-      memset(pCsr, 0, sizeof(KVBdbCursor));
+      // succeeded
       // retrieve necessary BerkeleyDB objects -- begin
       DB_ENV * envp = p->envp;
       assert(envp != NULL);
@@ -577,14 +1146,31 @@ int kvbdbOpenCursor(KVStore *pKVStore, KVCursor **ppKVCursor) {
       // retrieve necessary BerkeleyDB objects -- end
       DBC * pNewBerkeleyDBCursor = NULL;
       int ret = 0;
-      if (nCurrTxnLevel == 0)
+      if (p->bPartition)
+      {
+         // The BerkeleyDB cursor is opened by the first seek, 
+         // on the partition sought, see kvbdbPartitionSeek(), 
+         // in the transaction the other modes would use for it.
+         pCsr->nCsrFlags = DB_READ_COMMITTED;
+         if (pCurrTxn != NULL)
+         {
+            pCsr->pCsrTxn = pCurrTxn;
+         }
+         else if (p->bMvcc)
+         {
+            ret = kvbdbBeginReadTxn(p);
+            pCsr->pCsrTxn = p->pReadTxn;
+            pCsr->nCsrFlags = DB_TXN_SNAPSHOT;
+         }
+      } // end of if (p->bPartition){...}
+      else if (nCurrTxnLevel == 0)
       {
          pNewBerkeleyDBCursor = p->pCsr;
 
          if (pNewBerkeleyDBCursor == NULL)
          {
             // (re-)open a cursor for read-only ops
-            ret = dbp->cursor(dbp, NULL, &pNewBerkeleyDBCursor, DB_READ_COMMITTED);
+            ret = kvbdbOpenReadCursor(p, &pNewBerkeleyDBCursor);
             if (ret == 0)
             {
                // success
@@ -603,7 +1189,7 @@ int kvbdbOpenCursor(KVStore *pKVStore, KVCursor **ppKVCursor) {
             if (pNewBerkeleyDBCursor == NULL)
             {
                // (re-)open a cursor for read-only ops
-               ret = dbp->cursor(dbp, NULL, &pNewBerkeleyDBCursor, DB_READ_COMMITTED);
+               ret = kvbdbOpenReadCursor(p, &pNewBerkeleyDBCursor);
                if (ret == 0)
                {
                   // success 
@@ -642,13 +1228,12 @@ int kvbdbOpenCursor(KVStore *pKVStore, KVCursor **ppKVCursor) {
          pCsr->pOwner = p; // ptr to the underlying KVStore, i.e. to the structure KVBdb
          pCsr->pCsr = pNewBerkeleyDBCursor; // the underlying BerkeleyDB cursor
                                             // Cached Key & Data Buffers -- begin
+         // (pCachedKey and pCachedData may be kept from a pooled cursor, 
+         // with their capacities, otherwise they are allocated by 
+         // the first kvbdbKey() or kvbdbData() call)
          pCsr->nHasKeyAndDataCached = 0;
-         pCsr->pCachedKey = NULL;
          pCsr->nCachedKeySize = 0;
-         pCsr->nCachedKeyCapacity = p->nInitialCursorKeyBufferCapacity;
-         pCsr->pCachedData = NULL;
          pCsr->nCachedDataSize = 0;
-         pCsr->nCachedDataCapacity = p->nInitialCursorDataBufferCapacity;
          // Cached Key & Data Buffers -- end
          //
          pCsr->iMagicKVBdbCur = SQLITE4_KVBDBCUR_MAGIC;
@@ -676,8 +1261,8 @@ int kvbdbOpenCursor(KVStore *pKVStore, KVCursor **ppKVCursor) {
    {
       if (rc != SQLITE4_NOMEM)
       {
-         // free the useless allocated memory
-         sqlite4_free(pKVStore->pEnv, pCsr);
+         // return the useless cursor to the free list
+         kvbdbReleaseCursor(p, pCsr);
       }
    }
    //KVBdbOpenCursor_nomem:
@@ -736,23 +1321,7 @@ int kvbdbCloseCursor(KVCursor *pKVCursor) {
 
    int rc = SQLITE4_OK;
 
-   // Cached Key & Data Buffers -- begin
-   if (pCur->pCachedKey != NULL)
-   {
-      free(pCur->pCachedKey);
-      pCur->pCachedKey = NULL;
-      pCur->nCachedKeySize = 0;
-      pCur->nCachedKeyCapacity = 0;
-   }
-   if (pCur->pCachedData != NULL)
-   {
-      free(pCur->pCachedData);
-      pCur->pCachedData = NULL;
-      pCur->nCachedDataSize = 0;
-      pCur->nCachedDataCapacity = 0;
-   }
-   pCur->nHasKeyAndDataCached = 0;
-   // Cached Key & Data Buffers -- end
+   // Cached Key & Data Buffers are kept for reuse, see kvbdbReleaseCursor()
 
    pCur->nIsEOF = 0; // EOF not encountered yet
    pCur->nLastSeekDir = SEEK_DIR_NONE;
@@ -763,6 +1332,13 @@ int kvbdbCloseCursor(KVCursor *pKVCursor) {
    DBC * pCurrBerkeleyDBCursor = pCur->pCsr;
    DBC * pCurrKVBdbBerkeleyDBReadOnlyCursor = p->pCsr;
 
+   if (pCurrBerkeleyDBCursor == NULL)
+   {
+      // partition mode : no partition sought yet
+      kvbdbReleaseCursor(p, pCur);
+      return SQLITE4_OK;
+   }
+
    if (pCurrBerkeleyDBCursor == pCurrKVBdbBerkeleyDBReadOnlyCursor)
    {
       assert(nCurrTxnLevel <= 1);
@@ -791,6 +1367,8 @@ int kvbdbCloseCursor(KVCursor *pKVCursor) {
       break;
    };
 
+   kvbdbReleaseCursor(p, pCur);
+
    return rc;
 } // end of kvbdbCloseCursor(...){...}
 
@@ -855,7 +1433,12 @@ int kvbdbNextEntry(KVCursor *pKVCursor) {
             break;
          case DB_NOTFOUND:
             rc = SQLITE4_NOTFOUND;
-            pCur->nIsEOF = 1; // true; // ???
+            if (p->bPartition)
+            {
+               // end of partition -- continue in the next one
+               rc = kvbdbPartitionStep(pCur, pCur->iPart, 1);
+            }
+            pCur->nIsEOF = (rc != SQLITE4_OK); // true; // ???
             break;
          case DB_LOCK_DEADLOCK:
          case DB_LOCK_NOTGRANTED:
@@ -951,7 +1534,12 @@ int kvbdbPrevEntry(KVCursor *pKVCursor) {
             break;
          case DB_NOTFOUND:
             rc = SQLITE4_NOTFOUND;
-            pCur->nIsEOF = 1; // true; // ???
+            if (p->bPartition)
+            {
+               // end of partition -- continue in the previous one
+               rc = kvbdbPartitionStep(pCur, pCur->iPart, 0);
+            }
+            pCur->nIsEOF = (rc != SQLITE4_OK); // true; // ???
             break;
          case DB_LOCK_DEADLOCK:
          case DB_LOCK_NOTGRANTED:
@@ -1532,6 +2120,68 @@ int kvbdbSeekGE(
    return rc;
 } // end of kvbdbSeekGE(...){...}
 
+  /*
+  ** Seek a cursor in partition mode.
+  ** The seek is done in the partition of the key's index root, 
+  ** an inexact seek continuing in the adjacent partitions, 
+  ** if there is no match there.
+  */
+static int kvbdbPartitionSeek(
+   KVBdbCursor * pCur,
+   const KVByteArray *aKey,
+   KVSize nKey,
+   int direction)
+{
+   u64 iRoot = kvbdbKeyRoot(aKey, nKey);
+   DB * dbp = NULL;
+   int rc = kvbdbPartition(pCur->pOwner, iRoot, 0, &dbp);
+
+   if (rc == SQLITE4_OK)
+   {
+      rc = SQLITE4_NOTFOUND;
+      if (dbp != NULL)
+      {
+         int ret = kvbdbPartitionCursor(pCur, dbp, iRoot);
+         if (ret != 0)
+         {
+            rc = kvbdbCursorErrorCode(ret);
+         }
+         else
+         {
+            DBT keyDBT; // dont allocate keyDBT on a heap
+            memset(&keyDBT, 0, sizeof(DBT));
+            keyDBT.data = (void*)aKey;
+            keyDBT.size = nKey;
+            if (direction == 0)
+            {
+               rc = kvbdbSeekEQ(pCur->pCsr, &keyDBT, &pCur->nIsEOF);
+            }
+            else if (direction < 0)
+            {
+               rc = kvbdbSeekLE(pCur->pCsr, &keyDBT, &pCur->nIsEOF);
+            }
+            else
+            {
+               rc = kvbdbSeekGE(pCur->pCsr, &keyDBT, &pCur->nIsEOF);
+            }
+         }
+      }
+      if (rc == SQLITE4_NOTFOUND && direction != 0)
+      {
+         // nothing LE/GE the key in its partition, 
+         // take the last/first entry of the nearest non-empty one
+         rc = kvbdbPartitionStep(pCur, iRoot, direction > 0);
+         if (rc == SQLITE4_OK)
+         {
+            rc = SQLITE4_INEXACT;
+         }
+      }
+   }
+
+   pCur->nIsEOF = (rc != SQLITE4_OK && rc != SQLITE4_INEXACT);
+   return rc;
+} // end of kvbdbPartitionSeek(...){...}
+
 int kvbdbSeek(
    KVCursor *pKVCursor,
    const KVByteArray *aKey,
@@ -1583,8 +2233,8 @@ int kvbdbSeek(
       rc = SQLITE4_INTERNAL; // or: SQLITE4_MISUSE
    }
 
-   assert(pCurrBerkeleyDBCursor != NULL);
-   if (pCurrBerkeleyDBCursor == NULL)
+   assert(pCurrBerkeleyDBCursor != NULL || p->bPartition);
+   if (pCurrBerkeleyDBCursor == NULL && !p->bPartition)
    {
       //printf("Internal Error : pCurrBerkeleyDBCursor == NULL\n");
       rc = SQLITE4_INTERNAL; // or: SQLITE4_MISUSE
@@ -1600,6 +2250,17 @@ int kvbdbSeek(
    pCur->nIsEOF = 1; // pro-forma EOF
    pCur->nLastSeekDir = SEEK_DIR_NONE;
 
+   if (rc == SQLITE4_OK && p->bPartition)
+   {
+      rc = kvbdbPartitionSeek(pCur, aKey, nKey, direction);
+      if (rc == SQLITE4_OK || rc == SQLITE4_INEXACT)
+      {
+         pCur->nLastSeekDir = direction == 0 ? SEEK_DIR_EQ 
+            : (direction < 0 ? SEEK_DIR_LE : SEEK_DIR_GE);
+      }
+      return rc;
+   }
+
    // Prepare DBT's
    // At the moment it is not obvious/clear,
    // whether we sould use: 
@@ -1816,7 +2477,7 @@ int kvbdbKey(
       // for key and data
       if (pCur->pCachedKey == NULL)
       {
-         pCur->pCachedKey = malloc(p->nInitialCursorKeyBufferCapacity);
+         pCur->pCachedKey = malloc(kvbdbBufferCapacity(p->nKeySizeSeen, p->nInitialCursorKeyBufferCapacity));
          if (pCur->pCachedKey == NULL)
          {
             //printf("key: #3\n");
@@ -1824,12 +2485,12 @@ int kvbdbKey(
             goto label_nomem;
          }
          pCur->nCachedKeySize = 0;
-         pCur->nCachedKeyCapacity = p->nInitialCursorKeyBufferCapacity;
+         pCur->nCachedKeyCapacity = kvbdbBufferCapacity(p->nKeySizeSeen, p->nInitialCursorKeyBufferCapacity);
       }
 
       if (pCur->pCachedData == NULL)
       {
-         pCur->pCachedData = malloc(p->nInitialCursorDataBufferCapacity);
+         pCur->pCachedData = malloc(kvbdbBufferCapacity(p->nDataSizeSeen, p->nInitialCursorDataBufferCapacity));
          if (pCur->pCachedData == NULL)
          {
             //printf("key: #4\n");
@@ -1837,7 +2498,7 @@ int kvbdbKey(
             goto label_nomem;
          }
          pCur->nCachedDataSize = 0;
-         pCur->nCachedDataCapacity = p->nInitialCursorDataBufferCapacity;
+         pCur->nCachedDataCapacity = kvbdbBufferCapacity(p->nDataSizeSeen, p->nInitialCursorDataBufferCapacity);
       }
 
       // Try to retrieve <key, data>, re-allocate buffers if necessary -- begin
@@ -1865,6 +2526,7 @@ int kvbdbKey(
          pCur->pCachedData = dataDBT.data; // I know it's redundant.
          pCur->nCachedDataSize = dataDBT.size;
          pCur->nHasKeyAndDataCached = 1;
+         kvbdbNoteCachedSizes(p, pCur);
          // Cache data in pCur -- end
          //
          // Prepare return -- begin
@@ -2049,6 +2711,7 @@ int kvbdbKey(
                   pCur->pCachedData = dataDBT.data; // I know it's redundant.
                   pCur->nCachedDataSize = dataDBT.size;
                   pCur->nHasKeyAndDataCached = 1;
+                  kvbdbNoteCachedSizes(p, pCur);
                   // Cache data in pCur -- end
                   //
                   // Prepare return -- begin
@@ -2246,26 +2909,26 @@ int kvbdbData(
       // for key and data
       if (pCur->pCachedKey == NULL)
       {
-         pCur->pCachedKey = malloc(p->nInitialCursorKeyBufferCapacity);
+         pCur->pCachedKey = malloc(kvbdbBufferCapacity(p->nKeySizeSeen, p->nInitialCursorKeyBufferCapacity));
          if (pCur->pCachedKey == NULL)
          {
             rc = SQLITE4_NOMEM;
             goto label_nomem;
          }
          pCur->nCachedKeySize = 0;
-         pCur->nCachedKeyCapacity = p->nInitialCursorKeyBufferCapacity;
+         pCur->nCachedKeyCapacity = kvbdbBufferCapacity(p->nKeySizeSeen, p->nInitialCursorKeyBufferCapacity);
       }
 
       if (pCur->pCachedData == NULL)
       {
-         pCur->pCachedData = malloc(p->nInitialCursorDataBufferCapacity);
+         pCur->pCachedData = malloc(kvbdbBufferCapacity(p->nDataSizeSeen, p->nInitialCursorDataBufferCapacity));
          if (pCur->pCachedData == NULL)
          {
             rc = SQLITE4_NOMEM;
             goto label_nomem;
          }
          pCur->nCachedDataSize = 0;
-         pCur->nCachedDataCapacity = p->nInitialCursorDataBufferCapacity;
+         pCur->nCachedDataCapacity = kvbdbBufferCapacity(p->nDataSizeSeen, p->nInitialCursorDataBufferCapacity);
       }
 
       // Try to retrieve <key, data>, re-allocate buffers if necessary -- begin
@@ -2292,6 +2955,7 @@ int kvbdbData(
          pCur->pCachedData = dataDBT.data; // I know it's redundant.
          pCur->nCachedDataSize = dataDBT.size;
          pCur->nHasKeyAndDataCached = 1;
+         kvbdbNoteCachedSizes(p, pCur);
          // Cache data in pCur -- end
          //
          // Prepare return -- begin
@@ -2477,6 +3141,7 @@ int kvbdbData(
                   pCur->pCachedData = dataDBT.data; // I know it's redundant.
                   pCur->nCachedDataSize = dataDBT.size;
                   pCur->nHasKeyAndDataCached = 1;
+                  kvbdbNoteCachedSizes(p, pCur);
                   // Cache data in pCur -- end
                   //
                   // Prepare return -- begin
@@ -2654,13 +3319,20 @@ int kvbdbBegin(KVStore *pKVStore, int iLevel) {
    ** similar to what KVLsm is doing.
    */
 
-   if (p->pCsr == NULL) // no Cursor allocated for read-trans ops
+   /*
+   ** In MVCC mode the read cursor is not opened at level 0,
+   ** e.g. when kvbdbRollback() restarts at level 0,
+   ** as its snapshot would then be taken before,
+   ** and reused by, the next transaction.
+   */
+
+   if (p->pCsr == NULL // no Cursor allocated for read-trans ops
+      && (iLevel > 0 || !p->bMvcc))
    {
       DBC * pNewCursor = NULL;
       int ret = 0;
       assert(p->dbp);
-      DB * dbp = p->dbp;
-      ret = dbp->cursor(dbp, NULL, &pNewCursor, DB_READ_COMMITTED); // 1/ parentTxn == NULL 2/ or: DB_READ_COMMITTED | DB_CURSOR_BULK
+      ret = kvbdbOpenReadCursor(p, &pNewCursor); // 1/ parentTxn == NULL or snapshot txn 2/ or: DB_READ_COMMITTED | DB_CURSOR_BULK
       if (ret != 0)
       {
          // failed
@@ -2835,15 +3507,10 @@ int kvbdbBegin(KVStore *pKVStore, int iLevel) {
       if (pKVStore->iTransLevel == 0)
       {
          // "initial" transaction level
-         if (p->pCsr != NULL)
-         {
-            // if a Cursor 
-            // for read-only txn ops exists, 
-            // then close it.
-            DBC * pcsr = p->pCsr;
-            pcsr->close(pcsr);
-            p->pCsr = NULL;
-         }
+         // if a Cursor 
+         // for read-only txn ops exists, 
+         // then close it.
+         kvbdbCloseReadCursor(p);
       }
    }
    // Epilogue -- end
@@ -2988,6 +3655,16 @@ int kvbdbCommitPhaseTwo(KVStore *pKVStore, int iLevel) {
 }
 #endif
 
+/*
+** Count a write transaction commit of connection p,
+** see SQLITE4_KVCTRL_DATA_VERSION in kvbdbControl(...).
+*/
+static void kvbdbNoteCommit(KVBdb * p)
+{
+   s_nDataVersion.fetch_add(1);
+   p->nOwnCommit++;
+} // end of kvbdbNoteCommit(...){...}
+
 int kvbdbCommitPhaseTwo(KVStore *pKVStore, int iLevel) {
    //printf("-----> kvbdbCommitPhaseTwo(%p,%d)\n", pKVStore, iLevel);  
 
@@ -3018,7 +3695,18 @@ int kvbdbCommitPhaseTwo(KVStore *pKVStore, int iLevel) {
                | DB_TXN_WRITE_NOSYNC;
 
             int ret = 0;
+            // The data version is bumped both before and after the commit, 
+            // so that a row read by another connection while the commit 
+            // is in progress is not trusted afterwards.
+            if (iLevel < 2)
+            {
+               kvbdbNoteCommit(p);
+            }
             ret = pTxnCommitCandidate->commit(pTxnCommitCandidate, flags);
+            if (iLevel < 2)
+            {
+               kvbdbNoteCommit(p);
+            }
             switch (ret)
             {
             case 0:
@@ -3055,12 +3743,7 @@ int kvbdbCommitPhaseTwo(KVStore *pKVStore, int iLevel) {
             // if any present
             if (iLevel == 0)
             {
-               DBC * pCsr = p->pCsr;
-               if (pCsr != NULL)
-               {
-                  p->pCsr = NULL;
-                  pCsr->close(pCsr);
-               }
+               kvbdbCloseReadCursor(p);
             }
          } // end of block : if(pTxnPrepareCandidate != NULL){...}
       } // end block : if(KVStore->iTransLevel >= 2){...}
@@ -3104,6 +3787,13 @@ int kvbdbCommitPhaseTwo(KVStore *pKVStore, int iLevel) {
       pKVStore->iTransLevel = iLevel;
    }
 
+   // In MVCC mode the snapshot of a read-only transaction 
+   // must end with it, too.
+   if (rc == SQLITE4_OK && iLevel == 0 && p->pReadTxn != NULL)
+   {
+      kvbdbCloseReadCursor(p);
+   }
+
    return rc;
 } // end of : kvbdbCommitPhaseTwo(KVStore *pKVStore, int iLevel){...}
 
@@ -3209,12 +3899,12 @@ int kvbdbRollback(KVStore *pKVStore, int iLevel)
 
       if (iLevel == 0)
       {
-         if (p->pCsr != NULL)
+         if (p->pCsr != NULL || p->pReadTxn != NULL)
          {
             // Cursor for read-only ops exists -- 
-            // -- close it and clean it up!
-            ret = p->pCsr->close(p->pCsr); // closing
-            p->pCsr = NULL; // cleaning up
+            // -- close it and clean it up, 
+            // together with its snapshot transaction, if any!
+            ret = kvbdbCloseReadCursor(p);
             if (ret != 0)
             {
                if (rc == SQLITE4_OK)
@@ -3227,7 +3917,7 @@ int kvbdbRollback(KVStore *pKVStore, int iLevel)
             {
                //printf("kvbdbRollback() : succeeded closing Cursor while iLevel==0 : pKVStore=%p, pKVStore->iTransLevel=%d.\n", pKVStore, pKVStore->iTransLevel);
             }
-         } // end of block : if(p->pCsr != NULL){...}
+         } // end of block : if(p->pCsr != NULL || p->pReadTxn != NULL){...}
       } // end of block : if(iLevel == 0){...}
 
       if (rc == SQLITE4_OK)
@@ -3314,6 +4004,10 @@ int kvbdbClose(KVStore *pKVStore) {
    assert(p->iMagicKVBdbBase == SQLITE4_KVBDBBASE_MAGIC);
    assert(p->nCursor == 0);
 
+   // a snapshot transaction still open would keep 
+   // the environment from closing
+   kvbdbCloseReadCursor(p);
+
    char * zName = p->name;
 
    bdb_dict_node_t * pDictNode_zName = global_acquire_locked_dict_node(zName);
@@ -3338,8 +4032,32 @@ int kvbdbClose(KVStore *pKVStore) {
       pDictNode_zName->nref -= 1;
    }
 
+   // partitions cached by this connection
+   sqlite4_free(p->base.pEnv, p->apPart);
+   p->apPart = NULL;
+   p->nPart = 0;
+
+   // cursors kept for reuse
+   kvbdbFreeCursorPool(p);
+
    if (pDictNode_zName->nref == 0)
    {
+      if (pDictNode_zName->apPart)
+      {
+         // close partitions, if any
+         uint32_t i;
+         for (i = 0; i < pDictNode_zName->nPart; ++i)
+         {
+            DB * pPartDbp = pDictNode_zName->apPart[i];
+            if (pPartDbp != NULL)
+            {
+               pPartDbp->close(pPartDbp, 0);
+            }
+         }
+         free(pDictNode_zName->apPart);
+         pDictNode_zName->apPart = NULL;
+         pDictNode_zName->nPart = 0;
+      }
       if (pDictNode_zName->dbp)
       {
          ret = pDictNode_zName->dbp->close(pDictNode_zName->dbp, 0);
@@ -3386,6 +4104,15 @@ int kvbdbClose(KVStore *pKVStore) {
 int kvbdbControl(KVStore *pKVStore, int op, void *pArg) {
    //printf("-----> kvbdbControl()\n");  
 
+   KVBdb *p = (KVBdb*)pKVStore;
+
+   // Changes only when another connection of this process commits
+   if (op == SQLITE4_KVCTRL_DATA_VERSION)
+   {
+      *(sqlite4_uint64 *)pArg = s_nDataVersion.load() - p->nOwnCommit;
+      return SQLITE4_OK;
+   }
+
    return SQLITE4_NOTFOUND;
 }
 
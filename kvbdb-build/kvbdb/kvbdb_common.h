@@ -23,6 +23,7 @@
 //#include <stdlib.h> /*for min and max macros*/
 
 #include <mutex>
+#include <atomic>
 
 
 // ---------------- decl begin --------------------------
@@ -51,6 +52,21 @@ typedef struct KVBdbCursor KVBdbCursor;
 */
 #define SQLITE4_KV_BDB_MAX_TXN_DEPTH 16
 
+/*
+** In partition mode ("partition=1") the entries of each index root,
+** i.e. of each table and index, are kept in a BerkeleyDB database
+** of their own, so that page locks of unrelated tables never collide.
+** Index roots are allocated densely from 1, this is their upper bound.
+*/
+#define SQLITE4_KV_BDB_MAX_PARTITION (1 << 20)
+
+/*
+** Closed cursors are kept, with their key and data buffers, 
+** on a per-connection free list of at most this many entries 
+** and reused by later kvbdbOpenCursor() calls.
+*/
+#define SQLITE4_KV_BDB_MAX_FREE_CURSOR 8
+
 struct KVBdb {
    KVStore base;         /* Base class, must be first */
    unsigned openFlags;   /* Flags used at open */
@@ -67,10 +83,24 @@ struct KVBdb {
 
    DB_TXN * pTxn[SQLITE4_KV_BDB_MAX_TXN_DEPTH + 1]; /* transaction(s) open in given database/connection*/
 
+   int bMvcc;             /* True if opened with "mvcc=1", i.e. with DB_MULTIVERSION */
+   DB_TXN * pReadTxn;     /* In MVCC mode, the DB_TXN_SNAPSHOT transaction of pCsr */
+
+   int bPartition;        /* True if opened with "partition=1" */
+   DB ** apPart;          /* Partition DB's used so far, indexed by index root */
+   u_int32_t nPart;       /* Size of apPart[] */
+   struct bdb_dict_node_t * pDictNode; /* Dictionary node shared with other connections */
+
                                                     // for cursors -- begin
    u_int32_t nInitialCursorKeyBufferCapacity;
    u_int32_t nInitialCursorDataBufferCapacity;
+   KVBdbCursor * pFreeCsr;    /* Closed cursors kept for reuse, see kvbdbAllocCursor() */
+   int nFreeCsr;              /* Number of entries in pFreeCsr list */
+   u_int32_t nKeySizeSeen;    /* Largest key read by any cursor so far */
+   u_int32_t nDataSizeSeen;   /* Largest data read by any cursor so far */
    // for cursors -- end
+
+   unsigned long long nOwnCommit; /* Write transactions committed, see SQLITE4_KVCTRL_DATA_VERSION */
 };
 #define SQLITE4_KVBDBBASE_MAGIC  0xcedc46e1
 
@@ -104,6 +134,15 @@ struct KVBdbCursor {
    int nIsEOF;
 
    int nLastSeekDir;
+
+   // In partition mode pCsr is opened on demand, 
+   // on the partition of index root iPart, 
+   // in transaction pCsrTxn and with flags nCsrFlags
+   DB_TXN * pCsrTxn;
+   u_int32_t nCsrFlags;
+   u64 iPart;
+
+   KVBdbCursor * pNextFree; // next in KVBdb::pFreeCsr list
 };
 #define SQLITE4_KVBDBCUR_MAGIC   0xc0abed20
 
@@ -131,6 +170,7 @@ void enable_mutexes_in_kvbdb();
 
 /* forward declarations of object names */
 typedef struct bdb_dict_node_t bdb_dict_node_t;
+typedef struct bdb_dict_shard_t bdb_dict_shard_t;
 typedef struct bdb_dict_t bdb_dict_t;
 
 /* Berkeley DB dictionary node */
@@ -140,12 +180,24 @@ struct bdb_dict_node_t
    char name[128];
    DB * dbp;
    DB_ENV * envp;
+   int bMvcc;
+   int bPartition;             /* one BerkeleyDB database per index root */
+   int bPartInMemory;          /* partitions are in-memory, not files */
+   u_int32_t nPartOpenFlags;   /* DB->open() flags of partitions */
+   DB ** apPart;               /* partitions, indexed by index root */
+   uint32_t nPart;             /* size of apPart[] */
    uint32_t nref;
    bdb_dict_node_t * next;
 
    bdb_dict_node_t()
       : dbp(nullptr)
       , envp(nullptr)
+      , bMvcc(0)
+      , bPartition(0)
+      , bPartInMemory(0)
+      , nPartOpenFlags(0)
+      , apPart(nullptr)
+      , nPart(0)
       , nref(0)
       , next(nullptr)
    {
@@ -156,28 +208,43 @@ struct bdb_dict_node_t
    {
       dbp = nullptr;
       envp = nullptr;
+      apPart = nullptr;
       nref = 0;
       next = nullptr;
    }
 };
 
-/* Berkeley DB dictionary */
-struct bdb_dict_t
+/* One shard of a Berkeley DB dictionary */
+struct bdb_dict_shard_t
 {
    std::mutex mutex;
    bdb_dict_node_t * nodes;
 
-   bdb_dict_t()
+   bdb_dict_shard_t()
       : nodes(nullptr)
    {
    }
 
-   ~bdb_dict_t()
+   ~bdb_dict_shard_t()
    {
       nodes = nullptr;
    }
 };
 
+/*
+** Berkeley DB dictionary.
+** Nodes are distributed among shards by a hash of the node name,
+** each shard having its own mutex and list of nodes,
+** so that acquiring nodes of different names does not serialize
+** on a single dictionary-wide mutex.
+*/
+#define BDB_DICT_NSHARD 16
+
+struct bdb_dict_t
+{
+   bdb_dict_shard_t shards[BDB_DICT_NSHARD];
+};
+
 /*
 ** initialize the global static BerkeleyDB dictionary,
 ** incl. mutex(es).
@@ -19,6 +19,13 @@ int kVStoreOpen(
 
    int ret;
 
+   // "mvcc=1" opens the database with DB_MULTIVERSION,
+   // so that reads use snapshot transactions instead of locks
+   int bMvcc = sqlite4_uri_boolean(zName, "mvcc", 0);
+
+   // "partition=1" keeps each index root in a database of its own
+   int bPartition = sqlite4_uri_boolean(zName, "partition", 0);
+
    init_global_bdb_dict();
 
    bdb_dict_node_t * pDictNode_zName = global_acquire_locked_dict_node((char*)zName);
@@ -191,6 +198,12 @@ int kVStoreOpen(
       open_flags = DB_CREATE | /* Allow database creation */
          DB_AUTO_COMMIT | /* Allow autocommit */
          DB_THREAD;               /* Cause the database to be free-threaded */
+      if (bMvcc)
+      {
+         // keep copies of pages being updated for snapshot readers;
+         // the copies live in the (2 GB) cache, as there are no temp files
+         open_flags |= DB_MULTIVERSION;
+      }
 
                                   /* Now open the database */
       ret = dbp->open(dbp, /* Pointer to the database */
@@ -210,6 +223,10 @@ int kVStoreOpen(
       {
          //printf("------>Succeeded opening BerkeleyDB database, zName='%s', dbp=%p \n", zName, dbp);
       }
+      pDictNode_zName->bMvcc = bMvcc;
+      pDictNode_zName->bPartition = bPartition;
+      pDictNode_zName->bPartInMemory = 1;
+      pDictNode_zName->nPartOpenFlags = open_flags;
    } // end of block if(dbp == NULL){...}
 
      // Substitute back to pDictNode_zName
@@ -242,6 +259,9 @@ int kVStoreOpen(
    pNew->dbp = dbp;   /* connection to BerkeleyDB database           */
    pNew->envp = envp; /* environment for above connection / database */
    strcpy(pNew->name, zName); /* database name */
+   pNew->bMvcc = pDictNode_zName->bMvcc; /* as chosen by the first open */
+   pNew->bPartition = pDictNode_zName->bPartition; /* likewise */
+   pNew->pDictNode = pDictNode_zName;
 
    pNew->pCsr = NULL; /* Cursor for tead-only ops "outside" {?] transaction(s) [?]} */
 
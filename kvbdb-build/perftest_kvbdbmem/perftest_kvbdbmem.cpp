@@ -598,7 +598,7 @@ int main(int argc, char* argv[])
    std::vector<MyTestTask*> oMyTestTaskVector;
    std::vector<std::thread*> oMyTestTaskThreadsVector;
 
-   if (argc == 5)
+   if (argc == 5 || argc == 6)
    {
       numrows_total = atoi(argv[1]);
       numrows_per_txn = atoi(argv[2]);
@@ -613,18 +613,27 @@ int main(int argc, char* argv[])
       }
       else
       {
-         printf("Usage:\perftest_kvbdbmem numrows_total numrows_per_txn numthreads lazy|eager\n");
+         printf("Usage:\perftest_kvbdbmem numrows_total numrows_per_txn numthreads lazy|eager [uri_params]\n");
          return -1;
       }
+      if (argc == 6)
+      {
+         // extra URI parameters, e.g. "mvcc=1" for snapshot reads, 
+         // see kvbdbOpenReadCursor(), or "partition=1" for a database 
+         // per table/index, see kvbdbPartition()
+         static char zNameBuf[256];
+         snprintf(zNameBuf, sizeof(zNameBuf), "%s&%s", zName, argv[5]);
+         zName = zNameBuf;
+      }
    }
    else
    {
-      printf("Usage:\perftest_kvbdbmem numrows_total numrows_per_txn numthreads lazy|eager\n");
+      printf("Usage:\perftest_kvbdbmem numrows_total numrows_per_txn numthreads lazy|eager [uri_params]\n");
       return -1;
    }
 
-   printf("perftest_kvbdbmem   numrows_total=%d numrows_per_txn=%d numthreads=%d lazy_init=%s \n", 
-      numrows_total, numrows_per_txn, numthreads, lazy_init?"true":"false");
+   printf("perftest_kvbdbmem   numrows_total=%d numrows_per_txn=%d numthreads=%d lazy_init=%s uri='%s' \n", 
+      numrows_total, numrows_per_txn, numthreads, lazy_init?"true":"false", zName);
 
    // initialize db / open session etc. -- begin
    rc = sqlite4_load_kvstore_plugin(0, "kvbdbmem.dll", "kvbdbmem");
@@ -0,0 +1,14 @@
+#ifndef _KVLSM_COMMON_H_
+#define _KVLSM_COMMON_H_
+
+#if defined(_WIN32) && defined(KVLSM_CREATE_DLL)
+#  define kvlsm_export __declspec(dllexport)
+#elif defined(__GNUC__)
+   // The plugin is built with -fvisibility=hidden, 
+   // so only the entry point(s) marked here are exported.
+#  define kvlsm_export __attribute__((visibility("default")))
+#else
+#  define kvlsm_export
+#endif
+
+#endif // _KVLSM_COMMON_H_
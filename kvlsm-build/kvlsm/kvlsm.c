@@ -0,0 +1,162 @@
+#include "kvlsm_common.h"
+
+// =======================================================================================
+// LSM-tree factory.
+//
+// The database name is a directory, created if it does not exist,
+// which holds the logs, the runs and the manifest, see "kvlsm_common.h".
+// Connections of a process to the same database share one LsmDb,
+// which is closed with the last connection.
+//
+// A database is configured by URI parameters of its first open
+// in the process:
+//
+//    sync=off|normal|full    log sync: never; when a log, run or manifest
+//                            is completed; or also on every commit
+//                            (default normal)
+//    memtable_size=N         bytes of the memtable before it is written
+//                            to a run (default 4MB)
+//    merge_threads=N         background threads which write and merge runs
+//                            (default 1, 0 to do it in the committing thread)
+//    merge_width=N           runs of similar size merged at once (default 4)
+//    bloom_bits=N            bloom filter bits per key of a run
+//                            (default 10, 0 for none)
+//    block_size=N            bytes of a run block (default 4096)
+//    busy_timeout=N          ms a write transaction waits for the write lock
+//                            before it fails with SQLITE4_BUSY (default 5000)
+//
+// At run time, SQLITE4_KVCTRL_SYNCHRONOUS changes the sync level of
+// the commits of a connection, SQLITE4_KVCTRL_LSM_FLUSH writes the
+// memtable to a run, SQLITE4_KVCTRL_LSM_MERGE merges every run into
+// one, and SQLITE4_KVCTRL_LSM_CHECKPOINT syncs the log and the
+// manifest, see kvlsmControl(...).
+// =======================================================================================
+
+// Parse a "sync" URI parameter, -1 if not recognized
+static int parseKVLsmSyncLevel(const char * z)
+{
+   if (!z) return 1;
+   if (sqlite4_stricmp(z, "off") == 0 || strcmp(z, "0") == 0) return 0;
+   if (sqlite4_stricmp(z, "normal") == 0 || strcmp(z, "1") == 0) return 1;
+   if (sqlite4_stricmp(z, "full") == 0 || strcmp(z, "2") == 0) return 2;
+   return -1;
+}
+
+// Registry of open databases by name
+static std::mutex gKVLsmDbMutex;
+static std::map<std::string, LsmDb*> gKVLsmDbMap;
+
+int kvlsmAcquireDb(const char * zName, LsmDb ** ppDb)
+{
+   std::lock_guard<std::mutex> oLock(gKVLsmDbMutex);
+   *ppDb = nullptr;
+
+   auto it = gKVLsmDbMap.find(zName);
+   if (it != gKVLsmDbMap.end())
+   {
+      // found
+      it->second->nRef++;
+      *ppDb = it->second;
+      return SQLITE4_OK;
+   }
+
+   // not found
+   LsmConfig oConfig;
+   oConfig.eSync = parseKVLsmSyncLevel(sqlite4_uri_parameter(zName, "sync"));
+   sqlite4_int64 nMemtableSize = sqlite4_uri_int64(zName, "memtable_size", KVLSM_DEFAULT_MEMTABLE_SIZE);
+   sqlite4_int64 nMergeThread = sqlite4_uri_int64(zName, "merge_threads", KVLSM_DEFAULT_MERGE_THREADS);
+   sqlite4_int64 nMergeWidth = sqlite4_uri_int64(zName, "merge_width", KVLSM_DEFAULT_MERGE_WIDTH);
+   sqlite4_int64 nBloomBit = sqlite4_uri_int64(zName, "bloom_bits", KVLSM_DEFAULT_BLOOM_BITS);
+   sqlite4_int64 nBlockSize = sqlite4_uri_int64(zName, "block_size", KVLSM_DEFAULT_BLOCK_SIZE);
+   sqlite4_int64 nBusyTimeout = sqlite4_uri_int64(zName, "busy_timeout", KVLSM_DEFAULT_BUSY_TIMEOUT);
+   if (oConfig.eSync < 0 || nMemtableSize <= 0 || nMergeThread < 0 || nMergeThread > 64
+      || nMergeWidth < 2 || nBloomBit < 0 || nBloomBit > 64 || nBlockSize < 256
+      || nBusyTimeout < 0)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed KVLSM::KVStoreOpen() : invalid URI parameter of '%s'\n", zName);
+      return SQLITE4_MISUSE;
+   }
+   oConfig.nMemtableSize = (size_t)nMemtableSize;
+   oConfig.nMergeThread = (int)nMergeThread;
+   oConfig.nMergeWidth = (int)nMergeWidth;
+   oConfig.nBloomBit = (uint32_t)nBloomBit;
+   oConfig.nBlockSize = (size_t)nBlockSize;
+   oConfig.nBusyTimeout = (int)nBusyTimeout;
+
+   LsmDb * pDb = nullptr;
+   int rc;
+   try
+   {
+      rc = lsmDbOpen(zName, &oConfig, &pDb);
+      if (rc == SQLITE4_OK)
+      {
+         gKVLsmDbMap.insert(std::pair<std::string, LsmDb*>(zName, pDb));
+         pDb->nRef = 1;
+         *ppDb = pDb;
+      }
+   }
+   catch (...)
+   {
+      if (pDb) lsmDbClose(pDb);
+      rc = SQLITE4_NOMEM;
+   }
+   return rc;
+} // end of kvlsmAcquireDb(...){...}
+
+void kvlsmReleaseDb(LsmDb * pDb)
+{
+   std::lock_guard<std::mutex> oLock(gKVLsmDbMutex);
+   if (--pDb->nRef == 0)
+   {
+      gKVLsmDbMap.erase(pDb->zDir);
+      lsmDbClose(pDb);
+   }
+} // end of kvlsmReleaseDb(...){...}
+
+
+int KVStoreOpen(
+   sqlite4_env *pEnv,              /* Runtime environment */
+   sqlite4_kvstore **ppKVStore,    /* OUT: Write the new sqlite4_kvstore here */
+   const char *zName,              /* Name of the database directory */
+   unsigned openFlags              /* Flags */
+   )
+{
+   assert(pEnv);
+   *ppKVStore = nullptr;
+
+   if (!zName || !zName[0])
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("\nFailed KVLSM::KVStoreOpen() : a database directory is required.\n");
+      return SQLITE4_CANTOPEN;
+   }
+
+   KVLsm * pNew = nullptr;
+   try
+   {
+      pNew = new KVLsm;
+   }
+   catch (...)
+   {
+      printf("\nFailed KVLSM::KVStoreOpen() : failed creation of the new KVLsm.\n");
+      return SQLITE4_NOMEM;
+   }
+
+   int rc = kvlsmAcquireDb(zName, &pNew->pDb);
+   if (rc != SQLITE4_OK)
+   {
+      printf("\nFailed KVLSM::KVStoreOpen() : cannot open '%s', error %d\n", zName, rc);
+      delete pNew;
+      return rc;
+   }
+
+   pNew->base.pStoreVfunc = &kvlsmMethods;
+   pNew->base.pEnv = pEnv;
+   pNew->base.iTransLevel = 0;
+   pNew->openFlags = openFlags;
+   pNew->eSync = pNew->pDb->config.eSync;
+
+   *ppKVStore = (sqlite4_kvstore*)pNew;
+   return SQLITE4_OK;
+}
@@ -0,0 +1,54 @@
+#ifndef _SQLITE4_KVLSM_H_
+#define _SQLITE4_KVLSM_H_
+
+#include "common.h"
+
+#include "sqlite4.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Entry point looked up by sqlite4_load_kvstore_plugin(...), 
+// see sqlite4GetKVStoreFactoryFunction(...) in "env.c".
+kvlsm_export int KVStoreOpen(
+   sqlite4_env *pEnv,              /* Runtime environment */
+   sqlite4_kvstore **ppKVStore,    /* OUT: Write the new sqlite4_kvstore here */
+   const char *zName,              /* Name of the database directory */
+   unsigned openFlags              /* Flags */
+   );
+
+int kvlsmReplace(
+   sqlite4_kvstore*,
+   const unsigned char *pKey, sqlite4_kvsize nKey,
+   const unsigned char *pData, sqlite4_kvsize nData);
+int kvlsmOpenCursor(sqlite4_kvstore*, sqlite4_kvcursor**);
+int kvlsmSeek(sqlite4_kvcursor*,
+   const unsigned char *pKey, sqlite4_kvsize nKey, int dir);
+int kvlsmNext(sqlite4_kvcursor*);
+int kvlsmPrev(sqlite4_kvcursor*);
+int kvlsmDelete(sqlite4_kvcursor*);
+int kvlsmKey(sqlite4_kvcursor*,
+   const unsigned char **ppKey, sqlite4_kvsize *pnKey);
+int kvlsmData(sqlite4_kvcursor*, sqlite4_kvsize ofst, sqlite4_kvsize n,
+   const unsigned char **ppData, sqlite4_kvsize *pnData);
+int kvlsmReset(sqlite4_kvcursor*);
+int kvlsmCloseCursor(sqlite4_kvcursor*);
+int kvlsmBegin(sqlite4_kvstore*, int);
+int kvlsmCommitPhaseOne(sqlite4_kvstore*, int);
+int kvlsmCommitPhaseOneXID(sqlite4_kvstore*, int, void*);
+int kvlsmCommitPhaseTwo(sqlite4_kvstore*, int);
+int kvlsmRollback(sqlite4_kvstore*, int);
+int kvlsmRevert(sqlite4_kvstore*, int);
+int kvlsmClose(sqlite4_kvstore*);
+int kvlsmControl(sqlite4_kvstore*, int, void*);
+int kvlsmGetMeta(sqlite4_kvstore*, unsigned int *);
+int kvlsmPutMeta(sqlite4_kvstore*, unsigned int);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of #ifndef _SQLITE4_KVLSM_H_ */
@@ -0,0 +1,991 @@
+#include "kvlsm_common.h"
+
+#include <algorithm>
+
+// =======================================================================================
+// Iterators of the sources of a cursor
+// =======================================================================================
+
+// The write set of a transaction
+class LsmWriteIter : public LsmIter {
+public:
+   explicit LsmWriteIter(LsmWriteMap * a_pMap) : pMap(a_pMap), it(a_pMap->end()) {}
+
+   void seekGE(std::string_view k, bool bExcl) override
+   {
+      it = bExcl ? pMap->upper_bound(k) : pMap->lower_bound(k);
+   }
+   void seekLE(std::string_view k, bool bExcl) override
+   {
+      it = bExcl ? pMap->lower_bound(k) : pMap->upper_bound(k);
+      if (it == pMap->begin()) it = pMap->end();
+      else --it;
+   }
+   void next() override { ++it; }
+   void prev() override
+   {
+      if (it == pMap->begin()) it = pMap->end();
+      else --it;
+   }
+   bool valid() const override { return it != pMap->end(); }
+   std::string_view key() const override { return it->first; }
+   bool isDelete() const override { return it->second.bDelete; }
+   std::string_view data() const override { return it->second.data; }
+
+   bool get(std::string_view k, bool * pbDelete, std::string_view * pData) override
+   {
+      auto i = pMap->find(k);
+      if (i == pMap->end()) return false;
+      *pbDelete = i->second.bDelete;
+      *pData = i->second.data;
+      return true;
+   }
+
+private:
+   LsmWriteMap * pMap;
+   LsmWriteMap::iterator it;
+};
+
+// A memtable, as of sequence number iSeq.  Entries are never removed
+// from a memtable, so an iterator stays valid while commits insert
+// entries; each step takes the memtable lock to exclude them.
+class LsmMemIter : public LsmIter {
+public:
+   LsmMemIter(LsmMemTable * a_pMem, uint64_t a_iSeq) : pMem(a_pMem), iSeq(a_iSeq), it(a_pMem->map.end()) {}
+
+   void seekGE(std::string_view k, bool bExcl) override
+   {
+      std::shared_lock<std::shared_mutex> oLock(pMem->mutex);
+      // Versions of a key are ordered newest first, so {k, 0} follows all of them
+      it = pMem->map.lower_bound(LsmMemProbe{ k, bExcl ? 0 : UINT64_MAX });
+      skipForward();
+   }
+   void seekLE(std::string_view k, bool bExcl) override
+   {
+      std::shared_lock<std::shared_mutex> oLock(pMem->mutex);
+      if (!bExcl)
+      {
+         auto i = pMem->map.lower_bound(LsmMemProbe{ k, iSeq });
+         if (i != pMem->map.end() && i->first.key == k)
+         {
+            it = i;
+            return;
+         }
+      }
+      it = pMem->map.lower_bound(LsmMemProbe{ k, UINT64_MAX });
+      skipReverse();
+   }
+   void next() override
+   {
+      std::shared_lock<std::shared_mutex> oLock(pMem->mutex);
+      it = pMem->map.lower_bound(LsmMemProbe{ it->first.key, 0 });
+      skipForward();
+   }
+   void prev() override
+   {
+      std::shared_lock<std::shared_mutex> oLock(pMem->mutex);
+      it = pMem->map.lower_bound(LsmMemProbe{ it->first.key, UINT64_MAX });
+      skipReverse();
+   }
+   bool valid() const override { return it != pMem->map.end(); }
+   std::string_view key() const override { return it->first.key; }
+   bool isDelete() const override { return it->second.bDelete; }
+   std::string_view data() const override { return it->second.data; }
+
+   bool get(std::string_view k, bool * pbDelete, std::string_view * pData) override
+   {
+      std::shared_lock<std::shared_mutex> oLock(pMem->mutex);
+      auto i = pMem->map.lower_bound(LsmMemProbe{ k, iSeq });
+      if (i == pMem->map.end() || i->first.key != k) return false;
+      *pbDelete = i->second.bDelete;
+      *pData = i->second.data;
+      return true;
+   }
+
+private:
+   // Skip versions written after iSeq.  The first version left
+   // is the newest visible one of its key.
+   void skipForward()
+   {
+      while (it != pMem->map.end() && it->first.iSeq > iSeq) ++it;
+   }
+
+   // Move from it, the newest version of a key, to the newest
+   // visible version of the nearest smaller key having one
+   void skipReverse()
+   {
+      while (it != pMem->map.begin())
+      {
+         --it;
+         auto i = pMem->map.lower_bound(LsmMemProbe{ it->first.key, iSeq });
+         if (i != pMem->map.end() && i->first.key == it->first.key)
+         {
+            it = i;
+            return;
+         }
+         it = pMem->map.lower_bound(LsmMemProbe{ it->first.key, UINT64_MAX });
+      }
+      it = pMem->map.end();
+   }
+
+   LsmMemTable * pMem;
+   uint64_t iSeq;
+   LsmMemMap::iterator it;
+};
+
+// A run.  Entries are located by a binary search of the first keys of
+// the blocks followed by a scan of one block.
+class LsmRunIter : public LsmIter {
+public:
+   explicit LsmRunIter(const LsmRun * a_pRun) : pRun(a_pRun), iBlock(0), iOff(0), bValid(false) {}
+
+   void seekGE(std::string_view k, bool bExcl) override
+   {
+      bValid = false;
+      if (pRun->nBlock == 0) return;
+      iBlock = findBlock(k, false);
+      if (iBlock == pRun->nBlock) iBlock = 0;
+      iOff = lsmRunBlock(pRun, iBlock);
+      bValid = decode();
+      while (bValid)
+      {
+         int c = key().compare(k);
+         if (c > 0 || (c == 0 && !bExcl)) break;
+         next();
+      }
+   }
+   void seekLE(std::string_view k, bool bExcl) override
+   {
+      bValid = false;
+      if (pRun->nBlock == 0) return;
+      iBlock = findBlock(k, bExcl);
+      if (iBlock == pRun->nBlock) return;
+      uint64_t iEnd = blockEnd(iBlock);
+      uint64_t iLast = 0;
+      for (uint64_t i = lsmRunBlock(pRun, iBlock); i < iEnd; i += entry.nSize)
+      {
+         if (!lsmRunDecode(pRun, i, &entry)) return;
+         int c = std::string_view((const char *)entry.aKey, entry.nKey).compare(k);
+         if (c > 0 || (c == 0 && bExcl)) break;
+         iLast = i;
+      }
+      iOff = iLast;
+      bValid = decode();
+   }
+   void next() override
+   {
+      iOff += entry.nSize;
+      if (iOff >= blockEnd(iBlock))
+      {
+         if (++iBlock >= pRun->nBlock)
+         {
+            bValid = false;
+            return;
+         }
+         iOff = lsmRunBlock(pRun, iBlock);
+      }
+      bValid = decode();
+   }
+   void prev() override
+   {
+      uint64_t iTarget = iOff;
+      uint64_t iStart = lsmRunBlock(pRun, iBlock);
+      if (iOff == iStart)
+      {
+         if (iBlock == 0)
+         {
+            bValid = false;
+            return;
+         }
+         iBlock--;
+         iStart = lsmRunBlock(pRun, iBlock);
+         iTarget = blockEnd(iBlock);
+      }
+      // Entries are found by scanning forward from the start of the block
+      uint64_t i = iStart;
+      while (true)
+      {
+         if (!lsmRunDecode(pRun, i, &entry))
+         {
+            bValid = false;
+            return;
+         }
+         if (i + entry.nSize >= iTarget) break;
+         i += entry.nSize;
+      }
+      iOff = i;
+      bValid = true;
+   }
+   bool valid() const override { return bValid; }
+   std::string_view key() const override { return std::string_view((const char *)entry.aKey, entry.nKey); }
+   bool isDelete() const override { return entry.bDelete; }
+   std::string_view data() const override { return std::string_view((const char *)entry.aData, entry.nData); }
+
+   bool get(std::string_view k, bool * pbDelete, std::string_view * pData) override
+   {
+      if (pRun->nBlock == 0) return false;
+      if (!lsmRunMayContain(pRun, (const uint8_t *)k.data(), k.size())) return false;
+      uint64_t iFound = findBlock(k, false);
+      if (iFound == pRun->nBlock) return false;
+      uint64_t iEnd = blockEnd(iFound);
+      LsmRunEntry e;
+      for (uint64_t i = lsmRunBlock(pRun, iFound); i < iEnd; i += e.nSize)
+      {
+         if (!lsmRunDecode(pRun, i, &e)) return false;
+         int c = std::string_view((const char *)e.aKey, e.nKey).compare(k);
+         if (c > 0) return false;
+         if (c == 0)
+         {
+            *pbDelete = e.bDelete;
+            *pData = std::string_view((const char *)e.aData, e.nData);
+            return true;
+         }
+      }
+      return false;
+   }
+
+private:
+   uint64_t blockEnd(uint64_t i) const
+   {
+      return i + 1 < pRun->nBlock ? lsmRunBlock(pRun, i + 1) : pRun->iBlockEnd;
+   }
+
+   bool decode()
+   {
+      return lsmRunDecode(pRun, iOff, &entry);
+   }
+
+   // The last block whose first key is <= k (< k if bExcl),
+   // or nBlock if there is none
+   uint64_t findBlock(std::string_view k, bool bExcl) const
+   {
+      uint64_t lo = 0, hi = pRun->nBlock;
+      LsmRunEntry e;
+      while (lo < hi)
+      {
+         uint64_t mid = lo + (hi - lo) / 2;
+         if (!lsmRunDecode(pRun, lsmRunBlock(pRun, mid), &e)) return pRun->nBlock;
+         int c = std::string_view((const char *)e.aKey, e.nKey).compare(k);
+         if (c < 0 || (c == 0 && !bExcl)) lo = mid + 1;
+         else hi = mid;
+      }
+      return lo == 0 ? pRun->nBlock : lo - 1;
+   }
+
+   const LsmRun * pRun;
+   uint64_t iBlock;
+   uint64_t iOff;
+   LsmRunEntry entry;
+   bool bValid;
+};
+
+// =======================================================================================
+// Cursor
+// =======================================================================================
+
+// Point the iterators of pCur at the snapshot of its connection, or,
+// outside of a transaction, at the current state of the database.
+static void kvlsmCursorSnapshot(KVLsmCursor * pCur)
+{
+   KVLsm * p = pCur->pOwner;
+   if (p->pVersion)
+   {
+      pCur->pVersion = p->pVersion;
+      pCur->iSeq = p->iSeq;
+   }
+   else
+   {
+      lsmDbSnapshot(p->pDb, &pCur->pVersion, &pCur->iSeq);
+   }
+   pCur->iSnapGen = p->iSnapGen;
+   pCur->iWriteGen = p->iWriteGen;
+
+   LsmVersion & v = *pCur->pVersion;
+   pCur->aIter.clear();
+   pCur->aIter.emplace_back(new LsmWriteIter(&p->aWrite));
+   pCur->aIter.emplace_back(new LsmMemIter(v.pMem.get(), pCur->iSeq));
+   for (auto & pMem : v.aFrozen)
+   {
+      pCur->aIter.emplace_back(new LsmMemIter(pMem.get(), pCur->iSeq));
+   }
+   for (auto & pRun : v.aRun)
+   {
+      pCur->aIter.emplace_back(new LsmRunIter(pRun.get()));
+   }
+}
+
+// Move iterator pIter to the current key of pCur, as required by the mode
+static void kvlsmCursorPlace(KVLsmCursor * pCur, LsmIter * pIter)
+{
+   if (pCur->eMode == KVLSM_CURSOR_FORWARD)
+   {
+      pIter->seekGE(pCur->key, false);
+   }
+   else if (pCur->eMode == KVLSM_CURSOR_REVERSE)
+   {
+      pIter->seekLE(pCur->key, false);
+   }
+}
+
+// Bring the iterators of pCur up to date with the snapshot and the
+// write set of its connection, keeping the current key.
+static void kvlsmCursorSync(KVLsmCursor * pCur)
+{
+   KVLsm * p = pCur->pOwner;
+   if (pCur->aIter.empty() || pCur->iSnapGen != p->iSnapGen)
+   {
+      kvlsmCursorSnapshot(pCur);
+      for (auto & pIter : pCur->aIter)
+      {
+         kvlsmCursorPlace(pCur, pIter.get());
+      }
+   }
+   else if (pCur->iWriteGen != p->iWriteGen)
+   {
+      pCur->iWriteGen = p->iWriteGen;
+      kvlsmCursorPlace(pCur, pCur->aIter[0].get());
+   }
+}
+
+// Make the entry with the smallest key (largest if !bForward) among
+// the iterators current, skipping deleted keys.  Where several sources
+// hold the key, the newest wins.
+static int kvlsmCursorSettle(KVLsmCursor * pCur, bool bForward)
+{
+   while (true)
+   {
+      LsmIter * pBest = nullptr;
+      for (auto & pIter : pCur->aIter)
+      {
+         if (!pIter->valid()) continue;
+         if (!pBest) pBest = pIter.get();
+         else
+         {
+            int c = pIter->key().compare(pBest->key());
+            if (bForward ? c < 0 : c > 0) pBest = pIter.get();
+         }
+      }
+      if (!pBest)
+      {
+         pCur->eMode = KVLSM_CURSOR_NONE;
+         pCur->key.clear();
+         return SQLITE4_NOTFOUND;
+      }
+      pCur->key.assign(pBest->key());
+      if (!pBest->isDelete())
+      {
+         std::string_view data = pBest->data();
+         if (pBest == pCur->aIter[0].get())
+         {
+            // The write set may change while the cursor points here
+            pCur->dataBuf.assign(data);
+            data = pCur->dataBuf;
+         }
+         pCur->aData = (const uint8_t *)data.data();
+         pCur->nData = data.size();
+         return SQLITE4_OK;
+      }
+      for (auto & pIter : pCur->aIter)
+      {
+         if (pIter->valid() && pIter->key() == pCur->key)
+         {
+            if (bForward) pIter->next();
+            else pIter->prev();
+         }
+      }
+   }
+}
+
+// Step to the next (bForward) or previous entry
+static int kvlsmCursorStep(KVLsmCursor * pCur, bool bForward)
+{
+   kvlsmCursorSync(pCur);
+   if (pCur->eMode == KVLSM_CURSOR_NONE) return SQLITE4_NOTFOUND;
+   int eMode = bForward ? KVLSM_CURSOR_FORWARD : KVLSM_CURSOR_REVERSE;
+   if (pCur->eMode != eMode)
+   {
+      pCur->eMode = eMode;
+      for (auto & pIter : pCur->aIter)
+      {
+         kvlsmCursorPlace(pCur, pIter.get());
+      }
+   }
+   for (auto & pIter : pCur->aIter)
+   {
+      if (pIter->valid() && pIter->key() == pCur->key)
+      {
+         if (bForward) pIter->next();
+         else pIter->prev();
+      }
+   }
+   return kvlsmCursorSettle(pCur, bForward);
+}
+
+int kvlsmOpenCursor(sqlite4_kvstore * pKVStore, sqlite4_kvcursor ** ppKVCursor)
+{
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+
+   KVLsmCursor * pCur = nullptr;
+   try
+   {
+      pCur = new KVLsmCursor;
+   }
+   catch (...)
+   {
+      *ppKVCursor = nullptr;
+      return SQLITE4_NOMEM;
+   }
+   memset(&pCur->base, 0, sizeof(pCur->base));
+   pCur->base.pStore = pKVStore;
+   pCur->base.pStoreVfunc = pKVStore->pStoreVfunc;
+   pCur->base.pEnv = pKVStore->pEnv;
+   pCur->pOwner = p;
+   pCur->iMagicKVLsmCur = SQLITE4_KVLSMCUR_MAGIC;
+   pCur->iSeq = 0;
+   pCur->iSnapGen = 0;
+   pCur->iWriteGen = 0;
+   pCur->eMode = KVLSM_CURSOR_NONE;
+   pCur->aData = nullptr;
+   pCur->nData = 0;
+   p->nCursor++;
+   *ppKVCursor = (sqlite4_kvcursor *)pCur;
+   return SQLITE4_OK;
+}
+
+int kvlsmSeek(
+   sqlite4_kvcursor * pKVCursor,
+   const unsigned char * aKey, sqlite4_kvsize nKey,
+   int dir
+   )
+{
+   KVLsmCursor * pCur = (KVLsmCursor *)pKVCursor;
+   assert(pCur->iMagicKVLsmCur == SQLITE4_KVLSMCUR_MAGIC);
+
+   pCur->eMode = KVLSM_CURSOR_NONE;
+   pCur->key.clear();
+   if (!pCur->pOwner->pVersion)
+   {
+      // Outside of a transaction, read the latest commit
+      pCur->aIter.clear();
+   }
+   kvlsmCursorSync(pCur);
+
+   std::string_view k((const char *)aKey, (size_t)nKey);
+   if (dir == 0)
+   {
+      // Exact match: the newest source holding the key decides
+      bool bDelete;
+      std::string_view data;
+      for (size_t i = 0; i < pCur->aIter.size(); ++i)
+      {
+         if (!pCur->aIter[i]->get(k, &bDelete, &data)) continue;
+         if (bDelete) return SQLITE4_NOTFOUND;
+         pCur->key.assign(k);
+         if (i == 0)
+         {
+            pCur->dataBuf.assign(data);
+            data = pCur->dataBuf;
+         }
+         pCur->aData = (const uint8_t *)data.data();
+         pCur->nData = data.size();
+         pCur->eMode = KVLSM_CURSOR_POINT;
+         return SQLITE4_OK;
+      }
+      return SQLITE4_NOTFOUND;
+   }
+
+   bool bForward = (dir > 0);
+   pCur->eMode = bForward ? KVLSM_CURSOR_FORWARD : KVLSM_CURSOR_REVERSE;
+   for (auto & pIter : pCur->aIter)
+   {
+      if (bForward) pIter->seekGE(k, false);
+      else pIter->seekLE(k, false);
+   }
+   int rc = kvlsmCursorSettle(pCur, bForward);
+   if (rc == SQLITE4_OK && pCur->key != k)
+   {
+      rc = SQLITE4_INEXACT;
+   }
+   return rc;
+}
+
+int kvlsmNext(sqlite4_kvcursor * pKVCursor)
+{
+   KVLsmCursor * pCur = (KVLsmCursor *)pKVCursor;
+   assert(pCur->iMagicKVLsmCur == SQLITE4_KVLSMCUR_MAGIC);
+   return kvlsmCursorStep(pCur, true);
+}
+
+int kvlsmPrev(sqlite4_kvcursor * pKVCursor)
+{
+   KVLsmCursor * pCur = (KVLsmCursor *)pKVCursor;
+   assert(pCur->iMagicKVLsmCur == SQLITE4_KVLSMCUR_MAGIC);
+   return kvlsmCursorStep(pCur, false);
+}
+
+int kvlsmKey(
+   sqlite4_kvcursor * pKVCursor,
+   const unsigned char ** paKey, sqlite4_kvsize * pnKey
+   )
+{
+   KVLsmCursor * pCur = (KVLsmCursor *)pKVCursor;
+   assert(pCur->iMagicKVLsmCur == SQLITE4_KVLSMCUR_MAGIC);
+   if (pCur->eMode == KVLSM_CURSOR_NONE)
+   {
+      *paKey = 0;
+      *pnKey = 0;
+      return SQLITE4_DONE;
+   }
+   *paKey = (const unsigned char *)pCur->key.data();
+   *pnKey = (sqlite4_kvsize)pCur->key.size();
+   return SQLITE4_OK;
+}
+
+int kvlsmData(
+   sqlite4_kvcursor * pKVCursor,
+   sqlite4_kvsize ofst, sqlite4_kvsize n,
+   const unsigned char ** paData, sqlite4_kvsize * pnData
+   )
+{
+   KVLsmCursor * pCur = (KVLsmCursor *)pKVCursor;
+   assert(pCur->iMagicKVLsmCur == SQLITE4_KVLSMCUR_MAGIC);
+   if (pCur->eMode == KVLSM_CURSOR_NONE)
+   {
+      *paData = 0;
+      *pnData = 0;
+      return SQLITE4_DONE;
+   }
+   *paData = pCur->aData + ofst;
+   *pnData = (sqlite4_kvsize)pCur->nData - ofst;
+   return SQLITE4_OK;
+}
+
+int kvlsmReset(sqlite4_kvcursor * pKVCursor)
+{
+   KVLsmCursor * pCur = (KVLsmCursor *)pKVCursor;
+   assert(pCur->iMagicKVLsmCur == SQLITE4_KVLSMCUR_MAGIC);
+   pCur->eMode = KVLSM_CURSOR_NONE;
+   pCur->key.clear();
+   return SQLITE4_OK;
+}
+
+int kvlsmCloseCursor(sqlite4_kvcursor * pKVCursor)
+{
+   if (!pKVCursor) return SQLITE4_OK;
+   KVLsmCursor * pCur = (KVLsmCursor *)pKVCursor;
+   assert(pCur->iMagicKVLsmCur == SQLITE4_KVLSMCUR_MAGIC);
+   pCur->pOwner->nCursor--;
+   pCur->iMagicKVLsmCur = 0;
+   delete pCur;
+   return SQLITE4_OK;
+}
+
+// =======================================================================================
+// Changes
+// =======================================================================================
+
+// Write an entry, or a deletion, to the write set of p
+static int kvlsmWrite(KVLsm * p, std::string_view k, std::string_view data, bool bDelete)
+{
+   int iLevel = p->base.iTransLevel;
+   assert(iLevel >= 2 && p->bWriter);
+   try
+   {
+      auto it = p->aWrite.find(k);
+      if (iLevel >= 3)
+      {
+         LsmUndo oUndo;
+         oUndo.key.assign(k);
+         oUndo.bExisted = (it != p->aWrite.end());
+         oUndo.old.bDelete = false;
+         if (oUndo.bExisted) oUndo.old = it->second;
+         p->aUndo[iLevel - 3].push_back(std::move(oUndo));
+      }
+      if (it == p->aWrite.end())
+      {
+         it = p->aWrite.emplace(std::string(k), LsmWriteVal()).first;
+      }
+      it->second.data.assign(data);
+      it->second.bDelete = bDelete;
+   }
+   catch (std::bad_alloc &)
+   {
+      return SQLITE4_NOMEM;
+   }
+   p->iWriteGen++;
+   return SQLITE4_OK;
+}
+
+int kvlsmReplace(
+   sqlite4_kvstore * pKVStore,
+   const unsigned char * aKey, sqlite4_kvsize nKey,
+   const unsigned char * aData, sqlite4_kvsize nData
+   )
+{
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+   if (p->base.iTransLevel < 2) return SQLITE4_MISUSE;
+   return kvlsmWrite(p, std::string_view((const char *)aKey, (size_t)nKey),
+      std::string_view((const char *)aData, (size_t)nData), false);
+}
+
+// Delete the entry the cursor points to.  The cursor keeps its position,
+// so xNext and xPrev move from the deleted key.
+int kvlsmDelete(sqlite4_kvcursor * pKVCursor)
+{
+   KVLsmCursor * pCur = (KVLsmCursor *)pKVCursor;
+   assert(pCur->iMagicKVLsmCur == SQLITE4_KVLSMCUR_MAGIC);
+   KVLsm * p = pCur->pOwner;
+   if (p->base.iTransLevel < 2) return SQLITE4_MISUSE;
+   if (pCur->eMode == KVLSM_CURSOR_NONE) return SQLITE4_OK;
+   return kvlsmWrite(p, pCur->key, std::string_view(), true);
+}
+
+// The log record body of the write transaction of p
+static std::string kvlsmBody(KVLsm * p, uint32_t iMeta)
+{
+   std::string body;
+   char aMeta[4] = { (char)(iMeta >> 24), (char)(iMeta >> 16), (char)(iMeta >> 8), (char)iMeta };
+   body.append(aMeta, 4);
+   for (auto & oEntry : p->aWrite)
+   {
+      lsmEncodeEntry(body, (const uint8_t *)oEntry.first.data(), oEntry.first.size(),
+         (const uint8_t *)oEntry.second.data.data(), oEntry.second.data.size(), oEntry.second.bDelete);
+   }
+   return body;
+}
+
+// =======================================================================================
+// Transactions
+// =======================================================================================
+
+// Drop the write set of p and release the write lock
+static void kvlsmEndWrite(KVLsm * p)
+{
+   p->aWrite.clear();
+   p->aUndo.clear();
+   p->iWriteGen++;
+   p->bPrepared = false;
+   p->bMetaChanged = false;
+   if (p->bWriter)
+   {
+      p->bWriter = false;
+      lsmDbUnlockWriter(p->pDb, p);
+   }
+}
+
+// Take (or drop, if !bTake) the snapshot read by the transaction of p
+static void kvlsmSetSnapshot(KVLsm * p, bool bTake)
+{
+   if (bTake)
+   {
+      lsmDbSnapshot(p->pDb, &p->pVersion, &p->iSeq);
+   }
+   else
+   {
+      p->pVersion.reset();
+   }
+   p->iSnapGen++;
+}
+
+// Begin a transaction or subtransaction.  A write transaction takes the
+// write lock of the database, and fails with SQLITE4_BUSY if another
+// connection has committed since the snapshot of the read transaction
+// was taken.
+int kvlsmBegin(sqlite4_kvstore * pKVStore, int iLevel)
+{
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+   assert(iLevel > 0);
+   assert(iLevel == 2 || iLevel == p->base.iTransLevel + 1);
+
+   if (iLevel >= 2 && p->base.iTransLevel < 2)
+   {
+      int rc = lsmDbLockWriter(p->pDb, p);
+      if (rc != SQLITE4_OK) return rc;
+      p->bWriter = true;
+      if (p->base.iTransLevel == 0)
+      {
+         kvlsmSetSnapshot(p, true);
+      }
+      else
+      {
+         std::shared_ptr<LsmVersion> pVersion;
+         uint64_t iSeq;
+         lsmDbSnapshot(p->pDb, &pVersion, &iSeq);
+         if (iSeq != p->iSeq)
+         {
+            kvlsmEndWrite(p);
+            return SQLITE4_BUSY;
+         }
+      }
+   }
+   else if (p->base.iTransLevel == 0)
+   {
+      kvlsmSetSnapshot(p, true);
+   }
+
+   if (iLevel >= 3)
+   {
+      try
+      {
+         p->aUndo.resize(iLevel - 2);
+      }
+      catch (std::bad_alloc &)
+      {
+         return SQLITE4_NOMEM;
+      }
+      p->aUndo[iLevel - 3].clear();
+   }
+   p->base.iTransLevel = iLevel;
+   return SQLITE4_OK;
+}
+
+// Nothing is written by phase one, unless the transaction is given an
+// id by xCommitPhaseOneXID; the changes are logged by phase two.
+int kvlsmCommitPhaseOne(sqlite4_kvstore * pKVStore, int iLevel)
+{
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+   assert(iLevel >= 0 && iLevel < p->base.iTransLevel);
+   UNUSED_PARAMETER(p);
+   UNUSED_PARAMETER(iLevel);
+   return SQLITE4_OK;
+}
+
+// Prepare the write transaction: log its changes with the transaction
+// id xid, a NUL-terminated string, so that the commit survives a crash
+// once phase two has logged a commit record.  A transaction which was
+// prepared but not committed is rolled back by recovery.
+int kvlsmCommitPhaseOneXID(sqlite4_kvstore * pKVStore, int iLevel, void * xid)
+{
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+   assert(iLevel >= 0 && iLevel < p->base.iTransLevel);
+   if (iLevel >= 2 || p->base.iTransLevel < 2 || p->bPrepared) return SQLITE4_OK;
+
+   uint64_t iSeq;
+   std::shared_ptr<LsmVersion> pVersion;
+   lsmDbSnapshot(p->pDb, &pVersion, &iSeq);
+   uint32_t iMeta = p->iMeta;
+   if (!p->bMetaChanged) kvlsmGetMeta(pKVStore, &iMeta);
+   int rc = lsmDbPrepare(p->pDb, iSeq + 1, (const char *)xid, kvlsmBody(p, iMeta), p->eSync);
+   if (rc == SQLITE4_OK) p->bPrepared = true;
+   return rc;
+}
+
+int kvlsmCommitPhaseTwo(sqlite4_kvstore * pKVStore, int iLevel)
+{
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+   assert(iLevel >= 0 && iLevel < p->base.iTransLevel);
+   int rc = SQLITE4_OK;
+
+   if (iLevel >= 2)
+   {
+      // Changes of the committed levels become part of level iLevel
+      if (iLevel >= 3)
+      {
+         std::vector<LsmUndo> & aTo = p->aUndo[iLevel - 3];
+         for (int i = iLevel - 2; i < (int)p->aUndo.size(); ++i)
+         {
+            for (auto & oUndo : p->aUndo[i]) aTo.push_back(std::move(oUndo));
+         }
+      }
+      p->aUndo.resize(iLevel >= 3 ? iLevel - 2 : 0);
+   }
+   else if (p->base.iTransLevel >= 2)
+   {
+      if (!p->aWrite.empty() || p->bMetaChanged || p->bPrepared)
+      {
+         uint64_t iSeq;
+         std::shared_ptr<LsmVersion> pVersion;
+         lsmDbSnapshot(p->pDb, &pVersion, &iSeq);
+         uint32_t iMeta = p->iMeta;
+         if (!p->bMetaChanged) kvlsmGetMeta(pKVStore, &iMeta);
+         rc = lsmDbCommit(p->pDb, iSeq + 1, kvlsmBody(p, iMeta), p->bPrepared, p->eSync);
+         if (rc != SQLITE4_OK) return rc;
+         p->nOwnCommit++;
+      }
+      kvlsmEndWrite(p);
+      if (iLevel == 1) kvlsmSetSnapshot(p, true);
+   }
+   if (iLevel == 0)
+   {
+      kvlsmSetSnapshot(p, false);
+   }
+   p->base.iTransLevel = iLevel;
+   return rc;
+}
+
+int kvlsmRollback(sqlite4_kvstore * pKVStore, int iLevel)
+{
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+   assert(iLevel >= 0);
+
+   if (iLevel >= 2)
+   {
+      // Undo the changes of the levels above iLevel, newest first
+      for (int i = (int)p->aUndo.size() - 1; i >= iLevel - 2; --i)
+      {
+         std::vector<LsmUndo> & aLog = p->aUndo[i];
+         for (auto it = aLog.rbegin(); it != aLog.rend(); ++it)
+         {
+            if (it->bExisted) p->aWrite[it->key] = std::move(it->old);
+            else p->aWrite.erase(it->key);
+         }
+      }
+      p->aUndo.resize(iLevel >= 3 ? iLevel - 2 : 0);
+      p->iWriteGen++;
+   }
+   else if (p->base.iTransLevel >= 2)
+   {
+      if (p->bPrepared)
+      {
+         uint64_t iSeq;
+         std::shared_ptr<LsmVersion> pVersion;
+         lsmDbSnapshot(p->pDb, &pVersion, &iSeq);
+         lsmDbAbort(p->pDb, iSeq + 1);
+      }
+      kvlsmEndWrite(p);
+   }
+   if (iLevel == 0 && p->base.iTransLevel > 0)
+   {
+      kvlsmSetSnapshot(p, false);
+   }
+   p->base.iTransLevel = iLevel;
+   return SQLITE4_OK;
+}
+
+int kvlsmRevert(sqlite4_kvstore * pKVStore, int iLevel)
+{
+   int rc = kvlsmRollback(pKVStore, iLevel - 1);
+   if (rc == SQLITE4_OK)
+   {
+      rc = kvlsmBegin(pKVStore, iLevel);
+   }
+   return rc;
+}
+
+int kvlsmClose(sqlite4_kvstore * pKVStore)
+{
+   if (!pKVStore) return SQLITE4_OK;
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+   if (p->iMagicKVLsmBase != SQLITE4_KVLSMBASE_MAGIC) return SQLITE4_MISUSE;
+   assert(p->nCursor == 0);
+
+   if (p->base.iTransLevel > 0) kvlsmRollback(pKVStore, 0);
+   kvlsmReleaseDb(p->pDb);
+   p->iMagicKVLsmBase = 0;
+   delete p;
+   return SQLITE4_OK;
+}
+
+// Run fx on the database of p with the write lock held,
+// taking it for the call if the connection does not hold it.
+template <class F>
+static int kvlsmWithWriter(KVLsm * p, F fx)
+{
+   if (p->bWriter) return fx();
+   int rc = lsmDbLockWriter(p->pDb, p);
+   if (rc != SQLITE4_OK) return rc;
+   rc = fx();
+   lsmDbUnlockWriter(p->pDb, p);
+   return rc;
+}
+
+int kvlsmControl(sqlite4_kvstore * pKVStore, int n, void * arg)
+{
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+   LsmDb * pDb = p->pDb;
+   int rc;
+
+   switch (n)
+   {
+   case SQLITE4_KVCTRL_DATA_VERSION:
+   {
+      // Changes only when another connection commits
+      std::lock_guard<std::mutex> oLock(pDb->mutex);
+      *(sqlite4_uint64 *)arg = pDb->nCommit - p->nOwnCommit;
+      return SQLITE4_OK;
+   }
+   case SQLITE4_KVCTRL_SYNCHRONOUS:
+   {
+      int * peSync = (int *)arg;
+      if (*peSync >= 0 && *peSync <= 2)
+      {
+         p->eSync = *peSync;
+      }
+      *peSync = p->eSync;
+      return SQLITE4_OK;
+   }
+   case SQLITE4_KVCTRL_LSM_FLUSH:
+      // Write the memtable to a run and wait for it
+      rc = kvlsmWithWriter(p, [pDb] { return lsmDbFreeze(pDb); });
+      if (rc == SQLITE4_OK) rc = lsmDbWait(pDb);
+      return rc;
+   case SQLITE4_KVCTRL_LSM_MERGE:
+      return lsmDbMerge(pDb);
+   case SQLITE4_KVCTRL_LSM_CHECKPOINT:
+      return kvlsmWithWriter(p, [pDb] { return lsmDbCheckpoint(pDb); });
+   default:
+      break;
+   }
+   return SQLITE4_NOTFOUND;
+}
+
+// The schema cookie: as written by the transaction, if it has,
+// otherwise as of the last commit.
+int kvlsmGetMeta(sqlite4_kvstore * pKVStore, unsigned int * piVal)
+{
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+   if (p->bMetaChanged)
+   {
+      *piVal = p->iMeta;
+   }
+   else
+   {
+      std::lock_guard<std::mutex> oLock(p->pDb->mutex);
+      *piVal = p->pDb->iMeta;
+   }
+   return SQLITE4_OK;
+}
+
+int kvlsmPutMeta(sqlite4_kvstore * pKVStore, unsigned int iVal)
+{
+   KVLsm * p = (KVLsm *)pKVStore;
+   assert(p->iMagicKVLsmBase == SQLITE4_KVLSMBASE_MAGIC);
+   p->iMeta = iVal;
+   p->bMetaChanged = true;
+   return SQLITE4_OK;
+}
+
+const sqlite4_kv_methods kvlsmMethods = {
+   1,                            /* iVersion */
+   sizeof(sqlite4_kv_methods),   /* szSelf */
+   kvlsmReplace,                 /* xReplace */
+   kvlsmOpenCursor,              /* xOpenCursor */
+   kvlsmSeek,                    /* xSeek */
+   kvlsmNext,                    /* xNext */
+   kvlsmPrev,                    /* xPrev */
+   kvlsmDelete,                  /* xDelete */
+   kvlsmKey,                     /* xKey */
+   kvlsmData,                    /* xData */
+   kvlsmReset,                   /* xReset */
+   kvlsmCloseCursor,             /* xCloseCursor */
+   kvlsmBegin,                   /* xBegin */
+   kvlsmCommitPhaseOne,          /* xCommitPhaseOne */
+   kvlsmCommitPhaseOneXID,       /* xCommitPhaseOneXID */
+   kvlsmCommitPhaseTwo,          /* xCommitPhaseTwo */
+   kvlsmRollback,                /* xRollback */
+   kvlsmRevert,                  /* xRevert */
+   kvlsmClose,                   /* xClose */
+   kvlsmControl,                 /* xControl */
+   kvlsmGetMeta,                 /* xGetMeta */
+   kvlsmPutMeta                  /* xPutMeta */
+};
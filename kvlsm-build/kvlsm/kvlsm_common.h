@@ -0,0 +1,398 @@
+#ifndef _SQLITE4_KVLSM_COMMON_H_
+#define _SQLITE4_KVLSM_COMMON_H_
+
+#include "kvlsm.h"
+
+#include "sqlite4.h"
+#include "sqliteInt.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// =======================================================================================
+// KVLSM : a log-structured merge-tree KVStore.
+//
+// A database is a directory holding:
+//
+//    MANIFEST     the live runs (newest first) and the oldest live log
+//    log-N        write-ahead logs of committed transactions
+//    run-N        sorted runs, immutable once written
+//
+// Commits are appended to the current log and applied to an in-memory
+// tree (the memtable).  A memtable larger than memtable_size is frozen
+// and a new one, with a new log, takes its place.  Background threads
+// write each frozen memtable to a new run, after which its log is
+// deleted, and merge runs of similar size into one, so that a read
+// visits few runs.  Each run carries a bloom filter of its keys, which
+// lets exact-match seeks skip runs that do not hold the key.
+//
+// Every entry in a memtable carries the sequence number of the commit
+// that wrote it.  A read transaction pins an LsmVersion (the memtables
+// and runs of the database) and the sequence number of the last commit,
+// and ignores entries written after it, so it sees a consistent snapshot
+// while other connections commit, flush and merge.
+//
+// There is one writer at a time per database.  A write transaction
+// collects its changes in a private write set, which is written to the
+// log and applied to the memtable on commit.
+// =======================================================================================
+
+typedef struct KVLsm KVLsm;
+typedef struct KVLsmCursor KVLsmCursor;
+
+struct LsmDb;
+
+// Defaults of the URI parameters, see KVStoreOpen(...) in "kvlsm.c"
+#define KVLSM_DEFAULT_MEMTABLE_SIZE   (4*1024*1024)
+#define KVLSM_DEFAULT_MERGE_THREADS   1
+#define KVLSM_DEFAULT_MERGE_WIDTH     4
+#define KVLSM_DEFAULT_BLOOM_BITS      10
+#define KVLSM_DEFAULT_BLOCK_SIZE      4096
+#define KVLSM_DEFAULT_BUSY_TIMEOUT    5000
+
+// A commit waits for the background threads while this many
+// frozen memtables are waiting to be written to runs.
+#define KVLSM_MAX_FROZEN_MEMTABLE     4
+
+// Runs are merged regardless of their sizes
+// once there are more than this many.
+#define KVLSM_MAX_RUN                 24
+
+// =======================================================================================
+// Memtable
+// =======================================================================================
+
+// Key of a memtable entry.  Versions of a key are ordered newest first.
+struct LsmMemKey {
+   std::string key;
+   uint64_t iSeq;
+};
+
+// Probe used to search a memtable without building an LsmMemKey
+struct LsmMemProbe {
+   std::string_view key;
+   uint64_t iSeq;
+};
+
+struct LsmMemKeyLess {
+   typedef void is_transparent;
+   template <class A, class B>
+   bool operator()(const A & a, const B & b) const
+   {
+      int c = std::string_view(a.key).compare(std::string_view(b.key));
+      if (c != 0) return c < 0;
+      return a.iSeq > b.iSeq;
+   }
+};
+
+struct LsmMemVal {
+   std::string data;
+   bool bDelete;
+};
+
+typedef std::map<LsmMemKey, LsmMemVal, LsmMemKeyLess> LsmMemMap;
+
+struct LsmMemTable {
+   // Held exclusively while a commit inserts entries,
+   // and shared by readers of the active memtable.
+   std::shared_mutex mutex;
+   LsmMemMap map;
+   size_t nByte;           // approximate memory used by the entries
+   uint64_t iLog;          // first log holding commits of this memtable
+
+   LsmMemTable(uint64_t a_iLog)
+      : nByte(0)
+      , iLog(a_iLog)
+   {
+   }
+};
+
+// =======================================================================================
+// Sorted runs, see "kvlsm_run.c"
+// =======================================================================================
+
+// A run file, mapped into memory.  A run that has been merged into
+// another is unlinked when the last version using it is released.
+struct LsmRun {
+   uint64_t iFile;         // the file is "run-<iFile>"
+   std::string zPath;
+   const uint8_t * aMap;
+   size_t nMap;
+   uint64_t nEntry;
+   uint64_t nBlock;
+   const uint8_t * aIndex; // block offsets, 8 bytes each
+   uint64_t iBlockEnd;     // end of the last block
+   const uint8_t * aBloom;
+   uint64_t nBloomBit;
+   uint32_t nHash;
+   bool bMerging;          // claimed by a merge, guarded by LsmDb::mutex
+   bool bDrop;             // unlink the file on destruction
+
+   LsmRun()
+      : iFile(0), aMap(nullptr), nMap(0), nEntry(0), nBlock(0)
+      , aIndex(nullptr), iBlockEnd(0), aBloom(nullptr), nBloomBit(0), nHash(0)
+      , bMerging(false), bDrop(false)
+   {
+   }
+   ~LsmRun();
+};
+
+// One entry of a run, as decoded by lsmRunDecode(...)
+struct LsmRunEntry {
+   const uint8_t * aKey;
+   size_t nKey;
+   const uint8_t * aData;
+   size_t nData;
+   bool bDelete;
+   size_t nSize;           // bytes used by the entry in the block
+};
+
+// Writes a run file entry by entry, in key order
+struct LsmRunWriter {
+   FILE * pFile;
+   std::string zPath;
+   size_t nBlockSize;
+   uint32_t nBloomBitPerKey;
+   uint64_t iOff;          // offset of the next byte written
+   uint64_t iBlock;        // offset of the current block
+   std::vector<uint64_t> aBlock;
+   std::vector<uint64_t> aHash;
+   std::string buf;
+
+   LsmRunWriter() : pFile(nullptr), nBlockSize(0), nBloomBitPerKey(0), iOff(0), iBlock(0) {}
+   ~LsmRunWriter();
+};
+
+int lsmRunWriterOpen(LsmRunWriter *, const char * zPath, size_t nBlockSize, uint32_t nBloomBitPerKey);
+int lsmRunWriterAdd(LsmRunWriter *, const uint8_t * aKey, size_t nKey, const uint8_t * aData, size_t nData, bool bDelete);
+int lsmRunWriterFinish(LsmRunWriter *, int bSync);
+int lsmRunOpen(const char * zPath, uint64_t iFile, std::shared_ptr<LsmRun> * ppRun);
+bool lsmRunMayContain(const LsmRun *, const uint8_t * aKey, size_t nKey);
+bool lsmRunDecode(const LsmRun *, uint64_t iOff, LsmRunEntry *);
+uint64_t lsmRunBlock(const LsmRun *, uint64_t iBlock);
+
+uint64_t lsmHash(const uint8_t * a, size_t n);
+int lsmPutVarint(std::string &, uint64_t);
+int lsmGetVarint(const uint8_t * a, const uint8_t * aEnd, uint64_t *);
+
+// =======================================================================================
+// Versions and the shared database object, see "kvlsm_engine.c"
+// =======================================================================================
+
+// The memtables and runs of a database at some point in time
+struct LsmVersion {
+   std::shared_ptr<LsmMemTable> pMem;                  // active memtable
+   std::vector<std::shared_ptr<LsmMemTable>> aFrozen;  // frozen memtables, newest first
+   std::vector<std::shared_ptr<LsmRun>> aRun;          // runs, newest first
+};
+
+// Configuration of a database, from the URI parameters of its first open
+struct LsmConfig {
+   size_t nMemtableSize;
+   int nMergeThread;
+   int nMergeWidth;
+   uint32_t nBloomBit;
+   size_t nBlockSize;
+   int eSync;              // 0, 1, 2 for OFF, NORMAL, FULL
+   int nBusyTimeout;       // ms
+};
+
+// Log record types
+#define KVLSM_LOG_WRITE      1   // a committed transaction
+#define KVLSM_LOG_PREPARE    2   // a prepared transaction ...
+#define KVLSM_LOG_COMMIT     3   // ... later committed
+#define KVLSM_LOG_ROLLBACK   4   // ... or rolled back
+
+struct LsmDb {
+   std::string zDir;
+   LsmConfig config;
+   int nRef;               // connections, guarded by the registry mutex
+
+   // Guards everything below, except the log,
+   // which only the writer uses.
+   std::mutex mutex;
+   std::condition_variable cond;   // signalled when the version or the work changes
+   std::shared_ptr<LsmVersion> pVersion;
+   uint64_t iSeq;          // sequence number of the last commit
+   uint32_t iMeta;         // schema cookie
+   uint64_t iNextFile;     // next log or run file number
+   uint64_t nCommit;       // commits by all connections, see SQLITE4_KVCTRL_DATA_VERSION
+   bool bFlushing;         // a frozen memtable is being written
+   int nMerging;           // merges in progress
+   int rcBackground;       // first error of a background flush or merge
+   std::atomic<bool> bShutdown;
+   std::vector<std::thread> aWorker;
+
+   // The write lock.  It is not a std::mutex because a connection
+   // may commit on a thread other than the one which began the transaction.
+   std::mutex writerMutex;
+   std::condition_variable writerCond;
+   void * pWriter;
+
+   // The log, used by the writer only
+   int fdLog;
+   uint64_t iLogFile;
+
+   LsmDb()
+      : nRef(0), iSeq(0), iMeta(0), iNextFile(1), nCommit(0)
+      , bFlushing(false), nMerging(0), rcBackground(SQLITE4_OK), bShutdown(false)
+      , pWriter(nullptr), fdLog(-1), iLogFile(0)
+   {
+      memset(&config, 0, sizeof(config));
+   }
+};
+
+int lsmDbOpen(const char * zDir, const LsmConfig * pConfig, LsmDb ** ppDb);
+void lsmDbClose(LsmDb *);
+int lsmDbLockWriter(LsmDb *, void * pOwner);
+void lsmDbUnlockWriter(LsmDb *, void * pOwner);
+void lsmDbSnapshot(LsmDb *, std::shared_ptr<LsmVersion> * ppVersion, uint64_t * piSeq);
+int lsmDbPrepare(LsmDb *, uint64_t iSeq, const char * zXid, const std::string & body, int eSync);
+int lsmDbCommit(LsmDb *, uint64_t iSeq, const std::string & body, bool bPrepared, int eSync);
+int lsmDbAbort(LsmDb *, uint64_t iSeq);
+int lsmDbFreeze(LsmDb *);
+int lsmDbWait(LsmDb *);
+int lsmDbMerge(LsmDb *);
+int lsmDbCheckpoint(LsmDb *);
+int lsmEncodeEntry(std::string &, const uint8_t * aKey, size_t nKey, const uint8_t * aData, size_t nData, bool bDelete);
+
+// =======================================================================================
+// Connection and cursor, see "kvlsm_common.c"
+// =======================================================================================
+
+struct LsmWriteVal {
+   std::string data;
+   bool bDelete;
+};
+
+typedef std::map<std::string, LsmWriteVal, std::less<>> LsmWriteMap;
+
+// Undo record of a change made in a nested write transaction
+struct LsmUndo {
+   std::string key;
+   bool bExisted;
+   LsmWriteVal old;
+};
+
+#define SQLITE4_KVLSMBASE_MAGIC  0x1c3a61d5
+struct KVLsm
+{
+   sqlite4_kvstore base;
+
+   unsigned openFlags;   /* Flags used at open */
+   int nCursor;          /* Number of outstanding cursors */
+   int iMagicKVLsmBase;  /* Magic number of sanity */
+   LsmDb * pDb;
+
+   // Snapshot read by the transaction, if one is open
+   std::shared_ptr<LsmVersion> pVersion;
+   uint64_t iSeq;
+   uint64_t iSnapGen;         // changed whenever the snapshot is replaced
+
+   // Changes of the write transaction.  aUndo[i] holds the undo
+   // records of transaction level i+3; level 2 needs none.
+   LsmWriteMap aWrite;
+   uint64_t iWriteGen;        // changed by every change of aWrite
+   std::vector<std::vector<LsmUndo>> aUndo;
+   bool bWriter;              // holds the write lock of pDb
+   bool bPrepared;            // a prepare record has been logged
+   bool bMetaChanged;
+   uint32_t iMeta;            // schema cookie written by this transaction
+
+   // Synchronous level of commits (0, 1, 2 for OFF, NORMAL, FULL).
+   // See SQLITE4_KVCTRL_SYNCHRONOUS.
+   int eSync;
+
+   // Write transactions committed by this connection;
+   // see SQLITE4_KVCTRL_DATA_VERSION.
+   uint64_t nOwnCommit;
+
+   KVLsm()
+      : openFlags(0)
+      , nCursor(0)
+      , iMagicKVLsmBase(SQLITE4_KVLSMBASE_MAGIC)
+      , pDb(nullptr)
+      , iSeq(0)
+      , iSnapGen(0)
+      , iWriteGen(0)
+      , bWriter(false)
+      , bPrepared(false)
+      , bMetaChanged(false)
+      , iMeta(0)
+      , eSync(1)
+      , nOwnCommit(0)
+   {
+      memset(&base, 0, sizeof(base));
+   }
+};
+
+// Iterates the visible entries of one source of a cursor: the write set,
+// a memtable or a run.  Each key appears once, with its newest version,
+// which may be a deletion.  See "kvlsm_common.c".
+class LsmIter {
+public:
+   virtual ~LsmIter() {}
+
+   // Move to the first entry with a key >= k (> k if bExcl)
+   virtual void seekGE(std::string_view k, bool bExcl) = 0;
+   // Move to the last entry with a key <= k (< k if bExcl)
+   virtual void seekLE(std::string_view k, bool bExcl) = 0;
+   virtual void next() = 0;
+   virtual void prev() = 0;
+   virtual bool valid() const = 0;
+   virtual std::string_view key() const = 0;
+   virtual bool isDelete() const = 0;
+   virtual std::string_view data() const = 0;
+
+   // Look up k alone, without moving.  True if the source has an entry
+   // for k, which is written to *pbDelete and *pData.
+   virtual bool get(std::string_view k, bool * pbDelete, std::string_view * pData) = 0;
+};
+
+#define SQLITE4_KVLSMCUR_MAGIC   0x7e21b04f
+struct KVLsmCursor {
+   KVCursor base;        /* Base class. Must be first */
+   KVLsm *pOwner;        /* The connection that owns this cursor */
+   int iMagicKVLsmCur;   /* Magic number for sanity */
+
+   std::shared_ptr<LsmVersion> pVersion;   // snapshot iterated by the cursor
+   uint64_t iSeq;
+   uint64_t iSnapGen;
+   uint64_t iWriteGen;
+
+   // One iterator per source, newest first: the write set,
+   // the memtables and the runs of pVersion.
+   std::vector<std::unique_ptr<LsmIter>> aIter;
+
+   int eMode;            // KVLSM_CURSOR_xxx
+   std::string key;      // key of the current entry
+   const uint8_t * aData;
+   size_t nData;
+   std::string dataBuf;  // copy of data taken from the write set
+};
+
+#define KVLSM_CURSOR_NONE     0   // not pointing at an entry
+#define KVLSM_CURSOR_POINT    1   // found by an exact match, other iterators not positioned
+#define KVLSM_CURSOR_FORWARD  2   // every iterator at the first entry > key, or at key
+#define KVLSM_CURSOR_REVERSE  3   // every iterator at the last entry < key, or at key
+
+extern const sqlite4_kv_methods kvlsmMethods;
+
+// Registry of open databases by name, see "kvlsm.c"
+int kvlsmAcquireDb(const char * zName, LsmDb ** ppDb);
+void kvlsmReleaseDb(LsmDb *);
+
+#endif /* end of #ifndef _SQLITE4_KVLSM_COMMON_H_ */
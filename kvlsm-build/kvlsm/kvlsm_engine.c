@@ -0,0 +1,958 @@
+#include "kvlsm_common.h"
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+// =======================================================================================
+// The shared database object: the log, the manifest, memtables,
+// versions, and the background threads which flush and merge.
+//
+// A log record is:
+//
+//    type (4 bytes), body size (4 bytes), sequence number (8 bytes),
+//    body, checksum (4 bytes) of everything before it
+//
+// The body of a KVLSM_LOG_WRITE record is the schema cookie (4 bytes)
+// followed by the changes, encoded as run entries.  A KVLSM_LOG_PREPARE
+// record is a varint size and the bytes of the transaction id passed to
+// xCommitPhaseOneXID, followed by such a body.  Recovery applies a
+// prepared transaction only if the KVLSM_LOG_COMMIT record with the same
+// sequence number follows; a transaction left prepared is rolled back.
+//
+// The manifest is a text file written under a temporary name and renamed.
+// =======================================================================================
+
+#define KVLSM_LOG_HDRSIZE     16
+
+static std::string lsmFileName(LsmDb * p, const char * zPrefix, uint64_t iFile)
+{
+   char zBuf[64];
+   snprintf(zBuf, sizeof(zBuf), "/%s-%06llu", zPrefix, (unsigned long long)iFile);
+   return p->zDir + zBuf;
+}
+
+static void lsmPutU32(std::string & s, uint32_t v)
+{
+   char a[4] = { (char)(v >> 24), (char)(v >> 16), (char)(v >> 8), (char)v };
+   s.append(a, 4);
+}
+
+static uint32_t lsmGetU32(const uint8_t * a)
+{
+   return ((uint32_t)a[0] << 24) | ((uint32_t)a[1] << 16) | ((uint32_t)a[2] << 8) | a[3];
+}
+
+static uint32_t lsmLogChecksum(const uint8_t * a, size_t n)
+{
+   // Fletcher-style, two running sums
+   uint32_t s1 = 1, s2 = 0;
+   for (size_t i = 0; i < n; ++i)
+   {
+      s1 += a[i];
+      s2 += s1;
+   }
+   return (s2 << 16) ^ s1 ^ (uint32_t)n;
+}
+
+static void lsmSyncDir(LsmDb * p)
+{
+   int fd = open(p->zDir.c_str(), O_RDONLY);
+   if (fd >= 0)
+   {
+      fsync(fd);
+      close(fd);
+   }
+}
+
+static int lsmWriteAll(int fd, const char * a, size_t n)
+{
+   while (n > 0)
+   {
+      ssize_t nWrite = write(fd, a, n);
+      if (nWrite < 0)
+      {
+         if (errno == EINTR) continue;
+         return SQLITE4_IOERR;
+      }
+      a += nWrite;
+      n -= (size_t)nWrite;
+   }
+   return SQLITE4_OK;
+}
+
+// =======================================================================================
+// Log
+// =======================================================================================
+
+static int lsmLogAppend(LsmDb * p, int eType, uint64_t iSeq, const char * aBody, size_t nBody, bool bSync)
+{
+   if (p->fdLog < 0) return SQLITE4_IOERR;
+   std::string rec;
+   rec.reserve(KVLSM_LOG_HDRSIZE + nBody + 4);
+   lsmPutU32(rec, (uint32_t)eType);
+   lsmPutU32(rec, (uint32_t)nBody);
+   lsmPutU32(rec, (uint32_t)(iSeq >> 32));
+   lsmPutU32(rec, (uint32_t)iSeq);
+   rec.append(aBody, nBody);
+   lsmPutU32(rec, lsmLogChecksum((const uint8_t *)rec.data(), rec.size()));
+   int rc = lsmWriteAll(p->fdLog, rec.data(), rec.size());
+   if (rc == SQLITE4_OK && bSync && fdatasync(p->fdLog) != 0)
+   {
+      rc = SQLITE4_IOERR;
+   }
+   if (rc != SQLITE4_OK)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed lsmLogAppend() : cannot write log-%06llu of '%s'\n", (unsigned long long)p->iLogFile, p->zDir.c_str());
+   }
+   return rc;
+}
+
+// Start a new log file.  Called with p->mutex held.
+static int lsmLogOpenNew(LsmDb * p)
+{
+   uint64_t iFile = p->iNextFile++;
+   std::string zPath = lsmFileName(p, "log", iFile);
+   int fd = open(zPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+   if (fd < 0)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed lsmLogOpenNew() : cannot create '%s'\n", zPath.c_str());
+      return SQLITE4_CANTOPEN;
+   }
+   if (p->fdLog >= 0)
+   {
+      if (p->config.eSync >= 1) fdatasync(p->fdLog);
+      close(p->fdLog);
+   }
+   p->fdLog = fd;
+   p->iLogFile = iFile;
+   if (p->config.eSync >= 2) lsmSyncDir(p);
+   return SQLITE4_OK;
+}
+
+// Apply the changes of a log record body to a memtable,
+// which the caller has locked or owns.
+static int lsmApplyBody(LsmMemTable * pMem, uint64_t iSeq, const uint8_t * a, size_t n, uint32_t * piMeta)
+{
+   if (n < 4) return SQLITE4_CORRUPT;
+   *piMeta = lsmGetU32(a);
+   const uint8_t * aEnd = a + n;
+   a += 4;
+   try
+   {
+      while (a < aEnd)
+      {
+         uint64_t nKey, nData;
+         int n1 = lsmGetVarint(a, aEnd, &nKey);
+         if (n1 == 0) return SQLITE4_CORRUPT;
+         int n2 = lsmGetVarint(a + n1, aEnd, &nData);
+         if (n2 == 0) return SQLITE4_CORRUPT;
+         a += n1 + n2;
+         bool bDelete = (nData == 0);
+         if (nData) nData--;
+         if (nKey > (uint64_t)(aEnd - a) || nData > (uint64_t)(aEnd - a) - nKey) return SQLITE4_CORRUPT;
+
+         LsmMemKey oKey{ std::string((const char *)a, (size_t)nKey), iSeq };
+         LsmMemVal oVal{ std::string((const char *)a + nKey, (size_t)nData), bDelete };
+         pMem->nByte += nKey + nData + 96;
+         pMem->map.emplace(std::move(oKey), std::move(oVal));
+         a += nKey + nData;
+      }
+   }
+   catch (std::bad_alloc &)
+   {
+      return SQLITE4_NOMEM;
+   }
+   return SQLITE4_OK;
+}
+
+// =======================================================================================
+// Manifest
+// =======================================================================================
+
+// The oldest log holding commits not yet written to a run
+static uint64_t lsmFirstLog(const LsmVersion & v)
+{
+   if (!v.aFrozen.empty()) return v.aFrozen.back()->iLog;
+   return v.pMem->iLog;
+}
+
+// Write the manifest describing version v.  Called with p->mutex held.
+static int lsmWriteManifest(LsmDb * p, const LsmVersion & v)
+{
+   std::string zTmp = p->zDir + "/MANIFEST-tmp";
+   std::string zPath = p->zDir + "/MANIFEST";
+   FILE * pFile = fopen(zTmp.c_str(), "w");
+   if (!pFile) return SQLITE4_CANTOPEN;
+   fprintf(pFile, "KVLSM 1\n");
+   fprintf(pFile, "next %llu\n", (unsigned long long)p->iNextFile);
+   fprintf(pFile, "log %llu\n", (unsigned long long)lsmFirstLog(v));
+   fprintf(pFile, "seq %llu\n", (unsigned long long)p->iSeq);
+   fprintf(pFile, "meta %u\n", p->iMeta);
+   for (auto & pRun : v.aRun)
+   {
+      fprintf(pFile, "run %llu\n", (unsigned long long)pRun->iFile);
+   }
+   fprintf(pFile, "end\n");
+   int rc = SQLITE4_OK;
+   if (fflush(pFile) != 0 || (p->config.eSync >= 1 && fdatasync(fileno(pFile)) != 0))
+   {
+      rc = SQLITE4_IOERR;
+   }
+   fclose(pFile);
+   if (rc == SQLITE4_OK && rename(zTmp.c_str(), zPath.c_str()) != 0)
+   {
+      rc = SQLITE4_IOERR;
+   }
+   if (rc == SQLITE4_OK && p->config.eSync >= 1)
+   {
+      lsmSyncDir(p);
+   }
+   if (rc != SQLITE4_OK)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed lsmWriteManifest() : cannot write '%s'\n", zPath.c_str());
+      unlink(zTmp.c_str());
+   }
+   return rc;
+}
+
+struct LsmManifest {
+   uint64_t iNext;
+   uint64_t iLog;
+   uint64_t iSeq;
+   uint32_t iMeta;
+   std::vector<uint64_t> aRun;
+};
+
+// Read the manifest.  Return SQLITE4_NOTFOUND if there is none.
+static int lsmReadManifest(LsmDb * p, LsmManifest * pMan)
+{
+   std::string zPath = p->zDir + "/MANIFEST";
+   FILE * pFile = fopen(zPath.c_str(), "r");
+   if (!pFile) return SQLITE4_NOTFOUND;
+   char zLine[128];
+   char zWord[32];
+   unsigned long long v;
+   bool bHeader = false, bEnd = false;
+   while (fgets(zLine, sizeof(zLine), pFile))
+   {
+      if (!bHeader)
+      {
+         bHeader = (strcmp(zLine, "KVLSM 1\n") == 0);
+         if (!bHeader) break;
+         continue;
+      }
+      if (strcmp(zLine, "end\n") == 0)
+      {
+         bEnd = true;
+         break;
+      }
+      if (sscanf(zLine, "%31s %llu", zWord, &v) != 2) break;
+      if (strcmp(zWord, "next") == 0) pMan->iNext = v;
+      else if (strcmp(zWord, "log") == 0) pMan->iLog = v;
+      else if (strcmp(zWord, "seq") == 0) pMan->iSeq = v;
+      else if (strcmp(zWord, "meta") == 0) pMan->iMeta = (uint32_t)v;
+      else if (strcmp(zWord, "run") == 0) pMan->aRun.push_back(v);
+      else break;
+   }
+   fclose(pFile);
+   if (!bEnd)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed lsmReadManifest() : '%s' is corrupt\n", zPath.c_str());
+      return SQLITE4_CORRUPT;
+   }
+   return SQLITE4_OK;
+}
+
+// =======================================================================================
+// Recovery
+// =======================================================================================
+
+// Replay log file zPath into pMem.  A torn or corrupt record ends the log.
+static int lsmReplayLog(LsmDb * p, const std::string & zPath, LsmMemTable * pMem,
+   std::map<uint64_t, std::string> & aPrepared)
+{
+   FILE * pFile = fopen(zPath.c_str(), "rb");
+   if (!pFile) return SQLITE4_CANTOPEN;
+   std::string log;
+   char aBuf[65536];
+   size_t n;
+   while ((n = fread(aBuf, 1, sizeof(aBuf), pFile)) > 0)
+   {
+      log.append(aBuf, n);
+   }
+   fclose(pFile);
+
+   const uint8_t * a = (const uint8_t *)log.data();
+   size_t iOff = 0;
+   int rc = SQLITE4_OK;
+   while (rc == SQLITE4_OK && log.size() - iOff >= KVLSM_LOG_HDRSIZE + 4)
+   {
+      const uint8_t * aRec = a + iOff;
+      uint32_t eType = lsmGetU32(aRec);
+      uint32_t nBody = lsmGetU32(aRec + 4);
+      uint64_t iSeq = ((uint64_t)lsmGetU32(aRec + 8) << 32) | lsmGetU32(aRec + 12);
+      if (nBody > log.size() - iOff - KVLSM_LOG_HDRSIZE - 4) break;
+      size_t nRec = KVLSM_LOG_HDRSIZE + nBody;
+      if (lsmGetU32(aRec + nRec) != lsmLogChecksum(aRec, nRec)) break;
+      const uint8_t * aBody = aRec + KVLSM_LOG_HDRSIZE;
+
+      switch (eType)
+      {
+      case KVLSM_LOG_WRITE:
+         rc = lsmApplyBody(pMem, iSeq, aBody, nBody, &p->iMeta);
+         break;
+      case KVLSM_LOG_PREPARE:
+         aPrepared[iSeq] = std::string((const char *)aBody, nBody);
+         break;
+      case KVLSM_LOG_COMMIT:
+      {
+         auto it = aPrepared.find(iSeq);
+         if (it != aPrepared.end())
+         {
+            const uint8_t * aPrep = (const uint8_t *)it->second.data();
+            const uint8_t * aPrepEnd = aPrep + it->second.size();
+            uint64_t nXid = 0;
+            int nVarint = lsmGetVarint(aPrep, aPrepEnd, &nXid);
+            if (nVarint == 0 || nXid > (uint64_t)(aPrepEnd - aPrep - nVarint))
+            {
+               rc = SQLITE4_CORRUPT;
+            }
+            else
+            {
+               aPrep += nVarint + nXid;
+               rc = lsmApplyBody(pMem, iSeq, aPrep, aPrepEnd - aPrep, &p->iMeta);
+            }
+            aPrepared.erase(it);
+         }
+         break;
+      }
+      case KVLSM_LOG_ROLLBACK:
+         aPrepared.erase(iSeq);
+         break;
+      default:
+         rc = SQLITE4_CORRUPT;
+         break;
+      }
+      if (iSeq > p->iSeq) p->iSeq = iSeq;
+      iOff += nRec + 4;
+   }
+   return rc;
+}
+
+static void lsmWorkerMain(LsmDb * p);
+
+int lsmDbOpen(const char * zDir, const LsmConfig * pConfig, LsmDb ** ppDb)
+{
+   *ppDb = nullptr;
+   if (mkdir(zDir, 0755) != 0 && errno != EEXIST)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed lsmDbOpen() : cannot create directory '%s'\n", zDir);
+      return SQLITE4_CANTOPEN;
+   }
+
+   std::unique_ptr<LsmDb> p(new LsmDb);
+   p->zDir = zDir;
+   p->config = *pConfig;
+
+   // Manifest and runs
+   LsmManifest man = { 1, 0, 0, 0, {} };
+   int rc = lsmReadManifest(p.get(), &man);
+   if (rc == SQLITE4_NOTFOUND) rc = SQLITE4_OK;
+   if (rc != SQLITE4_OK) return rc;
+   p->iNextFile = man.iNext;
+   p->iSeq = man.iSeq;
+   p->iMeta = man.iMeta;
+
+   std::shared_ptr<LsmVersion> pVersion = std::make_shared<LsmVersion>();
+   std::set<uint64_t> aLive;
+   for (uint64_t iFile : man.aRun)
+   {
+      std::shared_ptr<LsmRun> pRun;
+      rc = lsmRunOpen(lsmFileName(p.get(), "run", iFile).c_str(), iFile, &pRun);
+      if (rc != SQLITE4_OK) return rc;
+      pVersion->aRun.push_back(pRun);
+      aLive.insert(iFile);
+   }
+
+   // Remove the files of interrupted flushes and merges, and logs
+   // already written to runs; collect the logs to replay.
+   std::vector<uint64_t> aLog;
+   DIR * pDir = opendir(zDir);
+   if (!pDir) return SQLITE4_CANTOPEN;
+   struct dirent * pEntry;
+   while ((pEntry = readdir(pDir)) != nullptr)
+   {
+      unsigned long long iFile;
+      char c;
+      std::string zPath = p->zDir + "/" + pEntry->d_name;
+      if (sscanf(pEntry->d_name, "run-%llu%c", &iFile, &c) == 1)
+      {
+         if (!aLive.count(iFile)) unlink(zPath.c_str());
+      }
+      else if (sscanf(pEntry->d_name, "log-%llu%c", &iFile, &c) == 1)
+      {
+         if (iFile < man.iLog) unlink(zPath.c_str());
+         else aLog.push_back(iFile);
+      }
+      else if (strcmp(pEntry->d_name, "MANIFEST-tmp") == 0)
+      {
+         unlink(zPath.c_str());
+         continue;
+      }
+      else
+      {
+         continue;
+      }
+      if (iFile >= p->iNextFile) p->iNextFile = iFile + 1;
+   }
+   closedir(pDir);
+   std::sort(aLog.begin(), aLog.end());
+
+   // Replay the logs into the first memtable.  It is written to a run
+   // like any other, after which the replayed logs are deleted.
+   std::map<uint64_t, std::string> aPrepared;
+   std::shared_ptr<LsmMemTable> pMem = std::make_shared<LsmMemTable>(aLog.empty() ? 0 : aLog[0]);
+   for (uint64_t iLog : aLog)
+   {
+      rc = lsmReplayLog(p.get(), lsmFileName(p.get(), "log", iLog), pMem.get(), aPrepared);
+      if (rc != SQLITE4_OK) return rc;
+   }
+   for (auto & prepared : aPrepared)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("lsmDbOpen() : '%s' : rolling back transaction %llu, prepared but not committed\n",
+         zDir, (unsigned long long)prepared.first);
+   }
+
+   rc = lsmLogOpenNew(p.get());
+   if (rc != SQLITE4_OK) return rc;
+   if (aLog.empty()) pMem->iLog = p->iLogFile;
+   pVersion->pMem = pMem;
+   p->pVersion = pVersion;
+   rc = lsmWriteManifest(p.get(), *pVersion);
+   if (rc != SQLITE4_OK)
+   {
+      close(p->fdLog);
+      return rc;
+   }
+
+   for (int i = 0; i < p->config.nMergeThread; ++i)
+   {
+      p->aWorker.emplace_back(lsmWorkerMain, p.get());
+   }
+   *ppDb = p.release();
+   return SQLITE4_OK;
+}
+
+void lsmDbClose(LsmDb * p)
+{
+   {
+      std::lock_guard<std::mutex> oLock(p->mutex);
+      p->bShutdown = true;
+      p->cond.notify_all();
+   }
+   for (auto & oWorker : p->aWorker)
+   {
+      oWorker.join();
+   }
+   if (p->fdLog >= 0)
+   {
+      if (p->config.eSync >= 1) fdatasync(p->fdLog);
+      close(p->fdLog);
+   }
+   delete p;
+}
+
+// =======================================================================================
+// Transactions
+// =======================================================================================
+
+int lsmDbLockWriter(LsmDb * p, void * pOwner)
+{
+   std::unique_lock<std::mutex> oLock(p->writerMutex);
+   if (!p->writerCond.wait_for(oLock, std::chrono::milliseconds(p->config.nBusyTimeout),
+      [p] { return p->pWriter == nullptr; }))
+   {
+      return SQLITE4_BUSY;
+   }
+   p->pWriter = pOwner;
+   return SQLITE4_OK;
+}
+
+void lsmDbUnlockWriter(LsmDb * p, void * pOwner)
+{
+   std::lock_guard<std::mutex> oLock(p->writerMutex);
+   assert(p->pWriter == pOwner);
+   p->pWriter = nullptr;
+   p->writerCond.notify_one();
+}
+
+void lsmDbSnapshot(LsmDb * p, std::shared_ptr<LsmVersion> * ppVersion, uint64_t * piSeq)
+{
+   std::lock_guard<std::mutex> oLock(p->mutex);
+   *ppVersion = p->pVersion;
+   *piSeq = p->iSeq;
+}
+
+// Log a prepared transaction.  The caller holds the write lock.
+int lsmDbPrepare(LsmDb * p, uint64_t iSeq, const char * zXid, const std::string & body, int eSync)
+{
+   std::string rec;
+   size_t nXid = zXid ? strlen(zXid) : 0;
+   lsmPutVarint(rec, nXid);
+   rec.append(zXid ? zXid : "", nXid);
+   rec.append(body);
+   return lsmLogAppend(p, KVLSM_LOG_PREPARE, iSeq, rec.data(), rec.size(), eSync >= 1);
+}
+
+int lsmDbAbort(LsmDb * p, uint64_t iSeq)
+{
+   return lsmLogAppend(p, KVLSM_LOG_ROLLBACK, iSeq, "", 0, false);
+}
+
+// Freeze the active memtable.  Called with p->mutex and the write lock held.
+static int lsmFreeze(LsmDb * p)
+{
+   int rc = lsmLogOpenNew(p);
+   if (rc != SQLITE4_OK) return rc;
+   std::shared_ptr<LsmVersion> pNew = std::make_shared<LsmVersion>(*p->pVersion);
+   pNew->aFrozen.insert(pNew->aFrozen.begin(), pNew->pMem);
+   pNew->pMem = std::make_shared<LsmMemTable>(p->iLogFile);
+   p->pVersion = pNew;
+   p->cond.notify_all();
+   return SQLITE4_OK;
+}
+
+static void lsmWorkInline(LsmDb * p);
+
+// Commit transaction iSeq, whose changes are body, or, if bPrepared,
+// the body of the prepare record logged before.  The caller holds the
+// write lock.
+int lsmDbCommit(LsmDb * p, uint64_t iSeq, const std::string & body, bool bPrepared, int eSync)
+{
+   int rc;
+   if (bPrepared)
+   {
+      rc = lsmLogAppend(p, KVLSM_LOG_COMMIT, iSeq, "", 0, eSync >= 2);
+   }
+   else
+   {
+      rc = lsmLogAppend(p, KVLSM_LOG_WRITE, iSeq, body.data(), body.size(), eSync >= 2);
+   }
+   if (rc != SQLITE4_OK) return rc;
+
+   // Only the writer replaces the active memtable, so it may be used
+   // outside of p->mutex.  Readers do not see the new entries until
+   // p->iSeq is set below.
+   std::shared_ptr<LsmMemTable> pMem;
+   {
+      std::lock_guard<std::mutex> oLock(p->mutex);
+      pMem = p->pVersion->pMem;
+   }
+   uint32_t iMeta = 0;
+   {
+      std::unique_lock<std::shared_mutex> oMemLock(pMem->mutex);
+      rc = lsmApplyBody(pMem.get(), iSeq, (const uint8_t *)body.data(), body.size(), &iMeta);
+   }
+   if (rc != SQLITE4_OK) return rc;
+
+   bool bFrozen = false;
+   {
+      std::unique_lock<std::mutex> oLock(p->mutex);
+      p->iSeq = iSeq;
+      p->iMeta = iMeta;
+      p->nCommit++;
+      if (pMem->nByte >= p->config.nMemtableSize)
+      {
+         rc = lsmFreeze(p);
+         bFrozen = (rc == SQLITE4_OK);
+      }
+      // Wait for the background threads if they have fallen behind
+      while (p->config.nMergeThread > 0 && !p->bShutdown && p->rcBackground == SQLITE4_OK
+         && p->pVersion->aFrozen.size() > KVLSM_MAX_FROZEN_MEMTABLE)
+      {
+         p->cond.wait(oLock);
+      }
+   }
+   if (bFrozen && p->config.nMergeThread == 0)
+   {
+      lsmWorkInline(p);
+   }
+   return rc;
+}
+
+// Freeze the active memtable, unless it is empty.  The caller holds the write lock.
+int lsmDbFreeze(LsmDb * p)
+{
+   int rc = SQLITE4_OK;
+   {
+      std::lock_guard<std::mutex> oLock(p->mutex);
+      if (!p->pVersion->pMem->map.empty())
+      {
+         rc = lsmFreeze(p);
+      }
+   }
+   if (rc == SQLITE4_OK && p->config.nMergeThread == 0)
+   {
+      lsmWorkInline(p);
+   }
+   return rc;
+}
+
+// Make every commit so far durable and record the current runs.
+// The caller holds the write lock.
+int lsmDbCheckpoint(LsmDb * p)
+{
+   if (p->fdLog >= 0 && fdatasync(p->fdLog) != 0) return SQLITE4_IOERR;
+   std::lock_guard<std::mutex> oLock(p->mutex);
+   return lsmWriteManifest(p, *p->pVersion);
+}
+
+// =======================================================================================
+// Flush and merge
+// =======================================================================================
+
+// Write the oldest frozen memtable to a new run.
+// Called, and returns, with p->mutex held by oLock.
+static int lsmDoFlush(LsmDb * p, std::unique_lock<std::mutex> & oLock)
+{
+   std::shared_ptr<LsmMemTable> pMem = p->pVersion->aFrozen.back();
+   uint64_t iFile = p->iNextFile++;
+   p->bFlushing = true;
+   oLock.unlock();
+
+   // Each key is written once, with its newest version.  Deleted keys
+   // are kept, as older runs may hold them.
+   std::string zPath = lsmFileName(p, "run", iFile);
+   std::shared_ptr<LsmRun> pRun;
+   int rc;
+   {
+      LsmRunWriter oWriter;
+      rc = lsmRunWriterOpen(&oWriter, zPath.c_str(), p->config.nBlockSize, p->config.nBloomBit);
+      const std::string * pPrev = nullptr;
+      for (auto it = pMem->map.begin(); rc == SQLITE4_OK && it != pMem->map.end(); ++it)
+      {
+         if (pPrev && *pPrev == it->first.key) continue;
+         pPrev = &it->first.key;
+         rc = lsmRunWriterAdd(&oWriter, (const uint8_t *)it->first.key.data(), it->first.key.size(),
+            (const uint8_t *)it->second.data.data(), it->second.data.size(), it->second.bDelete);
+      }
+      if (rc == SQLITE4_OK) rc = lsmRunWriterFinish(&oWriter, p->config.eSync >= 1);
+   }
+   if (rc == SQLITE4_OK) rc = lsmRunOpen(zPath.c_str(), iFile, &pRun);
+
+   oLock.lock();
+   if (rc == SQLITE4_OK)
+   {
+      std::shared_ptr<LsmVersion> pNew = std::make_shared<LsmVersion>(*p->pVersion);
+      assert(pNew->aFrozen.back() == pMem);
+      pNew->aFrozen.pop_back();
+      pNew->aRun.insert(pNew->aRun.begin(), pRun);
+      rc = lsmWriteManifest(p, *pNew);
+      if (rc == SQLITE4_OK)
+      {
+         // The logs of the memtable are no longer needed
+         uint64_t iFirst = lsmFirstLog(*pNew);
+         for (uint64_t iLog = pMem->iLog; iLog < iFirst; ++iLog)
+         {
+            unlink(lsmFileName(p, "log", iLog).c_str());
+         }
+         p->pVersion = pNew;
+      }
+      else
+      {
+         pRun->bDrop = true;
+      }
+   }
+   if (rc != SQLITE4_OK)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed lsmDoFlush() : '%s' : error %d\n", p->zDir.c_str(), rc);
+      p->rcBackground = rc;
+   }
+   p->bFlushing = false;
+   p->cond.notify_all();
+   return rc;
+}
+
+// Choose runs to merge: a sequence of consecutive runs, none of them
+// claimed by another merge, in which each run is at most twice as large
+// as the newer runs together, if there are at least merge_width of them.
+// Once there are more than KVLSM_MAX_RUN runs, the newest merge_width
+// unclaimed consecutive runs are merged whatever their sizes.
+// Called with p->mutex held.
+static bool lsmPickMerge(LsmDb * p, std::vector<std::shared_ptr<LsmRun>> & aIn, bool & bBottom, bool bAll)
+{
+   const std::vector<std::shared_ptr<LsmRun>> & aRun = p->pVersion->aRun;
+   size_t n = aRun.size();
+   size_t nWidth = (size_t)std::max(2, p->config.nMergeWidth);
+   aIn.clear();
+   if (bAll)
+   {
+      // Every run, for SQLITE4_KVCTRL_LSM_MERGE
+      if (n < 2 || p->nMerging) return false;
+      aIn = aRun;
+   }
+   for (size_t s = 0; aIn.empty() && s < n; ++s)
+   {
+      if (aRun[s]->bMerging) continue;
+      uint64_t nTotal = aRun[s]->nMap;
+      size_t e = s + 1;
+      while (e < n && !aRun[e]->bMerging && aRun[e]->nMap <= 2 * nTotal)
+      {
+         nTotal += aRun[e]->nMap;
+         e++;
+      }
+      if (e - s >= nWidth)
+      {
+         aIn.assign(aRun.begin() + s, aRun.begin() + e);
+      }
+   }
+   if (aIn.empty() && n > KVLSM_MAX_RUN)
+   {
+      for (size_t s = 0; aIn.empty() && s + nWidth <= n; ++s)
+      {
+         size_t e = s;
+         while (e < s + nWidth && !aRun[e]->bMerging) e++;
+         if (e == s + nWidth) aIn.assign(aRun.begin() + s, aRun.begin() + e);
+      }
+   }
+   if (aIn.empty()) return false;
+   bBottom = (aIn.back() == aRun.back());
+   for (auto & pRun : aIn) pRun->bMerging = true;
+   return true;
+}
+
+// Reads the entries of one run in order, for a merge
+struct LsmMergeInput {
+   const LsmRun * pRun;
+   uint64_t iBlock;
+   uint64_t iOff;
+   uint64_t iEnd;
+   LsmRunEntry entry;
+   bool bValid;
+
+   void load()
+   {
+      while (iOff >= iEnd)
+      {
+         if (++iBlock >= pRun->nBlock)
+         {
+            bValid = false;
+            return;
+         }
+         iOff = lsmRunBlock(pRun, iBlock);
+         iEnd = iBlock + 1 < pRun->nBlock ? lsmRunBlock(pRun, iBlock + 1) : pRun->iBlockEnd;
+      }
+      bValid = lsmRunDecode(pRun, iOff, &entry);
+   }
+};
+
+// Merge runs aIn, consecutive and newest first, into one new run.
+// Deleted keys are dropped if bBottom, as no older run remains.
+// Called, and returns, with p->mutex held by oLock.
+static int lsmDoMerge(LsmDb * p, std::unique_lock<std::mutex> & oLock,
+   const std::vector<std::shared_ptr<LsmRun>> & aIn, bool bBottom)
+{
+   uint64_t iFile = p->iNextFile++;
+   p->nMerging++;
+   oLock.unlock();
+
+   std::string zPath = lsmFileName(p, "run", iFile);
+   std::vector<LsmMergeInput> aInput(aIn.size());
+   for (size_t i = 0; i < aIn.size(); ++i)
+   {
+      LsmMergeInput & in = aInput[i];
+      in.pRun = aIn[i].get();
+      in.iBlock = 0;
+      in.bValid = in.pRun->nBlock > 0;
+      if (in.bValid)
+      {
+         in.iOff = lsmRunBlock(in.pRun, 0);
+         in.iEnd = in.pRun->nBlock > 1 ? lsmRunBlock(in.pRun, 1) : in.pRun->iBlockEnd;
+         in.load();
+      }
+   }
+
+   int rc;
+   uint64_t nOut = 0;
+   {
+      LsmRunWriter oWriter;
+      rc = lsmRunWriterOpen(&oWriter, zPath.c_str(), p->config.nBlockSize, p->config.nBloomBit);
+      uint64_t nStep = 0;
+      while (rc == SQLITE4_OK)
+      {
+         // The smallest key; the newest run wins a tie
+         LsmMergeInput * pBest = nullptr;
+         for (auto & in : aInput)
+         {
+            if (!in.bValid) continue;
+            if (!pBest) { pBest = &in; continue; }
+            std::string_view k1((const char *)in.entry.aKey, in.entry.nKey);
+            std::string_view k2((const char *)pBest->entry.aKey, pBest->entry.nKey);
+            if (k1 < k2) pBest = &in;
+         }
+         if (!pBest) break;
+         if (!(bBottom && pBest->entry.bDelete))
+         {
+            rc = lsmRunWriterAdd(&oWriter, pBest->entry.aKey, pBest->entry.nKey,
+               pBest->entry.aData, pBest->entry.nData, pBest->entry.bDelete);
+            nOut++;
+         }
+         std::string_view kBest((const char *)pBest->entry.aKey, pBest->entry.nKey);
+         for (auto & in : aInput)
+         {
+            if (&in == pBest || !in.bValid) continue;
+            if (std::string_view((const char *)in.entry.aKey, in.entry.nKey) == kBest)
+            {
+               in.iOff += in.entry.nSize;
+               in.load();
+            }
+         }
+         pBest->iOff += pBest->entry.nSize;
+         pBest->load();
+
+         // Give up if the database is being closed
+         if ((++nStep & 1023) == 0 && p->bShutdown) rc = SQLITE4_ABORT;
+      }
+      for (auto & in : aInput)
+      {
+         if (rc == SQLITE4_OK && in.iBlock < in.pRun->nBlock && !in.bValid) rc = SQLITE4_CORRUPT;
+      }
+      if (rc == SQLITE4_OK) rc = lsmRunWriterFinish(&oWriter, p->config.eSync >= 1);
+   }
+   std::shared_ptr<LsmRun> pRun;
+   if (rc == SQLITE4_OK)
+   {
+      if (nOut)
+      {
+         rc = lsmRunOpen(zPath.c_str(), iFile, &pRun);
+      }
+      else
+      {
+         unlink(zPath.c_str());
+      }
+   }
+
+   oLock.lock();
+   if (rc == SQLITE4_OK)
+   {
+      // Flushes have only added newer runs and other merges have
+      // replaced other runs, so the inputs are still consecutive.
+      std::shared_ptr<LsmVersion> pNew = std::make_shared<LsmVersion>(*p->pVersion);
+      auto it = std::find(pNew->aRun.begin(), pNew->aRun.end(), aIn[0]);
+      assert(it != pNew->aRun.end() && (size_t)(pNew->aRun.end() - it) >= aIn.size());
+      it = pNew->aRun.erase(it, it + aIn.size());
+      if (pRun) pNew->aRun.insert(it, pRun);
+      rc = lsmWriteManifest(p, *pNew);
+      if (rc == SQLITE4_OK)
+      {
+         for (auto & pOld : aIn) pOld->bDrop = true;
+         p->pVersion = pNew;
+      }
+      else if (pRun)
+      {
+         pRun->bDrop = true;
+      }
+   }
+   if (rc != SQLITE4_OK && rc != SQLITE4_ABORT)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed lsmDoMerge() : '%s' : error %d\n", p->zDir.c_str(), rc);
+      p->rcBackground = rc;
+   }
+   for (auto & pOld : aIn) pOld->bMerging = false;
+   p->nMerging--;
+   p->cond.notify_all();
+   return rc;
+}
+
+// Do one flush or merge, if any is due.  Called with p->mutex held.
+static bool lsmDoWork(LsmDb * p, std::unique_lock<std::mutex> & oLock)
+{
+   if (p->rcBackground != SQLITE4_OK || p->bShutdown) return false;
+   if (!p->bFlushing && !p->pVersion->aFrozen.empty())
+   {
+      lsmDoFlush(p, oLock);
+      return true;
+   }
+   std::vector<std::shared_ptr<LsmRun>> aIn;
+   bool bBottom = false;
+   if (lsmPickMerge(p, aIn, bBottom, false))
+   {
+      lsmDoMerge(p, oLock, aIn, bBottom);
+      return true;
+   }
+   return false;
+}
+
+static void lsmWorkerMain(LsmDb * p)
+{
+   std::unique_lock<std::mutex> oLock(p->mutex);
+   while (!p->bShutdown)
+   {
+      if (!lsmDoWork(p, oLock))
+      {
+         p->cond.wait(oLock);
+      }
+   }
+}
+
+// With merge_threads=0, flushes and merges are done by the committing thread
+static void lsmWorkInline(LsmDb * p)
+{
+   std::unique_lock<std::mutex> oLock(p->mutex);
+   while (lsmDoWork(p, oLock))
+   {
+   }
+}
+
+// Wait until every frozen memtable has been written to a run
+int lsmDbWait(LsmDb * p)
+{
+   std::unique_lock<std::mutex> oLock(p->mutex);
+   while (p->rcBackground == SQLITE4_OK && !p->pVersion->aFrozen.empty())
+   {
+      if (p->config.nMergeThread == 0)
+      {
+         lsmDoWork(p, oLock);
+      }
+      else
+      {
+         p->cond.wait(oLock);
+      }
+   }
+   return p->rcBackground;
+}
+
+// Merge every run into one, after waiting for the flushes and merges in progress
+int lsmDbMerge(LsmDb * p)
+{
+   int rc = lsmDbWait(p);
+   if (rc != SQLITE4_OK) return rc;
+   std::unique_lock<std::mutex> oLock(p->mutex);
+   while (p->nMerging > 0 && p->rcBackground == SQLITE4_OK)
+   {
+      p->cond.wait(oLock);
+   }
+   std::vector<std::shared_ptr<LsmRun>> aIn;
+   bool bBottom = false;
+   if (p->rcBackground == SQLITE4_OK && lsmPickMerge(p, aIn, bBottom, true))
+   {
+      rc = lsmDoMerge(p, oLock, aIn, bBottom);
+   }
+   return rc != SQLITE4_OK ? rc : p->rcBackground;
+}
@@ -0,0 +1,390 @@
+#include "kvlsm_common.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// =======================================================================================
+// Sorted run files.
+//
+// A run file holds the entries of a frozen memtable, or of the runs
+// merged into it, in key order:
+//
+//    header       64 bytes, see below
+//    blocks       entries, starting a new block once one reaches block_size
+//    index        the offset of each block, 8 bytes each
+//    bloom        the bloom filter of the keys
+//
+// Each entry is a varint key size, a varint data size plus one (0 for a
+// deleted key), the key and the data.  A seek binary-searches the index
+// by the first key of each block and scans one block.
+//
+// The header is:
+//
+//    0    "KVLSMRUN"
+//    8    version (1)
+//    12   number of bloom filter hash functions
+//    16   number of entries
+//    24   number of blocks
+//    32   offset of the index, which is also the end of the last block
+//    40   offset of the bloom filter
+//    48   number of bits in the bloom filter
+//    56   unused
+//    60   checksum of bytes 0 to 59
+//
+// Integers are big-endian.
+// =======================================================================================
+
+#define KVLSM_RUN_MAGIC      "KVLSMRUN"
+#define KVLSM_RUN_VERSION    1
+#define KVLSM_RUN_HDRSIZE    64
+
+static void lsmPut32(uint8_t * a, uint32_t v)
+{
+   a[0] = (uint8_t)(v >> 24); a[1] = (uint8_t)(v >> 16);
+   a[2] = (uint8_t)(v >> 8);  a[3] = (uint8_t)v;
+}
+
+static void lsmPut64(uint8_t * a, uint64_t v)
+{
+   lsmPut32(a, (uint32_t)(v >> 32));
+   lsmPut32(a + 4, (uint32_t)v);
+}
+
+static uint32_t lsmGet32(const uint8_t * a)
+{
+   return ((uint32_t)a[0] << 24) | ((uint32_t)a[1] << 16) | ((uint32_t)a[2] << 8) | a[3];
+}
+
+static uint64_t lsmGet64(const uint8_t * a)
+{
+   return ((uint64_t)lsmGet32(a) << 32) | lsmGet32(a + 4);
+}
+
+// FNV-1a, 32 bits, used as the header checksum
+static uint32_t lsmHeaderChecksum(const uint8_t * a, size_t n)
+{
+   uint32_t h = 2166136261u;
+   for (size_t i = 0; i < n; ++i)
+   {
+      h = (h ^ a[i]) * 16777619u;
+   }
+   return h;
+}
+
+// Hash of a key for the bloom filters: FNV-1a, 64 bits,
+// followed by the splitmix64 finalizer to spread the bits.
+uint64_t lsmHash(const uint8_t * a, size_t n)
+{
+   uint64_t h = 14695981039346656037ULL;
+   for (size_t i = 0; i < n; ++i)
+   {
+      h = (h ^ a[i]) * 1099511628211ULL;
+   }
+   h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ULL;
+   h ^= h >> 27; h *= 0x94d049bb133111ebULL;
+   h ^= h >> 31;
+   return h;
+}
+
+// Append a varint, 7 bits per byte, least significant first
+int lsmPutVarint(std::string & s, uint64_t v)
+{
+   int n = 0;
+   do
+   {
+      uint8_t c = (uint8_t)(v & 0x7f);
+      v >>= 7;
+      if (v) c |= 0x80;
+      s.push_back((char)c);
+      n++;
+   } while (v);
+   return n;
+}
+
+// Read a varint from a[], which ends at aEnd.
+// Return the number of bytes read, or 0 if it is truncated.
+int lsmGetVarint(const uint8_t * a, const uint8_t * aEnd, uint64_t * pv)
+{
+   uint64_t v = 0;
+   int i;
+   for (i = 0; i < 10 && a + i < aEnd; ++i)
+   {
+      v |= (uint64_t)(a[i] & 0x7f) << (7 * i);
+      if ((a[i] & 0x80) == 0)
+      {
+         *pv = v;
+         return i + 1;
+      }
+   }
+   return 0;
+}
+
+int lsmEncodeEntry(std::string & s, const uint8_t * aKey, size_t nKey, const uint8_t * aData, size_t nData, bool bDelete)
+{
+   lsmPutVarint(s, nKey);
+   lsmPutVarint(s, bDelete ? 0 : nData + 1);
+   s.append((const char *)aKey, nKey);
+   if (!bDelete) s.append((const char *)aData, nData);
+   return SQLITE4_OK;
+}
+
+// =======================================================================================
+// Writer
+// =======================================================================================
+
+LsmRunWriter::~LsmRunWriter()
+{
+   if (pFile)
+   {
+      // Not finished: an error occurred, the partial file is removed
+      fclose(pFile);
+      unlink(zPath.c_str());
+   }
+}
+
+int lsmRunWriterOpen(LsmRunWriter * p, const char * zPath, size_t nBlockSize, uint32_t nBloomBitPerKey)
+{
+   p->zPath = zPath;
+   p->nBlockSize = nBlockSize;
+   p->nBloomBitPerKey = nBloomBitPerKey;
+   p->pFile = fopen(zPath, "wb");
+   if (!p->pFile)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed lsmRunWriterOpen() : cannot create '%s'\n", zPath);
+      return SQLITE4_CANTOPEN;
+   }
+   setvbuf(p->pFile, nullptr, _IOFBF, 1 << 16);
+
+   uint8_t aHdr[KVLSM_RUN_HDRSIZE];
+   memset(aHdr, 0, sizeof(aHdr));
+   if (fwrite(aHdr, sizeof(aHdr), 1, p->pFile) != 1) return SQLITE4_IOERR;
+   p->iOff = KVLSM_RUN_HDRSIZE;
+   p->iBlock = p->iOff;
+   return SQLITE4_OK;
+}
+
+static int lsmRunWriterFlushBlock(LsmRunWriter * p)
+{
+   if (p->buf.empty()) return SQLITE4_OK;
+   if (fwrite(p->buf.data(), p->buf.size(), 1, p->pFile) != 1) return SQLITE4_IOERR;
+   p->aBlock.push_back(p->iBlock);
+   p->iOff += p->buf.size();
+   p->iBlock = p->iOff;
+   p->buf.clear();
+   return SQLITE4_OK;
+}
+
+int lsmRunWriterAdd(LsmRunWriter * p, const uint8_t * aKey, size_t nKey, const uint8_t * aData, size_t nData, bool bDelete)
+{
+   lsmEncodeEntry(p->buf, aKey, nKey, aData, nData, bDelete);
+   if (p->nBloomBitPerKey)
+   {
+      p->aHash.push_back(lsmHash(aKey, nKey));
+   }
+   else
+   {
+      p->aHash.push_back(0);
+   }
+   if (p->buf.size() >= p->nBlockSize)
+   {
+      return lsmRunWriterFlushBlock(p);
+   }
+   return SQLITE4_OK;
+}
+
+int lsmRunWriterFinish(LsmRunWriter * p, int bSync)
+{
+   int rc = lsmRunWriterFlushBlock(p);
+   if (rc != SQLITE4_OK) return rc;
+
+   uint64_t nEntry = p->aHash.size();
+   uint64_t nBlock = p->aBlock.size();
+   uint64_t iIndex = p->iOff;
+
+   // Index
+   std::vector<uint8_t> aIndex(nBlock * 8);
+   for (uint64_t i = 0; i < nBlock; ++i)
+   {
+      lsmPut64(&aIndex[i * 8], p->aBlock[i]);
+   }
+   if (nBlock && fwrite(aIndex.data(), aIndex.size(), 1, p->pFile) != 1) return SQLITE4_IOERR;
+   uint64_t iBloom = iIndex + aIndex.size();
+
+   // Bloom filter.  About 0.69 hash functions per bit of a key
+   // give the lowest false positive rate.
+   uint64_t nBloomBit = 0;
+   uint32_t nHash = 0;
+   std::vector<uint8_t> aBloom;
+   if (p->nBloomBitPerKey && nEntry)
+   {
+      nBloomBit = nEntry * p->nBloomBitPerKey;
+      if (nBloomBit < 64) nBloomBit = 64;
+      nHash = (uint32_t)(p->nBloomBitPerKey * 69 / 100);
+      if (nHash < 1) nHash = 1;
+      if (nHash > 30) nHash = 30;
+      aBloom.assign((size_t)((nBloomBit + 7) / 8), 0);
+      for (uint64_t h : p->aHash)
+      {
+         uint64_t h2 = (h >> 32) | 1;
+         for (uint32_t i = 0; i < nHash; ++i)
+         {
+            uint64_t iBit = (h + i * h2) % nBloomBit;
+            aBloom[iBit / 8] |= (uint8_t)(1 << (iBit % 8));
+         }
+      }
+      if (fwrite(aBloom.data(), aBloom.size(), 1, p->pFile) != 1) return SQLITE4_IOERR;
+   }
+
+   // Header, last
+   uint8_t aHdr[KVLSM_RUN_HDRSIZE];
+   memset(aHdr, 0, sizeof(aHdr));
+   memcpy(aHdr, KVLSM_RUN_MAGIC, 8);
+   lsmPut32(&aHdr[8], KVLSM_RUN_VERSION);
+   lsmPut32(&aHdr[12], nHash);
+   lsmPut64(&aHdr[16], nEntry);
+   lsmPut64(&aHdr[24], nBlock);
+   lsmPut64(&aHdr[32], iIndex);
+   lsmPut64(&aHdr[40], iBloom);
+   lsmPut64(&aHdr[48], nBloomBit);
+   lsmPut32(&aHdr[60], lsmHeaderChecksum(aHdr, 60));
+   if (fseek(p->pFile, 0, SEEK_SET) != 0
+      || fwrite(aHdr, sizeof(aHdr), 1, p->pFile) != 1
+      || fflush(p->pFile) != 0
+      || (bSync && fdatasync(fileno(p->pFile)) != 0))
+   {
+      return SQLITE4_IOERR;
+   }
+   fclose(p->pFile);
+   p->pFile = nullptr;
+   return SQLITE4_OK;
+}
+
+// =======================================================================================
+// Reader
+// =======================================================================================
+
+LsmRun::~LsmRun()
+{
+   if (aMap)
+   {
+      munmap((void *)aMap, nMap);
+   }
+   if (bDrop)
+   {
+      unlink(zPath.c_str());
+   }
+}
+
+int lsmRunOpen(const char * zPath, uint64_t iFile, std::shared_ptr<LsmRun> * ppRun)
+{
+   int fd = open(zPath, O_RDONLY);
+   if (fd < 0)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed lsmRunOpen() : cannot open '%s'\n", zPath);
+      return SQLITE4_CANTOPEN;
+   }
+   struct stat st;
+   if (fstat(fd, &st) != 0)
+   {
+      close(fd);
+      return SQLITE4_IOERR;
+   }
+   size_t nMap = (size_t)st.st_size;
+   if (nMap < KVLSM_RUN_HDRSIZE)
+   {
+      close(fd);
+      return SQLITE4_CORRUPT;
+   }
+   void * pMap = mmap(nullptr, nMap, PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (pMap == MAP_FAILED)
+   {
+      return SQLITE4_IOERR;
+   }
+
+   std::shared_ptr<LsmRun> pRun = std::make_shared<LsmRun>();
+   pRun->iFile = iFile;
+   pRun->zPath = zPath;
+   pRun->aMap = (const uint8_t *)pMap;
+   pRun->nMap = nMap;
+
+   const uint8_t * aHdr = pRun->aMap;
+   if (memcmp(aHdr, KVLSM_RUN_MAGIC, 8) != 0
+      || lsmGet32(&aHdr[8]) != KVLSM_RUN_VERSION
+      || lsmGet32(&aHdr[60]) != lsmHeaderChecksum(aHdr, 60))
+   {
+      return SQLITE4_CORRUPT;
+   }
+   pRun->nHash = lsmGet32(&aHdr[12]);
+   pRun->nEntry = lsmGet64(&aHdr[16]);
+   pRun->nBlock = lsmGet64(&aHdr[24]);
+   pRun->iBlockEnd = lsmGet64(&aHdr[32]);
+   uint64_t iBloom = lsmGet64(&aHdr[40]);
+   pRun->nBloomBit = lsmGet64(&aHdr[48]);
+   if (pRun->iBlockEnd < KVLSM_RUN_HDRSIZE
+      || pRun->nBlock > (nMap - pRun->iBlockEnd) / 8
+      || iBloom != pRun->iBlockEnd + pRun->nBlock * 8
+      || (pRun->nBloomBit + 7) / 8 > nMap - iBloom
+      || (pRun->nBloomBit && pRun->nHash == 0))
+   {
+      return SQLITE4_CORRUPT;
+   }
+   pRun->aIndex = pRun->aMap + pRun->iBlockEnd;
+   pRun->aBloom = pRun->nBloomBit ? pRun->aMap + iBloom : nullptr;
+   for (uint64_t i = 0; i < pRun->nBlock; ++i)
+   {
+      uint64_t iOff = lsmGet64(&pRun->aIndex[i * 8]);
+      if (iOff < KVLSM_RUN_HDRSIZE || iOff >= pRun->iBlockEnd) return SQLITE4_CORRUPT;
+   }
+
+   *ppRun = pRun;
+   return SQLITE4_OK;
+}
+
+bool lsmRunMayContain(const LsmRun * pRun, const uint8_t * aKey, size_t nKey)
+{
+   if (!pRun->aBloom) return true;
+   uint64_t h = lsmHash(aKey, nKey);
+   uint64_t h2 = (h >> 32) | 1;
+   for (uint32_t i = 0; i < pRun->nHash; ++i)
+   {
+      uint64_t iBit = (h + i * h2) % pRun->nBloomBit;
+      if ((pRun->aBloom[iBit / 8] & (1 << (iBit % 8))) == 0) return false;
+   }
+   return true;
+}
+
+// Decode the entry at offset iOff.  Return false if it is corrupt.
+bool lsmRunDecode(const LsmRun * pRun, uint64_t iOff, LsmRunEntry * pEntry)
+{
+   const uint8_t * a = pRun->aMap + iOff;
+   const uint8_t * aEnd = pRun->aMap + pRun->iBlockEnd;
+   uint64_t nKey, nData;
+   int n1 = lsmGetVarint(a, aEnd, &nKey);
+   if (n1 == 0) return false;
+   int n2 = lsmGetVarint(a + n1, aEnd, &nData);
+   if (n2 == 0) return false;
+   pEntry->bDelete = (nData == 0);
+   if (nData) nData--;
+   if (nKey > (uint64_t)(aEnd - a) || nData > (uint64_t)(aEnd - a) - nKey
+      || (uint64_t)(n1 + n2) > (uint64_t)(aEnd - a) - nKey - nData)
+   {
+      return false;
+   }
+   pEntry->aKey = a + n1 + n2;
+   pEntry->nKey = (size_t)nKey;
+   pEntry->aData = pEntry->aKey + nKey;
+   pEntry->nData = (size_t)nData;
+   pEntry->nSize = (size_t)(n1 + n2 + nKey + nData);
+   return true;
+}
+
+// Offset of block iBlock
+uint64_t lsmRunBlock(const LsmRun * pRun, uint64_t iBlock)
+{
+   return lsmGet64(&pRun->aIndex[iBlock * 8]);
+}
@@ -0,0 +1,389 @@
+// perftest_kvlsm.cpp :
+// */ Perf-Test of INSERTing rows w/ Parameter Binding, then SEEKing them by random PK,
+//    against a KVStore plugin: kvlsm, or any other one (kvwt, kvbdb) where it builds.
+//
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+extern "C"
+{
+#include "sqlite4.h"
+}
+
+void execute_or_exit(sqlite4 * db, const char * sSql)
+{
+   printf("%s\n", sSql);
+
+   int rc = sqlite4_exec(db, sSql, 0, 0);
+   if (rc != SQLITE4_OK) {
+
+      printf("Failed to execute '%s' : %s\n", sSql, sqlite4_errmsg(db));
+
+      sqlite4_close(db, 0);
+
+      exit(-1);
+   }
+}
+
+int count_rows_in_table_or_exit(sqlite4 * db, const char * sTable)
+{
+   char sSql[128];
+   snprintf(sSql, sizeof(sSql), "SELECT COUNT(*) from %s", sTable);
+
+   sqlite4_stmt * pStmt = 0;
+   int rc = sqlite4_prepare(db, sSql, -1, &pStmt, 0);
+   if (rc != SQLITE4_OK || sqlite4_step(pStmt) != SQLITE4_ROW) {
+
+      printf("Failed to count rows : %s\n", sqlite4_errmsg(db));
+
+      sqlite4_finalize(pStmt);
+      sqlite4_close(db, 0);
+
+      exit(-1);
+   }
+
+   int retval = sqlite4_column_int(pStmt, 0);
+
+   sqlite4_finalize(pStmt);
+
+   return retval;
+}
+
+void create_table(sqlite4 * a_pDB)
+{
+   execute_or_exit(a_pDB, "create table if not exists table06 (c_int integer PRIMARY KEY, c_num number, c_datetime text, c_char char(20), c_varchar varchar(20))");
+}
+
+sqlite4_stmt * prepare_or_exit(sqlite4 * a_pDB, const char * sSQL)
+{
+   sqlite4_stmt * pStmt = NULL;
+   int rc = sqlite4_prepare(a_pDB, sSQL, -1, &pStmt, 0);
+   if (rc != SQLITE4_OK) {
+
+      printf("Failed to prepare '%s' : %s\n", sSQL, sqlite4_errmsg(a_pDB));
+
+      sqlite4_finalize(pStmt);
+      sqlite4_close(a_pDB, 0);
+
+      exit(-1);
+   }
+   return pStmt;
+}
+
+// Step a statement which returns no rows.  SQLITE4_BUSY is returned to
+// the caller, which retries the transaction; other errors are fatal.
+int step_or_exit(sqlite4 * a_pDB, sqlite4_stmt * pStmt, const char * sWhat)
+{
+   int rc = sqlite4_step(pStmt);
+   sqlite4_reset(pStmt);
+   if (rc == SQLITE4_BUSY)
+   {
+      return rc;
+   }
+   if (rc != SQLITE4_DONE) {
+
+      printf("Failed to step/execute the '%s' statement: %s\n", sWhat, sqlite4_errmsg(a_pDB));
+
+      sqlite4_close(a_pDB, 0);
+
+      exit(-1);
+   }
+   return SQLITE4_OK;
+}
+
+enum class TestPhase { Insert, Seek };
+
+class MyTestTask
+{
+public:
+   MyTestTask(int a_nMyNum, sqlite4_env * a_pEnv, const char * a_zName, sqlite4 * a_pShared, TestPhase a_ePhase,
+      int a_numrows_total, int a_numrows_per_txn, int a_numthreads, int a_numseeks)
+      : m_n_my_num(a_nMyNum)
+      , m_pEnv(a_pEnv)
+      , m_zName(a_zName)
+      , m_pShared(a_pShared)
+      , m_ePhase(a_ePhase)
+      , m_numrows_total(a_numrows_total)
+      , m_numrows_per_txn(a_numrows_per_txn)
+      , m_numthreads(a_numthreads)
+      , m_numseeks(a_numseeks)
+   {
+      // Connections are opened before the clock starts
+      initialize();
+   }
+
+   ~MyTestTask()
+   {
+      finalize();
+   }
+
+   int operator()()
+   {
+      if (m_ePhase == TestPhase::Insert)
+      {
+         runInserts();
+      }
+      else
+      {
+         runSeeks();
+      }
+      return 0;
+   }
+
+   long getBusyRetries() const { return m_nBusy; }
+
+private:
+   void runInserts()
+   {
+      int n_num_iter = m_numrows_total / m_numrows_per_txn / m_numthreads;
+      for (int i = 0; i < n_num_iter; ++i)
+      {
+         // A transaction which meets a concurrent commit fails with
+         // SQLITE4_BUSY, and is rolled back and retried.
+         while (true)
+         {
+            int rc = step_or_exit(m_pDb, m_pBeginTxn, "BEGIN TRANSACTION");
+            for (int j = 0; rc == SQLITE4_OK && j < m_numrows_per_txn; ++j)
+            {
+               int nPK = i * m_numthreads * m_numrows_per_txn
+                  + m_n_my_num * m_numrows_per_txn
+                  + j;
+               rc = insertData(nPK);
+            }
+            if (rc == SQLITE4_OK) rc = step_or_exit(m_pDb, m_pCommitTxn, "COMMIT");
+            if (rc == SQLITE4_OK) break;
+            m_nBusy++;
+            step_or_exit(m_pDb, m_pRollbackTxn, "ROLLBACK");
+         }
+      }
+   }
+
+   void runSeeks()
+   {
+      std::mt19937 oRandom(1234 + m_n_my_num);
+      std::uniform_int_distribution<int> oPK(0, m_numrows_total - 1);
+      int n_num_seeks = m_numseeks / m_numthreads;
+      for (int i = 0; i < n_num_seeks; ++i)
+      {
+         int nPK = oPK(oRandom);
+         sqlite4_bind_int(m_pSelectData, 1, nPK);
+         int rc = sqlite4_step(m_pSelectData);
+         if (rc != SQLITE4_ROW) {
+
+            printf("Failed to find the row with PK %d : %s\n", nPK, sqlite4_errmsg(m_pDb));
+
+            exit(-1);
+         }
+         sqlite4_reset(m_pSelectData);
+      }
+   }
+
+   int insertData(int a_nPK)
+   {
+      sqlite4_bind_int(m_pInsertData, 1, a_nPK);
+      sqlite4_bind_text(m_pInsertData, 2, "123.456", -1, SQLITE4_STATIC, NULL);
+      sqlite4_bind_text(m_pInsertData, 3, "2018-11-13 08:52:56.803", -1, SQLITE4_STATIC, NULL);
+      sqlite4_bind_text(m_pInsertData, 4, "qazwsx", -1, SQLITE4_STATIC, NULL);
+      sqlite4_bind_text(m_pInsertData, 5, "edcrfv", -1, SQLITE4_STATIC, NULL);
+      return step_or_exit(m_pDb, m_pInsertData, "INSERT");
+   }
+
+   void initialize()
+   {
+      int rc = SQLITE4_OK;
+      if (m_pShared)
+      {
+         m_pDb = m_pShared;
+      }
+      else
+      {
+         rc = sqlite4_open(m_pEnv, m_zName, &m_pDb, 0);
+      }
+      if (rc != SQLITE4_OK) {
+         printf("Cannot open database: %s\n", sqlite4_errmsg(m_pDb));
+         sqlite4_close(m_pDb, 0);
+         exit(-1);
+      }
+
+      m_pBeginTxn = prepare_or_exit(m_pDb, "BEGIN TRANSACTION");
+      m_pCommitTxn = prepare_or_exit(m_pDb, "COMMIT");
+      m_pRollbackTxn = prepare_or_exit(m_pDb, "ROLLBACK");
+      m_pInsertData = prepare_or_exit(m_pDb, "insert into table06 (c_int, c_num, c_datetime, c_char, c_varchar) values (:p_int, :p_num, :p_datetime, :p_char, :p_varchar)");
+      m_pSelectData = prepare_or_exit(m_pDb, "select c_varchar from table06 where c_int = :p_int");
+   }
+
+   void finalize()
+   {
+      sqlite4_finalize(m_pBeginTxn);
+      sqlite4_finalize(m_pCommitTxn);
+      sqlite4_finalize(m_pRollbackTxn);
+      sqlite4_finalize(m_pInsertData);
+      sqlite4_finalize(m_pSelectData);
+      if (!m_pShared) sqlite4_close(m_pDb, 0);
+   }
+
+private:
+   int m_n_my_num = 0;
+   sqlite4_env * m_pEnv = NULL;
+   const char * m_zName = NULL;
+   sqlite4 * m_pShared = NULL;   // connection of main(), used instead of a new one
+   TestPhase m_ePhase;
+   sqlite4 * m_pDb = NULL;
+   sqlite4_stmt * m_pBeginTxn = NULL;
+   sqlite4_stmt * m_pCommitTxn = NULL;
+   sqlite4_stmt * m_pRollbackTxn = NULL;
+   sqlite4_stmt * m_pInsertData = NULL;
+   sqlite4_stmt * m_pSelectData = NULL;
+   int m_numrows_total = 0;
+   int m_numrows_per_txn = 0;
+   int m_numthreads = 0;
+   int m_numseeks = 0;
+   long m_nBusy = 0;
+}; // end of class MyTestTask
+
+// Run one phase of the test in numthreads threads and print its speed
+void run_phase(sqlite4_env * pEnv, const char * zName, sqlite4 * pShared, TestPhase ePhase,
+   int numrows_total, int numrows_per_txn, int numthreads, int numseeks)
+{
+   std::vector<MyTestTask*> oMyTestTaskVector;
+   std::vector<std::thread> oMyTestTaskThreadsVector;
+
+   for (int i = 0; i < numthreads; ++i)
+   {
+      oMyTestTaskVector.push_back(new MyTestTask(i, pEnv, zName, pShared, ePhase,
+         numrows_total, numrows_per_txn, numthreads, numseeks));
+   }
+
+   auto start_t = std::chrono::steady_clock::now();
+   for (int i = 0; i < numthreads; ++i)
+   {
+      oMyTestTaskThreadsVector.emplace_back(std::ref(*oMyTestTaskVector[i]));
+   }
+   for (auto & oThread : oMyTestTaskThreadsVector)
+   {
+      oThread.join();
+   }
+   auto end_t = std::chrono::steady_clock::now();
+   double total_t = std::chrono::duration<double>(end_t - start_t).count();
+
+   long nBusy = 0;
+   for (auto pTask : oMyTestTaskVector)
+   {
+      nBusy += pTask->getBusyRetries();
+      delete pTask;
+   }
+
+   int nRows = (ePhase == TestPhase::Insert) ? numrows_total : numseeks;
+   printf("\n%s\n", (ePhase == TestPhase::Insert) ? "INSERT" : "SEEK");
+   printf("#Rows: %d [-]\n", nRows);
+   printf("Time: %f [s]\n", total_t);
+   printf("Speed: %f [rows/s]\n", nRows / total_t);
+   if (nBusy)
+   {
+      printf("Retried transactions: %ld [-]\n", nBusy);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   if (argc != 8)
+   {
+      printf("Usage:\nperftest_kvlsm plugin_file|- database_uri numrows_total numrows_per_txn numthreads numseeks insert|seek|both\n");
+      printf("   e.g. perftest_kvlsm ./libkvlsm.so \"file:perftest_kvlsm.db?kv=kvlsm\" 1000000 10000 4 1000000 both\n");
+      printf("   The plugin is registered under the name of its file without \"lib\" and the extension,\n");
+      printf("   or, with '-', the database is opened with the built-in KVStores, in one thread.\n");
+      return -1;
+   }
+
+   const char * zPlugin = argv[1];
+   const char * zName = argv[2];
+   int numrows_total = atoi(argv[3]);
+   int numrows_per_txn = atoi(argv[4]);
+   int numthreads = atoi(argv[5]);
+   int numseeks = atoi(argv[6]);
+   const char * zPhase = argv[7];
+   bool bInsert = !strcmp(zPhase, "insert") || !strcmp(zPhase, "both");
+   bool bSeek = !strcmp(zPhase, "seek") || !strcmp(zPhase, "both");
+
+   if (numrows_total <= 0 || numrows_per_txn <= 0 || numthreads <= 0 || numseeks < 0 || (!bInsert && !bSeek))
+   {
+      printf("Invalid arguments\n");
+      return -1;
+   }
+
+   printf("perftest_kvlsm   plugin=%s database=%s numrows_total=%d numrows_per_txn=%d numthreads=%d numseeks=%d\n",
+      zPlugin, zName, numrows_total, numrows_per_txn, numthreads, numseeks);
+
+   // initialize db / open session etc. -- begin
+   if (strcmp(zPlugin, "-"))
+   {
+      // "path/libkvlsm.so" is registered as "kvlsm"
+      std::string oAlias = zPlugin;
+      size_t iSlash = oAlias.find_last_of("/\\");
+      if (iSlash != std::string::npos) oAlias = oAlias.substr(iSlash + 1);
+      if (oAlias.compare(0, 3, "lib") == 0) oAlias = oAlias.substr(3);
+      oAlias = oAlias.substr(0, oAlias.find('.'));
+
+      int rc = sqlite4_load_kvstore_plugin(0, zPlugin, oAlias.c_str());
+      if (rc != SQLITE4_OK)
+      {
+         printf("Failed sqlite4_load_kvstore_plugin(...) for %s\n", zPlugin);
+         exit(-1);
+      }
+   }
+
+   sqlite4_env * pEnv = sqlite4_env_default();
+   if (pEnv == NULL)
+   {
+      printf("Cannot acquire default environment\n");
+      return -1;
+   }
+
+   // This connection stays open for the whole test, so that
+   // an in-memory database lives until its end.
+   sqlite4 * pDb = NULL;
+   int rc = sqlite4_open(pEnv, zName, &pDb, 0);
+   if (rc != SQLITE4_OK)
+   {
+      printf("Cannot open database: %s\n", sqlite4_errmsg(pDb));
+      sqlite4_close(pDb, 0);
+      return -1;
+   }
+   // initialize db / open session etc. -- end
+
+   create_table(pDb);
+
+   // Every connection to a built-in in-memory store has a database of
+   // its own, so the test runs in this connection.
+   sqlite4 * pShared = NULL;
+   if (!strcmp(zPlugin, "-"))
+   {
+      pShared = pDb;
+      if (numthreads > 1)
+      {
+         printf("Built-in KVStores : numthreads=1\n");
+         numthreads = 1;
+      }
+   }
+
+   if (bInsert)
+   {
+      run_phase(pEnv, zName, pShared, TestPhase::Insert, numrows_total, numrows_per_txn, numthreads, numseeks);
+   }
+   printf("\n#Rows in table06: %d [-]\n", count_rows_in_table_or_exit(pDb, "table06"));
+   if (bSeek && numseeks > 0)
+   {
+      run_phase(pEnv, zName, pShared, TestPhase::Seek, numrows_total, numrows_per_txn, numthreads, numseeks);
+   }
+
+   sqlite4_close(pDb, 0);
+
+   return 0;
+}
@@ -1,6 +1,48 @@
 #include "kvwt_common.h"
 
 #include <map>
+#include <string>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+// =======================================================================================
+// Disk-backed WiredTiger factory.
+//
+// The database name is used as the WiredTiger home directory, 
+// which is created if it does not exist. The table is logged, 
+// so committed transactions survive a crash, and checkpoints 
+// bound the amount of log replayed by recovery.
+//
+// The connection is configured by URI parameters of the first open 
+// of a database in the process:
+//
+//    cache_size=N            cache size in bytes (default 2GB)
+//    sync=off|normal|full    log sync on commit: none, in the background, 
+//                            or before the commit returns (default normal)
+//    checkpoint_wait=N       seconds between checkpoints (default 60, 0 for none)
+//    checkpoint_log=N        also checkpoint after N bytes of log (default 0, none)
+//    eviction_threads=N      eviction worker threads (default: WiredTiger's)
+//
+// At run time, SQLITE4_KVCTRL_SYNCHRONOUS changes the sync level 
+// of a connection, SQLITE4_KVCTRL_LSM_FLUSH flushes and syncs the log, 
+// and SQLITE4_KVCTRL_LSM_CHECKPOINT writes a checkpoint, 
+// see kvwtControl(...).
+// =======================================================================================
+
+// Parse a "sync" URI parameter, -1 if not recognized
+static int parseKVWTSyncLevel(const char * z)
+{
+   if (!z) return 1;
+   if (sqlite4_stricmp(z, "off") == 0 || strcmp(z, "0") == 0) return 0;
+   if (sqlite4_stricmp(z, "normal") == 0 || strcmp(z, "1") == 0) return 1;
+   if (sqlite4_stricmp(z, "full") == 0 || strcmp(z, "2") == 0) return 2;
+   return -1;
+}
 
 //uint32_t nGlobalDefaultInitialCursorKeyBufferCapacity = 16384; // 16 k
 //uint32_t nGlobalDefaultInitialCursorDataBufferCapacity = 16384; // 16 k
@@ -13,10 +55,12 @@ struct KVWTEnv {
    char db_name[128];
    char table_name[128];
    uint32_t n_ref;
+   int sync_level;   // initial synchronous level of connections, 0..2
 
    KVWTEnv()
       : conn(nullptr)
       , n_ref(0)
+      , sync_level(1)
    {
       memset(db_name, 0, 128);
       memset(table_name, 0, 128);
@@ -35,18 +79,35 @@ struct KVWTEnv {
    }
 };
 
-std::mutex gKVWTEnvMapMutex;
-std::map<std::string, KVWTEnv*> gKVWTEnvMap;
+// Registry of KVWTEnv objects by database name.  It is split into
+// shards, each with its own mutex, so that opening databases with
+// different names does not serialize on one lock (wiredtiger_open()
+// runs while the shard is locked).  Entries are never removed.
+#define KVWT_ENV_NSHARD 16
+
+struct KVWTEnvShard {
+   std::mutex mutex;
+   std::map<std::string, KVWTEnv*> map;
+};
+
+KVWTEnvShard gKVWTEnvShards[KVWT_ENV_NSHARD];
+
+static KVWTEnvShard & kvwtEnvShard(const char * zName)
+{
+   size_t h = std::hash<std::string>()(std::string(zName));
+   return gKVWTEnvShards[h % KVWT_ENV_NSHARD];
+}
 
 KVWTEnv * acquireKVWTEnv(const char * zName)
 {
    //printf("-----> KVWT::acquireKVWTEnv(...)\n");
 
-   std::lock_guard<std::mutex> oLock(gKVWTEnvMapMutex);
+   KVWTEnvShard & oShard = kvwtEnvShard(zName);
+   std::lock_guard<std::mutex> oLock(oShard.mutex);
    KVWTEnv * pKVWTEnv = nullptr;
 
-   auto it = gKVWTEnvMap.find(zName);
-   if (it != gKVWTEnvMap.end())
+   auto it = oShard.map.find(zName);
+   if (it != oShard.map.end())
    {
       // found
       pKVWTEnv = it->second;
@@ -58,11 +119,45 @@ KVWTEnv * acquireKVWTEnv(const char * zName)
       {
          pKVWTEnv = new KVWTEnv;
          sprintf(pKVWTEnv->db_name, "%s", zName);
-         //sprintf(pKVWTEnv->table_name, "table:sqlite4"); // see "test_015.cpp", l. 129
+         // The database name is the home directory, 
+         // so one fixed table name suffices.
+         sprintf(pKVWTEnv->table_name, "table:sqlite4"); // see "test_015.cpp", l. 129
          //sprintf(pKVWTEnv->table_name, "sqlite4:%s", zName);
-         sprintf(pKVWTEnv->table_name, "table:%s", zName);
+         //sprintf(pKVWTEnv->table_name, "table:%s", zName);
+
+         // Build the connection configuration from URI parameters
+         pKVWTEnv->sync_level = parseKVWTSyncLevel(sqlite4_uri_parameter(zName, "sync"));
+         sqlite4_int64 nCacheSize = sqlite4_uri_int64(zName, "cache_size", 2147483648LL);
+         sqlite4_int64 nCheckpointWait = sqlite4_uri_int64(zName, "checkpoint_wait", 60);
+         sqlite4_int64 nCheckpointLog = sqlite4_uri_int64(zName, "checkpoint_log", 0);
+         sqlite4_int64 nEvictionThreads = sqlite4_uri_int64(zName, "eviction_threads", 0);
+         std::string oConfig;
+         char cBuf[256];
+         sprintf(cBuf, "create, cache_size=%lld, log=(enabled=true), checkpoint=(wait=%lld, log_size=%lld)",
+            nCacheSize, nCheckpointWait, nCheckpointLog);
+         oConfig = cBuf;
+         if (nEvictionThreads > 0)
+         {
+            sprintf(cBuf, ", eviction=(threads_min=%lld, threads_max=%lld)", nEvictionThreads, nEvictionThreads);
+            oConfig += cBuf;
+         }
+
+         // WiredTiger requires an existing home directory
+#ifdef _WIN32
+         _mkdir(zName);
+#else
+         mkdir(zName, 0755);
+#endif
+
          int ret = 0;
-         ret = wiredtiger_open(NULL, NULL, "create, in_memory=true, cache_size=2147483648, cache_overhead=8, checkpoint={log_size=2147483648, wait=0}, checkpoint_sync=false, log={file_max=2147483648}", &(pKVWTEnv->conn));
+         if (pKVWTEnv->sync_level < 0 || nCacheSize <= 0 || nCheckpointWait < 0 || nCheckpointLog < 0)
+         {
+            ret = EINVAL;
+         }
+         else
+         {
+            ret = wiredtiger_open(zName, NULL, oConfig.c_str(), &(pKVWTEnv->conn));
+         }
          if (ret != 0)
          {
             // error
@@ -76,7 +171,7 @@ KVWTEnv * acquireKVWTEnv(const char * zName)
          {
             // success
 
-            gKVWTEnvMap.insert(std::pair<std::string, KVWTEnv*>(zName, pKVWTEnv));
+            oShard.map.insert(std::pair<std::string, KVWTEnv*>(zName, pKVWTEnv));
          }
       }
       catch (...)
@@ -133,7 +228,8 @@ int acquireWTResources(const char * zName, KVWT * pKVWT)
    }
 
    // Create a table for SQLite4/M database
-   ret = pKVWT->session->create(pKVWT->session, pKVWTEnv->table_name, "access_pattern_hint=sequential, cache_resident=true, ignore_in_memory_cache_size=true, key_format=u,value_format=u");
+   // Unlike kvwtmem, the table may be evicted to disk, so it is not cache_resident.
+   ret = pKVWT->session->create(pKVWT->session, pKVWTEnv->table_name, "access_pattern_hint=sequential, key_format=u,value_format=u");
    if (ret != 0)
    {
       // Integrate with SQLite4/M diagnostics!
@@ -152,6 +248,9 @@ int acquireWTResources(const char * zName, KVWT * pKVWT)
    // strcpy(pKVWT->name, pKVWTEnv->db_name); // moved to CTOR
    strcpy(pKVWT->table_name, pKVWTEnv->table_name);
    //
+   // commits are logged, with the sync level configured for the database
+   pKVWT->eSync = pKVWTEnv->sync_level;
+   //
    //// set initial buffer sizes for Cursor's Key and Value -- moved to CTOR
    //pKVWT->nInitialCursorKeyBufferCapacity = nGlobalDefaultInitialCursorKeyBufferCapacity;
    //pKVWT->nInitialCursorDataBufferCapacity = nGlobalDefaultInitialCursorDataBufferCapacity;
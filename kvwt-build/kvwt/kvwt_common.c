@@ -7,6 +7,12 @@ uint32_t nGlobalDefaultInitialCursorDataBufferCapacity = 16384; // 16 k
 
 std::atomic<size_t> oCounter(1); // transactions' counter, zero (0) not permitted as txn counter/timestamp!
 
+// Write transactions committed by all connections, see SQLITE4_KVCTRL_DATA_VERSION
+static std::atomic<uint64_t> oDataVersion(0);
+
+// Log sync configuration of commit_transaction(...) by KVWT::eSync
+static const char * azKVWTCommitSync[] = { ",sync=off", ",sync=background", ",sync=on" };
+
 
 
 int kvwtReplace(
@@ -117,6 +123,123 @@ int kvwtReplace(
    return rc;
 }
 
+// Cursor pool -- begin ---------------------------------------------
+
+// Capacity for a new key or data buffer of a cursor: 
+// the configured initial capacity until anything has been read, 
+// then the smallest power of 2, not below 64, 
+// holding the largest item read so far.
+static uint32_t kvwtBufferCapacity(uint32_t nSeen, uint32_t nInitial)
+{
+   uint32_t nCapacity = 64;
+   if (nSeen == 0)
+   {
+      return nInitial;
+   }
+   while (nCapacity < nSeen && nCapacity < 0x80000000)
+   {
+      nCapacity *= 2;
+   }
+   return nCapacity;
+} // end of : kvwtBufferCapacity(...){...}
+
+// Record the sizes of the key and data just cached by cursor pCur.
+static void kvwtNoteCachedSizes(KVWT * p, KVWTCursor * pCur)
+{
+   if (pCur->nCachedKeySize > p->nKeySizeSeen)
+   {
+      p->nKeySizeSeen = pCur->nCachedKeySize;
+   }
+   if (pCur->nCachedDataSize > p->nDataSizeSeen)
+   {
+      p->nDataSizeSeen = pCur->nCachedDataSize;
+   }
+} // end of : kvwtNoteCachedSizes(...){...}
+
+// Take a cursor object from the free list, keeping its buffers, 
+// or allocate a new one. All other fields are zeroed.
+// Returns NULL if out of memory.
+static KVWTCursor * kvwtAllocCursor(KVWT * p)
+{
+   KVWTCursor * pCsr = p->pFreeCsr;
+   if (pCsr != NULL)
+   {
+      void * pCachedKey = pCsr->pCachedKey;
+      uint32_t nCachedKeyCapacity = pCsr->nCachedKeyCapacity;
+      void * pCachedData = pCsr->pCachedData;
+      uint32_t nCachedDataCapacity = pCsr->nCachedDataCapacity;
+
+      p->pFreeCsr = pCsr->pNextFree;
+      p->nFreeCsr -= 1;
+      memset(pCsr, 0, sizeof(KVWTCursor));
+      pCsr->pCachedKey = pCachedKey;
+      pCsr->nCachedKeyCapacity = nCachedKeyCapacity;
+      pCsr->pCachedData = pCachedData;
+      pCsr->nCachedDataCapacity = nCachedDataCapacity;
+   }
+   else
+   {
+      pCsr = (KVWTCursor*)sqlite4_malloc(p->base.pEnv, sizeof(KVWTCursor));
+      if (pCsr != NULL)
+      {
+         memset(pCsr, 0, sizeof(KVWTCursor));
+      }
+   }
+   return pCsr;
+} // end of : kvwtAllocCursor(...){...}
+
+// Free a key or data buffer of a cursor if it is over 4 times 
+// the capacity a new one would get, see kvwtBufferCapacity().
+static void kvwtTrimBuffer(void ** ppBuf, uint32_t * pnCapacity, uint32_t nSeen, uint32_t nInitial)
+{
+   if (*ppBuf != NULL && *pnCapacity / 4 > kvwtBufferCapacity(nSeen, nInitial))
+   {
+      free(*ppBuf);
+      *ppBuf = NULL;
+      *pnCapacity = 0;
+   }
+} // end of : kvwtTrimBuffer(...){...}
+
+// Put a closed cursor on the free list, with its buffers 
+// trimmed to the sizes seen so far, or free it if the list is full.
+static void kvwtReleaseCursor(KVWT * p, KVWTCursor * pCsr)
+{
+   pCsr->iMagicKVWTCur = 0;
+   pCsr->nHasKeyAndDataCached = 0;
+   pCsr->nCachedKeySize = 0;
+   pCsr->nCachedDataSize = 0;
+   if (p->nFreeCsr < SQLITE4_KV_WT_MAX_FREE_CURSOR)
+   {
+      kvwtTrimBuffer(&pCsr->pCachedKey, &pCsr->nCachedKeyCapacity, p->nKeySizeSeen, p->nInitialCursorKeyBufferCapacity);
+      kvwtTrimBuffer(&pCsr->pCachedData, &pCsr->nCachedDataCapacity, p->nDataSizeSeen, p->nInitialCursorDataBufferCapacity);
+      pCsr->pNextFree = p->pFreeCsr;
+      p->pFreeCsr = pCsr;
+      p->nFreeCsr += 1;
+   }
+   else
+   {
+      free(pCsr->pCachedKey);
+      free(pCsr->pCachedData);
+      sqlite4_free(p->base.pEnv, pCsr);
+   }
+} // end of : kvwtReleaseCursor(...){...}
+
+// Free all cursors on the free list.
+static void kvwtFreeCursorPool(KVWT * p)
+{
+   while (p->pFreeCsr != NULL)
+   {
+      KVWTCursor * pCsr = p->pFreeCsr;
+      p->pFreeCsr = pCsr->pNextFree;
+      free(pCsr->pCachedKey);
+      free(pCsr->pCachedData);
+      sqlite4_free(p->base.pEnv, pCsr);
+   }
+   p->nFreeCsr = 0;
+} // end of : kvwtFreeCursorPool(...){...}
+
+// Cursor pool -- end -----------------------------------------------
+
 int kvwtOpenCursor(sqlite4_kvstore * pkvstore, sqlite4_kvcursor ** ppkvcursor) 
 {
    //printf("-----> kvwtOpenCursor()\n");  
@@ -130,7 +253,7 @@ int kvwtOpenCursor(sqlite4_kvstore * pkvstore, sqlite4_kvcursor ** ppkvcursor)
    int rc = SQLITE4_OK;
 
    KVWTCursor * pCsr = NULL;
-   pCsr = (KVWTCursor*)sqlite4_malloc(pkvstore->pEnv, sizeof(KVWTCursor));
+   pCsr = kvwtAllocCursor(p); // from the free list, or sqlite4_malloc'ed
    if (pCsr == 0)
    {
       // sqlite4_malloc failed
@@ -138,8 +261,7 @@ int kvwtOpenCursor(sqlite4_kvstore * pkvstore, sqlite4_kvcursor ** ppkvcursor)
    }
    else
    {
-      // sqlite4_malloc succeeded
-      memset(pCsr, 0, sizeof(KVWTCursor));
+      // succeeded
       // retrieve necessary WiredTiger objects -- begin
       WT_SESSION * psession = p->session;
       assert(psession != NULL);
@@ -222,13 +344,12 @@ int kvwtOpenCursor(sqlite4_kvstore * pkvstore, sqlite4_kvcursor ** ppkvcursor)
          pCsr->pCsr = pNewWiredTigerCursor; // the underlying WiredTiger cursor
           
          // Cached Key & Data Buffers -- begin
+         // (pCachedKey and pCachedData may be kept from a pooled cursor, 
+         // with their capacities, otherwise they are allocated by 
+         // the first kvwtKey() or kvwtData() call)
          pCsr->nHasKeyAndDataCached = 0;
-         pCsr->pCachedKey = NULL;
          pCsr->nCachedKeySize = 0;
-         pCsr->nCachedKeyCapacity = p->nInitialCursorKeyBufferCapacity;
-         pCsr->pCachedData = NULL;
          pCsr->nCachedDataSize = 0;
-         pCsr->nCachedDataCapacity = p->nInitialCursorDataBufferCapacity;
          // Cached Key & Data Buffers -- end
          //
          pCsr->iMagicKVWTCur = SQLITE4_KVWTCUR_MAGIC;
@@ -273,8 +394,8 @@ int kvwtOpenCursor(sqlite4_kvstore * pkvstore, sqlite4_kvcursor ** ppkvcursor)
    {
       if (rc != SQLITE4_NOMEM)
       {
-         // free the useless allocated memory
-         sqlite4_free(pkvstore->pEnv, pCsr);
+         // return the useless cursor to the free list
+         kvwtReleaseCursor(p, pCsr);
       }
    }
    //KVBdbOpenCursor_nomem:
@@ -1138,7 +1259,7 @@ int kvwtKey(
       // for key and data
       if (pCur->pCachedKey == NULL)
       {
-         pCur->pCachedKey = malloc(p->nInitialCursorKeyBufferCapacity);
+         pCur->pCachedKey = malloc(kvwtBufferCapacity(p->nKeySizeSeen, p->nInitialCursorKeyBufferCapacity));
          if (pCur->pCachedKey == NULL)
          {
             //printf("key: #3\n");
@@ -1146,12 +1267,12 @@ int kvwtKey(
             goto label_nomem;
          }
          pCur->nCachedKeySize = 0;
-         pCur->nCachedKeyCapacity = p->nInitialCursorKeyBufferCapacity;
+         pCur->nCachedKeyCapacity = kvwtBufferCapacity(p->nKeySizeSeen, p->nInitialCursorKeyBufferCapacity);
       }
 
       if (pCur->pCachedData == NULL)
       {
-         pCur->pCachedData = malloc(p->nInitialCursorDataBufferCapacity);
+         pCur->pCachedData = malloc(kvwtBufferCapacity(p->nDataSizeSeen, p->nInitialCursorDataBufferCapacity));
          if (pCur->pCachedData == NULL)
          {
             //printf("key: #4\n");
@@ -1159,7 +1280,7 @@ int kvwtKey(
             goto label_nomem;
          }
          pCur->nCachedDataSize = 0;
-         pCur->nCachedDataCapacity = p->nInitialCursorDataBufferCapacity;
+         pCur->nCachedDataCapacity = kvwtBufferCapacity(p->nDataSizeSeen, p->nInitialCursorDataBufferCapacity);
       }
 
       { // Try to retrieve <key, data>, re-allocate buffers if necessary -- begin
@@ -1222,6 +1343,7 @@ int kvwtKey(
             // 
             // mark key & data as cached
             pCur->nHasKeyAndDataCached = 1;
+            kvwtNoteCachedSizes(p, pCur);
             // 
             // Prepare return -- begin
             *paKey = (KVByteArray *)(pCur->pCachedKey);
@@ -1450,26 +1572,26 @@ int kvwtData(
       // for key and data
       if (pCur->pCachedKey == NULL)
       {
-         pCur->pCachedKey = malloc(p->nInitialCursorKeyBufferCapacity);
+         pCur->pCachedKey = malloc(kvwtBufferCapacity(p->nKeySizeSeen, p->nInitialCursorKeyBufferCapacity));
          if (pCur->pCachedKey == NULL)
          {
             rc = SQLITE4_NOMEM;
             goto label_nomem;
          }
          pCur->nCachedKeySize = 0;
-         pCur->nCachedKeyCapacity = p->nInitialCursorKeyBufferCapacity;
+         pCur->nCachedKeyCapacity = kvwtBufferCapacity(p->nKeySizeSeen, p->nInitialCursorKeyBufferCapacity);
       }
 
       if (pCur->pCachedData == NULL)
       {
-         pCur->pCachedData = malloc(p->nInitialCursorDataBufferCapacity);
+         pCur->pCachedData = malloc(kvwtBufferCapacity(p->nDataSizeSeen, p->nInitialCursorDataBufferCapacity));
          if (pCur->pCachedData == NULL)
          {
             rc = SQLITE4_NOMEM;
             goto label_nomem;
          }
          pCur->nCachedDataSize = 0;
-         pCur->nCachedDataCapacity = p->nInitialCursorDataBufferCapacity;
+         pCur->nCachedDataCapacity = kvwtBufferCapacity(p->nDataSizeSeen, p->nInitialCursorDataBufferCapacity);
       }
 
       { // Try to retrieve <key, data>, re-allocate buffers if necessary -- begin
@@ -1532,6 +1654,7 @@ int kvwtData(
             // 
             // mark key & data as cached
             pCur->nHasKeyAndDataCached = 1;
+            kvwtNoteCachedSizes(p, pCur);
             // 
             // Prepare return -- begin
             if (n<0)
@@ -1762,23 +1885,7 @@ int kvwtCloseCursor(sqlite4_kvcursor *pKVCursor) {
 
    int rc = SQLITE4_OK;
 
-   // Cached Key & Data Buffers -- begin
-   if (pCur->pCachedKey != NULL)
-   {
-      free(pCur->pCachedKey);
-      pCur->pCachedKey = NULL;
-      pCur->nCachedKeySize = 0;
-      pCur->nCachedKeyCapacity = 0;
-   }
-   if (pCur->pCachedData != NULL)
-   {
-      free(pCur->pCachedData);
-      pCur->pCachedData = NULL;
-      pCur->nCachedDataSize = 0;
-      pCur->nCachedDataCapacity = 0;
-   }
-   pCur->nHasKeyAndDataCached = 0;
-   // Cached Key & Data Buffers -- end
+   // Cached Key & Data Buffers are kept for reuse, see kvwtReleaseCursor()
 
    pCur->nIsEOF = 0; // EOF not encountered yet
    pCur->nLastSeekDir = SEEK_DIR_NONE;
@@ -1834,6 +1941,8 @@ int kvwtCloseCursor(sqlite4_kvcursor *pKVCursor) {
       break;
    };
 
+   kvwtReleaseCursor(p, pCur);
+
    return rc;
 } // end of : kvwtCloseCursor(...){...}
 
@@ -2326,6 +2435,16 @@ int kvwtCommitPhaseOneXID(KVStore *pKVStore, int iLevel, void * xid) {
 }
 
 
+/*
+** Count a write transaction commit of connection p,
+** see SQLITE4_KVCTRL_DATA_VERSION in kvwtControl(...).
+*/
+static void kvwtNoteCommit(KVWT * p)
+{
+   oDataVersion.fetch_add(1);
+   p->nOwnCommit++;
+} // end of : kvwtNoteCommit(...){...}
+
 int kvwtCommitPhaseTwo(KVStore *pKVStore, int iLevel) {
    //printf("-----> kvwtCommitPhaseTwo(%p,%d)\n", pKVStore, iLevel);  
 
@@ -2355,8 +2474,23 @@ int kvwtCommitPhaseTwo(KVStore *pKVStore, int iLevel) {
             char cBufCommit[128];
             size_t nCounter = oCounter.fetch_add(1);;
             sprintf(cBufCommit, "commit_timestamp=%lld", nCounter);
+            if (p->eSync >= 0)
+            {
+               strcat(cBufCommit, azKVWTCommitSync[p->eSync]);
+            }
 
+            // The data version is bumped both before and after the commit, 
+            // so that a row read by another connection while the commit 
+            // is in progress is not trusted afterwards.
+            if (iLevel < 2)
+            {
+               kvwtNoteCommit(p);
+            }
             int ret = p->session->commit_transaction(p->session, cBufCommit);
+            if (iLevel < 2)
+            {
+               kvwtNoteCommit(p);
+            }
             switch (ret)
             {
             case 0:
@@ -2418,6 +2552,14 @@ int kvwtCommitPhaseTwo(KVStore *pKVStore, int iLevel) {
                   pCsr->close(pCsr);
                }
             }
+
+            // Write a periodic snapshot, if one is due.
+            // The commit has succeeded anyway, 
+            // so a failed snapshot is not reported here.
+            if (rc == SQLITE4_OK && p->xSnapshot)
+            {
+               p->xSnapshot(p, 0);
+            }
          } // end of block : if(pTxnPrepareCandidate != NULL){...}
       } // end block : if(KVStore->iTransLevel >= 2){...}
    } // end block : if(KVStore->iTransLevel > iLevel){...}
@@ -2684,6 +2826,9 @@ int kvwtClose(sqlite4_kvstore * pkvstore)
 
    //free(pkvstore);
 
+   // cursors kept for reuse
+   kvwtFreeCursorPool(pKVWT);
+
    // DTOR of KVWT should clean cursor(s) and a session
    delete pKVWT; // ???
 
@@ -2694,6 +2839,69 @@ int kvwtControl(sqlite4_kvstore * pkvstore, int n, void * arg)
 {
    //printf("-----> kvwtControl()\n");
 
+   KVWT *p = (KVWT*)pkvstore;
+   assert(p->iMagicKVWTBase == SQLITE4_KVWTBASE_MAGIC);
+
+   // Changes only when another connection of this process commits
+   if (n == SQLITE4_KVCTRL_DATA_VERSION)
+   {
+      *(sqlite4_uint64 *)arg = oDataVersion.load() - p->nOwnCommit;
+      return SQLITE4_OK;
+   }
+
+   if (n == SQLITE4_KVCTRL_SNAPSHOT && p->xSnapshot)
+   {
+      return p->xSnapshot(p, 1);
+   }
+
+   // Logged, disk-backed databases only
+   if (p->eSync >= 0)
+   {
+      int ret = 0;
+      WT_SESSION * pSession = nullptr;
+      switch (n)
+      {
+      case SQLITE4_KVCTRL_SYNCHRONOUS:
+      {
+         int * peSync = (int *)arg;
+         if (*peSync >= 0 && *peSync <= 2)
+         {
+            p->eSync = *peSync;
+         }
+         *peSync = p->eSync;
+         return SQLITE4_OK;
+      }
+      case SQLITE4_KVCTRL_LSM_FLUSH:
+      case SQLITE4_KVCTRL_LSM_CHECKPOINT:
+         // Neither may run in a session with an open transaction, 
+         // so a separate session is used.
+         ret = p->conn->open_session(p->conn, NULL, NULL, &pSession);
+         if (ret == 0)
+         {
+            if (n == SQLITE4_KVCTRL_LSM_FLUSH)
+            {
+               // Make every transaction committed so far durable
+               ret = pSession->log_flush(pSession, "sync=on");
+            }
+            else
+            {
+               ret = pSession->checkpoint(pSession, NULL);
+            }
+            pSession->close(pSession, NULL);
+         }
+         break;
+      default:
+         return SQLITE4_NOTFOUND;
+      }
+      if (ret != 0)
+      {
+         // Integrate with SQLite4/M diagnostics!
+         printf("Failed kvwtControl(%d) : error : '%s'\n", n, wiredtiger_strerror(ret));
+         return SQLITE4_IOERR;
+      }
+      return SQLITE4_OK;
+   }
+
    //return SQLITE4_OK;
    return SQLITE4_NOTFOUND; // similar to what kvbdbControl(...) does
 }
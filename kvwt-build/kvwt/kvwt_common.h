@@ -24,6 +24,13 @@ extern uint32_t nGlobalDefaultInitialCursorDataBufferCapacity;
 
 typedef struct KVWT KVWT;
 typedef struct KVWTCursor KVWTCursor;
+typedef struct KVWTEnv KVWTEnv;
+
+// kvstore_control() op writing a snapshot of the database, 
+// see SQLITE4_KVCTRL_SNAPSHOT in "sqlite.h.in".
+#ifndef SQLITE4_KVCTRL_SNAPSHOT
+#define SQLITE4_KVCTRL_SNAPSHOT 6
+#endif
 
 //#ifdef WIN32 // already typedef'ed in "kvwt.h"
 //typedef __int32 int32_t;
@@ -31,6 +38,11 @@ typedef struct KVWTCursor KVWTCursor;
 //#endif
 
 #define SQLITE4_KV_WT_MAX_TXN_DEPTH 16
+
+// Closed cursors are kept, with their key and data buffers, 
+// on a per-connection free list of at most this many entries 
+// and reused by later kvwtOpenCursor() calls.
+#define SQLITE4_KV_WT_MAX_FREE_CURSOR 8
 #define SQLITE4_KVWTBASE_MAGIC  0xdfeb57f1
 struct KVWT
 {
@@ -61,8 +73,30 @@ struct KVWT
    // for cursors -- begin
    uint32_t nInitialCursorKeyBufferCapacity;
    uint32_t nInitialCursorDataBufferCapacity;
+   KVWTCursor * pFreeCsr;     // Closed cursors kept for reuse, see kvwtAllocCursor()
+   int nFreeCsr;              // Number of entries in pFreeCsr list
+   uint32_t nKeySizeSeen;     // Largest key read by any cursor so far
+   uint32_t nDataSizeSeen;    // Largest data read by any cursor so far
    // for cursors -- end
 
+   // for snapshots -- begin
+   // Set by factories which can save the database to a snapshot file.
+   // xSnapshot(p, 1) writes a snapshot now; xSnapshot(p, 0) writes one 
+   // only if the configured snapshot interval has elapsed, 
+   // and is called after each successful write commit.
+   KVWTEnv * pKVWTEnv;
+   int (*xSnapshot)(KVWT *, int bForce);
+   // for snapshots -- end
+
+   // Synchronous level of commits (0, 1, 2 for OFF, NORMAL, FULL) 
+   // for logged, disk-backed databases; -1 for in-memory ones.
+   // See SQLITE4_KVCTRL_SYNCHRONOUS.
+   int eSync;
+
+   // Write transactions committed by this connection; 
+   // see SQLITE4_KVCTRL_DATA_VERSION.
+   uint64_t nOwnCommit;
+
    KVWT()
       : openFlags(0)
       , nCursor(0)
@@ -75,6 +109,14 @@ struct KVWT
       , nInitialCursorKeyBufferCapacity(nGlobalDefaultInitialCursorKeyBufferCapacity)
       //, nInitialCursorDataBufferCapacity(0)
       , nInitialCursorDataBufferCapacity(nGlobalDefaultInitialCursorDataBufferCapacity)
+      , pFreeCsr(nullptr)
+      , nFreeCsr(0)
+      , nKeySizeSeen(0)
+      , nDataSizeSeen(0)
+      , pKVWTEnv(nullptr)
+      , xSnapshot(nullptr)
+      , eSync(-1)
+      , nOwnCommit(0)
    {
       memset(name, 0, 128);
       memset(table_name, 0, 128);
@@ -156,6 +198,8 @@ struct KVWTCursor {
    int nIsEOF;
 
    int nLastSeekDir;
+
+   KVWTCursor * pNextFree; // next in KVWT::pFreeCsr list
 };
 #define SQLITE4_KVWTCUR_MAGIC   0xd09afc30
 
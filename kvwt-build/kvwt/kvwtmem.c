@@ -1,6 +1,16 @@
 #include "kvwt_common.h"
 
 #include <map>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 //uint32_t nGlobalDefaultInitialCursorKeyBufferCapacity = 16384; // 16 k
 //uint32_t nGlobalDefaultInitialCursorDataBufferCapacity = 16384; // 16 k
@@ -14,9 +24,18 @@ struct KVWTEnv {
    char table_name[128];
    uint32_t n_ref;
 
+   // for snapshots -- begin
+   std::string snapshot_path;      // snapshot file, empty if none configured
+   sqlite4_int64 snapshot_interval; // seconds between periodic snapshots, 0 for none
+   std::chrono::steady_clock::time_point snapshot_time; // time of the last snapshot
+   std::mutex snapshot_mutex;      // held while a snapshot is written
+   // for snapshots -- end
+
    KVWTEnv()
       : conn(nullptr)
       , n_ref(0)
+      , snapshot_interval(0)
+      , snapshot_time(std::chrono::steady_clock::now())
    {
       memset(db_name, 0, 128);
       memset(table_name, 0, 128);
@@ -35,18 +54,444 @@ struct KVWTEnv {
    }
 };
 
-std::mutex gKVWTEnvMapMutex;
-std::map<std::string, KVWTEnv*> gKVWTEnvMap;
+// Registry of KVWTEnv objects by database name.  It is split into
+// shards, each with its own mutex, so that opening databases with
+// different names does not serialize on one lock (wiredtiger_open()
+// runs while the shard is locked).  Entries are never removed.
+#define KVWT_ENV_NSHARD 16
+
+struct KVWTEnvShard {
+   std::mutex mutex;
+   std::map<std::string, KVWTEnv*> map;
+};
+
+KVWTEnvShard gKVWTEnvShards[KVWT_ENV_NSHARD];
+
+static KVWTEnvShard & kvwtEnvShard(const char * zName)
+{
+   size_t h = std::hash<std::string>()(std::string(zName));
+   return gKVWTEnvShards[h % KVWT_ENV_NSHARD];
+}
+
+// Configuration of the SQLite4/M table, 
+// shared by the snapshot loader and acquireWTResources(...).
+static const char * zKVWTTableConfig = "access_pattern_hint=sequential, cache_resident=true, ignore_in_memory_cache_size=true, key_format=u,value_format=u";
+
+// =======================================================================================
+// Snapshots
+//
+// WiredTiger runs here with in_memory=true, so the database is lost 
+// when the process exits. A snapshot saves it to a file, 
+// from which it is bulk-loaded when the database is next opened, 
+// so that restart time is bounded by sequential I/O 
+// rather than by SQL insert throughput.
+//
+// Snapshots are configured by URI parameters of the first open 
+// of a database in the process:
+//
+//    snapshot=PATH           the snapshot file; without it snapshots are off
+//    snapshot_interval=N     write a snapshot after a commit 
+//                            when N seconds have passed since the last one
+//
+// A snapshot is also written on demand by 
+// sqlite4_kvstore_control(db, "main", SQLITE4_KVCTRL_SNAPSHOT, 0).
+//
+// A snapshot is a consistent read of the table inside 
+// a snapshot-isolation transaction, so writers are not blocked. 
+// It is written to PATH-tmp, synced, and renamed over PATH.
+//
+// File format (integers are big-endian):
+//
+//    header  : "KVWTSNAP", u32 version (1), u32 reserved (0)
+//    records : u32 nKey, u32 nData, key, data -- in key order
+//    trailer : u32 0xFFFFFFFF, u32 0, u64 nRecord, u32 s1, u32 s2
+//
+// (s1, s2) is a Fletcher-style checksum of all record bytes.
+// =======================================================================================
+
+#define KVWT_SNAPSHOT_VERSION 1
+#define KVWT_SNAPSHOT_TRAILER 0xFFFFFFFF
+
+struct KVWTSnapshotFile {
+   FILE * f;
+   uint32_t s1;
+   uint32_t s2;
+
+   KVWTSnapshotFile()
+      : f(nullptr)
+      , s1(1)
+      , s2(0)
+   {
+   }
+
+   ~KVWTSnapshotFile()
+   {
+      if (f)
+      {
+         fclose(f);
+         f = nullptr;
+      }
+   }
+
+   void checksum(const unsigned char * a, size_t n)
+   {
+      for (size_t i = 0; i < n; ++i)
+      {
+         s1 += a[i];
+         s2 += s1;
+      }
+   }
+
+   static void put32(unsigned char * a, uint32_t v)
+   {
+      a[0] = (unsigned char)(v >> 24);
+      a[1] = (unsigned char)(v >> 16);
+      a[2] = (unsigned char)(v >> 8);
+      a[3] = (unsigned char)v;
+   }
+
+   static uint32_t get32(const unsigned char * a)
+   {
+      return ((uint32_t)a[0] << 24) | ((uint32_t)a[1] << 16) | ((uint32_t)a[2] << 8) | (uint32_t)a[3];
+   }
+
+   bool write(const void * a, size_t n, bool bChecksum)
+   {
+      if (bChecksum)
+      {
+         checksum((const unsigned char *)a, n);
+      }
+      return n == 0 || fwrite(a, 1, n, f) == n;
+   }
+
+   bool read(void * a, size_t n, bool bChecksum)
+   {
+      if (n != 0 && fread(a, 1, n, f) != n)
+      {
+         return false;
+      }
+      if (bChecksum)
+      {
+         checksum((const unsigned char *)a, n);
+      }
+      return true;
+   }
+
+   bool sync()
+   {
+      if (fflush(f) != 0)
+      {
+         return false;
+      }
+#ifdef _WIN32
+      return _commit(_fileno(f)) == 0;
+#else
+      return fsync(fileno(f)) == 0;
+#endif
+   }
+};
+
+static int renameSnapshotFile(const char * zFrom, const char * zTo)
+{
+#ifdef _WIN32
+   if (!MoveFileExA(zFrom, zTo, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+   {
+      return SQLITE4_IOERR;
+   }
+#else
+   if (rename(zFrom, zTo) != 0)
+   {
+      return SQLITE4_IOERR;
+   }
+#endif
+   return SQLITE4_OK;
+}
+
+// Write a snapshot of the database of pKVWTEnv.
+// The caller holds pKVWTEnv->snapshot_mutex.
+static int saveKVWTSnapshot(KVWTEnv * pKVWTEnv)
+{
+   int rc = SQLITE4_OK;
+   int ret = 0;
+   std::string oTmpPath = pKVWTEnv->snapshot_path + "-tmp";
+   WT_SESSION * pSession = nullptr;
+   WT_CURSOR * pCsr = nullptr;
+   sqlite4_uint64 nRecord = 0;
+   KVWTSnapshotFile oFile;
+
+   ret = pKVWTEnv->conn->open_session(pKVWTEnv->conn, NULL, "isolation=snapshot", &pSession);
+   if (ret == 0)
+   {
+      ret = pSession->begin_transaction(pSession, "isolation=snapshot");
+   }
+   if (ret == 0)
+   {
+      ret = pSession->open_cursor(pSession, pKVWTEnv->table_name, NULL, NULL, &pCsr);
+   }
+   if (ret != 0)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed saveKVWTSnapshot(...) : error : '%s'\n", wiredtiger_strerror(ret));
+      rc = SQLITE4_ERROR;
+   }
+
+   if (rc == SQLITE4_OK)
+   {
+      oFile.f = fopen(oTmpPath.c_str(), "wb");
+      if (!oFile.f)
+      {
+         rc = SQLITE4_CANTOPEN;
+      }
+   }
+   if (rc == SQLITE4_OK)
+   {
+      unsigned char aHdr[16];
+      setvbuf(oFile.f, NULL, _IOFBF, 1 << 20);
+      memcpy(aHdr, "KVWTSNAP", 8);
+      KVWTSnapshotFile::put32(&aHdr[8], KVWT_SNAPSHOT_VERSION);
+      KVWTSnapshotFile::put32(&aHdr[12], 0);
+      if (!oFile.write(aHdr, 16, false))
+      {
+         rc = SQLITE4_IOERR;
+      }
+   }
+
+   // Stream the records in key order
+   while (rc == SQLITE4_OK && (ret = pCsr->next(pCsr)) == 0)
+   {
+      WT_ITEM oKey;
+      WT_ITEM oData;
+      unsigned char aLen[8];
+      ret = pCsr->get_key(pCsr, &oKey);
+      if (ret == 0)
+      {
+         ret = pCsr->get_value(pCsr, &oData);
+      }
+      if (ret != 0)
+      {
+         rc = SQLITE4_ERROR;
+         break;
+      }
+      KVWTSnapshotFile::put32(aLen, (uint32_t)oKey.size);
+      KVWTSnapshotFile::put32(&aLen[4], (uint32_t)oData.size);
+      if (!oFile.write(aLen, 8, true)
+         || !oFile.write(oKey.data, oKey.size, true)
+         || !oFile.write(oData.data, oData.size, true))
+      {
+         rc = SQLITE4_IOERR;
+         break;
+      }
+      ++nRecord;
+   }
+   if (rc == SQLITE4_OK && ret != WT_NOTFOUND)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed saveKVWTSnapshot(...) : cursor->next(...) : error : '%s'\n", wiredtiger_strerror(ret));
+      rc = SQLITE4_ERROR;
+   }
+
+   if (rc == SQLITE4_OK)
+   {
+      unsigned char aTrailer[24];
+      KVWTSnapshotFile::put32(aTrailer, KVWT_SNAPSHOT_TRAILER);
+      KVWTSnapshotFile::put32(&aTrailer[4], 0);
+      KVWTSnapshotFile::put32(&aTrailer[8], (uint32_t)(nRecord >> 32));
+      KVWTSnapshotFile::put32(&aTrailer[12], (uint32_t)nRecord);
+      KVWTSnapshotFile::put32(&aTrailer[16], oFile.s1);
+      KVWTSnapshotFile::put32(&aTrailer[20], oFile.s2);
+      if (!oFile.write(aTrailer, 24, false) || !oFile.sync())
+      {
+         rc = SQLITE4_IOERR;
+      }
+   }
+   if (oFile.f)
+   {
+      if (fclose(oFile.f) != 0 && rc == SQLITE4_OK)
+      {
+         rc = SQLITE4_IOERR;
+      }
+      oFile.f = nullptr;
+   }
+   if (rc == SQLITE4_OK)
+   {
+      rc = renameSnapshotFile(oTmpPath.c_str(), pKVWTEnv->snapshot_path.c_str());
+   }
+   if (rc != SQLITE4_OK)
+   {
+      remove(oTmpPath.c_str());
+   }
+
+   if (pSession)
+   {
+      // closes pCsr and ends the read-only transaction
+      pSession->close(pSession, NULL);
+   }
+   return rc;
+} // end of saveKVWTSnapshot(...){...}
+
+// Bulk-load the snapshot of pKVWTEnv, if there is one, 
+// into the newly created table. 
+// The records are in key order, as a bulk cursor requires.
+static int loadKVWTSnapshot(KVWTEnv * pKVWTEnv)
+{
+   int rc = SQLITE4_OK;
+   int ret = 0;
+   WT_SESSION * pSession = nullptr;
+   WT_CURSOR * pCsr = nullptr;
+   sqlite4_uint64 nRecord = 0;
+   std::vector<unsigned char> aKey;
+   std::vector<unsigned char> aData;
+   KVWTSnapshotFile oFile;
+   unsigned char aHdr[24];
+
+   oFile.f = fopen(pKVWTEnv->snapshot_path.c_str(), "rb");
+   if (!oFile.f)
+   {
+      return SQLITE4_OK; // no snapshot yet
+   }
+   setvbuf(oFile.f, NULL, _IOFBF, 1 << 20);
+   if (!oFile.read(aHdr, 16, false)
+      || memcmp(aHdr, "KVWTSNAP", 8) != 0
+      || KVWTSnapshotFile::get32(&aHdr[8]) != KVWT_SNAPSHOT_VERSION)
+   {
+      return SQLITE4_CORRUPT;
+   }
+
+   ret = pKVWTEnv->conn->open_session(pKVWTEnv->conn, NULL, NULL, &pSession);
+   if (ret == 0)
+   {
+      ret = pSession->create(pSession, pKVWTEnv->table_name, zKVWTTableConfig);
+   }
+   if (ret == 0)
+   {
+      ret = pSession->open_cursor(pSession, pKVWTEnv->table_name, NULL, "bulk", &pCsr);
+   }
+   if (ret != 0)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed loadKVWTSnapshot(...) : error : '%s'\n", wiredtiger_strerror(ret));
+      rc = SQLITE4_ERROR;
+   }
+
+   while (rc == SQLITE4_OK)
+   {
+      uint32_t nKey;
+      uint32_t nData;
+      if (!oFile.read(aHdr, 8, false))
+      {
+         rc = SQLITE4_CORRUPT;
+         break;
+      }
+      nKey = KVWTSnapshotFile::get32(aHdr);
+      nData = KVWTSnapshotFile::get32(&aHdr[4]);
+      if (nKey == KVWT_SNAPSHOT_TRAILER)
+      {
+         break;
+      }
+      oFile.checksum(aHdr, 8);
+      aKey.resize(nKey);
+      aData.resize(nData);
+      if (!oFile.read(aKey.data(), nKey, true) || !oFile.read(aData.data(), nData, true))
+      {
+         rc = SQLITE4_CORRUPT;
+         break;
+      }
+      WT_ITEM oKey;
+      oKey.data = aKey.data();
+      oKey.size = nKey;
+      WT_ITEM oData;
+      oData.data = aData.data();
+      oData.size = nData;
+      pCsr->set_key(pCsr, &oKey);
+      pCsr->set_value(pCsr, &oData);
+      ret = pCsr->insert(pCsr);
+      if (ret != 0)
+      {
+         // Integrate with SQLite4/M diagnostics!
+         printf("Failed loadKVWTSnapshot(...) : cursor->insert(...) : error : '%s'\n", wiredtiger_strerror(ret));
+         rc = SQLITE4_ERROR;
+         break;
+      }
+      ++nRecord;
+   }
+
+   if (rc == SQLITE4_OK)
+   {
+      if (!oFile.read(&aHdr[8], 16, false)
+         || (((sqlite4_uint64)KVWTSnapshotFile::get32(&aHdr[8]) << 32) | KVWTSnapshotFile::get32(&aHdr[12])) != nRecord
+         || KVWTSnapshotFile::get32(&aHdr[16]) != oFile.s1
+         || KVWTSnapshotFile::get32(&aHdr[20]) != oFile.s2)
+      {
+         rc = SQLITE4_CORRUPT;
+      }
+   }
+
+   if (pSession)
+   {
+      if (pCsr)
+      {
+         pCsr->close(pCsr);
+      }
+      if (rc != SQLITE4_OK)
+      {
+         // Do not leave a partially loaded table behind.
+         pSession->drop(pSession, pKVWTEnv->table_name, NULL);
+      }
+      pSession->close(pSession, NULL);
+   }
+   if (rc == SQLITE4_CORRUPT)
+   {
+      // Integrate with SQLite4/M diagnostics!
+      printf("Failed loadKVWTSnapshot(...) : snapshot file '%s' is corrupt\n", pKVWTEnv->snapshot_path.c_str());
+   }
+   return rc;
+} // end of loadKVWTSnapshot(...){...}
+
+// KVWT::xSnapshot for kvwtmem databases, see "kvwt_common.h".
+static int kvwtmemSnapshot(KVWT * pKVWT, int bForce)
+{
+   KVWTEnv * pKVWTEnv = pKVWT->pKVWTEnv;
+   std::unique_lock<std::mutex> oLock(pKVWTEnv->snapshot_mutex, std::defer_lock);
+
+   if (bForce)
+   {
+      oLock.lock();
+   }
+   else
+   {
+      if (pKVWTEnv->snapshot_interval <= 0)
+      {
+         return SQLITE4_OK;
+      }
+      // Skip if another connection is writing a snapshot right now.
+      if (!oLock.try_lock())
+      {
+         return SQLITE4_OK;
+      }
+      auto oElapsed = std::chrono::steady_clock::now() - pKVWTEnv->snapshot_time;
+      if (oElapsed < std::chrono::seconds(pKVWTEnv->snapshot_interval))
+      {
+         return SQLITE4_OK;
+      }
+   }
+
+   int rc = saveKVWTSnapshot(pKVWTEnv);
+   // On failure too, so that a failing periodic snapshot 
+   // is not retried after every commit.
+   pKVWTEnv->snapshot_time = std::chrono::steady_clock::now();
+   return rc;
+} // end of kvwtmemSnapshot(...){...}
 
 KVWTEnv * acquireKVWTEnv(const char * zName)
 {
    //printf("-----> KVWTMem::acquireKVWTEnv(...)\n");
 
-   std::lock_guard<std::mutex> oLock(gKVWTEnvMapMutex);
+   KVWTEnvShard & oShard = kvwtEnvShard(zName);
+   std::lock_guard<std::mutex> oLock(oShard.mutex);
    KVWTEnv * pKVWTEnv = nullptr;
 
-   auto it = gKVWTEnvMap.find(zName);
-   if (it != gKVWTEnvMap.end())
+   auto it = oShard.map.find(zName);
+   if (it != oShard.map.end())
    {
       // found
       pKVWTEnv = it->second;
@@ -76,7 +521,22 @@ KVWTEnv * acquireKVWTEnv(const char * zName)
          {
             // success
 
-            gKVWTEnvMap.insert(std::pair<std::string, KVWTEnv*>(zName, pKVWTEnv));
+            // Restore the database from its snapshot, if configured
+            const char * zSnapshot = sqlite4_uri_parameter(zName, "snapshot");
+            if (zSnapshot && zSnapshot[0])
+            {
+               pKVWTEnv->snapshot_path = zSnapshot;
+               pKVWTEnv->snapshot_interval = sqlite4_uri_int64(zName, "snapshot_interval", 0);
+               if (loadKVWTSnapshot(pKVWTEnv) != SQLITE4_OK)
+               {
+                  delete pKVWTEnv;
+                  pKVWTEnv = nullptr;
+               }
+            }
+         }
+         if (pKVWTEnv)
+         {
+            oShard.map.insert(std::pair<std::string, KVWTEnv*>(zName, pKVWTEnv));
          }
       }
       catch (...)
@@ -133,7 +593,7 @@ int acquireWTResources(const char * zName, KVWT * pKVWT)
    }
 
    // Create a table for SQLite4/M database
-   ret = pKVWT->session->create(pKVWT->session, pKVWTEnv->table_name, "access_pattern_hint=sequential, cache_resident=true, ignore_in_memory_cache_size=true, key_format=u,value_format=u");
+   ret = pKVWT->session->create(pKVWT->session, pKVWTEnv->table_name, zKVWTTableConfig);
    if (ret != 0)
    {
       // Integrate with SQLite4/M diagnostics!
@@ -152,6 +612,13 @@ int acquireWTResources(const char * zName, KVWT * pKVWT)
    // strcpy(pKVWT->name, pKVWTEnv->db_name); // moved to CTOR
    strcpy(pKVWT->table_name, pKVWTEnv->table_name);
    //
+   // snapshots, if configured for the database
+   if (!pKVWTEnv->snapshot_path.empty())
+   {
+      pKVWT->pKVWTEnv = pKVWTEnv;
+      pKVWT->xSnapshot = kvwtmemSnapshot;
+   }
+   //
    //// set initial buffer sizes for Cursor's Key and Value -- moved to CTOR
    //pKVWT->nInitialCursorKeyBufferCapacity = nGlobalDefaultInitialCursorKeyBufferCapacity;
    //pKVWT->nInitialCursorDataBufferCapacity = nGlobalDefaultInitialCursorDataBufferCapacity;
@@ -218,6 +218,11 @@ struct sdb_vm {
     char has_values;        /* true when step succeeds */
 
     char temp;              /* temporary vm used in db:rows */
+
+    /* buffers reused by stmt:fetch_batch */
+    sqlite4_batch_column *batch;
+    int batch_columns;      /* number of entries in batch */
+    int batch_rows;         /* rows the batch buffers have room for */
 };
 
 /* called with db,sql text on the lua stack */
@@ -232,6 +237,9 @@ static sdb_vm *newvm(lua_State *L, sdb *db) {
     svm->has_values = 0;
     svm->vm = NULL;
     svm->temp = 0;
+    svm->batch = NULL;
+    svm->batch_columns = 0;
+    svm->batch_rows = 0;
 
     /* add an entry on the database table: svm -> db to keep db live while svm is live */
     lua_pushlightuserdata(L, db);     /* db sql svm_ud db_lud -- */
@@ -244,6 +252,8 @@ static sdb_vm *newvm(lua_State *L, sdb *db) {
     return svm;
 }
 
+static void batch_free(sqlite4_batch_column *cols, int columns);
+
 static int cleanupvm(lua_State *L, sdb_vm *svm) {
 
     /* remove entry in database table - no harm if not present in the table */
@@ -257,6 +267,11 @@ static int cleanupvm(lua_State *L, sdb_vm *svm) {
     svm->columns = 0;
     svm->has_values = 0;
 
+    batch_free(svm->batch, svm->batch_columns);
+    svm->batch = NULL;
+    svm->batch_columns = 0;
+    svm->batch_rows = 0;
+
     if (!svm->vm) return 0;
 
     lua_pushinteger(L, sqlite4_finalize(svm->vm));
@@ -510,6 +525,145 @@ static int dbvm_get_named_types(lua_State *L) {
     return 1;
 }
 
+/*
+** =======================================================
+** Virtual Machine - batched fetch
+** =======================================================
+*/
+
+#define LSQLITE4_BATCH_DATA 4096    /* initial text/blob buffer per column */
+
+static void batch_free(sqlite4_batch_column *cols, int columns) {
+    int n;
+    if (cols == NULL) return;
+    for (n = 0; n < columns; ++n) {
+        free(cols[n].aType);
+        free(cols[n].aInt);
+        free(cols[n].aReal);
+        free(cols[n].aOffset);
+        free(cols[n].aData);
+    }
+    free(cols);
+}
+
+static sqlite4_batch_column *batch_alloc(int columns, int k) {
+    sqlite4_batch_column *cols = (sqlite4_batch_column*)calloc(columns ? columns : 1, sizeof(*cols));
+    int n;
+    if (cols == NULL) return NULL;
+    for (n = 0; n < columns; ++n) {
+        sqlite4_batch_column *c = &cols[n];
+        c->eType = 0; /* store each value with its own type */
+        c->aType = (unsigned char*)malloc(k);
+        c->aInt = (sqlite4_int64*)malloc(k * sizeof(sqlite4_int64));
+        c->aReal = (double*)malloc(k * sizeof(double));
+        c->aOffset = (int*)malloc((k + 1) * sizeof(int));
+        c->aData = (char*)malloc(LSQLITE4_BATCH_DATA);
+        c->nData = LSQLITE4_BATCH_DATA;
+        if (!c->aType || !c->aInt || !c->aReal || !c->aOffset || !c->aData) {
+            batch_free(cols, columns);
+            return NULL;
+        }
+    }
+    return cols;
+}
+
+static int batch_grow(sqlite4_batch_column *cols, int columns) {
+    int n;
+    for (n = 0; n < columns; ++n) {
+        char *aData = (char*)realloc(cols[n].aData, cols[n].nData * 2);
+        if (aData == NULL) return 0;
+        cols[n].aData = aData;
+        cols[n].nData *= 2;
+    }
+    return 1;
+}
+
+/* return buffers for k rows of the statement's columns, reusing those of the previous call */
+static sqlite4_batch_column *batch_reserve(sdb_vm *svm, int columns, int k) {
+    if (svm->batch == NULL || svm->batch_columns != columns || svm->batch_rows < k) {
+        batch_free(svm->batch, svm->batch_columns);
+        svm->batch = batch_alloc(columns, k);
+        svm->batch_columns = svm->batch ? columns : 0;
+        svm->batch_rows = svm->batch ? k : 0;
+    }
+    return svm->batch;
+}
+
+/* push rows [0..n) of the batch onto the table at the top of the stack, starting at index first */
+static void batch_push_rows(lua_State *L, sqlite4_batch_column *cols, int columns, int n, int first) {
+    int r, c;
+    for (r = 0; r < n; ++r) {
+        lua_createtable(L, columns, 0);
+        for (c = 0; c < columns; ++c) {
+            sqlite4_batch_column *col = &cols[c];
+            switch (col->aType[r]) {
+                case SQLITE4_INTEGER:
+                    PUSH_INT64(L, col->aInt[r], lua_pushnumber(L, (lua_Number)col->aInt[r]));
+                    break;
+                case SQLITE4_FLOAT:
+                    lua_pushnumber(L, col->aReal[r]);
+                    break;
+                case SQLITE4_TEXT:
+                case SQLITE4_BLOB:
+                    lua_pushlstring(L, col->aData + col->aOffset[r], col->aOffset[r + 1] - col->aOffset[r]);
+                    break;
+                default:
+                    lua_pushnil(L);
+                    break;
+            }
+            lua_rawseti(L, -2, c + 1);
+        }
+        lua_rawseti(L, -2, first + r);
+    }
+}
+
+/*
+** stmt:fetch_batch(k)
+** Returns an array of up to k rows, each an array of column values (as
+** returned by get_values), using a single sqlite4_step_batch() call per
+** batch instead of one sqlite4_column_* call per value. Fewer than k rows
+** are returned only at the end of the result set. The buffers are kept
+** with the statement and reused by the next call.
+*/
+static int dbvm_fetch_batch(lua_State *L) {
+    sdb_vm *svm = lsqlite4_checkvm(L, 1);
+    sqlite4_stmt *vm = svm->vm;
+    int k = luaL_checkint(L, 2);
+    int columns = sqlite4_column_count(vm);
+    sqlite4_batch_column *cols;
+    int nrows = 0;
+    int result = SQLITE4_ROW;
+
+    luaL_argcheck(L, k > 0, 2, "batch size must be positive");
+    cols = batch_reserve(svm, columns, k);
+    if (cols == NULL) {
+        luaL_error(L, "out of memory");
+    }
+
+    svm->has_values = 0;
+    lua_createtable(L, k, 0);
+    while (nrows < k) {
+        int n = 0;
+        result = sqlite4_step_batch(vm, k - nrows, columns, cols, &n);
+        batch_push_rows(L, cols, columns, n, nrows + 1);
+        nrows += n;
+        if (result == SQLITE4_BATCHFULL || (result == SQLITE4_ROW && nrows < k)) {
+            /* a row did not fit into the text/blob buffers */
+            if (!batch_grow(cols, columns)) {
+                luaL_error(L, "out of memory");
+            }
+            result = SQLITE4_ROW;
+        }
+        else break;
+    }
+
+    if (result != SQLITE4_ROW && result != SQLITE4_DONE) {
+        lua_pushstring(L, sqlite4_errmsg(svm->db->db));
+        lua_error(L);
+    }
+    return 1;
+}
+
 /*
 ** =======================================================
 ** Virtual Machine - Bind
@@ -2586,6 +2740,8 @@ static const luaL_Reg vmlib[] = {
     {"get_named_values",    dbvm_get_named_values   },
     {"get_named_types",     dbvm_get_named_types    },
 
+    {"fetch_batch",         dbvm_fetch_batch        },
+
     {"rows",                dbvm_rows               },
     {"urows",               dbvm_urows              },
     {"nrows",               dbvm_nrows              },
@@ -85,6 +85,26 @@ print(string.format("\n\n\ninserted rows: %d\n", num_rows))
 print(string.format("elapsed time: %.2f [s]\n", elapsed_time)) 
 print(string.format("performance: %f [rows/s]\n", performance)) 
 
+print("----------> scanning table with fetch_batch() <----------");
+local batch_size = 1000;
+local scanned_rows = 0;
+
+start_time = os.clock()
+
+repeat
+   local rows = select_stmt:fetch_batch(batch_size)
+   scanned_rows = scanned_rows + #rows
+until #rows < batch_size
+select_stmt:reset()
+
+end_time = os.clock()
+elapsed_time = end_time - start_time;
+performance = scanned_rows / elapsed_time;
+
+print(string.format("\n\n\nscanned rows: %d\n", scanned_rows)) 
+print(string.format("elapsed time: %.2f [s]\n", elapsed_time)) 
+print(string.format("performance: %f [rows/s]\n", performance)) 
+
 
 
 
@@ -11,19 +11,20 @@
 ** is substantially reduced.  This is important for embedded applications
 ** on platforms with limited memory.
 */
-/* Hash score: 166 */
+/* Hash score: 170 */
 static int keywordCode(const char *z, int n){
-  /* zText[] encodes 805 bytes of keywords in 535 bytes */
+  /* zText[] encodes 813 bytes of keywords in 542 bytes */
   /*   REINDEXEDESCAPEACHECKEYBEFOREIGNOREGEXPLAINSTEADDATABASELECT       */
   /*   ABLEFTHENDEFERRABLELSEXCEPTRANSACTIONATURALTERAISEXCLUSIVE         */
   /*   XISTSAVEPOINTERSECTRIGGEREFERENCESCONSTRAINTOFFSETEMPORARY         */
   /*   UNIQUERYATTACHAVINGROUPDATEBEGINNERELEASEBETWEENOTNULLIKE          */
   /*   CASCADELETECASECOLLATECREATECURRENT_DATEDETACHIMMEDIATEJOIN        */
-  /*   SERTMATCHPLANALYZEPRAGMABORTVALUESWHENWHERENAMEAFTEREPLACEAND      */
-  /*   EFAULTAUTOINCREMENTCASTCOLUMNCOMMITCONFLICTCOVERINGLOBYCROSS       */
-  /*   CURRENT_TIMESTAMPRIMARYDEFERREDISTINCTDROPFAILIMITFROMFULLIF       */
-  /*   ISNULLORDERESTRICTOUTERIGHTROLLBACKROWUNIONUSINGVIEWINITIALLY      */
-  static const char zText[534] = {
+  /*   SERTMATCHPLANALYZEPRAGMABORTPROFILEVALUESWHENWHERENAMEAFTER        */
+  /*   EPLACEANDEFAULTAUTOINCREMENTCASTCOLUMNCOMMITCONFLICTCOVERING       */
+  /*   LOBYCROSSCURRENT_TIMESTAMPRIMARYDEFERREDISTINCTDROPFAILIMIT        */
+  /*   FROMFULLIFISNULLORDERESTRICTOUTERIGHTROLLBACKROWUNIONUSINGVIEW     */
+  /*   INITIALLY                                                          */
+  static const char zText[541] = {
     'R','E','I','N','D','E','X','E','D','E','S','C','A','P','E','A','C','H',
     'E','C','K','E','Y','B','E','F','O','R','E','I','G','N','O','R','E','G',
     'E','X','P','L','A','I','N','S','T','E','A','D','D','A','T','A','B','A',
@@ -41,69 +42,70 @@ static int keywordCode(const char *z, int n){
     'A','T','E','C','R','E','A','T','E','C','U','R','R','E','N','T','_','D',
     'A','T','E','D','E','T','A','C','H','I','M','M','E','D','I','A','T','E',
     'J','O','I','N','S','E','R','T','M','A','T','C','H','P','L','A','N','A',
-    'L','Y','Z','E','P','R','A','G','M','A','B','O','R','T','V','A','L','U',
-    'E','S','W','H','E','N','W','H','E','R','E','N','A','M','E','A','F','T',
-    'E','R','E','P','L','A','C','E','A','N','D','E','F','A','U','L','T','A',
-    'U','T','O','I','N','C','R','E','M','E','N','T','C','A','S','T','C','O',
-    'L','U','M','N','C','O','M','M','I','T','C','O','N','F','L','I','C','T',
-    'C','O','V','E','R','I','N','G','L','O','B','Y','C','R','O','S','S','C',
-    'U','R','R','E','N','T','_','T','I','M','E','S','T','A','M','P','R','I',
-    'M','A','R','Y','D','E','F','E','R','R','E','D','I','S','T','I','N','C',
-    'T','D','R','O','P','F','A','I','L','I','M','I','T','F','R','O','M','F',
-    'U','L','L','I','F','I','S','N','U','L','L','O','R','D','E','R','E','S',
-    'T','R','I','C','T','O','U','T','E','R','I','G','H','T','R','O','L','L',
-    'B','A','C','K','R','O','W','U','N','I','O','N','U','S','I','N','G','V',
-    'I','E','W','I','N','I','T','I','A','L','L','Y',
+    'L','Y','Z','E','P','R','A','G','M','A','B','O','R','T','P','R','O','F',
+    'I','L','E','V','A','L','U','E','S','W','H','E','N','W','H','E','R','E',
+    'N','A','M','E','A','F','T','E','R','E','P','L','A','C','E','A','N','D',
+    'E','F','A','U','L','T','A','U','T','O','I','N','C','R','E','M','E','N',
+    'T','C','A','S','T','C','O','L','U','M','N','C','O','M','M','I','T','C',
+    'O','N','F','L','I','C','T','C','O','V','E','R','I','N','G','L','O','B',
+    'Y','C','R','O','S','S','C','U','R','R','E','N','T','_','T','I','M','E',
+    'S','T','A','M','P','R','I','M','A','R','Y','D','E','F','E','R','R','E',
+    'D','I','S','T','I','N','C','T','D','R','O','P','F','A','I','L','I','M',
+    'I','T','F','R','O','M','F','U','L','L','I','F','I','S','N','U','L','L',
+    'O','R','D','E','R','E','S','T','R','I','C','T','O','U','T','E','R','I',
+    'G','H','T','R','O','L','L','B','A','C','K','R','O','W','U','N','I','O',
+    'N','U','S','I','N','G','V','I','E','W','I','N','I','T','I','A','L','L',
+    'Y',
   };
   static const unsigned char aHash[127] = {
-      72, 102, 114,  70,   0,  45,   0,   0,  78,   0,  73,   0,   0,
-      42,  12,  74,  15,   0, 113,  79,  50, 108,   0,  19,   0,   0,
-      35,   0, 116, 111,   0,  22,  87,   0,   9,   0,   0,  66,  67,
-       0,  65,   6,   0,  48,  84,  99,   0, 115,  98,   0,  93,  44,
-       0, 100,  24,   0,  17,   0, 118,  49,  23,   0,   5,  94,  25,
-      90,   0,   0, 120, 103,  56, 119,  53,  28,  51,   0,  85,   0,
-      97,  26,   0,  96,   0,   0,   0,  89,  86,  91,  82, 107,  14,
-      39, 106,   0,  77,   0,  18,  83,  95,  32,   0, 117,  76, 109,
-      58,  46, 105,   0,   0,  88,  40,   0, 112,   0,  36,   0,   0,
-      29,   0,  80,  59,  60,   0,  20,  57,   0,  52,
+      71, 103, 115,  69,   0,  44,   0,   0,  79,   0,  72,   0,   0,
+      78,  12,  73,  15,   0, 114,  80,  49, 109,   0,  19,   0,   0,
+      35,   0, 117, 112,   0,  22,  88,   0,   9,   0,   0,  65,  66,
+       0,  64,   6,   0,  47,  85, 100,   0, 116,  99,   0,  94,  43,
+       0, 101,  24,   0,  17,   0, 119,  48,  23,   0,   5,  95,  25,
+      91,   0,   0, 121, 104,  55, 120,  52,  28,  50,   0,  86,   0,
+      98,  26,   0,  97,   0,   0,   0,  90,  87,  92,  83, 108,  14,
+      39, 107,   0,  76,   0,  18,  84,  96,  32,   0, 118,  75, 110,
+      57,  77, 106,   0,   0,  89,  40,   0, 113,   0,  36,   0,   0,
+      29,   0,  81,  58,  59,   0,  20,  56,   0,  51,
   };
-  static const unsigned char aNext[120] = {
+  static const unsigned char aNext[121] = {
        0,   0,   0,   0,   4,   0,   0,   0,   0,   0,   0,   0,   0,
        0,   2,   0,   0,   0,   0,   0,   0,  13,   0,   0,   0,   0,
        0,   7,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-       0,   0,   0,   0,  33,   0,  21,   0,   0,   0,  43,   3,  47,
-       0,   0,   0,   0,  30,   0,  54,   0,  38,   0,   0,   0,   1,
-      62,   0,   0,  63,   0,  41,   0,   0,   0,   0,   0,   0,   0,
-       0,   0,   0,  31,  55,  16,  34,  10,   0,   0,   0,   0,   0,
-       0,   0,   0,  81,   0,  11,  68,  75,   0,   8,   0, 101,  92,
-       0,   0, 104,   0,  71,   0,   0, 110,  27,  37,  69,  61,   0,
-      64,   0,   0,
+       0,   0,   0,  33,   0,  21,   0,   0,   0,  42,   3,  46,   0,
+       0,   0,   0,  30,   0,  53,   0,  38,   0,   0,   0,   1,  61,
+       0,   0,  62,   0,  41,   0,   0,   0,   0,   0,   0,  45,   0,
+       0,   0,   0,   0,  31,  54,  16,  34,  10,   0,   0,   0,   0,
+       0,   0,   0,   0,  82,   0,  11,  67,  74,   0,   8,   0, 102,
+      93,   0,   0, 105,   0,  70,   0,   0, 111,  27,  37,  68,  60,
+       0,  63,   0,   0,
   };
-  static const unsigned char aLen[120] = {
+  static const unsigned char aLen[121] = {
        7,   7,   5,   4,   6,   4,   5,   3,   6,   7,   3,   6,   6,
        7,   7,   3,   8,   2,   6,   5,   4,   4,   3,  10,   4,   6,
       11,   6,   2,   7,   5,   5,   9,   6,   9,   9,   7,  10,  10,
-       4,   6,   2,   3,   9,   4,   2,   6,   5,   6,   6,   5,   6,
-       5,   5,   7,   7,   7,   3,   2,   4,   4,   7,   3,   6,   4,
-       7,   6,  12,   6,   9,   4,   6,   5,   4,   7,   6,   5,   6,
-       4,   5,   6,   5,   7,   3,   7,  13,   2,   2,   4,   6,   6,
-       8,   8,   4,   2,   5,  17,  12,   7,   8,   8,   2,   4,   4,
-       5,   4,   4,   2,   6,   5,   8,   5,   5,   8,   3,   5,   5,
-       4,   9,   3,
+       4,   6,   3,   9,   4,   2,   6,   5,   6,   6,   5,   6,   5,
+       5,   7,   7,   7,   3,   2,   4,   4,   7,   3,   6,   4,   7,
+       6,  12,   6,   9,   4,   6,   5,   4,   7,   6,   5,   7,   2,
+       6,   4,   5,   6,   5,   7,   3,   7,  13,   2,   2,   4,   6,
+       6,   8,   8,   4,   2,   5,  17,  12,   7,   8,   8,   2,   4,
+       4,   5,   4,   4,   2,   6,   5,   8,   5,   5,   8,   3,   5,
+       5,   4,   9,   3,
   };
-  static const unsigned short int aOffset[120] = {
+  static const unsigned short int aOffset[121] = {
        0,   2,   2,   8,   9,  14,  16,  20,  23,  25,  25,  29,  33,
       36,  41,  46,  48,  53,  54,  59,  62,  65,  67,  69,  78,  81,
       86,  91,  95,  96, 101, 105, 109, 117, 122, 128, 136, 142, 152,
-     159, 162, 162, 165, 167, 167, 171, 176, 179, 184, 189, 194, 197,
-     203, 206, 210, 217, 223, 223, 223, 226, 229, 233, 234, 238, 244,
-     248, 255, 261, 273, 279, 288, 290, 296, 301, 303, 310, 315, 320,
-     326, 330, 333, 339, 343, 350, 352, 359, 361, 363, 372, 376, 382,
-     388, 396, 403, 406, 408, 413, 413, 429, 436, 443, 444, 451, 455,
-     458, 463, 467, 471, 473, 479, 483, 491, 495, 500, 508, 511, 516,
-     521, 525, 530,
+     159, 162, 165, 167, 167, 171, 176, 179, 184, 189, 194, 197, 203,
+     206, 210, 217, 223, 223, 223, 226, 229, 233, 234, 238, 244, 248,
+     255, 261, 273, 279, 288, 290, 296, 301, 303, 310, 315, 320, 322,
+     327, 333, 337, 340, 346, 350, 357, 359, 366, 368, 370, 379, 383,
+     389, 395, 403, 410, 413, 415, 420, 420, 436, 443, 450, 451, 458,
+     462, 465, 470, 474, 478, 480, 486, 490, 498, 502, 507, 515, 518,
+     523, 528, 532, 537,
   };
-  static const unsigned char aCode[120] = {
+  static const unsigned char aCode[121] = {
     TK_REINDEX,    TK_INDEXED,    TK_INDEX,      TK_DESC,       TK_ESCAPE,     
     TK_EACH,       TK_CHECK,      TK_KEY,        TK_BEFORE,     TK_FOREIGN,    
     TK_FOR,        TK_IGNORE,     TK_LIKE_KW,    TK_EXPLAIN,    TK_INSTEAD,    
@@ -112,22 +114,23 @@ static int keywordCode(const char *z, int n){
     TK_EXCEPT,     TK_TRANSACTION,TK_ACTION,     TK_ON,         TK_JOIN_KW,    
     TK_ALTER,      TK_RAISE,      TK_EXCLUSIVE,  TK_EXISTS,     TK_SAVEPOINT,  
     TK_INTERSECT,  TK_TRIGGER,    TK_REFERENCES, TK_CONSTRAINT, TK_INTO,       
-    TK_OFFSET,     TK_OF,         TK_SET,        TK_TEMP,       TK_TEMP,       
-    TK_OR,         TK_UNIQUE,     TK_QUERY,      TK_ATTACH,     TK_HAVING,     
-    TK_GROUP,      TK_UPDATE,     TK_BEGIN,      TK_JOIN_KW,    TK_RELEASE,    
-    TK_BETWEEN,    TK_NOTNULL,    TK_NOT,        TK_NO,         TK_NULL,       
-    TK_LIKE_KW,    TK_CASCADE,    TK_ASC,        TK_DELETE,     TK_CASE,       
-    TK_COLLATE,    TK_CREATE,     TK_CTIME_KW,   TK_DETACH,     TK_IMMEDIATE,  
-    TK_JOIN,       TK_INSERT,     TK_MATCH,      TK_PLAN,       TK_ANALYZE,    
-    TK_PRAGMA,     TK_ABORT,      TK_VALUES,     TK_WHEN,       TK_WHERE,      
-    TK_RENAME,     TK_AFTER,      TK_REPLACE,    TK_AND,        TK_DEFAULT,    
-    TK_AUTOINCR,   TK_TO,         TK_IN,         TK_CAST,       TK_COLUMNKW,   
-    TK_COMMIT,     TK_CONFLICT,   TK_COVERING,   TK_LIKE_KW,    TK_BY,         
-    TK_JOIN_KW,    TK_CTIME_KW,   TK_CTIME_KW,   TK_PRIMARY,    TK_DEFERRED,   
-    TK_DISTINCT,   TK_IS,         TK_DROP,       TK_FAIL,       TK_LIMIT,      
-    TK_FROM,       TK_JOIN_KW,    TK_IF,         TK_ISNULL,     TK_ORDER,      
-    TK_RESTRICT,   TK_JOIN_KW,    TK_JOIN_KW,    TK_ROLLBACK,   TK_ROW,        
-    TK_UNION,      TK_USING,      TK_VIEW,       TK_INITIALLY,  TK_ALL,        
+    TK_OFFSET,     TK_SET,        TK_TEMP,       TK_TEMP,       TK_OR,         
+    TK_UNIQUE,     TK_QUERY,      TK_ATTACH,     TK_HAVING,     TK_GROUP,      
+    TK_UPDATE,     TK_BEGIN,      TK_JOIN_KW,    TK_RELEASE,    TK_BETWEEN,    
+    TK_NOTNULL,    TK_NOT,        TK_NO,         TK_NULL,       TK_LIKE_KW,    
+    TK_CASCADE,    TK_ASC,        TK_DELETE,     TK_CASE,       TK_COLLATE,    
+    TK_CREATE,     TK_CTIME_KW,   TK_DETACH,     TK_IMMEDIATE,  TK_JOIN,       
+    TK_INSERT,     TK_MATCH,      TK_PLAN,       TK_ANALYZE,    TK_PRAGMA,     
+    TK_ABORT,      TK_PROFILE,    TK_OF,         TK_VALUES,     TK_WHEN,       
+    TK_WHERE,      TK_RENAME,     TK_AFTER,      TK_REPLACE,    TK_AND,        
+    TK_DEFAULT,    TK_AUTOINCR,   TK_TO,         TK_IN,         TK_CAST,       
+    TK_COLUMNKW,   TK_COMMIT,     TK_CONFLICT,   TK_COVERING,   TK_LIKE_KW,    
+    TK_BY,         TK_JOIN_KW,    TK_CTIME_KW,   TK_CTIME_KW,   TK_PRIMARY,    
+    TK_DEFERRED,   TK_DISTINCT,   TK_IS,         TK_DROP,       TK_FAIL,       
+    TK_LIMIT,      TK_FROM,       TK_JOIN_KW,    TK_IF,         TK_ISNULL,     
+    TK_ORDER,      TK_RESTRICT,   TK_JOIN_KW,    TK_JOIN_KW,    TK_ROLLBACK,   
+    TK_ROW,        TK_UNION,      TK_USING,      TK_VIEW,       TK_INITIALLY,  
+    TK_ALL,        
   };
   int h, i;
   if( n<2 ) return TK_ID;
@@ -177,85 +180,86 @@ static int keywordCode(const char *z, int n){
       testcase( i==38 ); /* CONSTRAINT */
       testcase( i==39 ); /* INTO */
       testcase( i==40 ); /* OFFSET */
-      testcase( i==41 ); /* OF */
-      testcase( i==42 ); /* SET */
-      testcase( i==43 ); /* TEMPORARY */
-      testcase( i==44 ); /* TEMP */
-      testcase( i==45 ); /* OR */
-      testcase( i==46 ); /* UNIQUE */
-      testcase( i==47 ); /* QUERY */
-      testcase( i==48 ); /* ATTACH */
-      testcase( i==49 ); /* HAVING */
-      testcase( i==50 ); /* GROUP */
-      testcase( i==51 ); /* UPDATE */
-      testcase( i==52 ); /* BEGIN */
-      testcase( i==53 ); /* INNER */
-      testcase( i==54 ); /* RELEASE */
-      testcase( i==55 ); /* BETWEEN */
-      testcase( i==56 ); /* NOTNULL */
-      testcase( i==57 ); /* NOT */
-      testcase( i==58 ); /* NO */
-      testcase( i==59 ); /* NULL */
-      testcase( i==60 ); /* LIKE */
-      testcase( i==61 ); /* CASCADE */
-      testcase( i==62 ); /* ASC */
-      testcase( i==63 ); /* DELETE */
-      testcase( i==64 ); /* CASE */
-      testcase( i==65 ); /* COLLATE */
-      testcase( i==66 ); /* CREATE */
-      testcase( i==67 ); /* CURRENT_DATE */
-      testcase( i==68 ); /* DETACH */
-      testcase( i==69 ); /* IMMEDIATE */
-      testcase( i==70 ); /* JOIN */
-      testcase( i==71 ); /* INSERT */
-      testcase( i==72 ); /* MATCH */
-      testcase( i==73 ); /* PLAN */
-      testcase( i==74 ); /* ANALYZE */
-      testcase( i==75 ); /* PRAGMA */
-      testcase( i==76 ); /* ABORT */
-      testcase( i==77 ); /* VALUES */
-      testcase( i==78 ); /* WHEN */
-      testcase( i==79 ); /* WHERE */
-      testcase( i==80 ); /* RENAME */
-      testcase( i==81 ); /* AFTER */
-      testcase( i==82 ); /* REPLACE */
-      testcase( i==83 ); /* AND */
-      testcase( i==84 ); /* DEFAULT */
-      testcase( i==85 ); /* AUTOINCREMENT */
-      testcase( i==86 ); /* TO */
-      testcase( i==87 ); /* IN */
-      testcase( i==88 ); /* CAST */
-      testcase( i==89 ); /* COLUMN */
-      testcase( i==90 ); /* COMMIT */
-      testcase( i==91 ); /* CONFLICT */
-      testcase( i==92 ); /* COVERING */
-      testcase( i==93 ); /* GLOB */
-      testcase( i==94 ); /* BY */
-      testcase( i==95 ); /* CROSS */
-      testcase( i==96 ); /* CURRENT_TIMESTAMP */
-      testcase( i==97 ); /* CURRENT_TIME */
-      testcase( i==98 ); /* PRIMARY */
-      testcase( i==99 ); /* DEFERRED */
-      testcase( i==100 ); /* DISTINCT */
-      testcase( i==101 ); /* IS */
-      testcase( i==102 ); /* DROP */
-      testcase( i==103 ); /* FAIL */
-      testcase( i==104 ); /* LIMIT */
-      testcase( i==105 ); /* FROM */
-      testcase( i==106 ); /* FULL */
-      testcase( i==107 ); /* IF */
-      testcase( i==108 ); /* ISNULL */
-      testcase( i==109 ); /* ORDER */
-      testcase( i==110 ); /* RESTRICT */
-      testcase( i==111 ); /* OUTER */
-      testcase( i==112 ); /* RIGHT */
-      testcase( i==113 ); /* ROLLBACK */
-      testcase( i==114 ); /* ROW */
-      testcase( i==115 ); /* UNION */
-      testcase( i==116 ); /* USING */
-      testcase( i==117 ); /* VIEW */
-      testcase( i==118 ); /* INITIALLY */
-      testcase( i==119 ); /* ALL */
+      testcase( i==41 ); /* SET */
+      testcase( i==42 ); /* TEMPORARY */
+      testcase( i==43 ); /* TEMP */
+      testcase( i==44 ); /* OR */
+      testcase( i==45 ); /* UNIQUE */
+      testcase( i==46 ); /* QUERY */
+      testcase( i==47 ); /* ATTACH */
+      testcase( i==48 ); /* HAVING */
+      testcase( i==49 ); /* GROUP */
+      testcase( i==50 ); /* UPDATE */
+      testcase( i==51 ); /* BEGIN */
+      testcase( i==52 ); /* INNER */
+      testcase( i==53 ); /* RELEASE */
+      testcase( i==54 ); /* BETWEEN */
+      testcase( i==55 ); /* NOTNULL */
+      testcase( i==56 ); /* NOT */
+      testcase( i==57 ); /* NO */
+      testcase( i==58 ); /* NULL */
+      testcase( i==59 ); /* LIKE */
+      testcase( i==60 ); /* CASCADE */
+      testcase( i==61 ); /* ASC */
+      testcase( i==62 ); /* DELETE */
+      testcase( i==63 ); /* CASE */
+      testcase( i==64 ); /* COLLATE */
+      testcase( i==65 ); /* CREATE */
+      testcase( i==66 ); /* CURRENT_DATE */
+      testcase( i==67 ); /* DETACH */
+      testcase( i==68 ); /* IMMEDIATE */
+      testcase( i==69 ); /* JOIN */
+      testcase( i==70 ); /* INSERT */
+      testcase( i==71 ); /* MATCH */
+      testcase( i==72 ); /* PLAN */
+      testcase( i==73 ); /* ANALYZE */
+      testcase( i==74 ); /* PRAGMA */
+      testcase( i==75 ); /* ABORT */
+      testcase( i==76 ); /* PROFILE */
+      testcase( i==77 ); /* OF */
+      testcase( i==78 ); /* VALUES */
+      testcase( i==79 ); /* WHEN */
+      testcase( i==80 ); /* WHERE */
+      testcase( i==81 ); /* RENAME */
+      testcase( i==82 ); /* AFTER */
+      testcase( i==83 ); /* REPLACE */
+      testcase( i==84 ); /* AND */
+      testcase( i==85 ); /* DEFAULT */
+      testcase( i==86 ); /* AUTOINCREMENT */
+      testcase( i==87 ); /* TO */
+      testcase( i==88 ); /* IN */
+      testcase( i==89 ); /* CAST */
+      testcase( i==90 ); /* COLUMN */
+      testcase( i==91 ); /* COMMIT */
+      testcase( i==92 ); /* CONFLICT */
+      testcase( i==93 ); /* COVERING */
+      testcase( i==94 ); /* GLOB */
+      testcase( i==95 ); /* BY */
+      testcase( i==96 ); /* CROSS */
+      testcase( i==97 ); /* CURRENT_TIMESTAMP */
+      testcase( i==98 ); /* CURRENT_TIME */
+      testcase( i==99 ); /* PRIMARY */
+      testcase( i==100 ); /* DEFERRED */
+      testcase( i==101 ); /* DISTINCT */
+      testcase( i==102 ); /* IS */
+      testcase( i==103 ); /* DROP */
+      testcase( i==104 ); /* FAIL */
+      testcase( i==105 ); /* LIMIT */
+      testcase( i==106 ); /* FROM */
+      testcase( i==107 ); /* FULL */
+      testcase( i==108 ); /* IF */
+      testcase( i==109 ); /* ISNULL */
+      testcase( i==110 ); /* ORDER */
+      testcase( i==111 ); /* RESTRICT */
+      testcase( i==112 ); /* OUTER */
+      testcase( i==113 ); /* RIGHT */
+      testcase( i==114 ); /* ROLLBACK */
+      testcase( i==115 ); /* ROW */
+      testcase( i==116 ); /* UNION */
+      testcase( i==117 ); /* USING */
+      testcase( i==118 ); /* VIEW */
+      testcase( i==119 ); /* INITIALLY */
+      testcase( i==120 ); /* ALL */
       return aCode[i];
     }
   }
@@ -264,4 +268,4 @@ static int keywordCode(const char *z, int n){
 int sqlite4KeywordCode(const unsigned char *z, int n){
   return keywordCode((char*)z, n);
 }
-#define SQLITE4_N_KEYWORD 120
+#define SQLITE4_N_KEYWORD 121
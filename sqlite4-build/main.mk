@@ -67,21 +67,22 @@ TCPPX = g++ -Wall -g -I. -I$(TOP)/src $(OPTS)
 
 
 LIBOBJ+= vdbe.o parse.o \
-         alter.o analyze.o attach.o auth.o \
-         build.o \
+         alter.o analyze.o async.o attach.o auth.o \
+         build.o bulkload.o \
          callback.o complete.o ctime.o date.o delete.o env.o expr.o \
          fault.o fkey.o fts5.o fts5func.o \
          func.o global.o hash.o \
-         icu.o insert.o kv.o kvmem.o legacy.o \
-         main.o malloc.o math.o mem.o mem0.o mem2.o mem3.o mem5.o \
-         mutex.o mutex_noop.o mutex_unix.o mutex_w32.o \
+         icu.o insert.o kv.o kvmap.o kvmem.o kvmemlog.o legacy.o \
+         main.o malloc.o math.o \
+         mem.o mem0.o mem2.o mem3.o mem5.o mem6.o \
+         mutex.o mutex_noop.o mutex_prof.o mutex_unix.o mutex_w32.o \
          opcodes.o os.o \
-         pragma.o prepare.o printf.o \
+         pool.o pragma.o prepare.o printf.o \
          random.o resolve.o rowset.o rtree.o select.o status.o \
-         tokenize.o trigger.o \
+         threads.o tokenize.o trigger.o \
          update.o util.o varint.o \
-         vdbeapi.o vdbeaux.o vdbecodec.o vdbecursor.o \
-         vdbemem.o vdbetrace.o \
+         vdbeagg.o vdbeapi.o vdbeaux.o vdbecodec.o vdbecursor.o \
+         vdbemem.o vdbesort.o vdbetrace.o \
          walker.o where.o utf.o
 
 # All of the source code files.
@@ -89,9 +90,11 @@ LIBOBJ+= vdbe.o parse.o \
 SRC = \
   $(TOP)/src/alter.c \
   $(TOP)/src/analyze.c \
+  $(TOP)/src/async.c \
   $(TOP)/src/attach.c \
   $(TOP)/src/auth.c \
   $(TOP)/src/build.c \
+  $(TOP)/src/bulkload.c \
   $(TOP)/src/callback.c \
   $(TOP)/src/complete.c \
   $(TOP)/src/ctime.c \
@@ -111,7 +114,9 @@ SRC = \
   $(TOP)/src/insert.c \
   $(TOP)/src/kv.c \
   $(TOP)/src/kv.h \
+  $(TOP)/src/kvmap.c \
   $(TOP)/src/kvmem.c \
+  $(TOP)/src/kvmemlog.c \
   $(TOP)/src/legacy.c \
   $(TOP)/src/main.c \
   $(TOP)/src/malloc.c \
@@ -121,14 +126,17 @@ SRC = \
   $(TOP)/src/mem2.c \
   $(TOP)/src/mem3.c \
   $(TOP)/src/mem5.c \
+  $(TOP)/src/mem6.c \
   $(TOP)/src/mutex.c \
   $(TOP)/src/mutex.h \
   $(TOP)/src/mutex_noop.c \
+  $(TOP)/src/mutex_prof.c \
   $(TOP)/src/mutex_unix.c \
   $(TOP)/src/mutex_w32.c \
   $(TOP)/src/os.c \
   $(TOP)/src/os.h \
   $(TOP)/src/parse.y \
+  $(TOP)/src/pool.c \
   $(TOP)/src/pragma.c \
   $(TOP)/src/prepare.c \
   $(TOP)/src/printf.c \
@@ -142,6 +150,7 @@ SRC = \
   $(TOP)/src/sqliteLimit.h \
   $(TOP)/src/status.c \
   $(TOP)/src/tclsqlite.c \
+  $(TOP)/src/threads.c \
   $(TOP)/src/tokenize.c \
   $(TOP)/src/trigger.c \
   $(TOP)/src/utf.c \
@@ -150,11 +159,13 @@ SRC = \
   $(TOP)/src/varint.c \
   $(TOP)/src/vdbe.c \
   $(TOP)/src/vdbe.h \
+  $(TOP)/src/vdbeagg.c \
   $(TOP)/src/vdbeapi.c \
   $(TOP)/src/vdbeaux.c \
   $(TOP)/src/vdbecodec.c \
   $(TOP)/src/vdbecursor.c \
   $(TOP)/src/vdbemem.c \
+  $(TOP)/src/vdbesort.c \
   $(TOP)/src/vdbetrace.c \
   $(TOP)/src/vdbeInt.h \
   $(TOP)/src/walker.c \
@@ -21,9 +21,9 @@ const char *sqlite4OpcodeName(int i){
      /*  16 */ "ResultRow",
      /*  17 */ "CollSeq",
      /*  18 */ "KVMethod",
-     /*  19 */ "Not",
-     /*  20 */ "Mifunction",
-     /*  21 */ "Function",
+     /*  19 */ "Mifunction",
+     /*  20 */ "Function",
+     /*  21 */ "Not",
      /*  22 */ "AddImm",
      /*  23 */ "MustBeInt",
      /*  24 */ "RealAffinity",
@@ -54,101 +54,107 @@ const char *sqlite4OpcodeName(int i){
      /*  49 */ "SeekLe",
      /*  50 */ "SeekGe",
      /*  51 */ "SeekGt",
-     /*  52 */ "NotExists",
-     /*  53 */ "NotFound",
-     /*  54 */ "Found",
-     /*  55 */ "IsUnique",
-     /*  56 */ "Sequence",
-     /*  57 */ "NewRowid",
-     /*  58 */ "NewIdxid",
-     /*  59 */ "Delete",
-     /*  60 */ "ResetCount",
-     /*  61 */ "GrpCompare",
-     /*  62 */ "SorterData",
-     /*  63 */ "RowKey",
-     /*  64 */ "RowData",
-     /*  65 */ "AnalyzeKey",
-     /*  66 */ "Rowid",
-     /*  67 */ "Or",
-     /*  68 */ "And",
-     /*  69 */ "NullRow",
-     /*  70 */ "Last",
-     /*  71 */ "SorterSort",
-     /*  72 */ "IsNull",
-     /*  73 */ "NotNull",
-     /*  74 */ "Ne",
-     /*  75 */ "Eq",
-     /*  76 */ "Gt",
-     /*  77 */ "Le",
-     /*  78 */ "Lt",
-     /*  79 */ "Ge",
-     /*  80 */ "Sort",
-     /*  81 */ "BitAnd",
-     /*  82 */ "BitOr",
-     /*  83 */ "ShiftLeft",
-     /*  84 */ "ShiftRight",
-     /*  85 */ "Add",
-     /*  86 */ "Subtract",
-     /*  87 */ "Multiply",
-     /*  88 */ "Divide",
-     /*  89 */ "Remainder",
-     /*  90 */ "Concat",
-     /*  91 */ "Rewind",
-     /*  92 */ "BitNot",
-     /*  93 */ "String8",
-     /*  94 */ "SorterNext",
-     /*  95 */ "Prev",
-     /*  96 */ "Next",
-     /*  97 */ "Insert",
-     /*  98 */ "IdxDelete",
-     /*  99 */ "IdxRowkey",
-     /* 100 */ "IdxLT",
-     /* 101 */ "IdxLE",
-     /* 102 */ "IdxGE",
-     /* 103 */ "IdxGT",
-     /* 104 */ "Clear",
-     /* 105 */ "ParseSchema",
-     /* 106 */ "LoadAnalysis",
-     /* 107 */ "DropTable",
-     /* 108 */ "DropIndex",
-     /* 109 */ "DropTrigger",
-     /* 110 */ "RowSetTest",
-     /* 111 */ "RowSetAdd",
-     /* 112 */ "RowSetRead",
-     /* 113 */ "Program",
-     /* 114 */ "Param",
-     /* 115 */ "FkCounter",
-     /* 116 */ "FkIfZero",
-     /* 117 */ "MemMax",
-     /* 118 */ "IfPos",
-     /* 119 */ "IfNeg",
-     /* 120 */ "IfZero",
-     /* 121 */ "AggStep",
-     /* 122 */ "AggFinal",
-     /* 123 */ "JournalMode",
-     /* 124 */ "Expire",
-     /* 125 */ "VBegin",
-     /* 126 */ "VCreate",
-     /* 127 */ "VDestroy",
-     /* 128 */ "VOpen",
-     /* 129 */ "VFilter",
-     /* 130 */ "VColumn",
-     /* 131 */ "VNext",
-     /* 132 */ "VRename",
-     /* 133 */ "VUpdate",
-     /* 134 */ "Trace",
-     /* 135 */ "FtsUpdate",
-     /* 136 */ "FtsCksum",
-     /* 137 */ "FtsOpen",
-     /* 138 */ "FtsNext",
-     /* 139 */ "FtsPk",
-     /* 140 */ "Noop",
-     /* 141 */ "ToText",
-     /* 142 */ "ToBlob",
-     /* 143 */ "ToNumeric",
-     /* 144 */ "ToInt",
-     /* 145 */ "ToReal",
-     /* 146 */ "Explain",
+     /*  52 */ "SeekBatch",
+     /*  53 */ "SeekBatchAdd",
+     /*  54 */ "SeekBatchNext",
+     /*  55 */ "NotExists",
+     /*  56 */ "NotFound",
+     /*  57 */ "Found",
+     /*  58 */ "IsUnique",
+     /*  59 */ "Sequence",
+     /*  60 */ "NewRowid",
+     /*  61 */ "NewIdxid",
+     /*  62 */ "Delete",
+     /*  63 */ "ResetCount",
+     /*  64 */ "GrpCompare",
+     /*  65 */ "SorterData",
+     /*  66 */ "RowKey",
+     /*  67 */ "RowData",
+     /*  68 */ "Or",
+     /*  69 */ "And",
+     /*  70 */ "AnalyzeKey",
+     /*  71 */ "Rowid",
+     /*  72 */ "NullRow",
+     /*  73 */ "IsNull",
+     /*  74 */ "NotNull",
+     /*  75 */ "Ne",
+     /*  76 */ "Eq",
+     /*  77 */ "Gt",
+     /*  78 */ "Le",
+     /*  79 */ "Lt",
+     /*  80 */ "Ge",
+     /*  81 */ "Last",
+     /*  82 */ "BitAnd",
+     /*  83 */ "BitOr",
+     /*  84 */ "ShiftLeft",
+     /*  85 */ "ShiftRight",
+     /*  86 */ "Add",
+     /*  87 */ "Subtract",
+     /*  88 */ "Multiply",
+     /*  89 */ "Divide",
+     /*  90 */ "Remainder",
+     /*  91 */ "Concat",
+     /*  92 */ "SorterSort",
+     /*  93 */ "BitNot",
+     /*  94 */ "String8",
+     /*  95 */ "Sort",
+     /*  96 */ "Rewind",
+     /*  97 */ "SorterNext",
+     /*  98 */ "Prev",
+     /*  99 */ "Next",
+     /* 100 */ "Insert",
+     /* 101 */ "SorterInsert",
+     /* 102 */ "SorterWrite",
+     /* 103 */ "IdxDelete",
+     /* 104 */ "IdxRowkey",
+     /* 105 */ "IdxLT",
+     /* 106 */ "IdxLE",
+     /* 107 */ "IdxGE",
+     /* 108 */ "IdxGT",
+     /* 109 */ "Clear",
+     /* 110 */ "ParseSchema",
+     /* 111 */ "LoadAnalysis",
+     /* 112 */ "DropTable",
+     /* 113 */ "DropIndex",
+     /* 114 */ "DropTrigger",
+     /* 115 */ "RowSetTest",
+     /* 116 */ "RowSetAdd",
+     /* 117 */ "RowSetRead",
+     /* 118 */ "Program",
+     /* 119 */ "Param",
+     /* 120 */ "FkCounter",
+     /* 121 */ "FkIfZero",
+     /* 122 */ "MemMax",
+     /* 123 */ "IfPos",
+     /* 124 */ "IfNeg",
+     /* 125 */ "IfZero",
+     /* 126 */ "AggStep",
+     /* 127 */ "AggFinal",
+     /* 128 */ "ParallelAgg",
+     /* 129 */ "JournalMode",
+     /* 130 */ "Expire",
+     /* 131 */ "VBegin",
+     /* 132 */ "VCreate",
+     /* 133 */ "VDestroy",
+     /* 134 */ "VOpen",
+     /* 135 */ "VFilter",
+     /* 136 */ "VColumn",
+     /* 137 */ "VNext",
+     /* 138 */ "VRename",
+     /* 139 */ "VUpdate",
+     /* 140 */ "Trace",
+     /* 141 */ "FtsUpdate",
+     /* 142 */ "ToText",
+     /* 143 */ "ToBlob",
+     /* 144 */ "ToNumeric",
+     /* 145 */ "ToInt",
+     /* 146 */ "ToReal",
+     /* 147 */ "FtsCksum",
+     /* 148 */ "FtsOpen",
+     /* 149 */ "FtsNext",
+     /* 150 */ "FtsPk",
+     /* 151 */ "Noop",
+     /* 152 */ "Explain",
   };
   return azName[i];
 }
@@ -8,7 +8,7 @@
 #define OP_Halt                                 6
 #define OP_Integer                              7
 #define OP_Num                                  8
-#define OP_String8                             93   /* same as TK_STRING   */
+#define OP_String8                             94   /* same as TK_STRING   */
 #define OP_String                               9
 #define OP_Null                                10
 #define OP_Blob                                11
@@ -17,46 +17,46 @@
 #define OP_Copy                                14
 #define OP_SCopy                               15
 #define OP_ResultRow                           16
-#define OP_Concat                              90   /* same as TK_CONCAT   */
-#define OP_Add                                 85   /* same as TK_PLUS     */
-#define OP_Subtract                            86   /* same as TK_MINUS    */
-#define OP_Multiply                            87   /* same as TK_STAR     */
-#define OP_Divide                              88   /* same as TK_SLASH    */
-#define OP_Remainder                           89   /* same as TK_REM      */
+#define OP_Concat                              91   /* same as TK_CONCAT   */
+#define OP_Add                                 86   /* same as TK_PLUS     */
+#define OP_Subtract                            87   /* same as TK_MINUS    */
+#define OP_Multiply                            88   /* same as TK_STAR     */
+#define OP_Divide                              89   /* same as TK_SLASH    */
+#define OP_Remainder                           90   /* same as TK_REM      */
 #define OP_CollSeq                             17
 #define OP_KVMethod                            18
-#define OP_Mifunction                          20
-#define OP_Function                            21
-#define OP_BitAnd                              81   /* same as TK_BITAND   */
-#define OP_BitOr                               82   /* same as TK_BITOR    */
-#define OP_ShiftLeft                           83   /* same as TK_LSHIFT   */
-#define OP_ShiftRight                          84   /* same as TK_RSHIFT   */
+#define OP_Mifunction                          19
+#define OP_Function                            20
+#define OP_BitAnd                              82   /* same as TK_BITAND   */
+#define OP_BitOr                               83   /* same as TK_BITOR    */
+#define OP_ShiftLeft                           84   /* same as TK_LSHIFT   */
+#define OP_ShiftRight                          85   /* same as TK_RSHIFT   */
 #define OP_AddImm                              22
 #define OP_MustBeInt                           23
 #define OP_RealAffinity                        24
-#define OP_ToText                             141   /* same as TK_TO_TEXT  */
-#define OP_ToBlob                             142   /* same as TK_TO_BLOB  */
-#define OP_ToNumeric                          143   /* same as TK_TO_NUMERIC*/
-#define OP_ToInt                              144   /* same as TK_TO_INT   */
-#define OP_ToReal                             145   /* same as TK_TO_REAL  */
-#define OP_Eq                                  75   /* same as TK_EQ       */
-#define OP_Ne                                  74   /* same as TK_NE       */
-#define OP_Lt                                  78   /* same as TK_LT       */
-#define OP_Le                                  77   /* same as TK_LE       */
-#define OP_Gt                                  76   /* same as TK_GT       */
-#define OP_Ge                                  79   /* same as TK_GE       */
+#define OP_ToText                             142   /* same as TK_TO_TEXT  */
+#define OP_ToBlob                             143   /* same as TK_TO_BLOB  */
+#define OP_ToNumeric                          144   /* same as TK_TO_NUMERIC*/
+#define OP_ToInt                              145   /* same as TK_TO_INT   */
+#define OP_ToReal                             146   /* same as TK_TO_REAL  */
+#define OP_Eq                                  76   /* same as TK_EQ       */
+#define OP_Ne                                  75   /* same as TK_NE       */
+#define OP_Lt                                  79   /* same as TK_LT       */
+#define OP_Le                                  78   /* same as TK_LE       */
+#define OP_Gt                                  77   /* same as TK_GT       */
+#define OP_Ge                                  80   /* same as TK_GE       */
 #define OP_Permutation                         25
 #define OP_Compare                             26
 #define OP_Jump                                27
-#define OP_And                                 68   /* same as TK_AND      */
-#define OP_Or                                  67   /* same as TK_OR       */
-#define OP_Not                                 19   /* same as TK_NOT      */
-#define OP_BitNot                              92   /* same as TK_BITNOT   */
+#define OP_And                                 69   /* same as TK_AND      */
+#define OP_Or                                  68   /* same as TK_OR       */
+#define OP_Not                                 21   /* same as TK_NOT      */
+#define OP_BitNot                              93   /* same as TK_BITNOT   */
 #define OP_Once                                28
 #define OP_If                                  29
 #define OP_IfNot                               30
-#define OP_IsNull                              72   /* same as TK_ISNULL   */
-#define OP_NotNull                             73   /* same as TK_NOTNULL  */
+#define OP_IsNull                              73   /* same as TK_ISNULL   */
+#define OP_NotNull                             74   /* same as TK_NOTNULL  */
 #define OP_Column                              31
 #define OP_MakeKey                             32
 #define OP_MakeRecord                          33
@@ -78,74 +78,80 @@
 #define OP_SeekLe                              49
 #define OP_SeekGe                              50
 #define OP_SeekGt                              51
-#define OP_NotExists                           52
-#define OP_NotFound                            53
-#define OP_Found                               54
-#define OP_IsUnique                            55
-#define OP_Sequence                            56
-#define OP_NewRowid                            57
-#define OP_NewIdxid                            58
-#define OP_Delete                              59
-#define OP_ResetCount                          60
-#define OP_GrpCompare                          61
-#define OP_SorterData                          62
-#define OP_RowKey                              63
-#define OP_RowData                             64
-#define OP_AnalyzeKey                          65
-#define OP_Rowid                               66
-#define OP_NullRow                             69
-#define OP_Last                                70
-#define OP_SorterSort                          71
-#define OP_Sort                                80
-#define OP_Rewind                              91
-#define OP_SorterNext                          94
-#define OP_Prev                                95
-#define OP_Next                                96
-#define OP_Insert                              97
-#define OP_IdxDelete                           98
-#define OP_IdxRowkey                           99
-#define OP_IdxLT                              100
-#define OP_IdxLE                              101
-#define OP_IdxGE                              102
-#define OP_IdxGT                              103
-#define OP_Clear                              104
-#define OP_ParseSchema                        105
-#define OP_LoadAnalysis                       106
-#define OP_DropTable                          107
-#define OP_DropIndex                          108
-#define OP_DropTrigger                        109
-#define OP_RowSetTest                         110
-#define OP_RowSetAdd                          111
-#define OP_RowSetRead                         112
-#define OP_Program                            113
-#define OP_Param                              114
-#define OP_FkCounter                          115
-#define OP_FkIfZero                           116
-#define OP_MemMax                             117
-#define OP_IfPos                              118
-#define OP_IfNeg                              119
-#define OP_IfZero                             120
-#define OP_AggStep                            121
-#define OP_AggFinal                           122
-#define OP_JournalMode                        123
-#define OP_Expire                             124
-#define OP_VBegin                             125
-#define OP_VCreate                            126
-#define OP_VDestroy                           127
-#define OP_VOpen                              128
-#define OP_VFilter                            129
-#define OP_VColumn                            130
-#define OP_VNext                              131
-#define OP_VRename                            132
-#define OP_VUpdate                            133
-#define OP_Trace                              134
-#define OP_FtsUpdate                          135
-#define OP_FtsCksum                           136
-#define OP_FtsOpen                            137
-#define OP_FtsNext                            138
-#define OP_FtsPk                              139
-#define OP_Noop                               140
-#define OP_Explain                            146
+#define OP_SeekBatch                           52
+#define OP_SeekBatchAdd                        53
+#define OP_SeekBatchNext                       54
+#define OP_NotExists                           55
+#define OP_NotFound                            56
+#define OP_Found                               57
+#define OP_IsUnique                            58
+#define OP_Sequence                            59
+#define OP_NewRowid                            60
+#define OP_NewIdxid                            61
+#define OP_Delete                              62
+#define OP_ResetCount                          63
+#define OP_GrpCompare                          64
+#define OP_SorterData                          65
+#define OP_RowKey                              66
+#define OP_RowData                             67
+#define OP_AnalyzeKey                          70
+#define OP_Rowid                               71
+#define OP_NullRow                             72
+#define OP_Last                                81
+#define OP_SorterSort                          92
+#define OP_Sort                                95
+#define OP_Rewind                              96
+#define OP_SorterNext                          97
+#define OP_Prev                                98
+#define OP_Next                                99
+#define OP_Insert                             100
+#define OP_SorterInsert                       101
+#define OP_SorterWrite                        102
+#define OP_IdxDelete                          103
+#define OP_IdxRowkey                          104
+#define OP_IdxLT                              105
+#define OP_IdxLE                              106
+#define OP_IdxGE                              107
+#define OP_IdxGT                              108
+#define OP_Clear                              109
+#define OP_ParseSchema                        110
+#define OP_LoadAnalysis                       111
+#define OP_DropTable                          112
+#define OP_DropIndex                          113
+#define OP_DropTrigger                        114
+#define OP_RowSetTest                         115
+#define OP_RowSetAdd                          116
+#define OP_RowSetRead                         117
+#define OP_Program                            118
+#define OP_Param                              119
+#define OP_FkCounter                          120
+#define OP_FkIfZero                           121
+#define OP_MemMax                             122
+#define OP_IfPos                              123
+#define OP_IfNeg                              124
+#define OP_IfZero                             125
+#define OP_AggStep                            126
+#define OP_AggFinal                           127
+#define OP_ParallelAgg                        128
+#define OP_JournalMode                        129
+#define OP_Expire                             130
+#define OP_VBegin                             131
+#define OP_VCreate                            132
+#define OP_VDestroy                           133
+#define OP_VOpen                              134
+#define OP_VFilter                            135
+#define OP_VColumn                            136
+#define OP_VNext                              137
+#define OP_VRename                            138
+#define OP_VUpdate                            139
+#define OP_Trace                              140
+#define OP_FtsUpdate                          141
+#define OP_FtsCksum                           147
+#define OP_FtsOpen                            148
+#define OP_FtsNext                            149
+#define OP_FtsPk                              150
+#define OP_Noop                               151
+#define OP_Explain                            152
 
 
 /* Properties such as "out2" or "jump" that are specified in
@@ -162,20 +168,178 @@
 #define OPFLG_INITIALIZER {\
 /*   0 */ 0x00, 0x01, 0x01, 0x04, 0x04, 0x10, 0x00, 0x02,\
 /*   8 */ 0x02, 0x02, 0x02, 0x02, 0x02, 0x00, 0x24, 0x24,\
-/*  16 */ 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x04, 0x05,\
+/*  16 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0x04, 0x05,\
 /*  24 */ 0x04, 0x00, 0x00, 0x01, 0x01, 0x05, 0x05, 0x00,\
 /*  32 */ 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x02, 0x10,\
 /*  40 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,\
-/*  48 */ 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,\
-/*  56 */ 0x02, 0x02, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,\
-/*  64 */ 0x00, 0x00, 0x02, 0x4c, 0x4c, 0x00, 0x01, 0x01,\
-/*  72 */ 0x05, 0x05, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,\
-/*  80 */ 0x01, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c,\
-/*  88 */ 0x4c, 0x4c, 0x4c, 0x01, 0x24, 0x02, 0x01, 0x01,\
-/*  96 */ 0x01, 0x00, 0x00, 0x02, 0x01, 0x01, 0x01, 0x01,\
-/* 104 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x14,\
-/* 112 */ 0x04, 0x01, 0x02, 0x00, 0x01, 0x08, 0x05, 0x05,\
-/* 120 */ 0x05, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,\
-/* 128 */ 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,\
-/* 136 */ 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x04, 0x04,\
-/* 144 */ 0x04, 0x04, 0x00,}
+/*  48 */ 0x11, 0x11, 0x11, 0x11, 0x01, 0x00, 0x00, 0x11,\
+/*  56 */ 0x11, 0x11, 0x11, 0x02, 0x02, 0x04, 0x00, 0x00,\
+/*  64 */ 0x00, 0x00, 0x00, 0x00, 0x4c, 0x4c, 0x00, 0x02,\
+/*  72 */ 0x00, 0x05, 0x05, 0x15, 0x15, 0x15, 0x15, 0x15,\
+/*  80 */ 0x15, 0x01, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c, 0x4c,\
+/*  88 */ 0x4c, 0x4c, 0x4c, 0x4c, 0x01, 0x24, 0x02, 0x01,\
+/*  96 */ 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00,\
+/* 104 */ 0x02, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00,\
+/* 112 */ 0x00, 0x00, 0x00, 0x15, 0x14, 0x04, 0x01, 0x02,\
+/* 120 */ 0x00, 0x01, 0x08, 0x05, 0x05, 0x05, 0x00, 0x00,\
+/* 128 */ 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,\
+/* 136 */ 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x04, 0x04,\
+/* 144 */ 0x04, 0x04, 0x04, 0x00, 0x01, 0x00, 0x00, 0x00,\
+/* 152 */ 0x00,}
+
+/* Labels in sqlite4VdbeExec() for computed-goto dispatch */
+#define OPCODE_LABEL_INITIALIZER {\
+  &&vdbe_op_switch,\
+  &&vdbe_op_Goto,\
+  &&vdbe_op_Gosub,\
+  &&vdbe_op_Return,\
+  &&vdbe_op_Yield,\
+  &&vdbe_op_HaltIfNull,\
+  &&vdbe_op_Halt,\
+  &&vdbe_op_Integer,\
+  &&vdbe_op_Num,\
+  &&vdbe_op_String,\
+  &&vdbe_op_Null,\
+  &&vdbe_op_Blob,\
+  &&vdbe_op_Variable,\
+  &&vdbe_op_Move,\
+  &&vdbe_op_Copy,\
+  &&vdbe_op_SCopy,\
+  &&vdbe_op_ResultRow,\
+  &&vdbe_op_CollSeq,\
+  &&vdbe_op_KVMethod,\
+  &&vdbe_op_Mifunction,\
+  &&vdbe_op_Function,\
+  &&vdbe_op_Not,\
+  &&vdbe_op_AddImm,\
+  &&vdbe_op_MustBeInt,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_Permutation,\
+  &&vdbe_op_Compare,\
+  &&vdbe_op_Jump,\
+  &&vdbe_op_Once,\
+  &&vdbe_op_If,\
+  &&vdbe_op_IfNot,\
+  &&vdbe_op_Column,\
+  &&vdbe_op_MakeKey,\
+  &&vdbe_op_MakeRecord,\
+  &&vdbe_op_Affinity,\
+  &&vdbe_op_Count,\
+  &&vdbe_op_Savepoint,\
+  &&vdbe_op_Transaction,\
+  &&vdbe_op_ReadCookie,\
+  &&vdbe_op_SetCookie,\
+  &&vdbe_op_VerifyCookie,\
+  &&vdbe_op_OpenRead,\
+  &&vdbe_op_OpenWrite,\
+  &&vdbe_op_OpenAutoindex,\
+  &&vdbe_op_OpenEphemeral,\
+  &&vdbe_op_SorterOpen,\
+  &&vdbe_op_Close,\
+  &&vdbe_op_SeekPk,\
+  &&vdbe_op_SeekLt,\
+  &&vdbe_op_SeekLe,\
+  &&vdbe_op_SeekGe,\
+  &&vdbe_op_SeekGt,\
+  &&vdbe_op_SeekBatch,\
+  &&vdbe_op_SeekBatchAdd,\
+  &&vdbe_op_SeekBatchNext,\
+  &&vdbe_op_NotExists,\
+  &&vdbe_op_NotFound,\
+  &&vdbe_op_Found,\
+  &&vdbe_op_IsUnique,\
+  &&vdbe_op_Sequence,\
+  &&vdbe_op_NewRowid,\
+  &&vdbe_op_NewIdxid,\
+  &&vdbe_op_Delete,\
+  &&vdbe_op_ResetCount,\
+  &&vdbe_op_GrpCompare,\
+  &&vdbe_op_SorterData,\
+  &&vdbe_op_RowKey,\
+  &&vdbe_op_RowData,\
+  &&vdbe_op_Or,\
+  &&vdbe_op_And,\
+  &&vdbe_op_AnalyzeKey,\
+  &&vdbe_op_Rowid,\
+  &&vdbe_op_NullRow,\
+  &&vdbe_op_IsNull,\
+  &&vdbe_op_NotNull,\
+  &&vdbe_op_Ne,\
+  &&vdbe_op_Eq,\
+  &&vdbe_op_Gt,\
+  &&vdbe_op_Le,\
+  &&vdbe_op_Lt,\
+  &&vdbe_op_Ge,\
+  &&vdbe_op_Last,\
+  &&vdbe_op_BitAnd,\
+  &&vdbe_op_BitOr,\
+  &&vdbe_op_ShiftLeft,\
+  &&vdbe_op_ShiftRight,\
+  &&vdbe_op_Add,\
+  &&vdbe_op_Subtract,\
+  &&vdbe_op_Multiply,\
+  &&vdbe_op_Divide,\
+  &&vdbe_op_Remainder,\
+  &&vdbe_op_Concat,\
+  &&vdbe_op_SorterSort,\
+  &&vdbe_op_BitNot,\
+  &&vdbe_op_String8,\
+  &&vdbe_op_Sort,\
+  &&vdbe_op_Rewind,\
+  &&vdbe_op_SorterNext,\
+  &&vdbe_op_Prev,\
+  &&vdbe_op_Next,\
+  &&vdbe_op_Insert,\
+  &&vdbe_op_SorterInsert,\
+  &&vdbe_op_SorterWrite,\
+  &&vdbe_op_IdxDelete,\
+  &&vdbe_op_IdxRowkey,\
+  &&vdbe_op_IdxLT,\
+  &&vdbe_op_IdxLE,\
+  &&vdbe_op_IdxGE,\
+  &&vdbe_op_IdxGT,\
+  &&vdbe_op_Clear,\
+  &&vdbe_op_ParseSchema,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_DropTable,\
+  &&vdbe_op_DropIndex,\
+  &&vdbe_op_DropTrigger,\
+  &&vdbe_op_RowSetTest,\
+  &&vdbe_op_RowSetAdd,\
+  &&vdbe_op_RowSetRead,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_IfPos,\
+  &&vdbe_op_IfNeg,\
+  &&vdbe_op_IfZero,\
+  &&vdbe_op_AggStep,\
+  &&vdbe_op_AggFinal,\
+  &&vdbe_op_ParallelAgg,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_Expire,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_FtsUpdate,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_ToInt,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_FtsCksum,\
+  &&vdbe_op_FtsOpen,\
+  &&vdbe_op_FtsNext,\
+  &&vdbe_op_FtsPk,\
+  &&vdbe_op_switch,\
+  &&vdbe_op_switch,\
+}
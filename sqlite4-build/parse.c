@@ -72,7 +72,7 @@ struct ValueList {
 */
 struct CoveringOpt { IdList *pList; Token sEnd; };
 
-#line 762 "parse.y"
+#line 772 "parse.y"
 
   /* This is a utility routine used to set the ExprSpan.zStart and
   ** ExprSpan.zEnd values of pOut so that the span covers the complete
@@ -92,7 +92,7 @@ struct CoveringOpt { IdList *pList; Token sEnd; };
     pOut->zStart = pValue->z;
     pOut->zEnd = &pValue->z[pValue->n];
   }
-#line 857 "parse.y"
+#line 867 "parse.y"
 
   /* This routine constructs a binary expression node out of two ExprSpan
   ** objects and uses the result to populate a new ExprSpan object.
@@ -108,7 +108,7 @@ struct CoveringOpt { IdList *pList; Token sEnd; };
     pOut->zStart = pLeft->zStart;
     pOut->zEnd = pRight->zEnd;
   }
-#line 917 "parse.y"
+#line 927 "parse.y"
 
   /* Construct an expression node for a unary postfix operator
   */
@@ -123,7 +123,7 @@ struct CoveringOpt { IdList *pList; Token sEnd; };
     pOut->zStart = pOperand->zStart;
     pOut->zEnd = &pPostOp->z[pPostOp->n];
   }                           
-#line 936 "parse.y"
+#line 946 "parse.y"
 
   /* A routine to convert a binary TK_IS or TK_ISNOT expression into a
   ** unary TK_ISNULL or TK_NOTNULL expression. */
@@ -135,7 +135,7 @@ struct CoveringOpt { IdList *pList; Token sEnd; };
       pA->pRight = 0;
     }
   }
-#line 964 "parse.y"
+#line 974 "parse.y"
 
   /* Construct an expression node for a unary prefix operator
   */
@@ -201,29 +201,29 @@ struct CoveringOpt { IdList *pList; Token sEnd; };
 **                       defined, then do no error processing.
 */
 #define YYCODETYPE unsigned char
-#define YYNOCODE 252
+#define YYNOCODE 253
 #define YYACTIONTYPE unsigned short int
-#define YYWILDCARD 66
+#define YYWILDCARD 67
 #define sqlite4ParserTOKENTYPE Token
 typedef union {
   int yyinit;
   sqlite4ParserTOKENTYPE yy0;
-  Expr* yy72;
-  TriggerStep* yy145;
-  ExprList* yy148;
-  struct ValueList yy167;
-  SrcList* yy185;
-  ExprSpan yy190;
-  int yy194;
-  CreateIndex yy195;
-  u8 yy234;
-  Select* yy243;
-  IdList* yy254;
-  struct TrigEvent yy332;
-  struct LimitVal yy354;
-  struct CoveringOpt yy376;
-  struct LikeOp yy392;
-  struct {int value; int mask;} yy497;
+  int yy4;
+  struct TrigEvent yy90;
+  ExprSpan yy118;
+  TriggerStep* yy203;
+  u8 yy210;
+  struct {int value; int mask;} yy215;
+  CreateIndex yy233;
+  SrcList* yy259;
+  struct ValueList yy260;
+  struct LimitVal yy292;
+  Expr* yy314;
+  ExprList* yy322;
+  struct LikeOp yy342;
+  IdList* yy384;
+  Select* yy387;
+  struct CoveringOpt yy422;
 } YYMINORTYPE;
 #ifndef YYSTACKDEPTH
 #define YYSTACKDEPTH 100
@@ -232,8 +232,8 @@ typedef union {
 #define sqlite4ParserARG_PDECL ,Parse *pParse
 #define sqlite4ParserARG_FETCH Parse *pParse = yypParser->pParse
 #define sqlite4ParserARG_STORE yypParser->pParse = pParse
-#define YYNSTATE 625
-#define YYNRULE 325
+#define YYNSTATE 627
+#define YYNRULE 327
 #define YYFALLBACK 1
 #define YY_NO_ACTION      (YYNSTATE+YYNRULE+2)
 #define YY_ACCEPT_ACTION  (YYNSTATE+YYNRULE+1)
@@ -303,481 +303,483 @@ static const YYMINORTYPE yyzerominor = { 0 };
 **                     shifting non-terminals after a reduce.
 **  yy_default[]       Default action for each state.
 */
-#define YY_ACTTAB_COUNT (1595)
+#define YY_ACTTAB_COUNT (1610)
 static const YYACTIONTYPE yy_action[] = {
- /*     0 */   312,  169,   50,   46,  153,  174,  622,  592,   56,   56,
+ /*     0 */   312,  624,   50,   46,  153,  174,  304,  594,   56,   56,
  /*    10 */    56,   56,   49,   54,   54,   54,   54,   53,   53,   52,
- /*    20 */    52,   52,   51,  240,  242,   66,  618,  617,  428,  592,
- /*    30 */   585,   48,   56,   56,   56,   56,  354,   54,   54,   54,
- /*    40 */    54,   53,   53,   52,   52,   52,   51,  240,   57,   58,
- /*    50 */    47,  578,  577,  579,  579,   55,   55,   56,   56,   56,
- /*    60 */    56,  304,   54,   54,   54,   54,   53,   53,   52,   52,
- /*    70 */    52,   51,  240,  312,  592,  272,  329,  412,  509,   32,
- /*    80 */    54,   54,   54,   54,   53,   53,   52,   52,   52,   51,
- /*    90 */   240,  329,  415,  615,  614,  168,  592,  603,  383,  380,
- /*   100 */   379,  596,   81,  585,   48,  199,  198,  197,   59,  378,
- /*   110 */   512,  511,   53,   53,   52,   52,   52,   51,  240,  268,
- /*   120 */   270,   57,   58,   47,  578,  577,  579,  579,   55,   55,
- /*   130 */    56,   56,   56,   56,  216,   54,   54,   54,   54,   53,
- /*   140 */    53,   52,   52,   52,   51,  240,  312,  410,  228,  575,
- /*   150 */   575,  139,  179,  145,  286,  386,  281,  385,  171,  562,
- /*   160 */   412,  196,  429,  228,  412,  277,  502,  503,  145,  286,
- /*   170 */   386,  281,  385,  171,  576,  415,  585,   48,  168,  415,
- /*   180 */   277,  383,  380,  379,  596,   88,  241,  522,  596,   88,
- /*   190 */     3,  590,  378,   18,   57,   58,   47,  578,  577,  579,
- /*   200 */   579,   55,   55,   56,   56,   56,   56,  461,   54,   54,
- /*   210 */    54,   54,   53,   53,   52,   52,   52,   51,  240,  312,
- /*   220 */   113,  666,  588,  588,  588,  236,  285,  412,  397,  235,
- /*   230 */   338,  168,  419,  621,  383,  380,  379,  284,  243,  412,
- /*   240 */   136,  412,  415,   10,  597,  378,  207,  667,  598,  585,
- /*   250 */    48,  596,   95,  462,  415,  311,  415,    1,  564,  488,
- /*   260 */   215,  618,  617,  596,   95,  596,   81,   57,   58,   47,
- /*   270 */   578,  577,  579,  579,   55,   55,   56,   56,   56,   56,
- /*   280 */   595,   54,   54,   54,   54,   53,   53,   52,   52,   52,
- /*   290 */    51,  240,  312,  399,  668,  487,  341,  340,  389,  469,
- /*   300 */   261,  350,  260,  470,  345,  395,  602,   67,  178,  412,
- /*   310 */   616,  242,  412,  545,  321,  314,   68,  366,  158,  204,
- /*   320 */   618,  617,  585,   48,  415,  316,  433,  415,  615,  614,
- /*   330 */   193,  478,  177,  596,   95,   38,  596,   95,  618,  617,
- /*   340 */    57,   58,   47,  578,  577,  579,  579,   55,   55,   56,
- /*   350 */    56,   56,   56,  595,   54,   54,   54,   54,   53,   53,
- /*   360 */    52,   52,   52,   51,  240,  312,  412,  568,  568,  527,
- /*   370 */   613,  612,  611,  618,  617,  399,  205,  557,  399,   44,
- /*   380 */   400,  415,  152,  351,  618,  617,  592,  615,  614,  365,
- /*   390 */   596,   74,  209,  556,  170,  585,   48,  619,  363,  529,
- /*   400 */    52,   52,   52,   51,  240,  615,  614,  545,   35,  555,
- /*   410 */   595,  403,  616,   57,   58,   47,  578,  577,  579,  579,
- /*   420 */    55,   55,   56,   56,   56,   56,  595,   54,   54,   54,
- /*   430 */    54,   53,   53,   52,   52,   52,   51,  240,  312,  572,
- /*   440 */   615,  614,  524,  573,  528,   65,  487,  315,  574,  412,
- /*   450 */   355,  615,  614,  592,  302,  412,  190,  477,   67,  563,
- /*   460 */   412,  616,  561,  560,  415,  538,  544,  173,  585,   48,
- /*   470 */   415,   62,  462,  596,   94,  415,  349,  543,  257,  596,
- /*   480 */    73,  618,  617,  208,  596,   95,   57,   58,   47,  578,
- /*   490 */   577,  579,  579,   55,   55,   56,   56,   56,   56,  202,
- /*   500 */    54,   54,   54,   54,   53,   53,   52,   52,   52,   51,
- /*   510 */   240,  312,  185,  557,  184,  507,  545,  595,  550,  261,
- /*   520 */   350,  260,  254,  256,  295,  356,  322,  549,  559,  556,
- /*   530 */   242,  159,  410,  540,  575,  575,  410,  176,  575,  575,
- /*   540 */   616,  585,   48,  353,  174,  555,  592,  516,  615,  614,
- /*   550 */   410,  558,  575,  575,  331,  571,  570,  554,  515,   57,
- /*   560 */    58,   47,  578,  577,  579,  579,   55,   55,   56,   56,
- /*   570 */    56,   56,  531,   54,   54,   54,   54,   53,   53,   52,
- /*   580 */    52,   52,   51,  240,  312,  152,  375,   34,  274,   50,
- /*   590 */    46,  153,  225,  408,  571,  570,  501,  487,  520,  255,
- /*   600 */   410,    6,  575,  575,  625,  623,  333,  599,  423,   67,
- /*   610 */   545,  384,  616,  592,  585,   48,  467,  170,  500,  480,
- /*   620 */   506,  239,   50,   46,  153,  201,  481,  951,  187,  420,
- /*   630 */     2,   30,   57,   58,   47,  578,  577,  579,  579,   55,
- /*   640 */    55,   56,   56,   56,   56,   13,   54,   54,   54,   54,
- /*   650 */    53,   53,   52,   52,   52,   51,  240,  312,  266,  595,
- /*   660 */   239,  412,   21,  624,    2,  412,  388,  327,   12,  203,
- /*   670 */   315,  200,  150,  616,  542,  277,  415,  471,  471,  368,
- /*   680 */   415,  496,  134,  169,  209,  596,   69,  585,   48,  596,
- /*   690 */    97,  597,  518,  517,  465,  598,  564,  407,  215,  172,
- /*   700 */   275,  336,  169,  595,  206,   57,   58,   47,  578,  577,
- /*   710 */   579,  579,   55,   55,   56,   56,   56,   56,  595,   54,
- /*   720 */    54,   54,   54,   53,   53,   52,   52,   52,   51,  240,
- /*   730 */   312,  412,  871,  278,  412,  343,  278,  600,  595,  376,
- /*   740 */   112,  169,  355,  601,  489,  492,  415,  412,  616,  415,
- /*   750 */   412,  616,  492,  547,  242,  596,  100,  334,  596,   98,
- /*   760 */   585,   48,  415,   20,  344,  415,  354,  455,  362,  173,
- /*   770 */   326,  596,  108,  227,  596,  107,  214,  150,   57,   58,
- /*   780 */    47,  578,  577,  579,  579,   55,   55,   56,   56,   56,
- /*   790 */    56,  412,   54,   54,   54,   54,   53,   53,   52,   52,
- /*   800 */    52,   51,  240,  312,  412,  278,  415,  412,  454,  391,
- /*   810 */    34,  412,  278,  359,  149,  596,  110,  392,  534,  415,
- /*   820 */   616,  360,  415,  412,  536,  526,  415,  616,  596,  111,
- /*   830 */   440,  596,  140,  585,   48,  596,  141,  525,  415,  616,
- /*   840 */   148,   39,  325,   37,  213,  233,  191,  596,  101,  324,
- /*   850 */    28,   57,   58,   47,  578,  577,  579,  579,   55,   55,
- /*   860 */    56,   56,   56,   56,  412,   54,   54,   54,   54,   53,
- /*   870 */    53,   52,   52,   52,   51,  240,  312,  412,  595,  415,
- /*   880 */   412,  212,  499,  278,  356,  412,  382,  330,  596,  106,
- /*   890 */   566,  238,  415,  412,  250,  415,  169,  412,  616,  616,
- /*   900 */   415,  596,  105,  132,  596,  104,  585,   48,  415,  596,
- /*   910 */    96,  439,  415,  173,  276,  595,  540,  596,  103,  131,
- /*   920 */   320,  596,   77,   27,   57,   45,   47,  578,  577,  579,
- /*   930 */   579,   55,   55,   56,   56,   56,   56,  412,   54,   54,
- /*   940 */    54,   54,   53,   53,   52,   52,   52,   51,  240,  312,
- /*   950 */   266,  221,  415,  412,  434,  234,   23,  412,   16,  377,
- /*   960 */   189,  596,   99,  464,  517,  616,  623,  333,  415,  130,
- /*   970 */   412,  361,  415,  536,  361,  584,  583,  596,  144,  585,
- /*   980 */    48,  596,  143,  284,  167,  415,  616,  373,  616,  616,
- /*   990 */    51,  240,  475,  265,  596,  142,  581,  580,   58,   47,
- /*  1000 */   578,  577,  579,  579,   55,   55,   56,   56,   56,   56,
- /*  1010 */   412,   54,   54,   54,   54,   53,   53,   52,   52,   52,
- /*  1020 */    51,  240,  312,  582,  412,  415,  412,  361,  188,  369,
- /*  1030 */   412,  128,  607,  472,  596,   76,  367,  127,  468,  415,
- /*  1040 */   263,  415,  616,  412,  536,  415,  412,  616,  596,   93,
- /*  1050 */   596,   92,  585,   48,  596,   75,  173,   15,  415,  616,
- /*  1060 */   162,  415,  460,  161,  160,  457,  226,  596,   91,  259,
- /*  1070 */   596,   90,   47,  578,  577,  579,  579,   55,   55,   56,
- /*  1080 */    56,   56,   56,  125,   54,   54,   54,   54,   53,   53,
- /*  1090 */    52,   52,   52,   51,  240,   43,  406,   25,    4,  435,
- /*  1100 */   412,  540,  416,  617,  412,  540,  124,  323,   24,   43,
- /*  1110 */   406,  606,    4,  409,   11,  415,  416,  617,    5,  415,
- /*  1120 */   352,  266,  224,  412,  596,  102,  616,  409,  596,   89,
- /*  1130 */   453,  448,  404,  115,  122,  117,  616,  605,  415,  146,
- /*  1140 */   290,  562,  451,  137,  288,  266,  404,  596,   87,  114,
- /*  1150 */   438,  266,  616,  220,  616,  562,  266,  442,  219,  411,
- /*  1160 */   616,   40,   41,  536,  449,  412,  616,   64,   42,  414,
- /*  1170 */   413,  616,  430,  590,  616,   40,   41,  412,  616,  432,
- /*  1180 */   415,  431,   42,  414,  413,  266,  430,  590,  447,  596,
- /*  1190 */    86,  218,  415,  432,  446,  431,  266,  266,  589,  445,
- /*  1200 */   616,  596,   85,  335,  588,  588,  588,  587,  586,   14,
- /*  1210 */    61,  616,  616,  616,  618,  617,  154,  244,  588,  588,
- /*  1220 */   588,  587,  586,   14,   43,  406,  318,    4,  223,  401,
- /*  1230 */   553,  416,  617,  332,  109,  421,  232,  541,  129,  222,
- /*  1240 */   251,  537,  409,  412,  616,  616,  620,   43,  406,  535,
- /*  1250 */     4,  412,  616,  562,  416,  617,  616,  610,  415,  183,
- /*  1260 */   182,  404,  280,  412,  616,  409,  415,  596,   72,  609,
- /*  1270 */   562,  418,    8,  195,  194,  596,   71,  616,  415,  412,
- /*  1280 */   505,  522,  608,  180,  404,  590,  242,  596,   84,   30,
- /*  1290 */    40,   41,  530,  562,  415,  616,  279,   42,  414,  413,
- /*  1300 */   594,  417,  590,  596,   83,  298,  396,  398,   31,  299,
- /*  1310 */   237,  616,  485,   40,   41,  273,  588,  588,  588,  297,
- /*  1320 */    42,  414,  413,   60,  271,  590,  412,  616,  296,  269,
- /*  1330 */   616,   36,  267,  588,  588,  588,  587,  586,   14,  616,
- /*  1340 */   412,  415,  175,  242,  616,   43,  406,  616,    4,  552,
- /*  1350 */   596,   82,  416,  617,  291,  415,  588,  588,  588,  587,
- /*  1360 */   586,   14,  262,  409,  596,   80,  466,  186,   33,  406,
- /*  1370 */   412,    4,  412,  459,  412,  416,  617,  616,  593,   29,
- /*  1380 */   539,  616,  404,  289,  393,  415,  409,  415,  616,  415,
- /*  1390 */   287,  562,  458,  357,  596,   70,  596,   17,  596,   79,
- /*  1400 */   342,  412,  249,  519,  533,  404,  390,  616,  616,  246,
- /*  1410 */   387,   40,   41,  245,  562,  616,  415,  616,   42,  414,
- /*  1420 */   413,  415,  532,  590,  616,  596,   78,  328,  616,  424,
- /*  1430 */   596,    9,  294,  514,   40,   41,  151,  282,  394,  513,
- /*  1440 */   510,   42,  414,  413,  616,  509,  590,  616,  293,  508,
- /*  1450 */   310,  616,  133,  616,  588,  588,  588,  587,  586,   14,
- /*  1460 */   217,  230,  490,  616,  231,  307,  306,  305,  181,  303,
- /*  1470 */   229,  484,  450,  483,  166,  482,  374,  588,  588,  588,
- /*  1480 */   587,  586,   14,  309,  476,  165,  155,  372,  248,  164,
- /*  1490 */   264,  211,  474,  370,   26,  163,  147,  247,  364,  463,
- /*  1500 */   126,  473,  138,  123,  452,  121,  348,  120,  119,  118,
- /*  1510 */   157,  444,  462,  116,  441,  135,  319,   22,  156,  317,
- /*  1520 */   427,   19,  426,  425,  422,   63,  604,  192,  569,  591,
- /*  1530 */   300,  567,  551,  405,  548,  283,  506,  292,  495,  358,
- /*  1540 */   494,  493,  491,  456,  443,  381,  258,  253,  339,  346,
- /*  1550 */   437,  436,  308,  565,  546,    7,  240,  486,  479,  261,
- /*  1560 */   347,  252,  210,  301,  371,  313,  402,  523,  521,  504,
- /*  1570 */   242,  498,  497,  952,  952,  952,  952,  952,  952,  952,
- /*  1580 */   952,  952,  952,  952,  952,  952,  952,  952,  952,  952,
- /*  1590 */   952,  952,  952,  952,  337,
+ /*    20 */    52,   52,   51,  240,  285,  216,  620,  619,  430,  587,
+ /*    30 */    48,   56,   56,   56,   56,  284,   54,   54,   54,   54,
+ /*    40 */    53,   53,   52,   52,   52,   51,  240,   57,   58,   47,
+ /*    50 */   580,  579,  581,  581,   55,   55,   56,   56,   56,   56,
+ /*    60 */   257,   54,   54,   54,   54,   53,   53,   52,   52,   52,
+ /*    70 */    51,  240,  312,  594,  575,  330,   65,  375,   32,   54,
+ /*    80 */    54,   54,   54,   53,   53,   52,   52,   52,   51,  240,
+ /*    90 */   330,  670,  617,  616,  168,  530,  599,  383,  380,  379,
+ /*   100 */   600,  587,   48,  254,  256,  315,   59,  170,  378,   53,
+ /*   110 */    53,   52,   52,   52,   51,  240,  615,  614,  613,   57,
+ /*   120 */    58,   47,  580,  579,  581,  581,   55,   55,   56,   56,
+ /*   130 */    56,   56,  112,   54,   54,   54,   54,   53,   53,   52,
+ /*   140 */    52,   52,   51,  240,  312,  333,  228,  422,  421,  139,
+ /*   150 */   179,  145,  286,  386,  281,  385,  171,  196,  514,  513,
+ /*   160 */   316,  228,  412,  277,  391,  277,  145,  286,  386,  281,
+ /*   170 */   385,  171,  392,  587,   48,  419,  623,  415,  277,  365,
+ /*   180 */   255,  243,  410,  136,  577,  577,  598,   95,  363,  207,
+ /*   190 */   564,   57,   58,   47,  580,  579,  581,  581,   55,   55,
+ /*   200 */    56,   56,   56,   56,  463,   54,   54,   54,   54,   53,
+ /*   210 */    53,   52,   52,   52,   51,  240,  312,  621,  524,  412,
+ /*   220 */   671,  442,  592,  597,  489,  559,  168,  412,  399,  383,
+ /*   230 */   380,  379,  618,  389,  415,  604,   67,  504,  505,  618,
+ /*   240 */   378,  558,  415,  598,   94,  587,   48,  345,  540,  464,
+ /*   250 */   173,  598,   88,  590,  590,  590,  557,  322,  403,  193,
+ /*   260 */   480,  609,  464,   57,   58,   47,  580,  579,  581,  581,
+ /*   270 */    55,   55,   56,   56,   56,   56,  618,   54,   54,   54,
+ /*   280 */    54,   53,   53,   52,   52,   52,   51,  240,  312,  605,
+ /*   290 */   113,  397,  235,  343,  295,    1,  261,  350,  260,  620,
+ /*   300 */   619,  412,  620,  619,  412,  388,  356,  242,  412,  261,
+ /*   310 */   350,  260,  242,  498,  204,  169,  415,  587,   48,  415,
+ /*   320 */   242,  618,   44,  415,  354,  598,   95,  672,  598,   95,
+ /*   330 */   599,   38,  598,   81,  600,   57,   58,   47,  580,  579,
+ /*   340 */   581,  581,   55,   55,   56,   56,   56,   56,  597,   54,
+ /*   350 */    54,   54,   54,   53,   53,   52,   52,   52,   51,  240,
+ /*   360 */   312,  412,  203,  576,  529,  617,  616,  399,  617,  616,
+ /*   370 */   399,  205,  351,  225,  168,  400,  415,  383,  380,  379,
+ /*   380 */   620,  619,  620,  619,  563,  598,   74,  158,  378,  587,
+ /*   390 */    48,  178,  317,  435,  546,  311,  597,   68,  566,  490,
+ /*   400 */   215,  620,  619,   35,  275,  597,  169,   57,   58,   47,
+ /*   410 */   580,  579,  581,  581,   55,   55,   56,   56,   56,   56,
+ /*   420 */   542,   54,   54,   54,   54,   53,   53,   52,   52,   52,
+ /*   430 */    51,  240,  312,  627,  625,  314,  526,   52,   52,   52,
+ /*   440 */    51,  240,  531,  489,  586,  585,  617,  616,  617,  616,
+ /*   450 */   410,  302,  577,  577,  479,   67,   66,  547,  618,  533,
+ /*   460 */   594,  587,   48,  482,  508,  583,  582,  617,  616,  177,
+ /*   470 */   483,  410,  545,  577,  577,  578,   50,   46,  153,   57,
+ /*   480 */    58,   47,  580,  579,  581,  581,   55,   55,   56,   56,
+ /*   490 */    56,   56,  584,   54,   54,   54,   54,   53,   53,   52,
+ /*   500 */    52,   52,   51,  240,  312,  559,  209,  185,  509,  184,
+ /*   510 */   190,  547,  489,  574,  332,  573,  572,  412,  570,  570,
+ /*   520 */   412,  558,  412,  425,   67,  152,  594,  618,  408,  573,
+ /*   530 */   572,  170,  415,  587,   48,  415,  557,  415,  518,    3,
+ /*   540 */   597,  598,   88,  565,  598,   95,  598,   95,  562,  517,
+ /*   550 */   547,   57,   58,   47,  580,  579,  581,  581,   55,   55,
+ /*   560 */    56,   56,   56,   56,  355,   54,   54,   54,   54,   53,
+ /*   570 */    53,   52,   52,   52,   51,  240,  312,  412,  503,  152,
+ /*   580 */   274,  239,  236,  542,  316,   62,  395,  174,  323,  594,
+ /*   590 */   349,   10,  415,  384,  410,  239,  577,  577,  620,  619,
+ /*   600 */   502,  598,   81,  202,  547,  587,   48,  214,  150,  955,
+ /*   610 */   187,  420,    2,  199,  198,  197,  272,  473,  473,  368,
+ /*   620 */   201,  594,  234,   57,   58,   47,  580,  579,  581,  581,
+ /*   630 */    55,   55,   56,   56,   56,   56,  266,   54,   54,   54,
+ /*   640 */    54,   53,   53,   52,   52,   52,   51,  240,  312,  328,
+ /*   650 */   209,  618,  176,   21,  597,  594,  412,  338,  412,  268,
+ /*   660 */   270,  412,  431,  159,  617,  616,  200,  150,   50,   46,
+ /*   670 */   153,  415,  410,  415,  577,  577,  415,  587,   48,  336,
+ /*   680 */   598,   73,  598,   69,  597,  598,   97,  594,  566,  407,
+ /*   690 */   215,  208,  376,   34,  169,   57,   58,   47,  580,  579,
+ /*   700 */   581,  581,   55,   55,   56,   56,   56,   56,  355,   54,
+ /*   710 */    54,   54,   54,   53,   53,   52,   52,   52,   51,  240,
+ /*   720 */   312,  469,  412,  341,  340,  597,  278,  169,  471,  412,
+ /*   730 */   457,  472,  173,  412,  362,  334,  456,  415,   34,  549,
+ /*   740 */   412,  618,  626,    2,  415,  366,  598,  100,  415,  587,
+ /*   750 */    48,  353,   20,  598,   98,  415,  561,  598,  108,   16,
+ /*   760 */   206,  189,   30,  327,  598,  107,    6,   57,   58,   47,
+ /*   770 */   580,  579,  581,  581,   55,   55,   56,   56,   56,   56,
+ /*   780 */   412,   54,   54,   54,   54,   53,   53,   52,   52,   52,
+ /*   790 */    51,  240,  312,  412,  597,  415,  278,  560,  467,  412,
+ /*   800 */   250,  412,  169,  511,  598,  110,  603,  491,  415,  520,
+ /*   810 */   519,  618,  538,  412,  415,  494,  415,  598,  111,  538,
+ /*   820 */   344,  587,   48,  598,  140,  598,  141,  618,  415,  556,
+ /*   830 */    39,  191,   37,  227,  618,   13,  875,  598,  101,   57,
+ /*   840 */    58,   47,  580,  579,  581,  581,   55,   55,   56,   56,
+ /*   850 */    56,   56,  412,   54,   54,   54,   54,   53,   53,   52,
+ /*   860 */    52,   52,   51,  240,  312,  412,  278,  415,  278,  361,
+ /*   870 */   552,  412,  441,  608,  173,  331,  598,  106,   12,  551,
+ /*   880 */   415,  618,  367,  618,  618,  412,  415,  361,  618,  598,
+ /*   890 */   105,  241,  356,  587,   48,  598,  104,  436,   18,   23,
+ /*   900 */   415,  544,  618,  326,  134,  325,  172,  618,  536,  598,
+ /*   910 */    96,   57,   45,   47,  580,  579,  581,  581,   55,   55,
+ /*   920 */    56,   56,   56,   56,  412,   54,   54,   54,   54,   53,
+ /*   930 */    53,   52,   52,   52,   51,  240,  312,  412,  278,  415,
+ /*   940 */   266,  149,  359,  412,  528,  412,  466,  519,  598,  103,
+ /*   950 */   360,  527,  415,  618,  148,  618,  412,  607,  415,  221,
+ /*   960 */   415,  598,   77,  538,  226,  587,   48,  598,   99,  598,
+ /*   970 */   144,  415,  618,   51,  240,  321,  568,  238,  618,  213,
+ /*   980 */   598,  143,  259,  265,   58,   47,  580,  579,  581,  581,
+ /*   990 */    55,   55,   56,   56,   56,   56,  412,   54,   54,   54,
+ /*  1000 */    54,   53,   53,   52,   52,   52,   51,  240,  312,  412,
+ /*  1010 */   361,  415,  266,  597,  212,  412,  146,  412,  625,  314,
+ /*  1020 */   598,  142,  233,   28,  415,  618,  324,  618,  412,  542,
+ /*  1030 */   415,  618,  415,  598,   76,  411,  538,  587,   48,  598,
+ /*  1040 */    93,  598,   92,  415,  501,  382,  276,  522,  597,  132,
+ /*  1050 */   618,  618,  598,   75,  542,  451,  601,   47,  580,  579,
+ /*  1060 */   581,  581,   55,   55,   56,   56,   56,   56,  290,   54,
+ /*  1070 */    54,   54,   54,   53,   53,   52,   52,   52,   51,  240,
+ /*  1080 */    43,  406,  602,    4,  437,  412,  266,  416,  619,  412,
+ /*  1090 */   494,  591,  266,  288,  377,   43,  406,  409,    4,  319,
+ /*  1100 */   415,  618,  416,  619,  415,  224,  618,  618,  412,  598,
+ /*  1110 */    91,  401,  409,  598,   90,  555,  404,  131,   27,  412,
+ /*  1120 */   130,  266,  543,  415,  539,  564,  618,  537,  167,  449,
+ /*  1130 */   618,  404,  598,  102,  415,  448,  618,  618,  242,  618,
+ /*  1140 */   564,  284,  618,  598,   89,   40,   41,  280,  373,  188,
+ /*  1150 */   354,  507,   42,  414,  413,  128,  432,  592,  412,  477,
+ /*  1160 */    40,   41,  618,  434,  447,  433,  618,   42,  414,  413,
+ /*  1170 */    61,  432,  592,  415,  620,  619,  369,  474,  434,  127,
+ /*  1180 */   433,  279,  598,   87,  266,  412,  173,  263,  590,  590,
+ /*  1190 */   590,  589,  588,   14,   43,  406,  618,    4,  470,  618,
+ /*  1200 */   415,  416,  619,  590,  590,  590,  589,  588,   14,  598,
+ /*  1210 */    86,  409,  564,  412,  266,  162,  487,   43,  406,   15,
+ /*  1220 */     4,  412,  160,  462,  416,  619,  412,  223,  415,  618,
+ /*  1230 */   404,  618,  195,  194,  409,  459,  415,  598,   85,  564,
+ /*  1240 */   524,  415,  161,  273,  592,  598,   72,  125,  412,  266,
+ /*  1250 */   598,   71,   25,  404,  412,  271,   24,  222,  618,   40,
+ /*  1260 */    41,  532,  564,  415,  618,  269,   42,  414,  413,  415,
+ /*  1270 */   618,  592,  598,   84,   11,  590,  590,  590,  598,   83,
+ /*  1280 */   618,  267,   40,   41,  412,  262,  412,  124,  352,   42,
+ /*  1290 */   414,  413,  251,    5,  592,  455,  618,  122,  468,  415,
+ /*  1300 */   618,  415,  590,  590,  590,  589,  588,   14,  598,   82,
+ /*  1310 */   598,   80,  242,  618,  450,  453,   43,  406,  117,    4,
+ /*  1320 */   114,  412,  115,  416,  619,  590,  590,  590,  589,  588,
+ /*  1330 */    14,  137,  412,  409,   33,  406,  415,    4,  444,  220,
+ /*  1340 */   412,  416,  619,  412,  440,  598,   70,  415,  461,  219,
+ /*  1350 */   218,  409,  404,   64,  460,  415,  598,   17,  415,  390,
+ /*  1360 */   357,  564,  342,  618,  598,   79,  335,  598,   78,  618,
+ /*  1370 */   404,  154,  249,  244,  415,  618,  246,  618,  423,  564,
+ /*  1380 */   245,   40,   41,  598,    9,  109,  426,  618,   42,  414,
+ /*  1390 */   413,  618,  622,  592,  232,  618,  129,  294,  151,   40,
+ /*  1400 */    41,  618,  394,  293,  183,  612,   42,  414,  413,  611,
+ /*  1410 */   418,  592,  618,  618,  182,  610,  180,  618,  618,    8,
+ /*  1420 */   242,  596,   30,  417,  590,  590,  590,  589,  588,   14,
+ /*  1430 */   299,  396,  298,   31,  237,  297,   60,  296,  398,  554,
+ /*  1440 */   595,   36,  590,  590,  590,  589,  588,   14,  175,  155,
+ /*  1450 */   217,  186,  291,   29,  393,  307,  306,  305,  181,  303,
+ /*  1460 */   541,  535,  452,  521,  289,  287,  387,  516,  534,  515,
+ /*  1470 */   329,  282,  511,  133,  230,  510,  512,  248,  166,  310,
+ /*  1480 */   486,  374,  485,  478,  165,  492,  247,  484,  164,  231,
+ /*  1490 */   229,  370,  372,   26,  211,  309,  476,  163,  147,  157,
+ /*  1500 */   364,  464,  138,  123,  348,  135,  443,  156,  264,  320,
+ /*  1510 */   475,  121,  465,  126,  116,  318,   22,  454,  429,  120,
+ /*  1520 */   446,  119,  118,  428,   19,  427,  424,  606,   63,  192,
+ /*  1530 */   593,  553,  308,  550,  283,  508,  300,  497,  496,  495,
+ /*  1540 */   571,  956,  493,  381,  339,  458,  439,  438,  261,  347,
+ /*  1550 */   252,  445,  567,  292,  313,  240,  301,  253,  346,  242,
+ /*  1560 */   956,  956,  506,    7,  525,  500,  523,  956,  402,  405,
+ /*  1570 */   499,  488,  956,  956,  481,  956,  956,  569,  956,  956,
+ /*  1580 */   956,  548,  956,  337,  956,  956,  956,  956,  956,  956,
+ /*  1590 */   956,  358,  371,  258,  956,  956,  956,  956,  956,  956,
+ /*  1600 */   956,  956,  956,  956,  956,  956,  956,  956,  956,  210,
 };
 static const YYCODETYPE yy_lookahead[] = {
- /*     0 */    19,   25,  222,  223,  224,   24,    1,   26,   76,   77,
- /*    10 */    78,   79,   80,   81,   82,   83,   84,   85,   86,   87,
- /*    20 */    88,   89,   90,   91,  115,   22,   26,   27,  248,   26,
- /*    30 */    49,   50,   76,   77,   78,   79,  127,   81,   82,   83,
- /*    40 */    84,   85,   86,   87,   88,   89,   90,   91,   67,   68,
- /*    50 */    69,   70,   71,   72,   73,   74,   75,   76,   77,   78,
- /*    60 */    79,   15,   81,   82,   83,   84,   85,   86,   87,   88,
- /*    70 */    89,   90,   91,   19,   93,   16,   19,  150,  102,   25,
- /*    80 */    81,   82,   83,   84,   85,   86,   87,   88,   89,   90,
- /*    90 */    91,   19,  165,   93,   94,   95,   93,   23,   98,   99,
- /*   100 */   100,  174,  175,   49,   50,  104,  105,  106,   54,  109,
- /*   110 */     7,    8,   85,   86,   87,   88,   89,   90,   91,   60,
- /*   120 */    61,   67,   68,   69,   70,   71,   72,   73,   74,   75,
- /*   130 */    76,   77,   78,   79,   22,   81,   82,   83,   84,   85,
- /*   140 */    86,   87,   88,   89,   90,   91,   19,  111,   91,  113,
- /*   150 */   114,   24,   95,   96,   97,   98,   99,  100,  101,   65,
- /*   160 */   150,   25,  235,   91,  150,  108,   96,   97,   96,   97,
- /*   170 */    98,   99,  100,  101,  112,  165,   49,   50,   95,  165,
- /*   180 */   108,   98,   99,  100,  174,  175,  197,   93,  174,  175,
- /*   190 */    22,   97,  109,  204,   67,   68,   69,   70,   71,   72,
- /*   200 */    73,   74,   75,   76,   77,   78,   79,   11,   81,   82,
- /*   210 */    83,   84,   85,   86,   87,   88,   89,   90,   91,   19,
- /*   220 */    22,  117,  128,  129,  130,  215,   97,  150,  214,  215,
- /*   230 */   166,   95,  146,  147,   98,   99,  100,  108,  152,  150,
- /*   240 */   154,  150,  165,   75,  112,  109,  160,  117,  116,   49,
- /*   250 */    50,  174,  175,   57,  165,  163,  165,   22,  166,  167,
- /*   260 */   168,   26,   27,  174,  175,  174,  175,   67,   68,   69,
- /*   270 */    70,   71,   72,   73,   74,   75,   76,   77,   78,   79,
- /*   280 */   194,   81,   82,   83,   84,   85,   86,   87,   88,   89,
- /*   290 */    90,   91,   19,  216,  117,  150,  232,  233,  221,   30,
- /*   300 */   104,  105,  106,   34,  218,  216,  161,  162,  117,  150,
- /*   310 */   165,  115,  150,   25,  228,  155,   22,   48,  120,  160,
- /*   320 */    26,   27,   49,   50,  165,  234,  235,  165,   93,   94,
- /*   330 */   185,  186,  117,  174,  175,  135,  174,  175,   26,   27,
- /*   340 */    67,   68,   69,   70,   71,   72,   73,   74,   75,   76,
- /*   350 */    77,   78,   79,  194,   81,   82,   83,   84,   85,   86,
- /*   360 */    87,   88,   89,   90,   91,   19,  150,  128,  129,   23,
- /*   370 */     7,    8,    9,   26,   27,  216,  160,   12,  216,   22,
- /*   380 */   221,  165,   94,  221,   26,   27,   26,   93,   94,  229,
- /*   390 */   174,  175,  160,   28,   50,   49,   50,  150,  238,   87,
- /*   400 */    87,   88,   89,   90,   91,   93,   94,  119,  135,   44,
- /*   410 */   194,   46,  165,   67,   68,   69,   70,   71,   72,   73,
- /*   420 */    74,   75,   76,   77,   78,   79,  194,   81,   82,   83,
- /*   430 */    84,   85,   86,   87,   88,   89,   90,   91,   19,   23,
- /*   440 */    93,   94,   23,   23,   23,   25,  150,  103,   23,  150,
- /*   450 */   218,   93,   94,   93,  158,  150,   22,  161,  162,   23,
- /*   460 */   150,  165,   23,   11,  165,   23,  119,   25,   49,   50,
- /*   470 */   165,  239,   57,  174,  175,  165,  244,  119,   16,  174,
- /*   480 */   175,   26,   27,  160,  174,  175,   67,   68,   69,   70,
- /*   490 */    71,   72,   73,   74,   75,   76,   77,   78,   79,   22,
- /*   500 */    81,   82,   83,   84,   85,   86,   87,   88,   89,   90,
- /*   510 */    91,   19,   23,   12,   23,   23,   25,  194,   32,  104,
- /*   520 */   105,  106,   60,   61,  225,  150,  216,   41,   23,   28,
- /*   530 */   115,   25,  111,  166,  113,  114,  111,   25,  113,  114,
- /*   540 */   165,   49,   50,  220,   24,   44,   26,   46,   93,   94,
- /*   550 */   111,   23,  113,  114,  169,  170,  171,   23,   57,   67,
- /*   560 */    68,   69,   70,   71,   72,   73,   74,   75,   76,   77,
- /*   570 */    78,   79,  205,   81,   82,   83,   84,   85,   86,   87,
- /*   580 */    88,   89,   90,   91,   19,   94,   19,   25,   23,  222,
- /*   590 */   223,  224,  217,  169,  170,  171,   36,  150,  165,  137,
- /*   600 */   111,   35,  113,  114,    0,    1,    2,  174,  161,  162,
- /*   610 */   119,   51,  165,   93,   49,   50,   21,   50,   58,  181,
- /*   620 */   182,  236,  222,  223,  224,  160,  188,  142,  143,  144,
- /*   630 */   145,  125,   67,   68,   69,   70,   71,   72,   73,   74,
- /*   640 */    75,   76,   77,   78,   79,   25,   81,   82,   83,   84,
- /*   650 */    85,   86,   87,   88,   89,   90,   91,   19,  150,  194,
- /*   660 */   236,  150,   24,  144,  145,  150,   87,  107,   35,  160,
- /*   670 */   103,  206,  207,  165,  119,  108,  165,  104,  105,  106,
- /*   680 */   165,   23,   22,   25,  160,  174,  175,   49,   50,  174,
- /*   690 */   175,  112,  190,  191,   99,  116,  166,  167,  168,   35,
- /*   700 */    23,  193,   25,  194,  160,   67,   68,   69,   70,   71,
- /*   710 */    72,   73,   74,   75,   76,   77,   78,   79,  194,   81,
- /*   720 */    82,   83,   84,   85,   86,   87,   88,   89,   90,   91,
- /*   730 */    19,  150,  137,  150,  150,   96,  150,  173,  194,   23,
- /*   740 */    22,   25,  218,  172,  173,  181,  165,  150,  165,  165,
- /*   750 */   150,  165,  181,   25,  115,  174,  175,  249,  174,  175,
- /*   760 */    49,   50,  165,   52,  220,  165,  127,   23,  244,   25,
- /*   770 */   187,  174,  175,  187,  174,  175,  206,  207,   67,   68,
- /*   780 */    69,   70,   71,   72,   73,   74,   75,   76,   77,   78,
- /*   790 */    79,  150,   81,   82,   83,   84,   85,   86,   87,   88,
- /*   800 */    89,   90,   91,   19,  150,  150,  165,  150,   23,   19,
- /*   810 */    25,  150,  150,   19,  117,  174,  175,   27,   27,  165,
- /*   820 */   165,   27,  165,  150,  150,   23,  165,  165,  174,  175,
- /*   830 */   112,  174,  175,   49,   50,  174,  175,   23,  165,  165,
- /*   840 */    39,  134,  187,  136,  160,   52,  118,  174,  175,  187,
- /*   850 */    22,   67,   68,   69,   70,   71,   72,   73,   74,   75,
- /*   860 */    76,   77,   78,   79,  150,   81,   82,   83,   84,   85,
- /*   870 */    86,   87,   88,   89,   90,   91,   19,  150,  194,  165,
- /*   880 */   150,  160,   29,  150,  150,  150,   52,  213,  174,  175,
- /*   890 */    85,   86,  165,  150,   23,  165,   25,  150,  165,  165,
- /*   900 */   165,  174,  175,   22,  174,  175,   49,   50,  165,  174,
- /*   910 */   175,   23,  165,   25,   23,  194,  166,  174,  175,   22,
- /*   920 */   187,  174,  175,   22,   67,   68,   69,   70,   71,   72,
- /*   930 */    73,   74,   75,   76,   77,   78,   79,  150,   81,   82,
- /*   940 */    83,   84,   85,   86,   87,   88,   89,   90,   91,   19,
- /*   950 */   150,  217,  165,  150,   23,  205,   25,  150,   22,   52,
- /*   960 */    24,  174,  175,  190,  191,  165,    1,    2,  165,   22,
- /*   970 */   150,  150,  165,  150,  150,   49,   50,  174,  175,   49,
- /*   980 */    50,  174,  175,  108,  101,  165,  165,   19,  165,  165,
- /*   990 */    90,   91,   20,  193,  174,  175,   70,   71,   68,   69,
- /*  1000 */    70,   71,   72,   73,   74,   75,   76,   77,   78,   79,
- /*  1010 */   150,   81,   82,   83,   84,   85,   86,   87,   88,   89,
- /*  1020 */    90,   91,   19,   97,  150,  165,  150,  150,   24,   43,
- /*  1030 */   150,  103,  150,   59,  174,  175,  213,   53,   53,  165,
- /*  1040 */   137,  165,  165,  150,  150,  165,  150,  165,  174,  175,
- /*  1050 */   174,  175,   49,   50,  174,  175,   25,    5,  165,  165,
- /*  1060 */   103,  165,    1,  117,   35,   27,  245,  174,  175,  245,
- /*  1070 */   174,  175,   69,   70,   71,   72,   73,   74,   75,   76,
- /*  1080 */    77,   78,   79,  107,   81,   82,   83,   84,   85,   86,
- /*  1090 */    87,   88,   89,   90,   91,   19,   20,   75,   22,   23,
- /*  1100 */   150,  166,   26,   27,  150,  166,  126,  213,   75,   19,
- /*  1110 */    20,  150,   22,   37,   22,  165,   26,   27,   22,  165,
- /*  1120 */    25,  150,  245,  150,  174,  175,  165,   37,  174,  175,
- /*  1130 */    23,   20,   56,  107,  118,  118,  165,  150,  165,  150,
- /*  1140 */   205,   65,    1,   22,  205,  150,   56,  174,  175,  126,
- /*  1150 */    23,  150,  165,   25,  165,   65,  150,  127,   75,  150,
- /*  1160 */   165,   85,   86,  150,  193,  150,  165,   16,   92,   93,
- /*  1170 */    94,  165,   96,   97,  165,   85,   86,  150,  165,  103,
- /*  1180 */   165,  105,   92,   93,   94,  150,   96,   97,  193,  174,
- /*  1190 */   175,   75,  165,  103,  193,  105,  150,  150,  150,  193,
- /*  1200 */   165,  174,  175,   64,  128,  129,  130,  131,  132,  133,
- /*  1210 */    22,  165,  165,  165,   26,   27,   15,  140,  128,  129,
- /*  1220 */   130,  131,  132,  133,   19,   20,  213,   22,  193,  150,
- /*  1230 */   150,   26,   27,    3,  164,    4,  180,  150,  180,  193,
- /*  1240 */   193,  150,   37,  150,  165,  165,  149,   19,   20,  150,
- /*  1250 */    22,  150,  165,   65,   26,   27,  165,  149,  165,    6,
- /*  1260 */   151,   56,  150,  150,  165,   37,  165,  174,  175,  149,
- /*  1270 */    65,  149,   25,   85,   86,  174,  175,  165,  165,  150,
- /*  1280 */   150,   93,   13,  151,   56,   97,  115,  174,  175,  125,
- /*  1290 */    85,   86,   87,   65,  165,  165,  150,   92,   93,   94,
- /*  1300 */   194,  159,   97,  174,  175,  200,  122,  121,  123,  199,
- /*  1310 */   226,  165,  150,   85,   86,  150,  128,  129,  130,  201,
- /*  1320 */    92,   93,   94,  124,  150,   97,  150,  165,  202,  150,
- /*  1330 */   165,  134,  150,  128,  129,  130,  131,  132,  133,  165,
- /*  1340 */   150,  165,  117,  115,  165,   19,   20,  165,   22,  157,
- /*  1350 */   174,  175,   26,   27,  210,  165,  128,  129,  130,  131,
- /*  1360 */   132,  133,  150,   37,  174,  175,  150,  157,   19,   20,
- /*  1370 */   150,   22,  150,  150,  150,   26,   27,  165,  203,  103,
- /*  1380 */   211,  165,   56,  210,  120,  165,   37,  165,  165,  165,
- /*  1390 */   210,   65,  150,  150,  174,  175,  174,  175,  174,  175,
- /*  1400 */   150,  150,  150,  176,  211,   56,  150,  165,  165,  150,
- /*  1410 */   103,   85,   86,  150,   65,  165,  165,  165,   92,   93,
- /*  1420 */    94,  165,  211,   97,  165,  174,  175,   47,  165,  150,
- /*  1430 */   174,  175,  150,  176,   85,   86,  150,  176,  150,  184,
- /*  1440 */   178,   92,   93,   94,  165,  102,   97,  165,  150,  176,
- /*  1450 */   179,  165,   22,  165,  128,  129,  130,  131,  132,  133,
- /*  1460 */     5,   91,  184,  165,  231,   10,   11,   12,   13,   14,
- /*  1470 */   231,  176,   17,  176,  156,  176,   18,  128,  129,  130,
- /*  1480 */   131,  132,  133,  179,  157,  156,   31,  157,   33,  156,
- /*  1490 */   242,  157,  157,   45,  134,  156,   67,   42,  157,  189,
- /*  1500 */   189,  243,  219,   22,  199,  192,   18,  192,  192,  192,
- /*  1510 */    55,  199,   57,  189,  230,  219,  138,  247,   63,  157,
- /*  1520 */    40,  247,  157,  157,   38,  250,  153,  196,  237,  166,
- /*  1530 */   198,  237,  177,  227,  177,  177,  182,  209,  177,  246,
- /*  1540 */   166,  177,  166,  199,  199,  178,  246,  209,  166,  209,
- /*  1550 */   166,  166,  148,  166,  208,  196,   91,  186,  186,  104,
- /*  1560 */   105,  106,  240,  195,  241,  110,  191,  174,  174,  183,
- /*  1570 */   115,  183,  183,  251,  251,  251,  251,  251,  251,  251,
- /*  1580 */   251,  251,  251,  251,  251,  251,  251,  251,  251,  251,
- /*  1590 */   251,  251,  251,  251,  139,
+ /*     0 */    21,    1,  223,  224,  225,   26,   17,   28,   77,   78,
+ /*    10 */    79,   80,   81,   82,   83,   84,   85,   86,   87,   88,
+ /*    20 */    89,   90,   91,   92,   98,   24,   28,   29,  249,   50,
+ /*    30 */    51,   77,   78,   79,   80,  109,   82,   83,   84,   85,
+ /*    40 */    86,   87,   88,   89,   90,   91,   92,   68,   69,   70,
+ /*    50 */    71,   72,   73,   74,   75,   76,   77,   78,   79,   80,
+ /*    60 */    18,   82,   83,   84,   85,   86,   87,   88,   89,   90,
+ /*    70 */    91,   92,   21,   94,   25,   21,   27,   21,   27,   82,
+ /*    80 */    83,   84,   85,   86,   87,   88,   89,   90,   91,   92,
+ /*    90 */    21,  118,   94,   95,   96,   25,  113,   99,  100,  101,
+ /*   100 */   117,   50,   51,   61,   62,  156,   55,   51,  110,   86,
+ /*   110 */    87,   88,   89,   90,   91,   92,    9,   10,   11,   68,
+ /*   120 */    69,   70,   71,   72,   73,   74,   75,   76,   77,   78,
+ /*   130 */    79,   80,   24,   82,   83,   84,   85,   86,   87,   88,
+ /*   140 */    89,   90,   91,   92,   21,    3,   92,    5,    6,   26,
+ /*   150 */    96,   97,   98,   99,  100,  101,  102,   27,    9,   10,
+ /*   160 */   104,   92,  151,  109,   21,  109,   97,   98,   99,  100,
+ /*   170 */   101,  102,   29,   50,   51,  147,  148,  166,  109,  230,
+ /*   180 */   138,  153,  112,  155,  114,  115,  175,  176,  239,  161,
+ /*   190 */    66,   68,   69,   70,   71,   72,   73,   74,   75,   76,
+ /*   200 */    77,   78,   79,   80,   13,   82,   83,   84,   85,   86,
+ /*   210 */    87,   88,   89,   90,   91,   92,   21,  151,   94,  151,
+ /*   220 */   118,  113,   98,  195,  151,   14,   96,  151,  217,   99,
+ /*   230 */   100,  101,  166,  222,  166,  162,  163,   97,   98,  166,
+ /*   240 */   110,   30,  166,  175,  176,   50,   51,  219,   25,   58,
+ /*   250 */    27,  175,  176,  129,  130,  131,   45,  229,   47,  186,
+ /*   260 */   187,  151,   58,   68,   69,   70,   71,   72,   73,   74,
+ /*   270 */    75,   76,   77,   78,   79,   80,  166,   82,   83,   84,
+ /*   280 */    85,   86,   87,   88,   89,   90,   91,   92,   21,   25,
+ /*   290 */    24,  215,  216,   97,  226,   24,  105,  106,  107,   28,
+ /*   300 */    29,  151,   28,   29,  151,   88,  151,  116,  151,  105,
+ /*   310 */   106,  107,  116,   25,  161,   27,  166,   50,   51,  166,
+ /*   320 */   116,  166,   24,  166,  128,  175,  176,  118,  175,  176,
+ /*   330 */   113,  136,  175,  176,  117,   68,   69,   70,   71,   72,
+ /*   340 */    73,   74,   75,   76,   77,   78,   79,   80,  195,   82,
+ /*   350 */    83,   84,   85,   86,   87,   88,   89,   90,   91,   92,
+ /*   360 */    21,  151,  161,   25,   25,   94,   95,  217,   94,   95,
+ /*   370 */   217,  161,  222,  218,   96,  222,  166,   99,  100,  101,
+ /*   380 */    28,   29,   28,   29,   25,  175,  176,  121,  110,   50,
+ /*   390 */    51,  118,  235,  236,  120,  164,  195,   24,  167,  168,
+ /*   400 */   169,   28,   29,  136,   25,  195,   27,   68,   69,   70,
+ /*   410 */    71,   72,   73,   74,   75,   76,   77,   78,   79,   80,
+ /*   420 */   167,   82,   83,   84,   85,   86,   87,   88,   89,   90,
+ /*   430 */    91,   92,   21,    0,    1,    2,   25,   88,   89,   90,
+ /*   440 */    91,   92,   88,  151,   50,   51,   94,   95,   94,   95,
+ /*   450 */   112,  159,  114,  115,  162,  163,   24,   27,  166,  206,
+ /*   460 */    28,   50,   51,  182,  183,   71,   72,   94,   95,  118,
+ /*   470 */   189,  112,  120,  114,  115,  113,  223,  224,  225,   68,
+ /*   480 */    69,   70,   71,   72,   73,   74,   75,   76,   77,   78,
+ /*   490 */    79,   80,   98,   82,   83,   84,   85,   86,   87,   88,
+ /*   500 */    89,   90,   91,   92,   21,   14,  161,   25,   25,   25,
+ /*   510 */    24,   27,  151,   25,  170,  171,  172,  151,  129,  130,
+ /*   520 */   151,   30,  151,  162,  163,   95,   94,  166,  170,  171,
+ /*   530 */   172,   51,  166,   50,   51,  166,   45,  166,   47,   24,
+ /*   540 */   195,  175,  176,   25,  175,  176,  175,  176,   13,   58,
+ /*   550 */   120,   68,   69,   70,   71,   72,   73,   74,   75,   76,
+ /*   560 */    77,   78,   79,   80,  219,   82,   83,   84,   85,   86,
+ /*   570 */    87,   88,   89,   90,   91,   92,   21,  151,   37,   95,
+ /*   580 */    25,  237,  216,  167,  104,  240,  217,   26,  217,   28,
+ /*   590 */   245,   76,  166,   52,  112,  237,  114,  115,   28,   29,
+ /*   600 */    59,  175,  176,   24,  120,   50,   51,  207,  208,  143,
+ /*   610 */   144,  145,  146,  105,  106,  107,   18,  105,  106,  107,
+ /*   620 */   161,   28,  206,   68,   69,   70,   71,   72,   73,   74,
+ /*   630 */    75,   76,   77,   78,   79,   80,  151,   82,   83,   84,
+ /*   640 */    85,   86,   87,   88,   89,   90,   91,   92,   21,  108,
+ /*   650 */   161,  166,   27,   26,  195,   94,  151,  167,  151,   61,
+ /*   660 */    62,  151,  236,   27,   94,   95,  207,  208,  223,  224,
+ /*   670 */   225,  166,  112,  166,  114,  115,  166,   50,   51,  194,
+ /*   680 */   175,  176,  175,  176,  195,  175,  176,   94,  167,  168,
+ /*   690 */   169,  161,   25,   27,   27,   68,   69,   70,   71,   72,
+ /*   700 */    73,   74,   75,   76,   77,   78,   79,   80,  219,   82,
+ /*   710 */    83,   84,   85,   86,   87,   88,   89,   90,   91,   92,
+ /*   720 */    21,   23,  151,  233,  234,  195,  151,   27,   32,  151,
+ /*   730 */    25,   35,   27,  151,  245,  250,   25,  166,   27,   27,
+ /*   740 */   151,  166,  145,  146,  166,   49,  175,  176,  166,   50,
+ /*   750 */    51,  221,   53,  175,  176,  166,   25,  175,  176,   24,
+ /*   760 */   161,   26,  126,  188,  175,  176,   36,   68,   69,   70,
+ /*   770 */    71,   72,   73,   74,   75,   76,   77,   78,   79,   80,
+ /*   780 */   151,   82,   83,   84,   85,   86,   87,   88,   89,   90,
+ /*   790 */    91,   92,   21,  151,  195,  166,  151,   25,  100,  151,
+ /*   800 */    25,  151,   27,  103,  175,  176,  173,  174,  166,  191,
+ /*   810 */   192,  166,  151,  151,  166,  182,  166,  175,  176,  151,
+ /*   820 */   221,   50,   51,  175,  176,  175,  176,  166,  166,   25,
+ /*   830 */   135,  119,  137,  188,  166,   27,  138,  175,  176,   68,
+ /*   840 */    69,   70,   71,   72,   73,   74,   75,   76,   77,   78,
+ /*   850 */    79,   80,  151,   82,   83,   84,   85,   86,   87,   88,
+ /*   860 */    89,   90,   91,   92,   21,  151,  151,  166,  151,  151,
+ /*   870 */    33,  151,   25,  151,   27,  214,  175,  176,   36,   42,
+ /*   880 */   166,  166,  214,  166,  166,  151,  166,  151,  166,  175,
+ /*   890 */   176,  198,  151,   50,   51,  175,  176,   25,  205,   27,
+ /*   900 */   166,  120,  166,  188,   24,  188,   36,  166,   29,  175,
+ /*   910 */   176,   68,   69,   70,   71,   72,   73,   74,   75,   76,
+ /*   920 */    77,   78,   79,   80,  151,   82,   83,   84,   85,   86,
+ /*   930 */    87,   88,   89,   90,   91,   92,   21,  151,  151,  166,
+ /*   940 */   151,  118,   21,  151,   25,  151,  191,  192,  175,  176,
+ /*   950 */    29,   25,  166,  166,   40,  166,  151,  151,  166,  218,
+ /*   960 */   166,  175,  176,  151,  246,   50,   51,  175,  176,  175,
+ /*   970 */   176,  166,  166,   91,   92,  188,   86,   87,  166,  161,
+ /*   980 */   175,  176,  246,  194,   69,   70,   71,   72,   73,   74,
+ /*   990 */    75,   76,   77,   78,   79,   80,  151,   82,   83,   84,
+ /*  1000 */    85,   86,   87,   88,   89,   90,   91,   92,   21,  151,
+ /*  1010 */   151,  166,  151,  195,  161,  151,  151,  151,    1,    2,
+ /*  1020 */   175,  176,   53,   24,  166,  166,  214,  166,  151,  167,
+ /*  1030 */   166,  166,  166,  175,  176,  151,  151,   50,   51,  175,
+ /*  1040 */   176,  175,  176,  166,   31,   53,   25,  166,  195,   24,
+ /*  1050 */   166,  166,  175,  176,  167,  194,  175,   70,   71,   72,
+ /*  1060 */    73,   74,   75,   76,   77,   78,   79,   80,  206,   82,
+ /*  1070 */    83,   84,   85,   86,   87,   88,   89,   90,   91,   92,
+ /*  1080 */    21,   22,  174,   24,   25,  151,  151,   28,   29,  151,
+ /*  1090 */   182,  151,  151,  206,   53,   21,   22,   38,   24,  214,
+ /*  1100 */   166,  166,   28,   29,  166,  246,  166,  166,  151,  175,
+ /*  1110 */   176,  151,   38,  175,  176,  151,   57,   24,   24,  151,
+ /*  1120 */    24,  151,  151,  166,  151,   66,  166,  151,  102,  194,
+ /*  1130 */   166,   57,  175,  176,  166,  194,  166,  166,  116,  166,
+ /*  1140 */    66,  109,  166,  175,  176,   86,   87,  151,   21,   26,
+ /*  1150 */   128,  151,   93,   94,   95,  104,   97,   98,  151,   22,
+ /*  1160 */    86,   87,  166,  104,  194,  106,  166,   93,   94,   95,
+ /*  1170 */    24,   97,   98,  166,   28,   29,   44,   60,  104,   54,
+ /*  1180 */   106,  151,  175,  176,  151,  151,   27,  138,  129,  130,
+ /*  1190 */   131,  132,  133,  134,   21,   22,  166,   24,   54,  166,
+ /*  1200 */   166,   28,   29,  129,  130,  131,  132,  133,  134,  175,
+ /*  1210 */   176,   38,   66,  151,  151,  104,  151,   21,   22,    7,
+ /*  1220 */    24,  151,   36,    1,   28,   29,  151,  194,  166,  166,
+ /*  1230 */    57,  166,   86,   87,   38,   29,  166,  175,  176,   66,
+ /*  1240 */    94,  166,  118,  151,   98,  175,  176,  108,  151,  151,
+ /*  1250 */   175,  176,   76,   57,  151,  151,   76,  194,  166,   86,
+ /*  1260 */    87,   88,   66,  166,  166,  151,   93,   94,   95,  166,
+ /*  1270 */   166,   98,  175,  176,   24,  129,  130,  131,  175,  176,
+ /*  1280 */   166,  151,   86,   87,  151,  151,  151,  127,   27,   93,
+ /*  1290 */    94,   95,  194,   24,   98,   25,  166,  119,  151,  166,
+ /*  1300 */   166,  166,  129,  130,  131,  132,  133,  134,  175,  176,
+ /*  1310 */   175,  176,  116,  166,   22,    1,   21,   22,  119,   24,
+ /*  1320 */   127,  151,  108,   28,   29,  129,  130,  131,  132,  133,
+ /*  1330 */   134,   24,  151,   38,   21,   22,  166,   24,  128,   27,
+ /*  1340 */   151,   28,   29,  151,   25,  175,  176,  166,  151,   76,
+ /*  1350 */    76,   38,   57,   18,  151,  166,  175,  176,  166,  151,
+ /*  1360 */   151,   66,  151,  166,  175,  176,   65,  175,  176,  166,
+ /*  1370 */    57,   17,  151,  141,  166,  166,  151,  166,    4,   66,
+ /*  1380 */   151,   86,   87,  175,  176,  165,  151,  166,   93,   94,
+ /*  1390 */    95,  166,  150,   98,  181,  166,  181,  151,  151,   86,
+ /*  1400 */    87,  166,  151,  151,    8,  150,   93,   94,   95,  150,
+ /*  1410 */   150,   98,  166,  166,  152,   15,  152,  166,  166,   27,
+ /*  1420 */   116,  195,  126,  160,  129,  130,  131,  132,  133,  134,
+ /*  1430 */   200,  123,  201,  124,  227,  202,  125,  203,  122,  158,
+ /*  1440 */   204,  135,  129,  130,  131,  132,  133,  134,  118,    6,
+ /*  1450 */     7,  158,  211,  104,  121,   12,   13,   14,   15,   16,
+ /*  1460 */   212,  212,   19,  177,  211,  211,  104,  177,  212,  185,
+ /*  1470 */    48,  177,  103,   24,   92,  177,  179,   34,  157,  180,
+ /*  1480 */   177,   20,  177,  158,  157,  185,   43,  177,  157,  232,
+ /*  1490 */   232,   46,  158,  135,  158,  180,  158,  157,   68,   56,
+ /*  1500 */   158,   58,  220,   24,   20,  220,  231,   64,  243,  139,
+ /*  1510 */   244,  193,  190,  190,  190,  158,  248,  200,   41,  193,
+ /*  1520 */   200,  193,  193,  158,  248,  158,   39,  154,  251,  197,
+ /*  1530 */   167,  178,  149,  178,  178,  183,  199,  178,  167,  178,
+ /*  1540 */   238,  252,  167,  179,  167,  200,  167,  167,  105,  106,
+ /*  1550 */   107,  200,  167,  210,  111,   92,  196,  210,  210,  116,
+ /*  1560 */   252,  252,  184,  197,  175,  184,  175,  252,  192,  228,
+ /*  1570 */   184,  187,  252,  252,  187,  252,  252,  238,  252,  252,
+ /*  1580 */   252,  209,  252,  140,  252,  252,  252,  252,  252,  252,
+ /*  1590 */   252,  247,  242,  247,  252,  252,  252,  252,  252,  252,
+ /*  1600 */   252,  252,  252,  252,  252,  252,  252,  252,  252,  241,
 };
-#define YY_SHIFT_USE_DFLT (-92)
+#define YY_SHIFT_USE_DFLT (-75)
 #define YY_SHIFT_COUNT (419)
-#define YY_SHIFT_MIN   (-91)
-#define YY_SHIFT_MAX   (1488)
+#define YY_SHIFT_MIN   (-74)
+#define YY_SHIFT_MAX   (1487)
 static const short yy_shift_ofst[] = {
- /*     0 */   965, 1228, 1455, 1076, 1228, 1326, 1326, 1326,    0,  -19,
- /*    10 */  1090, 1326, 1326, 1326, 1326,  415,  455,  711, 1205, 1326,
- /*    20 */  1326, 1326, 1326, 1326, 1326, 1326, 1326, 1326, 1326, 1326,
- /*    30 */  1326, 1326, 1326, 1326, 1326, 1326, 1326, 1326, 1326, 1326,
- /*    40 */  1326, 1326, 1326, 1326, 1326, 1326, 1326, 1349, 1326, 1326,
- /*    50 */  1326, 1326, 1326, 1326, 1326, 1326, 1326, 1326, 1326, 1326,
- /*    60 */  1326, 1326,  196,  455,  455,  805,  805,  360, 1171,   54,
- /*    70 */   638,  565,  492,  419,  346,  273,  200,  127,  784,  784,
- /*    80 */   784,  784,  784,  784,  784,  784,  784,  784,  784,  784,
- /*    90 */   784,  784,  784,  784,  784,  784,  857,  784,  930, 1003,
- /*   100 */  1003,  -68,  -44,  -44,  -44,  -44,  -44,  -44,   -1,   57,
- /*   110 */    27,  313,  455,  455,  455,  455,  455,  455,  455,  455,
- /*   120 */   455,  455,  455,  455,  455,  455,  455,  455,  455,  567,
- /*   130 */   455,  455,  455,  455,  455,  639,  595,  360,  -91,  360,
- /*   140 */   900, 1465,  -92,  -92,  -92, 1188,   72,  501,  501,  312,
- /*   150 */   294,  358,  347,  235,  455,  455,  455,  455,  455,  455,
- /*   160 */   455,  455,  455,  455,  455,  455,  455,  455,  455,  455,
- /*   170 */   455,  455,  455,  455,  455,  455,  455,  455,  455,  455,
- /*   180 */   455,  455,  455,  455,  520,  520,  520,  604, 1171, 1171,
- /*   190 */  1171,  -92,  -92,  136,   94,   94,   83,  560,  560,  560,
- /*   200 */   491,  489,  365,  439,  425,  421,   36,   36,   36,   36,
- /*   210 */   573,  269,   36,   36,  288,    3,  579,  363,  360,  360,
- /*   220 */   360,  506,  790,  790,  794,  506,  794,  -24,  360,  486,
- /*   230 */   360,  486,  344,  486,  790,  486,  486,  707,  239,  239,
- /*   240 */   360,  728,  132,  936, 1486, 1225, 1225, 1480, 1480, 1225,
- /*   250 */  1378, 1481, 1429, 1164, 1488, 1488, 1488, 1488, 1164, 1481,
- /*   260 */  1429, 1429, 1225, 1458, 1360, 1448, 1225, 1225, 1458, 1225,
- /*   270 */  1458, 1225, 1458, 1430, 1307, 1307, 1307, 1380, 1370, 1370,
- /*   280 */  1430, 1307, 1343, 1307, 1380, 1307, 1307, 1264, 1276, 1264,
- /*   290 */  1276, 1264, 1276, 1225, 1225, 1197, 1199, 1186, 1185, 1184,
- /*   300 */  1164, 1171, 1247, 1269, 1269, 1253, 1253, 1253, 1253,  -92,
- /*   310 */   -92,  -92,  926,  462,   59,    1,  931,  168,  888,  718,
- /*   320 */   871,  198,  785,  744,  716,  677,  658,   70,  103,  129,
- /*   330 */   442,  420, 1231, 1230, 1077, 1201, 1139, 1151, 1116, 1083,
- /*   340 */  1128, 1127, 1121, 1030, 1095, 1023, 1026, 1017, 1111, 1141,
- /*   350 */  1016, 1107, 1096, 1095, 1092,  980, 1033, 1022,  976, 1038,
- /*   360 */  1029,  946, 1061, 1052,  957,  903,  985, 1031,  984,  974,
- /*   370 */   986,  928, 1004,  972,  968,  875,  883,  947,  907,  901,
- /*   380 */   897,  891,  881,  834,  853,  828,  793,  801,  814,  802,
- /*   390 */   697,  791,  664,  660,  555,  562,  633,  620,  566,  562,
- /*   400 */   534,  528,  512,  505,  477,  452,  434,  436,  416,  357,
- /*   410 */    62,  215,  191,  177,  130,  104,  112,   74,   46,    5,
+ /*     0 */  1017, 1196, 1443, 1059, 1196, 1295, 1295, 1295,   -2,  -21,
+ /*    10 */  1074, 1295, 1295, 1295, 1295,  204,  570,  699, 1173, 1295,
+ /*    20 */  1295, 1295, 1295, 1295, 1295, 1295, 1295, 1295, 1295, 1295,
+ /*    30 */  1295, 1295, 1295, 1295, 1295, 1295, 1295, 1295, 1295, 1295,
+ /*    40 */  1295, 1295, 1295, 1295, 1295, 1295, 1295, 1313, 1295, 1295,
+ /*    50 */  1295, 1295, 1295, 1295, 1295, 1295, 1295, 1295, 1295, 1295,
+ /*    60 */  1295, 1295,  191,  570,  570,  890,  890,  593, 1304,   51,
+ /*    70 */   627,  555,  483,  411,  339,  267,  195,  123,  771,  771,
+ /*    80 */   771,  771,  771,  771,  771,  771,  771,  771,  771,  771,
+ /*    90 */   771,  771,  771,  771,  771,  771,  843,  771,  915,  987,
+ /*   100 */   987,  -69,  -46,  -46,  -46,  -46,  -46,  -46,   -3,   54,
+ /*   110 */    23,  349,  570,  570,  570,  570,  570,  570,  570,  570,
+ /*   120 */   570,  570,  570,  570,  570,  570,  570,  570,  570,   56,
+ /*   130 */   570,  570,  570,  570,  570,  196,  698,  593, 1022,  593,
+ /*   140 */   882, 1463,  -75,  -75,  -75, 1146,   69,  491,  491,  354,
+ /*   150 */   373,  352,  274,  271,  570,  570,  570,  570,  570,  570,
+ /*   160 */   570,  570,  570,  570,  570,  570,  570,  570,  570,  570,
+ /*   170 */   570,  570,  570,  570,  570,  570,  570,  570,  570,  570,
+ /*   180 */   570,  570,  570,  570,  561,  561,  561,  433, 1304, 1304,
+ /*   190 */  1304,  -75,  -75,  130,  124,  124,  278,  541,  541,  541,
+ /*   200 */   484,  482,  211,  359,  338,   70,  560,  560,  560,  560,
+ /*   210 */   512,  696,  560,  560,  430,  432,  217,  107,  593,  593,
+ /*   220 */   593,  636,  143,  143,  921,  636,  921,  700,  593,  837,
+ /*   230 */   593,  837,  480,  837,  143,  837,  837,  695,  389,  389,
+ /*   240 */   593,  712,  -17,  735, 1487, 1330, 1330, 1477, 1477, 1330,
+ /*   250 */  1370, 1479, 1430, 1296, 1484, 1484, 1484, 1484, 1296, 1479,
+ /*   260 */  1430, 1430, 1330, 1461, 1358, 1445, 1330, 1330, 1461, 1330,
+ /*   270 */  1461, 1330, 1461, 1449, 1362, 1362, 1362, 1422, 1382, 1382,
+ /*   280 */  1449, 1362, 1369, 1362, 1422, 1362, 1362, 1333, 1349, 1333,
+ /*   290 */  1349, 1333, 1349, 1330, 1330, 1306, 1311, 1316, 1309, 1308,
+ /*   300 */  1296, 1304, 1392, 1400, 1400, 1396, 1396, 1396, 1396,  -75,
+ /*   310 */   -75,  -75,  394,   42,  142,  598,  508,  872,  515,  847,
+ /*   320 */   108,  775,  266,  711,  705,  667,  379,  288,  140,  149,
+ /*   330 */   -74,  223,   49, 1374, 1232, 1354, 1301, 1335, 1274, 1273,
+ /*   340 */  1312, 1319, 1307, 1210, 1261, 1193, 1214, 1199, 1292, 1314,
+ /*   350 */  1178, 1270, 1269, 1261, 1250, 1160, 1180, 1176, 1139, 1206,
+ /*   360 */  1186, 1124, 1222, 1212, 1111, 1049, 1144, 1159, 1125, 1117,
+ /*   370 */  1132, 1051, 1123, 1137, 1127, 1032, 1026, 1096, 1041, 1094,
+ /*   380 */  1093, 1021, 1025,  992, 1013,  999,  969,  914,  926,  919,
+ /*   390 */   823,  879,  870,  880,  781,  666,  842,  808,  730,  666,
+ /*   400 */   804,  772,  625,  731,  579,  535,  486,  518,  488,  298,
+ /*   410 */   362,  351,  273,  209,  102,  -27,    1,  264,  -11,    0,
 };
-#define YY_REDUCE_USE_DFLT (-221)
+#define YY_REDUCE_USE_DFLT (-222)
 #define YY_REDUCE_COUNT (311)
-#define YY_REDUCE_MIN   (-220)
-#define YY_REDUCE_MAX   (1404)
+#define YY_REDUCE_MIN   (-221)
+#define YY_REDUCE_MAX   (1391)
 static const short yy_reduce_ofst[] = {
- /*     0 */   485,  159,   86,   91,  216,  162,   14,   77,  145,  367,
- /*    10 */   -73,  310,   89,   10,  299,  232,  296, -220, 1256, 1251,
- /*    20 */  1224, 1222, 1220, 1190, 1176, 1129, 1113, 1101, 1093, 1027,
- /*    30 */  1015,  973,  954,  950,  896,  893,  880,  876,  874,  860,
- /*    40 */   820,  807,  803,  787,  747,  743,  735,  730,  727,  714,
- /*    50 */   673,  661,  657,  654,  641,  600,  597,  584,  581,  515,
- /*    60 */   511,  305,  524,  447,  508,  424,  385,   92,  465,  400,
- /*    70 */   400,  400,  400,  400,  400,  400,  400,  400,  400,  400,
- /*    80 */   400,  400,  400,  400,  400,  400,  400,  400,  400,  400,
- /*    90 */   400,  400,  400,  400,  400,  400,  400,  400,  400,  400,
- /*   100 */   400,  400,  400,  400,  400,  400,  400,  400,  400,  571,
- /*   110 */   400,  400, 1013,  733, 1047,  734, 1046, 1035, 1006, 1001,
- /*   120 */   995,  971,  877,  894,  824,  375,  821,  823,  800,  438,
- /*   130 */   662,  655,  586,  583,  674,  544,  160,   64,  323,  530,
- /*   140 */   400,  400,  400,  400,  400,  433,  564,  773,  502, 1009,
- /*   150 */  1298, 1288, 1286, 1282, 1279, 1263, 1259, 1252, 1250, 1243,
- /*   160 */  1242, 1223, 1216, 1212, 1182, 1179, 1174, 1165, 1162, 1146,
- /*   170 */  1130, 1112, 1099, 1091, 1087, 1080, 1079, 1048, 1009,  989,
- /*   180 */   987,  961,  882,  247,  939,  935,  750,  519,  721,  684,
- /*   190 */   509,  570,  -11, 1372, 1394, 1393, 1371, 1389, 1388, 1386,
- /*   200 */  1346, 1368, 1375, 1368, 1368, 1368, 1368, 1368, 1368, 1368,
- /*   210 */  1323, 1322, 1368, 1368, 1346, 1387, 1359, 1404, 1385, 1384,
- /*   220 */  1382, 1345, 1340, 1338, 1300, 1344, 1293, 1367, 1376, 1364,
- /*   230 */  1374, 1361, 1354, 1358, 1328, 1357, 1355, 1306, 1294, 1291,
- /*   240 */  1363, 1332, 1331, 1373, 1275, 1366, 1365, 1274, 1270, 1362,
- /*   250 */  1284, 1296, 1324, 1312, 1317, 1316, 1315, 1313, 1305, 1283,
- /*   260 */  1311, 1310, 1341, 1339, 1258, 1248, 1335, 1334, 1333, 1330,
- /*   270 */  1329, 1327, 1318, 1304, 1299, 1297, 1295, 1278, 1239, 1233,
- /*   280 */  1271, 1273, 1262, 1261, 1255, 1257, 1227, 1211, 1180, 1193,
- /*   290 */  1173, 1169, 1144, 1210, 1192, 1084, 1175, 1126, 1118, 1105,
- /*   300 */  1110, 1106, 1142, 1132, 1109, 1122, 1120, 1108, 1097, 1058,
- /*   310 */  1056, 1070,
+ /*     0 */   466,  153,   28,  157,  210,  150,   76,   11,   73,  253,
+ /*    10 */   426,  371,  369,  366,   68,  345,  292, -221, 1208, 1192,
+ /*    20 */  1189, 1181, 1170, 1135, 1133, 1103, 1097, 1075, 1070, 1062,
+ /*    30 */  1034, 1007,  968,  957,  938,  934,  877,  866,  864,  858,
+ /*    40 */   845,  805,  794,  792,  786,  773,  734,  720,  714,  701,
+ /*    50 */   662,  650,  648,  642,  629,  589,  582,  578,  571,  510,
+ /*    60 */   507,  505,  489,  361,  485,  358,  344,  231,  459,  445,
+ /*    70 */   445,  445,  445,  445,  445,  445,  445,  445,  445,  445,
+ /*    80 */   445,  445,  445,  445,  445,  445,  445,  445,  445,  445,
+ /*    90 */   445,  445,  445,  445,  445,  445,  445,  445,  445,  445,
+ /*   100 */   445,  445,  445,  445,  445,  445,  445,  445,  445,  633,
+ /*   110 */   445,  445,  885,  787, 1098,  741, 1063, 1033,  970,  941,
+ /*   120 */   935,  861,  859,  812,  736,  155,  718,  668,  789,  281,
+ /*   130 */   717,  715,  645,  575,  661,  599,  -51,  490,  530,  521,
+ /*   140 */   445,  445,  445,  445,  445,  881,  908,  755,  618,  884,
+ /*   150 */  1252, 1251, 1247, 1246, 1235, 1229, 1225, 1221, 1211, 1209,
+ /*   160 */  1203, 1197, 1147, 1134, 1130, 1114, 1104, 1092, 1065, 1030,
+ /*   170 */  1000,  996,  976,  973,  971,  964,  960,  940,  884,  865,
+ /*   180 */   806,  722,  110,   66,  887,  862,  416,  597,  853,  818,
+ /*   190 */   201,  400,  693, 1387, 1391, 1389, 1384, 1386, 1381, 1378,
+ /*   200 */  1372, 1360, 1376, 1360, 1360, 1360, 1360, 1360, 1360, 1360,
+ /*   210 */  1350, 1368, 1360, 1360, 1372, 1385, 1366, 1383, 1380, 1379,
+ /*   220 */  1377, 1351, 1348, 1347, 1346, 1345, 1344, 1364, 1375, 1361,
+ /*   230 */  1371, 1359, 1352, 1356, 1343, 1355, 1353, 1341, 1339, 1302,
+ /*   240 */  1363, 1337, 1332, 1373, 1277, 1367, 1365, 1276, 1268, 1357,
+ /*   250 */  1275, 1285, 1324, 1320, 1329, 1328, 1326, 1318, 1317, 1282,
+ /*   260 */  1323, 1322, 1342, 1340, 1266, 1265, 1338, 1336, 1331, 1334,
+ /*   270 */  1327, 1325, 1321, 1315, 1310, 1305, 1303, 1300, 1258, 1257,
+ /*   280 */  1299, 1298, 1297, 1294, 1284, 1290, 1286, 1256, 1254, 1249,
+ /*   290 */  1253, 1248, 1241, 1293, 1281, 1207, 1236, 1234, 1233, 1231,
+ /*   300 */  1230, 1226, 1263, 1264, 1262, 1260, 1259, 1255, 1242, 1215,
+ /*   310 */  1213, 1220,
 };
 static const YYACTIONTYPE yy_default[] = {
- /*     0 */   630,  865,  950,  950,  950,  865,  950,  865,  950,  754,
- /*    10 */   950,  950,  950,  950,  863,  950,  950,  937,  950,  950,
- /*    20 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  950,
- /*    30 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  950,
- /*    40 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  950,
- /*    50 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  950,
- /*    60 */   950,  950,  950,  950,  950,  903,  903,  669,  758,  789,
- /*    70 */   950,  950,  950,  950,  950,  950,  950,  950,  936,  938,
- /*    80 */   894,  895,  797,  796,  916,  769,  794,  787,  780,  791,
- /*    90 */   866,  859,  860,  858,  862,  867,  950,  790,  826,  843,
- /*   100 */   825,  836,  842,  849,  841,  838,  837,  828,  827,  661,
- /*   110 */   829,  830,  950,  950,  950,  950,  950,  950,  950,  950,
- /*   120 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  723,
- /*   130 */   950,  950,  950,  950,  950,  950,  656,  880,  950,  950,
- /*   140 */   831,  832,  846,  845,  844,  950,  950,  950,  950,  950,
- /*   150 */   950,  950,  950,  950,  950,  943,  941,  950,  950,  950,
- /*   160 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  950,
- /*   170 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  950,
- /*   180 */   950,  950,  950,  636,  754,  754,  754,  630,  950,  950,
- /*   190 */   950,  758,  748,  714,  950,  950,  950,  950,  950,  950,
- /*   200 */   950,  950,  950,  950,  950,  950,  799,  737,  926,  928,
- /*   210 */   950,  909,  735,  658,  756,  671,  746,  638,  950,  950,
- /*   220 */   950,  793,  771,  771,  921,  793,  921,  695,  950,  783,
- /*   230 */   950,  783,  692,  783,  771,  783,  783,  861,  950,  950,
- /*   240 */   950,  755,  746,  950,  948,  762,  762,  940,  940,  762,
- /*   250 */   885,  805,  727,  793,  734,  734,  734,  734,  793,  805,
- /*   260 */   727,  727,  762,  653,  915,  913,  762,  762,  653,  762,
- /*   270 */   653,  762,  653,  872,  725,  725,  725,  710,  876,  876,
- /*   280 */   872,  725,  695,  725,  710,  725,  725,  775,  770,  775,
- /*   290 */   770,  775,  770,  762,  762,  950,  788,  776,  786,  784,
- /*   300 */   793,  950,  713,  646,  646,  635,  635,  635,  635,  697,
- /*   310 */   697,  679,  950,  950,  950,  950,  950,  889,  950,  950,
- /*   320 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  950,
- /*   330 */   950,  950,  950,  631,  950,  950,  947,  950,  884,  882,
- /*   340 */   879,  950,  950,  950,  798,  950,  950,  950,  950,  950,
- /*   350 */   950,  950,  950,  925,  950,  950,  950,  950,  950,  950,
- /*   360 */   950,  919,  950,  950,  950,  950,  950,  912,  911,  950,
- /*   370 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  950,
- /*   380 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  950,
- /*   390 */   950,  950,  950,  950,  950,  785,  950,  777,  950,  864,
- /*   400 */   950,  950,  950,  950,  950,  950,  950,  950,  950,  950,
- /*   410 */   740,  814,  950,  813,  817,  812,  663,  950,  644,  950,
- /*   420 */   627,  632,  949,  946,  945,  944,  942,  939,  935,  892,
- /*   430 */   898,  897,  896,  893,  891,  890,  883,  881,  878,  887,
- /*   440 */   886,  869,  800,  795,  792,  934,  888,  736,  733,  732,
- /*   450 */   652,  918,  927,  804,  803,  806,  924,  923,  922,  920,
- /*   460 */   917,  904,  802,  801,  728,  870,  868,  655,  908,  907,
- /*   470 */   906,  910,  914,  905,  764,  654,  651,  660,  717,  716,
- /*   480 */   724,  722,  721,  720,  719,  718,  715,  662,  670,  681,
- /*   490 */   709,  694,  693,  875,  877,  874,  873,  702,  701,  707,
- /*   500 */   706,  705,  704,  703,  700,  699,  698,  691,  690,  696,
- /*   510 */   689,  712,  711,  708,  688,  731,  730,  729,  726,  687,
- /*   520 */   686,  685,  817,  684,  683,  823,  822,  810,  853,  751,
- /*   530 */   750,  749,  761,  760,  773,  772,  808,  807,  774,  759,
- /*   540 */   753,  752,  768,  767,  766,  765,  757,  747,  779,  782,
- /*   550 */   781,  778,  855,  763,  852,  933,  932,  931,  930,  929,
- /*   560 */   857,  856,  824,  821,  674,  675,  902,  900,  901,  899,
- /*   570 */   677,  676,  673,  672,  854,  742,  741,  850,  847,  839,
- /*   580 */   851,  848,  840,  835,  834,  833,  819,  818,  816,  815,
- /*   590 */   811,  820,  665,  743,  739,  738,  809,  745,  744,  682,
- /*   600 */   680,  678,  659,  657,  650,  648,  647,  649,  645,  643,
- /*   610 */   642,  641,  640,  639,  668,  667,  666,  664,  663,  637,
- /*   620 */   634,  633,  629,  628,  626,
+ /*     0 */   632,  869,  954,  954,  954,  869,  954,  869,  954,  758,
+ /*    10 */   954,  954,  954,  954,  867,  954,  954,  941,  954,  954,
+ /*    20 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*    30 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*    40 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*    50 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*    60 */   954,  954,  954,  954,  954,  907,  907,  673,  762,  793,
+ /*    70 */   954,  954,  954,  954,  954,  954,  954,  954,  940,  942,
+ /*    80 */   898,  899,  801,  800,  920,  773,  798,  791,  784,  795,
+ /*    90 */   870,  863,  864,  862,  866,  871,  954,  794,  830,  847,
+ /*   100 */   829,  840,  846,  853,  845,  842,  841,  832,  831,  665,
+ /*   110 */   833,  834,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*   120 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  727,
+ /*   130 */   954,  954,  954,  954,  954,  954,  660,  884,  954,  954,
+ /*   140 */   835,  836,  850,  849,  848,  954,  954,  954,  954,  954,
+ /*   150 */   954,  954,  954,  954,  954,  947,  945,  954,  954,  954,
+ /*   160 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*   170 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*   180 */   954,  954,  954,  640,  758,  758,  758,  632,  954,  954,
+ /*   190 */   954,  762,  752,  718,  954,  954,  954,  954,  954,  954,
+ /*   200 */   954,  954,  954,  954,  954,  954,  803,  741,  930,  932,
+ /*   210 */   954,  913,  739,  662,  760,  675,  750,  642,  954,  954,
+ /*   220 */   954,  797,  775,  775,  925,  797,  925,  699,  954,  787,
+ /*   230 */   954,  787,  696,  787,  775,  787,  787,  865,  954,  954,
+ /*   240 */   954,  759,  750,  954,  952,  766,  766,  944,  944,  766,
+ /*   250 */   889,  809,  731,  797,  738,  738,  738,  738,  797,  809,
+ /*   260 */   731,  731,  766,  657,  919,  917,  766,  766,  657,  766,
+ /*   270 */   657,  766,  657,  876,  729,  729,  729,  714,  880,  880,
+ /*   280 */   876,  729,  699,  729,  714,  729,  729,  779,  774,  779,
+ /*   290 */   774,  779,  774,  766,  766,  954,  792,  780,  790,  788,
+ /*   300 */   797,  954,  717,  650,  650,  639,  639,  639,  639,  701,
+ /*   310 */   701,  683,  954,  954,  633,  954,  954,  954,  893,  954,
+ /*   320 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*   330 */   954,  954,  954,  954,  954,  954,  951,  954,  888,  886,
+ /*   340 */   883,  954,  954,  954,  802,  954,  954,  954,  954,  954,
+ /*   350 */   954,  954,  954,  929,  954,  954,  954,  954,  954,  954,
+ /*   360 */   954,  923,  954,  954,  954,  954,  954,  916,  915,  954,
+ /*   370 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*   380 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*   390 */   954,  954,  954,  954,  954,  789,  954,  781,  954,  868,
+ /*   400 */   954,  954,  954,  954,  954,  954,  954,  954,  954,  954,
+ /*   410 */   744,  818,  954,  817,  821,  816,  667,  954,  648,  954,
+ /*   420 */   629,  636,  635,  634,  953,  950,  949,  948,  946,  943,
+ /*   430 */   939,  896,  902,  901,  900,  897,  895,  894,  887,  885,
+ /*   440 */   882,  891,  890,  873,  804,  799,  796,  938,  892,  740,
+ /*   450 */   737,  736,  656,  922,  931,  808,  807,  810,  928,  927,
+ /*   460 */   926,  924,  921,  908,  806,  805,  732,  874,  872,  659,
+ /*   470 */   912,  911,  910,  914,  918,  909,  768,  658,  655,  664,
+ /*   480 */   721,  720,  728,  726,  725,  724,  723,  722,  719,  666,
+ /*   490 */   674,  685,  713,  698,  697,  879,  881,  878,  877,  706,
+ /*   500 */   705,  711,  710,  709,  708,  707,  704,  703,  702,  695,
+ /*   510 */   694,  700,  693,  716,  715,  712,  692,  735,  734,  733,
+ /*   520 */   730,  691,  690,  689,  821,  688,  687,  827,  826,  814,
+ /*   530 */   857,  755,  754,  753,  765,  764,  777,  776,  812,  811,
+ /*   540 */   778,  763,  757,  756,  772,  771,  770,  769,  761,  751,
+ /*   550 */   783,  786,  785,  782,  859,  767,  856,  937,  936,  935,
+ /*   560 */   934,  933,  861,  860,  828,  825,  678,  679,  906,  904,
+ /*   570 */   905,  903,  681,  680,  677,  676,  858,  746,  745,  854,
+ /*   580 */   851,  843,  855,  852,  844,  839,  838,  837,  823,  822,
+ /*   590 */   820,  819,  815,  824,  669,  747,  743,  742,  813,  749,
+ /*   600 */   748,  686,  684,  682,  663,  661,  654,  652,  651,  653,
+ /*   610 */   649,  647,  646,  645,  644,  643,  672,  671,  670,  668,
+ /*   620 */   667,  641,  638,  637,  631,  630,  628,
 };
 
 /* The next table maps tokens into fallback tokens.  If a construct
@@ -794,70 +796,71 @@ static const YYACTIONTYPE yy_default[] = {
 static const YYCODETYPE yyFallback[] = {
     0,  /*          $ => nothing */
     0,  /*       SEMI => nothing */
-   26,  /*    EXPLAIN => ID */
-   26,  /*      QUERY => ID */
-   26,  /*       PLAN => ID */
-   26,  /*      BEGIN => ID */
+   28,  /*    EXPLAIN => ID */
+   28,  /*      QUERY => ID */
+   28,  /*       PLAN => ID */
+   28,  /*    PROFILE => ID */
+   28,  /*    ANALYZE => ID */
+   28,  /*      BEGIN => ID */
     0,  /* TRANSACTION => nothing */
-   26,  /*   DEFERRED => ID */
-   26,  /*  IMMEDIATE => ID */
-   26,  /*  EXCLUSIVE => ID */
+   28,  /*   DEFERRED => ID */
+   28,  /*  IMMEDIATE => ID */
+   28,  /*  EXCLUSIVE => ID */
     0,  /*     COMMIT => nothing */
-   26,  /*        END => ID */
-   26,  /*   ROLLBACK => ID */
-   26,  /*  SAVEPOINT => ID */
-   26,  /*    RELEASE => ID */
+   28,  /*        END => ID */
+   28,  /*   ROLLBACK => ID */
+   28,  /*  SAVEPOINT => ID */
+   28,  /*    RELEASE => ID */
     0,  /*         TO => nothing */
     0,  /*      TABLE => nothing */
     0,  /*     CREATE => nothing */
-   26,  /*         IF => ID */
+   28,  /*         IF => ID */
     0,  /*        NOT => nothing */
     0,  /*     EXISTS => nothing */
-   26,  /*       TEMP => ID */
+   28,  /*       TEMP => ID */
     0,  /*         LP => nothing */
     0,  /*         RP => nothing */
     0,  /*         AS => nothing */
     0,  /*      COMMA => nothing */
     0,  /*         ID => nothing */
     0,  /*    INDEXED => nothing */
-   26,  /*      ABORT => ID */
-   26,  /*     ACTION => ID */
-   26,  /*      AFTER => ID */
-   26,  /*    ANALYZE => ID */
-   26,  /*        ASC => ID */
-   26,  /*     ATTACH => ID */
-   26,  /*     BEFORE => ID */
-   26,  /*         BY => ID */
-   26,  /*    CASCADE => ID */
-   26,  /*       CAST => ID */
-   26,  /*   COLUMNKW => ID */
-   26,  /*   CONFLICT => ID */
-   26,  /*   DATABASE => ID */
-   26,  /*       DESC => ID */
-   26,  /*     DETACH => ID */
-   26,  /*       EACH => ID */
-   26,  /*       FAIL => ID */
-   26,  /*        FOR => ID */
-   26,  /*     IGNORE => ID */
-   26,  /*  INITIALLY => ID */
-   26,  /*    INSTEAD => ID */
-   26,  /*    LIKE_KW => ID */
-   26,  /*      MATCH => ID */
-   26,  /*         NO => ID */
-   26,  /*        KEY => ID */
-   26,  /*         OF => ID */
-   26,  /*     OFFSET => ID */
-   26,  /*     PRAGMA => ID */
-   26,  /*      RAISE => ID */
-   26,  /*    REPLACE => ID */
-   26,  /*   RESTRICT => ID */
-   26,  /*        ROW => ID */
-   26,  /*    TRIGGER => ID */
-   26,  /*       VIEW => ID */
-   26,  /*    VIRTUAL => ID */
-   26,  /*    REINDEX => ID */
-   26,  /*     RENAME => ID */
-   26,  /*   CTIME_KW => ID */
+   28,  /*      ABORT => ID */
+   28,  /*     ACTION => ID */
+   28,  /*      AFTER => ID */
+   28,  /*        ASC => ID */
+   28,  /*     ATTACH => ID */
+   28,  /*     BEFORE => ID */
+   28,  /*         BY => ID */
+   28,  /*    CASCADE => ID */
+   28,  /*       CAST => ID */
+   28,  /*   COLUMNKW => ID */
+   28,  /*   CONFLICT => ID */
+   28,  /*   DATABASE => ID */
+   28,  /*       DESC => ID */
+   28,  /*     DETACH => ID */
+   28,  /*       EACH => ID */
+   28,  /*       FAIL => ID */
+   28,  /*        FOR => ID */
+   28,  /*     IGNORE => ID */
+   28,  /*  INITIALLY => ID */
+   28,  /*    INSTEAD => ID */
+   28,  /*    LIKE_KW => ID */
+   28,  /*      MATCH => ID */
+   28,  /*         NO => ID */
+   28,  /*        KEY => ID */
+   28,  /*         OF => ID */
+   28,  /*     OFFSET => ID */
+   28,  /*     PRAGMA => ID */
+   28,  /*      RAISE => ID */
+   28,  /*    REPLACE => ID */
+   28,  /*   RESTRICT => ID */
+   28,  /*        ROW => ID */
+   28,  /*    TRIGGER => ID */
+   28,  /*       VIEW => ID */
+   28,  /*    VIRTUAL => ID */
+   28,  /*    REINDEX => ID */
+   28,  /*     RENAME => ID */
+   28,  /*   CTIME_KW => ID */
 };
 #endif /* YYFALLBACK */
 
@@ -938,68 +941,68 @@ void sqlite4ParserTrace(FILE *TraceFILE, char *zTracePrompt){
 ** are required.  The following table supplies these names */
 static const char *const yyTokenName[] = { 
   "$",             "SEMI",          "EXPLAIN",       "QUERY",       
-  "PLAN",          "BEGIN",         "TRANSACTION",   "DEFERRED",    
-  "IMMEDIATE",     "EXCLUSIVE",     "COMMIT",        "END",         
-  "ROLLBACK",      "SAVEPOINT",     "RELEASE",       "TO",          
-  "TABLE",         "CREATE",        "IF",            "NOT",         
-  "EXISTS",        "TEMP",          "LP",            "RP",          
-  "AS",            "COMMA",         "ID",            "INDEXED",     
-  "ABORT",         "ACTION",        "AFTER",         "ANALYZE",     
-  "ASC",           "ATTACH",        "BEFORE",        "BY",          
-  "CASCADE",       "CAST",          "COLUMNKW",      "CONFLICT",    
-  "DATABASE",      "DESC",          "DETACH",        "EACH",        
-  "FAIL",          "FOR",           "IGNORE",        "INITIALLY",   
-  "INSTEAD",       "LIKE_KW",       "MATCH",         "NO",          
-  "KEY",           "OF",            "OFFSET",        "PRAGMA",      
-  "RAISE",         "REPLACE",       "RESTRICT",      "ROW",         
-  "TRIGGER",       "VIEW",          "VIRTUAL",       "REINDEX",     
-  "RENAME",        "CTIME_KW",      "ANY",           "OR",          
-  "AND",           "IS",            "BETWEEN",       "IN",          
-  "ISNULL",        "NOTNULL",       "NE",            "EQ",          
-  "GT",            "LE",            "LT",            "GE",          
-  "ESCAPE",        "BITAND",        "BITOR",         "LSHIFT",      
-  "RSHIFT",        "PLUS",          "MINUS",         "STAR",        
-  "SLASH",         "REM",           "CONCAT",        "COLLATE",     
-  "BITNOT",        "STRING",        "JOIN_KW",       "CONSTRAINT",  
-  "DEFAULT",       "NULL",          "PRIMARY",       "UNIQUE",      
-  "CHECK",         "REFERENCES",    "AUTOINCR",      "ON",          
-  "INSERT",        "DELETE",        "UPDATE",        "SET",         
-  "DEFERRABLE",    "FOREIGN",       "DROP",          "UNION",       
-  "ALL",           "EXCEPT",        "INTERSECT",     "SELECT",      
-  "DISTINCT",      "DOT",           "FROM",          "JOIN",        
-  "USING",         "ORDER",         "GROUP",         "HAVING",      
-  "LIMIT",         "WHERE",         "INTO",          "VALUES",      
-  "INTEGER",       "FLOAT",         "BLOB",          "REGISTER",    
-  "VARIABLE",      "CASE",          "WHEN",          "THEN",        
-  "ELSE",          "INDEX",         "COVERING",      "ALTER",       
-  "ADD",           "error",         "input",         "cmdlist",     
-  "ecmd",          "explain",       "cmdx",          "cmd",         
-  "transtype",     "trans_opt",     "nm",            "savepoint_opt",
-  "create_table",  "create_table_args",  "createkw",      "temp",        
-  "ifnotexists",   "dbnm",          "columnlist",    "conslist_opt",
-  "select",        "column",        "columnid",      "type",        
-  "carglist",      "id",            "ids",           "typetoken",   
-  "typename",      "signed",        "plus_num",      "minus_num",   
-  "carg",          "ccons",         "term",          "expr",        
-  "onconf",        "sortorder",     "autoinc",       "idxlist_opt", 
-  "refargs",       "defer_subclause",  "refarg",        "refact",      
-  "init_deferred_pred_opt",  "conslist",      "tcons",         "idxlist",     
-  "defer_subclause_opt",  "orconf",        "resolvetype",   "raisetype",   
-  "ifexists",      "fullname",      "oneselect",     "multiselect_op",
-  "distinct",      "selcollist",    "from",          "where_opt",   
-  "groupby_opt",   "having_opt",    "orderby_opt",   "limit_opt",   
-  "sclp",          "as",            "seltablist",    "stl_prefix",  
-  "joinop",        "indexed_opt",   "on_opt",        "using_opt",   
-  "joinop2",       "inscollist",    "sortlist",      "sortitem",    
-  "nexprlist",     "setlist",       "insert_cmd",    "inscollist_opt",
-  "valuelist",     "exprlist",      "likeop",        "between_op",  
-  "in_op",         "case_operand",  "case_exprlist",  "case_else",   
-  "createindex",   "uniqueflag",    "covering_opt",  "collate",     
-  "uidxlist_opt",  "uidxlist",      "pragmaargs",    "pragmaarg",   
-  "plus_opt",      "number",        "trigger_decl",  "trigger_cmd_list",
-  "trigger_time",  "trigger_event",  "foreach_clause",  "when_clause", 
-  "trigger_cmd",   "trnm",          "tridxby",       "database_kw_opt",
-  "key_opt",       "add_column_fullname",  "kwcolumn_opt",
+  "PLAN",          "PROFILE",       "ANALYZE",       "BEGIN",       
+  "TRANSACTION",   "DEFERRED",      "IMMEDIATE",     "EXCLUSIVE",   
+  "COMMIT",        "END",           "ROLLBACK",      "SAVEPOINT",   
+  "RELEASE",       "TO",            "TABLE",         "CREATE",      
+  "IF",            "NOT",           "EXISTS",        "TEMP",        
+  "LP",            "RP",            "AS",            "COMMA",       
+  "ID",            "INDEXED",       "ABORT",         "ACTION",      
+  "AFTER",         "ASC",           "ATTACH",        "BEFORE",      
+  "BY",            "CASCADE",       "CAST",          "COLUMNKW",    
+  "CONFLICT",      "DATABASE",      "DESC",          "DETACH",      
+  "EACH",          "FAIL",          "FOR",           "IGNORE",      
+  "INITIALLY",     "INSTEAD",       "LIKE_KW",       "MATCH",       
+  "NO",            "KEY",           "OF",            "OFFSET",      
+  "PRAGMA",        "RAISE",         "REPLACE",       "RESTRICT",    
+  "ROW",           "TRIGGER",       "VIEW",          "VIRTUAL",     
+  "REINDEX",       "RENAME",        "CTIME_KW",      "ANY",         
+  "OR",            "AND",           "IS",            "BETWEEN",     
+  "IN",            "ISNULL",        "NOTNULL",       "NE",          
+  "EQ",            "GT",            "LE",            "LT",          
+  "GE",            "ESCAPE",        "BITAND",        "BITOR",       
+  "LSHIFT",        "RSHIFT",        "PLUS",          "MINUS",       
+  "STAR",          "SLASH",         "REM",           "CONCAT",      
+  "COLLATE",       "BITNOT",        "STRING",        "JOIN_KW",     
+  "CONSTRAINT",    "DEFAULT",       "NULL",          "PRIMARY",     
+  "UNIQUE",        "CHECK",         "REFERENCES",    "AUTOINCR",    
+  "ON",            "INSERT",        "DELETE",        "UPDATE",      
+  "SET",           "DEFERRABLE",    "FOREIGN",       "DROP",        
+  "UNION",         "ALL",           "EXCEPT",        "INTERSECT",   
+  "SELECT",        "DISTINCT",      "DOT",           "FROM",        
+  "JOIN",          "USING",         "ORDER",         "GROUP",       
+  "HAVING",        "LIMIT",         "WHERE",         "INTO",        
+  "VALUES",        "INTEGER",       "FLOAT",         "BLOB",        
+  "REGISTER",      "VARIABLE",      "CASE",          "WHEN",        
+  "THEN",          "ELSE",          "INDEX",         "COVERING",    
+  "ALTER",         "ADD",           "error",         "input",       
+  "cmdlist",       "ecmd",          "explain",       "cmdx",        
+  "cmd",           "transtype",     "trans_opt",     "nm",          
+  "savepoint_opt",  "create_table",  "create_table_args",  "createkw",    
+  "temp",          "ifnotexists",   "dbnm",          "columnlist",  
+  "conslist_opt",  "select",        "column",        "columnid",    
+  "type",          "carglist",      "id",            "ids",         
+  "typetoken",     "typename",      "signed",        "plus_num",    
+  "minus_num",     "carg",          "ccons",         "term",        
+  "expr",          "onconf",        "sortorder",     "autoinc",     
+  "idxlist_opt",   "refargs",       "defer_subclause",  "refarg",      
+  "refact",        "init_deferred_pred_opt",  "conslist",      "tcons",       
+  "idxlist",       "defer_subclause_opt",  "orconf",        "resolvetype", 
+  "raisetype",     "ifexists",      "fullname",      "oneselect",   
+  "multiselect_op",  "distinct",      "selcollist",    "from",        
+  "where_opt",     "groupby_opt",   "having_opt",    "orderby_opt", 
+  "limit_opt",     "sclp",          "as",            "seltablist",  
+  "stl_prefix",    "joinop",        "indexed_opt",   "on_opt",      
+  "using_opt",     "joinop2",       "inscollist",    "sortlist",    
+  "sortitem",      "nexprlist",     "setlist",       "insert_cmd",  
+  "inscollist_opt",  "valuelist",     "exprlist",      "likeop",      
+  "between_op",    "in_op",         "case_operand",  "case_exprlist",
+  "case_else",     "createindex",   "uniqueflag",    "covering_opt",
+  "collate",       "uidxlist_opt",  "uidxlist",      "pragmaargs",  
+  "pragmaarg",     "plus_opt",      "number",        "trigger_decl",
+  "trigger_cmd_list",  "trigger_time",  "trigger_event",  "foreach_clause",
+  "when_clause",   "trigger_cmd",   "trnm",          "tridxby",     
+  "database_kw_opt",  "key_opt",       "add_column_fullname",  "kwcolumn_opt",
 };
 #endif /* NDEBUG */
 
@@ -1015,323 +1018,325 @@ static const char *const yyRuleName[] = {
  /*   5 */ "explain ::=",
  /*   6 */ "explain ::= EXPLAIN",
  /*   7 */ "explain ::= EXPLAIN QUERY PLAN",
- /*   8 */ "cmdx ::= cmd",
- /*   9 */ "cmd ::= BEGIN transtype trans_opt",
- /*  10 */ "trans_opt ::=",
- /*  11 */ "trans_opt ::= TRANSACTION",
- /*  12 */ "trans_opt ::= TRANSACTION nm",
- /*  13 */ "transtype ::=",
- /*  14 */ "transtype ::= DEFERRED",
- /*  15 */ "transtype ::= IMMEDIATE",
- /*  16 */ "transtype ::= EXCLUSIVE",
- /*  17 */ "cmd ::= COMMIT trans_opt",
- /*  18 */ "cmd ::= END trans_opt",
- /*  19 */ "cmd ::= ROLLBACK trans_opt",
- /*  20 */ "savepoint_opt ::= SAVEPOINT",
- /*  21 */ "savepoint_opt ::=",
- /*  22 */ "cmd ::= SAVEPOINT nm",
- /*  23 */ "cmd ::= RELEASE savepoint_opt nm",
- /*  24 */ "cmd ::= ROLLBACK trans_opt TO savepoint_opt nm",
- /*  25 */ "cmd ::= create_table create_table_args",
- /*  26 */ "create_table ::= createkw temp TABLE ifnotexists nm dbnm",
- /*  27 */ "createkw ::= CREATE",
- /*  28 */ "ifnotexists ::=",
- /*  29 */ "ifnotexists ::= IF NOT EXISTS",
- /*  30 */ "temp ::= TEMP",
- /*  31 */ "temp ::=",
- /*  32 */ "create_table_args ::= LP columnlist conslist_opt RP",
- /*  33 */ "create_table_args ::= AS select",
- /*  34 */ "columnlist ::= columnlist COMMA column",
- /*  35 */ "columnlist ::= column",
- /*  36 */ "column ::= columnid type carglist",
- /*  37 */ "columnid ::= nm",
- /*  38 */ "id ::= ID",
- /*  39 */ "id ::= INDEXED",
- /*  40 */ "ids ::= ID|STRING",
- /*  41 */ "nm ::= id",
- /*  42 */ "nm ::= STRING",
- /*  43 */ "nm ::= JOIN_KW",
- /*  44 */ "type ::=",
- /*  45 */ "type ::= typetoken",
- /*  46 */ "typetoken ::= typename",
- /*  47 */ "typetoken ::= typename LP signed RP",
- /*  48 */ "typetoken ::= typename LP signed COMMA signed RP",
- /*  49 */ "typename ::= ids",
- /*  50 */ "typename ::= typename ids",
- /*  51 */ "signed ::= plus_num",
- /*  52 */ "signed ::= minus_num",
- /*  53 */ "carglist ::= carglist carg",
- /*  54 */ "carglist ::=",
- /*  55 */ "carg ::= CONSTRAINT nm ccons",
- /*  56 */ "carg ::= ccons",
- /*  57 */ "ccons ::= DEFAULT term",
- /*  58 */ "ccons ::= DEFAULT LP expr RP",
- /*  59 */ "ccons ::= DEFAULT PLUS term",
- /*  60 */ "ccons ::= DEFAULT MINUS term",
- /*  61 */ "ccons ::= DEFAULT id",
- /*  62 */ "ccons ::= NULL onconf",
- /*  63 */ "ccons ::= NOT NULL onconf",
- /*  64 */ "ccons ::= PRIMARY KEY sortorder onconf autoinc",
- /*  65 */ "ccons ::= UNIQUE onconf",
- /*  66 */ "ccons ::= CHECK LP expr RP",
- /*  67 */ "ccons ::= REFERENCES nm idxlist_opt refargs",
- /*  68 */ "ccons ::= defer_subclause",
- /*  69 */ "ccons ::= COLLATE ids",
- /*  70 */ "autoinc ::=",
- /*  71 */ "autoinc ::= AUTOINCR",
- /*  72 */ "refargs ::=",
- /*  73 */ "refargs ::= refargs refarg",
- /*  74 */ "refarg ::= MATCH nm",
- /*  75 */ "refarg ::= ON INSERT refact",
- /*  76 */ "refarg ::= ON DELETE refact",
- /*  77 */ "refarg ::= ON UPDATE refact",
- /*  78 */ "refact ::= SET NULL",
- /*  79 */ "refact ::= SET DEFAULT",
- /*  80 */ "refact ::= CASCADE",
- /*  81 */ "refact ::= RESTRICT",
- /*  82 */ "refact ::= NO ACTION",
- /*  83 */ "defer_subclause ::= NOT DEFERRABLE init_deferred_pred_opt",
- /*  84 */ "defer_subclause ::= DEFERRABLE init_deferred_pred_opt",
- /*  85 */ "init_deferred_pred_opt ::=",
- /*  86 */ "init_deferred_pred_opt ::= INITIALLY DEFERRED",
- /*  87 */ "init_deferred_pred_opt ::= INITIALLY IMMEDIATE",
- /*  88 */ "conslist_opt ::=",
- /*  89 */ "conslist_opt ::= COMMA conslist",
- /*  90 */ "conslist ::= conslist COMMA tcons",
- /*  91 */ "conslist ::= conslist tcons",
- /*  92 */ "conslist ::= tcons",
- /*  93 */ "tcons ::= CONSTRAINT nm",
- /*  94 */ "tcons ::= PRIMARY KEY LP idxlist autoinc RP onconf",
- /*  95 */ "tcons ::= UNIQUE LP idxlist RP onconf",
- /*  96 */ "tcons ::= CHECK LP expr RP onconf",
- /*  97 */ "tcons ::= FOREIGN KEY LP idxlist RP REFERENCES nm idxlist_opt refargs defer_subclause_opt",
- /*  98 */ "defer_subclause_opt ::=",
- /*  99 */ "defer_subclause_opt ::= defer_subclause",
- /* 100 */ "onconf ::=",
- /* 101 */ "onconf ::= ON CONFLICT resolvetype",
- /* 102 */ "orconf ::=",
- /* 103 */ "orconf ::= OR resolvetype",
- /* 104 */ "resolvetype ::= raisetype",
- /* 105 */ "resolvetype ::= IGNORE",
- /* 106 */ "resolvetype ::= REPLACE",
- /* 107 */ "cmd ::= DROP TABLE ifexists fullname",
- /* 108 */ "ifexists ::= IF EXISTS",
- /* 109 */ "ifexists ::=",
- /* 110 */ "cmd ::= createkw temp VIEW ifnotexists nm dbnm AS select",
- /* 111 */ "cmd ::= DROP VIEW ifexists fullname",
- /* 112 */ "cmd ::= select",
- /* 113 */ "select ::= oneselect",
- /* 114 */ "select ::= select multiselect_op oneselect",
- /* 115 */ "multiselect_op ::= UNION",
- /* 116 */ "multiselect_op ::= UNION ALL",
- /* 117 */ "multiselect_op ::= EXCEPT|INTERSECT",
- /* 118 */ "oneselect ::= SELECT distinct selcollist from where_opt groupby_opt having_opt orderby_opt limit_opt",
- /* 119 */ "distinct ::= DISTINCT",
- /* 120 */ "distinct ::= ALL",
- /* 121 */ "distinct ::=",
- /* 122 */ "sclp ::= selcollist COMMA",
- /* 123 */ "sclp ::=",
- /* 124 */ "selcollist ::= sclp expr as",
- /* 125 */ "selcollist ::= sclp STAR",
- /* 126 */ "selcollist ::= sclp nm DOT STAR",
- /* 127 */ "as ::= AS nm",
- /* 128 */ "as ::= ids",
- /* 129 */ "as ::=",
- /* 130 */ "from ::=",
- /* 131 */ "from ::= FROM seltablist",
- /* 132 */ "stl_prefix ::= seltablist joinop",
- /* 133 */ "stl_prefix ::=",
- /* 134 */ "seltablist ::= stl_prefix nm dbnm as indexed_opt on_opt using_opt",
- /* 135 */ "seltablist ::= stl_prefix LP select RP as on_opt using_opt",
- /* 136 */ "seltablist ::= stl_prefix LP seltablist RP as on_opt using_opt",
- /* 137 */ "dbnm ::=",
- /* 138 */ "dbnm ::= DOT nm",
- /* 139 */ "fullname ::= nm dbnm",
- /* 140 */ "joinop ::= COMMA|JOIN",
- /* 141 */ "joinop ::= JOIN_KW JOIN",
- /* 142 */ "joinop ::= JOIN_KW nm JOIN",
- /* 143 */ "joinop ::= JOIN_KW nm nm JOIN",
- /* 144 */ "on_opt ::= ON expr",
- /* 145 */ "on_opt ::=",
- /* 146 */ "indexed_opt ::=",
- /* 147 */ "indexed_opt ::= INDEXED BY nm",
- /* 148 */ "indexed_opt ::= NOT INDEXED",
- /* 149 */ "using_opt ::= USING LP inscollist RP",
- /* 150 */ "using_opt ::=",
- /* 151 */ "orderby_opt ::=",
- /* 152 */ "orderby_opt ::= ORDER BY sortlist",
- /* 153 */ "sortlist ::= sortlist COMMA sortitem sortorder",
- /* 154 */ "sortlist ::= sortitem sortorder",
- /* 155 */ "sortitem ::= expr",
- /* 156 */ "sortorder ::= ASC",
- /* 157 */ "sortorder ::= DESC",
- /* 158 */ "sortorder ::=",
- /* 159 */ "groupby_opt ::=",
- /* 160 */ "groupby_opt ::= GROUP BY nexprlist",
- /* 161 */ "having_opt ::=",
- /* 162 */ "having_opt ::= HAVING expr",
- /* 163 */ "limit_opt ::=",
- /* 164 */ "limit_opt ::= LIMIT expr",
- /* 165 */ "limit_opt ::= LIMIT expr OFFSET expr",
- /* 166 */ "limit_opt ::= LIMIT expr COMMA expr",
- /* 167 */ "cmd ::= DELETE FROM fullname indexed_opt where_opt",
- /* 168 */ "where_opt ::=",
- /* 169 */ "where_opt ::= WHERE expr",
- /* 170 */ "cmd ::= UPDATE orconf fullname indexed_opt SET setlist where_opt",
- /* 171 */ "setlist ::= setlist COMMA nm EQ expr",
- /* 172 */ "setlist ::= nm EQ expr",
- /* 173 */ "cmd ::= insert_cmd INTO fullname inscollist_opt valuelist",
- /* 174 */ "cmd ::= insert_cmd INTO fullname inscollist_opt select",
- /* 175 */ "cmd ::= insert_cmd INTO fullname inscollist_opt DEFAULT VALUES",
- /* 176 */ "insert_cmd ::= INSERT orconf",
- /* 177 */ "insert_cmd ::= REPLACE",
- /* 178 */ "valuelist ::= VALUES LP nexprlist RP",
- /* 179 */ "valuelist ::= valuelist COMMA LP exprlist RP",
- /* 180 */ "inscollist_opt ::=",
- /* 181 */ "inscollist_opt ::= LP inscollist RP",
- /* 182 */ "inscollist ::= inscollist COMMA nm",
- /* 183 */ "inscollist ::= nm",
- /* 184 */ "expr ::= term",
- /* 185 */ "expr ::= LP expr RP",
- /* 186 */ "term ::= NULL",
- /* 187 */ "expr ::= id",
- /* 188 */ "expr ::= JOIN_KW",
- /* 189 */ "expr ::= nm DOT nm",
- /* 190 */ "expr ::= nm DOT nm DOT nm",
- /* 191 */ "term ::= INTEGER|FLOAT|BLOB",
- /* 192 */ "term ::= STRING",
- /* 193 */ "expr ::= REGISTER",
- /* 194 */ "expr ::= VARIABLE",
- /* 195 */ "expr ::= expr COLLATE ids",
- /* 196 */ "expr ::= CAST LP expr AS typetoken RP",
- /* 197 */ "expr ::= ID LP distinct exprlist RP",
- /* 198 */ "expr ::= ID LP STAR RP",
- /* 199 */ "term ::= CTIME_KW",
- /* 200 */ "expr ::= expr AND expr",
- /* 201 */ "expr ::= expr OR expr",
- /* 202 */ "expr ::= expr LT|GT|GE|LE expr",
- /* 203 */ "expr ::= expr EQ|NE expr",
- /* 204 */ "expr ::= expr BITAND|BITOR|LSHIFT|RSHIFT expr",
- /* 205 */ "expr ::= expr PLUS|MINUS expr",
- /* 206 */ "expr ::= expr STAR|SLASH|REM expr",
- /* 207 */ "expr ::= expr CONCAT expr",
- /* 208 */ "likeop ::= LIKE_KW",
- /* 209 */ "likeop ::= NOT LIKE_KW",
- /* 210 */ "likeop ::= NOT MATCH",
- /* 211 */ "expr ::= expr likeop expr",
- /* 212 */ "expr ::= expr likeop expr ESCAPE expr",
- /* 213 */ "expr ::= expr MATCH expr",
- /* 214 */ "expr ::= expr ISNULL|NOTNULL",
- /* 215 */ "expr ::= expr NOT NULL",
- /* 216 */ "expr ::= expr IS expr",
- /* 217 */ "expr ::= expr IS NOT expr",
- /* 218 */ "expr ::= NOT expr",
- /* 219 */ "expr ::= BITNOT expr",
- /* 220 */ "expr ::= MINUS expr",
- /* 221 */ "expr ::= PLUS expr",
- /* 222 */ "between_op ::= BETWEEN",
- /* 223 */ "between_op ::= NOT BETWEEN",
- /* 224 */ "expr ::= expr between_op expr AND expr",
- /* 225 */ "in_op ::= IN",
- /* 226 */ "in_op ::= NOT IN",
- /* 227 */ "expr ::= expr in_op LP exprlist RP",
- /* 228 */ "expr ::= LP select RP",
- /* 229 */ "expr ::= expr in_op LP select RP",
- /* 230 */ "expr ::= expr in_op nm dbnm",
- /* 231 */ "expr ::= EXISTS LP select RP",
- /* 232 */ "expr ::= CASE case_operand case_exprlist case_else END",
- /* 233 */ "case_exprlist ::= case_exprlist WHEN expr THEN expr",
- /* 234 */ "case_exprlist ::= WHEN expr THEN expr",
- /* 235 */ "case_else ::= ELSE expr",
- /* 236 */ "case_else ::=",
- /* 237 */ "case_operand ::= expr",
- /* 238 */ "case_operand ::=",
- /* 239 */ "exprlist ::= nexprlist",
- /* 240 */ "exprlist ::=",
- /* 241 */ "nexprlist ::= nexprlist COMMA expr",
- /* 242 */ "nexprlist ::= expr",
- /* 243 */ "createindex ::= createkw uniqueflag INDEX ifnotexists nm dbnm ON nm",
- /* 244 */ "cmd ::= createindex LP idxlist RP covering_opt",
- /* 245 */ "uniqueflag ::= UNIQUE",
- /* 246 */ "uniqueflag ::=",
- /* 247 */ "idxlist_opt ::=",
- /* 248 */ "idxlist_opt ::= LP idxlist RP",
- /* 249 */ "idxlist ::= idxlist COMMA nm collate sortorder",
- /* 250 */ "idxlist ::= nm collate sortorder",
- /* 251 */ "collate ::=",
- /* 252 */ "collate ::= COLLATE ids",
- /* 253 */ "cmd ::= createindex USING nm LP uidxlist_opt RP",
- /* 254 */ "uidxlist_opt ::= uidxlist",
- /* 255 */ "uidxlist_opt ::=",
- /* 256 */ "uidxlist ::= uidxlist COMMA ids EQ ids",
- /* 257 */ "uidxlist ::= uidxlist COMMA ids",
- /* 258 */ "uidxlist ::= ids EQ ids",
- /* 259 */ "uidxlist ::= ids",
- /* 260 */ "covering_opt ::=",
- /* 261 */ "covering_opt ::= COVERING ALL",
- /* 262 */ "covering_opt ::= COVERING LP inscollist RP",
- /* 263 */ "cmd ::= DROP INDEX ifexists fullname",
- /* 264 */ "cmd ::= PRAGMA nm dbnm",
- /* 265 */ "cmd ::= PRAGMA nm dbnm LP RP",
- /* 266 */ "cmd ::= PRAGMA nm dbnm LP pragmaargs RP",
- /* 267 */ "cmd ::= PRAGMA nm dbnm EQ pragmaarg",
- /* 268 */ "pragmaargs ::= pragmaarg",
- /* 269 */ "pragmaargs ::= pragmaargs COMMA expr",
- /* 270 */ "pragmaarg ::= expr",
- /* 271 */ "pragmaarg ::= ON",
- /* 272 */ "pragmaarg ::= DELETE",
- /* 273 */ "pragmaarg ::= DEFAULT",
- /* 274 */ "plus_num ::= plus_opt number",
- /* 275 */ "minus_num ::= MINUS number",
- /* 276 */ "number ::= INTEGER|FLOAT",
- /* 277 */ "plus_opt ::= PLUS",
- /* 278 */ "plus_opt ::=",
- /* 279 */ "cmd ::= createkw trigger_decl BEGIN trigger_cmd_list END",
- /* 280 */ "trigger_decl ::= temp TRIGGER ifnotexists nm dbnm trigger_time trigger_event ON fullname foreach_clause when_clause",
- /* 281 */ "trigger_time ::= BEFORE",
- /* 282 */ "trigger_time ::= AFTER",
- /* 283 */ "trigger_time ::= INSTEAD OF",
- /* 284 */ "trigger_time ::=",
- /* 285 */ "trigger_event ::= DELETE|INSERT",
- /* 286 */ "trigger_event ::= UPDATE",
- /* 287 */ "trigger_event ::= UPDATE OF inscollist",
- /* 288 */ "foreach_clause ::=",
- /* 289 */ "foreach_clause ::= FOR EACH ROW",
- /* 290 */ "when_clause ::=",
- /* 291 */ "when_clause ::= WHEN expr",
- /* 292 */ "trigger_cmd_list ::= trigger_cmd_list trigger_cmd SEMI",
- /* 293 */ "trigger_cmd_list ::= trigger_cmd SEMI",
- /* 294 */ "trnm ::= nm",
- /* 295 */ "trnm ::= nm DOT nm",
- /* 296 */ "tridxby ::=",
- /* 297 */ "tridxby ::= INDEXED BY nm",
- /* 298 */ "tridxby ::= NOT INDEXED",
- /* 299 */ "trigger_cmd ::= UPDATE orconf trnm tridxby SET setlist where_opt",
- /* 300 */ "trigger_cmd ::= insert_cmd INTO trnm inscollist_opt valuelist",
- /* 301 */ "trigger_cmd ::= insert_cmd INTO trnm inscollist_opt select",
- /* 302 */ "trigger_cmd ::= DELETE FROM trnm tridxby where_opt",
- /* 303 */ "trigger_cmd ::= select",
- /* 304 */ "expr ::= RAISE LP IGNORE RP",
- /* 305 */ "expr ::= RAISE LP raisetype COMMA nm RP",
- /* 306 */ "raisetype ::= ROLLBACK",
- /* 307 */ "raisetype ::= ABORT",
- /* 308 */ "raisetype ::= FAIL",
- /* 309 */ "cmd ::= DROP TRIGGER ifexists fullname",
- /* 310 */ "cmd ::= ATTACH database_kw_opt expr AS expr key_opt",
- /* 311 */ "cmd ::= DETACH database_kw_opt expr",
- /* 312 */ "key_opt ::=",
- /* 313 */ "key_opt ::= KEY expr",
- /* 314 */ "database_kw_opt ::= DATABASE",
- /* 315 */ "database_kw_opt ::=",
- /* 316 */ "cmd ::= REINDEX",
- /* 317 */ "cmd ::= REINDEX nm dbnm",
- /* 318 */ "cmd ::= ANALYZE",
- /* 319 */ "cmd ::= ANALYZE nm dbnm",
- /* 320 */ "cmd ::= ALTER TABLE fullname RENAME TO nm",
- /* 321 */ "cmd ::= ALTER TABLE add_column_fullname ADD kwcolumn_opt column",
- /* 322 */ "add_column_fullname ::= fullname",
- /* 323 */ "kwcolumn_opt ::=",
- /* 324 */ "kwcolumn_opt ::= COLUMNKW",
+ /*   8 */ "explain ::= EXPLAIN PROFILE",
+ /*   9 */ "explain ::= EXPLAIN ANALYZE",
+ /*  10 */ "cmdx ::= cmd",
+ /*  11 */ "cmd ::= BEGIN transtype trans_opt",
+ /*  12 */ "trans_opt ::=",
+ /*  13 */ "trans_opt ::= TRANSACTION",
+ /*  14 */ "trans_opt ::= TRANSACTION nm",
+ /*  15 */ "transtype ::=",
+ /*  16 */ "transtype ::= DEFERRED",
+ /*  17 */ "transtype ::= IMMEDIATE",
+ /*  18 */ "transtype ::= EXCLUSIVE",
+ /*  19 */ "cmd ::= COMMIT trans_opt",
+ /*  20 */ "cmd ::= END trans_opt",
+ /*  21 */ "cmd ::= ROLLBACK trans_opt",
+ /*  22 */ "savepoint_opt ::= SAVEPOINT",
+ /*  23 */ "savepoint_opt ::=",
+ /*  24 */ "cmd ::= SAVEPOINT nm",
+ /*  25 */ "cmd ::= RELEASE savepoint_opt nm",
+ /*  26 */ "cmd ::= ROLLBACK trans_opt TO savepoint_opt nm",
+ /*  27 */ "cmd ::= create_table create_table_args",
+ /*  28 */ "create_table ::= createkw temp TABLE ifnotexists nm dbnm",
+ /*  29 */ "createkw ::= CREATE",
+ /*  30 */ "ifnotexists ::=",
+ /*  31 */ "ifnotexists ::= IF NOT EXISTS",
+ /*  32 */ "temp ::= TEMP",
+ /*  33 */ "temp ::=",
+ /*  34 */ "create_table_args ::= LP columnlist conslist_opt RP",
+ /*  35 */ "create_table_args ::= AS select",
+ /*  36 */ "columnlist ::= columnlist COMMA column",
+ /*  37 */ "columnlist ::= column",
+ /*  38 */ "column ::= columnid type carglist",
+ /*  39 */ "columnid ::= nm",
+ /*  40 */ "id ::= ID",
+ /*  41 */ "id ::= INDEXED",
+ /*  42 */ "ids ::= ID|STRING",
+ /*  43 */ "nm ::= id",
+ /*  44 */ "nm ::= STRING",
+ /*  45 */ "nm ::= JOIN_KW",
+ /*  46 */ "type ::=",
+ /*  47 */ "type ::= typetoken",
+ /*  48 */ "typetoken ::= typename",
+ /*  49 */ "typetoken ::= typename LP signed RP",
+ /*  50 */ "typetoken ::= typename LP signed COMMA signed RP",
+ /*  51 */ "typename ::= ids",
+ /*  52 */ "typename ::= typename ids",
+ /*  53 */ "signed ::= plus_num",
+ /*  54 */ "signed ::= minus_num",
+ /*  55 */ "carglist ::= carglist carg",
+ /*  56 */ "carglist ::=",
+ /*  57 */ "carg ::= CONSTRAINT nm ccons",
+ /*  58 */ "carg ::= ccons",
+ /*  59 */ "ccons ::= DEFAULT term",
+ /*  60 */ "ccons ::= DEFAULT LP expr RP",
+ /*  61 */ "ccons ::= DEFAULT PLUS term",
+ /*  62 */ "ccons ::= DEFAULT MINUS term",
+ /*  63 */ "ccons ::= DEFAULT id",
+ /*  64 */ "ccons ::= NULL onconf",
+ /*  65 */ "ccons ::= NOT NULL onconf",
+ /*  66 */ "ccons ::= PRIMARY KEY sortorder onconf autoinc",
+ /*  67 */ "ccons ::= UNIQUE onconf",
+ /*  68 */ "ccons ::= CHECK LP expr RP",
+ /*  69 */ "ccons ::= REFERENCES nm idxlist_opt refargs",
+ /*  70 */ "ccons ::= defer_subclause",
+ /*  71 */ "ccons ::= COLLATE ids",
+ /*  72 */ "autoinc ::=",
+ /*  73 */ "autoinc ::= AUTOINCR",
+ /*  74 */ "refargs ::=",
+ /*  75 */ "refargs ::= refargs refarg",
+ /*  76 */ "refarg ::= MATCH nm",
+ /*  77 */ "refarg ::= ON INSERT refact",
+ /*  78 */ "refarg ::= ON DELETE refact",
+ /*  79 */ "refarg ::= ON UPDATE refact",
+ /*  80 */ "refact ::= SET NULL",
+ /*  81 */ "refact ::= SET DEFAULT",
+ /*  82 */ "refact ::= CASCADE",
+ /*  83 */ "refact ::= RESTRICT",
+ /*  84 */ "refact ::= NO ACTION",
+ /*  85 */ "defer_subclause ::= NOT DEFERRABLE init_deferred_pred_opt",
+ /*  86 */ "defer_subclause ::= DEFERRABLE init_deferred_pred_opt",
+ /*  87 */ "init_deferred_pred_opt ::=",
+ /*  88 */ "init_deferred_pred_opt ::= INITIALLY DEFERRED",
+ /*  89 */ "init_deferred_pred_opt ::= INITIALLY IMMEDIATE",
+ /*  90 */ "conslist_opt ::=",
+ /*  91 */ "conslist_opt ::= COMMA conslist",
+ /*  92 */ "conslist ::= conslist COMMA tcons",
+ /*  93 */ "conslist ::= conslist tcons",
+ /*  94 */ "conslist ::= tcons",
+ /*  95 */ "tcons ::= CONSTRAINT nm",
+ /*  96 */ "tcons ::= PRIMARY KEY LP idxlist autoinc RP onconf",
+ /*  97 */ "tcons ::= UNIQUE LP idxlist RP onconf",
+ /*  98 */ "tcons ::= CHECK LP expr RP onconf",
+ /*  99 */ "tcons ::= FOREIGN KEY LP idxlist RP REFERENCES nm idxlist_opt refargs defer_subclause_opt",
+ /* 100 */ "defer_subclause_opt ::=",
+ /* 101 */ "defer_subclause_opt ::= defer_subclause",
+ /* 102 */ "onconf ::=",
+ /* 103 */ "onconf ::= ON CONFLICT resolvetype",
+ /* 104 */ "orconf ::=",
+ /* 105 */ "orconf ::= OR resolvetype",
+ /* 106 */ "resolvetype ::= raisetype",
+ /* 107 */ "resolvetype ::= IGNORE",
+ /* 108 */ "resolvetype ::= REPLACE",
+ /* 109 */ "cmd ::= DROP TABLE ifexists fullname",
+ /* 110 */ "ifexists ::= IF EXISTS",
+ /* 111 */ "ifexists ::=",
+ /* 112 */ "cmd ::= createkw temp VIEW ifnotexists nm dbnm AS select",
+ /* 113 */ "cmd ::= DROP VIEW ifexists fullname",
+ /* 114 */ "cmd ::= select",
+ /* 115 */ "select ::= oneselect",
+ /* 116 */ "select ::= select multiselect_op oneselect",
+ /* 117 */ "multiselect_op ::= UNION",
+ /* 118 */ "multiselect_op ::= UNION ALL",
+ /* 119 */ "multiselect_op ::= EXCEPT|INTERSECT",
+ /* 120 */ "oneselect ::= SELECT distinct selcollist from where_opt groupby_opt having_opt orderby_opt limit_opt",
+ /* 121 */ "distinct ::= DISTINCT",
+ /* 122 */ "distinct ::= ALL",
+ /* 123 */ "distinct ::=",
+ /* 124 */ "sclp ::= selcollist COMMA",
+ /* 125 */ "sclp ::=",
+ /* 126 */ "selcollist ::= sclp expr as",
+ /* 127 */ "selcollist ::= sclp STAR",
+ /* 128 */ "selcollist ::= sclp nm DOT STAR",
+ /* 129 */ "as ::= AS nm",
+ /* 130 */ "as ::= ids",
+ /* 131 */ "as ::=",
+ /* 132 */ "from ::=",
+ /* 133 */ "from ::= FROM seltablist",
+ /* 134 */ "stl_prefix ::= seltablist joinop",
+ /* 135 */ "stl_prefix ::=",
+ /* 136 */ "seltablist ::= stl_prefix nm dbnm as indexed_opt on_opt using_opt",
+ /* 137 */ "seltablist ::= stl_prefix LP select RP as on_opt using_opt",
+ /* 138 */ "seltablist ::= stl_prefix LP seltablist RP as on_opt using_opt",
+ /* 139 */ "dbnm ::=",
+ /* 140 */ "dbnm ::= DOT nm",
+ /* 141 */ "fullname ::= nm dbnm",
+ /* 142 */ "joinop ::= COMMA|JOIN",
+ /* 143 */ "joinop ::= JOIN_KW JOIN",
+ /* 144 */ "joinop ::= JOIN_KW nm JOIN",
+ /* 145 */ "joinop ::= JOIN_KW nm nm JOIN",
+ /* 146 */ "on_opt ::= ON expr",
+ /* 147 */ "on_opt ::=",
+ /* 148 */ "indexed_opt ::=",
+ /* 149 */ "indexed_opt ::= INDEXED BY nm",
+ /* 150 */ "indexed_opt ::= NOT INDEXED",
+ /* 151 */ "using_opt ::= USING LP inscollist RP",
+ /* 152 */ "using_opt ::=",
+ /* 153 */ "orderby_opt ::=",
+ /* 154 */ "orderby_opt ::= ORDER BY sortlist",
+ /* 155 */ "sortlist ::= sortlist COMMA sortitem sortorder",
+ /* 156 */ "sortlist ::= sortitem sortorder",
+ /* 157 */ "sortitem ::= expr",
+ /* 158 */ "sortorder ::= ASC",
+ /* 159 */ "sortorder ::= DESC",
+ /* 160 */ "sortorder ::=",
+ /* 161 */ "groupby_opt ::=",
+ /* 162 */ "groupby_opt ::= GROUP BY nexprlist",
+ /* 163 */ "having_opt ::=",
+ /* 164 */ "having_opt ::= HAVING expr",
+ /* 165 */ "limit_opt ::=",
+ /* 166 */ "limit_opt ::= LIMIT expr",
+ /* 167 */ "limit_opt ::= LIMIT expr OFFSET expr",
+ /* 168 */ "limit_opt ::= LIMIT expr COMMA expr",
+ /* 169 */ "cmd ::= DELETE FROM fullname indexed_opt where_opt",
+ /* 170 */ "where_opt ::=",
+ /* 171 */ "where_opt ::= WHERE expr",
+ /* 172 */ "cmd ::= UPDATE orconf fullname indexed_opt SET setlist where_opt",
+ /* 173 */ "setlist ::= setlist COMMA nm EQ expr",
+ /* 174 */ "setlist ::= nm EQ expr",
+ /* 175 */ "cmd ::= insert_cmd INTO fullname inscollist_opt valuelist",
+ /* 176 */ "cmd ::= insert_cmd INTO fullname inscollist_opt select",
+ /* 177 */ "cmd ::= insert_cmd INTO fullname inscollist_opt DEFAULT VALUES",
+ /* 178 */ "insert_cmd ::= INSERT orconf",
+ /* 179 */ "insert_cmd ::= REPLACE",
+ /* 180 */ "valuelist ::= VALUES LP nexprlist RP",
+ /* 181 */ "valuelist ::= valuelist COMMA LP exprlist RP",
+ /* 182 */ "inscollist_opt ::=",
+ /* 183 */ "inscollist_opt ::= LP inscollist RP",
+ /* 184 */ "inscollist ::= inscollist COMMA nm",
+ /* 185 */ "inscollist ::= nm",
+ /* 186 */ "expr ::= term",
+ /* 187 */ "expr ::= LP expr RP",
+ /* 188 */ "term ::= NULL",
+ /* 189 */ "expr ::= id",
+ /* 190 */ "expr ::= JOIN_KW",
+ /* 191 */ "expr ::= nm DOT nm",
+ /* 192 */ "expr ::= nm DOT nm DOT nm",
+ /* 193 */ "term ::= INTEGER|FLOAT|BLOB",
+ /* 194 */ "term ::= STRING",
+ /* 195 */ "expr ::= REGISTER",
+ /* 196 */ "expr ::= VARIABLE",
+ /* 197 */ "expr ::= expr COLLATE ids",
+ /* 198 */ "expr ::= CAST LP expr AS typetoken RP",
+ /* 199 */ "expr ::= ID LP distinct exprlist RP",
+ /* 200 */ "expr ::= ID LP STAR RP",
+ /* 201 */ "term ::= CTIME_KW",
+ /* 202 */ "expr ::= expr AND expr",
+ /* 203 */ "expr ::= expr OR expr",
+ /* 204 */ "expr ::= expr LT|GT|GE|LE expr",
+ /* 205 */ "expr ::= expr EQ|NE expr",
+ /* 206 */ "expr ::= expr BITAND|BITOR|LSHIFT|RSHIFT expr",
+ /* 207 */ "expr ::= expr PLUS|MINUS expr",
+ /* 208 */ "expr ::= expr STAR|SLASH|REM expr",
+ /* 209 */ "expr ::= expr CONCAT expr",
+ /* 210 */ "likeop ::= LIKE_KW",
+ /* 211 */ "likeop ::= NOT LIKE_KW",
+ /* 212 */ "likeop ::= NOT MATCH",
+ /* 213 */ "expr ::= expr likeop expr",
+ /* 214 */ "expr ::= expr likeop expr ESCAPE expr",
+ /* 215 */ "expr ::= expr MATCH expr",
+ /* 216 */ "expr ::= expr ISNULL|NOTNULL",
+ /* 217 */ "expr ::= expr NOT NULL",
+ /* 218 */ "expr ::= expr IS expr",
+ /* 219 */ "expr ::= expr IS NOT expr",
+ /* 220 */ "expr ::= NOT expr",
+ /* 221 */ "expr ::= BITNOT expr",
+ /* 222 */ "expr ::= MINUS expr",
+ /* 223 */ "expr ::= PLUS expr",
+ /* 224 */ "between_op ::= BETWEEN",
+ /* 225 */ "between_op ::= NOT BETWEEN",
+ /* 226 */ "expr ::= expr between_op expr AND expr",
+ /* 227 */ "in_op ::= IN",
+ /* 228 */ "in_op ::= NOT IN",
+ /* 229 */ "expr ::= expr in_op LP exprlist RP",
+ /* 230 */ "expr ::= LP select RP",
+ /* 231 */ "expr ::= expr in_op LP select RP",
+ /* 232 */ "expr ::= expr in_op nm dbnm",
+ /* 233 */ "expr ::= EXISTS LP select RP",
+ /* 234 */ "expr ::= CASE case_operand case_exprlist case_else END",
+ /* 235 */ "case_exprlist ::= case_exprlist WHEN expr THEN expr",
+ /* 236 */ "case_exprlist ::= WHEN expr THEN expr",
+ /* 237 */ "case_else ::= ELSE expr",
+ /* 238 */ "case_else ::=",
+ /* 239 */ "case_operand ::= expr",
+ /* 240 */ "case_operand ::=",
+ /* 241 */ "exprlist ::= nexprlist",
+ /* 242 */ "exprlist ::=",
+ /* 243 */ "nexprlist ::= nexprlist COMMA expr",
+ /* 244 */ "nexprlist ::= expr",
+ /* 245 */ "createindex ::= createkw uniqueflag INDEX ifnotexists nm dbnm ON nm",
+ /* 246 */ "cmd ::= createindex LP idxlist RP covering_opt",
+ /* 247 */ "uniqueflag ::= UNIQUE",
+ /* 248 */ "uniqueflag ::=",
+ /* 249 */ "idxlist_opt ::=",
+ /* 250 */ "idxlist_opt ::= LP idxlist RP",
+ /* 251 */ "idxlist ::= idxlist COMMA nm collate sortorder",
+ /* 252 */ "idxlist ::= nm collate sortorder",
+ /* 253 */ "collate ::=",
+ /* 254 */ "collate ::= COLLATE ids",
+ /* 255 */ "cmd ::= createindex USING nm LP uidxlist_opt RP",
+ /* 256 */ "uidxlist_opt ::= uidxlist",
+ /* 257 */ "uidxlist_opt ::=",
+ /* 258 */ "uidxlist ::= uidxlist COMMA ids EQ ids",
+ /* 259 */ "uidxlist ::= uidxlist COMMA ids",
+ /* 260 */ "uidxlist ::= ids EQ ids",
+ /* 261 */ "uidxlist ::= ids",
+ /* 262 */ "covering_opt ::=",
+ /* 263 */ "covering_opt ::= COVERING ALL",
+ /* 264 */ "covering_opt ::= COVERING LP inscollist RP",
+ /* 265 */ "cmd ::= DROP INDEX ifexists fullname",
+ /* 266 */ "cmd ::= PRAGMA nm dbnm",
+ /* 267 */ "cmd ::= PRAGMA nm dbnm LP RP",
+ /* 268 */ "cmd ::= PRAGMA nm dbnm LP pragmaargs RP",
+ /* 269 */ "cmd ::= PRAGMA nm dbnm EQ pragmaarg",
+ /* 270 */ "pragmaargs ::= pragmaarg",
+ /* 271 */ "pragmaargs ::= pragmaargs COMMA expr",
+ /* 272 */ "pragmaarg ::= expr",
+ /* 273 */ "pragmaarg ::= ON",
+ /* 274 */ "pragmaarg ::= DELETE",
+ /* 275 */ "pragmaarg ::= DEFAULT",
+ /* 276 */ "plus_num ::= plus_opt number",
+ /* 277 */ "minus_num ::= MINUS number",
+ /* 278 */ "number ::= INTEGER|FLOAT",
+ /* 279 */ "plus_opt ::= PLUS",
+ /* 280 */ "plus_opt ::=",
+ /* 281 */ "cmd ::= createkw trigger_decl BEGIN trigger_cmd_list END",
+ /* 282 */ "trigger_decl ::= temp TRIGGER ifnotexists nm dbnm trigger_time trigger_event ON fullname foreach_clause when_clause",
+ /* 283 */ "trigger_time ::= BEFORE",
+ /* 284 */ "trigger_time ::= AFTER",
+ /* 285 */ "trigger_time ::= INSTEAD OF",
+ /* 286 */ "trigger_time ::=",
+ /* 287 */ "trigger_event ::= DELETE|INSERT",
+ /* 288 */ "trigger_event ::= UPDATE",
+ /* 289 */ "trigger_event ::= UPDATE OF inscollist",
+ /* 290 */ "foreach_clause ::=",
+ /* 291 */ "foreach_clause ::= FOR EACH ROW",
+ /* 292 */ "when_clause ::=",
+ /* 293 */ "when_clause ::= WHEN expr",
+ /* 294 */ "trigger_cmd_list ::= trigger_cmd_list trigger_cmd SEMI",
+ /* 295 */ "trigger_cmd_list ::= trigger_cmd SEMI",
+ /* 296 */ "trnm ::= nm",
+ /* 297 */ "trnm ::= nm DOT nm",
+ /* 298 */ "tridxby ::=",
+ /* 299 */ "tridxby ::= INDEXED BY nm",
+ /* 300 */ "tridxby ::= NOT INDEXED",
+ /* 301 */ "trigger_cmd ::= UPDATE orconf trnm tridxby SET setlist where_opt",
+ /* 302 */ "trigger_cmd ::= insert_cmd INTO trnm inscollist_opt valuelist",
+ /* 303 */ "trigger_cmd ::= insert_cmd INTO trnm inscollist_opt select",
+ /* 304 */ "trigger_cmd ::= DELETE FROM trnm tridxby where_opt",
+ /* 305 */ "trigger_cmd ::= select",
+ /* 306 */ "expr ::= RAISE LP IGNORE RP",
+ /* 307 */ "expr ::= RAISE LP raisetype COMMA nm RP",
+ /* 308 */ "raisetype ::= ROLLBACK",
+ /* 309 */ "raisetype ::= ABORT",
+ /* 310 */ "raisetype ::= FAIL",
+ /* 311 */ "cmd ::= DROP TRIGGER ifexists fullname",
+ /* 312 */ "cmd ::= ATTACH database_kw_opt expr AS expr key_opt",
+ /* 313 */ "cmd ::= DETACH database_kw_opt expr",
+ /* 314 */ "key_opt ::=",
+ /* 315 */ "key_opt ::= KEY expr",
+ /* 316 */ "database_kw_opt ::= DATABASE",
+ /* 317 */ "database_kw_opt ::=",
+ /* 318 */ "cmd ::= REINDEX",
+ /* 319 */ "cmd ::= REINDEX nm dbnm",
+ /* 320 */ "cmd ::= ANALYZE",
+ /* 321 */ "cmd ::= ANALYZE nm dbnm",
+ /* 322 */ "cmd ::= ALTER TABLE fullname RENAME TO nm",
+ /* 323 */ "cmd ::= ALTER TABLE add_column_fullname ADD kwcolumn_opt column",
+ /* 324 */ "add_column_fullname ::= fullname",
+ /* 325 */ "kwcolumn_opt ::=",
+ /* 326 */ "kwcolumn_opt ::= COLUMNKW",
 };
 #endif /* NDEBUG */
 
@@ -1411,113 +1416,113 @@ static void yy_destructor(
     ** which appear on the RHS of the rule, but which are not used
     ** inside the C code.
     */
-    case 160: /* select */
-    case 194: /* oneselect */
+    case 161: /* select */
+    case 195: /* oneselect */
 {
-#line 417 "parse.y"
-sqlite4SelectDelete(pParse->db, (yypminor->yy243));
-#line 1420 "parse.c"
+#line 427 "parse.y"
+sqlite4SelectDelete(pParse->db, (yypminor->yy387));
+#line 1425 "parse.c"
 }
       break;
-    case 174: /* term */
-    case 175: /* expr */
+    case 175: /* term */
+    case 176: /* expr */
 {
-#line 760 "parse.y"
-sqlite4ExprDelete(pParse->db, (yypminor->yy190).pExpr);
-#line 1428 "parse.c"
+#line 770 "parse.y"
+sqlite4ExprDelete(pParse->db, (yypminor->yy118).pExpr);
+#line 1433 "parse.c"
 }
       break;
-    case 179: /* idxlist_opt */
-    case 187: /* idxlist */
-    case 197: /* selcollist */
-    case 200: /* groupby_opt */
-    case 202: /* orderby_opt */
-    case 204: /* sclp */
-    case 214: /* sortlist */
-    case 216: /* nexprlist */
-    case 217: /* setlist */
-    case 221: /* exprlist */
-    case 226: /* case_exprlist */
-    case 232: /* uidxlist_opt */
-    case 233: /* uidxlist */
-    case 234: /* pragmaargs */
-    case 235: /* pragmaarg */
-{
-#line 1158 "parse.y"
-sqlite4ExprListDelete(pParse->db, (yypminor->yy148));
-#line 1449 "parse.c"
+    case 180: /* idxlist_opt */
+    case 188: /* idxlist */
+    case 198: /* selcollist */
+    case 201: /* groupby_opt */
+    case 203: /* orderby_opt */
+    case 205: /* sclp */
+    case 215: /* sortlist */
+    case 217: /* nexprlist */
+    case 218: /* setlist */
+    case 222: /* exprlist */
+    case 227: /* case_exprlist */
+    case 233: /* uidxlist_opt */
+    case 234: /* uidxlist */
+    case 235: /* pragmaargs */
+    case 236: /* pragmaarg */
+{
+#line 1168 "parse.y"
+sqlite4ExprListDelete(pParse->db, (yypminor->yy322));
+#line 1454 "parse.c"
 }
       break;
-    case 193: /* fullname */
-    case 198: /* from */
-    case 206: /* seltablist */
-    case 207: /* stl_prefix */
+    case 194: /* fullname */
+    case 199: /* from */
+    case 207: /* seltablist */
+    case 208: /* stl_prefix */
 {
-#line 548 "parse.y"
-sqlite4SrcListDelete(pParse->db, (yypminor->yy185));
-#line 1459 "parse.c"
+#line 558 "parse.y"
+sqlite4SrcListDelete(pParse->db, (yypminor->yy259));
+#line 1464 "parse.c"
 }
       break;
-    case 199: /* where_opt */
-    case 201: /* having_opt */
-    case 210: /* on_opt */
-    case 215: /* sortitem */
-    case 225: /* case_operand */
-    case 227: /* case_else */
-    case 243: /* when_clause */
-    case 248: /* key_opt */
-{
-#line 658 "parse.y"
-sqlite4ExprDelete(pParse->db, (yypminor->yy72));
-#line 1473 "parse.c"
+    case 200: /* where_opt */
+    case 202: /* having_opt */
+    case 211: /* on_opt */
+    case 216: /* sortitem */
+    case 226: /* case_operand */
+    case 228: /* case_else */
+    case 244: /* when_clause */
+    case 249: /* key_opt */
+{
+#line 668 "parse.y"
+sqlite4ExprDelete(pParse->db, (yypminor->yy314));
+#line 1478 "parse.c"
 }
       break;
-    case 211: /* using_opt */
-    case 213: /* inscollist */
-    case 219: /* inscollist_opt */
+    case 212: /* using_opt */
+    case 214: /* inscollist */
+    case 220: /* inscollist_opt */
 {
-#line 580 "parse.y"
-sqlite4IdListDelete(pParse->db, (yypminor->yy254));
-#line 1482 "parse.c"
+#line 590 "parse.y"
+sqlite4IdListDelete(pParse->db, (yypminor->yy384));
+#line 1487 "parse.c"
 }
       break;
-    case 220: /* valuelist */
+    case 221: /* valuelist */
 {
-#line 714 "parse.y"
+#line 724 "parse.y"
 
-  sqlite4ExprListDelete(pParse->db, (yypminor->yy167).pList);
-  sqlite4SelectDelete(pParse->db, (yypminor->yy167).pSelect);
+  sqlite4ExprListDelete(pParse->db, (yypminor->yy260).pList);
+  sqlite4SelectDelete(pParse->db, (yypminor->yy260).pSelect);
 
-#line 1492 "parse.c"
+#line 1497 "parse.c"
 }
       break;
-    case 228: /* createindex */
+    case 229: /* createindex */
 {
-#line 1134 "parse.y"
-sqlite4SrcListDelete(pParse->db, (yypminor->yy195).pTblName);
-#line 1499 "parse.c"
+#line 1144 "parse.y"
+sqlite4SrcListDelete(pParse->db, (yypminor->yy233).pTblName);
+#line 1504 "parse.c"
 }
       break;
-    case 230: /* covering_opt */
+    case 231: /* covering_opt */
 {
-#line 1217 "parse.y"
-sqlite4IdListDelete(pParse->db, (yypminor->yy376).pList);
-#line 1506 "parse.c"
+#line 1227 "parse.y"
+sqlite4IdListDelete(pParse->db, (yypminor->yy422).pList);
+#line 1511 "parse.c"
 }
       break;
-    case 239: /* trigger_cmd_list */
-    case 244: /* trigger_cmd */
+    case 240: /* trigger_cmd_list */
+    case 245: /* trigger_cmd */
 {
-#line 1329 "parse.y"
-sqlite4DeleteTriggerStep(pParse->db, (yypminor->yy145));
-#line 1514 "parse.c"
+#line 1339 "parse.y"
+sqlite4DeleteTriggerStep(pParse->db, (yypminor->yy203));
+#line 1519 "parse.c"
 }
       break;
-    case 241: /* trigger_event */
+    case 242: /* trigger_event */
 {
-#line 1315 "parse.y"
-sqlite4IdListDelete(pParse->db, (yypminor->yy332).b);
-#line 1521 "parse.c"
+#line 1325 "parse.y"
+sqlite4IdListDelete(pParse->db, (yypminor->yy90).b);
+#line 1526 "parse.c"
 }
       break;
     default:  break;   /* If no destructor action specified: do nothing */
@@ -1707,7 +1712,7 @@ static void yyStackOverflow(yyParser *yypParser, YYMINORTYPE *yypMinor){
 
   UNUSED_PARAMETER(yypMinor); /* Silence some compiler warnings */
   sqlite4ErrorMsg(pParse, "parser stack overflow");
-#line 1711 "parse.c"
+#line 1716 "parse.c"
    sqlite4ParserARG_STORE; /* Suppress warning about unused %extra_argument var */
 }
 
@@ -1764,331 +1769,333 @@ static const struct {
   YYCODETYPE lhs;         /* Symbol on the left-hand side of the rule */
   unsigned char nrhs;     /* Number of right-hand side symbols in the rule */
 } yyRuleInfo[] = {
-  { 142, 1 },
-  { 143, 2 },
   { 143, 1 },
+  { 144, 2 },
   { 144, 1 },
-  { 144, 3 },
-  { 145, 0 },
   { 145, 1 },
   { 145, 3 },
+  { 146, 0 },
   { 146, 1 },
-  { 147, 3 },
+  { 146, 3 },
+  { 146, 2 },
+  { 146, 2 },
+  { 147, 1 },
+  { 148, 3 },
+  { 150, 0 },
+  { 150, 1 },
+  { 150, 2 },
   { 149, 0 },
   { 149, 1 },
-  { 149, 2 },
-  { 148, 0 },
-  { 148, 1 },
-  { 148, 1 },
-  { 148, 1 },
-  { 147, 2 },
-  { 147, 2 },
-  { 147, 2 },
-  { 151, 1 },
-  { 151, 0 },
-  { 147, 2 },
-  { 147, 3 },
-  { 147, 5 },
-  { 147, 2 },
-  { 152, 6 },
-  { 154, 1 },
-  { 156, 0 },
-  { 156, 3 },
+  { 149, 1 },
+  { 149, 1 },
+  { 148, 2 },
+  { 148, 2 },
+  { 148, 2 },
+  { 152, 1 },
+  { 152, 0 },
+  { 148, 2 },
+  { 148, 3 },
+  { 148, 5 },
+  { 148, 2 },
+  { 153, 6 },
   { 155, 1 },
-  { 155, 0 },
-  { 153, 4 },
-  { 153, 2 },
-  { 158, 3 },
-  { 158, 1 },
-  { 161, 3 },
-  { 162, 1 },
-  { 165, 1 },
-  { 165, 1 },
-  { 166, 1 },
-  { 150, 1 },
-  { 150, 1 },
-  { 150, 1 },
-  { 163, 0 },
+  { 157, 0 },
+  { 157, 3 },
+  { 156, 1 },
+  { 156, 0 },
+  { 154, 4 },
+  { 154, 2 },
+  { 159, 3 },
+  { 159, 1 },
+  { 162, 3 },
   { 163, 1 },
+  { 166, 1 },
+  { 166, 1 },
   { 167, 1 },
-  { 167, 4 },
-  { 167, 6 },
+  { 151, 1 },
+  { 151, 1 },
+  { 151, 1 },
+  { 164, 0 },
+  { 164, 1 },
   { 168, 1 },
-  { 168, 2 },
-  { 169, 1 },
+  { 168, 4 },
+  { 168, 6 },
   { 169, 1 },
-  { 164, 2 },
-  { 164, 0 },
-  { 172, 3 },
-  { 172, 1 },
-  { 173, 2 },
-  { 173, 4 },
-  { 173, 3 },
-  { 173, 3 },
-  { 173, 2 },
-  { 173, 2 },
+  { 169, 2 },
+  { 170, 1 },
+  { 170, 1 },
+  { 165, 2 },
+  { 165, 0 },
   { 173, 3 },
-  { 173, 5 },
-  { 173, 2 },
-  { 173, 4 },
-  { 173, 4 },
   { 173, 1 },
-  { 173, 2 },
-  { 178, 0 },
-  { 178, 1 },
-  { 180, 0 },
-  { 180, 2 },
-  { 182, 2 },
-  { 182, 3 },
-  { 182, 3 },
-  { 182, 3 },
-  { 183, 2 },
-  { 183, 2 },
-  { 183, 1 },
-  { 183, 1 },
-  { 183, 2 },
-  { 181, 3 },
+  { 174, 2 },
+  { 174, 4 },
+  { 174, 3 },
+  { 174, 3 },
+  { 174, 2 },
+  { 174, 2 },
+  { 174, 3 },
+  { 174, 5 },
+  { 174, 2 },
+  { 174, 4 },
+  { 174, 4 },
+  { 174, 1 },
+  { 174, 2 },
+  { 179, 0 },
+  { 179, 1 },
+  { 181, 0 },
   { 181, 2 },
-  { 184, 0 },
+  { 183, 2 },
+  { 183, 3 },
+  { 183, 3 },
+  { 183, 3 },
+  { 184, 2 },
   { 184, 2 },
+  { 184, 1 },
+  { 184, 1 },
   { 184, 2 },
-  { 159, 0 },
-  { 159, 2 },
-  { 185, 3 },
+  { 182, 3 },
+  { 182, 2 },
+  { 185, 0 },
   { 185, 2 },
-  { 185, 1 },
+  { 185, 2 },
+  { 160, 0 },
+  { 160, 2 },
+  { 186, 3 },
   { 186, 2 },
-  { 186, 7 },
-  { 186, 5 },
-  { 186, 5 },
-  { 186, 10 },
-  { 188, 0 },
-  { 188, 1 },
-  { 176, 0 },
-  { 176, 3 },
+  { 186, 1 },
+  { 187, 2 },
+  { 187, 7 },
+  { 187, 5 },
+  { 187, 5 },
+  { 187, 10 },
   { 189, 0 },
-  { 189, 2 },
-  { 190, 1 },
-  { 190, 1 },
-  { 190, 1 },
-  { 147, 4 },
-  { 192, 2 },
-  { 192, 0 },
-  { 147, 8 },
-  { 147, 4 },
-  { 147, 1 },
-  { 160, 1 },
-  { 160, 3 },
-  { 195, 1 },
-  { 195, 2 },
-  { 195, 1 },
-  { 194, 9 },
+  { 189, 1 },
+  { 177, 0 },
+  { 177, 3 },
+  { 190, 0 },
+  { 190, 2 },
+  { 191, 1 },
+  { 191, 1 },
+  { 191, 1 },
+  { 148, 4 },
+  { 193, 2 },
+  { 193, 0 },
+  { 148, 8 },
+  { 148, 4 },
+  { 148, 1 },
+  { 161, 1 },
+  { 161, 3 },
   { 196, 1 },
+  { 196, 2 },
   { 196, 1 },
-  { 196, 0 },
-  { 204, 2 },
-  { 204, 0 },
-  { 197, 3 },
-  { 197, 2 },
-  { 197, 4 },
+  { 195, 9 },
+  { 197, 1 },
+  { 197, 1 },
+  { 197, 0 },
   { 205, 2 },
-  { 205, 1 },
   { 205, 0 },
-  { 198, 0 },
+  { 198, 3 },
   { 198, 2 },
-  { 207, 2 },
-  { 207, 0 },
-  { 206, 7 },
-  { 206, 7 },
-  { 206, 7 },
-  { 157, 0 },
-  { 157, 2 },
-  { 193, 2 },
-  { 208, 1 },
+  { 198, 4 },
+  { 206, 2 },
+  { 206, 1 },
+  { 206, 0 },
+  { 199, 0 },
+  { 199, 2 },
   { 208, 2 },
-  { 208, 3 },
-  { 208, 4 },
-  { 210, 2 },
-  { 210, 0 },
-  { 209, 0 },
-  { 209, 3 },
+  { 208, 0 },
+  { 207, 7 },
+  { 207, 7 },
+  { 207, 7 },
+  { 158, 0 },
+  { 158, 2 },
+  { 194, 2 },
+  { 209, 1 },
   { 209, 2 },
-  { 211, 4 },
+  { 209, 3 },
+  { 209, 4 },
+  { 211, 2 },
   { 211, 0 },
+  { 210, 0 },
+  { 210, 3 },
+  { 210, 2 },
+  { 212, 4 },
+  { 212, 0 },
+  { 203, 0 },
+  { 203, 3 },
+  { 215, 4 },
+  { 215, 2 },
+  { 216, 1 },
+  { 178, 1 },
+  { 178, 1 },
+  { 178, 0 },
+  { 201, 0 },
+  { 201, 3 },
   { 202, 0 },
-  { 202, 3 },
-  { 214, 4 },
-  { 214, 2 },
-  { 215, 1 },
-  { 177, 1 },
-  { 177, 1 },
-  { 177, 0 },
+  { 202, 2 },
+  { 204, 0 },
+  { 204, 2 },
+  { 204, 4 },
+  { 204, 4 },
+  { 148, 5 },
   { 200, 0 },
-  { 200, 3 },
-  { 201, 0 },
-  { 201, 2 },
-  { 203, 0 },
-  { 203, 2 },
-  { 203, 4 },
-  { 203, 4 },
-  { 147, 5 },
-  { 199, 0 },
-  { 199, 2 },
-  { 147, 7 },
-  { 217, 5 },
-  { 217, 3 },
-  { 147, 5 },
-  { 147, 5 },
-  { 147, 6 },
-  { 218, 2 },
-  { 218, 1 },
-  { 220, 4 },
-  { 220, 5 },
-  { 219, 0 },
-  { 219, 3 },
-  { 213, 3 },
-  { 213, 1 },
+  { 200, 2 },
+  { 148, 7 },
+  { 218, 5 },
+  { 218, 3 },
+  { 148, 5 },
+  { 148, 5 },
+  { 148, 6 },
+  { 219, 2 },
+  { 219, 1 },
+  { 221, 4 },
+  { 221, 5 },
+  { 220, 0 },
+  { 220, 3 },
+  { 214, 3 },
+  { 214, 1 },
+  { 176, 1 },
+  { 176, 3 },
   { 175, 1 },
-  { 175, 3 },
-  { 174, 1 },
+  { 176, 1 },
+  { 176, 1 },
+  { 176, 3 },
+  { 176, 5 },
   { 175, 1 },
   { 175, 1 },
-  { 175, 3 },
-  { 175, 5 },
-  { 174, 1 },
-  { 174, 1 },
-  { 175, 1 },
+  { 176, 1 },
+  { 176, 1 },
+  { 176, 3 },
+  { 176, 6 },
+  { 176, 5 },
+  { 176, 4 },
   { 175, 1 },
-  { 175, 3 },
-  { 175, 6 },
-  { 175, 5 },
-  { 175, 4 },
-  { 174, 1 },
-  { 175, 3 },
-  { 175, 3 },
-  { 175, 3 },
-  { 175, 3 },
-  { 175, 3 },
-  { 175, 3 },
-  { 175, 3 },
-  { 175, 3 },
-  { 222, 1 },
-  { 222, 2 },
-  { 222, 2 },
-  { 175, 3 },
-  { 175, 5 },
-  { 175, 3 },
-  { 175, 2 },
-  { 175, 3 },
-  { 175, 3 },
-  { 175, 4 },
-  { 175, 2 },
-  { 175, 2 },
-  { 175, 2 },
-  { 175, 2 },
+  { 176, 3 },
+  { 176, 3 },
+  { 176, 3 },
+  { 176, 3 },
+  { 176, 3 },
+  { 176, 3 },
+  { 176, 3 },
+  { 176, 3 },
   { 223, 1 },
   { 223, 2 },
-  { 175, 5 },
+  { 223, 2 },
+  { 176, 3 },
+  { 176, 5 },
+  { 176, 3 },
+  { 176, 2 },
+  { 176, 3 },
+  { 176, 3 },
+  { 176, 4 },
+  { 176, 2 },
+  { 176, 2 },
+  { 176, 2 },
+  { 176, 2 },
   { 224, 1 },
   { 224, 2 },
-  { 175, 5 },
-  { 175, 3 },
-  { 175, 5 },
-  { 175, 4 },
-  { 175, 4 },
-  { 175, 5 },
-  { 226, 5 },
-  { 226, 4 },
-  { 227, 2 },
-  { 227, 0 },
+  { 176, 5 },
   { 225, 1 },
-  { 225, 0 },
-  { 221, 1 },
-  { 221, 0 },
-  { 216, 3 },
-  { 216, 1 },
-  { 228, 8 },
-  { 147, 5 },
-  { 229, 1 },
-  { 229, 0 },
-  { 179, 0 },
-  { 179, 3 },
-  { 187, 5 },
-  { 187, 3 },
-  { 231, 0 },
-  { 231, 2 },
-  { 147, 6 },
-  { 232, 1 },
+  { 225, 2 },
+  { 176, 5 },
+  { 176, 3 },
+  { 176, 5 },
+  { 176, 4 },
+  { 176, 4 },
+  { 176, 5 },
+  { 227, 5 },
+  { 227, 4 },
+  { 228, 2 },
+  { 228, 0 },
+  { 226, 1 },
+  { 226, 0 },
+  { 222, 1 },
+  { 222, 0 },
+  { 217, 3 },
+  { 217, 1 },
+  { 229, 8 },
+  { 148, 5 },
+  { 230, 1 },
+  { 230, 0 },
+  { 180, 0 },
+  { 180, 3 },
+  { 188, 5 },
+  { 188, 3 },
   { 232, 0 },
-  { 233, 5 },
-  { 233, 3 },
-  { 233, 3 },
+  { 232, 2 },
+  { 148, 6 },
   { 233, 1 },
-  { 230, 0 },
-  { 230, 2 },
-  { 230, 4 },
-  { 147, 4 },
-  { 147, 3 },
-  { 147, 5 },
-  { 147, 6 },
-  { 147, 5 },
-  { 234, 1 },
+  { 233, 0 },
+  { 234, 5 },
   { 234, 3 },
+  { 234, 3 },
+  { 234, 1 },
+  { 231, 0 },
+  { 231, 2 },
+  { 231, 4 },
+  { 148, 4 },
+  { 148, 3 },
+  { 148, 5 },
+  { 148, 6 },
+  { 148, 5 },
   { 235, 1 },
-  { 235, 1 },
-  { 235, 1 },
-  { 235, 1 },
-  { 170, 2 },
+  { 235, 3 },
+  { 236, 1 },
+  { 236, 1 },
+  { 236, 1 },
+  { 236, 1 },
   { 171, 2 },
+  { 172, 2 },
+  { 238, 1 },
   { 237, 1 },
-  { 236, 1 },
-  { 236, 0 },
-  { 147, 5 },
-  { 238, 11 },
-  { 240, 1 },
-  { 240, 1 },
-  { 240, 2 },
-  { 240, 0 },
+  { 237, 0 },
+  { 148, 5 },
+  { 239, 11 },
   { 241, 1 },
   { 241, 1 },
-  { 241, 3 },
-  { 242, 0 },
+  { 241, 2 },
+  { 241, 0 },
+  { 242, 1 },
+  { 242, 1 },
   { 242, 3 },
   { 243, 0 },
-  { 243, 2 },
-  { 239, 3 },
-  { 239, 2 },
-  { 245, 1 },
-  { 245, 3 },
-  { 246, 0 },
+  { 243, 3 },
+  { 244, 0 },
+  { 244, 2 },
+  { 240, 3 },
+  { 240, 2 },
+  { 246, 1 },
   { 246, 3 },
-  { 246, 2 },
-  { 244, 7 },
-  { 244, 5 },
-  { 244, 5 },
-  { 244, 5 },
-  { 244, 1 },
-  { 175, 4 },
-  { 175, 6 },
-  { 191, 1 },
-  { 191, 1 },
-  { 191, 1 },
-  { 147, 4 },
-  { 147, 6 },
-  { 147, 3 },
-  { 248, 0 },
-  { 248, 2 },
-  { 247, 1 },
   { 247, 0 },
-  { 147, 1 },
-  { 147, 3 },
-  { 147, 1 },
-  { 147, 3 },
-  { 147, 6 },
-  { 147, 6 },
-  { 249, 1 },
-  { 250, 0 },
+  { 247, 3 },
+  { 247, 2 },
+  { 245, 7 },
+  { 245, 5 },
+  { 245, 5 },
+  { 245, 5 },
+  { 245, 1 },
+  { 176, 4 },
+  { 176, 6 },
+  { 192, 1 },
+  { 192, 1 },
+  { 192, 1 },
+  { 148, 4 },
+  { 148, 6 },
+  { 148, 3 },
+  { 249, 0 },
+  { 249, 2 },
+  { 248, 1 },
+  { 248, 0 },
+  { 148, 1 },
+  { 148, 3 },
+  { 148, 1 },
+  { 148, 3 },
+  { 148, 6 },
+  { 148, 6 },
   { 250, 1 },
+  { 251, 0 },
+  { 251, 1 },
 };
 
 static void yy_accept(yyParser*);  /* Forward Declaration */
@@ -2146,1009 +2153,1019 @@ static void yy_reduce(
       case 5: /* explain ::= */
 #line 118 "parse.y"
 { sqlite4BeginParse(pParse, 0); }
-#line 2150 "parse.c"
+#line 2157 "parse.c"
         break;
       case 6: /* explain ::= EXPLAIN */
 #line 120 "parse.y"
 { sqlite4BeginParse(pParse, 1); }
-#line 2155 "parse.c"
+#line 2162 "parse.c"
         break;
       case 7: /* explain ::= EXPLAIN QUERY PLAN */
 #line 121 "parse.y"
 { sqlite4BeginParse(pParse, 2); }
-#line 2160 "parse.c"
+#line 2167 "parse.c"
         break;
-      case 8: /* cmdx ::= cmd */
+      case 8: /* explain ::= EXPLAIN PROFILE */
+#line 122 "parse.y"
+{ sqlite4BeginParse(pParse, 3); }
+#line 2172 "parse.c"
+        break;
+      case 9: /* explain ::= EXPLAIN ANALYZE */
 #line 123 "parse.y"
+{ sqlite4BeginParse(pParse, 4); }
+#line 2177 "parse.c"
+        break;
+      case 10: /* cmdx ::= cmd */
+#line 133 "parse.y"
 { sqlite4FinishCoding(pParse); }
-#line 2165 "parse.c"
+#line 2182 "parse.c"
         break;
-      case 9: /* cmd ::= BEGIN transtype trans_opt */
-#line 128 "parse.y"
-{sqlite4BeginTransaction(pParse, yymsp[-1].minor.yy194);}
-#line 2170 "parse.c"
+      case 11: /* cmd ::= BEGIN transtype trans_opt */
+#line 138 "parse.y"
+{sqlite4BeginTransaction(pParse, yymsp[-1].minor.yy4);}
+#line 2187 "parse.c"
         break;
-      case 13: /* transtype ::= */
-#line 133 "parse.y"
-{yygotominor.yy194 = TK_DEFERRED;}
-#line 2175 "parse.c"
-        break;
-      case 14: /* transtype ::= DEFERRED */
-      case 15: /* transtype ::= IMMEDIATE */ yytestcase(yyruleno==15);
-      case 16: /* transtype ::= EXCLUSIVE */ yytestcase(yyruleno==16);
-      case 115: /* multiselect_op ::= UNION */ yytestcase(yyruleno==115);
-      case 117: /* multiselect_op ::= EXCEPT|INTERSECT */ yytestcase(yyruleno==117);
-#line 134 "parse.y"
-{yygotominor.yy194 = yymsp[0].major;}
-#line 2184 "parse.c"
-        break;
-      case 17: /* cmd ::= COMMIT trans_opt */
-      case 18: /* cmd ::= END trans_opt */ yytestcase(yyruleno==18);
-#line 137 "parse.y"
+      case 15: /* transtype ::= */
+#line 143 "parse.y"
+{yygotominor.yy4 = TK_DEFERRED;}
+#line 2192 "parse.c"
+        break;
+      case 16: /* transtype ::= DEFERRED */
+      case 17: /* transtype ::= IMMEDIATE */ yytestcase(yyruleno==17);
+      case 18: /* transtype ::= EXCLUSIVE */ yytestcase(yyruleno==18);
+      case 117: /* multiselect_op ::= UNION */ yytestcase(yyruleno==117);
+      case 119: /* multiselect_op ::= EXCEPT|INTERSECT */ yytestcase(yyruleno==119);
+#line 144 "parse.y"
+{yygotominor.yy4 = yymsp[0].major;}
+#line 2201 "parse.c"
+        break;
+      case 19: /* cmd ::= COMMIT trans_opt */
+      case 20: /* cmd ::= END trans_opt */ yytestcase(yyruleno==20);
+#line 147 "parse.y"
 {sqlite4EndTransaction(pParse, SAVEPOINT_RELEASE);}
-#line 2190 "parse.c"
+#line 2207 "parse.c"
         break;
-      case 19: /* cmd ::= ROLLBACK trans_opt */
-#line 139 "parse.y"
+      case 21: /* cmd ::= ROLLBACK trans_opt */
+#line 149 "parse.y"
 {sqlite4EndTransaction(pParse, SAVEPOINT_ROLLBACK);}
-#line 2195 "parse.c"
+#line 2212 "parse.c"
         break;
-      case 22: /* cmd ::= SAVEPOINT nm */
-#line 143 "parse.y"
+      case 24: /* cmd ::= SAVEPOINT nm */
+#line 153 "parse.y"
 {
   sqlite4Savepoint(pParse, SAVEPOINT_BEGIN, &yymsp[0].minor.yy0);
 }
-#line 2202 "parse.c"
+#line 2219 "parse.c"
         break;
-      case 23: /* cmd ::= RELEASE savepoint_opt nm */
-#line 146 "parse.y"
+      case 25: /* cmd ::= RELEASE savepoint_opt nm */
+#line 156 "parse.y"
 {
   sqlite4Savepoint(pParse, SAVEPOINT_RELEASE, &yymsp[0].minor.yy0);
 }
-#line 2209 "parse.c"
+#line 2226 "parse.c"
         break;
-      case 24: /* cmd ::= ROLLBACK trans_opt TO savepoint_opt nm */
-#line 149 "parse.y"
+      case 26: /* cmd ::= ROLLBACK trans_opt TO savepoint_opt nm */
+#line 159 "parse.y"
 {
   sqlite4Savepoint(pParse, SAVEPOINT_ROLLBACK, &yymsp[0].minor.yy0);
 }
-#line 2216 "parse.c"
+#line 2233 "parse.c"
         break;
-      case 26: /* create_table ::= createkw temp TABLE ifnotexists nm dbnm */
-#line 156 "parse.y"
+      case 28: /* create_table ::= createkw temp TABLE ifnotexists nm dbnm */
+#line 166 "parse.y"
 {
-   sqlite4StartTable(pParse,&yymsp[-1].minor.yy0,&yymsp[0].minor.yy0,yymsp[-4].minor.yy194,0,0,yymsp[-2].minor.yy194);
+   sqlite4StartTable(pParse,&yymsp[-1].minor.yy0,&yymsp[0].minor.yy0,yymsp[-4].minor.yy4,0,0,yymsp[-2].minor.yy4);
 }
-#line 2223 "parse.c"
+#line 2240 "parse.c"
         break;
-      case 27: /* createkw ::= CREATE */
-#line 159 "parse.y"
+      case 29: /* createkw ::= CREATE */
+#line 169 "parse.y"
 {
   pParse->db->lookaside.bEnabled = 0;
   yygotominor.yy0 = yymsp[0].minor.yy0;
 }
-#line 2231 "parse.c"
-        break;
-      case 28: /* ifnotexists ::= */
-      case 31: /* temp ::= */ yytestcase(yyruleno==31);
-      case 70: /* autoinc ::= */ yytestcase(yyruleno==70);
-      case 83: /* defer_subclause ::= NOT DEFERRABLE init_deferred_pred_opt */ yytestcase(yyruleno==83);
-      case 85: /* init_deferred_pred_opt ::= */ yytestcase(yyruleno==85);
-      case 87: /* init_deferred_pred_opt ::= INITIALLY IMMEDIATE */ yytestcase(yyruleno==87);
-      case 98: /* defer_subclause_opt ::= */ yytestcase(yyruleno==98);
-      case 109: /* ifexists ::= */ yytestcase(yyruleno==109);
-      case 120: /* distinct ::= ALL */ yytestcase(yyruleno==120);
-      case 121: /* distinct ::= */ yytestcase(yyruleno==121);
-      case 222: /* between_op ::= BETWEEN */ yytestcase(yyruleno==222);
-      case 225: /* in_op ::= IN */ yytestcase(yyruleno==225);
-#line 164 "parse.y"
-{yygotominor.yy194 = 0;}
-#line 2247 "parse.c"
-        break;
-      case 29: /* ifnotexists ::= IF NOT EXISTS */
-      case 30: /* temp ::= TEMP */ yytestcase(yyruleno==30);
-      case 71: /* autoinc ::= AUTOINCR */ yytestcase(yyruleno==71);
-      case 86: /* init_deferred_pred_opt ::= INITIALLY DEFERRED */ yytestcase(yyruleno==86);
-      case 108: /* ifexists ::= IF EXISTS */ yytestcase(yyruleno==108);
-      case 119: /* distinct ::= DISTINCT */ yytestcase(yyruleno==119);
-      case 223: /* between_op ::= NOT BETWEEN */ yytestcase(yyruleno==223);
-      case 226: /* in_op ::= NOT IN */ yytestcase(yyruleno==226);
-#line 165 "parse.y"
-{yygotominor.yy194 = 1;}
-#line 2259 "parse.c"
-        break;
-      case 32: /* create_table_args ::= LP columnlist conslist_opt RP */
-#line 171 "parse.y"
+#line 2248 "parse.c"
+        break;
+      case 30: /* ifnotexists ::= */
+      case 33: /* temp ::= */ yytestcase(yyruleno==33);
+      case 72: /* autoinc ::= */ yytestcase(yyruleno==72);
+      case 85: /* defer_subclause ::= NOT DEFERRABLE init_deferred_pred_opt */ yytestcase(yyruleno==85);
+      case 87: /* init_deferred_pred_opt ::= */ yytestcase(yyruleno==87);
+      case 89: /* init_deferred_pred_opt ::= INITIALLY IMMEDIATE */ yytestcase(yyruleno==89);
+      case 100: /* defer_subclause_opt ::= */ yytestcase(yyruleno==100);
+      case 111: /* ifexists ::= */ yytestcase(yyruleno==111);
+      case 122: /* distinct ::= ALL */ yytestcase(yyruleno==122);
+      case 123: /* distinct ::= */ yytestcase(yyruleno==123);
+      case 224: /* between_op ::= BETWEEN */ yytestcase(yyruleno==224);
+      case 227: /* in_op ::= IN */ yytestcase(yyruleno==227);
+#line 174 "parse.y"
+{yygotominor.yy4 = 0;}
+#line 2264 "parse.c"
+        break;
+      case 31: /* ifnotexists ::= IF NOT EXISTS */
+      case 32: /* temp ::= TEMP */ yytestcase(yyruleno==32);
+      case 73: /* autoinc ::= AUTOINCR */ yytestcase(yyruleno==73);
+      case 88: /* init_deferred_pred_opt ::= INITIALLY DEFERRED */ yytestcase(yyruleno==88);
+      case 110: /* ifexists ::= IF EXISTS */ yytestcase(yyruleno==110);
+      case 121: /* distinct ::= DISTINCT */ yytestcase(yyruleno==121);
+      case 225: /* between_op ::= NOT BETWEEN */ yytestcase(yyruleno==225);
+      case 228: /* in_op ::= NOT IN */ yytestcase(yyruleno==228);
+#line 175 "parse.y"
+{yygotominor.yy4 = 1;}
+#line 2276 "parse.c"
+        break;
+      case 34: /* create_table_args ::= LP columnlist conslist_opt RP */
+#line 181 "parse.y"
 {
   sqlite4EndTable(pParse,&yymsp[-1].minor.yy0,&yymsp[0].minor.yy0,0);
 }
-#line 2266 "parse.c"
+#line 2283 "parse.c"
         break;
-      case 33: /* create_table_args ::= AS select */
-#line 174 "parse.y"
+      case 35: /* create_table_args ::= AS select */
+#line 184 "parse.y"
 {
-  sqlite4EndTable(pParse,0,0,yymsp[0].minor.yy243);
-  sqlite4SelectDelete(pParse->db, yymsp[0].minor.yy243);
+  sqlite4EndTable(pParse,0,0,yymsp[0].minor.yy387);
+  sqlite4SelectDelete(pParse->db, yymsp[0].minor.yy387);
 }
-#line 2274 "parse.c"
+#line 2291 "parse.c"
         break;
-      case 36: /* column ::= columnid type carglist */
-#line 186 "parse.y"
+      case 38: /* column ::= columnid type carglist */
+#line 196 "parse.y"
 {
   yygotominor.yy0.z = yymsp[-2].minor.yy0.z;
   yygotominor.yy0.n = (int)(pParse->sLastToken.z-yymsp[-2].minor.yy0.z) + pParse->sLastToken.n;
 }
-#line 2282 "parse.c"
+#line 2299 "parse.c"
         break;
-      case 37: /* columnid ::= nm */
-#line 190 "parse.y"
+      case 39: /* columnid ::= nm */
+#line 200 "parse.y"
 {
   sqlite4AddColumn(pParse,&yymsp[0].minor.yy0);
   yygotominor.yy0 = yymsp[0].minor.yy0;
 }
-#line 2290 "parse.c"
-        break;
-      case 38: /* id ::= ID */
-      case 39: /* id ::= INDEXED */ yytestcase(yyruleno==39);
-      case 40: /* ids ::= ID|STRING */ yytestcase(yyruleno==40);
-      case 41: /* nm ::= id */ yytestcase(yyruleno==41);
-      case 42: /* nm ::= STRING */ yytestcase(yyruleno==42);
-      case 43: /* nm ::= JOIN_KW */ yytestcase(yyruleno==43);
-      case 46: /* typetoken ::= typename */ yytestcase(yyruleno==46);
-      case 49: /* typename ::= ids */ yytestcase(yyruleno==49);
-      case 127: /* as ::= AS nm */ yytestcase(yyruleno==127);
-      case 128: /* as ::= ids */ yytestcase(yyruleno==128);
-      case 138: /* dbnm ::= DOT nm */ yytestcase(yyruleno==138);
-      case 147: /* indexed_opt ::= INDEXED BY nm */ yytestcase(yyruleno==147);
-      case 252: /* collate ::= COLLATE ids */ yytestcase(yyruleno==252);
-      case 274: /* plus_num ::= plus_opt number */ yytestcase(yyruleno==274);
-      case 275: /* minus_num ::= MINUS number */ yytestcase(yyruleno==275);
-      case 276: /* number ::= INTEGER|FLOAT */ yytestcase(yyruleno==276);
-      case 294: /* trnm ::= nm */ yytestcase(yyruleno==294);
-#line 200 "parse.y"
+#line 2307 "parse.c"
+        break;
+      case 40: /* id ::= ID */
+      case 41: /* id ::= INDEXED */ yytestcase(yyruleno==41);
+      case 42: /* ids ::= ID|STRING */ yytestcase(yyruleno==42);
+      case 43: /* nm ::= id */ yytestcase(yyruleno==43);
+      case 44: /* nm ::= STRING */ yytestcase(yyruleno==44);
+      case 45: /* nm ::= JOIN_KW */ yytestcase(yyruleno==45);
+      case 48: /* typetoken ::= typename */ yytestcase(yyruleno==48);
+      case 51: /* typename ::= ids */ yytestcase(yyruleno==51);
+      case 129: /* as ::= AS nm */ yytestcase(yyruleno==129);
+      case 130: /* as ::= ids */ yytestcase(yyruleno==130);
+      case 140: /* dbnm ::= DOT nm */ yytestcase(yyruleno==140);
+      case 149: /* indexed_opt ::= INDEXED BY nm */ yytestcase(yyruleno==149);
+      case 254: /* collate ::= COLLATE ids */ yytestcase(yyruleno==254);
+      case 276: /* plus_num ::= plus_opt number */ yytestcase(yyruleno==276);
+      case 277: /* minus_num ::= MINUS number */ yytestcase(yyruleno==277);
+      case 278: /* number ::= INTEGER|FLOAT */ yytestcase(yyruleno==278);
+      case 296: /* trnm ::= nm */ yytestcase(yyruleno==296);
+#line 210 "parse.y"
 {yygotominor.yy0 = yymsp[0].minor.yy0;}
-#line 2311 "parse.c"
+#line 2328 "parse.c"
         break;
-      case 45: /* type ::= typetoken */
-#line 262 "parse.y"
+      case 47: /* type ::= typetoken */
+#line 272 "parse.y"
 {sqlite4AddColumnType(pParse,&yymsp[0].minor.yy0);}
-#line 2316 "parse.c"
+#line 2333 "parse.c"
         break;
-      case 47: /* typetoken ::= typename LP signed RP */
-#line 264 "parse.y"
+      case 49: /* typetoken ::= typename LP signed RP */
+#line 274 "parse.y"
 {
   yygotominor.yy0.z = yymsp[-3].minor.yy0.z;
   yygotominor.yy0.n = (int)(&yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n] - yymsp[-3].minor.yy0.z);
 }
-#line 2324 "parse.c"
+#line 2341 "parse.c"
         break;
-      case 48: /* typetoken ::= typename LP signed COMMA signed RP */
-#line 268 "parse.y"
+      case 50: /* typetoken ::= typename LP signed COMMA signed RP */
+#line 278 "parse.y"
 {
   yygotominor.yy0.z = yymsp[-5].minor.yy0.z;
   yygotominor.yy0.n = (int)(&yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n] - yymsp[-5].minor.yy0.z);
 }
-#line 2332 "parse.c"
+#line 2349 "parse.c"
         break;
-      case 50: /* typename ::= typename ids */
-#line 274 "parse.y"
+      case 52: /* typename ::= typename ids */
+#line 284 "parse.y"
 {yygotominor.yy0.z=yymsp[-1].minor.yy0.z; yygotominor.yy0.n=yymsp[0].minor.yy0.n+(int)(yymsp[0].minor.yy0.z-yymsp[-1].minor.yy0.z);}
-#line 2337 "parse.c"
+#line 2354 "parse.c"
         break;
-      case 57: /* ccons ::= DEFAULT term */
-      case 59: /* ccons ::= DEFAULT PLUS term */ yytestcase(yyruleno==59);
-#line 285 "parse.y"
-{sqlite4AddDefaultValue(pParse,&yymsp[0].minor.yy190);}
-#line 2343 "parse.c"
+      case 59: /* ccons ::= DEFAULT term */
+      case 61: /* ccons ::= DEFAULT PLUS term */ yytestcase(yyruleno==61);
+#line 295 "parse.y"
+{sqlite4AddDefaultValue(pParse,&yymsp[0].minor.yy118);}
+#line 2360 "parse.c"
         break;
-      case 58: /* ccons ::= DEFAULT LP expr RP */
-#line 286 "parse.y"
-{sqlite4AddDefaultValue(pParse,&yymsp[-1].minor.yy190);}
-#line 2348 "parse.c"
+      case 60: /* ccons ::= DEFAULT LP expr RP */
+#line 296 "parse.y"
+{sqlite4AddDefaultValue(pParse,&yymsp[-1].minor.yy118);}
+#line 2365 "parse.c"
         break;
-      case 60: /* ccons ::= DEFAULT MINUS term */
-#line 288 "parse.y"
+      case 62: /* ccons ::= DEFAULT MINUS term */
+#line 298 "parse.y"
 {
   ExprSpan v;
-  v.pExpr = sqlite4PExpr(pParse, TK_UMINUS, yymsp[0].minor.yy190.pExpr, 0, 0);
+  v.pExpr = sqlite4PExpr(pParse, TK_UMINUS, yymsp[0].minor.yy118.pExpr, 0, 0);
   v.zStart = yymsp[-1].minor.yy0.z;
-  v.zEnd = yymsp[0].minor.yy190.zEnd;
+  v.zEnd = yymsp[0].minor.yy118.zEnd;
   sqlite4AddDefaultValue(pParse,&v);
 }
-#line 2359 "parse.c"
+#line 2376 "parse.c"
         break;
-      case 61: /* ccons ::= DEFAULT id */
-#line 295 "parse.y"
+      case 63: /* ccons ::= DEFAULT id */
+#line 305 "parse.y"
 {
   ExprSpan v;
   spanExpr(&v, pParse, TK_STRING, &yymsp[0].minor.yy0);
   sqlite4AddDefaultValue(pParse,&v);
 }
-#line 2368 "parse.c"
+#line 2385 "parse.c"
         break;
-      case 63: /* ccons ::= NOT NULL onconf */
-#line 305 "parse.y"
-{sqlite4AddNotNull(pParse, yymsp[0].minor.yy194);}
-#line 2373 "parse.c"
-        break;
-      case 64: /* ccons ::= PRIMARY KEY sortorder onconf autoinc */
-#line 307 "parse.y"
-{sqlite4AddPrimaryKey(pParse,0,yymsp[-1].minor.yy194,yymsp[0].minor.yy194,yymsp[-2].minor.yy194);}
-#line 2378 "parse.c"
-        break;
-      case 65: /* ccons ::= UNIQUE onconf */
-#line 308 "parse.y"
-{sqlite4CreateIndex(pParse,0,0,0,yymsp[0].minor.yy194,0,0,0);}
-#line 2383 "parse.c"
-        break;
-      case 66: /* ccons ::= CHECK LP expr RP */
-#line 309 "parse.y"
-{sqlite4AddCheckConstraint(pParse,yymsp[-1].minor.yy190.pExpr);}
-#line 2388 "parse.c"
-        break;
-      case 67: /* ccons ::= REFERENCES nm idxlist_opt refargs */
-#line 311 "parse.y"
-{sqlite4CreateForeignKey(pParse,0,&yymsp[-2].minor.yy0,yymsp[-1].minor.yy148,yymsp[0].minor.yy194);}
-#line 2393 "parse.c"
-        break;
-      case 68: /* ccons ::= defer_subclause */
-#line 312 "parse.y"
-{sqlite4DeferForeignKey(pParse,yymsp[0].minor.yy194);}
-#line 2398 "parse.c"
-        break;
-      case 69: /* ccons ::= COLLATE ids */
-#line 313 "parse.y"
+      case 65: /* ccons ::= NOT NULL onconf */
+#line 315 "parse.y"
+{sqlite4AddNotNull(pParse, yymsp[0].minor.yy4);}
+#line 2390 "parse.c"
+        break;
+      case 66: /* ccons ::= PRIMARY KEY sortorder onconf autoinc */
+#line 317 "parse.y"
+{sqlite4AddPrimaryKey(pParse,0,yymsp[-1].minor.yy4,yymsp[0].minor.yy4,yymsp[-2].minor.yy4);}
+#line 2395 "parse.c"
+        break;
+      case 67: /* ccons ::= UNIQUE onconf */
+#line 318 "parse.y"
+{sqlite4CreateIndex(pParse,0,0,0,yymsp[0].minor.yy4,0,0,0);}
+#line 2400 "parse.c"
+        break;
+      case 68: /* ccons ::= CHECK LP expr RP */
+#line 319 "parse.y"
+{sqlite4AddCheckConstraint(pParse,yymsp[-1].minor.yy118.pExpr);}
+#line 2405 "parse.c"
+        break;
+      case 69: /* ccons ::= REFERENCES nm idxlist_opt refargs */
+#line 321 "parse.y"
+{sqlite4CreateForeignKey(pParse,0,&yymsp[-2].minor.yy0,yymsp[-1].minor.yy322,yymsp[0].minor.yy4);}
+#line 2410 "parse.c"
+        break;
+      case 70: /* ccons ::= defer_subclause */
+#line 322 "parse.y"
+{sqlite4DeferForeignKey(pParse,yymsp[0].minor.yy4);}
+#line 2415 "parse.c"
+        break;
+      case 71: /* ccons ::= COLLATE ids */
+#line 323 "parse.y"
 {sqlite4AddCollateType(pParse, &yymsp[0].minor.yy0);}
-#line 2403 "parse.c"
-        break;
-      case 72: /* refargs ::= */
-#line 326 "parse.y"
-{ yygotominor.yy194 = OE_None*0x0101; /* EV: R-19803-45884 */}
-#line 2408 "parse.c"
-        break;
-      case 73: /* refargs ::= refargs refarg */
-#line 327 "parse.y"
-{ yygotominor.yy194 = (yymsp[-1].minor.yy194 & ~yymsp[0].minor.yy497.mask) | yymsp[0].minor.yy497.value; }
-#line 2413 "parse.c"
-        break;
-      case 74: /* refarg ::= MATCH nm */
-      case 75: /* refarg ::= ON INSERT refact */ yytestcase(yyruleno==75);
-#line 329 "parse.y"
-{ yygotominor.yy497.value = 0;     yygotominor.yy497.mask = 0x000000; }
-#line 2419 "parse.c"
-        break;
-      case 76: /* refarg ::= ON DELETE refact */
-#line 331 "parse.y"
-{ yygotominor.yy497.value = yymsp[0].minor.yy194;     yygotominor.yy497.mask = 0x0000ff; }
-#line 2424 "parse.c"
-        break;
-      case 77: /* refarg ::= ON UPDATE refact */
-#line 332 "parse.y"
-{ yygotominor.yy497.value = yymsp[0].minor.yy194<<8;  yygotominor.yy497.mask = 0x00ff00; }
-#line 2429 "parse.c"
-        break;
-      case 78: /* refact ::= SET NULL */
-#line 334 "parse.y"
-{ yygotominor.yy194 = OE_SetNull;  /* EV: R-33326-45252 */}
-#line 2434 "parse.c"
-        break;
-      case 79: /* refact ::= SET DEFAULT */
-#line 335 "parse.y"
-{ yygotominor.yy194 = OE_SetDflt;  /* EV: R-33326-45252 */}
-#line 2439 "parse.c"
-        break;
-      case 80: /* refact ::= CASCADE */
+#line 2420 "parse.c"
+        break;
+      case 74: /* refargs ::= */
 #line 336 "parse.y"
-{ yygotominor.yy194 = OE_Cascade;  /* EV: R-33326-45252 */}
-#line 2444 "parse.c"
+{ yygotominor.yy4 = OE_None*0x0101; /* EV: R-19803-45884 */}
+#line 2425 "parse.c"
         break;
-      case 81: /* refact ::= RESTRICT */
+      case 75: /* refargs ::= refargs refarg */
 #line 337 "parse.y"
-{ yygotominor.yy194 = OE_Restrict; /* EV: R-33326-45252 */}
-#line 2449 "parse.c"
-        break;
-      case 82: /* refact ::= NO ACTION */
-#line 338 "parse.y"
-{ yygotominor.yy194 = OE_None;     /* EV: R-33326-45252 */}
-#line 2454 "parse.c"
-        break;
-      case 84: /* defer_subclause ::= DEFERRABLE init_deferred_pred_opt */
-      case 99: /* defer_subclause_opt ::= defer_subclause */ yytestcase(yyruleno==99);
-      case 101: /* onconf ::= ON CONFLICT resolvetype */ yytestcase(yyruleno==101);
-      case 104: /* resolvetype ::= raisetype */ yytestcase(yyruleno==104);
+{ yygotominor.yy4 = (yymsp[-1].minor.yy4 & ~yymsp[0].minor.yy215.mask) | yymsp[0].minor.yy215.value; }
+#line 2430 "parse.c"
+        break;
+      case 76: /* refarg ::= MATCH nm */
+      case 77: /* refarg ::= ON INSERT refact */ yytestcase(yyruleno==77);
+#line 339 "parse.y"
+{ yygotominor.yy215.value = 0;     yygotominor.yy215.mask = 0x000000; }
+#line 2436 "parse.c"
+        break;
+      case 78: /* refarg ::= ON DELETE refact */
 #line 341 "parse.y"
-{yygotominor.yy194 = yymsp[0].minor.yy194;}
-#line 2462 "parse.c"
+{ yygotominor.yy215.value = yymsp[0].minor.yy4;     yygotominor.yy215.mask = 0x0000ff; }
+#line 2441 "parse.c"
+        break;
+      case 79: /* refarg ::= ON UPDATE refact */
+#line 342 "parse.y"
+{ yygotominor.yy215.value = yymsp[0].minor.yy4<<8;  yygotominor.yy215.mask = 0x00ff00; }
+#line 2446 "parse.c"
+        break;
+      case 80: /* refact ::= SET NULL */
+#line 344 "parse.y"
+{ yygotominor.yy4 = OE_SetNull;  /* EV: R-33326-45252 */}
+#line 2451 "parse.c"
+        break;
+      case 81: /* refact ::= SET DEFAULT */
+#line 345 "parse.y"
+{ yygotominor.yy4 = OE_SetDflt;  /* EV: R-33326-45252 */}
+#line 2456 "parse.c"
+        break;
+      case 82: /* refact ::= CASCADE */
+#line 346 "parse.y"
+{ yygotominor.yy4 = OE_Cascade;  /* EV: R-33326-45252 */}
+#line 2461 "parse.c"
+        break;
+      case 83: /* refact ::= RESTRICT */
+#line 347 "parse.y"
+{ yygotominor.yy4 = OE_Restrict; /* EV: R-33326-45252 */}
+#line 2466 "parse.c"
+        break;
+      case 84: /* refact ::= NO ACTION */
+#line 348 "parse.y"
+{ yygotominor.yy4 = OE_None;     /* EV: R-33326-45252 */}
+#line 2471 "parse.c"
+        break;
+      case 86: /* defer_subclause ::= DEFERRABLE init_deferred_pred_opt */
+      case 101: /* defer_subclause_opt ::= defer_subclause */ yytestcase(yyruleno==101);
+      case 103: /* onconf ::= ON CONFLICT resolvetype */ yytestcase(yyruleno==103);
+      case 106: /* resolvetype ::= raisetype */ yytestcase(yyruleno==106);
+#line 351 "parse.y"
+{yygotominor.yy4 = yymsp[0].minor.yy4;}
+#line 2479 "parse.c"
         break;
-      case 88: /* conslist_opt ::= */
-#line 350 "parse.y"
+      case 90: /* conslist_opt ::= */
+#line 360 "parse.y"
 {yygotominor.yy0.n = 0; yygotominor.yy0.z = 0;}
-#line 2467 "parse.c"
+#line 2484 "parse.c"
         break;
-      case 89: /* conslist_opt ::= COMMA conslist */
-#line 351 "parse.y"
+      case 91: /* conslist_opt ::= COMMA conslist */
+#line 361 "parse.y"
 {yygotominor.yy0 = yymsp[-1].minor.yy0;}
-#line 2472 "parse.c"
+#line 2489 "parse.c"
         break;
-      case 94: /* tcons ::= PRIMARY KEY LP idxlist autoinc RP onconf */
-#line 357 "parse.y"
-{sqlite4AddPrimaryKey(pParse,yymsp[-3].minor.yy148,yymsp[0].minor.yy194,yymsp[-2].minor.yy194,0);}
-#line 2477 "parse.c"
+      case 96: /* tcons ::= PRIMARY KEY LP idxlist autoinc RP onconf */
+#line 367 "parse.y"
+{sqlite4AddPrimaryKey(pParse,yymsp[-3].minor.yy322,yymsp[0].minor.yy4,yymsp[-2].minor.yy4,0);}
+#line 2494 "parse.c"
         break;
-      case 95: /* tcons ::= UNIQUE LP idxlist RP onconf */
-#line 359 "parse.y"
-{sqlite4CreateIndex(pParse,0,yymsp[-2].minor.yy148,0,yymsp[0].minor.yy194,0,0,0);}
-#line 2482 "parse.c"
+      case 97: /* tcons ::= UNIQUE LP idxlist RP onconf */
+#line 369 "parse.y"
+{sqlite4CreateIndex(pParse,0,yymsp[-2].minor.yy322,0,yymsp[0].minor.yy4,0,0,0);}
+#line 2499 "parse.c"
         break;
-      case 96: /* tcons ::= CHECK LP expr RP onconf */
-#line 361 "parse.y"
-{sqlite4AddCheckConstraint(pParse,yymsp[-2].minor.yy190.pExpr);}
-#line 2487 "parse.c"
+      case 98: /* tcons ::= CHECK LP expr RP onconf */
+#line 371 "parse.y"
+{sqlite4AddCheckConstraint(pParse,yymsp[-2].minor.yy118.pExpr);}
+#line 2504 "parse.c"
         break;
-      case 97: /* tcons ::= FOREIGN KEY LP idxlist RP REFERENCES nm idxlist_opt refargs defer_subclause_opt */
-#line 363 "parse.y"
+      case 99: /* tcons ::= FOREIGN KEY LP idxlist RP REFERENCES nm idxlist_opt refargs defer_subclause_opt */
+#line 373 "parse.y"
 {
-    sqlite4CreateForeignKey(pParse, yymsp[-6].minor.yy148, &yymsp[-3].minor.yy0, yymsp[-2].minor.yy148, yymsp[-1].minor.yy194);
-    sqlite4DeferForeignKey(pParse, yymsp[0].minor.yy194);
+    sqlite4CreateForeignKey(pParse, yymsp[-6].minor.yy322, &yymsp[-3].minor.yy0, yymsp[-2].minor.yy322, yymsp[-1].minor.yy4);
+    sqlite4DeferForeignKey(pParse, yymsp[0].minor.yy4);
 }
-#line 2495 "parse.c"
+#line 2512 "parse.c"
         break;
-      case 100: /* onconf ::= */
-#line 377 "parse.y"
-{yygotominor.yy194 = OE_Default;}
-#line 2500 "parse.c"
+      case 102: /* onconf ::= */
+#line 387 "parse.y"
+{yygotominor.yy4 = OE_Default;}
+#line 2517 "parse.c"
         break;
-      case 102: /* orconf ::= */
-#line 379 "parse.y"
-{yygotominor.yy234 = OE_Default;}
-#line 2505 "parse.c"
+      case 104: /* orconf ::= */
+#line 389 "parse.y"
+{yygotominor.yy210 = OE_Default;}
+#line 2522 "parse.c"
         break;
-      case 103: /* orconf ::= OR resolvetype */
-#line 380 "parse.y"
-{yygotominor.yy234 = (u8)yymsp[0].minor.yy194;}
-#line 2510 "parse.c"
+      case 105: /* orconf ::= OR resolvetype */
+#line 390 "parse.y"
+{yygotominor.yy210 = (u8)yymsp[0].minor.yy4;}
+#line 2527 "parse.c"
         break;
-      case 105: /* resolvetype ::= IGNORE */
-#line 382 "parse.y"
-{yygotominor.yy194 = OE_Ignore;}
-#line 2515 "parse.c"
+      case 107: /* resolvetype ::= IGNORE */
+#line 392 "parse.y"
+{yygotominor.yy4 = OE_Ignore;}
+#line 2532 "parse.c"
         break;
-      case 106: /* resolvetype ::= REPLACE */
-#line 383 "parse.y"
-{yygotominor.yy194 = OE_Replace;}
-#line 2520 "parse.c"
+      case 108: /* resolvetype ::= REPLACE */
+#line 393 "parse.y"
+{yygotominor.yy4 = OE_Replace;}
+#line 2537 "parse.c"
         break;
-      case 107: /* cmd ::= DROP TABLE ifexists fullname */
-#line 387 "parse.y"
+      case 109: /* cmd ::= DROP TABLE ifexists fullname */
+#line 397 "parse.y"
 {
-  sqlite4DropTable(pParse, yymsp[0].minor.yy185, 0, yymsp[-1].minor.yy194);
+  sqlite4DropTable(pParse, yymsp[0].minor.yy259, 0, yymsp[-1].minor.yy4);
 }
-#line 2527 "parse.c"
+#line 2544 "parse.c"
         break;
-      case 110: /* cmd ::= createkw temp VIEW ifnotexists nm dbnm AS select */
-#line 397 "parse.y"
+      case 112: /* cmd ::= createkw temp VIEW ifnotexists nm dbnm AS select */
+#line 407 "parse.y"
 {
-  sqlite4CreateView(pParse, &yymsp[-7].minor.yy0, &yymsp[-3].minor.yy0, &yymsp[-2].minor.yy0, yymsp[0].minor.yy243, yymsp[-6].minor.yy194, yymsp[-4].minor.yy194);
+  sqlite4CreateView(pParse, &yymsp[-7].minor.yy0, &yymsp[-3].minor.yy0, &yymsp[-2].minor.yy0, yymsp[0].minor.yy387, yymsp[-6].minor.yy4, yymsp[-4].minor.yy4);
 }
-#line 2534 "parse.c"
+#line 2551 "parse.c"
         break;
-      case 111: /* cmd ::= DROP VIEW ifexists fullname */
-#line 400 "parse.y"
+      case 113: /* cmd ::= DROP VIEW ifexists fullname */
+#line 410 "parse.y"
 {
-  sqlite4DropTable(pParse, yymsp[0].minor.yy185, 1, yymsp[-1].minor.yy194);
+  sqlite4DropTable(pParse, yymsp[0].minor.yy259, 1, yymsp[-1].minor.yy4);
 }
-#line 2541 "parse.c"
+#line 2558 "parse.c"
         break;
-      case 112: /* cmd ::= select */
-#line 407 "parse.y"
+      case 114: /* cmd ::= select */
+#line 417 "parse.y"
 {
   SelectDest dest = {SRT_Output, 0, 0, 0, 0};
-  sqlite4Select(pParse, yymsp[0].minor.yy243, &dest);
+  sqlite4Select(pParse, yymsp[0].minor.yy387, &dest);
   sqlite4ExplainBegin(pParse->pVdbe);
-  sqlite4ExplainSelect(pParse->pVdbe, yymsp[0].minor.yy243);
+  sqlite4ExplainSelect(pParse->pVdbe, yymsp[0].minor.yy387);
   sqlite4ExplainFinish(pParse->pVdbe);
-  sqlite4SelectDelete(pParse->db, yymsp[0].minor.yy243);
+  sqlite4SelectDelete(pParse->db, yymsp[0].minor.yy387);
 }
-#line 2553 "parse.c"
+#line 2570 "parse.c"
         break;
-      case 113: /* select ::= oneselect */
-#line 421 "parse.y"
-{yygotominor.yy243 = yymsp[0].minor.yy243;}
-#line 2558 "parse.c"
+      case 115: /* select ::= oneselect */
+#line 431 "parse.y"
+{yygotominor.yy387 = yymsp[0].minor.yy387;}
+#line 2575 "parse.c"
         break;
-      case 114: /* select ::= select multiselect_op oneselect */
-#line 423 "parse.y"
+      case 116: /* select ::= select multiselect_op oneselect */
+#line 433 "parse.y"
 {
-  if( yymsp[0].minor.yy243 ){
-    yymsp[0].minor.yy243->op = (u8)yymsp[-1].minor.yy194;
-    yymsp[0].minor.yy243->pPrior = yymsp[-2].minor.yy243;
+  if( yymsp[0].minor.yy387 ){
+    yymsp[0].minor.yy387->op = (u8)yymsp[-1].minor.yy4;
+    yymsp[0].minor.yy387->pPrior = yymsp[-2].minor.yy387;
   }else{
-    sqlite4SelectDelete(pParse->db, yymsp[-2].minor.yy243);
+    sqlite4SelectDelete(pParse->db, yymsp[-2].minor.yy387);
   }
-  yygotominor.yy243 = yymsp[0].minor.yy243;
+  yygotominor.yy387 = yymsp[0].minor.yy387;
 }
-#line 2571 "parse.c"
+#line 2588 "parse.c"
         break;
-      case 116: /* multiselect_op ::= UNION ALL */
-#line 434 "parse.y"
-{yygotominor.yy194 = TK_ALL;}
-#line 2576 "parse.c"
+      case 118: /* multiselect_op ::= UNION ALL */
+#line 444 "parse.y"
+{yygotominor.yy4 = TK_ALL;}
+#line 2593 "parse.c"
         break;
-      case 118: /* oneselect ::= SELECT distinct selcollist from where_opt groupby_opt having_opt orderby_opt limit_opt */
-#line 438 "parse.y"
+      case 120: /* oneselect ::= SELECT distinct selcollist from where_opt groupby_opt having_opt orderby_opt limit_opt */
+#line 448 "parse.y"
 {
-  yygotominor.yy243 = sqlite4SelectNew(pParse,yymsp[-6].minor.yy148,yymsp[-5].minor.yy185,yymsp[-4].minor.yy72,yymsp[-3].minor.yy148,yymsp[-2].minor.yy72,yymsp[-1].minor.yy148,yymsp[-7].minor.yy194,yymsp[0].minor.yy354.pLimit,yymsp[0].minor.yy354.pOffset);
+  yygotominor.yy387 = sqlite4SelectNew(pParse,yymsp[-6].minor.yy322,yymsp[-5].minor.yy259,yymsp[-4].minor.yy314,yymsp[-3].minor.yy322,yymsp[-2].minor.yy314,yymsp[-1].minor.yy322,yymsp[-7].minor.yy4,yymsp[0].minor.yy292.pLimit,yymsp[0].minor.yy292.pOffset);
 }
-#line 2583 "parse.c"
+#line 2600 "parse.c"
         break;
-      case 122: /* sclp ::= selcollist COMMA */
-      case 248: /* idxlist_opt ::= LP idxlist RP */ yytestcase(yyruleno==248);
-#line 459 "parse.y"
-{yygotominor.yy148 = yymsp[-1].minor.yy148;}
-#line 2589 "parse.c"
+      case 124: /* sclp ::= selcollist COMMA */
+      case 250: /* idxlist_opt ::= LP idxlist RP */ yytestcase(yyruleno==250);
+#line 469 "parse.y"
+{yygotominor.yy322 = yymsp[-1].minor.yy322;}
+#line 2606 "parse.c"
         break;
-      case 123: /* sclp ::= */
-      case 151: /* orderby_opt ::= */ yytestcase(yyruleno==151);
-      case 159: /* groupby_opt ::= */ yytestcase(yyruleno==159);
-      case 240: /* exprlist ::= */ yytestcase(yyruleno==240);
-      case 247: /* idxlist_opt ::= */ yytestcase(yyruleno==247);
-#line 460 "parse.y"
-{yygotominor.yy148 = 0;}
-#line 2598 "parse.c"
+      case 125: /* sclp ::= */
+      case 153: /* orderby_opt ::= */ yytestcase(yyruleno==153);
+      case 161: /* groupby_opt ::= */ yytestcase(yyruleno==161);
+      case 242: /* exprlist ::= */ yytestcase(yyruleno==242);
+      case 249: /* idxlist_opt ::= */ yytestcase(yyruleno==249);
+#line 470 "parse.y"
+{yygotominor.yy322 = 0;}
+#line 2615 "parse.c"
         break;
-      case 124: /* selcollist ::= sclp expr as */
-#line 461 "parse.y"
+      case 126: /* selcollist ::= sclp expr as */
+#line 471 "parse.y"
 {
-   yygotominor.yy148 = sqlite4ExprListAppend(pParse, yymsp[-2].minor.yy148, yymsp[-1].minor.yy190.pExpr);
-   if( yymsp[0].minor.yy0.n>0 ) sqlite4ExprListSetName(pParse, yygotominor.yy148, &yymsp[0].minor.yy0, 1);
-   sqlite4ExprListSetSpan(pParse,yygotominor.yy148,&yymsp[-1].minor.yy190);
+   yygotominor.yy322 = sqlite4ExprListAppend(pParse, yymsp[-2].minor.yy322, yymsp[-1].minor.yy118.pExpr);
+   if( yymsp[0].minor.yy0.n>0 ) sqlite4ExprListSetName(pParse, yygotominor.yy322, &yymsp[0].minor.yy0, 1);
+   sqlite4ExprListSetSpan(pParse,yygotominor.yy322,&yymsp[-1].minor.yy118);
 }
-#line 2607 "parse.c"
+#line 2624 "parse.c"
         break;
-      case 125: /* selcollist ::= sclp STAR */
-#line 466 "parse.y"
+      case 127: /* selcollist ::= sclp STAR */
+#line 476 "parse.y"
 {
   Expr *p = sqlite4Expr(pParse->db, TK_ALL, 0);
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse, yymsp[-1].minor.yy148, p);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse, yymsp[-1].minor.yy322, p);
 }
-#line 2615 "parse.c"
+#line 2632 "parse.c"
         break;
-      case 126: /* selcollist ::= sclp nm DOT STAR */
-#line 470 "parse.y"
+      case 128: /* selcollist ::= sclp nm DOT STAR */
+#line 480 "parse.y"
 {
   Expr *pRight = sqlite4PExpr(pParse, TK_ALL, 0, 0, &yymsp[0].minor.yy0);
   Expr *pLeft = sqlite4PExpr(pParse, TK_ID, 0, 0, &yymsp[-2].minor.yy0);
   Expr *pDot = sqlite4PExpr(pParse, TK_DOT, pLeft, pRight, 0);
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,yymsp[-3].minor.yy148, pDot);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,yymsp[-3].minor.yy322, pDot);
 }
-#line 2625 "parse.c"
+#line 2642 "parse.c"
         break;
-      case 129: /* as ::= */
-#line 483 "parse.y"
+      case 131: /* as ::= */
+#line 493 "parse.y"
 {yygotominor.yy0.n = 0;}
-#line 2630 "parse.c"
+#line 2647 "parse.c"
         break;
-      case 130: /* from ::= */
-#line 495 "parse.y"
-{yygotominor.yy185 = sqlite4DbMallocZero(pParse->db, sizeof(*yygotominor.yy185));}
-#line 2635 "parse.c"
+      case 132: /* from ::= */
+#line 505 "parse.y"
+{yygotominor.yy259 = sqlite4DbMallocZero(pParse->db, sizeof(*yygotominor.yy259));}
+#line 2652 "parse.c"
         break;
-      case 131: /* from ::= FROM seltablist */
-#line 496 "parse.y"
+      case 133: /* from ::= FROM seltablist */
+#line 506 "parse.y"
 {
-  yygotominor.yy185 = yymsp[0].minor.yy185;
-  sqlite4SrcListShiftJoinType(yygotominor.yy185);
+  yygotominor.yy259 = yymsp[0].minor.yy259;
+  sqlite4SrcListShiftJoinType(yygotominor.yy259);
 }
-#line 2643 "parse.c"
+#line 2660 "parse.c"
         break;
-      case 132: /* stl_prefix ::= seltablist joinop */
-#line 504 "parse.y"
+      case 134: /* stl_prefix ::= seltablist joinop */
+#line 514 "parse.y"
 {
-   yygotominor.yy185 = yymsp[-1].minor.yy185;
-   if( ALWAYS(yygotominor.yy185 && yygotominor.yy185->nSrc>0) ) yygotominor.yy185->a[yygotominor.yy185->nSrc-1].jointype = (u8)yymsp[0].minor.yy194;
+   yygotominor.yy259 = yymsp[-1].minor.yy259;
+   if( ALWAYS(yygotominor.yy259 && yygotominor.yy259->nSrc>0) ) yygotominor.yy259->a[yygotominor.yy259->nSrc-1].jointype = (u8)yymsp[0].minor.yy4;
 }
-#line 2651 "parse.c"
+#line 2668 "parse.c"
         break;
-      case 133: /* stl_prefix ::= */
-#line 508 "parse.y"
-{yygotominor.yy185 = 0;}
-#line 2656 "parse.c"
+      case 135: /* stl_prefix ::= */
+#line 518 "parse.y"
+{yygotominor.yy259 = 0;}
+#line 2673 "parse.c"
         break;
-      case 134: /* seltablist ::= stl_prefix nm dbnm as indexed_opt on_opt using_opt */
-#line 509 "parse.y"
+      case 136: /* seltablist ::= stl_prefix nm dbnm as indexed_opt on_opt using_opt */
+#line 519 "parse.y"
 {
-  yygotominor.yy185 = sqlite4SrcListAppendFromTerm(pParse,yymsp[-6].minor.yy185,&yymsp[-5].minor.yy0,&yymsp[-4].minor.yy0,&yymsp[-3].minor.yy0,0,yymsp[-1].minor.yy72,yymsp[0].minor.yy254);
-  sqlite4SrcListIndexedBy(pParse, yygotominor.yy185, &yymsp[-2].minor.yy0);
+  yygotominor.yy259 = sqlite4SrcListAppendFromTerm(pParse,yymsp[-6].minor.yy259,&yymsp[-5].minor.yy0,&yymsp[-4].minor.yy0,&yymsp[-3].minor.yy0,0,yymsp[-1].minor.yy314,yymsp[0].minor.yy384);
+  sqlite4SrcListIndexedBy(pParse, yygotominor.yy259, &yymsp[-2].minor.yy0);
 }
-#line 2664 "parse.c"
+#line 2681 "parse.c"
         break;
-      case 135: /* seltablist ::= stl_prefix LP select RP as on_opt using_opt */
-#line 515 "parse.y"
+      case 137: /* seltablist ::= stl_prefix LP select RP as on_opt using_opt */
+#line 525 "parse.y"
 {
-    yygotominor.yy185 = sqlite4SrcListAppendFromTerm(pParse,yymsp[-6].minor.yy185,0,0,&yymsp[-2].minor.yy0,yymsp[-4].minor.yy243,yymsp[-1].minor.yy72,yymsp[0].minor.yy254);
+    yygotominor.yy259 = sqlite4SrcListAppendFromTerm(pParse,yymsp[-6].minor.yy259,0,0,&yymsp[-2].minor.yy0,yymsp[-4].minor.yy387,yymsp[-1].minor.yy314,yymsp[0].minor.yy384);
   }
-#line 2671 "parse.c"
+#line 2688 "parse.c"
         break;
-      case 136: /* seltablist ::= stl_prefix LP seltablist RP as on_opt using_opt */
-#line 519 "parse.y"
+      case 138: /* seltablist ::= stl_prefix LP seltablist RP as on_opt using_opt */
+#line 529 "parse.y"
 {
-    if( yymsp[-6].minor.yy185==0 && yymsp[-2].minor.yy0.n==0 && yymsp[-1].minor.yy72==0 && yymsp[0].minor.yy254==0 ){
-      yygotominor.yy185 = yymsp[-4].minor.yy185;
+    if( yymsp[-6].minor.yy259==0 && yymsp[-2].minor.yy0.n==0 && yymsp[-1].minor.yy314==0 && yymsp[0].minor.yy384==0 ){
+      yygotominor.yy259 = yymsp[-4].minor.yy259;
     }else{
       Select *pSubquery;
-      sqlite4SrcListShiftJoinType(yymsp[-4].minor.yy185);
-      pSubquery = sqlite4SelectNew(pParse,0,yymsp[-4].minor.yy185,0,0,0,0,0,0,0);
-      yygotominor.yy185 = sqlite4SrcListAppendFromTerm(pParse,yymsp[-6].minor.yy185,0,0,&yymsp[-2].minor.yy0,pSubquery,yymsp[-1].minor.yy72,yymsp[0].minor.yy254);
+      sqlite4SrcListShiftJoinType(yymsp[-4].minor.yy259);
+      pSubquery = sqlite4SelectNew(pParse,0,yymsp[-4].minor.yy259,0,0,0,0,0,0,0);
+      yygotominor.yy259 = sqlite4SrcListAppendFromTerm(pParse,yymsp[-6].minor.yy259,0,0,&yymsp[-2].minor.yy0,pSubquery,yymsp[-1].minor.yy314,yymsp[0].minor.yy384);
     }
   }
-#line 2685 "parse.c"
+#line 2702 "parse.c"
         break;
-      case 137: /* dbnm ::= */
-      case 146: /* indexed_opt ::= */ yytestcase(yyruleno==146);
-#line 544 "parse.y"
-{yygotominor.yy0.z=0; yygotominor.yy0.n=0;}
-#line 2691 "parse.c"
-        break;
-      case 139: /* fullname ::= nm dbnm */
-#line 549 "parse.y"
-{yygotominor.yy185 = sqlite4SrcListAppend(pParse->db,0,&yymsp[-1].minor.yy0,&yymsp[0].minor.yy0);}
-#line 2696 "parse.c"
-        break;
-      case 140: /* joinop ::= COMMA|JOIN */
-#line 553 "parse.y"
-{ yygotominor.yy194 = JT_INNER; }
-#line 2701 "parse.c"
-        break;
-      case 141: /* joinop ::= JOIN_KW JOIN */
+      case 139: /* dbnm ::= */
+      case 148: /* indexed_opt ::= */ yytestcase(yyruleno==148);
 #line 554 "parse.y"
-{ yygotominor.yy194 = sqlite4JoinType(pParse,&yymsp[-1].minor.yy0,0,0); }
-#line 2706 "parse.c"
-        break;
-      case 142: /* joinop ::= JOIN_KW nm JOIN */
-#line 555 "parse.y"
-{ yygotominor.yy194 = sqlite4JoinType(pParse,&yymsp[-2].minor.yy0,&yymsp[-1].minor.yy0,0); }
-#line 2711 "parse.c"
-        break;
-      case 143: /* joinop ::= JOIN_KW nm nm JOIN */
-#line 557 "parse.y"
-{ yygotominor.yy194 = sqlite4JoinType(pParse,&yymsp[-3].minor.yy0,&yymsp[-2].minor.yy0,&yymsp[-1].minor.yy0); }
-#line 2716 "parse.c"
-        break;
-      case 144: /* on_opt ::= ON expr */
-      case 155: /* sortitem ::= expr */ yytestcase(yyruleno==155);
-      case 162: /* having_opt ::= HAVING expr */ yytestcase(yyruleno==162);
-      case 169: /* where_opt ::= WHERE expr */ yytestcase(yyruleno==169);
-      case 235: /* case_else ::= ELSE expr */ yytestcase(yyruleno==235);
-      case 237: /* case_operand ::= expr */ yytestcase(yyruleno==237);
-#line 561 "parse.y"
-{yygotominor.yy72 = yymsp[0].minor.yy190.pExpr;}
-#line 2726 "parse.c"
-        break;
-      case 145: /* on_opt ::= */
-      case 161: /* having_opt ::= */ yytestcase(yyruleno==161);
-      case 168: /* where_opt ::= */ yytestcase(yyruleno==168);
-      case 236: /* case_else ::= */ yytestcase(yyruleno==236);
-      case 238: /* case_operand ::= */ yytestcase(yyruleno==238);
-#line 562 "parse.y"
-{yygotominor.yy72 = 0;}
-#line 2735 "parse.c"
-        break;
-      case 148: /* indexed_opt ::= NOT INDEXED */
-#line 577 "parse.y"
-{yygotominor.yy0.z=0; yygotominor.yy0.n=1;}
-#line 2740 "parse.c"
-        break;
-      case 149: /* using_opt ::= USING LP inscollist RP */
-      case 181: /* inscollist_opt ::= LP inscollist RP */ yytestcase(yyruleno==181);
-#line 581 "parse.y"
-{yygotominor.yy254 = yymsp[-1].minor.yy254;}
-#line 2746 "parse.c"
-        break;
-      case 150: /* using_opt ::= */
-      case 180: /* inscollist_opt ::= */ yytestcase(yyruleno==180);
-#line 582 "parse.y"
-{yygotominor.yy254 = 0;}
+{yygotominor.yy0.z=0; yygotominor.yy0.n=0;}
+#line 2708 "parse.c"
+        break;
+      case 141: /* fullname ::= nm dbnm */
+#line 559 "parse.y"
+{yygotominor.yy259 = sqlite4SrcListAppend(pParse->db,0,&yymsp[-1].minor.yy0,&yymsp[0].minor.yy0);}
+#line 2713 "parse.c"
+        break;
+      case 142: /* joinop ::= COMMA|JOIN */
+#line 563 "parse.y"
+{ yygotominor.yy4 = JT_INNER; }
+#line 2718 "parse.c"
+        break;
+      case 143: /* joinop ::= JOIN_KW JOIN */
+#line 564 "parse.y"
+{ yygotominor.yy4 = sqlite4JoinType(pParse,&yymsp[-1].minor.yy0,0,0); }
+#line 2723 "parse.c"
+        break;
+      case 144: /* joinop ::= JOIN_KW nm JOIN */
+#line 565 "parse.y"
+{ yygotominor.yy4 = sqlite4JoinType(pParse,&yymsp[-2].minor.yy0,&yymsp[-1].minor.yy0,0); }
+#line 2728 "parse.c"
+        break;
+      case 145: /* joinop ::= JOIN_KW nm nm JOIN */
+#line 567 "parse.y"
+{ yygotominor.yy4 = sqlite4JoinType(pParse,&yymsp[-3].minor.yy0,&yymsp[-2].minor.yy0,&yymsp[-1].minor.yy0); }
+#line 2733 "parse.c"
+        break;
+      case 146: /* on_opt ::= ON expr */
+      case 157: /* sortitem ::= expr */ yytestcase(yyruleno==157);
+      case 164: /* having_opt ::= HAVING expr */ yytestcase(yyruleno==164);
+      case 171: /* where_opt ::= WHERE expr */ yytestcase(yyruleno==171);
+      case 237: /* case_else ::= ELSE expr */ yytestcase(yyruleno==237);
+      case 239: /* case_operand ::= expr */ yytestcase(yyruleno==239);
+#line 571 "parse.y"
+{yygotominor.yy314 = yymsp[0].minor.yy118.pExpr;}
+#line 2743 "parse.c"
+        break;
+      case 147: /* on_opt ::= */
+      case 163: /* having_opt ::= */ yytestcase(yyruleno==163);
+      case 170: /* where_opt ::= */ yytestcase(yyruleno==170);
+      case 238: /* case_else ::= */ yytestcase(yyruleno==238);
+      case 240: /* case_operand ::= */ yytestcase(yyruleno==240);
+#line 572 "parse.y"
+{yygotominor.yy314 = 0;}
 #line 2752 "parse.c"
         break;
-      case 152: /* orderby_opt ::= ORDER BY sortlist */
-      case 160: /* groupby_opt ::= GROUP BY nexprlist */ yytestcase(yyruleno==160);
-      case 239: /* exprlist ::= nexprlist */ yytestcase(yyruleno==239);
-      case 268: /* pragmaargs ::= pragmaarg */ yytestcase(yyruleno==268);
-#line 593 "parse.y"
-{yygotominor.yy148 = yymsp[0].minor.yy148;}
-#line 2760 "parse.c"
-        break;
-      case 153: /* sortlist ::= sortlist COMMA sortitem sortorder */
-#line 594 "parse.y"
-{
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,yymsp[-3].minor.yy148,yymsp[-1].minor.yy72);
-  if( yygotominor.yy148 ) yygotominor.yy148->a[yygotominor.yy148->nExpr-1].sortOrder = (u8)yymsp[0].minor.yy194;
-}
-#line 2768 "parse.c"
-        break;
-      case 154: /* sortlist ::= sortitem sortorder */
-#line 598 "parse.y"
-{
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,0,yymsp[-1].minor.yy72);
-  if( yygotominor.yy148 && ALWAYS(yygotominor.yy148->a) ) yygotominor.yy148->a[0].sortOrder = (u8)yymsp[0].minor.yy194;
-}
-#line 2776 "parse.c"
-        break;
-      case 156: /* sortorder ::= ASC */
-      case 158: /* sortorder ::= */ yytestcase(yyruleno==158);
-#line 606 "parse.y"
-{yygotominor.yy194 = SQLITE4_SO_ASC;}
-#line 2782 "parse.c"
-        break;
-      case 157: /* sortorder ::= DESC */
-#line 607 "parse.y"
-{yygotominor.yy194 = SQLITE4_SO_DESC;}
-#line 2787 "parse.c"
-        break;
-      case 163: /* limit_opt ::= */
-#line 633 "parse.y"
-{yygotominor.yy354.pLimit = 0; yygotominor.yy354.pOffset = 0;}
-#line 2792 "parse.c"
-        break;
-      case 164: /* limit_opt ::= LIMIT expr */
-#line 634 "parse.y"
-{yygotominor.yy354.pLimit = yymsp[0].minor.yy190.pExpr; yygotominor.yy354.pOffset = 0;}
-#line 2797 "parse.c"
-        break;
-      case 165: /* limit_opt ::= LIMIT expr OFFSET expr */
-#line 636 "parse.y"
-{yygotominor.yy354.pLimit = yymsp[-2].minor.yy190.pExpr; yygotominor.yy354.pOffset = yymsp[0].minor.yy190.pExpr;}
-#line 2802 "parse.c"
-        break;
-      case 166: /* limit_opt ::= LIMIT expr COMMA expr */
-#line 638 "parse.y"
-{yygotominor.yy354.pOffset = yymsp[-2].minor.yy190.pExpr; yygotominor.yy354.pLimit = yymsp[0].minor.yy190.pExpr;}
-#line 2807 "parse.c"
+      case 150: /* indexed_opt ::= NOT INDEXED */
+#line 587 "parse.y"
+{yygotominor.yy0.z=0; yygotominor.yy0.n=1;}
+#line 2757 "parse.c"
+        break;
+      case 151: /* using_opt ::= USING LP inscollist RP */
+      case 183: /* inscollist_opt ::= LP inscollist RP */ yytestcase(yyruleno==183);
+#line 591 "parse.y"
+{yygotominor.yy384 = yymsp[-1].minor.yy384;}
+#line 2763 "parse.c"
+        break;
+      case 152: /* using_opt ::= */
+      case 182: /* inscollist_opt ::= */ yytestcase(yyruleno==182);
+#line 592 "parse.y"
+{yygotominor.yy384 = 0;}
+#line 2769 "parse.c"
+        break;
+      case 154: /* orderby_opt ::= ORDER BY sortlist */
+      case 162: /* groupby_opt ::= GROUP BY nexprlist */ yytestcase(yyruleno==162);
+      case 241: /* exprlist ::= nexprlist */ yytestcase(yyruleno==241);
+      case 270: /* pragmaargs ::= pragmaarg */ yytestcase(yyruleno==270);
+#line 603 "parse.y"
+{yygotominor.yy322 = yymsp[0].minor.yy322;}
+#line 2777 "parse.c"
+        break;
+      case 155: /* sortlist ::= sortlist COMMA sortitem sortorder */
+#line 604 "parse.y"
+{
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,yymsp[-3].minor.yy322,yymsp[-1].minor.yy314);
+  if( yygotominor.yy322 ) yygotominor.yy322->a[yygotominor.yy322->nExpr-1].sortOrder = (u8)yymsp[0].minor.yy4;
+}
+#line 2785 "parse.c"
+        break;
+      case 156: /* sortlist ::= sortitem sortorder */
+#line 608 "parse.y"
+{
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,0,yymsp[-1].minor.yy314);
+  if( yygotominor.yy322 && ALWAYS(yygotominor.yy322->a) ) yygotominor.yy322->a[0].sortOrder = (u8)yymsp[0].minor.yy4;
+}
+#line 2793 "parse.c"
+        break;
+      case 158: /* sortorder ::= ASC */
+      case 160: /* sortorder ::= */ yytestcase(yyruleno==160);
+#line 616 "parse.y"
+{yygotominor.yy4 = SQLITE4_SO_ASC;}
+#line 2799 "parse.c"
+        break;
+      case 159: /* sortorder ::= DESC */
+#line 617 "parse.y"
+{yygotominor.yy4 = SQLITE4_SO_DESC;}
+#line 2804 "parse.c"
+        break;
+      case 165: /* limit_opt ::= */
+#line 643 "parse.y"
+{yygotominor.yy292.pLimit = 0; yygotominor.yy292.pOffset = 0;}
+#line 2809 "parse.c"
+        break;
+      case 166: /* limit_opt ::= LIMIT expr */
+#line 644 "parse.y"
+{yygotominor.yy292.pLimit = yymsp[0].minor.yy118.pExpr; yygotominor.yy292.pOffset = 0;}
+#line 2814 "parse.c"
+        break;
+      case 167: /* limit_opt ::= LIMIT expr OFFSET expr */
+#line 646 "parse.y"
+{yygotominor.yy292.pLimit = yymsp[-2].minor.yy118.pExpr; yygotominor.yy292.pOffset = yymsp[0].minor.yy118.pExpr;}
+#line 2819 "parse.c"
+        break;
+      case 168: /* limit_opt ::= LIMIT expr COMMA expr */
+#line 648 "parse.y"
+{yygotominor.yy292.pOffset = yymsp[-2].minor.yy118.pExpr; yygotominor.yy292.pLimit = yymsp[0].minor.yy118.pExpr;}
+#line 2824 "parse.c"
         break;
-      case 167: /* cmd ::= DELETE FROM fullname indexed_opt where_opt */
-#line 651 "parse.y"
+      case 169: /* cmd ::= DELETE FROM fullname indexed_opt where_opt */
+#line 661 "parse.y"
 {
-  sqlite4SrcListIndexedBy(pParse, yymsp[-2].minor.yy185, &yymsp[-1].minor.yy0);
-  sqlite4DeleteFrom(pParse,yymsp[-2].minor.yy185,yymsp[0].minor.yy72);
+  sqlite4SrcListIndexedBy(pParse, yymsp[-2].minor.yy259, &yymsp[-1].minor.yy0);
+  sqlite4DeleteFrom(pParse,yymsp[-2].minor.yy259,yymsp[0].minor.yy314);
 }
-#line 2815 "parse.c"
+#line 2832 "parse.c"
         break;
-      case 170: /* cmd ::= UPDATE orconf fullname indexed_opt SET setlist where_opt */
-#line 674 "parse.y"
+      case 172: /* cmd ::= UPDATE orconf fullname indexed_opt SET setlist where_opt */
+#line 684 "parse.y"
 {
-  sqlite4SrcListIndexedBy(pParse, yymsp[-4].minor.yy185, &yymsp[-3].minor.yy0);
-  sqlite4ExprListCheckLength(pParse,yymsp[-1].minor.yy148,"set list"); 
-  sqlite4Update(pParse,yymsp[-4].minor.yy185,yymsp[-1].minor.yy148,yymsp[0].minor.yy72,yymsp[-5].minor.yy234);
+  sqlite4SrcListIndexedBy(pParse, yymsp[-4].minor.yy259, &yymsp[-3].minor.yy0);
+  sqlite4ExprListCheckLength(pParse,yymsp[-1].minor.yy322,"set list"); 
+  sqlite4Update(pParse,yymsp[-4].minor.yy259,yymsp[-1].minor.yy322,yymsp[0].minor.yy314,yymsp[-5].minor.yy210);
 }
-#line 2824 "parse.c"
+#line 2841 "parse.c"
         break;
-      case 171: /* setlist ::= setlist COMMA nm EQ expr */
-#line 684 "parse.y"
+      case 173: /* setlist ::= setlist COMMA nm EQ expr */
+#line 694 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse, yymsp[-4].minor.yy148, yymsp[0].minor.yy190.pExpr);
-  sqlite4ExprListSetName(pParse, yygotominor.yy148, &yymsp[-2].minor.yy0, 1);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse, yymsp[-4].minor.yy322, yymsp[0].minor.yy118.pExpr);
+  sqlite4ExprListSetName(pParse, yygotominor.yy322, &yymsp[-2].minor.yy0, 1);
 }
-#line 2832 "parse.c"
+#line 2849 "parse.c"
         break;
-      case 172: /* setlist ::= nm EQ expr */
-#line 688 "parse.y"
+      case 174: /* setlist ::= nm EQ expr */
+#line 698 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse, 0, yymsp[0].minor.yy190.pExpr);
-  sqlite4ExprListSetName(pParse, yygotominor.yy148, &yymsp[-2].minor.yy0, 1);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse, 0, yymsp[0].minor.yy118.pExpr);
+  sqlite4ExprListSetName(pParse, yygotominor.yy322, &yymsp[-2].minor.yy0, 1);
 }
-#line 2840 "parse.c"
+#line 2857 "parse.c"
         break;
-      case 173: /* cmd ::= insert_cmd INTO fullname inscollist_opt valuelist */
-#line 696 "parse.y"
-{sqlite4Insert(pParse, yymsp[-2].minor.yy185, yymsp[0].minor.yy167.pList, yymsp[0].minor.yy167.pSelect, yymsp[-1].minor.yy254, yymsp[-4].minor.yy234);}
-#line 2845 "parse.c"
+      case 175: /* cmd ::= insert_cmd INTO fullname inscollist_opt valuelist */
+#line 706 "parse.y"
+{sqlite4Insert(pParse, yymsp[-2].minor.yy259, yymsp[0].minor.yy260.pList, yymsp[0].minor.yy260.pSelect, yymsp[-1].minor.yy384, yymsp[-4].minor.yy210);}
+#line 2862 "parse.c"
         break;
-      case 174: /* cmd ::= insert_cmd INTO fullname inscollist_opt select */
-#line 698 "parse.y"
-{sqlite4Insert(pParse, yymsp[-2].minor.yy185, 0, yymsp[0].minor.yy243, yymsp[-1].minor.yy254, yymsp[-4].minor.yy234);}
-#line 2850 "parse.c"
+      case 176: /* cmd ::= insert_cmd INTO fullname inscollist_opt select */
+#line 708 "parse.y"
+{sqlite4Insert(pParse, yymsp[-2].minor.yy259, 0, yymsp[0].minor.yy387, yymsp[-1].minor.yy384, yymsp[-4].minor.yy210);}
+#line 2867 "parse.c"
         break;
-      case 175: /* cmd ::= insert_cmd INTO fullname inscollist_opt DEFAULT VALUES */
-#line 700 "parse.y"
-{sqlite4Insert(pParse, yymsp[-3].minor.yy185, 0, 0, yymsp[-2].minor.yy254, yymsp[-5].minor.yy234);}
-#line 2855 "parse.c"
+      case 177: /* cmd ::= insert_cmd INTO fullname inscollist_opt DEFAULT VALUES */
+#line 710 "parse.y"
+{sqlite4Insert(pParse, yymsp[-3].minor.yy259, 0, 0, yymsp[-2].minor.yy384, yymsp[-5].minor.yy210);}
+#line 2872 "parse.c"
         break;
-      case 176: /* insert_cmd ::= INSERT orconf */
-#line 703 "parse.y"
-{yygotominor.yy234 = yymsp[0].minor.yy234;}
-#line 2860 "parse.c"
+      case 178: /* insert_cmd ::= INSERT orconf */
+#line 713 "parse.y"
+{yygotominor.yy210 = yymsp[0].minor.yy210;}
+#line 2877 "parse.c"
         break;
-      case 177: /* insert_cmd ::= REPLACE */
-#line 704 "parse.y"
-{yygotominor.yy234 = OE_Replace;}
-#line 2865 "parse.c"
+      case 179: /* insert_cmd ::= REPLACE */
+#line 714 "parse.y"
+{yygotominor.yy210 = OE_Replace;}
+#line 2882 "parse.c"
         break;
-      case 178: /* valuelist ::= VALUES LP nexprlist RP */
-#line 718 "parse.y"
+      case 180: /* valuelist ::= VALUES LP nexprlist RP */
+#line 728 "parse.y"
 {
-  yygotominor.yy167.pList = yymsp[-1].minor.yy148;
-  yygotominor.yy167.pSelect = 0;
+  yygotominor.yy260.pList = yymsp[-1].minor.yy322;
+  yygotominor.yy260.pSelect = 0;
 }
-#line 2873 "parse.c"
+#line 2890 "parse.c"
         break;
-      case 179: /* valuelist ::= valuelist COMMA LP exprlist RP */
-#line 722 "parse.y"
+      case 181: /* valuelist ::= valuelist COMMA LP exprlist RP */
+#line 732 "parse.y"
 {
-  Select *pRight = sqlite4SelectNew(pParse, yymsp[-1].minor.yy148, 0, 0, 0, 0, 0, 0, 0, 0);
-  if( yymsp[-4].minor.yy167.pList ){
-    yymsp[-4].minor.yy167.pSelect = sqlite4SelectNew(pParse, yymsp[-4].minor.yy167.pList, 0, 0, 0, 0, 0, 0, 0, 0);
-    yymsp[-4].minor.yy167.pList = 0;
+  Select *pRight = sqlite4SelectNew(pParse, yymsp[-1].minor.yy322, 0, 0, 0, 0, 0, 0, 0, 0);
+  if( yymsp[-4].minor.yy260.pList ){
+    yymsp[-4].minor.yy260.pSelect = sqlite4SelectNew(pParse, yymsp[-4].minor.yy260.pList, 0, 0, 0, 0, 0, 0, 0, 0);
+    yymsp[-4].minor.yy260.pList = 0;
   }
-  yygotominor.yy167.pList = 0;
-  if( yymsp[-4].minor.yy167.pSelect==0 || pRight==0 ){
+  yygotominor.yy260.pList = 0;
+  if( yymsp[-4].minor.yy260.pSelect==0 || pRight==0 ){
     sqlite4SelectDelete(pParse->db, pRight);
-    sqlite4SelectDelete(pParse->db, yymsp[-4].minor.yy167.pSelect);
-    yygotominor.yy167.pSelect = 0;
+    sqlite4SelectDelete(pParse->db, yymsp[-4].minor.yy260.pSelect);
+    yygotominor.yy260.pSelect = 0;
   }else{
     pRight->op = TK_ALL;
-    pRight->pPrior = yymsp[-4].minor.yy167.pSelect;
+    pRight->pPrior = yymsp[-4].minor.yy260.pSelect;
     pRight->selFlags |= SF_Values;
     pRight->pPrior->selFlags |= SF_Values;
-    yygotominor.yy167.pSelect = pRight;
+    yygotominor.yy260.pSelect = pRight;
   }
 }
-#line 2896 "parse.c"
-        break;
-      case 182: /* inscollist ::= inscollist COMMA nm */
-#line 750 "parse.y"
-{yygotominor.yy254 = sqlite4IdListAppend(pParse->db,yymsp[-2].minor.yy254,&yymsp[0].minor.yy0);}
-#line 2901 "parse.c"
-        break;
-      case 183: /* inscollist ::= nm */
-#line 752 "parse.y"
-{yygotominor.yy254 = sqlite4IdListAppend(pParse->db,0,&yymsp[0].minor.yy0);}
-#line 2906 "parse.c"
-        break;
-      case 184: /* expr ::= term */
-#line 783 "parse.y"
-{yygotominor.yy190 = yymsp[0].minor.yy190;}
-#line 2911 "parse.c"
-        break;
-      case 185: /* expr ::= LP expr RP */
-#line 784 "parse.y"
-{yygotominor.yy190.pExpr = yymsp[-1].minor.yy190.pExpr; spanSet(&yygotominor.yy190,&yymsp[-2].minor.yy0,&yymsp[0].minor.yy0);}
-#line 2916 "parse.c"
-        break;
-      case 186: /* term ::= NULL */
-      case 191: /* term ::= INTEGER|FLOAT|BLOB */ yytestcase(yyruleno==191);
-      case 192: /* term ::= STRING */ yytestcase(yyruleno==192);
-#line 785 "parse.y"
-{spanExpr(&yygotominor.yy190, pParse, yymsp[0].major, &yymsp[0].minor.yy0);}
+#line 2913 "parse.c"
+        break;
+      case 184: /* inscollist ::= inscollist COMMA nm */
+#line 760 "parse.y"
+{yygotominor.yy384 = sqlite4IdListAppend(pParse->db,yymsp[-2].minor.yy384,&yymsp[0].minor.yy0);}
+#line 2918 "parse.c"
+        break;
+      case 185: /* inscollist ::= nm */
+#line 762 "parse.y"
+{yygotominor.yy384 = sqlite4IdListAppend(pParse->db,0,&yymsp[0].minor.yy0);}
 #line 2923 "parse.c"
         break;
-      case 187: /* expr ::= id */
-      case 188: /* expr ::= JOIN_KW */ yytestcase(yyruleno==188);
-#line 786 "parse.y"
-{spanExpr(&yygotominor.yy190, pParse, TK_ID, &yymsp[0].minor.yy0);}
-#line 2929 "parse.c"
+      case 186: /* expr ::= term */
+#line 793 "parse.y"
+{yygotominor.yy118 = yymsp[0].minor.yy118;}
+#line 2928 "parse.c"
         break;
-      case 189: /* expr ::= nm DOT nm */
-#line 788 "parse.y"
+      case 187: /* expr ::= LP expr RP */
+#line 794 "parse.y"
+{yygotominor.yy118.pExpr = yymsp[-1].minor.yy118.pExpr; spanSet(&yygotominor.yy118,&yymsp[-2].minor.yy0,&yymsp[0].minor.yy0);}
+#line 2933 "parse.c"
+        break;
+      case 188: /* term ::= NULL */
+      case 193: /* term ::= INTEGER|FLOAT|BLOB */ yytestcase(yyruleno==193);
+      case 194: /* term ::= STRING */ yytestcase(yyruleno==194);
+#line 795 "parse.y"
+{spanExpr(&yygotominor.yy118, pParse, yymsp[0].major, &yymsp[0].minor.yy0);}
+#line 2940 "parse.c"
+        break;
+      case 189: /* expr ::= id */
+      case 190: /* expr ::= JOIN_KW */ yytestcase(yyruleno==190);
+#line 796 "parse.y"
+{spanExpr(&yygotominor.yy118, pParse, TK_ID, &yymsp[0].minor.yy0);}
+#line 2946 "parse.c"
+        break;
+      case 191: /* expr ::= nm DOT nm */
+#line 798 "parse.y"
 {
   Expr *temp1 = sqlite4PExpr(pParse, TK_ID, 0, 0, &yymsp[-2].minor.yy0);
   Expr *temp2 = sqlite4PExpr(pParse, TK_ID, 0, 0, &yymsp[0].minor.yy0);
-  yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_DOT, temp1, temp2, 0);
-  spanSet(&yygotominor.yy190,&yymsp[-2].minor.yy0,&yymsp[0].minor.yy0);
+  yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_DOT, temp1, temp2, 0);
+  spanSet(&yygotominor.yy118,&yymsp[-2].minor.yy0,&yymsp[0].minor.yy0);
 }
-#line 2939 "parse.c"
+#line 2956 "parse.c"
         break;
-      case 190: /* expr ::= nm DOT nm DOT nm */
-#line 794 "parse.y"
+      case 192: /* expr ::= nm DOT nm DOT nm */
+#line 804 "parse.y"
 {
   Expr *temp1 = sqlite4PExpr(pParse, TK_ID, 0, 0, &yymsp[-4].minor.yy0);
   Expr *temp2 = sqlite4PExpr(pParse, TK_ID, 0, 0, &yymsp[-2].minor.yy0);
   Expr *temp3 = sqlite4PExpr(pParse, TK_ID, 0, 0, &yymsp[0].minor.yy0);
   Expr *temp4 = sqlite4PExpr(pParse, TK_DOT, temp2, temp3, 0);
-  yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_DOT, temp1, temp4, 0);
-  spanSet(&yygotominor.yy190,&yymsp[-4].minor.yy0,&yymsp[0].minor.yy0);
+  yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_DOT, temp1, temp4, 0);
+  spanSet(&yygotominor.yy118,&yymsp[-4].minor.yy0,&yymsp[0].minor.yy0);
 }
-#line 2951 "parse.c"
+#line 2968 "parse.c"
         break;
-      case 193: /* expr ::= REGISTER */
-#line 804 "parse.y"
+      case 195: /* expr ::= REGISTER */
+#line 814 "parse.y"
 {
   /* When doing a nested parse, one can include terms in an expression
   ** that look like this:   #1 #2 ...  These terms refer to registers
   ** in the virtual machine.  #N is the N-th register. */
   if( pParse->nested==0 ){
     sqlite4ErrorMsg(pParse, "near \"%T\": syntax error", &yymsp[0].minor.yy0);
-    yygotominor.yy190.pExpr = 0;
+    yygotominor.yy118.pExpr = 0;
   }else{
-    yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_REGISTER, 0, 0, &yymsp[0].minor.yy0);
-    if( yygotominor.yy190.pExpr ) sqlite4GetInt32(&yymsp[0].minor.yy0.z[1], &yygotominor.yy190.pExpr->iTable);
+    yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_REGISTER, 0, 0, &yymsp[0].minor.yy0);
+    if( yygotominor.yy118.pExpr ) sqlite4GetInt32(&yymsp[0].minor.yy0.z[1], &yygotominor.yy118.pExpr->iTable);
   }
-  spanSet(&yygotominor.yy190, &yymsp[0].minor.yy0, &yymsp[0].minor.yy0);
+  spanSet(&yygotominor.yy118, &yymsp[0].minor.yy0, &yymsp[0].minor.yy0);
 }
-#line 2968 "parse.c"
+#line 2985 "parse.c"
         break;
-      case 194: /* expr ::= VARIABLE */
-#line 817 "parse.y"
+      case 196: /* expr ::= VARIABLE */
+#line 827 "parse.y"
 {
-  spanExpr(&yygotominor.yy190, pParse, TK_VARIABLE, &yymsp[0].minor.yy0);
-  sqlite4ExprAssignVarNumber(pParse, yygotominor.yy190.pExpr);
-  spanSet(&yygotominor.yy190, &yymsp[0].minor.yy0, &yymsp[0].minor.yy0);
+  spanExpr(&yygotominor.yy118, pParse, TK_VARIABLE, &yymsp[0].minor.yy0);
+  sqlite4ExprAssignVarNumber(pParse, yygotominor.yy118.pExpr);
+  spanSet(&yygotominor.yy118, &yymsp[0].minor.yy0, &yymsp[0].minor.yy0);
 }
-#line 2977 "parse.c"
+#line 2994 "parse.c"
         break;
-      case 195: /* expr ::= expr COLLATE ids */
-#line 822 "parse.y"
+      case 197: /* expr ::= expr COLLATE ids */
+#line 832 "parse.y"
 {
-  yygotominor.yy190.pExpr = sqlite4ExprSetCollByToken(pParse, yymsp[-2].minor.yy190.pExpr, &yymsp[0].minor.yy0);
-  yygotominor.yy190.zStart = yymsp[-2].minor.yy190.zStart;
-  yygotominor.yy190.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
+  yygotominor.yy118.pExpr = sqlite4ExprSetCollByToken(pParse, yymsp[-2].minor.yy118.pExpr, &yymsp[0].minor.yy0);
+  yygotominor.yy118.zStart = yymsp[-2].minor.yy118.zStart;
+  yygotominor.yy118.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
 }
-#line 2986 "parse.c"
+#line 3003 "parse.c"
         break;
-      case 196: /* expr ::= CAST LP expr AS typetoken RP */
-#line 828 "parse.y"
+      case 198: /* expr ::= CAST LP expr AS typetoken RP */
+#line 838 "parse.y"
 {
-  yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_CAST, yymsp[-3].minor.yy190.pExpr, 0, &yymsp[-1].minor.yy0);
-  spanSet(&yygotominor.yy190,&yymsp[-5].minor.yy0,&yymsp[0].minor.yy0);
+  yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_CAST, yymsp[-3].minor.yy118.pExpr, 0, &yymsp[-1].minor.yy0);
+  spanSet(&yygotominor.yy118,&yymsp[-5].minor.yy0,&yymsp[0].minor.yy0);
 }
-#line 2994 "parse.c"
+#line 3011 "parse.c"
         break;
-      case 197: /* expr ::= ID LP distinct exprlist RP */
-#line 833 "parse.y"
+      case 199: /* expr ::= ID LP distinct exprlist RP */
+#line 843 "parse.y"
 {
-  if( yymsp[-1].minor.yy148 && yymsp[-1].minor.yy148->nExpr>pParse->db->aLimit[SQLITE4_LIMIT_FUNCTION_ARG] ){
+  if( yymsp[-1].minor.yy322 && yymsp[-1].minor.yy322->nExpr>pParse->db->aLimit[SQLITE4_LIMIT_FUNCTION_ARG] ){
     sqlite4ErrorMsg(pParse, "too many arguments on function %T", &yymsp[-4].minor.yy0);
   }
-  yygotominor.yy190.pExpr = sqlite4ExprFunction(pParse, yymsp[-1].minor.yy148, &yymsp[-4].minor.yy0);
-  spanSet(&yygotominor.yy190,&yymsp[-4].minor.yy0,&yymsp[0].minor.yy0);
-  if( yymsp[-2].minor.yy194 && yygotominor.yy190.pExpr ){
-    yygotominor.yy190.pExpr->flags |= EP_Distinct;
+  yygotominor.yy118.pExpr = sqlite4ExprFunction(pParse, yymsp[-1].minor.yy322, &yymsp[-4].minor.yy0);
+  spanSet(&yygotominor.yy118,&yymsp[-4].minor.yy0,&yymsp[0].minor.yy0);
+  if( yymsp[-2].minor.yy4 && yygotominor.yy118.pExpr ){
+    yygotominor.yy118.pExpr->flags |= EP_Distinct;
   }
 }
-#line 3008 "parse.c"
+#line 3025 "parse.c"
         break;
-      case 198: /* expr ::= ID LP STAR RP */
-#line 843 "parse.y"
+      case 200: /* expr ::= ID LP STAR RP */
+#line 853 "parse.y"
 {
-  yygotominor.yy190.pExpr = sqlite4ExprFunction(pParse, 0, &yymsp[-3].minor.yy0);
-  spanSet(&yygotominor.yy190,&yymsp[-3].minor.yy0,&yymsp[0].minor.yy0);
+  yygotominor.yy118.pExpr = sqlite4ExprFunction(pParse, 0, &yymsp[-3].minor.yy0);
+  spanSet(&yygotominor.yy118,&yymsp[-3].minor.yy0,&yymsp[0].minor.yy0);
 }
-#line 3016 "parse.c"
+#line 3033 "parse.c"
         break;
-      case 199: /* term ::= CTIME_KW */
-#line 847 "parse.y"
+      case 201: /* term ::= CTIME_KW */
+#line 857 "parse.y"
 {
   /* The CURRENT_TIME, CURRENT_DATE, and CURRENT_TIMESTAMP values are
   ** treated as functions that return constants */
-  yygotominor.yy190.pExpr = sqlite4ExprFunction(pParse, 0,&yymsp[0].minor.yy0);
-  if( yygotominor.yy190.pExpr ){
-    yygotominor.yy190.pExpr->op = TK_CONST_FUNC;  
+  yygotominor.yy118.pExpr = sqlite4ExprFunction(pParse, 0,&yymsp[0].minor.yy0);
+  if( yygotominor.yy118.pExpr ){
+    yygotominor.yy118.pExpr->op = TK_CONST_FUNC;  
   }
-  spanSet(&yygotominor.yy190, &yymsp[0].minor.yy0, &yymsp[0].minor.yy0);
-}
-#line 3029 "parse.c"
-        break;
-      case 200: /* expr ::= expr AND expr */
-      case 201: /* expr ::= expr OR expr */ yytestcase(yyruleno==201);
-      case 202: /* expr ::= expr LT|GT|GE|LE expr */ yytestcase(yyruleno==202);
-      case 203: /* expr ::= expr EQ|NE expr */ yytestcase(yyruleno==203);
-      case 204: /* expr ::= expr BITAND|BITOR|LSHIFT|RSHIFT expr */ yytestcase(yyruleno==204);
-      case 205: /* expr ::= expr PLUS|MINUS expr */ yytestcase(yyruleno==205);
-      case 206: /* expr ::= expr STAR|SLASH|REM expr */ yytestcase(yyruleno==206);
-      case 207: /* expr ::= expr CONCAT expr */ yytestcase(yyruleno==207);
-#line 874 "parse.y"
-{spanBinaryExpr(&yygotominor.yy190,pParse,yymsp[-1].major,&yymsp[-2].minor.yy190,&yymsp[0].minor.yy190);}
-#line 3041 "parse.c"
-        break;
-      case 208: /* likeop ::= LIKE_KW */
-#line 887 "parse.y"
-{yygotominor.yy392.eOperator = yymsp[0].minor.yy0; yygotominor.yy392.not = 0;}
+  spanSet(&yygotominor.yy118, &yymsp[0].minor.yy0, &yymsp[0].minor.yy0);
+}
 #line 3046 "parse.c"
         break;
-      case 209: /* likeop ::= NOT LIKE_KW */
-      case 210: /* likeop ::= NOT MATCH */ yytestcase(yyruleno==210);
-#line 888 "parse.y"
-{yygotominor.yy392.eOperator = yymsp[0].minor.yy0; yygotominor.yy392.not = 1;}
-#line 3052 "parse.c"
-        break;
-      case 211: /* expr ::= expr likeop expr */
-#line 891 "parse.y"
+      case 202: /* expr ::= expr AND expr */
+      case 203: /* expr ::= expr OR expr */ yytestcase(yyruleno==203);
+      case 204: /* expr ::= expr LT|GT|GE|LE expr */ yytestcase(yyruleno==204);
+      case 205: /* expr ::= expr EQ|NE expr */ yytestcase(yyruleno==205);
+      case 206: /* expr ::= expr BITAND|BITOR|LSHIFT|RSHIFT expr */ yytestcase(yyruleno==206);
+      case 207: /* expr ::= expr PLUS|MINUS expr */ yytestcase(yyruleno==207);
+      case 208: /* expr ::= expr STAR|SLASH|REM expr */ yytestcase(yyruleno==208);
+      case 209: /* expr ::= expr CONCAT expr */ yytestcase(yyruleno==209);
+#line 884 "parse.y"
+{spanBinaryExpr(&yygotominor.yy118,pParse,yymsp[-1].major,&yymsp[-2].minor.yy118,&yymsp[0].minor.yy118);}
+#line 3058 "parse.c"
+        break;
+      case 210: /* likeop ::= LIKE_KW */
+#line 897 "parse.y"
+{yygotominor.yy342.eOperator = yymsp[0].minor.yy0; yygotominor.yy342.not = 0;}
+#line 3063 "parse.c"
+        break;
+      case 211: /* likeop ::= NOT LIKE_KW */
+      case 212: /* likeop ::= NOT MATCH */ yytestcase(yyruleno==212);
+#line 898 "parse.y"
+{yygotominor.yy342.eOperator = yymsp[0].minor.yy0; yygotominor.yy342.not = 1;}
+#line 3069 "parse.c"
+        break;
+      case 213: /* expr ::= expr likeop expr */
+#line 901 "parse.y"
 {
   ExprList *pList;
-  pList = sqlite4ExprListAppend(pParse,0, yymsp[0].minor.yy190.pExpr);
-  pList = sqlite4ExprListAppend(pParse,pList, yymsp[-2].minor.yy190.pExpr);
-  yygotominor.yy190.pExpr = sqlite4ExprFunction(pParse, pList, &yymsp[-1].minor.yy392.eOperator);
-  if( yymsp[-1].minor.yy392.not ) yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy190.pExpr, 0, 0);
-  yygotominor.yy190.zStart = yymsp[-2].minor.yy190.zStart;
-  yygotominor.yy190.zEnd = yymsp[0].minor.yy190.zEnd;
-  if( yygotominor.yy190.pExpr ) yygotominor.yy190.pExpr->flags |= EP_InfixFunc;
+  pList = sqlite4ExprListAppend(pParse,0, yymsp[0].minor.yy118.pExpr);
+  pList = sqlite4ExprListAppend(pParse,pList, yymsp[-2].minor.yy118.pExpr);
+  yygotominor.yy118.pExpr = sqlite4ExprFunction(pParse, pList, &yymsp[-1].minor.yy342.eOperator);
+  if( yymsp[-1].minor.yy342.not ) yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy118.pExpr, 0, 0);
+  yygotominor.yy118.zStart = yymsp[-2].minor.yy118.zStart;
+  yygotominor.yy118.zEnd = yymsp[0].minor.yy118.zEnd;
+  if( yygotominor.yy118.pExpr ) yygotominor.yy118.pExpr->flags |= EP_InfixFunc;
 }
-#line 3066 "parse.c"
+#line 3083 "parse.c"
         break;
-      case 212: /* expr ::= expr likeop expr ESCAPE expr */
-#line 901 "parse.y"
+      case 214: /* expr ::= expr likeop expr ESCAPE expr */
+#line 911 "parse.y"
 {
   ExprList *pList;
-  pList = sqlite4ExprListAppend(pParse,0, yymsp[-2].minor.yy190.pExpr);
-  pList = sqlite4ExprListAppend(pParse,pList, yymsp[-4].minor.yy190.pExpr);
-  pList = sqlite4ExprListAppend(pParse,pList, yymsp[0].minor.yy190.pExpr);
-  yygotominor.yy190.pExpr = sqlite4ExprFunction(pParse, pList, &yymsp[-3].minor.yy392.eOperator);
-  if( yymsp[-3].minor.yy392.not ) yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy190.pExpr, 0, 0);
-  yygotominor.yy190.zStart = yymsp[-4].minor.yy190.zStart;
-  yygotominor.yy190.zEnd = yymsp[0].minor.yy190.zEnd;
-  if( yygotominor.yy190.pExpr ) yygotominor.yy190.pExpr->flags |= EP_InfixFunc;
+  pList = sqlite4ExprListAppend(pParse,0, yymsp[-2].minor.yy118.pExpr);
+  pList = sqlite4ExprListAppend(pParse,pList, yymsp[-4].minor.yy118.pExpr);
+  pList = sqlite4ExprListAppend(pParse,pList, yymsp[0].minor.yy118.pExpr);
+  yygotominor.yy118.pExpr = sqlite4ExprFunction(pParse, pList, &yymsp[-3].minor.yy342.eOperator);
+  if( yymsp[-3].minor.yy342.not ) yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy118.pExpr, 0, 0);
+  yygotominor.yy118.zStart = yymsp[-4].minor.yy118.zStart;
+  yygotominor.yy118.zEnd = yymsp[0].minor.yy118.zEnd;
+  if( yygotominor.yy118.pExpr ) yygotominor.yy118.pExpr->flags |= EP_InfixFunc;
 }
-#line 3081 "parse.c"
+#line 3098 "parse.c"
         break;
-      case 213: /* expr ::= expr MATCH expr */
-#line 913 "parse.y"
+      case 215: /* expr ::= expr MATCH expr */
+#line 923 "parse.y"
 {
-  spanBinaryExpr(&yygotominor.yy190, pParse, TK_MATCH, &yymsp[-2].minor.yy190, &yymsp[0].minor.yy190);
+  spanBinaryExpr(&yygotominor.yy118, pParse, TK_MATCH, &yymsp[-2].minor.yy118, &yymsp[0].minor.yy118);
 }
-#line 3088 "parse.c"
+#line 3105 "parse.c"
         break;
-      case 214: /* expr ::= expr ISNULL|NOTNULL */
-#line 933 "parse.y"
-{spanUnaryPostfix(&yygotominor.yy190,pParse,yymsp[0].major,&yymsp[-1].minor.yy190,&yymsp[0].minor.yy0);}
-#line 3093 "parse.c"
+      case 216: /* expr ::= expr ISNULL|NOTNULL */
+#line 943 "parse.y"
+{spanUnaryPostfix(&yygotominor.yy118,pParse,yymsp[0].major,&yymsp[-1].minor.yy118,&yymsp[0].minor.yy0);}
+#line 3110 "parse.c"
         break;
-      case 215: /* expr ::= expr NOT NULL */
-#line 934 "parse.y"
-{spanUnaryPostfix(&yygotominor.yy190,pParse,TK_NOTNULL,&yymsp[-2].minor.yy190,&yymsp[0].minor.yy0);}
-#line 3098 "parse.c"
+      case 217: /* expr ::= expr NOT NULL */
+#line 944 "parse.y"
+{spanUnaryPostfix(&yygotominor.yy118,pParse,TK_NOTNULL,&yymsp[-2].minor.yy118,&yymsp[0].minor.yy0);}
+#line 3115 "parse.c"
         break;
-      case 216: /* expr ::= expr IS expr */
-#line 955 "parse.y"
+      case 218: /* expr ::= expr IS expr */
+#line 965 "parse.y"
 {
-  spanBinaryExpr(&yygotominor.yy190,pParse,TK_IS,&yymsp[-2].minor.yy190,&yymsp[0].minor.yy190);
-  binaryToUnaryIfNull(pParse, yymsp[0].minor.yy190.pExpr, yygotominor.yy190.pExpr, TK_ISNULL);
+  spanBinaryExpr(&yygotominor.yy118,pParse,TK_IS,&yymsp[-2].minor.yy118,&yymsp[0].minor.yy118);
+  binaryToUnaryIfNull(pParse, yymsp[0].minor.yy118.pExpr, yygotominor.yy118.pExpr, TK_ISNULL);
 }
-#line 3106 "parse.c"
+#line 3123 "parse.c"
         break;
-      case 217: /* expr ::= expr IS NOT expr */
-#line 959 "parse.y"
+      case 219: /* expr ::= expr IS NOT expr */
+#line 969 "parse.y"
 {
-  spanBinaryExpr(&yygotominor.yy190,pParse,TK_ISNOT,&yymsp[-3].minor.yy190,&yymsp[0].minor.yy190);
-  binaryToUnaryIfNull(pParse, yymsp[0].minor.yy190.pExpr, yygotominor.yy190.pExpr, TK_NOTNULL);
+  spanBinaryExpr(&yygotominor.yy118,pParse,TK_ISNOT,&yymsp[-3].minor.yy118,&yymsp[0].minor.yy118);
+  binaryToUnaryIfNull(pParse, yymsp[0].minor.yy118.pExpr, yygotominor.yy118.pExpr, TK_NOTNULL);
 }
-#line 3114 "parse.c"
+#line 3131 "parse.c"
         break;
-      case 218: /* expr ::= NOT expr */
-      case 219: /* expr ::= BITNOT expr */ yytestcase(yyruleno==219);
-#line 982 "parse.y"
-{spanUnaryPrefix(&yygotominor.yy190,pParse,yymsp[-1].major,&yymsp[0].minor.yy190,&yymsp[-1].minor.yy0);}
-#line 3120 "parse.c"
+      case 220: /* expr ::= NOT expr */
+      case 221: /* expr ::= BITNOT expr */ yytestcase(yyruleno==221);
+#line 992 "parse.y"
+{spanUnaryPrefix(&yygotominor.yy118,pParse,yymsp[-1].major,&yymsp[0].minor.yy118,&yymsp[-1].minor.yy0);}
+#line 3137 "parse.c"
         break;
-      case 220: /* expr ::= MINUS expr */
-#line 985 "parse.y"
-{spanUnaryPrefix(&yygotominor.yy190,pParse,TK_UMINUS,&yymsp[0].minor.yy190,&yymsp[-1].minor.yy0);}
-#line 3125 "parse.c"
+      case 222: /* expr ::= MINUS expr */
+#line 995 "parse.y"
+{spanUnaryPrefix(&yygotominor.yy118,pParse,TK_UMINUS,&yymsp[0].minor.yy118,&yymsp[-1].minor.yy0);}
+#line 3142 "parse.c"
         break;
-      case 221: /* expr ::= PLUS expr */
-#line 987 "parse.y"
-{spanUnaryPrefix(&yygotominor.yy190,pParse,TK_UPLUS,&yymsp[0].minor.yy190,&yymsp[-1].minor.yy0);}
-#line 3130 "parse.c"
+      case 223: /* expr ::= PLUS expr */
+#line 997 "parse.y"
+{spanUnaryPrefix(&yygotominor.yy118,pParse,TK_UPLUS,&yymsp[0].minor.yy118,&yymsp[-1].minor.yy0);}
+#line 3147 "parse.c"
         break;
-      case 224: /* expr ::= expr between_op expr AND expr */
-#line 992 "parse.y"
+      case 226: /* expr ::= expr between_op expr AND expr */
+#line 1002 "parse.y"
 {
-  ExprList *pList = sqlite4ExprListAppend(pParse,0, yymsp[-2].minor.yy190.pExpr);
-  pList = sqlite4ExprListAppend(pParse,pList, yymsp[0].minor.yy190.pExpr);
-  yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_BETWEEN, yymsp[-4].minor.yy190.pExpr, 0, 0);
-  if( yygotominor.yy190.pExpr ){
-    yygotominor.yy190.pExpr->x.pList = pList;
+  ExprList *pList = sqlite4ExprListAppend(pParse,0, yymsp[-2].minor.yy118.pExpr);
+  pList = sqlite4ExprListAppend(pParse,pList, yymsp[0].minor.yy118.pExpr);
+  yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_BETWEEN, yymsp[-4].minor.yy118.pExpr, 0, 0);
+  if( yygotominor.yy118.pExpr ){
+    yygotominor.yy118.pExpr->x.pList = pList;
   }else{
     sqlite4ExprListDelete(pParse->db, pList);
   } 
-  if( yymsp[-3].minor.yy194 ) yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy190.pExpr, 0, 0);
-  yygotominor.yy190.zStart = yymsp[-4].minor.yy190.zStart;
-  yygotominor.yy190.zEnd = yymsp[0].minor.yy190.zEnd;
+  if( yymsp[-3].minor.yy4 ) yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy118.pExpr, 0, 0);
+  yygotominor.yy118.zStart = yymsp[-4].minor.yy118.zStart;
+  yygotominor.yy118.zEnd = yymsp[0].minor.yy118.zEnd;
 }
-#line 3147 "parse.c"
+#line 3164 "parse.c"
         break;
-      case 227: /* expr ::= expr in_op LP exprlist RP */
-#line 1009 "parse.y"
+      case 229: /* expr ::= expr in_op LP exprlist RP */
+#line 1019 "parse.y"
 {
-    if( yymsp[-1].minor.yy148==0 ){
+    if( yymsp[-1].minor.yy322==0 ){
       /* Expressions of the form
       **
       **      expr1 IN ()
@@ -3157,544 +3174,544 @@ static void yy_reduce(
       ** simplify to constants 0 (false) and 1 (true), respectively,
       ** regardless of the value of expr1.
       */
-      yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_INTEGER, 0, 0, &sqlite4IntTokens[yymsp[-3].minor.yy194]);
-      sqlite4ExprDelete(pParse->db, yymsp[-4].minor.yy190.pExpr);
+      yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_INTEGER, 0, 0, &sqlite4IntTokens[yymsp[-3].minor.yy4]);
+      sqlite4ExprDelete(pParse->db, yymsp[-4].minor.yy118.pExpr);
     }else{
-      yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_IN, yymsp[-4].minor.yy190.pExpr, 0, 0);
-      if( yygotominor.yy190.pExpr ){
-        yygotominor.yy190.pExpr->x.pList = yymsp[-1].minor.yy148;
-        sqlite4ExprSetHeight(pParse, yygotominor.yy190.pExpr);
+      yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_IN, yymsp[-4].minor.yy118.pExpr, 0, 0);
+      if( yygotominor.yy118.pExpr ){
+        yygotominor.yy118.pExpr->x.pList = yymsp[-1].minor.yy322;
+        sqlite4ExprSetHeight(pParse, yygotominor.yy118.pExpr);
       }else{
-        sqlite4ExprListDelete(pParse->db, yymsp[-1].minor.yy148);
+        sqlite4ExprListDelete(pParse->db, yymsp[-1].minor.yy322);
       }
-      if( yymsp[-3].minor.yy194 ) yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy190.pExpr, 0, 0);
+      if( yymsp[-3].minor.yy4 ) yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy118.pExpr, 0, 0);
     }
-    yygotominor.yy190.zStart = yymsp[-4].minor.yy190.zStart;
-    yygotominor.yy190.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
+    yygotominor.yy118.zStart = yymsp[-4].minor.yy118.zStart;
+    yygotominor.yy118.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
   }
-#line 3176 "parse.c"
+#line 3193 "parse.c"
         break;
-      case 228: /* expr ::= LP select RP */
-#line 1034 "parse.y"
+      case 230: /* expr ::= LP select RP */
+#line 1044 "parse.y"
 {
-    yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_SELECT, 0, 0, 0);
-    if( yygotominor.yy190.pExpr ){
-      yygotominor.yy190.pExpr->x.pSelect = yymsp[-1].minor.yy243;
-      ExprSetProperty(yygotominor.yy190.pExpr, EP_xIsSelect);
-      sqlite4ExprSetHeight(pParse, yygotominor.yy190.pExpr);
+    yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_SELECT, 0, 0, 0);
+    if( yygotominor.yy118.pExpr ){
+      yygotominor.yy118.pExpr->x.pSelect = yymsp[-1].minor.yy387;
+      ExprSetProperty(yygotominor.yy118.pExpr, EP_xIsSelect);
+      sqlite4ExprSetHeight(pParse, yygotominor.yy118.pExpr);
     }else{
-      sqlite4SelectDelete(pParse->db, yymsp[-1].minor.yy243);
+      sqlite4SelectDelete(pParse->db, yymsp[-1].minor.yy387);
     }
-    yygotominor.yy190.zStart = yymsp[-2].minor.yy0.z;
-    yygotominor.yy190.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
+    yygotominor.yy118.zStart = yymsp[-2].minor.yy0.z;
+    yygotominor.yy118.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
   }
-#line 3192 "parse.c"
+#line 3209 "parse.c"
         break;
-      case 229: /* expr ::= expr in_op LP select RP */
-#line 1046 "parse.y"
+      case 231: /* expr ::= expr in_op LP select RP */
+#line 1056 "parse.y"
 {
-    yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_IN, yymsp[-4].minor.yy190.pExpr, 0, 0);
-    if( yygotominor.yy190.pExpr ){
-      yygotominor.yy190.pExpr->x.pSelect = yymsp[-1].minor.yy243;
-      ExprSetProperty(yygotominor.yy190.pExpr, EP_xIsSelect);
-      sqlite4ExprSetHeight(pParse, yygotominor.yy190.pExpr);
+    yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_IN, yymsp[-4].minor.yy118.pExpr, 0, 0);
+    if( yygotominor.yy118.pExpr ){
+      yygotominor.yy118.pExpr->x.pSelect = yymsp[-1].minor.yy387;
+      ExprSetProperty(yygotominor.yy118.pExpr, EP_xIsSelect);
+      sqlite4ExprSetHeight(pParse, yygotominor.yy118.pExpr);
     }else{
-      sqlite4SelectDelete(pParse->db, yymsp[-1].minor.yy243);
+      sqlite4SelectDelete(pParse->db, yymsp[-1].minor.yy387);
     }
-    if( yymsp[-3].minor.yy194 ) yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy190.pExpr, 0, 0);
-    yygotominor.yy190.zStart = yymsp[-4].minor.yy190.zStart;
-    yygotominor.yy190.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
+    if( yymsp[-3].minor.yy4 ) yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy118.pExpr, 0, 0);
+    yygotominor.yy118.zStart = yymsp[-4].minor.yy118.zStart;
+    yygotominor.yy118.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
   }
-#line 3209 "parse.c"
+#line 3226 "parse.c"
         break;
-      case 230: /* expr ::= expr in_op nm dbnm */
-#line 1059 "parse.y"
+      case 232: /* expr ::= expr in_op nm dbnm */
+#line 1069 "parse.y"
 {
     SrcList *pSrc = sqlite4SrcListAppend(pParse->db, 0,&yymsp[-1].minor.yy0,&yymsp[0].minor.yy0);
-    yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_IN, yymsp[-3].minor.yy190.pExpr, 0, 0);
-    if( yygotominor.yy190.pExpr ){
-      yygotominor.yy190.pExpr->x.pSelect = sqlite4SelectNew(pParse, 0,pSrc,0,0,0,0,0,0,0);
-      ExprSetProperty(yygotominor.yy190.pExpr, EP_xIsSelect);
-      sqlite4ExprSetHeight(pParse, yygotominor.yy190.pExpr);
+    yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_IN, yymsp[-3].minor.yy118.pExpr, 0, 0);
+    if( yygotominor.yy118.pExpr ){
+      yygotominor.yy118.pExpr->x.pSelect = sqlite4SelectNew(pParse, 0,pSrc,0,0,0,0,0,0,0);
+      ExprSetProperty(yygotominor.yy118.pExpr, EP_xIsSelect);
+      sqlite4ExprSetHeight(pParse, yygotominor.yy118.pExpr);
     }else{
       sqlite4SrcListDelete(pParse->db, pSrc);
     }
-    if( yymsp[-2].minor.yy194 ) yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy190.pExpr, 0, 0);
-    yygotominor.yy190.zStart = yymsp[-3].minor.yy190.zStart;
-    yygotominor.yy190.zEnd = yymsp[0].minor.yy0.z ? &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n] : &yymsp[-1].minor.yy0.z[yymsp[-1].minor.yy0.n];
+    if( yymsp[-2].minor.yy4 ) yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_NOT, yygotominor.yy118.pExpr, 0, 0);
+    yygotominor.yy118.zStart = yymsp[-3].minor.yy118.zStart;
+    yygotominor.yy118.zEnd = yymsp[0].minor.yy0.z ? &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n] : &yymsp[-1].minor.yy0.z[yymsp[-1].minor.yy0.n];
   }
-#line 3227 "parse.c"
+#line 3244 "parse.c"
         break;
-      case 231: /* expr ::= EXISTS LP select RP */
-#line 1073 "parse.y"
+      case 233: /* expr ::= EXISTS LP select RP */
+#line 1083 "parse.y"
 {
-    Expr *p = yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_EXISTS, 0, 0, 0);
+    Expr *p = yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_EXISTS, 0, 0, 0);
     if( p ){
-      p->x.pSelect = yymsp[-1].minor.yy243;
+      p->x.pSelect = yymsp[-1].minor.yy387;
       ExprSetProperty(p, EP_xIsSelect);
       sqlite4ExprSetHeight(pParse, p);
     }else{
-      sqlite4SelectDelete(pParse->db, yymsp[-1].minor.yy243);
+      sqlite4SelectDelete(pParse->db, yymsp[-1].minor.yy387);
     }
-    yygotominor.yy190.zStart = yymsp[-3].minor.yy0.z;
-    yygotominor.yy190.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
+    yygotominor.yy118.zStart = yymsp[-3].minor.yy0.z;
+    yygotominor.yy118.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
   }
-#line 3243 "parse.c"
+#line 3260 "parse.c"
         break;
-      case 232: /* expr ::= CASE case_operand case_exprlist case_else END */
-#line 1088 "parse.y"
+      case 234: /* expr ::= CASE case_operand case_exprlist case_else END */
+#line 1098 "parse.y"
 {
-  yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_CASE, yymsp[-3].minor.yy72, yymsp[-1].minor.yy72, 0);
-  if( yygotominor.yy190.pExpr ){
-    yygotominor.yy190.pExpr->x.pList = yymsp[-2].minor.yy148;
-    sqlite4ExprSetHeight(pParse, yygotominor.yy190.pExpr);
+  yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_CASE, yymsp[-3].minor.yy314, yymsp[-1].minor.yy314, 0);
+  if( yygotominor.yy118.pExpr ){
+    yygotominor.yy118.pExpr->x.pList = yymsp[-2].minor.yy322;
+    sqlite4ExprSetHeight(pParse, yygotominor.yy118.pExpr);
   }else{
-    sqlite4ExprListDelete(pParse->db, yymsp[-2].minor.yy148);
+    sqlite4ExprListDelete(pParse->db, yymsp[-2].minor.yy322);
   }
-  yygotominor.yy190.zStart = yymsp[-4].minor.yy0.z;
-  yygotominor.yy190.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
+  yygotominor.yy118.zStart = yymsp[-4].minor.yy0.z;
+  yygotominor.yy118.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
 }
-#line 3258 "parse.c"
+#line 3275 "parse.c"
         break;
-      case 233: /* case_exprlist ::= case_exprlist WHEN expr THEN expr */
-#line 1101 "parse.y"
+      case 235: /* case_exprlist ::= case_exprlist WHEN expr THEN expr */
+#line 1111 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,yymsp[-4].minor.yy148, yymsp[-2].minor.yy190.pExpr);
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,yygotominor.yy148, yymsp[0].minor.yy190.pExpr);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,yymsp[-4].minor.yy322, yymsp[-2].minor.yy118.pExpr);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,yygotominor.yy322, yymsp[0].minor.yy118.pExpr);
 }
-#line 3266 "parse.c"
+#line 3283 "parse.c"
         break;
-      case 234: /* case_exprlist ::= WHEN expr THEN expr */
-#line 1105 "parse.y"
+      case 236: /* case_exprlist ::= WHEN expr THEN expr */
+#line 1115 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,0, yymsp[-2].minor.yy190.pExpr);
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,yygotominor.yy148, yymsp[0].minor.yy190.pExpr);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,0, yymsp[-2].minor.yy118.pExpr);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,yygotominor.yy322, yymsp[0].minor.yy118.pExpr);
 }
-#line 3274 "parse.c"
+#line 3291 "parse.c"
         break;
-      case 241: /* nexprlist ::= nexprlist COMMA expr */
-#line 1126 "parse.y"
-{yygotominor.yy148 = sqlite4ExprListAppend(pParse,yymsp[-2].minor.yy148,yymsp[0].minor.yy190.pExpr);}
-#line 3279 "parse.c"
+      case 243: /* nexprlist ::= nexprlist COMMA expr */
+#line 1136 "parse.y"
+{yygotominor.yy322 = sqlite4ExprListAppend(pParse,yymsp[-2].minor.yy322,yymsp[0].minor.yy118.pExpr);}
+#line 3296 "parse.c"
         break;
-      case 242: /* nexprlist ::= expr */
-#line 1128 "parse.y"
-{yygotominor.yy148 = sqlite4ExprListAppend(pParse,0,yymsp[0].minor.yy190.pExpr);}
-#line 3284 "parse.c"
+      case 244: /* nexprlist ::= expr */
+#line 1138 "parse.y"
+{yygotominor.yy322 = sqlite4ExprListAppend(pParse,0,yymsp[0].minor.yy118.pExpr);}
+#line 3301 "parse.c"
         break;
-      case 243: /* createindex ::= createkw uniqueflag INDEX ifnotexists nm dbnm ON nm */
-#line 1137 "parse.y"
+      case 245: /* createindex ::= createkw uniqueflag INDEX ifnotexists nm dbnm ON nm */
+#line 1147 "parse.y"
 {
-  yygotominor.yy195.bUnique = yymsp[-6].minor.yy194;
-  yygotominor.yy195.bIfnotexist = yymsp[-4].minor.yy194;
-  yygotominor.yy195.tCreate = yymsp[-7].minor.yy0;
-  yygotominor.yy195.tName1 = yymsp[-3].minor.yy0;
-  yygotominor.yy195.tName2 = yymsp[-2].minor.yy0;
-  yygotominor.yy195.pTblName = sqlite4SrcListAppend(pParse->db, 0, &yymsp[0].minor.yy0, 0);
+  yygotominor.yy233.bUnique = yymsp[-6].minor.yy4;
+  yygotominor.yy233.bIfnotexist = yymsp[-4].minor.yy4;
+  yygotominor.yy233.tCreate = yymsp[-7].minor.yy0;
+  yygotominor.yy233.tName1 = yymsp[-3].minor.yy0;
+  yygotominor.yy233.tName2 = yymsp[-2].minor.yy0;
+  yygotominor.yy233.pTblName = sqlite4SrcListAppend(pParse->db, 0, &yymsp[0].minor.yy0, 0);
 }
-#line 3296 "parse.c"
+#line 3313 "parse.c"
         break;
-      case 244: /* cmd ::= createindex LP idxlist RP covering_opt */
-#line 1146 "parse.y"
+      case 246: /* cmd ::= createindex LP idxlist RP covering_opt */
+#line 1156 "parse.y"
 {
-  Token *pEnd = (yymsp[0].minor.yy376.pList ? &yymsp[0].minor.yy376.sEnd : &yymsp[-1].minor.yy0);
-  sqlite4CreateIndex(pParse, &yymsp[-4].minor.yy195, yymsp[-2].minor.yy148, yymsp[0].minor.yy376.pList, yymsp[-4].minor.yy195.bUnique, pEnd, SQLITE4_SO_ASC,0);
+  Token *pEnd = (yymsp[0].minor.yy422.pList ? &yymsp[0].minor.yy422.sEnd : &yymsp[-1].minor.yy0);
+  sqlite4CreateIndex(pParse, &yymsp[-4].minor.yy233, yymsp[-2].minor.yy322, yymsp[0].minor.yy422.pList, yymsp[-4].minor.yy233.bUnique, pEnd, SQLITE4_SO_ASC,0);
 }
-#line 3304 "parse.c"
+#line 3321 "parse.c"
         break;
-      case 245: /* uniqueflag ::= UNIQUE */
-      case 307: /* raisetype ::= ABORT */ yytestcase(yyruleno==307);
-#line 1152 "parse.y"
-{yygotominor.yy194 = OE_Abort;}
-#line 3310 "parse.c"
+      case 247: /* uniqueflag ::= UNIQUE */
+      case 309: /* raisetype ::= ABORT */ yytestcase(yyruleno==309);
+#line 1162 "parse.y"
+{yygotominor.yy4 = OE_Abort;}
+#line 3327 "parse.c"
         break;
-      case 246: /* uniqueflag ::= */
-#line 1153 "parse.y"
-{yygotominor.yy194 = OE_None;}
-#line 3315 "parse.c"
+      case 248: /* uniqueflag ::= */
+#line 1163 "parse.y"
+{yygotominor.yy4 = OE_None;}
+#line 3332 "parse.c"
         break;
-      case 249: /* idxlist ::= idxlist COMMA nm collate sortorder */
-#line 1162 "parse.y"
+      case 251: /* idxlist ::= idxlist COMMA nm collate sortorder */
+#line 1172 "parse.y"
 {
   Expr *p = 0;
   if( yymsp[-1].minor.yy0.n>0 ){
     p = sqlite4Expr(pParse->db, TK_COLUMN, 0);
     sqlite4ExprSetCollByToken(pParse, p, &yymsp[-1].minor.yy0);
   }
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,yymsp[-4].minor.yy148, p);
-  sqlite4ExprListSetName(pParse,yygotominor.yy148,&yymsp[-2].minor.yy0,1);
-  sqlite4ExprListCheckLength(pParse, yygotominor.yy148, "index");
-  if( yygotominor.yy148 ) yygotominor.yy148->a[yygotominor.yy148->nExpr-1].sortOrder = (u8)yymsp[0].minor.yy194;
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,yymsp[-4].minor.yy322, p);
+  sqlite4ExprListSetName(pParse,yygotominor.yy322,&yymsp[-2].minor.yy0,1);
+  sqlite4ExprListCheckLength(pParse, yygotominor.yy322, "index");
+  if( yygotominor.yy322 ) yygotominor.yy322->a[yygotominor.yy322->nExpr-1].sortOrder = (u8)yymsp[0].minor.yy4;
 }
-#line 3330 "parse.c"
+#line 3347 "parse.c"
         break;
-      case 250: /* idxlist ::= nm collate sortorder */
-#line 1173 "parse.y"
+      case 252: /* idxlist ::= nm collate sortorder */
+#line 1183 "parse.y"
 {
   Expr *p = 0;
   if( yymsp[-1].minor.yy0.n>0 ){
     p = sqlite4PExpr(pParse, TK_COLUMN, 0, 0, 0);
     sqlite4ExprSetCollByToken(pParse, p, &yymsp[-1].minor.yy0);
   }
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,0, p);
-  sqlite4ExprListSetName(pParse, yygotominor.yy148, &yymsp[-2].minor.yy0, 1);
-  sqlite4ExprListCheckLength(pParse, yygotominor.yy148, "index");
-  if( yygotominor.yy148 ) yygotominor.yy148->a[yygotominor.yy148->nExpr-1].sortOrder = (u8)yymsp[0].minor.yy194;
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,0, p);
+  sqlite4ExprListSetName(pParse, yygotominor.yy322, &yymsp[-2].minor.yy0, 1);
+  sqlite4ExprListCheckLength(pParse, yygotominor.yy322, "index");
+  if( yygotominor.yy322 ) yygotominor.yy322->a[yygotominor.yy322->nExpr-1].sortOrder = (u8)yymsp[0].minor.yy4;
 }
-#line 3345 "parse.c"
+#line 3362 "parse.c"
         break;
-      case 251: /* collate ::= */
-#line 1186 "parse.y"
+      case 253: /* collate ::= */
+#line 1196 "parse.y"
 {yygotominor.yy0.z = 0; yygotominor.yy0.n = 0;}
-#line 3350 "parse.c"
+#line 3367 "parse.c"
         break;
-      case 253: /* cmd ::= createindex USING nm LP uidxlist_opt RP */
-#line 1194 "parse.y"
+      case 255: /* cmd ::= createindex USING nm LP uidxlist_opt RP */
+#line 1204 "parse.y"
 {
-  sqlite4CreateUsingIndex(pParse, &yymsp[-5].minor.yy195, yymsp[-1].minor.yy148, &yymsp[-3].minor.yy0, &yymsp[0].minor.yy0);
+  sqlite4CreateUsingIndex(pParse, &yymsp[-5].minor.yy233, yymsp[-1].minor.yy322, &yymsp[-3].minor.yy0, &yymsp[0].minor.yy0);
 }
-#line 3357 "parse.c"
+#line 3374 "parse.c"
         break;
-      case 254: /* uidxlist_opt ::= uidxlist */
-#line 1198 "parse.y"
-{ yygotominor.yy148 = yymsp[0].minor.yy148; }
-#line 3362 "parse.c"
+      case 256: /* uidxlist_opt ::= uidxlist */
+#line 1208 "parse.y"
+{ yygotominor.yy322 = yymsp[0].minor.yy322; }
+#line 3379 "parse.c"
         break;
-      case 255: /* uidxlist_opt ::= */
-#line 1199 "parse.y"
-{ yygotominor.yy148 = 0; }
-#line 3367 "parse.c"
+      case 257: /* uidxlist_opt ::= */
+#line 1209 "parse.y"
+{ yygotominor.yy322 = 0; }
+#line 3384 "parse.c"
         break;
-      case 256: /* uidxlist ::= uidxlist COMMA ids EQ ids */
-#line 1201 "parse.y"
+      case 258: /* uidxlist ::= uidxlist COMMA ids EQ ids */
+#line 1211 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse, yymsp[-4].minor.yy148, sqlite4PExpr(pParse, yymsp[0].major, 0, 0, &yymsp[0].minor.yy0));
-  sqlite4ExprListSetName(pParse, yygotominor.yy148, &yymsp[-2].minor.yy0, 1);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse, yymsp[-4].minor.yy322, sqlite4PExpr(pParse, yymsp[0].major, 0, 0, &yymsp[0].minor.yy0));
+  sqlite4ExprListSetName(pParse, yygotominor.yy322, &yymsp[-2].minor.yy0, 1);
 }
-#line 3375 "parse.c"
+#line 3392 "parse.c"
         break;
-      case 257: /* uidxlist ::= uidxlist COMMA ids */
-#line 1205 "parse.y"
+      case 259: /* uidxlist ::= uidxlist COMMA ids */
+#line 1215 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse, yymsp[-2].minor.yy148, sqlite4PExpr(pParse, yymsp[0].major, 0, 0, &yymsp[0].minor.yy0));
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse, yymsp[-2].minor.yy322, sqlite4PExpr(pParse, yymsp[0].major, 0, 0, &yymsp[0].minor.yy0));
 }
-#line 3382 "parse.c"
+#line 3399 "parse.c"
         break;
-      case 258: /* uidxlist ::= ids EQ ids */
-#line 1208 "parse.y"
+      case 260: /* uidxlist ::= ids EQ ids */
+#line 1218 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse, 0, sqlite4PExpr(pParse, yymsp[0].major, 0, 0, &yymsp[0].minor.yy0));
-  sqlite4ExprListSetName(pParse, yygotominor.yy148, &yymsp[-2].minor.yy0, 1);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse, 0, sqlite4PExpr(pParse, yymsp[0].major, 0, 0, &yymsp[0].minor.yy0));
+  sqlite4ExprListSetName(pParse, yygotominor.yy322, &yymsp[-2].minor.yy0, 1);
 }
-#line 3390 "parse.c"
+#line 3407 "parse.c"
         break;
-      case 259: /* uidxlist ::= ids */
-#line 1212 "parse.y"
+      case 261: /* uidxlist ::= ids */
+#line 1222 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse, 0, sqlite4PExpr(pParse, yymsp[0].major, 0, 0, &yymsp[0].minor.yy0));
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse, 0, sqlite4PExpr(pParse, yymsp[0].major, 0, 0, &yymsp[0].minor.yy0));
 }
-#line 3397 "parse.c"
+#line 3414 "parse.c"
         break;
-      case 260: /* covering_opt ::= */
-#line 1218 "parse.y"
-{ yygotominor.yy376.pList = 0; }
-#line 3402 "parse.c"
+      case 262: /* covering_opt ::= */
+#line 1228 "parse.y"
+{ yygotominor.yy422.pList = 0; }
+#line 3419 "parse.c"
         break;
-      case 261: /* covering_opt ::= COVERING ALL */
-#line 1219 "parse.y"
+      case 263: /* covering_opt ::= COVERING ALL */
+#line 1229 "parse.y"
 { 
-  yygotominor.yy376.pList = sqlite4DbMallocZero(pParse->db, sizeof(IdList)); 
-  yygotominor.yy376.sEnd = yymsp[0].minor.yy0;
+  yygotominor.yy422.pList = sqlite4DbMallocZero(pParse->db, sizeof(IdList)); 
+  yygotominor.yy422.sEnd = yymsp[0].minor.yy0;
 }
-#line 3410 "parse.c"
+#line 3427 "parse.c"
         break;
-      case 262: /* covering_opt ::= COVERING LP inscollist RP */
-#line 1223 "parse.y"
+      case 264: /* covering_opt ::= COVERING LP inscollist RP */
+#line 1233 "parse.y"
 { 
-  yygotominor.yy376.pList = yymsp[-1].minor.yy254; 
-  yygotominor.yy376.sEnd = yymsp[0].minor.yy0;
+  yygotominor.yy422.pList = yymsp[-1].minor.yy384; 
+  yygotominor.yy422.sEnd = yymsp[0].minor.yy0;
 }
-#line 3418 "parse.c"
+#line 3435 "parse.c"
         break;
-      case 263: /* cmd ::= DROP INDEX ifexists fullname */
-#line 1231 "parse.y"
-{sqlite4DropIndex(pParse, yymsp[0].minor.yy185, yymsp[-1].minor.yy194);}
-#line 3423 "parse.c"
+      case 265: /* cmd ::= DROP INDEX ifexists fullname */
+#line 1241 "parse.y"
+{sqlite4DropIndex(pParse, yymsp[0].minor.yy259, yymsp[-1].minor.yy4);}
+#line 3440 "parse.c"
         break;
-      case 264: /* cmd ::= PRAGMA nm dbnm */
-#line 1237 "parse.y"
+      case 266: /* cmd ::= PRAGMA nm dbnm */
+#line 1247 "parse.y"
 { sqlite4Pragma(pParse, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy0, 0); }
-#line 3428 "parse.c"
+#line 3445 "parse.c"
         break;
-      case 265: /* cmd ::= PRAGMA nm dbnm LP RP */
-#line 1238 "parse.y"
+      case 267: /* cmd ::= PRAGMA nm dbnm LP RP */
+#line 1248 "parse.y"
 { sqlite4Pragma(pParse, &yymsp[-3].minor.yy0, &yymsp[-2].minor.yy0, 0); }
-#line 3433 "parse.c"
+#line 3450 "parse.c"
         break;
-      case 266: /* cmd ::= PRAGMA nm dbnm LP pragmaargs RP */
-#line 1239 "parse.y"
+      case 268: /* cmd ::= PRAGMA nm dbnm LP pragmaargs RP */
+#line 1249 "parse.y"
 {
-  sqlite4Pragma(pParse, &yymsp[-4].minor.yy0, &yymsp[-3].minor.yy0, yymsp[-1].minor.yy148);
+  sqlite4Pragma(pParse, &yymsp[-4].minor.yy0, &yymsp[-3].minor.yy0, yymsp[-1].minor.yy322);
 }
-#line 3440 "parse.c"
+#line 3457 "parse.c"
         break;
-      case 267: /* cmd ::= PRAGMA nm dbnm EQ pragmaarg */
-#line 1242 "parse.y"
+      case 269: /* cmd ::= PRAGMA nm dbnm EQ pragmaarg */
+#line 1252 "parse.y"
 {
-  sqlite4Pragma(pParse, &yymsp[-3].minor.yy0, &yymsp[-2].minor.yy0, yymsp[0].minor.yy148);
+  sqlite4Pragma(pParse, &yymsp[-3].minor.yy0, &yymsp[-2].minor.yy0, yymsp[0].minor.yy322);
 }
-#line 3447 "parse.c"
+#line 3464 "parse.c"
         break;
-      case 269: /* pragmaargs ::= pragmaargs COMMA expr */
-#line 1252 "parse.y"
+      case 271: /* pragmaargs ::= pragmaargs COMMA expr */
+#line 1262 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,yymsp[-2].minor.yy148,yymsp[0].minor.yy190.pExpr);
-  sqlite4ExprListSetSpan(pParse,yygotominor.yy148,&yymsp[0].minor.yy190);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,yymsp[-2].minor.yy322,yymsp[0].minor.yy118.pExpr);
+  sqlite4ExprListSetSpan(pParse,yygotominor.yy322,&yymsp[0].minor.yy118);
 }
-#line 3455 "parse.c"
+#line 3472 "parse.c"
         break;
-      case 270: /* pragmaarg ::= expr */
-#line 1256 "parse.y"
+      case 272: /* pragmaarg ::= expr */
+#line 1266 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse,0,yymsp[0].minor.yy190.pExpr);
-  sqlite4ExprListSetSpan(pParse,yygotominor.yy148,&yymsp[0].minor.yy190);
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse,0,yymsp[0].minor.yy118.pExpr);
+  sqlite4ExprListSetSpan(pParse,yygotominor.yy322,&yymsp[0].minor.yy118);
 }
-#line 3463 "parse.c"
+#line 3480 "parse.c"
         break;
-      case 271: /* pragmaarg ::= ON */
-      case 272: /* pragmaarg ::= DELETE */ yytestcase(yyruleno==272);
-      case 273: /* pragmaarg ::= DEFAULT */ yytestcase(yyruleno==273);
-#line 1260 "parse.y"
+      case 273: /* pragmaarg ::= ON */
+      case 274: /* pragmaarg ::= DELETE */ yytestcase(yyruleno==274);
+      case 275: /* pragmaarg ::= DEFAULT */ yytestcase(yyruleno==275);
+#line 1270 "parse.y"
 {
-  yygotominor.yy148 = sqlite4ExprListAppend(pParse, 0, sqlite4PExpr(pParse, TK_ID, 0, 0, &yymsp[0].minor.yy0)); 
+  yygotominor.yy322 = sqlite4ExprListAppend(pParse, 0, sqlite4PExpr(pParse, TK_ID, 0, 0, &yymsp[0].minor.yy0)); 
 }
-#line 3472 "parse.c"
+#line 3489 "parse.c"
         break;
-      case 279: /* cmd ::= createkw trigger_decl BEGIN trigger_cmd_list END */
-#line 1294 "parse.y"
+      case 281: /* cmd ::= createkw trigger_decl BEGIN trigger_cmd_list END */
+#line 1304 "parse.y"
 {
   Token all;
   all.z = yymsp[-3].minor.yy0.z;
   all.n = (int)(yymsp[0].minor.yy0.z - yymsp[-3].minor.yy0.z) + yymsp[0].minor.yy0.n;
-  sqlite4FinishTrigger(pParse, yymsp[-1].minor.yy145, &all);
+  sqlite4FinishTrigger(pParse, yymsp[-1].minor.yy203, &all);
 }
-#line 3482 "parse.c"
+#line 3499 "parse.c"
         break;
-      case 280: /* trigger_decl ::= temp TRIGGER ifnotexists nm dbnm trigger_time trigger_event ON fullname foreach_clause when_clause */
-#line 1303 "parse.y"
+      case 282: /* trigger_decl ::= temp TRIGGER ifnotexists nm dbnm trigger_time trigger_event ON fullname foreach_clause when_clause */
+#line 1313 "parse.y"
 {
-  sqlite4BeginTrigger(pParse, &yymsp[-7].minor.yy0, &yymsp[-6].minor.yy0, yymsp[-5].minor.yy194, yymsp[-4].minor.yy332.a, yymsp[-4].minor.yy332.b, yymsp[-2].minor.yy185, yymsp[0].minor.yy72, yymsp[-10].minor.yy194, yymsp[-8].minor.yy194);
+  sqlite4BeginTrigger(pParse, &yymsp[-7].minor.yy0, &yymsp[-6].minor.yy0, yymsp[-5].minor.yy4, yymsp[-4].minor.yy90.a, yymsp[-4].minor.yy90.b, yymsp[-2].minor.yy259, yymsp[0].minor.yy314, yymsp[-10].minor.yy4, yymsp[-8].minor.yy4);
   yygotominor.yy0 = (yymsp[-6].minor.yy0.n==0?yymsp[-7].minor.yy0:yymsp[-6].minor.yy0);
 }
-#line 3490 "parse.c"
-        break;
-      case 281: /* trigger_time ::= BEFORE */
-      case 284: /* trigger_time ::= */ yytestcase(yyruleno==284);
-#line 1309 "parse.y"
-{ yygotominor.yy194 = TK_BEFORE; }
-#line 3496 "parse.c"
-        break;
-      case 282: /* trigger_time ::= AFTER */
-#line 1310 "parse.y"
-{ yygotominor.yy194 = TK_AFTER;  }
-#line 3501 "parse.c"
-        break;
-      case 283: /* trigger_time ::= INSTEAD OF */
-#line 1311 "parse.y"
-{ yygotominor.yy194 = TK_INSTEAD;}
-#line 3506 "parse.c"
-        break;
-      case 285: /* trigger_event ::= DELETE|INSERT */
-      case 286: /* trigger_event ::= UPDATE */ yytestcase(yyruleno==286);
-#line 1316 "parse.y"
-{yygotominor.yy332.a = yymsp[0].major; yygotominor.yy332.b = 0;}
-#line 3512 "parse.c"
-        break;
-      case 287: /* trigger_event ::= UPDATE OF inscollist */
-#line 1318 "parse.y"
-{yygotominor.yy332.a = TK_UPDATE; yygotominor.yy332.b = yymsp[0].minor.yy254;}
-#line 3517 "parse.c"
-        break;
-      case 290: /* when_clause ::= */
-      case 312: /* key_opt ::= */ yytestcase(yyruleno==312);
-#line 1325 "parse.y"
-{ yygotominor.yy72 = 0; }
+#line 3507 "parse.c"
+        break;
+      case 283: /* trigger_time ::= BEFORE */
+      case 286: /* trigger_time ::= */ yytestcase(yyruleno==286);
+#line 1319 "parse.y"
+{ yygotominor.yy4 = TK_BEFORE; }
+#line 3513 "parse.c"
+        break;
+      case 284: /* trigger_time ::= AFTER */
+#line 1320 "parse.y"
+{ yygotominor.yy4 = TK_AFTER;  }
+#line 3518 "parse.c"
+        break;
+      case 285: /* trigger_time ::= INSTEAD OF */
+#line 1321 "parse.y"
+{ yygotominor.yy4 = TK_INSTEAD;}
 #line 3523 "parse.c"
         break;
-      case 291: /* when_clause ::= WHEN expr */
-      case 313: /* key_opt ::= KEY expr */ yytestcase(yyruleno==313);
+      case 287: /* trigger_event ::= DELETE|INSERT */
+      case 288: /* trigger_event ::= UPDATE */ yytestcase(yyruleno==288);
 #line 1326 "parse.y"
-{ yygotominor.yy72 = yymsp[0].minor.yy190.pExpr; }
+{yygotominor.yy90.a = yymsp[0].major; yygotominor.yy90.b = 0;}
 #line 3529 "parse.c"
         break;
-      case 292: /* trigger_cmd_list ::= trigger_cmd_list trigger_cmd SEMI */
-#line 1330 "parse.y"
+      case 289: /* trigger_event ::= UPDATE OF inscollist */
+#line 1328 "parse.y"
+{yygotominor.yy90.a = TK_UPDATE; yygotominor.yy90.b = yymsp[0].minor.yy384;}
+#line 3534 "parse.c"
+        break;
+      case 292: /* when_clause ::= */
+      case 314: /* key_opt ::= */ yytestcase(yyruleno==314);
+#line 1335 "parse.y"
+{ yygotominor.yy314 = 0; }
+#line 3540 "parse.c"
+        break;
+      case 293: /* when_clause ::= WHEN expr */
+      case 315: /* key_opt ::= KEY expr */ yytestcase(yyruleno==315);
+#line 1336 "parse.y"
+{ yygotominor.yy314 = yymsp[0].minor.yy118.pExpr; }
+#line 3546 "parse.c"
+        break;
+      case 294: /* trigger_cmd_list ::= trigger_cmd_list trigger_cmd SEMI */
+#line 1340 "parse.y"
 {
-  assert( yymsp[-2].minor.yy145!=0 );
-  yymsp[-2].minor.yy145->pLast->pNext = yymsp[-1].minor.yy145;
-  yymsp[-2].minor.yy145->pLast = yymsp[-1].minor.yy145;
-  yygotominor.yy145 = yymsp[-2].minor.yy145;
+  assert( yymsp[-2].minor.yy203!=0 );
+  yymsp[-2].minor.yy203->pLast->pNext = yymsp[-1].minor.yy203;
+  yymsp[-2].minor.yy203->pLast = yymsp[-1].minor.yy203;
+  yygotominor.yy203 = yymsp[-2].minor.yy203;
 }
-#line 3539 "parse.c"
+#line 3556 "parse.c"
         break;
-      case 293: /* trigger_cmd_list ::= trigger_cmd SEMI */
-#line 1336 "parse.y"
+      case 295: /* trigger_cmd_list ::= trigger_cmd SEMI */
+#line 1346 "parse.y"
 { 
-  assert( yymsp[-1].minor.yy145!=0 );
-  yymsp[-1].minor.yy145->pLast = yymsp[-1].minor.yy145;
-  yygotominor.yy145 = yymsp[-1].minor.yy145;
+  assert( yymsp[-1].minor.yy203!=0 );
+  yymsp[-1].minor.yy203->pLast = yymsp[-1].minor.yy203;
+  yygotominor.yy203 = yymsp[-1].minor.yy203;
 }
-#line 3548 "parse.c"
+#line 3565 "parse.c"
         break;
-      case 295: /* trnm ::= nm DOT nm */
-#line 1348 "parse.y"
+      case 297: /* trnm ::= nm DOT nm */
+#line 1358 "parse.y"
 {
   yygotominor.yy0 = yymsp[0].minor.yy0;
   sqlite4ErrorMsg(pParse, 
         "qualified table names are not allowed on INSERT, UPDATE, and DELETE "
         "statements within triggers");
 }
-#line 3558 "parse.c"
+#line 3575 "parse.c"
         break;
-      case 297: /* tridxby ::= INDEXED BY nm */
-#line 1360 "parse.y"
+      case 299: /* tridxby ::= INDEXED BY nm */
+#line 1370 "parse.y"
 {
   sqlite4ErrorMsg(pParse,
         "the INDEXED BY clause is not allowed on UPDATE or DELETE statements "
         "within triggers");
 }
-#line 3567 "parse.c"
+#line 3584 "parse.c"
         break;
-      case 298: /* tridxby ::= NOT INDEXED */
-#line 1365 "parse.y"
+      case 300: /* tridxby ::= NOT INDEXED */
+#line 1375 "parse.y"
 {
   sqlite4ErrorMsg(pParse,
         "the NOT INDEXED clause is not allowed on UPDATE or DELETE statements "
         "within triggers");
 }
-#line 3576 "parse.c"
+#line 3593 "parse.c"
         break;
-      case 299: /* trigger_cmd ::= UPDATE orconf trnm tridxby SET setlist where_opt */
-#line 1378 "parse.y"
-{ yygotominor.yy145 = sqlite4TriggerUpdateStep(pParse->db, &yymsp[-4].minor.yy0, yymsp[-1].minor.yy148, yymsp[0].minor.yy72, yymsp[-5].minor.yy234); }
-#line 3581 "parse.c"
+      case 301: /* trigger_cmd ::= UPDATE orconf trnm tridxby SET setlist where_opt */
+#line 1388 "parse.y"
+{ yygotominor.yy203 = sqlite4TriggerUpdateStep(pParse->db, &yymsp[-4].minor.yy0, yymsp[-1].minor.yy322, yymsp[0].minor.yy314, yymsp[-5].minor.yy210); }
+#line 3598 "parse.c"
         break;
-      case 300: /* trigger_cmd ::= insert_cmd INTO trnm inscollist_opt valuelist */
-#line 1383 "parse.y"
-{yygotominor.yy145 = sqlite4TriggerInsertStep(pParse->db, &yymsp[-2].minor.yy0, yymsp[-1].minor.yy254, yymsp[0].minor.yy167.pList, yymsp[0].minor.yy167.pSelect, yymsp[-4].minor.yy234);}
-#line 3586 "parse.c"
+      case 302: /* trigger_cmd ::= insert_cmd INTO trnm inscollist_opt valuelist */
+#line 1393 "parse.y"
+{yygotominor.yy203 = sqlite4TriggerInsertStep(pParse->db, &yymsp[-2].minor.yy0, yymsp[-1].minor.yy384, yymsp[0].minor.yy260.pList, yymsp[0].minor.yy260.pSelect, yymsp[-4].minor.yy210);}
+#line 3603 "parse.c"
         break;
-      case 301: /* trigger_cmd ::= insert_cmd INTO trnm inscollist_opt select */
-#line 1386 "parse.y"
-{yygotominor.yy145 = sqlite4TriggerInsertStep(pParse->db, &yymsp[-2].minor.yy0, yymsp[-1].minor.yy254, 0, yymsp[0].minor.yy243, yymsp[-4].minor.yy234);}
-#line 3591 "parse.c"
+      case 303: /* trigger_cmd ::= insert_cmd INTO trnm inscollist_opt select */
+#line 1396 "parse.y"
+{yygotominor.yy203 = sqlite4TriggerInsertStep(pParse->db, &yymsp[-2].minor.yy0, yymsp[-1].minor.yy384, 0, yymsp[0].minor.yy387, yymsp[-4].minor.yy210);}
+#line 3608 "parse.c"
         break;
-      case 302: /* trigger_cmd ::= DELETE FROM trnm tridxby where_opt */
-#line 1390 "parse.y"
-{yygotominor.yy145 = sqlite4TriggerDeleteStep(pParse->db, &yymsp[-2].minor.yy0, yymsp[0].minor.yy72);}
-#line 3596 "parse.c"
+      case 304: /* trigger_cmd ::= DELETE FROM trnm tridxby where_opt */
+#line 1400 "parse.y"
+{yygotominor.yy203 = sqlite4TriggerDeleteStep(pParse->db, &yymsp[-2].minor.yy0, yymsp[0].minor.yy314);}
+#line 3613 "parse.c"
         break;
-      case 303: /* trigger_cmd ::= select */
-#line 1393 "parse.y"
-{yygotominor.yy145 = sqlite4TriggerSelectStep(pParse->db, yymsp[0].minor.yy243); }
-#line 3601 "parse.c"
+      case 305: /* trigger_cmd ::= select */
+#line 1403 "parse.y"
+{yygotominor.yy203 = sqlite4TriggerSelectStep(pParse->db, yymsp[0].minor.yy387); }
+#line 3618 "parse.c"
         break;
-      case 304: /* expr ::= RAISE LP IGNORE RP */
-#line 1396 "parse.y"
+      case 306: /* expr ::= RAISE LP IGNORE RP */
+#line 1406 "parse.y"
 {
-  yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_RAISE, 0, 0, 0); 
-  if( yygotominor.yy190.pExpr ){
-    yygotominor.yy190.pExpr->affinity = OE_Ignore;
+  yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_RAISE, 0, 0, 0); 
+  if( yygotominor.yy118.pExpr ){
+    yygotominor.yy118.pExpr->affinity = OE_Ignore;
   }
-  yygotominor.yy190.zStart = yymsp[-3].minor.yy0.z;
-  yygotominor.yy190.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
+  yygotominor.yy118.zStart = yymsp[-3].minor.yy0.z;
+  yygotominor.yy118.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
 }
-#line 3613 "parse.c"
+#line 3630 "parse.c"
         break;
-      case 305: /* expr ::= RAISE LP raisetype COMMA nm RP */
-#line 1404 "parse.y"
+      case 307: /* expr ::= RAISE LP raisetype COMMA nm RP */
+#line 1414 "parse.y"
 {
-  yygotominor.yy190.pExpr = sqlite4PExpr(pParse, TK_RAISE, 0, 0, &yymsp[-1].minor.yy0); 
-  if( yygotominor.yy190.pExpr ) {
-    yygotominor.yy190.pExpr->affinity = (char)yymsp[-3].minor.yy194;
+  yygotominor.yy118.pExpr = sqlite4PExpr(pParse, TK_RAISE, 0, 0, &yymsp[-1].minor.yy0); 
+  if( yygotominor.yy118.pExpr ) {
+    yygotominor.yy118.pExpr->affinity = (char)yymsp[-3].minor.yy4;
   }
-  yygotominor.yy190.zStart = yymsp[-5].minor.yy0.z;
-  yygotominor.yy190.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
+  yygotominor.yy118.zStart = yymsp[-5].minor.yy0.z;
+  yygotominor.yy118.zEnd = &yymsp[0].minor.yy0.z[yymsp[0].minor.yy0.n];
 }
-#line 3625 "parse.c"
+#line 3642 "parse.c"
         break;
-      case 306: /* raisetype ::= ROLLBACK */
-#line 1415 "parse.y"
-{yygotominor.yy194 = OE_Rollback;}
-#line 3630 "parse.c"
+      case 308: /* raisetype ::= ROLLBACK */
+#line 1425 "parse.y"
+{yygotominor.yy4 = OE_Rollback;}
+#line 3647 "parse.c"
         break;
-      case 308: /* raisetype ::= FAIL */
-#line 1417 "parse.y"
-{yygotominor.yy194 = OE_Fail;}
-#line 3635 "parse.c"
+      case 310: /* raisetype ::= FAIL */
+#line 1427 "parse.y"
+{yygotominor.yy4 = OE_Fail;}
+#line 3652 "parse.c"
         break;
-      case 309: /* cmd ::= DROP TRIGGER ifexists fullname */
-#line 1422 "parse.y"
+      case 311: /* cmd ::= DROP TRIGGER ifexists fullname */
+#line 1432 "parse.y"
 {
-  sqlite4DropTrigger(pParse,yymsp[0].minor.yy185,yymsp[-1].minor.yy194);
+  sqlite4DropTrigger(pParse,yymsp[0].minor.yy259,yymsp[-1].minor.yy4);
 }
-#line 3642 "parse.c"
+#line 3659 "parse.c"
         break;
-      case 310: /* cmd ::= ATTACH database_kw_opt expr AS expr key_opt */
-#line 1429 "parse.y"
+      case 312: /* cmd ::= ATTACH database_kw_opt expr AS expr key_opt */
+#line 1439 "parse.y"
 {
-  sqlite4Attach(pParse, yymsp[-3].minor.yy190.pExpr, yymsp[-1].minor.yy190.pExpr, yymsp[0].minor.yy72);
+  sqlite4Attach(pParse, yymsp[-3].minor.yy118.pExpr, yymsp[-1].minor.yy118.pExpr, yymsp[0].minor.yy314);
 }
-#line 3649 "parse.c"
+#line 3666 "parse.c"
         break;
-      case 311: /* cmd ::= DETACH database_kw_opt expr */
-#line 1432 "parse.y"
+      case 313: /* cmd ::= DETACH database_kw_opt expr */
+#line 1442 "parse.y"
 {
-  sqlite4Detach(pParse, yymsp[0].minor.yy190.pExpr);
+  sqlite4Detach(pParse, yymsp[0].minor.yy118.pExpr);
 }
-#line 3656 "parse.c"
+#line 3673 "parse.c"
         break;
-      case 316: /* cmd ::= REINDEX */
-#line 1447 "parse.y"
+      case 318: /* cmd ::= REINDEX */
+#line 1457 "parse.y"
 {sqlite4Reindex(pParse, 0, 0);}
-#line 3661 "parse.c"
+#line 3678 "parse.c"
         break;
-      case 317: /* cmd ::= REINDEX nm dbnm */
-#line 1448 "parse.y"
+      case 319: /* cmd ::= REINDEX nm dbnm */
+#line 1458 "parse.y"
 {sqlite4Reindex(pParse, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy0);}
-#line 3666 "parse.c"
+#line 3683 "parse.c"
         break;
-      case 318: /* cmd ::= ANALYZE */
-#line 1453 "parse.y"
+      case 320: /* cmd ::= ANALYZE */
+#line 1463 "parse.y"
 {sqlite4Analyze(pParse, 0, 0);}
-#line 3671 "parse.c"
+#line 3688 "parse.c"
         break;
-      case 319: /* cmd ::= ANALYZE nm dbnm */
-#line 1454 "parse.y"
+      case 321: /* cmd ::= ANALYZE nm dbnm */
+#line 1464 "parse.y"
 {sqlite4Analyze(pParse, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy0);}
-#line 3676 "parse.c"
+#line 3693 "parse.c"
         break;
-      case 320: /* cmd ::= ALTER TABLE fullname RENAME TO nm */
-#line 1459 "parse.y"
+      case 322: /* cmd ::= ALTER TABLE fullname RENAME TO nm */
+#line 1469 "parse.y"
 {
-  sqlite4AlterRenameTable(pParse,yymsp[-3].minor.yy185,&yymsp[0].minor.yy0);
+  sqlite4AlterRenameTable(pParse,yymsp[-3].minor.yy259,&yymsp[0].minor.yy0);
 }
-#line 3683 "parse.c"
+#line 3700 "parse.c"
         break;
-      case 321: /* cmd ::= ALTER TABLE add_column_fullname ADD kwcolumn_opt column */
-#line 1462 "parse.y"
+      case 323: /* cmd ::= ALTER TABLE add_column_fullname ADD kwcolumn_opt column */
+#line 1472 "parse.y"
 {
   sqlite4AlterFinishAddColumn(pParse, &yymsp[0].minor.yy0);
 }
-#line 3690 "parse.c"
+#line 3707 "parse.c"
         break;
-      case 322: /* add_column_fullname ::= fullname */
-#line 1465 "parse.y"
+      case 324: /* add_column_fullname ::= fullname */
+#line 1475 "parse.y"
 {
   pParse->db->lookaside.bEnabled = 0;
-  sqlite4AlterBeginAddColumn(pParse, yymsp[0].minor.yy185);
+  sqlite4AlterBeginAddColumn(pParse, yymsp[0].minor.yy259);
 }
-#line 3698 "parse.c"
+#line 3715 "parse.c"
         break;
       default:
       /* (0) input ::= cmdlist */ yytestcase(yyruleno==0);
@@ -3702,35 +3719,35 @@ static void yy_reduce(
       /* (2) cmdlist ::= ecmd */ yytestcase(yyruleno==2);
       /* (3) ecmd ::= SEMI */ yytestcase(yyruleno==3);
       /* (4) ecmd ::= explain cmdx SEMI */ yytestcase(yyruleno==4);
-      /* (10) trans_opt ::= */ yytestcase(yyruleno==10);
-      /* (11) trans_opt ::= TRANSACTION */ yytestcase(yyruleno==11);
-      /* (12) trans_opt ::= TRANSACTION nm */ yytestcase(yyruleno==12);
-      /* (20) savepoint_opt ::= SAVEPOINT */ yytestcase(yyruleno==20);
-      /* (21) savepoint_opt ::= */ yytestcase(yyruleno==21);
-      /* (25) cmd ::= create_table create_table_args */ yytestcase(yyruleno==25);
-      /* (34) columnlist ::= columnlist COMMA column */ yytestcase(yyruleno==34);
-      /* (35) columnlist ::= column */ yytestcase(yyruleno==35);
-      /* (44) type ::= */ yytestcase(yyruleno==44);
-      /* (51) signed ::= plus_num */ yytestcase(yyruleno==51);
-      /* (52) signed ::= minus_num */ yytestcase(yyruleno==52);
-      /* (53) carglist ::= carglist carg */ yytestcase(yyruleno==53);
-      /* (54) carglist ::= */ yytestcase(yyruleno==54);
-      /* (55) carg ::= CONSTRAINT nm ccons */ yytestcase(yyruleno==55);
-      /* (56) carg ::= ccons */ yytestcase(yyruleno==56);
-      /* (62) ccons ::= NULL onconf */ yytestcase(yyruleno==62);
-      /* (90) conslist ::= conslist COMMA tcons */ yytestcase(yyruleno==90);
-      /* (91) conslist ::= conslist tcons */ yytestcase(yyruleno==91);
-      /* (92) conslist ::= tcons */ yytestcase(yyruleno==92);
-      /* (93) tcons ::= CONSTRAINT nm */ yytestcase(yyruleno==93);
-      /* (277) plus_opt ::= PLUS */ yytestcase(yyruleno==277);
-      /* (278) plus_opt ::= */ yytestcase(yyruleno==278);
-      /* (288) foreach_clause ::= */ yytestcase(yyruleno==288);
-      /* (289) foreach_clause ::= FOR EACH ROW */ yytestcase(yyruleno==289);
-      /* (296) tridxby ::= */ yytestcase(yyruleno==296);
-      /* (314) database_kw_opt ::= DATABASE */ yytestcase(yyruleno==314);
-      /* (315) database_kw_opt ::= */ yytestcase(yyruleno==315);
-      /* (323) kwcolumn_opt ::= */ yytestcase(yyruleno==323);
-      /* (324) kwcolumn_opt ::= COLUMNKW */ yytestcase(yyruleno==324);
+      /* (12) trans_opt ::= */ yytestcase(yyruleno==12);
+      /* (13) trans_opt ::= TRANSACTION */ yytestcase(yyruleno==13);
+      /* (14) trans_opt ::= TRANSACTION nm */ yytestcase(yyruleno==14);
+      /* (22) savepoint_opt ::= SAVEPOINT */ yytestcase(yyruleno==22);
+      /* (23) savepoint_opt ::= */ yytestcase(yyruleno==23);
+      /* (27) cmd ::= create_table create_table_args */ yytestcase(yyruleno==27);
+      /* (36) columnlist ::= columnlist COMMA column */ yytestcase(yyruleno==36);
+      /* (37) columnlist ::= column */ yytestcase(yyruleno==37);
+      /* (46) type ::= */ yytestcase(yyruleno==46);
+      /* (53) signed ::= plus_num */ yytestcase(yyruleno==53);
+      /* (54) signed ::= minus_num */ yytestcase(yyruleno==54);
+      /* (55) carglist ::= carglist carg */ yytestcase(yyruleno==55);
+      /* (56) carglist ::= */ yytestcase(yyruleno==56);
+      /* (57) carg ::= CONSTRAINT nm ccons */ yytestcase(yyruleno==57);
+      /* (58) carg ::= ccons */ yytestcase(yyruleno==58);
+      /* (64) ccons ::= NULL onconf */ yytestcase(yyruleno==64);
+      /* (92) conslist ::= conslist COMMA tcons */ yytestcase(yyruleno==92);
+      /* (93) conslist ::= conslist tcons */ yytestcase(yyruleno==93);
+      /* (94) conslist ::= tcons */ yytestcase(yyruleno==94);
+      /* (95) tcons ::= CONSTRAINT nm */ yytestcase(yyruleno==95);
+      /* (279) plus_opt ::= PLUS */ yytestcase(yyruleno==279);
+      /* (280) plus_opt ::= */ yytestcase(yyruleno==280);
+      /* (290) foreach_clause ::= */ yytestcase(yyruleno==290);
+      /* (291) foreach_clause ::= FOR EACH ROW */ yytestcase(yyruleno==291);
+      /* (298) tridxby ::= */ yytestcase(yyruleno==298);
+      /* (316) database_kw_opt ::= DATABASE */ yytestcase(yyruleno==316);
+      /* (317) database_kw_opt ::= */ yytestcase(yyruleno==317);
+      /* (325) kwcolumn_opt ::= */ yytestcase(yyruleno==325);
+      /* (326) kwcolumn_opt ::= COLUMNKW */ yytestcase(yyruleno==326);
         break;
   };
   yygoto = yyRuleInfo[yyruleno].lhs;
@@ -3795,7 +3812,7 @@ static void yy_syntax_error(
   UNUSED_PARAMETER(yymajor);  /* Silence some compiler warnings */
   assert( TOKEN.z[0] );  /* The tokenizer always gives us a token */
   sqlite4ErrorMsg(pParse, "near \"%T\": syntax error", &TOKEN);
-#line 3799 "parse.c"
+#line 3816 "parse.c"
   sqlite4ParserARG_STORE; /* Suppress warning about unused %extra_argument variable */
 }
 
@@ -2,156 +2,157 @@
 #define TK_EXPLAIN                         2
 #define TK_QUERY                           3
 #define TK_PLAN                            4
-#define TK_BEGIN                           5
-#define TK_TRANSACTION                     6
-#define TK_DEFERRED                        7
-#define TK_IMMEDIATE                       8
-#define TK_EXCLUSIVE                       9
-#define TK_COMMIT                         10
-#define TK_END                            11
-#define TK_ROLLBACK                       12
-#define TK_SAVEPOINT                      13
-#define TK_RELEASE                        14
-#define TK_TO                             15
-#define TK_TABLE                          16
-#define TK_CREATE                         17
-#define TK_IF                             18
-#define TK_NOT                            19
-#define TK_EXISTS                         20
-#define TK_TEMP                           21
-#define TK_LP                             22
-#define TK_RP                             23
-#define TK_AS                             24
-#define TK_COMMA                          25
-#define TK_ID                             26
-#define TK_INDEXED                        27
-#define TK_ABORT                          28
-#define TK_ACTION                         29
-#define TK_AFTER                          30
-#define TK_ANALYZE                        31
-#define TK_ASC                            32
-#define TK_ATTACH                         33
-#define TK_BEFORE                         34
-#define TK_BY                             35
-#define TK_CASCADE                        36
-#define TK_CAST                           37
-#define TK_COLUMNKW                       38
-#define TK_CONFLICT                       39
-#define TK_DATABASE                       40
-#define TK_DESC                           41
-#define TK_DETACH                         42
-#define TK_EACH                           43
-#define TK_FAIL                           44
-#define TK_FOR                            45
-#define TK_IGNORE                         46
-#define TK_INITIALLY                      47
-#define TK_INSTEAD                        48
-#define TK_LIKE_KW                        49
-#define TK_MATCH                          50
-#define TK_NO                             51
-#define TK_KEY                            52
-#define TK_OF                             53
-#define TK_OFFSET                         54
-#define TK_PRAGMA                         55
-#define TK_RAISE                          56
-#define TK_REPLACE                        57
-#define TK_RESTRICT                       58
-#define TK_ROW                            59
-#define TK_TRIGGER                        60
-#define TK_VIEW                           61
-#define TK_VIRTUAL                        62
-#define TK_REINDEX                        63
-#define TK_RENAME                         64
-#define TK_CTIME_KW                       65
-#define TK_ANY                            66
-#define TK_OR                             67
-#define TK_AND                            68
-#define TK_IS                             69
-#define TK_BETWEEN                        70
-#define TK_IN                             71
-#define TK_ISNULL                         72
-#define TK_NOTNULL                        73
-#define TK_NE                             74
-#define TK_EQ                             75
-#define TK_GT                             76
-#define TK_LE                             77
-#define TK_LT                             78
-#define TK_GE                             79
-#define TK_ESCAPE                         80
-#define TK_BITAND                         81
-#define TK_BITOR                          82
-#define TK_LSHIFT                         83
-#define TK_RSHIFT                         84
-#define TK_PLUS                           85
-#define TK_MINUS                          86
-#define TK_STAR                           87
-#define TK_SLASH                          88
-#define TK_REM                            89
-#define TK_CONCAT                         90
-#define TK_COLLATE                        91
-#define TK_BITNOT                         92
-#define TK_STRING                         93
-#define TK_JOIN_KW                        94
-#define TK_CONSTRAINT                     95
-#define TK_DEFAULT                        96
-#define TK_NULL                           97
-#define TK_PRIMARY                        98
-#define TK_UNIQUE                         99
-#define TK_CHECK                          100
-#define TK_REFERENCES                     101
-#define TK_AUTOINCR                       102
-#define TK_ON                             103
-#define TK_INSERT                         104
-#define TK_DELETE                         105
-#define TK_UPDATE                         106
-#define TK_SET                            107
-#define TK_DEFERRABLE                     108
-#define TK_FOREIGN                        109
-#define TK_DROP                           110
-#define TK_UNION                          111
-#define TK_ALL                            112
-#define TK_EXCEPT                         113
-#define TK_INTERSECT                      114
-#define TK_SELECT                         115
-#define TK_DISTINCT                       116
-#define TK_DOT                            117
-#define TK_FROM                           118
-#define TK_JOIN                           119
-#define TK_USING                          120
-#define TK_ORDER                          121
-#define TK_GROUP                          122
-#define TK_HAVING                         123
-#define TK_LIMIT                          124
-#define TK_WHERE                          125
-#define TK_INTO                           126
-#define TK_VALUES                         127
-#define TK_INTEGER                        128
-#define TK_FLOAT                          129
-#define TK_BLOB                           130
-#define TK_REGISTER                       131
-#define TK_VARIABLE                       132
-#define TK_CASE                           133
-#define TK_WHEN                           134
-#define TK_THEN                           135
-#define TK_ELSE                           136
-#define TK_INDEX                          137
-#define TK_COVERING                       138
-#define TK_ALTER                          139
-#define TK_ADD                            140
-#define TK_TO_TEXT                        141
-#define TK_TO_BLOB                        142
-#define TK_TO_NUMERIC                     143
-#define TK_TO_INT                         144
-#define TK_TO_REAL                        145
-#define TK_ISNOT                          146
-#define TK_END_OF_FILE                    147
-#define TK_ILLEGAL                        148
-#define TK_SPACE                          149
-#define TK_UNCLOSED_STRING                150
-#define TK_FUNCTION                       151
-#define TK_COLUMN                         152
-#define TK_AGG_FUNCTION                   153
-#define TK_AGG_COLUMN                     154
-#define TK_CONST_FUNC                     155
-#define TK_UMINUS                         156
-#define TK_UPLUS                          157
+#define TK_PROFILE                         5
+#define TK_ANALYZE                         6
+#define TK_BEGIN                           7
+#define TK_TRANSACTION                     8
+#define TK_DEFERRED                        9
+#define TK_IMMEDIATE                      10
+#define TK_EXCLUSIVE                      11
+#define TK_COMMIT                         12
+#define TK_END                            13
+#define TK_ROLLBACK                       14
+#define TK_SAVEPOINT                      15
+#define TK_RELEASE                        16
+#define TK_TO                             17
+#define TK_TABLE                          18
+#define TK_CREATE                         19
+#define TK_IF                             20
+#define TK_NOT                            21
+#define TK_EXISTS                         22
+#define TK_TEMP                           23
+#define TK_LP                             24
+#define TK_RP                             25
+#define TK_AS                             26
+#define TK_COMMA                          27
+#define TK_ID                             28
+#define TK_INDEXED                        29
+#define TK_ABORT                          30
+#define TK_ACTION                         31
+#define TK_AFTER                          32
+#define TK_ASC                            33
+#define TK_ATTACH                         34
+#define TK_BEFORE                         35
+#define TK_BY                             36
+#define TK_CASCADE                        37
+#define TK_CAST                           38
+#define TK_COLUMNKW                       39
+#define TK_CONFLICT                       40
+#define TK_DATABASE                       41
+#define TK_DESC                           42
+#define TK_DETACH                         43
+#define TK_EACH                           44
+#define TK_FAIL                           45
+#define TK_FOR                            46
+#define TK_IGNORE                         47
+#define TK_INITIALLY                      48
+#define TK_INSTEAD                        49
+#define TK_LIKE_KW                        50
+#define TK_MATCH                          51
+#define TK_NO                             52
+#define TK_KEY                            53
+#define TK_OF                             54
+#define TK_OFFSET                         55
+#define TK_PRAGMA                         56
+#define TK_RAISE                          57
+#define TK_REPLACE                        58
+#define TK_RESTRICT                       59
+#define TK_ROW                            60
+#define TK_TRIGGER                        61
+#define TK_VIEW                           62
+#define TK_VIRTUAL                        63
+#define TK_REINDEX                        64
+#define TK_RENAME                         65
+#define TK_CTIME_KW                       66
+#define TK_ANY                            67
+#define TK_OR                             68
+#define TK_AND                            69
+#define TK_IS                             70
+#define TK_BETWEEN                        71
+#define TK_IN                             72
+#define TK_ISNULL                         73
+#define TK_NOTNULL                        74
+#define TK_NE                             75
+#define TK_EQ                             76
+#define TK_GT                             77
+#define TK_LE                             78
+#define TK_LT                             79
+#define TK_GE                             80
+#define TK_ESCAPE                         81
+#define TK_BITAND                         82
+#define TK_BITOR                          83
+#define TK_LSHIFT                         84
+#define TK_RSHIFT                         85
+#define TK_PLUS                           86
+#define TK_MINUS                          87
+#define TK_STAR                           88
+#define TK_SLASH                          89
+#define TK_REM                            90
+#define TK_CONCAT                         91
+#define TK_COLLATE                        92
+#define TK_BITNOT                         93
+#define TK_STRING                         94
+#define TK_JOIN_KW                        95
+#define TK_CONSTRAINT                     96
+#define TK_DEFAULT                        97
+#define TK_NULL                           98
+#define TK_PRIMARY                        99
+#define TK_UNIQUE                         100
+#define TK_CHECK                          101
+#define TK_REFERENCES                     102
+#define TK_AUTOINCR                       103
+#define TK_ON                             104
+#define TK_INSERT                         105
+#define TK_DELETE                         106
+#define TK_UPDATE                         107
+#define TK_SET                            108
+#define TK_DEFERRABLE                     109
+#define TK_FOREIGN                        110
+#define TK_DROP                           111
+#define TK_UNION                          112
+#define TK_ALL                            113
+#define TK_EXCEPT                         114
+#define TK_INTERSECT                      115
+#define TK_SELECT                         116
+#define TK_DISTINCT                       117
+#define TK_DOT                            118
+#define TK_FROM                           119
+#define TK_JOIN                           120
+#define TK_USING                          121
+#define TK_ORDER                          122
+#define TK_GROUP                          123
+#define TK_HAVING                         124
+#define TK_LIMIT                          125
+#define TK_WHERE                          126
+#define TK_INTO                           127
+#define TK_VALUES                         128
+#define TK_INTEGER                        129
+#define TK_FLOAT                          130
+#define TK_BLOB                           131
+#define TK_REGISTER                       132
+#define TK_VARIABLE                       133
+#define TK_CASE                           134
+#define TK_WHEN                           135
+#define TK_THEN                           136
+#define TK_ELSE                           137
+#define TK_INDEX                          138
+#define TK_COVERING                       139
+#define TK_ALTER                          140
+#define TK_ADD                            141
+#define TK_TO_TEXT                        142
+#define TK_TO_BLOB                        143
+#define TK_TO_NUMERIC                     144
+#define TK_TO_INT                         145
+#define TK_TO_REAL                        146
+#define TK_ISNOT                          147
+#define TK_END_OF_FILE                    148
+#define TK_ILLEGAL                        149
+#define TK_SPACE                          150
+#define TK_UNCLOSED_STRING                151
+#define TK_FUNCTION                       152
+#define TK_COLUMN                         153
+#define TK_AGG_FUNCTION                   154
+#define TK_AGG_COLUMN                     155
+#define TK_CONST_FUNC                     156
+#define TK_UMINUS                         157
+#define TK_UPLUS                          158
@@ -115,7 +115,8 @@ typedef enum {
   SQLITE4_MM_LINEAR = 6,     /* Allocate from a fixed buffer w/o free */
   SQLITE4_MM_BESPOKE = 7,    /* Caller-defined implementation */
   SQLITE4_MM_DEBUG,          /* Debugging memory allocator */
-  SQLITE4_MM_STATS           /* Keep memory statistics */
+  SQLITE4_MM_STATS,          /* Keep memory statistics */
+  SQLITE4_MM_THREADCACHE     /* Per-thread size-class caches over A */
 } sqlite4_mm_type;
 
 /*
@@ -327,6 +328,8 @@ SQLITE4_API int sqlite4_env_config(sqlite4_env*, int op, ...);
 #define SQLITE4_ENVCONFIG_KVSTORE_PUSH 12   /* name, factory */
 #define SQLITE4_ENVCONFIG_KVSTORE_POP  13   /* name */
 #define SQLITE4_ENVCONFIG_KVSTORE_GET  14   /* name, *factory */
+#define SQLITE4_ENVCONFIG_MUTEXPROF    15   /* boolean */
+#define SQLITE4_ENVCONFIG_ASYNCTHREADS 16   /* int */
 
 /*
 ** CAPIREF: Compile-Time Library Version Numbers
@@ -636,6 +639,7 @@ SQLITE4_API int sqlite4_exec(
 #define SQLITE4_ROW         100  /* sqlite4_step() has another row ready */
 #define SQLITE4_DONE        101  /* sqlite4_step() has finished executing */
 #define SQLITE4_INEXACT     102  /* xSeek method of storage finds nearby ans */
+#define SQLITE4_BATCHFULL   103  /* Next row does not fit sqlite4_step_batch()*/
 
 /*
 ** CAPIREF: Extended Result Codes
@@ -855,11 +859,53 @@ SQLITE4_API sqlite4_env *sqlite4_db_env(sqlite4*);
 ** following this call.  The second parameter may be a NULL pointer, in
 ** which case the trigger setting is not reported back. </dd>
 **
+** <dt>SQLITE4_DBCONFIG_LOCK_RETRY</dt>
+** <dd> ^When the storage engine fails a statement with [SQLITE4_LOCKED]
+** to break a deadlock, the statement is rolled back and run again, up to
+** a limit, before the error is returned to the application. ^This is only
+** done if the statement has not yet returned a row and ran alone in an
+** automatic transaction of its own. ^Within an explicit transaction the
+** error is always returned, as the storage engine may have rolled back
+** the whole transaction. ^This option sets the maximum
+** number of retries of a single [sqlite4_step()] call. There should be two
+** additional arguments. The first is the new limit, 0 to disable retries
+** or negative to leave the limit unchanged. The second is a pointer to an
+** integer into which the limit in effect following this call is written,
+** or a NULL pointer. </dd>
+**
+** <dt>SQLITE4_DBCONFIG_LOCK_BACKOFF</dt>
+** <dd> ^This option sets the delay, in microseconds, before the first retry
+** made as described for SQLITE4_DBCONFIG_LOCK_RETRY. ^The delay doubles
+** with each further retry, and a random part of up to half of it is
+** dropped each time, so that the connections involved in a deadlock do not
+** retry in step. The two additional arguments are as for
+** SQLITE4_DBCONFIG_LOCK_RETRY. </dd>
+**
+** <dt>SQLITE4_DBCONFIG_SEEK_BATCH</dt>
+** <dd> ^When this option is greater than zero, a read-only statement that
+** joins a table to an enclosing loop by equality constraints on plain
+** columns of the enclosing table looks ahead over the next N rows of the
+** enclosing loop, sorts the keys it will search for and reads them from
+** the storage engine in key order, N being the value of this option.
+** ^The rows are still returned in the same order. ^The option applies to
+** statements prepared after it is set. The two additional arguments are
+** as for SQLITE4_DBCONFIG_LOCK_RETRY. ^The default is 0, which disables
+** seek batching.
+**
+** Seek batching pays off when the storage engine reads the inner table
+** from disk, as reading keys in order turns random page reads into
+** sequential ones. On the in-memory storage engine, whose tree stays in
+** the CPU cache, it makes such joins 15-25% slower, which is why it is
+** disabled by default. </dd>
+**
 ** </dl>
 */
 #define SQLITE4_DBCONFIG_LOOKASIDE       1001  /* void* int int */
 #define SQLITE4_DBCONFIG_ENABLE_FKEY     1002  /* int int* */
 #define SQLITE4_DBCONFIG_ENABLE_TRIGGER  1003  /* int int* */
+#define SQLITE4_DBCONFIG_LOCK_RETRY      1004  /* int int* */
+#define SQLITE4_DBCONFIG_LOCK_BACKOFF    1005  /* int int* */
+#define SQLITE4_DBCONFIG_SEEK_BATCH      1006  /* int int* */
 
 
 /*
@@ -1575,6 +1621,15 @@ SQLITE4_API int sqlite4_limit(sqlite4*, int id, int newVal);
 **
 ** [[SQLITE4_LIMIT_TRIGGER_DEPTH]] ^(<dt>SQLITE4_LIMIT_TRIGGER_DEPTH</dt>
 ** <dd>The maximum depth of recursion for triggers.</dd>)^
+**
+** [[SQLITE4_LIMIT_WORKER_THREADS]] ^(<dt>SQLITE4_LIMIT_WORKER_THREADS</dt>
+** <dd>The maximum number of auxiliary worker threads that a single
+** [prepared statement] may start.</dd>)^
+**
+** [[SQLITE4_LIMIT_SORTER_SIZE]] ^(<dt>SQLITE4_LIMIT_SORTER_SIZE</dt>
+** <dd>The maximum number of bytes of index entries that an index build or
+** a [sqlite4_bulkload_begin | bulk-load handle] buffers in memory before
+** sorting them and writing them to the database.</dd>)^
 ** </dl>
 */
 #define SQLITE4_LIMIT_LENGTH                    0
@@ -1588,6 +1643,8 @@ SQLITE4_API int sqlite4_limit(sqlite4*, int id, int newVal);
 #define SQLITE4_LIMIT_LIKE_PATTERN_LENGTH       8
 #define SQLITE4_LIMIT_VARIABLE_NUMBER           9
 #define SQLITE4_LIMIT_TRIGGER_DEPTH            10
+#define SQLITE4_LIMIT_WORKER_THREADS           11
+#define SQLITE4_LIMIT_SORTER_SIZE              12
 
 /*
 ** CAPIREF: Compiling An SQL Statement
@@ -2242,6 +2299,80 @@ SQLITE4_API const void *sqlite4_column_text16(sqlite4_stmt*, int iCol, int *pnBy
 SQLITE4_API int sqlite4_column_type(sqlite4_stmt*, int iCol);
 SQLITE4_API sqlite4_value *sqlite4_column_value(sqlite4_stmt*, int iCol);
 
+/*
+** CAPIREF: Evaluate An SQL Statement Into Columnar Buffers
+**
+** ^The sqlite4_step_batch(S, N, C, A, P) interface steps [prepared statement]
+** S until up to N rows of results have been produced. The values of the
+** first C result columns of each row are written to the buffers described
+** by the C elements of array A. ^The number of rows written is stored in *P.
+** This is faster than calling [sqlite4_step()] followed by one
+** [column access functions | sqlite4_column_*()] call per value, because
+** the database connection mutex is only entered once per batch.
+**
+** ^Each element of A describes where the values of one result column are
+** stored. Member eType selects the representation:
+**
+** <ul>
+** <li> [SQLITE4_INTEGER]: values are converted as by
+**      [sqlite4_column_int64()] and stored in aInt[]. aInt[] must have
+**      room for N values.
+** <li> [SQLITE4_FLOAT]: values are converted as by [sqlite4_column_double()]
+**      and stored in aReal[]. aReal[] must have room for N values.
+** <li> [SQLITE4_TEXT] or [SQLITE4_BLOB]: values are converted as by
+**      [sqlite4_column_text()] or [sqlite4_column_blob()] and packed into
+**      the nData byte buffer aData[]. aOffset[] must have room for N+1
+**      values. The value for the i-th row of the batch occupies bytes
+**      aOffset[i] through aOffset[i+1]-1 of aData[]. Text values are not
+**      nul-terminated.
+** <li> 0: each value is stored according to its own datatype, as by
+**      one of the above. aInt[], aReal[], aOffset[] and aData[] must all
+**      be supplied, and aType[] must not be NULL.
+** <li> [SQLITE4_NULL]: the column is ignored.
+** </ul>
+**
+** ^If aNull[] is not NULL, aNull[i] is set to 1 if the i-th value of the
+** batch is an SQL NULL, or to 0 otherwise. ^If aType[] is not NULL,
+** aType[i] is set to the [SQLITE4_INTEGER | datatype code] of the i-th
+** value before it was converted. ^NULL values are stored as 0, 0.0 or a
+** zero length string or blob.
+**
+** ^If the values of a row do not fit into the space remaining in one or
+** more aData[] buffers, the batch ends before that row. The row is retained
+** and becomes the first row of the next batch. ^If it does not fit even
+** into empty buffers, no rows are returned and sqlite4_step_batch()
+** returns [SQLITE4_BATCHFULL]. The caller may then supply larger buffers
+** and try again. ^SQLITE4_BATCHFULL is not an error and leaves the
+** statement as it was. Any [SQLITE4_TOOBIG] returned by
+** sqlite4_step_batch() is a real error raised by the statement.
+**
+** ^sqlite4_step_batch() returns [SQLITE4_ROW] if the batch ended before
+** the statement finished, or [SQLITE4_DONE] if it finished. In the latter
+** case fewer than N rows, possibly none, may have been returned. ^Any other
+** return value is an error code, as for [sqlite4_step()]. Rows returned
+** before the error are still written to the buffers and counted in *P.
+** ^[SQLITE4_MISUSE] is returned if C is greater than the number of columns
+** in the result set of S.
+*/
+typedef struct sqlite4_batch_column sqlite4_batch_column;
+struct sqlite4_batch_column {
+  int eType;                /* SQLITE4_INTEGER, _FLOAT, _TEXT, _BLOB, _NULL */
+  unsigned char *aNull;     /* If not NULL, set to 1 for each NULL value */
+  unsigned char *aType;     /* If not NULL, datatype code of each value */
+  sqlite4_int64 *aInt;      /* Integer values */
+  double *aReal;            /* Floating point values */
+  int *aOffset;             /* Offsets of text and blob values in aData[] */
+  char *aData;              /* Buffer for text and blob values */
+  int nData;                /* Size of aData[] in bytes */
+};
+SQLITE4_API int sqlite4_step_batch(
+  sqlite4_stmt *pStmt,      /* Statement to evaluate */
+  int nRow,                 /* Maximum number of rows to return */
+  int nCol,                 /* Number of entries in aCol[] */
+  sqlite4_batch_column *aCol,
+  int *pnRow                /* OUT: Number of rows returned */
+);
+
 /*
 ** CAPIREF: Destroy A Prepared Statement Object
 **
@@ -3582,12 +3713,315 @@ SQLITE4_API int sqlite4_kvstore_control(sqlite4*, const char *zDbName, int op, v
 ** or FULL, respectively. Regardless of its initial value, N is set to 
 ** the current (possibly updated) synchronous level before returning (
 ** 0, 1 or 2).
+**
+** <dt>SQLITE4_KVCTRL_LSM_FLUSH</dt><dd>
+** This op is used with log-structured backends. It writes the content of
+** the in-memory tree to a sorted run on disk and returns once the run is
+** written. The fourth parameter is not used.
+**
+** <dt>SQLITE4_KVCTRL_LSM_MERGE</dt><dd>
+** This op merges every sorted run of a log-structured backend into one,
+** removing deleted entries, so that a read visits a single run. The
+** fourth parameter is not used.
+**
+** <dt>SQLITE4_KVCTRL_LSM_CHECKPOINT</dt><dd>
+** This op makes every transaction committed so far durable, and records
+** the current state of the database so that recovery replays as little
+** of the log as possible. The fourth parameter is not used.
+**
+** <dt>SQLITE4_KVCTRL_SNAPSHOT</dt><dd>
+** This op is supported by the in-memory backend when the database was
+** opened with the "durable=1" URI parameter. It writes a snapshot of the 
+** entire database to disk and empties the write-ahead log, so that the 
+** next open loads the snapshot instead of replaying the log. The fourth 
+** parameter is not used. SQLITE4_BUSY is returned if a write transaction 
+** is open.
+**
+** <dt>SQLITE4_KVCTRL_DATA_VERSION</dt><dd>
+** The fourth parameter should be of type (sqlite4_uint64 *). The backend
+** writes a value to it that changes whenever another connection commits
+** a change to the database, and not when this connection does. A database
+** opened with the "rowcache" URI parameter uses this op to decide whether
+** the rows it has cached are still current.
+**
+** <dt>SQLITE4_KVCTRL_MAP_WRITE</dt><dd>
+** The fourth parameter should be of type (const char *), the name of a
+** file. The entire content of the database is written to that file in
+** the format read by the "map" backend, replacing any existing file of
+** that name. The file may then be opened read-only with the "kv=map" URI
+** parameter, which maps it into memory instead of loading it. This op is
+** supported by every backend.
 */
 #define SQLITE4_KVCTRL_LSM_HANDLE       1
 #define SQLITE4_KVCTRL_SYNCHRONOUS      2
 #define SQLITE4_KVCTRL_LSM_FLUSH        3
 #define SQLITE4_KVCTRL_LSM_MERGE        4
 #define SQLITE4_KVCTRL_LSM_CHECKPOINT   5
+#define SQLITE4_KVCTRL_SNAPSHOT         6
+#define SQLITE4_KVCTRL_DATA_VERSION     7
+#define SQLITE4_KVCTRL_MAP_WRITE        8
+
+/*
+** CAPIREF: Bulk-Load Handle
+**
+** An instance of this object loads rows into a single table without
+** running an INSERT statement. It is created by [sqlite4_bulkload_begin()]
+** and destroyed by [sqlite4_bulkload_finish()] or [sqlite4_bulkload_abort()].
+*/
+typedef struct sqlite4_bulkload sqlite4_bulkload;
+
+/*
+** CAPIREF: Load Rows Into A Table
+**
+** ^The sqlite4_bulkload_begin(D, S, T, P) interface opens a handle that
+** loads rows into table T of database S of connection D, and stores it
+** in *P. ^If S is NULL, all attached databases are searched for T, as for
+** an unqualified table name in SQL. ^If an error occurs, *P is set to NULL
+** and an error code returned.
+**
+** ^The values of each row are set using the sqlite4_bulkload_bind_*()
+** routines, which work like the corresponding [sqlite4_bind_blob |
+** sqlite4_bind_*()] routines except that the second argument is the
+** 1-based index of a table column. ^Columns that are not set take their
+** DEFAULT value. ^The row is then added by sqlite4_bulkload_append(),
+** after which all columns revert to their default values.
+**
+** ^Appended rows are encoded and buffered in memory. ^Buffered rows are
+** written to the database when sqlite4_bulkload_finish() is called, or by
+** sqlite4_bulkload_append() once the buffered index entries exceed
+** [SQLITE4_LIMIT_SORTER_SIZE] bytes. ^Writing the buffered rows sorts the
+** entries of each index into key order and writes them to the database
+** within a single statement transaction, which is committed if no explicit
+** transaction is open. ^This is faster than INSERT for large numbers of
+** rows, especially when the table is initially empty. ^To make a load
+** larger than SQLITE4_LIMIT_SORTER_SIZE atomic, run it within an explicit
+** transaction. ^sqlite4_bulkload_abort() discards the rows buffered since
+** they were last written. ^Both sqlite4_bulkload_finish() and
+** sqlite4_bulkload_abort() destroy the handle.
+**
+** ^Column affinities are applied and NOT NULL, UNIQUE and PRIMARY KEY
+** constraints are enforced, but ON CONFLICT clauses are ignored: any
+** constraint violation causes [SQLITE4_CONSTRAINT] to be returned.
+** ^NOT NULL violations are reported by sqlite4_bulkload_append(), and the
+** offending row is discarded. ^UNIQUE and PRIMARY KEY violations are
+** reported when the buffered rows are written, in which case none of the
+** rows buffered since they were last written are written.
+** ^Rowids for INTEGER PRIMARY KEY columns set to NULL and for tables
+** without a PRIMARY KEY are allocated when each row is appended, based
+** on the largest rowid in the table when the handle was opened.
+**
+** ^Tables with triggers, CHECK constraints, enabled foreign key
+** constraints, AUTOINCREMENT columns, fts5 indexes or non-constant
+** DEFAULT values cannot be loaded, nor can views, virtual tables or
+** system tables. ^If the schema is changed while a handle is open,
+** subsequent calls return [SQLITE4_SCHEMA].
+*/
+SQLITE4_API int sqlite4_bulkload_begin(
+  sqlite4 *db,              /* Database handle */
+  const char *zDb,          /* Database name, or NULL */
+  const char *zTab,         /* Name of table to load */
+  sqlite4_bulkload **pp     /* OUT: New bulk-load handle */
+);
+SQLITE4_API int sqlite4_bulkload_bind_blob(sqlite4_bulkload*, int, const void*, int n,
+                               void(*)(void*,void*),void*);
+SQLITE4_API int sqlite4_bulkload_bind_double(sqlite4_bulkload*, int, double);
+SQLITE4_API int sqlite4_bulkload_bind_int(sqlite4_bulkload*, int, int);
+SQLITE4_API int sqlite4_bulkload_bind_int64(sqlite4_bulkload*, int, sqlite4_int64);
+SQLITE4_API int sqlite4_bulkload_bind_null(sqlite4_bulkload*, int);
+SQLITE4_API int sqlite4_bulkload_bind_text(sqlite4_bulkload*, int, const char*, int n,
+                               void(*)(void*,void*),void*);
+SQLITE4_API int sqlite4_bulkload_append(sqlite4_bulkload*);
+SQLITE4_API int sqlite4_bulkload_finish(sqlite4_bulkload*);
+SQLITE4_API int sqlite4_bulkload_abort(sqlite4_bulkload*);
+
+/*
+** CAPIREF: Connection Pool Handle
+**
+** An instance of this object keeps a set of open database connections
+** to a single URI ready for use. It is created by [sqlite4_pool_open()]
+** and destroyed by [sqlite4_pool_close()].
+*/
+typedef struct sqlite4_pool sqlite4_pool;
+
+/*
+** CAPIREF: Connection Pools
+**
+** ^The sqlite4_pool_open(E, U, N, P) interface creates a pool of
+** connections to the database identified by URI U in environment E and
+** stores it in *P. ^N connections are opened immediately, and the pool
+** keeps up to N idle connections thereafter. ^Each connection has
+** already resolved its storage engine, opened its key-value store and
+** loaded the database schema, so that none of this is repeated when the
+** connection is used. ^If an error occurs, *P is set to NULL and an
+** error code returned.
+**
+** ^sqlite4_pool_prepare(P, Z, I) adds SQL statement Z to the set of
+** statements prepared on every connection of pool P, and stores its
+** index in *I. ^Idle connections prepare the statement at once, and
+** connections that are checked out prepare it when it is first
+** requested. ^The prepared statement of a connection D is obtained by
+** calling sqlite4_pool_stmt(D, I), which returns NULL if D does not
+** belong to a pool, I is out of range or the statement cannot be
+** prepared. ^Pool statements must not be finalized by the application.
+**
+** ^sqlite4_pool_checkout(P, D) stores an idle connection from P in *D.
+** ^If no connection is idle, a new one is opened. ^The connection must
+** be returned using sqlite4_pool_checkin(P, D) and must not be closed
+** by the application. ^Checkin resets the pool statements of D and
+** clears their bindings, finalizes any other statement prepared on D and
+** rolls back any open transaction. ^The connection is then kept for
+** reuse, or closed if the pool already has N idle connections or the
+** rollback failed. ^If closing the connection fails, sqlite4_pool_checkin()
+** returns the error code. ^Both
+** operations take constant time unless a connection has to be opened
+** or closed. ^A pool may be used by multiple threads at once, but each
+** checked out connection should be used by one thread at a time.
+**
+** ^sqlite4_pool_close(P) closes all connections of P and destroys it.
+** ^If any connection is checked out, [SQLITE4_BUSY] is returned and the
+** pool is not destroyed.
+*/
+SQLITE4_API int sqlite4_pool_open(
+  sqlite4_env *pEnv,        /* Run-time environment, or NULL */
+  const char *zUri,         /* URI of database to open */
+  int nConn,                /* Number of connections to keep ready */
+  sqlite4_pool **ppPool     /* OUT: New connection pool */
+);
+SQLITE4_API int sqlite4_pool_prepare(sqlite4_pool*, const char *zSql, int *piStmt);
+SQLITE4_API int sqlite4_pool_checkout(sqlite4_pool*, sqlite4 **pDb);
+SQLITE4_API int sqlite4_pool_checkin(sqlite4_pool*, sqlite4 *db);
+SQLITE4_API sqlite4_stmt *sqlite4_pool_stmt(sqlite4 *db, int iStmt);
+SQLITE4_API int sqlite4_pool_close(sqlite4_pool*);
+
+/*
+** CAPIREF: Connection Pool Status
+**
+** ^sqlite4_pool_status(P, OP, C, H, R) retrieves statistics about
+** connection pool P. ^The current value of the statistic selected by OP
+** is written into *C and its highest value into *H. ^If R is true, the
+** highest value is reset to the current value, and counters are reset
+** to zero. ^SQLITE4_ERROR is returned if OP is not one of the
+** [SQLITE4_POOLSTATUS_IDLE | pool status verbs].
+*/
+SQLITE4_API int sqlite4_pool_status(sqlite4_pool*, int op, int *pCur, int *pHiwtr,
+                        int resetFlg);
+
+/*
+** CAPIREF: Status Parameters for connection pools
+** KEYWORDS: {pool status verbs}
+**
+** These constants are the available integer verbs for
+** [sqlite4_pool_status()].
+**
+** <dl>
+** <dt>SQLITE4_POOLSTATUS_IDLE</dt>
+** <dd>The number of idle connections.</dd>
+**
+** <dt>SQLITE4_POOLSTATUS_INUSE</dt>
+** <dd>The number of checked out connections.</dd>
+**
+** <dt>SQLITE4_POOLSTATUS_CHECKOUT</dt>
+** <dd>The number of checkouts. ^The highest value is not used.</dd>
+**
+** <dt>SQLITE4_POOLSTATUS_MISS</dt>
+** <dd>The number of checkouts that found no idle connection and so had
+** to open a new one. ^The highest value is not used.</dd>
+**
+** <dt>SQLITE4_POOLSTATUS_RESET</dt>
+** <dd>The number of checkins that had to reset a running statement or
+** roll back a transaction. ^The highest value is not used.</dd>
+** </dl>
+*/
+#define SQLITE4_POOLSTATUS_IDLE         0
+#define SQLITE4_POOLSTATUS_INUSE        1
+#define SQLITE4_POOLSTATUS_CHECKOUT     2
+#define SQLITE4_POOLSTATUS_MISS         3
+#define SQLITE4_POOLSTATUS_RESET        4
+
+/*
+** CAPIREF: Asynchronous Statement Execution
+**
+** These interfaces run prepared statements on a pool of worker threads
+** owned by the [sqlite4_env] object, so that an application can overlap
+** database work with other activity.
+**
+** ^The sqlite4_async_submit(S, N, C, A, X, P, Q, J) interface submits
+** statement S, with whatever values are currently bound to its
+** parameters, for execution and stores a handle for the new job in *J.
+** ^A worker thread fills the C batch buffers in A with up to N rows at
+** a time, as if by [sqlite4_step_batch(S, N, C, A, ...)], and delivers
+** each batch in one of two ways:
+**
+** <ul>
+** <li> ^If X is not NULL, X(P, J, R, RC) is invoked on the worker
+**      thread, where R is the number of rows in the batch and RC is the
+**      value returned by sqlite4_step_batch(). ^If RC is [SQLITE4_ROW]
+**      and X returns zero, the job continues with the next batch once X
+**      returns. Otherwise the job stops. Q must be NULL.
+** <li> ^If X is NULL, the job is appended to completion queue Q and
+**      waits there. ^sqlite4_async_poll(Q, W) removes and returns the
+**      next job from Q that has a batch ready, or returns NULL if there
+**      is none. ^If W is true and jobs submitted to Q are still running,
+**      it waits for one to deliver a batch. ^sqlite4_async_result(J, R, P)
+**      sets *R to the number of rows in the batch and *P to the P value
+**      passed to sqlite4_async_submit(), and returns the RC value of the
+**      batch. ^sqlite4_async_next(J) lets a job returned by
+**      sqlite4_async_poll() continue with its next batch. ^It returns
+**      the RC value of the batch instead if the job has already stopped.
+** </ul>
+**
+** ^The contents of the batch buffers are valid until the callback
+** returns, or until sqlite4_async_next() or sqlite4_async_finish() is
+** called.
+**
+** ^sqlite4_async_finish(J) waits until job J is not running, frees
+** it and returns the RC value of its most recent batch. This is
+** [SQLITE4_DONE] if the statement ran to completion or [SQLITE4_ROW] if
+** the job was stopped early. ^If it is called while the callback of J
+** is running, including from within the callback, it returns
+** immediately and J is freed when the callback returns. Every job must
+** eventually be finished. ^The statement is not reset or finalized;
+** that is up to the application once the job has been finished.
+**
+** ^[sqlite4_interrupt(D)] stops all unfinished jobs of connection D.
+** ^Each one delivers a last batch with an RC value of
+** [SQLITE4_INTERRUPT], even if it had not yet started to run.
+** ^Stopping jobs does not take any mutex, so sqlite4_interrupt() may
+** still be called from a signal handler while jobs are running.
+**
+** The connection that owns S must not be used by other threads while
+** a batch is being computed, unless the environment is configured as
+** [SQLITE4_ENVCONFIG_SERIALIZED]. Concurrent jobs run in parallel only
+** if they belong to different connections.
+**
+** ^The number of worker threads is set by
+** [SQLITE4_ENVCONFIG_ASYNCTHREADS]. ^If it is zero, or threads are not
+** available, each batch is computed on the thread that calls
+** sqlite4_async_submit() or sqlite4_async_next().
+**
+** ^sqlite4_async_queue_open(E, Q) creates a completion queue for
+** environment E and stores it in *Q. ^sqlite4_async_queue_close(Q)
+** destroys it, or returns [SQLITE4_BUSY] if any job submitted to it has
+** not been finished.
+*/
+typedef struct sqlite4_async sqlite4_async;
+typedef struct sqlite4_async_queue sqlite4_async_queue;
+SQLITE4_API int sqlite4_async_queue_open(sqlite4_env*, sqlite4_async_queue**);
+SQLITE4_API int sqlite4_async_queue_close(sqlite4_async_queue*);
+SQLITE4_API int sqlite4_async_submit(
+  sqlite4_stmt *pStmt,      /* Statement to run */
+  int nRow,                 /* Maximum number of rows per batch */
+  int nCol,                 /* Number of entries in aCol[] */
+  sqlite4_batch_column *aCol,
+  int (*xBatch)(void*,sqlite4_async*,int,int),
+  void *pArg,               /* First argument to xBatch */
+  sqlite4_async_queue *pQueue,
+  sqlite4_async **ppJob     /* OUT: New job */
+);
+SQLITE4_API sqlite4_async *sqlite4_async_poll(sqlite4_async_queue*, int bWait);
+SQLITE4_API int sqlite4_async_result(sqlite4_async*, int *pnRow, void **ppArg);
+SQLITE4_API int sqlite4_async_next(sqlite4_async*);
+SQLITE4_API int sqlite4_async_finish(sqlite4_async*);
 
 /*
 ** CAPIREF: Testing Interface
@@ -3711,6 +4145,59 @@ SQLITE4_API int sqlite4_env_status(
 #define SQLITE4_ENVSTATUS_MALLOC_COUNT         2
 #define SQLITE4_ENVSTATUS_PARSER_STACK         3
 
+/*
+** CAPIREF: Mutex Contention Profile
+**
+** ^If an environment is configured using [SQLITE4_ENVCONFIG_MUTEXPROF]
+** before it is initialized, every dynamic mutex it allocates records
+** how often it is entered, how often an entering thread had to wait,
+** and histograms of wait times and hold times.  ^Mutexes are grouped
+** by allocation site: the mutex type ([SQLITE4_MUTEX_FAST] or
+** [SQLITE4_MUTEX_RECURSIVE]) together with a tag naming the object
+** the mutex protects, for example "db.mutex" or "env.pFactoryMutex".
+** ^The statistics of a site include those of mutexes that have since
+** been freed.
+**
+** ^sqlite4_env_mutex_status(E,I,P,R) writes the statistics of the I-th
+** allocation site of environment E into *P.  ^Sites are numbered
+** starting from zero.  ^If the R parameter is true, the counters and
+** histograms of the site are reset to zero.  ^SQLITE4_NOTFOUND is
+** returned if there is no I-th site and SQLITE4_MISUSE if profiling
+** is not enabled for E.
+**
+** ^Entry i of the aWait[] and aHold[] histograms counts intervals of
+** at least 4^(i-1) and less than 4^i microseconds.  Entry 0 counts
+** intervals of less than one microsecond, and the final entry has no
+** upper bound.  ^Only acquisitions that had to wait are added to
+** aWait[].  ^For recursive mutexes, the hold time runs from the
+** outermost enter to the matching leave.
+**
+** Like [sqlite4_env_status()], this routine is threadsafe but not
+** atomic.  Counters that are updated while the routine runs may be
+** slightly inconsistent with each other.
+*/
+#define SQLITE4_MUTEX_NHIST 12
+typedef struct sqlite4_mutex_status sqlite4_mutex_status;
+struct sqlite4_mutex_status {
+  const char *zTag;             /* Allocation site tag, or NULL */
+  int eType;                    /* SQLITE4_MUTEX_FAST or _RECURSIVE */
+  int nAlloc;                   /* Mutexes allocated at this site */
+  int nLive;                    /* Mutexes allocated and not yet freed */
+  sqlite4_uint64 nEnter;        /* Successful acquisitions */
+  sqlite4_uint64 nContended;    /* Acquisitions that had to wait */
+  sqlite4_uint64 nBusy;         /* sqlite4_mutex_try() calls that failed */
+  sqlite4_uint64 nWaitNs;       /* Total wait time in nanoseconds */
+  sqlite4_uint64 nHoldNs;       /* Total hold time in nanoseconds */
+  sqlite4_uint64 aWait[SQLITE4_MUTEX_NHIST];  /* Wait time histogram */
+  sqlite4_uint64 aHold[SQLITE4_MUTEX_NHIST];  /* Hold time histogram */
+};
+SQLITE4_API int sqlite4_env_mutex_status(
+  sqlite4_env *pEnv,
+  int iSite,
+  sqlite4_mutex_status *pStatus,
+  int resetFlag
+);
+
 /*
 ** CAPIREF: Database Connection Status
 **
@@ -3777,7 +4264,8 @@ SQLITE4_API int sqlite4_db_status(sqlite4*, int op, int *pCur, int *pHiwtr, int
 **
 ** [[SQLITE4_DBSTATUS_CACHE_USED]] ^(<dt>SQLITE4_DBSTATUS_CACHE_USED</dt>
 ** <dd>This parameter returns the approximate number of of bytes of heap
-** memory used by all pager caches associated with the database connection.)^
+** memory used by the hot-row caches of all databases associated with the
+** database connection.  See the "rowcache" URI parameter.)^
 ** ^The highwater mark associated with SQLITE4_DBSTATUS_CACHE_USED is always 0.
 **
 ** [[SQLITE4_DBSTATUS_SCHEMA_USED]] ^(<dt>SQLITE4_DBSTATUS_SCHEMA_USED</dt>
@@ -3797,15 +4285,32 @@ SQLITE4_API int sqlite4_db_status(sqlite4*, int op, int *pCur, int *pHiwtr, int
 ** </dd>
 **
 ** [[SQLITE4_DBSTATUS_CACHE_HIT]] ^(<dt>SQLITE4_DBSTATUS_CACHE_HIT</dt>
-** <dd>This parameter returns the number of pager cache hits that have
-** occurred.)^ ^The highwater mark associated with SQLITE4_DBSTATUS_CACHE_HIT 
-** is always 0.
+** <dd>This parameter returns the number of exact-match lookups that have
+** been answered from a hot-row cache.)^ ^The highwater mark associated with
+** SQLITE4_DBSTATUS_CACHE_HIT is always 0. ^If the resetFlg is true, the
+** current value is reset to zero.
 ** </dd>
 **
 ** [[SQLITE4_DBSTATUS_CACHE_MISS]] ^(<dt>SQLITE4_DBSTATUS_CACHE_MISS</dt>
-** <dd>This parameter returns the number of pager cache misses that have
-** occurred.)^ ^The highwater mark associated with SQLITE4_DBSTATUS_CACHE_MISS 
-** is always 0.
+** <dd>This parameter returns the number of exact-match lookups that a
+** hot-row cache has passed through to the storage engine.)^ ^The highwater
+** mark associated with SQLITE4_DBSTATUS_CACHE_MISS is always 0. ^If the
+** resetFlg is true, the current value is reset to zero.
+** </dd>
+**
+** [[SQLITE4_DBSTATUS_LOCK_RETRY]] ^(<dt>SQLITE4_DBSTATUS_LOCK_RETRY</dt>
+** <dd>This parameter returns the number of times a statement has been
+** rolled back and run again after failing with [SQLITE4_LOCKED].)^ ^The
+** highwater mark is the largest number of such retries made by a single
+** call to [sqlite4_step()]. ^If the resetFlg is true, both values are
+** reset to zero. See [SQLITE4_DBCONFIG_LOCK_RETRY].
+** </dd>
+**
+** [[SQLITE4_DBSTATUS_LOCK_BACKOFF]] ^(<dt>SQLITE4_DBSTATUS_LOCK_BACKOFF</dt>
+** <dd>This parameter returns the total number of milliseconds spent waiting
+** before the retries counted by SQLITE4_DBSTATUS_LOCK_RETRY.)^ ^The
+** highwater mark is always 0. ^If the resetFlg is true, the current value
+** is reset to zero.
 ** </dd>
 ** </dl>
 */
@@ -3818,7 +4323,9 @@ SQLITE4_API int sqlite4_db_status(sqlite4*, int op, int *pCur, int *pHiwtr, int
 #define SQLITE4_DBSTATUS_LOOKASIDE_MISS_FULL  6
 #define SQLITE4_DBSTATUS_CACHE_HIT            7
 #define SQLITE4_DBSTATUS_CACHE_MISS           8
-#define SQLITE4_DBSTATUS_MAX                  8   /* Largest defined DBSTATUS */
+#define SQLITE4_DBSTATUS_LOCK_RETRY           9
+#define SQLITE4_DBSTATUS_LOCK_BACKOFF        10
+#define SQLITE4_DBSTATUS_MAX                 10   /* Largest defined DBSTATUS */
 
 
 /*
@@ -3873,11 +4380,17 @@ SQLITE4_API int sqlite4_stmt_status(sqlite4_stmt*, int op,int resetFlg);
 ** A non-zero value in this counter may indicate an opportunity to
 ** improvement performance by adding permanent indices that do not
 ** need to be reinitialized each time the statement is run.</dd>
+**
+** [[SQLITE4_STMTSTATUS_LOCK_RETRY]] <dt>SQLITE4_STMTSTATUS_LOCK_RETRY</dt>
+** <dd>^This is the number of times the statement has been rolled back and
+** run again after failing with [SQLITE4_LOCKED]. See
+** [SQLITE4_DBCONFIG_LOCK_RETRY].</dd>
 ** </dl>
 */
 #define SQLITE4_STMTSTATUS_FULLSCAN_STEP     1
 #define SQLITE4_STMTSTATUS_SORT              2
 #define SQLITE4_STMTSTATUS_AUTOINDEX         3
+#define SQLITE4_STMTSTATUS_LOCK_RETRY        4
 
 
 /*
@@ -4084,7 +4597,10 @@ struct sqlite4_kv_methods {
       void (**pxFunc)(sqlite4_context *, int, sqlite4_value **),
       void (**pxDestroy)(void *)
   );
-  
+  /* Methods above are version 1.  Methods below are version 2 or later */
+  int (*xSeekBatch)(sqlite4_kvcursor*, int nProbe,
+         const unsigned char *const *apKey, const sqlite4_kvsize *anKey,
+         int (*xVisit)(void*, int iProbe, int rc), void *pCtx);
 };
 typedef struct sqlite4_kv_methods sqlite4_kv_methods;
 
@@ -0,0 +1,623 @@
+/*
+** 2026-10-18
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file contains the implementation of asynchronous statement
+** execution - the sqlite4_async_*() interfaces.
+**
+** Each environment owns a pool of worker threads and a run queue of
+** jobs. A job is a prepared statement together with a set of batch
+** buffers. Each time a worker takes a job from the run queue it calls
+** sqlite4_step_batch() once to fill the buffers and then hands the batch
+** to the application, either by invoking the job's callback on the
+** worker thread or by appending the job to a completion queue that the
+** application polls. In the first case the job goes back on the run
+** queue once the callback returns. In the second it waits until the
+** application calls sqlite4_async_next().
+**
+** Worker threads are started when the first job is submitted and stopped
+** by sqlite4_shutdown(). If the environment is configured with zero
+** worker threads, or threads are not available in this build, jobs run
+** on the thread that submits or resumes them.
+**
+** A job that is interrupted using sqlite4_interrupt() while waiting on
+** the run queue finishes with SQLITE4_INTERRUPT without running. The
+** interrupt flag of the connection cannot be used for this, as it is
+** cleared when a statement starts. Instead each job records the value of
+** sqlite4.iInterrupt, which sqlite4_interrupt() increments without taking
+** any lock, when it is submitted. A job is cancelled once the two differ.
+*/
+#include "sqliteInt.h"
+
+/*
+** The AsyncLock object is a mutex and two condition variables, one
+** signalled when a job is added to the run queue and one when a batch
+** is completed.
+*/
+#if SQLITE4_MAX_WORKER_THREADS>0 && SQLITE4_THREADSAFE>0 \
+ && defined(SQLITE4_MUTEX_PTHREADS)
+/******************************** Unix Pthreads *************************/
+#define SQLITE4_ASYNC_THREADS 1
+#include <pthread.h>
+
+typedef struct AsyncLock AsyncLock;
+struct AsyncLock {
+  pthread_mutex_t mutex;
+  pthread_cond_t condWork;
+  pthread_cond_t condDone;
+};
+static void asyncLockInit(AsyncLock *p){
+  pthread_mutex_init(&p->mutex, 0);
+  pthread_cond_init(&p->condWork, 0);
+  pthread_cond_init(&p->condDone, 0);
+}
+static void asyncLockDestroy(AsyncLock *p){
+  pthread_cond_destroy(&p->condDone);
+  pthread_cond_destroy(&p->condWork);
+  pthread_mutex_destroy(&p->mutex);
+}
+static void asyncEnter(AsyncLock *p){ pthread_mutex_lock(&p->mutex); }
+static void asyncLeave(AsyncLock *p){ pthread_mutex_unlock(&p->mutex); }
+static void asyncWaitWork(AsyncLock *p){
+  pthread_cond_wait(&p->condWork, &p->mutex);
+}
+static void asyncWaitDone(AsyncLock *p){
+  pthread_cond_wait(&p->condDone, &p->mutex);
+}
+static void asyncSignalWork(AsyncLock *p){ pthread_cond_signal(&p->condWork); }
+static void asyncBroadcastWork(AsyncLock *p){
+  pthread_cond_broadcast(&p->condWork);
+}
+static void asyncBroadcastDone(AsyncLock *p){
+  pthread_cond_broadcast(&p->condDone);
+}
+
+#elif SQLITE4_MAX_WORKER_THREADS>0 && SQLITE4_THREADSAFE>0 \
+ && defined(SQLITE4_MUTEX_W32)
+/********************************* Win32 Threads ****************************/
+#define SQLITE4_ASYNC_THREADS 1
+#include <windows.h>
+
+typedef struct AsyncLock AsyncLock;
+struct AsyncLock {
+  CRITICAL_SECTION mutex;
+  CONDITION_VARIABLE condWork;
+  CONDITION_VARIABLE condDone;
+};
+static void asyncLockInit(AsyncLock *p){
+  InitializeCriticalSection(&p->mutex);
+  InitializeConditionVariable(&p->condWork);
+  InitializeConditionVariable(&p->condDone);
+}
+static void asyncLockDestroy(AsyncLock *p){
+  DeleteCriticalSection(&p->mutex);
+}
+static void asyncEnter(AsyncLock *p){ EnterCriticalSection(&p->mutex); }
+static void asyncLeave(AsyncLock *p){ LeaveCriticalSection(&p->mutex); }
+static void asyncWaitWork(AsyncLock *p){
+  SleepConditionVariableCS(&p->condWork, &p->mutex, INFINITE);
+}
+static void asyncWaitDone(AsyncLock *p){
+  SleepConditionVariableCS(&p->condDone, &p->mutex, INFINITE);
+}
+static void asyncSignalWork(AsyncLock *p){
+  WakeConditionVariable(&p->condWork);
+}
+static void asyncBroadcastWork(AsyncLock *p){
+  WakeAllConditionVariable(&p->condWork);
+}
+static void asyncBroadcastDone(AsyncLock *p){
+  WakeAllConditionVariable(&p->condDone);
+}
+
+#else
+/********************************* Single-Threaded **************************/
+/*
+** All jobs run on the calling thread, so nothing ever waits.
+*/
+typedef struct AsyncLock AsyncLock;
+struct AsyncLock {
+  int notUsed;
+};
+#define asyncLockInit(p)
+#define asyncLockDestroy(p)
+#define asyncEnter(p)
+#define asyncLeave(p)
+#define asyncWaitWork(p)      assert( 0 )
+#define asyncWaitDone(p)      assert( 0 )
+#define asyncSignalWork(p)
+#define asyncBroadcastWork(p)
+#define asyncBroadcastDone(p)
+
+#endif
+/*************************************************************************/
+
+/*
+** Values for sqlite4_async.eState.
+*/
+#define ASYNC_QUEUED   1          /* On the run queue */
+#define ASYNC_RUNNING  2          /* Being run by a worker */
+#define ASYNC_READY    3          /* On a completion queue, not yet polled */
+#define ASYNC_PAUSED   4          /* Polled, waiting for sqlite4_async_next() */
+#define ASYNC_DONE     5          /* Finished */
+
+/*
+** The worker pool of an environment.
+*/
+struct AsyncPool {
+  sqlite4_env *pEnv;              /* Environment that owns this pool */
+  AsyncLock lock;                 /* Protects all fields below */
+  int bStarted;                   /* True once threads have been started */
+  int bShutdown;                  /* True to stop worker threads */
+  int nThread;                    /* Number of entries in apThread[] */
+  SQLiteThread **apThread;        /* Worker threads */
+  sqlite4_async *pFirst;          /* First job on the run queue */
+  sqlite4_async *pLast;           /* Last job on the run queue */
+  sqlite4_async *pAll;            /* List of all unfinished jobs */
+};
+
+/*
+** A completion queue.
+*/
+struct sqlite4_async_queue {
+  AsyncPool *pPool;               /* Pool that runs the jobs */
+  int nJob;                       /* Jobs submitted and not yet finished */
+  int nPending;                   /* Jobs in state QUEUED or RUNNING */
+  sqlite4_async *pFirst;          /* First job in state READY */
+  sqlite4_async *pLast;           /* Last job in state READY */
+};
+
+/*
+** A submitted job.
+*/
+struct sqlite4_async {
+  AsyncPool *pPool;               /* Pool that runs this job */
+  sqlite4 *db;                    /* Connection that owns pStmt */
+  sqlite4_stmt *pStmt;            /* Statement to run */
+  int nRow;                       /* Maximum rows per batch */
+  int nCol;                       /* Number of entries in aCol[] */
+  sqlite4_batch_column *aCol;     /* Batch buffers */
+  int (*xBatch)(void*,sqlite4_async*,int,int);  /* Callback, or NULL */
+  void *pArg;                     /* First argument to xBatch */
+  sqlite4_async_queue *pQueue;    /* Completion queue, if xBatch==0 */
+  int eState;                     /* One of the ASYNC_* values */
+  int iInterrupt;                 /* Value of db->iInterrupt when submitted */
+  int bInCallback;                /* True while xBatch is running */
+  int bFinish;                    /* Finished from within xBatch */
+  int rc;                         /* Result of the most recent batch */
+  int nOut;                       /* Rows in the most recent batch */
+  sqlite4_async *pNext;           /* Next on run or completion queue */
+  sqlite4_async *pAllNext;        /* Next in AsyncPool.pAll list */
+  sqlite4_async *pAllPrev;        /* Previous in AsyncPool.pAll list */
+};
+
+/*
+** Append job pJob to the run queue. The caller holds the pool lock.
+*/
+static void asyncEnqueue(AsyncPool *p, sqlite4_async *pJob){
+  pJob->eState = ASYNC_QUEUED;
+  pJob->pNext = 0;
+  if( p->pLast ){
+    p->pLast->pNext = pJob;
+  }else{
+    p->pFirst = pJob;
+  }
+  p->pLast = pJob;
+  if( pJob->pQueue ) pJob->pQueue->nPending++;
+  asyncSignalWork(&p->lock);
+}
+
+/*
+** Remove the first job from the run queue and return it, or return NULL
+** if the run queue is empty. The caller holds the pool lock.
+*/
+static sqlite4_async *asyncDequeue(AsyncPool *p){
+  sqlite4_async *pJob = p->pFirst;
+  if( pJob ){
+    p->pFirst = pJob->pNext;
+    if( p->pFirst==0 ) p->pLast = 0;
+    pJob->pNext = 0;
+    pJob->eState = ASYNC_RUNNING;
+  }
+  return pJob;
+}
+
+/*
+** Remove job pJob from the list of unfinished jobs and free it. The
+** caller holds the pool lock.
+*/
+static void asyncFree(AsyncPool *p, sqlite4_async *pJob){
+  if( pJob->pAllPrev ){
+    pJob->pAllPrev->pAllNext = pJob->pAllNext;
+  }else{
+    p->pAll = pJob->pAllNext;
+  }
+  if( pJob->pAllNext ) pJob->pAllNext->pAllPrev = pJob->pAllPrev;
+  if( pJob->pQueue ) pJob->pQueue->nJob--;
+  sqlite4_free(p->pEnv, pJob);
+}
+
+/*
+** Return true if sqlite4_interrupt() has been called on the connection
+** that owns job pJob since the job was submitted.
+*/
+static int asyncIsCancelled(sqlite4_async *pJob){
+  return SQLITE4_ATOMIC_LOAD_INT(&pJob->db->iInterrupt)!=pJob->iInterrupt;
+}
+
+/*
+** Run one batch of job pJob, which has just been removed from the run
+** queue, and deliver it. The caller does not hold the pool lock.
+*/
+static void asyncRun(AsyncPool *p, sqlite4_async *pJob){
+  int rc;
+  int nOut = 0;
+
+  if( asyncIsCancelled(pJob) ){
+    rc = SQLITE4_INTERRUPT;
+  }else{
+    rc = sqlite4_step_batch(
+        pJob->pStmt, pJob->nRow, pJob->nCol, pJob->aCol, &nOut
+    );
+  }
+
+  if( pJob->xBatch ){
+    int bStop;
+    asyncEnter(&p->lock);
+    pJob->rc = rc;
+    pJob->nOut = nOut;
+    pJob->bInCallback = 1;
+    asyncLeave(&p->lock);
+
+    bStop = pJob->xBatch(pJob->pArg, pJob, nOut, rc);
+
+    asyncEnter(&p->lock);
+    pJob->bInCallback = 0;
+    if( pJob->bFinish ){
+      asyncFree(p, pJob);
+    }else if( rc!=SQLITE4_ROW || bStop ){
+      pJob->eState = ASYNC_DONE;
+      asyncBroadcastDone(&p->lock);
+    }else{
+      asyncEnqueue(p, pJob);
+    }
+    asyncLeave(&p->lock);
+  }else{
+    sqlite4_async_queue *pQueue = pJob->pQueue;
+    asyncEnter(&p->lock);
+    pJob->rc = rc;
+    pJob->nOut = nOut;
+    pJob->eState = ASYNC_READY;
+    if( pQueue->pLast ){
+      pQueue->pLast->pNext = pJob;
+    }else{
+      pQueue->pFirst = pJob;
+    }
+    pQueue->pLast = pJob;
+    pQueue->nPending--;
+    asyncBroadcastDone(&p->lock);
+    asyncLeave(&p->lock);
+  }
+}
+
+/*
+** Run jobs from the run queue on the calling thread until it is empty.
+** This is used when the pool has no worker threads.
+*/
+static void asyncDrain(AsyncPool *p){
+  sqlite4_async *pJob;
+  asyncEnter(&p->lock);
+  while( (pJob = asyncDequeue(p))!=0 ){
+    asyncLeave(&p->lock);
+    asyncRun(p, pJob);
+    asyncEnter(&p->lock);
+  }
+  asyncLeave(&p->lock);
+}
+
+#ifdef SQLITE4_ASYNC_THREADS
+/*
+** Main routine of a worker thread.
+*/
+static void *asyncMain(void *pArg){
+  AsyncPool *p = (AsyncPool*)pArg;
+  asyncEnter(&p->lock);
+  while( 1 ){
+    sqlite4_async *pJob;
+    while( p->pFirst==0 && p->bShutdown==0 ){
+      asyncWaitWork(&p->lock);
+    }
+    pJob = asyncDequeue(p);
+    if( pJob==0 ) break;
+    asyncLeave(&p->lock);
+    asyncRun(p, pJob);
+    asyncEnter(&p->lock);
+  }
+  asyncLeave(&p->lock);
+  return 0;
+}
+#endif
+
+/*
+** Start the worker threads of pool p, if they have not already been
+** started. The caller does not hold the pool lock.
+**
+** The pool lock is held while the threads are created, so that bStarted
+** is only seen to be set once apThread[] and nThread are. New threads
+** block on the lock until this function returns.
+*/
+static void asyncStart(AsyncPool *p){
+#ifdef SQLITE4_ASYNC_THREADS
+  int nThread;
+  SQLiteThread **apThread = 0;
+  int i = 0;
+
+  asyncEnter(&p->lock);
+  if( p->bStarted==0 ){
+    nThread = p->pEnv->nAsyncThread;
+    if( nThread>0 ){
+      apThread = (SQLiteThread**)sqlite4MallocZero(
+          p->pEnv, nThread*sizeof(SQLiteThread*)
+      );
+    }
+    if( apThread ){
+      for(i=0; i<nThread; i++){
+        if( sqlite4ThreadCreate(p->pEnv, &apThread[i], asyncMain, (void*)p) ){
+          break;
+        }
+      }
+    }
+    p->apThread = apThread;
+    p->nThread = i;
+    p->bStarted = 1;
+  }
+  asyncLeave(&p->lock);
+#else
+  UNUSED_PARAMETER(p);
+#endif
+}
+
+/*
+** If the pool has no worker threads, run queued jobs on the calling
+** thread.
+*/
+static void asyncRunIfNoThreads(AsyncPool *p){
+  int nThread;
+  asyncEnter(&p->lock);
+  nThread = p->nThread;
+  asyncLeave(&p->lock);
+  if( nThread==0 ) asyncDrain(p);
+}
+
+/*
+** Create the worker pool of an environment. Called by
+** sqlite4_initialize(). Threads are not started until the first job is
+** submitted.
+*/
+int sqlite4AsyncInit(sqlite4_env *pEnv){
+  AsyncPool *p;
+  p = (AsyncPool*)sqlite4MallocZero(pEnv, sizeof(AsyncPool));
+  if( p==0 ) return SQLITE4_NOMEM;
+  p->pEnv = pEnv;
+  asyncLockInit(&p->lock);
+  pEnv->pAsync = p;
+  return SQLITE4_OK;
+}
+
+/*
+** Stop the worker threads of an environment and free its pool. Called
+** by sqlite4_shutdown(). Jobs still on the run queue are run first.
+*/
+void sqlite4AsyncEnd(sqlite4_env *pEnv){
+  AsyncPool *p = pEnv->pAsync;
+  if( p ){
+    int i;
+    asyncEnter(&p->lock);
+    p->bShutdown = 1;
+    asyncBroadcastWork(&p->lock);
+    asyncLeave(&p->lock);
+    for(i=0; i<p->nThread; i++){
+      void *pOut;
+      sqlite4ThreadJoin(p->apThread[i], &pOut);
+    }
+    asyncDrain(p);
+    asyncLockDestroy(&p->lock);
+    sqlite4_free(pEnv, p->apThread);
+    sqlite4_free(pEnv, p);
+    pEnv->pAsync = 0;
+  }
+}
+
+/*
+** Return true if the worker threads of the environment have been
+** started.
+*/
+int sqlite4AsyncStarted(sqlite4_env *pEnv){
+  AsyncPool *p = pEnv->pAsync;
+  int bStarted;
+  asyncEnter(&p->lock);
+  bStarted = p->bStarted;
+  asyncLeave(&p->lock);
+  return bStarted;
+}
+
+/*
+** Create a new completion queue.
+*/
+int sqlite4_async_queue_open(sqlite4_env *pEnv, sqlite4_async_queue **ppQueue){
+  sqlite4_async_queue *pQueue;
+  int rc;
+
+  *ppQueue = 0;
+  if( pEnv==0 ) pEnv = sqlite4_env_default();
+#ifndef SQLITE4_OMIT_AUTOINIT
+  rc = sqlite4_initialize(pEnv);
+  if( rc ) return rc;
+#endif
+  pQueue = (sqlite4_async_queue*)sqlite4MallocZero(
+      pEnv, sizeof(sqlite4_async_queue)
+  );
+  if( pQueue==0 ) return SQLITE4_NOMEM;
+  pQueue->pPool = pEnv->pAsync;
+  *ppQueue = pQueue;
+  return SQLITE4_OK;
+}
+
+/*
+** Destroy a completion queue. Return SQLITE4_BUSY if any job submitted
+** to it has not been finished.
+*/
+int sqlite4_async_queue_close(sqlite4_async_queue *pQueue){
+  AsyncPool *p;
+  int nJob;
+  if( pQueue==0 ) return SQLITE4_OK;
+  p = pQueue->pPool;
+  asyncEnter(&p->lock);
+  nJob = pQueue->nJob;
+  asyncLeave(&p->lock);
+  if( nJob ) return SQLITE4_BUSY;
+  sqlite4_free(p->pEnv, pQueue);
+  return SQLITE4_OK;
+}
+
+/*
+** Submit statement pStmt for asynchronous execution.
+*/
+int sqlite4_async_submit(
+  sqlite4_stmt *pStmt,
+  int nRow,
+  int nCol,
+  sqlite4_batch_column *aCol,
+  int (*xBatch)(void*,sqlite4_async*,int,int),
+  void *pArg,
+  sqlite4_async_queue *pQueue,
+  sqlite4_async **ppJob
+){
+  sqlite4 *db;
+  AsyncPool *p;
+  sqlite4_async *pJob;
+
+  *ppJob = 0;
+  if( pStmt==0 || nRow<1 || (xBatch==0)==(pQueue==0) ){
+    return SQLITE4_MISUSE_BKPT;
+  }
+  db = sqlite4_db_handle(pStmt);
+  p = db->pEnv->pAsync;
+  if( pQueue && pQueue->pPool!=p ) return SQLITE4_MISUSE_BKPT;
+
+  pJob = (sqlite4_async*)sqlite4MallocZero(db->pEnv, sizeof(sqlite4_async));
+  if( pJob==0 ) return SQLITE4_NOMEM;
+  pJob->pPool = p;
+  pJob->db = db;
+  pJob->pStmt = pStmt;
+  pJob->nRow = nRow;
+  pJob->nCol = nCol;
+  pJob->aCol = aCol;
+  pJob->xBatch = xBatch;
+  pJob->pArg = pArg;
+  pJob->pQueue = pQueue;
+  pJob->iInterrupt = SQLITE4_ATOMIC_LOAD_INT(&db->iInterrupt);
+  *ppJob = pJob;
+
+  asyncStart(p);
+  asyncEnter(&p->lock);
+  pJob->pAllNext = p->pAll;
+  if( p->pAll ) p->pAll->pAllPrev = pJob;
+  p->pAll = pJob;
+  if( pQueue ) pQueue->nJob++;
+  asyncEnqueue(p, pJob);
+  asyncLeave(&p->lock);
+  asyncRunIfNoThreads(p);
+  return SQLITE4_OK;
+}
+
+/*
+** Return the next job on completion queue pQueue that has a batch ready.
+*/
+sqlite4_async *sqlite4_async_poll(sqlite4_async_queue *pQueue, int bWait){
+  AsyncPool *p = pQueue->pPool;
+  sqlite4_async *pJob;
+  asyncEnter(&p->lock);
+  while( bWait && pQueue->pFirst==0 && pQueue->nPending>0 ){
+    asyncWaitDone(&p->lock);
+  }
+  pJob = pQueue->pFirst;
+  if( pJob ){
+    pQueue->pFirst = pJob->pNext;
+    if( pQueue->pFirst==0 ) pQueue->pLast = 0;
+    pJob->pNext = 0;
+    pJob->eState = ASYNC_PAUSED;
+  }
+  asyncLeave(&p->lock);
+  return pJob;
+}
+
+/*
+** Return the result of the most recent batch of job pJob.
+*/
+int sqlite4_async_result(sqlite4_async *pJob, int *pnRow, void **ppArg){
+  if( pnRow ) *pnRow = pJob->nOut;
+  if( ppArg ) *ppArg = pJob->pArg;
+  return pJob->rc;
+}
+
+/*
+** Resume a job that was returned by sqlite4_async_poll().
+*/
+int sqlite4_async_next(sqlite4_async *pJob){
+  AsyncPool *p = pJob->pPool;
+  int rc = SQLITE4_OK;
+  asyncEnter(&p->lock);
+  if( pJob->eState!=ASYNC_PAUSED ){
+    rc = SQLITE4_MISUSE_BKPT;
+  }else if( pJob->rc!=SQLITE4_ROW ){
+    rc = pJob->rc;
+  }else{
+    asyncEnqueue(p, pJob);
+  }
+  asyncLeave(&p->lock);
+  if( rc==SQLITE4_OK ) asyncRunIfNoThreads(p);
+  return rc;
+}
+
+/*
+** Wait for job pJob to stop running, then free it. Return the result
+** of its most recent batch.
+*/
+int sqlite4_async_finish(sqlite4_async *pJob){
+  AsyncPool *p;
+  int rc;
+  if( pJob==0 ) return SQLITE4_OK;
+  p = pJob->pPool;
+  asyncEnter(&p->lock);
+  if( pJob->bInCallback ){
+    /* The job is freed by the worker once the callback returns. */
+    pJob->bFinish = 1;
+    rc = pJob->rc;
+    asyncLeave(&p->lock);
+    return rc;
+  }
+  while( pJob->eState==ASYNC_QUEUED || pJob->eState==ASYNC_RUNNING ){
+    asyncWaitDone(&p->lock);
+  }
+  if( pJob->eState==ASYNC_READY ){
+    sqlite4_async_queue *pQueue = pJob->pQueue;
+    sqlite4_async **pp;
+    sqlite4_async *pPrev = 0;
+    for(pp=&pQueue->pFirst; *pp!=pJob; pp=&(*pp)->pNext) pPrev = *pp;
+    *pp = pJob->pNext;
+    if( pQueue->pLast==pJob ) pQueue->pLast = pPrev;
+  }
+  rc = pJob->rc;
+  asyncFree(p, pJob);
+  asyncLeave(&p->lock);
+  return rc;
+}
@@ -2261,86 +2261,128 @@ void sqlite4EncodeIndexValue(
 }
 
 /*
-** Generate code that will erase and refill index *pIdx.  This is
-** used to initialize a newly created index or to recompute the
-** content of an index in response to a REINDEX command.
-*/
-static void sqlite4RefillIndex(Parse *pParse, Index *pIdx, int bCreate){
-  Table *pTab = pIdx->pTable;    /* The table that is indexed */
-  int iTab = pParse->nTab++;     /* Cursor used for PK of pTab */
-  int iIdx = pParse->nTab++;     /* Cursor used for pIdx */
+** Generate code that will erase and refill the nIdx indexes in array
+** apIdx[], all of which must belong to the same table. This is used to
+** initialize a newly created index or to recompute the content of one
+** or more indexes in response to a REINDEX command.
+**
+** The table is scanned once. For each row, a key for each index is
+** added to an in-memory sorter (OP_SorterInsert). Once the scan is
+** complete, each sorter is sorted and its contents written to the
+** index in key order (OP_SorterWrite). A sorter that grows larger than
+** SQLITE4_LIMIT_SORTER_SIZE bytes during the scan is written out early,
+** as a sorted run. FTS5 indexes are updated row by row as the scan
+** proceeds.
+*/
+static void refillIndexes(
+  Parse *pParse,                 /* Parse context */
+  Table *pTab,                   /* The table that is indexed */
+  Index **apIdx,                 /* Indexes to refill */
+  int nIdx,                      /* Number of entries in apIdx[] */
+  int bCreate                    /* True if the indexes are new (and empty) */
+){
+  int iTab;                      /* Cursor used for PK of pTab */
+  int iIdx;                      /* Cursor used for apIdx[0] */
   int addr1;                     /* Address of top of loop */
   Vdbe *v;                       /* Generate code into this virtual machine */
-  int regKey;                    /* Registers containing the index key */
   sqlite4 *db = pParse->db;      /* The database connection */
-  int iDb = sqlite4SchemaToIndex(db, pIdx->pSchema);
+  int iDb = sqlite4SchemaToIndex(db, pTab->pSchema);
   Index *pPk;
+  int i;
 
 #ifndef SQLITE4_OMIT_AUTHORIZATION
-  if( sqlite4AuthCheck(pParse, SQLITE4_REINDEX, pIdx->zName, 0,
-      db->aDb[iDb].zName ) ){
-    return;
+  for(i=0; i<nIdx; i++){
+    if( sqlite4AuthCheck(pParse, SQLITE4_REINDEX, apIdx[i]->zName, 0,
+        db->aDb[iDb].zName ) ){
+      return;
+    }
   }
 #endif
 
   pPk = sqlite4FindPrimaryKey(pTab, 0);
   v = sqlite4GetVdbe(pParse);
-  if( v==0 ) return;
+  if( v==0 || nIdx==0 ) return;
+  iTab = pParse->nTab++;
+  iIdx = pParse->nTab;
+  pParse->nTab += nIdx;
 
   /* A write-lock on the table is required to perform this operation. Easiest
   ** way to do this is to open a write-cursor on the PK - even though this
   ** operation only requires read access.  */
   sqlite4OpenPrimaryKey(pParse, iTab, iDb, pTab, OP_OpenWrite);
 
-  /* Delete the current contents (if any) of the index. Then open a write
+  /* Delete the current contents (if any) of each index. Then open a write
   ** cursor on it.  */
-  if( bCreate==0 ){
-    sqlite4VdbeAddOp2(v, OP_Clear, pIdx->tnum, iDb);
+  for(i=0; i<nIdx; i++){
+    if( bCreate==0 ){
+      sqlite4VdbeAddOp2(v, OP_Clear, apIdx[i]->tnum, iDb);
+    }
+    sqlite4OpenIndex(pParse, iIdx+i, iDb, apIdx[i], OP_OpenWrite);
+    if( bCreate ) sqlite4VdbeChangeP5(v, 1);
   }
-  sqlite4OpenIndex(pParse, iIdx, iDb, pIdx, OP_OpenWrite);
-  if( bCreate ) sqlite4VdbeChangeP5(v, 1);
 
-  /* Loop through the contents of the PK index. At each row, insert the
-  ** corresponding entry into the auxiliary index.  */
+  /* Loop through the contents of the PK index. At each row, add the
+  ** corresponding entry for each auxiliary index to its sorter.  */
   addr1 = sqlite4VdbeAddOp2(v, OP_Rewind, iTab, 0);
+  for(i=0; i<nIdx; i++){
+    Index *pIdx = apIdx[i];
+    int regKey;                  /* Registers containing the index key */
 
-  if( pIdx->eIndexType==SQLITE4_INDEX_FTS5 ){
-    int regData;
-    int i;
+    if( pIdx->eIndexType==SQLITE4_INDEX_FTS5 ){
+      int regData;
+      int iCol;
 
-    regKey = sqlite4GetTempRange(pParse, pTab->nCol+1);
-    regData = regKey+1;
-
-    sqlite4VdbeAddOp2(v, OP_RowKey, iTab, regKey);
-    for(i=0; i<pTab->nCol; i++){
-      sqlite4VdbeAddOp3(v, OP_Column, iTab, i, regData+i);
-    }
-    sqlite4Fts5CodeUpdate(pParse, pIdx, pParse->iNewidxReg, regKey, regData, 0);
-  }else{
-    int regData = 0;
-    regKey = sqlite4GetTempRange(pParse, 2);
-    sqlite4EncodeIndexKey(pParse, pPk, iTab, pIdx, iIdx, 0, regKey);
-    if( pIdx->onError!=OE_None ){
-      const char *zErr = "indexed columns are not unique";
-      int addrTest;
-
-      addrTest = sqlite4VdbeAddOp4Int(v, OP_IsUnique, iIdx, 0, regKey, 0);
-      sqlite4HaltConstraint(pParse, OE_Abort, (char *)zErr, P4_STATIC);
-      sqlite4VdbeJumpHere(v, addrTest);
-    }
-    if( pIdx->nCover>0 ){
+      regKey = sqlite4GetTempRange(pParse, pTab->nCol+1);
       regData = regKey+1;
-      sqlite4EncodeIndexValue(pParse, iTab, pIdx, regData);
+
+      sqlite4VdbeAddOp2(v, OP_RowKey, iTab, regKey);
+      for(iCol=0; iCol<pTab->nCol; iCol++){
+        sqlite4VdbeAddOp3(v, OP_Column, iTab, iCol, regData+iCol);
+      }
+      sqlite4Fts5CodeUpdate(
+          pParse, pIdx, pParse->iNewidxReg, regKey, regData, 0
+      );
+      sqlite4ReleaseTempRange(pParse, regKey, pTab->nCol+1);
+    }else{
+      int regData = 0;
+      regKey = sqlite4GetTempRange(pParse, 2);
+      sqlite4EncodeIndexKey(pParse, pPk, iTab, pIdx, iIdx+i, 0, regKey);
+      if( pIdx->nCover>0 ){
+        regData = regKey+1;
+        sqlite4EncodeIndexValue(pParse, iTab, pIdx, regData);
+      }
+      sqlite4VdbeAddOp3(v, OP_SorterInsert, iIdx+i, regData, regKey);
+      if( pIdx->onError!=OE_None ) sqlite4VdbeChangeP5(v, 1);
+      sqlite4ReleaseTempRange(pParse, regKey, 2);
     }
-    sqlite4VdbeAddOp3(v, OP_Insert, iIdx, regData, regKey);  
-    sqlite4ReleaseTempRange(pParse, regKey, 2);
   }
-
   sqlite4VdbeAddOp2(v, OP_Next, iTab, addr1+1);
   sqlite4VdbeJumpHere(v, addr1);
 
+  /* Sort the keys accumulated for each index and write them out. */
+  for(i=0; i<nIdx; i++){
+    Index *pIdx = apIdx[i];
+    if( pIdx->eIndexType!=SQLITE4_INDEX_FTS5 ){
+      int addrWrite = sqlite4VdbeAddOp2(v, OP_SorterWrite, iIdx+i, 0);
+      if( pIdx->onError!=OE_None ){
+        const char *zErr = "indexed columns are not unique";
+        sqlite4HaltConstraint(pParse, OE_Abort, (char *)zErr, P4_STATIC);
+      }
+      sqlite4VdbeJumpHere(v, addrWrite);
+    }
+  }
+
   sqlite4VdbeAddOp1(v, OP_Close, iTab);
-  sqlite4VdbeAddOp1(v, OP_Close, iIdx);
+  for(i=0; i<nIdx; i++){
+    sqlite4VdbeAddOp1(v, OP_Close, iIdx+i);
+  }
+}
+
+/*
+** Generate code that will erase and refill index *pIdx.
+*/
+static void sqlite4RefillIndex(Parse *pParse, Index *pIdx, int bCreate){
+  refillIndexes(pParse, pIdx->pTable, &pIdx, 1, bCreate);
 }
 
 /*
@@ -3505,10 +3547,14 @@ void sqlite4Savepoint(Parse *pParse, int op, Token *pName){
 /*
 ** Make sure the TEMP database is open and available for use.  Return
 ** the number of errors.  Leave any error messages in the pParse structure.
+**
+** Plain EXPLAIN and EXPLAIN QUERY PLAN never run the statement, so the
+** TEMP database is not opened for them.  EXPLAIN PROFILE and EXPLAIN
+** ANALYZE do.
 */
 int sqlite4OpenTempDatabase(Parse *pParse){
   sqlite4 *db = pParse->db;
-  if( db->aDb[1].pKV==0 && !pParse->explain ){
+  if( db->aDb[1].pKV==0 && (pParse->explain==0 || pParse->explain>=3) ){
     int rc;
     rc = sqlite4KVStoreOpen(db, "temp", ":memory:", &db->aDb[1].pKV,
                             SQLITE4_KVOPEN_TEMPORARY);
@@ -3677,16 +3723,30 @@ static int collationMatch(const char *zColl, Index *pIndex){
 */
 #ifndef SQLITE4_OMIT_REINDEX
 static void reindexTable(Parse *pParse, Table *pTab, char const *zColl){
+  sqlite4 *db = pParse->db;   /* The database connection */
   Index *pIndex;              /* An index associated with pTab */
+  Index **apIdx;              /* Indexes to recompute */
+  int nIdx = 0;               /* Number of entries in apIdx[] */
+
+  for(pIndex=pTab->pIndex; pIndex; pIndex=pIndex->pNext) nIdx++;
+  apIdx = (Index **)sqlite4DbMallocRaw(db, sizeof(Index *)*(nIdx+1));
+  if( apIdx==0 ) return;
 
+  /* Collect the indexes to recompute, so that they may all be filled
+  ** using a single scan of the table.  */
+  nIdx = 0;
   for(pIndex=pTab->pIndex; pIndex; pIndex=pIndex->pNext){
     if( pIndex->eIndexType==SQLITE4_INDEX_PRIMARYKEY ) continue;
     if( zColl==0 || collationMatch(zColl, pIndex) ){
-      int iDb = sqlite4SchemaToIndex(pParse->db, pTab->pSchema);
-      sqlite4BeginWriteOperation(pParse, 0, iDb);
-      sqlite4RefillIndex(pParse, pIndex, 0);
+      apIdx[nIdx++] = pIndex;
     }
   }
+  if( nIdx>0 ){
+    int iDb = sqlite4SchemaToIndex(db, pTab->pSchema);
+    sqlite4BeginWriteOperation(pParse, 0, iDb);
+    refillIndexes(pParse, pTab, apIdx, nIdx, 0);
+  }
+  sqlite4DbFree(db, apIdx);
 }
 #endif
 
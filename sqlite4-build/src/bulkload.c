@@ -0,0 +1,858 @@
+/*
+** 2026-10-18
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file contains the implementation of the sqlite4_bulkload_*()
+** interfaces. A bulk-load handle loads rows into a single table without
+** preparing or running an INSERT statement.
+**
+** Each row appended to the handle is encoded directly, using the same
+** routines as OP_MakeKey and OP_MakeRecord, into one key (and possibly
+** one data record) for each index on the table, including the PRIMARY
+** KEY index. The encoded entries are buffered in memory, one VdbeSorter
+** per index. When the load is finished, or earlier if the buffered entries
+** grow larger than SQLITE4_LIMIT_SORTER_SIZE bytes, each buffer is sorted
+** in key order (using worker threads if SQLITE4_LIMIT_WORKER_THREADS
+** allows), checked for UNIQUE and PRIMARY KEY violations and then written
+** to the key-value store in a single statement transaction. Writing entries
+** in ascending key order is the access pattern that the key-value backends
+** handle most efficiently.
+*/
+#include "sqliteInt.h"
+#include "vdbeInt.h"
+
+typedef struct BulkIndex BulkIndex;
+
+/*
+** The entries buffered for a single index of the table being loaded.
+*/
+struct BulkIndex {
+  Index *pIdx;                    /* Index these entries belong to */
+  KeyInfo *pKeyInfo;              /* Key encoding information for pIdx */
+  VdbeSorter *pSorter;            /* Buffered entries */
+};
+
+/*
+** An instance of the following object is allocated by each call to
+** sqlite4_bulkload_begin().
+**
+** The values bound to the current row are stored in aVal[1] through
+** aVal[nCol]. If the table has an implicit integer primary key, the
+** rowid assigned to the current row is stored in aVal[0]. This is the
+** same layout that INSERT uses for the registers passed to
+** sqlite4GenerateConstraintChecks(), so that Index.aiColumn[] entries
+** (which are -1 for an implicit primary key) may be used to index aVal[]
+** after adding 1.
+*/
+struct sqlite4_bulkload {
+  sqlite4 *db;                    /* Database handle */
+  Table *pTab;                    /* Table being loaded */
+  int iDb;                        /* Database containing pTab */
+  int iGeneration;                /* Schema generation when handle opened */
+  int iCookie;                    /* Schema cookie when handle opened */
+  int nCol;                       /* Number of columns in pTab */
+  int iIntPKCol;                  /* INTEGER PRIMARY KEY column, or -1 */
+  int bImplicitPK;                /* True if pTab has an implicit PK */
+  i64 iNextRowid;                 /* Next rowid to assign automatically */
+  Mem *aVal;                      /* Values for the current row */
+  Mem **apDflt;                   /* Default value for each column */
+  Mem *aTmp;                      /* Scratch array used to build keys */
+  int nIdx;                       /* Number of entries in aIdx[] */
+  BulkIndex *aIdx;                /* One entry for each index on pTab */
+  int nRow;                       /* Number of rows currently buffered */
+  int nWritten;                   /* Number of rows already written */
+};
+
+/*
+** Report error code rc with the message zErr (which may be NULL) on
+** database handle db. zErr is freed by this function.
+*/
+static int bulkError(sqlite4 *db, int rc, char *zErr){
+  if( zErr ){
+    sqlite4Error(db, rc, "%s", zErr);
+    sqlite4DbFree(db, zErr);
+  }else{
+    sqlite4Error(db, rc, 0);
+  }
+  return rc;
+}
+
+/*
+** Return SQLITE4_SCHEMA if the schema of the database containing the
+** table being loaded has been modified or reloaded since handle p was
+** opened. In this case the Table and Index objects referred to by p may
+** have been freed. Otherwise return SQLITE4_OK.
+*/
+static int bulkCheckSchema(sqlite4_bulkload *p){
+  Schema *pSchema = p->db->aDb[p->iDb].pSchema;
+  if( pSchema==0
+   || pSchema->iGeneration!=p->iGeneration
+   || pSchema->schema_cookie!=p->iCookie
+  ){
+    return bulkError(p->db, SQLITE4_SCHEMA,
+        sqlite4MPrintf(p->db, "database schema has changed")
+    );
+  }
+  return SQLITE4_OK;
+}
+
+/*
+** Set *piRowid to one greater than the largest integer key currently
+** stored in the primary key of table pTab, or to 1 if the table is
+** empty. This is the value that OP_NewRowid would return.
+*/
+static int bulkLastRowid(KVStore *pKV, Index *pPk, i64 *piRowid){
+  KVCursor *pCur = 0;
+  KVByteArray aProbe[16];
+  KVSize nProbe;
+  const KVByteArray *aKey;
+  KVSize nKey;
+  int bTrans = 0;
+  int rc;
+  i64 iMax = 0;
+
+  if( pKV->iTransLevel==0 ){
+    rc = sqlite4KVStoreBegin(pKV, 1);
+    if( rc!=SQLITE4_OK ) return rc;
+    bTrans = 1;
+  }
+  rc = sqlite4KVStoreOpenCursor(pKV, &pCur);
+  if( rc==SQLITE4_OK ){
+    nProbe = sqlite4PutVarint64(aProbe, pPk->tnum);
+    aProbe[nProbe] = 0xFF;
+    rc = sqlite4KVCursorSeek(pCur, aProbe, nProbe+1, -1);
+    if( rc==SQLITE4_INEXACT ){
+      rc = sqlite4KVCursorKey(pCur, &aKey, &nKey);
+      if( rc==SQLITE4_OK && nKey>nProbe && memcmp(aKey, aProbe, nProbe)==0 ){
+        sqlite4_num num;
+        if( sqlite4VdbeDecodeNumericKey(&aKey[nProbe], nKey-nProbe, &num) ){
+          iMax = sqlite4_num_to_int64(num, 0);
+        }else{
+          rc = SQLITE4_CORRUPT_BKPT;
+        }
+      }
+    }else if( rc==SQLITE4_NOTFOUND ){
+      rc = SQLITE4_OK;
+    }else if( rc==SQLITE4_OK ){
+      rc = SQLITE4_CORRUPT_BKPT;
+    }
+    sqlite4KVCursorClose(pCur);
+  }
+  if( bTrans ){
+    sqlite4KVStoreRollback(pKV, 0);
+  }
+
+  if( rc==SQLITE4_OK && iMax==LARGEST_INT64 ) rc = SQLITE4_FULL;
+  *piRowid = iMax+1;
+  return rc;
+}
+
+/*
+** Free all resources associated with bulk-load handle p. The database
+** connection mutex must be held.
+*/
+static void bulkFree(sqlite4_bulkload *p){
+  sqlite4 *db = p->db;
+  int i;
+
+  for(i=0; i<p->nIdx; i++){
+    BulkIndex *pBI = &p->aIdx[i];
+    sqlite4VdbeSorterFree(db, pBI->pSorter);
+    sqlite4DbFree(db, pBI->pKeyInfo);
+  }
+  if( p->aVal ){
+    for(i=0; i<=p->nCol; i++) sqlite4VdbeMemRelease(&p->aVal[i]);
+  }
+  if( p->aTmp ){
+    for(i=0; i<=p->nCol*2; i++) sqlite4VdbeMemRelease(&p->aTmp[i]);
+  }
+  if( p->apDflt ){
+    for(i=0; i<p->nCol; i++) sqlite4ValueFree(p->apDflt[i]);
+  }
+  sqlite4DbFree(db, p->apDflt);
+  sqlite4DbFree(db, p->aTmp);
+  sqlite4DbFree(db, p->aVal);
+  sqlite4DbFree(db, p->aIdx);
+  sqlite4DbFree(db, p);
+}
+
+/*
+** Set the values of the current row of handle p to the column defaults.
+*/
+static int bulkResetRow(sqlite4_bulkload *p){
+  int rc = SQLITE4_OK;
+  int i;
+  sqlite4VdbeMemSetNull(&p->aVal[0]);
+  for(i=0; rc==SQLITE4_OK && i<p->nCol; i++){
+    Mem *pVal = &p->aVal[i+1];
+    if( p->apDflt[i] ){
+      rc = sqlite4VdbeMemCopy(pVal, p->apDflt[i]);
+    }else{
+      sqlite4VdbeMemSetNull(pVal);
+    }
+  }
+  return rc;
+}
+
+/*
+** Check whether or not table pTab may be loaded using a bulk-load handle.
+** If it may not, leave an error message in pParse and return non-zero.
+**
+** Tables that have triggers, foreign keys, CHECK constraints or an
+** AUTOINCREMENT column are not supported, as maintaining these requires
+** running SQL code for each row. Nor are tables with FTS5 indexes.
+*/
+static int bulkTableIsUnsupported(Parse *pParse, Table *pTab){
+  sqlite4 *db = pParse->db;
+  Index *pIdx;
+  const char *zReason = 0;
+
+  if( sqlite4IsReadOnly(pParse, pTab, 0) ) return 1;
+  if( IsKvstore(pTab) ){
+    zReason = "it is the sqlite_kvstore table";
+  }else if( sqlite4TriggerList(pParse, pTab) ){
+    zReason = "it has triggers";
+  }else if( pTab->pFKey && (db->flags & SQLITE4_ForeignKeys) ){
+    zReason = "it has foreign key constraints";
+#ifndef SQLITE4_OMIT_CHECK
+  }else if( pTab->pCheck ){
+    zReason = "it has CHECK constraints";
+#endif
+  }else if( pTab->tabFlags & TF_Autoincrement ){
+    zReason = "it has an AUTOINCREMENT column";
+  }else{
+    for(pIdx=pTab->pIndex; pIdx; pIdx=pIdx->pNext){
+      if( pIdx->eIndexType==SQLITE4_INDEX_FTS5 ){
+        zReason = "it has an fts5 index";
+        break;
+      }
+    }
+  }
+
+  if( zReason ){
+    sqlite4ErrorMsg(pParse, "cannot bulk load %s because %s",
+        pTab->zName, zReason
+    );
+    return 1;
+  }
+  return 0;
+}
+
+/*
+** Open a bulk-load handle on table zTab.
+*/
+int sqlite4_bulkload_begin(
+  sqlite4 *db,
+  const char *zDb,
+  const char *zTab,
+  sqlite4_bulkload **pp
+){
+  sqlite4_bulkload *p = 0;
+  Parse *pParse;
+  Table *pTab = 0;
+  Index *pIdx;
+  Index *pPk;
+  int rc = SQLITE4_OK;
+  int i;
+
+  *pp = 0;
+  if( !sqlite4SafetyCheckOk(db) ) return SQLITE4_MISUSE_BKPT;
+  sqlite4_mutex_enter(db->mutex);
+
+  pParse = sqlite4StackAllocZero(db, sizeof(Parse));
+  if( pParse==0 ){
+    rc = SQLITE4_NOMEM;
+    goto bulkload_begin_out;
+  }
+  pParse->db = db;
+
+  pTab = sqlite4LocateTable(pParse, 0, zTab, zDb);
+  if( pTab==0 || bulkTableIsUnsupported(pParse, pTab) ){
+    rc = pParse->rc ? pParse->rc : SQLITE4_ERROR;
+    goto bulkload_begin_out;
+  }
+
+  p = (sqlite4_bulkload *)sqlite4DbMallocZero(db, sizeof(sqlite4_bulkload));
+  if( p==0 ){
+    rc = SQLITE4_NOMEM;
+    goto bulkload_begin_out;
+  }
+  p->db = db;
+  p->pTab = pTab;
+  p->iDb = sqlite4SchemaToIndex(db, pTab->pSchema);
+  p->iGeneration = pTab->pSchema->iGeneration;
+  p->iCookie = pTab->pSchema->schema_cookie;
+  p->nCol = pTab->nCol;
+  p->iIntPKCol = -1;
+
+  pPk = sqlite4FindPrimaryKey(pTab, 0);
+  assert( pPk );
+  if( pPk->aiColumn[0]==(-1) ){
+    p->bImplicitPK = 1;
+  }else if( pPk->fIndex & IDX_IntPK ){
+    p->iIntPKCol = pPk->aiColumn[0];
+  }
+
+  /* Allocate the arrays of values. The scratch array aTmp[] is large
+  ** enough for the columns of any index followed by the primary key
+  ** columns.  */
+  for(pIdx=pTab->pIndex; pIdx; pIdx=pIdx->pNext) p->nIdx++;
+  p->aVal = (Mem *)sqlite4DbMallocZero(db, sizeof(Mem)*(p->nCol+1));
+  p->aTmp = (Mem *)sqlite4DbMallocZero(db, sizeof(Mem)*(p->nCol*2+1));
+  p->apDflt = (Mem **)sqlite4DbMallocZero(db, sizeof(Mem *)*p->nCol);
+  p->aIdx = (BulkIndex *)sqlite4DbMallocZero(db, sizeof(BulkIndex)*p->nIdx);
+  if( !p->aVal || !p->aTmp || !p->apDflt || !p->aIdx ){
+    rc = SQLITE4_NOMEM;
+    goto bulkload_begin_out;
+  }
+  for(i=0; i<=p->nCol; i++){
+    p->aVal[i].flags = MEM_Null;
+    p->aVal[i].db = db;
+  }
+  for(i=0; i<=p->nCol*2; i++){
+    p->aTmp[i].flags = MEM_Null;
+    p->aTmp[i].db = db;
+  }
+
+  /* Evaluate the DEFAULT value of each column. Values that are not
+  ** constant cannot be evaluated without a VM, so are not supported.  */
+  for(i=0; rc==SQLITE4_OK && i<p->nCol; i++){
+    Column *pCol = &pTab->aCol[i];
+    if( pCol->pDflt ){
+      rc = sqlite4ValueFromExpr(
+          db, pCol->pDflt, ENC(db), pCol->affinity, &p->apDflt[i]
+      );
+      if( rc==SQLITE4_OK && p->apDflt[i]==0 ){
+        sqlite4ErrorMsg(pParse,
+            "cannot bulk load %s because the default value of column %s "
+            "is not constant", pTab->zName, pCol->zName
+        );
+        rc = SQLITE4_ERROR;
+      }
+    }
+  }
+  if( rc!=SQLITE4_OK ) goto bulkload_begin_out;
+
+  /* Build a KeyInfo for each index */
+  for(i=0, pIdx=pTab->pIndex; pIdx; i++, pIdx=pIdx->pNext){
+    p->aIdx[i].pIdx = pIdx;
+    p->aIdx[i].pKeyInfo = sqlite4IndexKeyinfo(pParse, pIdx);
+    if( p->aIdx[i].pKeyInfo==0 ){
+      rc = pParse->nErr ? SQLITE4_ERROR : SQLITE4_NOMEM;
+      goto bulkload_begin_out;
+    }
+  }
+
+  /* If rowids may need to be allocated, find the largest in the table */
+  if( p->bImplicitPK || p->iIntPKCol>=0 ){
+    KVStore *pKV = db->aDb[p->iDb].pKV;
+    rc = bulkLastRowid(pKV, pPk, &p->iNextRowid);
+    if( rc!=SQLITE4_OK ) goto bulkload_begin_out;
+  }
+
+  rc = bulkResetRow(p);
+
+ bulkload_begin_out:
+  if( pParse ){
+    if( rc!=SQLITE4_OK && pParse->zErrMsg ){
+      bulkError(db, rc, pParse->zErrMsg);
+      pParse->zErrMsg = 0;
+    }else{
+      sqlite4Error(db, rc, 0);
+    }
+    sqlite4DbFree(db, pParse->zErrMsg);
+    sqlite4StackFree(db, pParse);
+  }
+  if( rc!=SQLITE4_OK && p ){
+    bulkFree(p);
+    p = 0;
+  }
+  *pp = p;
+  rc = sqlite4ApiExit(db, rc);
+  sqlite4_mutex_leave(db->mutex);
+  return rc;
+}
+
+/*
+** Check that iCol is a valid 1-based column number for handle p. If it
+** is, enter the database mutex and return a pointer to the value for
+** the column. Otherwise, return NULL.
+*/
+static Mem *bulkColumn(sqlite4_bulkload *p, int iCol){
+  if( p==0 ) return 0;
+  if( iCol<1 || iCol>p->nCol ){
+    sqlite4_mutex_enter(p->db->mutex);
+    sqlite4Error(p->db, SQLITE4_RANGE, 0);
+    sqlite4_mutex_leave(p->db->mutex);
+    return 0;
+  }
+  sqlite4_mutex_enter(p->db->mutex);
+  return &p->aVal[iCol];
+}
+
+/*
+** Set the value of one column of the current row.
+*/
+static int bulkBindText(
+  sqlite4_bulkload *p,       /* Bulk-load handle */
+  int iCol,                  /* Column to set (1-based) */
+  const void *zData,         /* Pointer to the data to be bound */
+  int nData,                 /* Number of bytes of data to be bound */
+  void (*xDel)(void*,void*), /* Destructor for the data */
+  void *pDelArg,             /* First argument to xDel() */
+  u8 encoding                /* Encoding for the data */
+){
+  Mem *pVal;
+  int rc = SQLITE4_OK;
+
+  pVal = bulkColumn(p, iCol);
+  if( pVal==0 ){
+    if( xDel!=SQLITE4_STATIC && xDel!=SQLITE4_TRANSIENT ){
+      xDel(pDelArg, (void*)zData);
+    }
+    return p ? SQLITE4_RANGE : SQLITE4_MISUSE_BKPT;
+  }
+  if( zData==0 ){
+    sqlite4VdbeMemSetNull(pVal);
+  }else{
+    rc = sqlite4VdbeMemSetStr(pVal, zData, nData, encoding, xDel, pDelArg);
+    if( rc==SQLITE4_OK && encoding!=0 ){
+      rc = sqlite4VdbeChangeEncoding(pVal, ENC(p->db));
+    }
+    sqlite4Error(p->db, rc, 0);
+    rc = sqlite4ApiExit(p->db, rc);
+  }
+  sqlite4_mutex_leave(p->db->mutex);
+  return rc;
+}
+int sqlite4_bulkload_bind_blob(
+  sqlite4_bulkload *p,
+  int iCol,
+  const void *zData,
+  int nData,
+  void (*xDel)(void*,void*),
+  void *pDelArg
+){
+  return bulkBindText(p, iCol, zData, nData, xDel, pDelArg, 0);
+}
+int sqlite4_bulkload_bind_text(
+  sqlite4_bulkload *p,
+  int iCol,
+  const char *zData,
+  int nData,
+  void (*xDel)(void*,void*),
+  void *pDelArg
+){
+  return bulkBindText(p, iCol, zData, nData, xDel, pDelArg, SQLITE4_UTF8);
+}
+int sqlite4_bulkload_bind_double(sqlite4_bulkload *p, int iCol, double r){
+  Mem *pVal = bulkColumn(p, iCol);
+  if( pVal==0 ) return p ? SQLITE4_RANGE : SQLITE4_MISUSE_BKPT;
+  sqlite4VdbeMemSetDouble(pVal, r);
+  sqlite4_mutex_leave(p->db->mutex);
+  return SQLITE4_OK;
+}
+int sqlite4_bulkload_bind_int64(
+  sqlite4_bulkload *p,
+  int iCol,
+  sqlite4_int64 iValue
+){
+  Mem *pVal = bulkColumn(p, iCol);
+  if( pVal==0 ) return p ? SQLITE4_RANGE : SQLITE4_MISUSE_BKPT;
+  sqlite4VdbeMemSetInt64(pVal, iValue);
+  sqlite4_mutex_leave(p->db->mutex);
+  return SQLITE4_OK;
+}
+int sqlite4_bulkload_bind_int(sqlite4_bulkload *p, int iCol, int iValue){
+  return sqlite4_bulkload_bind_int64(p, iCol, (i64)iValue);
+}
+int sqlite4_bulkload_bind_null(sqlite4_bulkload *p, int iCol){
+  Mem *pVal = bulkColumn(p, iCol);
+  if( pVal==0 ) return p ? SQLITE4_RANGE : SQLITE4_MISUSE_BKPT;
+  sqlite4VdbeMemSetNull(pVal);
+  sqlite4_mutex_leave(p->db->mutex);
+  return SQLITE4_OK;
+}
+
+/*
+** Add an entry to the buffer for index pBI. The key is formed from the
+** nKeyVal values in array aKeyVal[]. If aPermute is not NULL, the data
+** record is formed from the nData values of aVal[] identified by the
+** entries of aPermute[], as for sqlite4VdbeEncodeData(). Otherwise, the
+** data record is empty.
+*/
+static int bulkAddEntry(
+  sqlite4 *db,
+  BulkIndex *pBI,
+  Mem *aKeyVal, int nKeyVal,
+  Mem *aVal, int *aPermute, int nData,
+  int bUnique
+){
+  int rc;
+  u8 *aKey = 0;
+  int nKey = 0;
+  u8 *aData = 0;
+  int nDataOut = 0;
+  int nPrefix = 0;
+
+  rc = sqlite4VdbeEncodeKey(db, aKeyVal, nKeyVal, pBI->pIdx->tnum,
+      pBI->pKeyInfo, &aKey, &nKey, 0
+  );
+  if( rc==SQLITE4_OK && nData>0 ){
+    rc = sqlite4VdbeEncodeData(db, aVal, aPermute, nData, &aData, &nDataOut);
+  }
+  if( rc==SQLITE4_OK ){
+    /* If nPrefix is non-zero, no two entries in the index may share the
+    ** first nPrefix bytes of their keys. It is zero for entries of
+    ** non-unique indexes and for entries of UNIQUE indexes that contain
+    ** one or more NULL values.  */
+    if( bUnique ){
+      Index *pIdx = pBI->pIdx;
+      if( pIdx->eIndexType==SQLITE4_INDEX_PRIMARYKEY ){
+        nPrefix = nKey;
+      }else{
+        nPrefix = sqlite4VdbeShortKey(aKey, nKey, pIdx->nColumn, 0);
+      }
+    }
+    rc = sqlite4VdbeSorterInsert(db, &pBI->pSorter,
+        aKey, nKey, aData, nDataOut, nPrefix
+    );
+  }
+
+  sqlite4DbFree(db, aKey);
+  sqlite4DbFree(db, aData);
+  return rc;
+}
+
+/*
+** Encode the current row of bulk-load handle p into one entry for each
+** index on the table. The database mutex must be held.
+*/
+static int bulkAppendRow(sqlite4_bulkload *p){
+  sqlite4 *db = p->db;
+  Table *pTab = p->pTab;
+  Mem *aVal = p->aVal;
+  Mem *aTmp = p->aTmp;
+  Index *pPk = 0;
+  int rc = SQLITE4_OK;
+  int i;
+  int j;
+
+  /* Assign a rowid if required. */
+  if( p->bImplicitPK ){
+    sqlite4VdbeMemSetInt64(&aVal[0], p->iNextRowid++);
+  }else if( p->iIntPKCol>=0 ){
+    Mem *pIPK = &aVal[p->iIntPKCol+1];
+    if( pIPK->flags & MEM_Null ){
+      sqlite4VdbeMemSetInt64(pIPK, p->iNextRowid++);
+    }
+  }
+
+  /* Apply column affinities and check NOT NULL constraints. */
+  for(i=0; i<p->nCol; i++){
+    Column *pCol = &pTab->aCol[i];
+    Mem *pVal = &aVal[i+1];
+    sqlite4ValueApplyAffinity(pVal, pCol->affinity, ENC(db));
+    if( pCol->notNull && (pVal->flags & MEM_Null) ){
+      return bulkError(db, SQLITE4_CONSTRAINT, sqlite4MPrintf(db,
+            "%s.%s may not be NULL", pTab->zName, pCol->zName
+      ));
+    }
+  }
+  if( p->iIntPKCol>=0 ){
+    Mem *pIPK = &aVal[p->iIntPKCol+1];
+    i64 iRowid;
+    if( (pIPK->flags & MEM_Int)==0 ){
+      return bulkError(db, SQLITE4_MISMATCH,
+          sqlite4MPrintf(db, "datatype mismatch")
+      );
+    }
+    iRowid = sqlite4_num_to_int64(pIPK->u.num, 0);
+    if( iRowid>=p->iNextRowid ){
+      p->iNextRowid = (iRowid==LARGEST_INT64 ? iRowid : iRowid+1);
+    }
+  }
+
+  /* Create an entry for each index. As in sqlite4GenerateConstraintChecks(),
+  ** the primary key consists of just the primary key values. Other index
+  ** keys consist of the indexed columns followed by the primary key
+  ** values. The primary key entry stores the table record as its data.  */
+  for(i=0; rc==SQLITE4_OK && i<p->nIdx; i++){
+    Index *pIdx = p->aIdx[i].pIdx;
+    if( pIdx->eIndexType==SQLITE4_INDEX_PRIMARYKEY ){ pPk = pIdx; break; }
+  }
+  assert( pPk );
+  for(i=0; rc==SQLITE4_OK && i<p->nIdx; i++){
+    BulkIndex *pBI = &p->aIdx[i];
+    Index *pIdx = pBI->pIdx;
+    int nKeyVal = 0;
+    int bUnique = (pIdx->onError!=OE_None);
+
+    for(j=0; j<pIdx->nColumn; j++){
+      Mem *pVal = &aVal[pIdx->aiColumn[j]+1];
+      if( pVal->flags & MEM_Null ) bUnique = 0;
+      sqlite4VdbeMemShallowCopy(&aTmp[nKeyVal++], pVal, MEM_Ephem);
+    }
+    if( pIdx==pPk ){
+      rc = bulkAddEntry(db, pBI, aTmp, nKeyVal, &aVal[1], 0, p->nCol, 1);
+    }else{
+      for(j=0; j<pPk->nColumn; j++){
+        Mem *pVal = &aVal[pPk->aiColumn[j]+1];
+        sqlite4VdbeMemShallowCopy(&aTmp[nKeyVal++], pVal, MEM_Ephem);
+      }
+      rc = bulkAddEntry(db, pBI, aTmp, nKeyVal,
+          &aVal[1], pIdx->aiCover, pIdx->nCover, bUnique
+      );
+    }
+    for(j=0; j<nKeyVal; j++){
+      sqlite4VdbeMemSetNull(&aTmp[j]);
+    }
+  }
+
+  if( rc==SQLITE4_OK ){
+    p->nRow++;
+    rc = bulkResetRow(p);
+  }else{
+    /* Discard any entries already added for this row */
+    for(i=0; i<p->nIdx; i++){
+      sqlite4VdbeSorterTruncate(db, p->aIdx[i].pSorter, p->nRow);
+    }
+  }
+  return rc;
+}
+
+/*
+** Set *pbEmpty to true if the index with root tnum contains no entries,
+** or to false otherwise.
+*/
+static int bulkIndexIsEmpty(KVCursor *pCur, int tnum, int *pbEmpty){
+  KVByteArray aProbe[16];
+  KVSize nProbe;
+  const KVByteArray *aKey;
+  KVSize nKey;
+  int rc;
+
+  *pbEmpty = 1;
+  nProbe = sqlite4PutVarint64(aProbe, tnum);
+  rc = sqlite4KVCursorSeek(pCur, aProbe, nProbe, 1);
+  if( rc==SQLITE4_OK || rc==SQLITE4_INEXACT ){
+    rc = sqlite4KVCursorKey(pCur, &aKey, &nKey);
+    if( rc==SQLITE4_OK && nKey>=nProbe && memcmp(aKey, aProbe, nProbe)==0 ){
+      *pbEmpty = 0;
+    }
+  }else if( rc==SQLITE4_NOTFOUND ){
+    rc = SQLITE4_OK;
+  }
+  return rc;
+}
+
+/*
+** Sort the entries buffered for index pBI, check them for UNIQUE
+** constraint violations and write them to the key-value store. If the
+** index is not empty, each entry that is subject to a UNIQUE constraint
+** is also checked against the existing contents of the index.
+*/
+static int bulkWriteIndex(
+  sqlite4 *db,
+  KVCursor *pCur,
+  BulkIndex *pBI
+){
+  Index *pIdx = pBI->pIdx;
+  int bEmpty = 1;
+  int bFound = 0;
+  int rc;
+
+  rc = bulkIndexIsEmpty(pCur, pIdx->tnum, &bEmpty);
+  if( rc==SQLITE4_OK ){
+    rc = sqlite4VdbeSorterFlush(db, pBI->pSorter, pCur, !bEmpty, &bFound);
+  }
+  if( rc==SQLITE4_OK && bFound ){
+    rc = bulkError(db, SQLITE4_CONSTRAINT, sqlite4NotUniqueMessage(db, pIdx));
+  }
+  return rc;
+}
+
+/*
+** Write the rows buffered by bulk-load handle p to the database and
+** empty the buffers. The database mutex must be held.
+**
+** The rows are written within a statement transaction, as for an INSERT
+** statement. If no explicit transaction is open and no other statement
+** is writing to the database, the transaction is committed before
+** returning. If an error occurs, the buffered rows are discarded.
+*/
+static int bulkFlush(sqlite4_bulkload *p){
+  sqlite4 *db = p->db;
+  KVStore *pKV = db->aDb[p->iDb].pKV;
+  KVCursor *pCur = 0;
+  int bCommit;
+  int iLevel;
+  int rc = SQLITE4_OK;
+  int rc2;
+  int i;
+
+  if( p->nRow==0 ) return SQLITE4_OK;
+  if( db->writeVdbeCnt==0 && db->pSavepoint==0 ){
+    bCommit = 1;
+  }else{
+    bCommit = 0;
+  }
+
+  /* Open a write transaction, then a statement transaction within it. This
+  ** mirrors the work done by OP_Transaction. Starting a new step
+  ** generation causes any seek batches read before the load to be
+  ** discarded.  */
+  sqlite4VdbeNewStepGen(db);
+  iLevel = db->nSavepoint + 1;
+  if( iLevel<2 ) iLevel = 2;
+  if( pKV->iTransLevel<iLevel ){
+    rc = sqlite4KVStoreBegin(pKV, iLevel);
+  }
+  if( rc==SQLITE4_OK ){
+    rc = sqlite4KVStoreBegin(pKV, pKV->iTransLevel+1);
+    if( rc==SQLITE4_OK ){
+      rc = sqlite4KVStoreOpenCursor(pKV, &pCur);
+      for(i=0; rc==SQLITE4_OK && i<p->nIdx; i++){
+        rc = bulkWriteIndex(db, pCur, &p->aIdx[i]);
+      }
+      sqlite4KVCursorClose(pCur);
+
+      /* Close the statement transaction */
+      rc2 = SQLITE4_OK;
+      if( rc!=SQLITE4_OK ){
+        rc2 = sqlite4KVStoreRollback(pKV, pKV->iTransLevel);
+      }
+      if( rc2==SQLITE4_OK ){
+        rc2 = sqlite4KVStoreCommit(pKV, pKV->iTransLevel-1);
+      }
+      if( rc==SQLITE4_OK ) rc = rc2;
+    }
+  }
+
+  if( bCommit ){
+    if( rc==SQLITE4_OK ){
+      rc = sqlite4VdbeCommit(db, 1);
+    }else{
+      sqlite4VdbeRollback(db, 1);
+    }
+    if( db->activeVdbeCnt==0 ){
+      sqlite4VdbeRollback(db, 0);
+    }
+  }
+
+  /* Discard the buffered entries. After an error, free the sorters too,
+  ** as a sorter that has found a UNIQUE conflict accepts no more entries. */
+  for(i=0; i<p->nIdx; i++){
+    if( rc==SQLITE4_OK ){
+      sqlite4VdbeSorterTruncate(db, p->aIdx[i].pSorter, 0);
+    }else{
+      sqlite4VdbeSorterFree(db, p->aIdx[i].pSorter);
+      p->aIdx[i].pSorter = 0;
+    }
+  }
+  if( rc==SQLITE4_OK ) p->nWritten += p->nRow;
+  p->nRow = 0;
+  return rc;
+}
+
+/*
+** If the entries buffered by bulk-load handle p have grown larger than
+** SQLITE4_LIMIT_SORTER_SIZE bytes, write them to the database.
+*/
+static int bulkFlushIfFull(sqlite4_bulkload *p){
+  i64 nByte = 0;
+  int i;
+  for(i=0; i<p->nIdx; i++){
+    nByte += sqlite4VdbeSorterSize(p->aIdx[i].pSorter);
+  }
+  if( nByte>=p->db->aLimit[SQLITE4_LIMIT_SORTER_SIZE] ){
+    return bulkFlush(p);
+  }
+  return SQLITE4_OK;
+}
+
+/*
+** Write any rows still buffered by bulk-load handle p to the database. The
+** database mutex must be held.
+*/
+static int bulkFinish(sqlite4_bulkload *p){
+  int rc = bulkFlush(p);
+  if( rc==SQLITE4_OK ){
+    sqlite4VdbeSetChanges(p->db, p->nWritten);
+  }
+  return rc;
+}
+
+/*
+** Append the current row to the bulk-load handle.
+*/
+int sqlite4_bulkload_append(sqlite4_bulkload *p){
+  sqlite4 *db;
+  int rc;
+
+  if( p==0 ) return SQLITE4_MISUSE_BKPT;
+  db = p->db;
+  sqlite4_mutex_enter(db->mutex);
+  rc = bulkCheckSchema(p);
+  if( rc==SQLITE4_OK ){
+    rc = bulkAppendRow(p);
+    if( rc==SQLITE4_OK ) rc = bulkFlushIfFull(p);
+    if( rc==SQLITE4_OK ){
+      sqlite4Error(db, SQLITE4_OK, 0);
+    }else if( db->errCode!=rc ){
+      sqlite4Error(db, rc, 0);
+    }
+  }
+  if( rc!=SQLITE4_OK ) bulkResetRow(p);
+  rc = sqlite4ApiExit(db, rc);
+  sqlite4_mutex_leave(db->mutex);
+  return rc;
+}
+
+/*
+** Write all rows appended to bulk-load handle p to the database and
+** close the handle.
+*/
+int sqlite4_bulkload_finish(sqlite4_bulkload *p){
+  sqlite4 *db;
+  int rc;
+
+  if( p==0 ) return SQLITE4_OK;
+  db = p->db;
+  sqlite4_mutex_enter(db->mutex);
+  rc = bulkCheckSchema(p);
+  if( rc==SQLITE4_OK ){
+    rc = bulkFinish(p);
+    if( rc==SQLITE4_OK ){
+      sqlite4Error(db, SQLITE4_OK, 0);
+    }else if( db->errCode!=rc ){
+      sqlite4Error(db, rc, 0);
+    }
+  }
+  bulkFree(p);
+  rc = sqlite4ApiExit(db, rc);
+  sqlite4_mutex_leave(db->mutex);
+  return rc;
+}
+
+/*
+** Close bulk-load handle p without writing anything to the database.
+*/
+int sqlite4_bulkload_abort(sqlite4_bulkload *p){
+  sqlite4 *db;
+
+  if( p==0 ) return SQLITE4_OK;
+  db = p->db;
+  sqlite4_mutex_enter(db->mutex);
+  bulkFree(p);
+  sqlite4_mutex_leave(db->mutex);
+  return SQLITE4_OK;
+}
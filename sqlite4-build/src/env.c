@@ -13,6 +13,9 @@
 ** This file contains code used to help implement the sqlite4_env object.
 */
 #include "sqliteInt.h"
+#ifndef WIN32
+# include <dlfcn.h>
+#endif
 
 
 /*
@@ -24,6 +27,12 @@ static KVFactory memFactory = {
    sqlite4KVStoreOpenMem,
    1
 };
+static KVFactory mapFactory = {
+   &memFactory,
+   "map",
+   sqlite4KVStoreOpenMap,
+   1
+};
 //static KVFactory bdbFactory = {
 //   &memFactory,
 //   "bdb",
@@ -72,7 +81,7 @@ static KVFactory memFactory = {
 //};
 
 KVFactory sqlite4BuiltinFactory = {
-   &memFactory,
+   &mapFactory,
    "main",
    sqlite4KVStoreOpenMem, // use "temp" as "main"
    1
@@ -100,6 +109,7 @@ struct sqlite4_env sqlite4DefaultEnv = {
    &sqlite4BuiltinFactory,    /* pFactory */
    sqlite4OsRandomness,       /* xRandomness */
    sqlite4OsCurrentTime,      /* xCurrentTime */
+   SQLITE4_DEFAULT_ASYNC_THREADS, /* nAsyncThread */
    /* All the rest should always be initialized to zero */
    0,                         /* isInit */
    0,                         /* pFactoryMutex */
@@ -172,6 +182,9 @@ int sqlite4_initialize(sqlite4_env *pEnv){
     ){
       rc = SQLITE4_NOMEM;
     }
+    sqlite4MutexTag(pEnv->pMemMutex, "env.pMemMutex");
+    sqlite4MutexTag(pEnv->pPrngMutex, "env.pPrngMutex");
+    sqlite4MutexTag(pEnv->pFactoryMutex, "env.pFactoryMutex");
   }else{
     pEnv->pMemMutex = 0;
     pEnv->pPrngMutex = 0;
@@ -185,6 +198,11 @@ int sqlite4_initialize(sqlite4_env *pEnv){
     sqlite4RegisterGlobalFunctions(pEnv);
   }
 
+  /* Create the asynchronous execution worker pool */
+  if( rc==SQLITE4_OK ){
+    rc = sqlite4AsyncInit(pEnv);
+  }
+
   /* The following is just a sanity check to make sure SQLite has
   ** been compiled correctly.  It is important to run this code, but
   ** we don't want to run it too often and soak up CPU cycles for no
@@ -219,6 +237,7 @@ int sqlite4_shutdown(sqlite4_env *pEnv){
   if( pEnv==0 ) pEnv = &sqlite4DefaultEnv;
   if( pEnv->isInit ){
     KVFactory *pMkr;
+    sqlite4AsyncEnd(pEnv);
     sqlite4_mutex_free(pEnv->pFactoryMutex);
     sqlite4_mutex_free(pEnv->pPrngMutex);
     sqlite4_mutex_free(pEnv->pMemMutex);
@@ -228,8 +247,18 @@ int sqlite4_shutdown(sqlite4_env *pEnv){
       sqlite4_free(pEnv, pMkr);
       pEnv->pFactory = pNext;
     }
+    while( (pMkr = pEnv->pRetiredFactory)!=0 ){
+      pEnv->pRetiredFactory = pMkr->pRetired;
+      sqlite4_free(pEnv, pMkr);
+    }
     sqlite4MutexEnd(pEnv);
     sqlite4MallocEnd(pEnv);
+
+    /* The built-in functions are registered again by the next call to
+    ** sqlite4_initialize(). Their FuncDef structures are static, so
+    ** appending them to the existing table would link the last back to
+    ** the first.  */
+    memset(&pEnv->aGlobalFuncs, 0, sizeof(pEnv->aGlobalFuncs));
     pEnv->isInit = 0;
   }
   return SQLITE4_OK;
@@ -284,6 +313,7 @@ sqlite4_kvfactory sqlite4GetKVStoreFactoryFunction(const char * sPluginName)
    }
 #else
    // POSIX
+   const char * sFactoryFunctionName = "KVStoreOpen";
    void    * handle = 0;
    /* open the needed object */
    handle = dlopen(sPluginName, RTLD_GLOBAL | RTLD_NOW);
@@ -292,7 +322,7 @@ sqlite4_kvfactory sqlite4GetKVStoreFactoryFunction(const char * sPluginName)
       printf("Failed sqlite4GetKVStoreFactoryFunction() : dlopen() failed for Plugin '%s'\n", sPluginName);
       return 0;
    }
-   *(void **)(&fact_fun) = dlsym(handle, "KVStoreOpen");
+   *(void **)(&fact_fun) = dlsym(handle, sFactoryFunctionName);
    if (!fact_fun)
    {
       printf("Failed sqlite4GetKVStoreFactoryFunction() : dlsym() failed for Plugin '%s' and Factory Function '%s'\n",
@@ -365,6 +395,9 @@ int sqlite4_env_config(sqlite4_env *pEnv, int op, ...){
       if( n>sizeof(sqlite4_env) ) n = sizeof(sqlite4_env);
       memcpy(pEnv, pTemplate, n);
       pEnv->pFactory = &sqlite4BuiltinFactory;
+      pEnv->pMutexProf = 0;
+      pEnv->pRetiredFactory = 0;
+      pEnv->pAsync = 0;
       pEnv->isInit = 0;
       break;
     }
@@ -477,6 +510,36 @@ int sqlite4_env_config(sqlite4_env *pEnv, int op, ...){
       break;
     }
 
+    /* sqlite4_env_config(p, SQLITE4_ENVCONFIG_MUTEXPROF, int onoff);
+    **
+    ** Enable or disable the mutex contention profiler.  The profiler
+    ** wraps the mutex methods when the environment is initialized, so
+    ** this option is not available afterwards.  Results are read using
+    ** sqlite4_env_mutex_status().
+    */
+    case SQLITE4_ENVCONFIG_MUTEXPROF: {
+      if( pEnv->isInit ) return SQLITE4_MISUSE;
+      pEnv->bMutexProf = va_arg(ap, int);
+      break;
+    }
+
+    /* sqlite4_env_config(p, SQLITE4_ENVCONFIG_ASYNCTHREADS, int nThread);
+    **
+    ** Set the number of worker threads used to run jobs submitted with
+    ** sqlite4_async_submit().  Zero means that jobs run on the calling
+    ** thread.  The threads are started when the first job is submitted,
+    ** so this option is not available after that.
+    */
+    case SQLITE4_ENVCONFIG_ASYNCTHREADS: {
+      int nThread = va_arg(ap, int);
+      if( nThread<0 || (pEnv->pAsync && sqlite4AsyncStarted(pEnv)) ){
+        rc = SQLITE4_MISUSE;
+        break;
+      }
+      pEnv->nAsyncThread = nThread;
+      break;
+    }
+
     /*
     ** sqlite4_env_config(p, SQLITE4_ENVCONFIG_LOOKASIDE, size, count);
     **
@@ -528,7 +591,7 @@ int sqlite4_env_config(sqlite4_env *pEnv, int op, ...){
       pMkr->xFactory = va_arg(ap, sqlite4_kvfactory);
       sqlite4_mutex_enter(pEnv->pFactoryMutex);
       pMkr->pNext = pEnv->pFactory;
-      pEnv->pFactory = pMkr;
+      SQLITE4_ATOMIC_STORE_PTR(&pEnv->pFactory, pMkr);
       sqlite4_mutex_leave(pEnv->pFactoryMutex);
       break;
     }
@@ -563,8 +626,10 @@ int sqlite4_env_config(sqlite4_env *pEnv, int op, ...){
       if( pMkr ){
         *pxFact = pMkr->xFactory;
         if( op==SQLITE4_ENVCONFIG_KVSTORE_POP && pMkr->isPerm==0 ){
-          *ppPrev = pMkr->pNext;
-          sqlite4_free(pEnv, pMkr);
+          /* Readers may still be using pMkr.  See KVFactory. */
+          SQLITE4_ATOMIC_STORE_PTR(ppPrev, pMkr->pNext);
+          pMkr->pRetired = pEnv->pRetiredFactory;
+          pEnv->pRetiredFactory = pMkr;
         }
       }
       sqlite4_mutex_leave(pEnv->pFactoryMutex);
@@ -1652,6 +1652,7 @@ int sqlite4CodeSubselect(
 ){
   int testAddr = -1;                      /* One-time test address */
   int rReg = 0;                           /* Register storing resulting */
+  int addrExplain = -1;                   /* OP_Explain instruction, or -1 */
   Vdbe *v = sqlite4GetVdbe(pParse);
   if( NEVER(v==0) ) return 0;
   sqlite4ExprCachePush(pParse);
@@ -1671,12 +1672,14 @@ int sqlite4CodeSubselect(
   }
 
 #ifndef SQLITE4_OMIT_EXPLAIN
-  if( pParse->explain==2 ){
+  if( ExplainQueryPlan(pParse) ){
     char *zMsg = sqlite4MPrintf(
         pParse->db, "EXECUTE %s%s SUBQUERY %d", testAddr>=0?"":"CORRELATED ",
         pExpr->op==TK_IN?"LIST":"SCALAR", pParse->iNextSelectId
     );
-    sqlite4VdbeAddOp4(v, OP_Explain, pParse->iSelectId, 0, 0, zMsg, P4_DYNAMIC);
+    addrExplain = sqlite4VdbeAddOp4(
+        v, OP_Explain, pParse->iSelectId, 0, 0, zMsg, P4_DYNAMIC
+    );
   }
 #endif
 
@@ -1826,6 +1829,14 @@ int sqlite4CodeSubselect(
     }
   }
 
+  /* For EXPLAIN ANALYZE, the OP_Explain is run each time the subquery is */
+  if( addrExplain>=0 && ExplainAnalyze(pParse) ){
+    sqlite4VdbeScanStatus(v, addrExplain, addrExplain, -1, -1);
+    sqlite4VdbeScanStatusRange(v, addrExplain,
+        addrExplain, sqlite4VdbeCurrentAddr(v)
+    );
+  }
+
   if( testAddr>=0 ){
     sqlite4VdbeJumpHere(v, testAddr);
   }
@@ -2925,12 +2936,28 @@ int sqlite4ExprCodeTarget(Parse *pParse, Expr *pExpr, int target){
 ** If the register is a temporary register that can be deallocated,
 ** then write its number into *pReg.  If the result register is not
 ** a temporary, then set *pReg to zero.
+**
+** The value in a temporary register is consumed by the caller before the
+** cursor it was read from advances. So if pExpr is a column reference that
+** was loaded by an OP_Column, that instruction is marked with OPFLAG_KVREF
+** to allow it to refer to the row in the storage engine instead of copying
+** it. The register is also removed from the column cache, so that no other
+** expression can pick up the reference and keep it past a cursor move.
 */
 int sqlite4ExprCodeTemp(Parse *pParse, Expr *pExpr, int *pReg){
+  Vdbe *v = pParse->pVdbe;
+  int iAddr = (v ? sqlite4VdbeCurrentAddr(v) : 0);
   int r1 = sqlite4GetTempReg(pParse);
   int r2 = sqlite4ExprCodeTarget(pParse, pExpr, r1);
   if( r2==r1 ){
     *pReg = r1;
+    if( v && pExpr->op==TK_COLUMN && iAddr<sqlite4VdbeCurrentAddr(v) ){
+      VdbeOp *pOp = sqlite4VdbeGetOp(v, iAddr);
+      if( pOp->opcode==OP_Column && pOp->p3==r1 ){
+        pOp->p5 |= OPFLAG_KVREF;
+        sqlite4ExprCacheRemove(pParse, r1, 1);
+      }
+    }
   }else{
     sqlite4ReleaseTempReg(pParse, r1);
     *pReg = 0;
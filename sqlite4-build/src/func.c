@@ -1409,6 +1409,22 @@ int sqlite4IsLikeFunction(sqlite4 *db, Expr *pExpr, int *pIsNocase, char *aWc){
   return 1;
 }
 
+/*
+** If pDef is the built-in count(), sum(), avg(), min() or max() aggregate,
+** return the corresponding PARAGG_* value. Otherwise, return 0.
+*/
+int sqlite4ParallelAggOp(FuncDef *pDef){
+  if( pDef->xStep==countStep ) return PARAGG_COUNT;
+  if( pDef->xStep==sumStep ){
+    if( pDef->xFinalize==sumFinalize ) return PARAGG_SUM;
+    if( pDef->xFinalize==avgFinalize ) return PARAGG_AVG;
+  }
+  if( pDef->xStep==minmaxStep ){
+    return (pDef->pUserData ? PARAGG_MAX : PARAGG_MIN);
+  }
+  return 0;
+}
+
 /*
 ** Add all of the FuncDef structures in the aBuiltinFunc[] array above
 ** to the global function hash table.  This occurs at start-time (as
@@ -11,31 +11,32 @@
 ******************************************************************************
 **
 ** This file contains inline asm code for retrieving "high-performance"
-** counters for x86 class CPUs.
+** counters for x86, x86_64, ARM64 and PowerPC CPUs.
 */
 #ifndef _HWTIME_H_
 #define _HWTIME_H_
 
 /*
-** The following routine only works on pentium-class (or newer) processors.
-** It uses the RDTSC opcode to read the cycle count value out of the
-** processor and returns that value.  This can be used for high-res
-** profiling.
+** The following routine returns the value of a free-running cycle or
+** timebase counter maintained by the processor.  On x86 class CPUs this
+** is the RDTSC counter.  This can be used for high-res profiling.  The
+** units are not the same on all platforms, so only differences between
+** values returned on the same machine are meaningful.
 */
 #if (defined(__GNUC__) || defined(_MSC_VER)) && \
       (defined(i386) || defined(__i386__) || defined(_M_IX86))
 
   #if defined(__GNUC__)
 
-  __inline__ sqlite_uint64 sqlite4Hwtime(void){
+  static __inline__ sqlite4_uint64 sqlite4Hwtime(void){
      unsigned int lo, hi;
      __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
-     return (sqlite_uint64)hi << 32 | lo;
+     return (sqlite4_uint64)hi << 32 | lo;
   }
 
   #elif defined(_MSC_VER)
 
-  __declspec(naked) __inline sqlite_uint64 __cdecl sqlite4Hwtime(void){
+  __declspec(naked) __inline sqlite4_uint64 __cdecl sqlite4Hwtime(void){
      __asm {
         rdtsc
         ret       ; return value at EDX:EAX
@@ -46,15 +47,30 @@
 
 #elif (defined(__GNUC__) && defined(__x86_64__))
 
-  __inline__ sqlite_uint64 sqlite4Hwtime(void){
-      unsigned long val;
-      __asm__ __volatile__ ("rdtsc" : "=A" (val));
+  static __inline__ sqlite4_uint64 sqlite4Hwtime(void){
+      unsigned int lo, hi;
+      __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+      return (sqlite4_uint64)hi << 32 | lo;
+  }
+
+#elif (defined(_MSC_VER) && defined(_M_X64))
+
+  #include <intrin.h>
+  static __inline sqlite4_uint64 sqlite4Hwtime(void){
+      return (sqlite4_uint64)__rdtsc();
+  }
+
+#elif (defined(__GNUC__) && defined(__aarch64__))
+
+  static __inline__ sqlite4_uint64 sqlite4Hwtime(void){
+      sqlite4_uint64 val;
+      __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (val));
       return val;
   }
  
 #elif (defined(__GNUC__) && defined(__ppc__))
 
-  __inline__ sqlite_uint64 sqlite4Hwtime(void){
+  static __inline__ sqlite4_uint64 sqlite4Hwtime(void){
       unsigned long long retval;
       unsigned long junk;
       __asm__ __volatile__ ("\n\
@@ -69,16 +85,12 @@
 
 #else
 
-  #error Need implementation of sqlite4Hwtime() for your platform.
-
   /*
-  ** To compile without implementing sqlite4Hwtime() for your platform,
-  ** you can remove the above #error and use the following
-  ** stub function.  You will lose timing support for many
-  ** of the debugging and testing utilities, but it should at
-  ** least compile and run.
+  ** There is no implementation of sqlite4Hwtime() for this platform.
+  ** The stub below lets the library compile and run, but all timings
+  ** reported by VDBE_PROFILE and EXPLAIN PROFILE will be zero.
   */
-  sqlite_uint64 sqlite4Hwtime(void){ return ((sqlite_uint64)0); }
+  static sqlite4_uint64 sqlite4Hwtime(void){ return ((sqlite4_uint64)0); }
 
 #endif
 
@@ -1098,8 +1098,8 @@ Index *sqlite4FindPrimaryKey(
 **
 ** The returned buffer should be freed by the caller using sqlite4DbFree().
 */
-static char *notUniqueMessage(
-  Parse *pParse,                  /* Parse context */
+char *sqlite4NotUniqueMessage(
+  sqlite4 *db,                    /* Database handle */
   Index *pIdx                     /* Index to generate error message for */
 ){
   const int nCol = pIdx->nColumn; /* Number of columns indexed by pIdx */
@@ -1107,8 +1107,8 @@ static char *notUniqueMessage(
   int iCol;                       /* Used to iterate through indexed columns */
 
   sqlite4StrAccumInit(&errMsg, 0, 0, 200);
-  errMsg.db = pParse->db;
-  errMsg.pEnv = errMsg.db->pEnv;
+  errMsg.db = db;
+  errMsg.pEnv = db->pEnv;
   if( pIdx->eIndexType==SQLITE4_INDEX_PRIMARYKEY ){
     sqlite4StrAccumAppend(&errMsg, "PRIMARY KEY must be unique", -1);
   }else{
@@ -1356,7 +1356,7 @@ void sqlite4GenerateConstraintChecks(
         case OE_Rollback:
         case OE_Abort:
         case OE_Fail: {
-          char *zErr = notUniqueMessage(pParse, pIdx);
+          char *zErr = sqlite4NotUniqueMessage(pParse->db, pIdx);
           sqlite4HaltConstraint(pParse, onError, zErr, 0);
           sqlite4DbFree(pParse->db, zErr);
           break;
@@ -16,9 +16,33 @@
 ** calls.
 */
 #include "sqliteInt.h"
+#include "hwtime.h"
 
 #include <stdio.h>
 
+/*
+** Evaluate expression X and assign the result to rc.  If the thread is
+** running an EXPLAIN PROFILE or EXPLAIN ANALYZE statement, also add the
+** number of cycles taken to the statement's KVProfile and increment its
+** counter named by the third argument.
+*/
+#ifdef SQLITE4_TLS
+SQLITE4_TLS KVProfile *sqlite4KVProfile = 0;
+# define KVPROFILE(rc, X, nCall) do{                         \
+    KVProfile *pProf_ = sqlite4KVProfile;                     \
+    if( pProf_ ){                                             \
+      u64 tStart_ = sqlite4Hwtime();                          \
+      rc = X;                                                 \
+      pProf_->nCycle += sqlite4Hwtime() - tStart_;            \
+      pProf_->nCall++;                                        \
+    }else{                                                    \
+      rc = X;                                                 \
+    }                                                         \
+  }while(0)
+#else
+# define KVPROFILE(rc, X, nCall) rc = X
+#endif
+
 /*
 ** Names of error codes used for tracing.
 */
@@ -77,6 +101,1117 @@ static void kvTrace(KVStore *p, const char *zFormat, ...){
   }
 }
 
+/*
+** Hot-row cache.
+**
+** If a database is opened with a "rowcache=N" URI parameter, N greater
+** than zero, the store made by the factory is wrapped in a KVCache object
+** that remembers up to N rows found by exact-match (dir==0) seeks.  A
+** later exact-match seek for one of those keys is answered from memory
+** without calling into the storage engine, and the cursor then returns
+** the remembered key and value from xKey and xData.  All other calls are
+** passed through to the wrapped store.
+**
+** Cached rows are immutable and reference counted, so a cursor reading a
+** row keeps it alive after it has been evicted or replaced.  Only content
+** that no open write transaction of this connection has touched is
+** cached:
+**
+**   *  xReplace and xDelete drop any cached copy of the key.  Inside a
+**      write transaction they leave a marker (a row with nData<0) in its
+**      place, so that the key is neither served from nor added to the
+**      cache until the transaction ends.  If there is no room for a marker
+**      the cache is bypassed for the rest of the transaction instead.
+**
+**   *  The markers are removed when the write transaction commits or rolls
+**      back.  If the wrapped store fails to roll back, the cache is emptied.
+**
+**   *  Changes committed by other connections are detected using the
+**      SQLITE4_KVCTRL_DATA_VERSION op, which is checked before the cache is
+**      used.  If the wrapped store does not support that op, the cache is
+**      emptied each time a new read transaction is opened.
+**
+**   *  The data version is also read as each read transaction begins.  If
+**      another connection has committed since then, the transaction may be
+**      reading an older snapshot than the current version, so the cache is
+**      neither used nor filled until the next read transaction.
+**
+** Slots are reused according to the CLOCK algorithm.  Hits and misses are
+** reported by SQLITE4_DBSTATUS_CACHE_HIT and SQLITE4_DBSTATUS_CACHE_MISS.
+*/
+typedef struct KVCache KVCache;
+typedef struct KVCacheCursor KVCacheCursor;
+typedef struct KVCacheRow KVCacheRow;
+typedef struct KVCacheSlot KVCacheSlot;
+
+/*
+** A cached row.  The key is stored in a[], followed by the value.
+*/
+struct KVCacheRow {
+  int nRef;                 /* Number of references to this row */
+  KVSize nKey;              /* Size of the key in bytes */
+  KVSize nData;             /* Size of the value, or -1 for a marker */
+  KVByteArray a[8];         /* Key and value.  Extra space as necessary */
+};
+
+/*
+** A cache slot.  Slots that hold a row are linked into a hash chain.
+*/
+struct KVCacheSlot {
+  KVCacheRow *pRow;         /* The row, or NULL if this slot is free */
+  KVCacheSlot *pHashNext;   /* Next slot in the same hash chain */
+  u32 iHash;                /* Hash of the key */
+  u8 bRef;                  /* Set on each hit, cleared by the clock hand */
+};
+
+struct KVCache {
+  KVStore base;             /* Base class, must be first */
+  KVStore *pReal;           /* The wrapped store */
+  int nSlot;                /* Number of entries in aSlot[] */
+  int iHand;                /* Clock hand */
+  int nMarker;              /* Number of marker rows in the cache */
+  u8 bBypass;               /* Do not use the cache until the write ends */
+  u8 bVersion;              /* True if pReal supports DATA_VERSION */
+  u8 bSnapshot;             /* True if iSnapshot is valid */
+  u32 mHash;                /* Number of apHash[] entries minus one */
+  sqlite4_uint64 iVersion;  /* Data version the cached rows belong to */
+  sqlite4_uint64 iSnapshot; /* Data version when the read trans. began */
+  KVCacheSlot *aSlot;       /* Array of nSlot slots */
+  KVCacheSlot **apHash;     /* Hash table */
+  i64 nByte;                /* Heap memory used by cached rows */
+  i64 nHit;                 /* Seeks answered from the cache */
+  i64 nMiss;                /* Seeks passed through to pReal */
+};
+
+struct KVCacheCursor {
+  KVCursor base;            /* Base class, must be first */
+  KVCursor *pReal;          /* Cursor on the wrapped store */
+  KVCacheRow *pRow;         /* Row the cursor points to, or NULL */
+};
+
+static u32 kvcacheHash(const KVByteArray *a, KVSize n){
+  u32 h = 2166136261u;
+  KVSize i;
+  for(i=0; i<n; i++){
+    h = (h ^ a[i]) * 16777619u;
+  }
+  return h;
+}
+
+static KVCacheRow *kvcacheNewRow(
+  sqlite4_env *pEnv,
+  const KVByteArray *aKey, KVSize nKey,
+  const KVByteArray *aData, KVSize nData
+){
+  KVCacheRow *pRow;
+  pRow = sqlite4_malloc(pEnv, sizeof(*pRow) + nKey + (nData>0 ? nData : 0));
+  if( pRow ){
+    pRow->nRef = 1;
+    pRow->nKey = nKey;
+    pRow->nData = nData;
+    memcpy(pRow->a, aKey, nKey);
+    if( nData>0 ) memcpy(&pRow->a[nKey], aData, nData);
+  }
+  return pRow;
+}
+
+static void kvcacheUnrefRow(sqlite4_env *pEnv, KVCacheRow *pRow){
+  if( pRow && (--pRow->nRef)==0 ) sqlite4_free(pEnv, pRow);
+}
+
+/*
+** Return the slot holding key aKey/nKey, or NULL if there is none.
+*/
+static KVCacheSlot *kvcacheFind(
+  KVCache *p,
+  const KVByteArray *aKey, KVSize nKey,
+  u32 iHash
+){
+  KVCacheSlot *pSlot;
+  for(pSlot=p->apHash[iHash & p->mHash]; pSlot; pSlot=pSlot->pHashNext){
+    KVCacheRow *pRow = pSlot->pRow;
+    if( pSlot->iHash==iHash && pRow->nKey==nKey
+     && memcmp(pRow->a, aKey, nKey)==0
+    ){
+      return pSlot;
+    }
+  }
+  return 0;
+}
+
+/*
+** Drop the row held by pSlot and unlink the slot from its hash chain.
+*/
+static void kvcacheRemove(KVCache *p, KVCacheSlot *pSlot){
+  KVCacheSlot **pp = &p->apHash[pSlot->iHash & p->mHash];
+  KVCacheRow *pRow = pSlot->pRow;
+  while( *pp!=pSlot ) pp = &(*pp)->pHashNext;
+  *pp = pSlot->pHashNext;
+  if( pRow->nData<0 ){
+    p->nMarker--;
+  }else{
+    p->nByte -= sqlite4MallocSize(p->base.pEnv, pRow);
+  }
+  kvcacheUnrefRow(p->base.pEnv, pRow);
+  pSlot->pRow = 0;
+  pSlot->pHashNext = 0;
+}
+
+/*
+** Remove every row from the cache.  If this discards markers belonging
+** to the open write transaction, bypass the cache until it ends.
+*/
+static void kvcacheFlush(KVCache *p){
+  int i;
+  if( p->nMarker>0 ) p->bBypass = 1;
+  for(i=0; i<p->nSlot; i++){
+    if( p->aSlot[i].pRow ) kvcacheRemove(p, &p->aSlot[i]);
+  }
+}
+
+/*
+** Called when a write transaction ends.  Remove the markers and stop
+** bypassing the cache.
+*/
+static void kvcacheEndWrite(KVCache *p){
+  int i;
+  for(i=0; p->nMarker>0 && i<p->nSlot; i++){
+    KVCacheRow *pRow = p->aSlot[i].pRow;
+    if( pRow && pRow->nData<0 ) kvcacheRemove(p, &p->aSlot[i]);
+  }
+  p->bBypass = 0;
+}
+
+/*
+** Store pRow in a free slot, taking over the caller's reference.  Return
+** NULL, and leave pRow to the caller, if no slot can be found.
+**
+** The clock hand skips slots referenced since it last passed them and
+** never evicts a marker.
+*/
+static KVCacheSlot *kvcacheInsert(KVCache *p, KVCacheRow *pRow, u32 iHash){
+  KVCacheSlot *pSlot = 0;
+  int i;
+  for(i=0; i<2*p->nSlot; i++){
+    KVCacheSlot *pTry = &p->aSlot[p->iHand];
+    p->iHand = (p->iHand+1) % p->nSlot;
+    if( pTry->pRow==0 ){
+      pSlot = pTry;
+      break;
+    }
+    if( pTry->pRow->nData<0 ) continue;
+    if( pTry->bRef ){
+      pTry->bRef = 0;
+      continue;
+    }
+    kvcacheRemove(p, pTry);
+    pSlot = pTry;
+    break;
+  }
+  if( pSlot ){
+    pSlot->pRow = pRow;
+    pSlot->iHash = iHash;
+    pSlot->bRef = 0;
+    pSlot->pHashNext = p->apHash[iHash & p->mHash];
+    p->apHash[iHash & p->mHash] = pSlot;
+    if( pRow->nData<0 ){
+      p->nMarker++;
+    }else{
+      p->nByte += sqlite4MallocSize(p->base.pEnv, pRow);
+    }
+  }
+  return pSlot;
+}
+
+/*
+** Called before key aKey/nKey is written or deleted.
+*/
+static void kvcacheInvalidate(KVCache *p, const KVByteArray *aKey, KVSize nKey){
+  u32 iHash;
+  KVCacheSlot *pSlot;
+  KVCacheRow *pMarker;
+
+  if( p->bBypass ) return;
+  iHash = kvcacheHash(aKey, nKey);
+  pSlot = kvcacheFind(p, aKey, nKey, iHash);
+  if( pSlot ){
+    if( pSlot->pRow->nData<0 ) return;
+    kvcacheRemove(p, pSlot);
+  }
+  if( p->pReal->iTransLevel>=2 ){
+    pMarker = kvcacheNewRow(p->base.pEnv, aKey, nKey, 0, -1);
+    if( pMarker==0 || kvcacheInsert(p, pMarker, iHash)==0 ){
+      kvcacheUnrefRow(p->base.pEnv, pMarker);
+      p->bBypass = 1;
+    }
+  }
+}
+
+/*
+** Return true if the cache may be used.  Empty it first if another
+** connection has committed since its rows were read.  Return false if
+** another connection has committed since the current read transaction
+** began, as its snapshot may predate the rows that would be cached.
+*/
+static int kvcacheUsable(KVCache *p){
+  if( p->bBypass ) return 0;
+  if( p->bVersion ){
+    KVStore *pReal = p->pReal;
+    sqlite4_uint64 iVersion = 0;
+    if( pReal->pStoreVfunc->xControl(
+            pReal, SQLITE4_KVCTRL_DATA_VERSION, (void*)&iVersion)!=SQLITE4_OK
+    ){
+      return 0;
+    }
+    if( iVersion!=p->iVersion ){
+      kvcacheFlush(p);
+      p->iVersion = iVersion;
+    }
+    if( p->bSnapshot==0 || iVersion!=p->iSnapshot ) return 0;
+  }
+  return p->bBypass==0;
+}
+
+static void kvcacheReleaseRow(KVCacheCursor *pCur){
+  kvcacheUnrefRow(pCur->base.pEnv, pCur->pRow);
+  pCur->pRow = 0;
+}
+
+static int kvcacheReplace(
+  KVStore *pKVStore,
+  const KVByteArray *aKey, KVSize nKey,
+  const KVByteArray *aData, KVSize nData
+){
+  KVCache *p = (KVCache*)pKVStore;
+  KVStore *pReal = p->pReal;
+  kvcacheInvalidate(p, aKey, nKey);
+  return pReal->pStoreVfunc->xReplace(pReal, aKey, nKey, aData, nData);
+}
+
+static int kvcacheOpenCursor(KVStore *pKVStore, KVCursor **ppKVCursor){
+  KVCache *p = (KVCache*)pKVStore;
+  KVStore *pReal = p->pReal;
+  KVCacheCursor *pCur;
+  KVCursor *pRealCur = 0;
+  int rc;
+
+  *ppKVCursor = 0;
+  pCur = sqlite4_malloc(p->base.pEnv, sizeof(*pCur));
+  if( pCur==0 ) return SQLITE4_NOMEM;
+  memset(pCur, 0, sizeof(*pCur));
+  rc = pReal->pStoreVfunc->xOpenCursor(pReal, &pRealCur);
+  if( rc!=SQLITE4_OK ){
+    if( pRealCur ) pRealCur->pStoreVfunc->xCloseCursor(pRealCur);
+    sqlite4_free(p->base.pEnv, pCur);
+    return rc;
+  }
+  pRealCur->pStore = pReal;
+  pCur->base.pStore = pKVStore;
+  pCur->base.pStoreVfunc = pKVStore->pStoreVfunc;
+  pCur->base.pEnv = p->base.pEnv;
+  pCur->pReal = pRealCur;
+  *ppKVCursor = (KVCursor*)pCur;
+  return SQLITE4_OK;
+}
+
+static int kvcacheSeek(
+  KVCursor *pKVCursor,
+  const KVByteArray *aKey, KVSize nKey,
+  int dir
+){
+  KVCacheCursor *pCur = (KVCacheCursor*)pKVCursor;
+  KVCache *p = (KVCache*)pCur->base.pStore;
+  KVCursor *pReal = pCur->pReal;
+  KVCacheSlot *pSlot = 0;
+  u32 iHash = 0;
+  int bCache = 0;
+  int rc;
+
+  kvcacheReleaseRow(pCur);
+  if( dir==0 && kvcacheUsable(p) ){
+    iHash = kvcacheHash(aKey, nKey);
+    pSlot = kvcacheFind(p, aKey, nKey, iHash);
+    if( pSlot==0 ){
+      p->nMiss++;
+      bCache = 1;
+    }else if( pSlot->pRow->nData>=0 ){
+      p->nHit++;
+      pSlot->bRef = 1;
+      pCur->pRow = pSlot->pRow;
+      pCur->pRow->nRef++;
+      return SQLITE4_OK;
+    }
+  }
+
+  rc = pReal->pStoreVfunc->xSeek(pReal, aKey, nKey, dir);
+  if( rc==SQLITE4_OK && bCache ){
+    const KVByteArray *aData;
+    KVSize nData;
+    if( pReal->pStoreVfunc->xData(pReal, 0, -1, &aData, &nData)==SQLITE4_OK
+     && nKey+nData<=SQLITE4_MAX_ROWCACHE_ROW
+    ){
+      KVCacheRow *pRow = kvcacheNewRow(p->base.pEnv, aKey, nKey, aData, nData);
+      if( pRow && kvcacheInsert(p, pRow, iHash)==0 ){
+        kvcacheUnrefRow(p->base.pEnv, pRow);
+      }
+    }
+  }
+  return rc;
+}
+
+/*
+** Position the wrapped cursor on the row served from the cache, using
+** a seek in direction dir.  Return SQLITE4_INEXACT if the row is gone and
+** the cursor was left on a neighbour instead.
+*/
+static int kvcacheRestore(KVCacheCursor *pCur, int dir){
+  KVCursor *pReal = pCur->pReal;
+  KVCacheRow *pRow = pCur->pRow;
+  int rc = pReal->pStoreVfunc->xSeek(pReal, pRow->a, pRow->nKey, dir);
+  kvcacheReleaseRow(pCur);
+  return rc;
+}
+
+static int kvcacheNext(KVCursor *pKVCursor){
+  KVCacheCursor *pCur = (KVCacheCursor*)pKVCursor;
+  KVCursor *pReal = pCur->pReal;
+  if( pCur->pRow ){
+    int rc = kvcacheRestore(pCur, +1);
+    if( rc==SQLITE4_INEXACT ) return SQLITE4_OK;
+    if( rc!=SQLITE4_OK ) return rc;
+  }
+  return pReal->pStoreVfunc->xNext(pReal);
+}
+
+static int kvcachePrev(KVCursor *pKVCursor){
+  KVCacheCursor *pCur = (KVCacheCursor*)pKVCursor;
+  KVCursor *pReal = pCur->pReal;
+  if( pCur->pRow ){
+    int rc = kvcacheRestore(pCur, -1);
+    if( rc==SQLITE4_INEXACT ) return SQLITE4_OK;
+    if( rc!=SQLITE4_OK ) return rc;
+  }
+  return pReal->pStoreVfunc->xPrev(pReal);
+}
+
+static int kvcacheDelete(KVCursor *pKVCursor){
+  KVCacheCursor *pCur = (KVCacheCursor*)pKVCursor;
+  KVCache *p = (KVCache*)pCur->base.pStore;
+  KVCursor *pReal = pCur->pReal;
+  const KVByteArray *aKey;
+  KVSize nKey;
+  int rc;
+
+  if( pCur->pRow ){
+    rc = kvcacheRestore(pCur, 0);
+    if( rc!=SQLITE4_OK ) return rc;
+  }
+  rc = pReal->pStoreVfunc->xKey(pReal, &aKey, &nKey);
+  if( rc==SQLITE4_OK ){
+    kvcacheInvalidate(p, aKey, nKey);
+    rc = pReal->pStoreVfunc->xDelete(pReal);
+  }
+  return rc;
+}
+
+static int kvcacheKey(
+  KVCursor *pKVCursor,
+  const KVByteArray **paKey,
+  KVSize *pnKey
+){
+  KVCacheCursor *pCur = (KVCacheCursor*)pKVCursor;
+  KVCursor *pReal = pCur->pReal;
+  if( pCur->pRow ){
+    *paKey = pCur->pRow->a;
+    *pnKey = pCur->pRow->nKey;
+    return SQLITE4_OK;
+  }
+  return pReal->pStoreVfunc->xKey(pReal, paKey, pnKey);
+}
+
+static int kvcacheData(
+  KVCursor *pKVCursor,
+  KVSize ofst,
+  KVSize n,
+  const KVByteArray **paData,
+  KVSize *pnData
+){
+  KVCacheCursor *pCur = (KVCacheCursor*)pKVCursor;
+  KVCursor *pReal = pCur->pReal;
+  KVCacheRow *pRow = pCur->pRow;
+  if( pRow ){
+    if( ofst>pRow->nData ) ofst = pRow->nData;
+    *paData = &pRow->a[pRow->nKey + ofst];
+    *pnData = pRow->nData - ofst;
+    return SQLITE4_OK;
+  }
+  return pReal->pStoreVfunc->xData(pReal, ofst, n, paData, pnData);
+}
+
+static int kvcacheReset(KVCursor *pKVCursor){
+  KVCacheCursor *pCur = (KVCacheCursor*)pKVCursor;
+  KVCursor *pReal = pCur->pReal;
+  kvcacheReleaseRow(pCur);
+  return pReal->pStoreVfunc->xReset(pReal);
+}
+
+static int kvcacheCloseCursor(KVCursor *pKVCursor){
+  KVCacheCursor *pCur = (KVCacheCursor*)pKVCursor;
+  KVCursor *pReal = pCur->pReal;
+  int rc;
+  kvcacheReleaseRow(pCur);
+  rc = pReal->pStoreVfunc->xCloseCursor(pReal);
+  sqlite4_free(pCur->base.pEnv, pCur);
+  return rc;
+}
+
+static int kvcacheBegin(KVStore *pKVStore, int iLevel){
+  KVCache *p = (KVCache*)pKVStore;
+  KVStore *pReal = p->pReal;
+  int rc;
+  if( pReal->iTransLevel==0 ){
+    if( p->bVersion==0 ){
+      kvcacheFlush(p);
+    }else{
+      /* Read the version before the snapshot is taken, so that a commit
+      ** between the two makes iSnapshot look older, never newer. */
+      p->bSnapshot = (pReal->pStoreVfunc->xControl(
+          pReal, SQLITE4_KVCTRL_DATA_VERSION, (void*)&p->iSnapshot
+      )==SQLITE4_OK);
+    }
+  }
+  rc = pReal->pStoreVfunc->xBegin(pReal, iLevel);
+  p->base.iTransLevel = pReal->iTransLevel;
+  return rc;
+}
+
+static int kvcacheCommitPhaseOne(KVStore *pKVStore, int iLevel){
+  KVCache *p = (KVCache*)pKVStore;
+  KVStore *pReal = p->pReal;
+  int rc = SQLITE4_OK;
+  if( pReal->pStoreVfunc->xCommitPhaseOne ){
+    rc = pReal->pStoreVfunc->xCommitPhaseOne(pReal, iLevel);
+  }
+  return rc;
+}
+
+static int kvcacheCommitPhaseOneXID(KVStore *pKVStore, int iLevel, void *xid){
+  KVCache *p = (KVCache*)pKVStore;
+  KVStore *pReal = p->pReal;
+  int rc = SQLITE4_OK;
+  if( pReal->pStoreVfunc->xCommitPhaseOneXID ){
+    rc = pReal->pStoreVfunc->xCommitPhaseOneXID(pReal, iLevel, xid);
+  }
+  return rc;
+}
+
+static int kvcacheCommitPhaseTwo(KVStore *pKVStore, int iLevel){
+  KVCache *p = (KVCache*)pKVStore;
+  KVStore *pReal = p->pReal;
+  int rc;
+  rc = pReal->pStoreVfunc->xCommitPhaseTwo(pReal, iLevel);
+  p->base.iTransLevel = pReal->iTransLevel;
+  if( rc==SQLITE4_OK && iLevel<2 ) kvcacheEndWrite(p);
+  return rc;
+}
+
+static int kvcacheRollback(KVStore *pKVStore, int iLevel){
+  KVCache *p = (KVCache*)pKVStore;
+  KVStore *pReal = p->pReal;
+  int rc;
+  rc = pReal->pStoreVfunc->xRollback(pReal, iLevel);
+  p->base.iTransLevel = pReal->iTransLevel;
+  if( rc!=SQLITE4_OK ) kvcacheFlush(p);
+  if( pReal->iTransLevel<2 ) kvcacheEndWrite(p);
+  return rc;
+}
+
+static int kvcacheRevert(KVStore *pKVStore, int iLevel){
+  KVCache *p = (KVCache*)pKVStore;
+  KVStore *pReal = p->pReal;
+  int rc;
+  if( pReal->pStoreVfunc->xRevert ){
+    rc = pReal->pStoreVfunc->xRevert(pReal, iLevel);
+    p->base.iTransLevel = pReal->iTransLevel;
+    if( rc!=SQLITE4_OK ) kvcacheFlush(p);
+    if( iLevel<=2 || pReal->iTransLevel<2 ) kvcacheEndWrite(p);
+  }else{
+    rc = kvcacheRollback(pKVStore, iLevel-1);
+    if( rc==SQLITE4_OK ) rc = kvcacheBegin(pKVStore, iLevel);
+  }
+  return rc;
+}
+
+static int kvcacheClose(KVStore *pKVStore){
+  KVCache *p = (KVCache*)pKVStore;
+  KVStore *pReal = p->pReal;
+  sqlite4_env *pEnv = p->base.pEnv;
+  int rc;
+  kvcacheFlush(p);
+  rc = pReal->pStoreVfunc->xClose(pReal);
+  sqlite4_free(pEnv, p->aSlot);
+  sqlite4_free(pEnv, p->apHash);
+  sqlite4_free(pEnv, p);
+  return rc;
+}
+
+static int kvcacheControl(KVStore *pKVStore, int op, void *pArg){
+  KVStore *pReal = ((KVCache*)pKVStore)->pReal;
+  return pReal->pStoreVfunc->xControl(pReal, op, pArg);
+}
+
+static int kvcacheGetMeta(KVStore *pKVStore, unsigned int *piVal){
+  KVStore *pReal = ((KVCache*)pKVStore)->pReal;
+  return pReal->pStoreVfunc->xGetMeta(pReal, piVal);
+}
+
+static int kvcachePutMeta(KVStore *pKVStore, unsigned int iVal){
+  KVStore *pReal = ((KVCache*)pKVStore)->pReal;
+  return pReal->pStoreVfunc->xPutMeta(pReal, iVal);
+}
+
+static int kvcacheGetMethod(
+  KVStore *pKVStore,
+  const char *zMethod,
+  void **ppArg,
+  void (**pxFunc)(sqlite4_context *, int, sqlite4_value **),
+  void (**pxDestroy)(void *)
+){
+  KVStore *pReal = ((KVCache*)pKVStore)->pReal;
+  if( pReal->pStoreVfunc->xGetMethod==0 ) return SQLITE4_NOTFOUND;
+  return pReal->pStoreVfunc->xGetMethod(pReal, zMethod, ppArg, pxFunc, 
+                                        pxDestroy);
+}
+
+static const KVStoreMethods kvcacheMethods = {
+  1,                        /* iVersion */
+  sizeof(KVStoreMethods),   /* szSelf */
+  kvcacheReplace,           /* xReplace */
+  kvcacheOpenCursor,        /* xOpenCursor */
+  kvcacheSeek,              /* xSeek */
+  kvcacheNext,              /* xNext */
+  kvcachePrev,              /* xPrev */
+  kvcacheDelete,            /* xDelete */
+  kvcacheKey,               /* xKey */
+  kvcacheData,              /* xData */
+  kvcacheReset,             /* xReset */
+  kvcacheCloseCursor,       /* xCloseCursor */
+  kvcacheBegin,             /* xBegin */
+  kvcacheCommitPhaseOne,    /* xCommitPhaseOne */
+  kvcacheCommitPhaseOneXID, /* xCommitPhaseOneXID */
+  kvcacheCommitPhaseTwo,    /* xCommitPhaseTwo */
+  kvcacheRollback,          /* xRollback */
+  kvcacheRevert,            /* xRevert */
+  kvcacheClose,             /* xClose */
+  kvcacheControl,           /* xControl */
+  kvcacheGetMeta,           /* xGetMeta */
+  kvcachePutMeta,           /* xPutMeta */
+  kvcacheGetMethod          /* xGetMethod */
+};
+
+/*
+** Wrap store pReal in a hot-row cache of nRow rows.  The new store is
+** written to *ppKVStore.  If an error occurs, pReal is closed.
+*/
+static int kvcacheOpen(
+  sqlite4_env *pEnv,
+  KVStore *pReal,
+  i64 nRow,
+  KVStore **ppKVStore
+){
+  KVCache *p;
+  sqlite4_uint64 iVersion = 0;
+  u32 nHash = 64;
+
+  if( nRow>SQLITE4_MAX_ROWCACHE ) nRow = SQLITE4_MAX_ROWCACHE;
+  while( nHash<nRow ) nHash *= 2;
+  *ppKVStore = 0;
+  p = sqlite4_malloc(pEnv, sizeof(*p));
+  if( p ){
+    memset(p, 0, sizeof(*p));
+    p->aSlot = sqlite4_malloc(pEnv, sizeof(KVCacheSlot)*nRow);
+    p->apHash = sqlite4_malloc(pEnv, sizeof(KVCacheSlot*)*nHash);
+  }
+  if( p==0 || p->aSlot==0 || p->apHash==0 ){
+    if( p ){
+      sqlite4_free(pEnv, p->aSlot);
+      sqlite4_free(pEnv, p->apHash);
+      sqlite4_free(pEnv, p);
+    }
+    pReal->pStoreVfunc->xClose(pReal);
+    return SQLITE4_NOMEM;
+  }
+  memset(p->aSlot, 0, sizeof(KVCacheSlot)*nRow);
+  memset(p->apHash, 0, sizeof(KVCacheSlot*)*nHash);
+  p->base.pStoreVfunc = &kvcacheMethods;
+  p->base.pEnv = pEnv;
+  p->base.iTransLevel = pReal->iTransLevel;
+  p->pReal = pReal;
+  p->nSlot = (int)nRow;
+  p->mHash = nHash-1;
+  p->nByte = sizeof(*p) + sizeof(KVCacheSlot)*nRow + sizeof(KVCacheSlot*)*nHash;
+  if( pReal->pStoreVfunc->xControl(
+          pReal, SQLITE4_KVCTRL_DATA_VERSION, (void*)&iVersion)==SQLITE4_OK
+  ){
+    p->bVersion = 1;
+    p->iVersion = iVersion;
+  }
+  *ppKVStore = (KVStore*)p;
+  return SQLITE4_OK;
+}
+
+/*
+** Return the value of SQLITE4_DBSTATUS_CACHE_USED, _CACHE_HIT or
+** _CACHE_MISS for store p, or 0 if p has no hot-row cache.  If resetFlag
+** is true, the hit or miss counter is cleared.
+*/
+i64 sqlite4KVStoreCacheStatus(KVStore *p, int op, int resetFlag){
+  KVCache *pCache = (KVCache*)p;
+  i64 iVal = 0;
+  if( p && p->pStoreVfunc==&kvcacheMethods ){
+    switch( op ){
+      case SQLITE4_DBSTATUS_CACHE_USED:
+        iVal = pCache->nByte;
+        break;
+      case SQLITE4_DBSTATUS_CACHE_HIT:
+        iVal = pCache->nHit;
+        if( resetFlag ) pCache->nHit = 0;
+        break;
+      case SQLITE4_DBSTATUS_CACHE_MISS:
+        iVal = pCache->nMiss;
+        if( resetFlag ) pCache->nMiss = 0;
+        break;
+    }
+  }
+  return iVal;
+}
+
+/*
+** Seek batches.
+**
+** When the VDBE batches the seeks made by the inner loop of a join (see
+** OP_SeekBatch), the KV cursor of that loop is wrapped in a KVBatchCursor
+** and the keys the loop will seek for the next block of rows of the outer
+** loop are added to it with sqlite4KVCursorBatchAdd().  Then
+** sqlite4KVCursorBatchRun() sorts the keys and resolves them in key order
+** in a single sweep of the wrapped cursor, using the xSeekBatch method of
+** the store if it has one.  For each key, a copy is kept of the entries
+** that begin with the key, followed by the first entry that does not (the
+** one the VDBE reads to learn that it has left the range), up to
+** SQLITE4_MAX_SEEKBATCH_RUN entries.
+**
+** A later xSeek with a positive dir for one of the keys is answered from
+** the copy, as are xNext calls that stay within the entries copied for it.
+** Any other call first moves the wrapped cursor to the entry the batch
+** cursor points to.  The caller must discard the batch with
+** sqlite4KVCursorBatchClear() whenever the database may have changed
+** since it was filled.  An xDelete through the batch cursor discards it
+** automatically.
+*/
+typedef struct KVBatchCursor KVBatchCursor;
+typedef struct KVBatchProbe KVBatchProbe;
+typedef struct KVBatchRow KVBatchRow;
+typedef struct KVBatchSpace KVBatchSpace;
+
+/*
+** A growable buffer.  Objects in it are identified by their offsets, as
+** the buffer may move when it grows.
+*/
+struct KVBatchSpace {
+  KVByteArray *a;           /* The buffer */
+  int n;                    /* Bytes in use */
+  int nAlloc;               /* Allocated size of a[] */
+};
+
+/*
+** A key added to the batch, and the result of seeking for it.
+*/
+struct KVBatchProbe {
+  int iKey;                 /* Offset of the key in KVBatchCursor.sKey */
+  KVSize nKey;              /* Size of the key in bytes */
+  const KVByteArray *aKey;  /* The key, once the batch has been run */
+  int rc;                   /* Return code of the seek */
+  int iRow;                 /* Index of the first entry in aRow[] */
+  int nRow;                 /* Number of entries copied, or -1 if none */
+};
+
+/*
+** An entry copied by the sweep.  The value follows the key.
+*/
+struct KVBatchRow {
+  int iKey;                 /* Offset of the key in KVBatchCursor.sRow */
+  KVSize nKey;              /* Size of the key in bytes */
+  KVSize nData;             /* Size of the value in bytes */
+};
+
+struct KVBatchCursor {
+  KVCursor base;            /* Base class, must be first */
+  KVCursor *pReal;          /* The wrapped cursor */
+  int nProbe;               /* Number of keys in aProbe[] */
+  int nProbeAlloc;          /* Allocated size of aProbe[] */
+  KVBatchProbe *aProbe;     /* Keys added, sorted once the batch is run */
+  int nRow;                 /* Number of entries in aRow[] */
+  int nRowAlloc;            /* Allocated size of aRow[] */
+  KVBatchRow *aRow;         /* Entries copied by the sweep */
+  KVBatchSpace sKey;        /* Keys added to the batch */
+  KVBatchSpace sRow;        /* Keys and values of the entries copied */
+  u8 bReady;                /* True once the batch has been run */
+  KVBatchProbe *pProbe;     /* Key whose entries the cursor points to */
+  int iRow;                 /* Entry of aRow[] the cursor points to */
+};
+
+static const KVStoreMethods kvbatchMethods;
+
+/*
+** Append n bytes to buffer pSpace.  Return the offset at which they were
+** written, or -1 if a malloc fails.
+*/
+static int kvbatchAppend(
+  sqlite4_env *pEnv,
+  KVBatchSpace *pSpace,
+  const KVByteArray *a, KVSize n,
+  const KVByteArray *a2, KVSize n2
+){
+  int iOff = pSpace->n;
+  if( iOff+n+n2>pSpace->nAlloc ){
+    int nNew = pSpace->nAlloc ? pSpace->nAlloc*2 : 1024;
+    KVByteArray *aNew;
+    while( nNew<iOff+n+n2 ) nNew *= 2;
+    aNew = sqlite4_realloc(pEnv, pSpace->a, nNew);
+    if( aNew==0 ) return -1;
+    pSpace->a = aNew;
+    pSpace->nAlloc = nNew;
+  }
+  memcpy(&pSpace->a[iOff], a, n);
+  if( n2>0 ) memcpy(&pSpace->a[iOff+n], a2, n2);
+  pSpace->n = iOff+n+n2;
+  return iOff;
+}
+
+static int kvbatchCompare(const void *pA, const void *pB){
+  const KVBatchProbe *p1 = (const KVBatchProbe*)pA;
+  const KVBatchProbe *p2 = (const KVBatchProbe*)pB;
+  int c = memcmp(p1->aKey, p2->aKey, p1->nKey<p2->nKey ? p1->nKey : p2->nKey);
+  if( c==0 ) c = p1->nKey - p2->nKey;
+  return c;
+}
+
+/*
+** Return the probe for key aKey/nKey, or NULL if there is none.
+*/
+static KVBatchProbe *kvbatchFind(
+  KVBatchCursor *p,
+  const KVByteArray *aKey, KVSize nKey
+){
+  KVBatchProbe sKey;
+  sKey.aKey = aKey;
+  sKey.nKey = nKey;
+  return (KVBatchProbe*)bsearch(
+      &sKey, p->aProbe, p->nProbe, sizeof(KVBatchProbe), kvbatchCompare
+  );
+}
+
+/*
+** Called by the sweep after each seek.  Copy the entries for the key.
+*/
+static int kvbatchVisit(void *pCtx, int iProbe, int rc){
+  KVBatchCursor *p = (KVBatchCursor*)pCtx;
+  KVBatchProbe *pProbe = &p->aProbe[iProbe];
+  KVCursor *pReal = p->pReal;
+  const KVStoreMethods *pMethods = pReal->pStoreVfunc;
+
+  pProbe->rc = rc;
+  pProbe->iRow = p->nRow;
+  pProbe->nRow = 0;
+  while( rc==SQLITE4_OK || rc==SQLITE4_INEXACT ){
+    const KVByteArray *aKey;
+    const KVByteArray *aData;
+    KVSize nKey;
+    KVSize nData;
+    KVBatchRow *pRow;
+
+    if( pProbe->nRow==SQLITE4_MAX_SEEKBATCH_RUN ) break;
+    rc = pMethods->xKey(pReal, &aKey, &nKey);
+    if( rc==SQLITE4_OK ) rc = pMethods->xData(pReal, 0, -1, &aData, &nData);
+    if( rc!=SQLITE4_OK ) return rc;
+    if( nKey+nData>SQLITE4_MAX_SEEKBATCH_ROW ) break;
+    if( p->nRow==p->nRowAlloc ){
+      int nNew = p->nRowAlloc ? p->nRowAlloc*2 : 64;
+      KVBatchRow *aNew;
+      aNew = sqlite4_realloc(p->base.pEnv, p->aRow, nNew*sizeof(KVBatchRow));
+      if( aNew==0 ) return SQLITE4_NOMEM;
+      p->aRow = aNew;
+      p->nRowAlloc = nNew;
+    }
+    pRow = &p->aRow[p->nRow];
+    pRow->iKey = kvbatchAppend(p->base.pEnv, &p->sRow, aKey, nKey, aData, nData);
+    if( pRow->iKey<0 ) return SQLITE4_NOMEM;
+    pRow->nKey = nKey;
+    pRow->nData = nData;
+    p->nRow++;
+    pProbe->nRow++;
+    if( nKey<pProbe->nKey || memcmp(aKey, pProbe->aKey, pProbe->nKey) ) break;
+    rc = pMethods->xNext(pReal);
+  }
+
+  /* An entry too large to copy.  Seeks for this key are passed through. */
+  if( pProbe->nRow==0 && rc!=SQLITE4_NOTFOUND ) pProbe->nRow = -1;
+  return (rc==SQLITE4_NOTFOUND || rc==SQLITE4_INEXACT) ? SQLITE4_OK : rc;
+}
+
+/*
+** Empty the batch of cursor p.  This is a no-op if p is not a batch cursor.
+*/
+void sqlite4KVCursorBatchClear(KVCursor *pKVCursor){
+  if( pKVCursor && pKVCursor->pStoreVfunc==&kvbatchMethods ){
+    KVBatchCursor *p = (KVBatchCursor*)pKVCursor;
+    p->nProbe = 0;
+    p->nRow = 0;
+    p->sKey.n = 0;
+    p->sRow.n = 0;
+    p->bReady = 0;
+    p->pProbe = 0;
+  }
+}
+
+/*
+** Add key aKey/nKey to the batch of the cursor *pp.  If the cursor is not
+** already a batch cursor, it is first wrapped in one and *pp set to point
+** to the wrapper.  If the batch has already been run, it is emptied
+** before the key is added.
+*/
+int sqlite4KVCursorBatchAdd(
+  KVCursor **pp,
+  const KVByteArray *aKey,
+  KVSize nKey
+){
+  KVBatchCursor *p;
+  KVBatchProbe *pProbe;
+
+  if( (*pp)->pStoreVfunc!=&kvbatchMethods ){
+    KVCursor *pReal = *pp;
+    p = sqlite4_malloc(pReal->pEnv, sizeof(*p));
+    if( p==0 ) return SQLITE4_NOMEM;
+    memset(p, 0, sizeof(*p));
+    p->base = *pReal;
+    p->base.pStoreVfunc = &kvbatchMethods;
+    p->pReal = pReal;
+    *pp = (KVCursor*)p;
+  }
+  p = (KVBatchCursor*)*pp;
+  if( p->bReady ) sqlite4KVCursorBatchClear(*pp);
+  if( p->nProbe==p->nProbeAlloc ){
+    int nNew = p->nProbeAlloc ? p->nProbeAlloc*2 : 64;
+    KVBatchProbe *aNew;
+    aNew = sqlite4_realloc(p->base.pEnv, p->aProbe, nNew*sizeof(KVBatchProbe));
+    if( aNew==0 ) return SQLITE4_NOMEM;
+    p->aProbe = aNew;
+    p->nProbeAlloc = nNew;
+  }
+  pProbe = &p->aProbe[p->nProbe];
+  memset(pProbe, 0, sizeof(*pProbe));
+  pProbe->iKey = kvbatchAppend(p->base.pEnv, &p->sKey, aKey, nKey, 0, 0);
+  if( pProbe->iKey<0 ) return SQLITE4_NOMEM;
+  pProbe->nKey = nKey;
+  p->nProbe++;
+  return SQLITE4_OK;
+}
+
+/*
+** Sort the keys added to the batch of cursor pKVCursor, drop duplicates
+** and seek for each in key order.  This is a no-op if pKVCursor is not a
+** batch cursor.  If an error occurs, the batch is emptied.
+*/
+int sqlite4KVCursorBatchRun(KVCursor *pKVCursor){
+  KVBatchCursor *p = (KVBatchCursor*)pKVCursor;
+  const KVByteArray **apKey;
+  KVSize *anKey;
+  int rc = SQLITE4_OK;
+  int i, j;
+
+  if( pKVCursor->pStoreVfunc!=&kvbatchMethods || p->bReady ) return rc;
+  for(i=0; i<p->nProbe; i++){
+    p->aProbe[i].aKey = &p->sKey.a[p->aProbe[i].iKey];
+  }
+  qsort(p->aProbe, p->nProbe, sizeof(KVBatchProbe), kvbatchCompare);
+  for(i=j=0; i<p->nProbe; i++){
+    if( j==0 || kvbatchCompare(&p->aProbe[j-1], &p->aProbe[i]) ){
+      p->aProbe[j++] = p->aProbe[i];
+    }
+  }
+  p->nProbe = j;
+
+  apKey = sqlite4_malloc(p->base.pEnv,
+      (sizeof(KVByteArray*) + sizeof(KVSize)) * (p->nProbe+1)
+  );
+  if( apKey==0 ){
+    rc = SQLITE4_NOMEM;
+  }else{
+    anKey = (KVSize*)&apKey[p->nProbe+1];
+    for(i=0; i<p->nProbe; i++){
+      apKey[i] = p->aProbe[i].aKey;
+      anKey[i] = p->aProbe[i].nKey;
+    }
+    rc = sqlite4KVCursorSeekBatch(p->pReal, p->nProbe,
+        (const KVByteArray *const*)apKey, anKey, kvbatchVisit, (void*)p
+    );
+    sqlite4_free(p->base.pEnv, apKey);
+  }
+  if( rc==SQLITE4_OK ){
+    p->bReady = 1;
+  }else{
+    sqlite4KVCursorBatchClear(pKVCursor);
+  }
+  return rc;
+}
+
+/*
+** Position the wrapped cursor on the entry the batch cursor points to,
+** using a seek in direction dir.  Return SQLITE4_INEXACT if the entry is
+** gone and the cursor was left on a neighbour instead.
+*/
+static int kvbatchRestore(KVBatchCursor *p, int dir){
+  KVCursor *pReal = p->pReal;
+  KVBatchRow *pRow = &p->aRow[p->iRow];
+  p->pProbe = 0;
+  return pReal->pStoreVfunc->xSeek(pReal, &p->sRow.a[pRow->iKey],
+                                   pRow->nKey, dir);
+}
+
+static int kvbatchSeek(
+  KVCursor *pKVCursor,
+  const KVByteArray *aKey, KVSize nKey,
+  int dir
+){
+  KVBatchCursor *p = (KVBatchCursor*)pKVCursor;
+  KVCursor *pReal = p->pReal;
+  p->pProbe = 0;
+  if( dir>0 && p->bReady ){
+    KVBatchProbe *pProbe = kvbatchFind(p, aKey, nKey);
+    if( pProbe && pProbe->nRow>=0 ){
+      if( pProbe->rc!=SQLITE4_NOTFOUND ){
+        p->pProbe = pProbe;
+        p->iRow = pProbe->iRow;
+      }
+      return pProbe->rc;
+    }
+  }
+  return pReal->pStoreVfunc->xSeek(pReal, aKey, nKey, dir);
+}
+
+static int kvbatchNext(KVCursor *pKVCursor){
+  KVBatchCursor *p = (KVBatchCursor*)pKVCursor;
+  KVCursor *pReal = p->pReal;
+  KVBatchProbe *pProbe = p->pProbe;
+  if( pProbe ){
+    int rc;
+    if( p->iRow+1<pProbe->iRow+pProbe->nRow ){
+      p->iRow++;
+      return SQLITE4_OK;
+    }
+    rc = kvbatchRestore(p, +1);
+    if( rc==SQLITE4_INEXACT ) return SQLITE4_OK;
+    if( rc!=SQLITE4_OK ) return rc;
+  }
+  return pReal->pStoreVfunc->xNext(pReal);
+}
+
+static int kvbatchPrev(KVCursor *pKVCursor){
+  KVBatchCursor *p = (KVBatchCursor*)pKVCursor;
+  KVCursor *pReal = p->pReal;
+  if( p->pProbe ){
+    int rc = kvbatchRestore(p, -1);
+    if( rc==SQLITE4_INEXACT ) return SQLITE4_OK;
+    if( rc!=SQLITE4_OK ) return rc;
+  }
+  return pReal->pStoreVfunc->xPrev(pReal);
+}
+
+static int kvbatchDelete(KVCursor *pKVCursor){
+  KVBatchCursor *p = (KVBatchCursor*)pKVCursor;
+  KVCursor *pReal = p->pReal;
+  int rc = SQLITE4_OK;
+  if( p->pProbe ) rc = kvbatchRestore(p, 0);
+  sqlite4KVCursorBatchClear(pKVCursor);
+  if( rc==SQLITE4_OK ) rc = pReal->pStoreVfunc->xDelete(pReal);
+  return rc;
+}
+
+static int kvbatchKey(
+  KVCursor *pKVCursor,
+  const KVByteArray **paKey,
+  KVSize *pnKey
+){
+  KVBatchCursor *p = (KVBatchCursor*)pKVCursor;
+  KVCursor *pReal = p->pReal;
+  if( p->pProbe ){
+    KVBatchRow *pRow = &p->aRow[p->iRow];
+    *paKey = &p->sRow.a[pRow->iKey];
+    *pnKey = pRow->nKey;
+    return SQLITE4_OK;
+  }
+  return pReal->pStoreVfunc->xKey(pReal, paKey, pnKey);
+}
+
+static int kvbatchData(
+  KVCursor *pKVCursor,
+  KVSize ofst,
+  KVSize n,
+  const KVByteArray **paData,
+  KVSize *pnData
+){
+  KVBatchCursor *p = (KVBatchCursor*)pKVCursor;
+  KVCursor *pReal = p->pReal;
+  if( p->pProbe ){
+    KVBatchRow *pRow = &p->aRow[p->iRow];
+    if( ofst>pRow->nData ) ofst = pRow->nData;
+    *paData = &p->sRow.a[pRow->iKey + pRow->nKey + ofst];
+    *pnData = pRow->nData - ofst;
+    return SQLITE4_OK;
+  }
+  return pReal->pStoreVfunc->xData(pReal, ofst, n, paData, pnData);
+}
+
+static int kvbatchReset(KVCursor *pKVCursor){
+  KVBatchCursor *p = (KVBatchCursor*)pKVCursor;
+  KVCursor *pReal = p->pReal;
+  p->pProbe = 0;
+  return pReal->pStoreVfunc->xReset(pReal);
+}
+
+static int kvbatchCloseCursor(KVCursor *pKVCursor){
+  KVBatchCursor *p = (KVBatchCursor*)pKVCursor;
+  KVCursor *pReal = p->pReal;
+  sqlite4_env *pEnv = p->base.pEnv;
+  int rc;
+  rc = pReal->pStoreVfunc->xCloseCursor(pReal);
+  sqlite4_free(pEnv, p->aProbe);
+  sqlite4_free(pEnv, p->aRow);
+  sqlite4_free(pEnv, p->sKey.a);
+  sqlite4_free(pEnv, p->sRow.a);
+  sqlite4_free(pEnv, p);
+  return rc;
+}
+
+/*
+** Only the cursor methods are used.  The store methods of a batch cursor
+** are never called, as its pStore is the store of the wrapped cursor.
+*/
+static const KVStoreMethods kvbatchMethods = {
+  1,                        /* iVersion */
+  sizeof(KVStoreMethods),   /* szSelf */
+  0,                        /* xReplace */
+  0,                        /* xOpenCursor */
+  kvbatchSeek,              /* xSeek */
+  kvbatchNext,              /* xNext */
+  kvbatchPrev,              /* xPrev */
+  kvbatchDelete,            /* xDelete */
+  kvbatchKey,               /* xKey */
+  kvbatchData,              /* xData */
+  kvbatchReset,             /* xReset */
+  kvbatchCloseCursor,       /* xCloseCursor */
+};
+
 /*
 ** Open a storage engine via URI
 */
@@ -107,15 +1242,24 @@ int sqlite4KVStoreOpen(
     }
   }
   *ppKVStore = 0;
-  sqlite4_mutex_enter(pEnv->pFactoryMutex);
-  for(pMkr=pEnv->pFactory; pMkr && strcmp(zStorageName,pMkr->zName);
-      pMkr=pMkr->pNext){}
+
+  /* The factory list is read without pFactoryMutex so that concurrent
+  ** opens do not serialize.  See the comments above KVFactory. */
+  pMkr = (KVFactory*)SQLITE4_ATOMIC_LOAD_PTR(&pEnv->pFactory);
+  while( pMkr && strcmp(zStorageName, pMkr->zName) ){
+    pMkr = (KVFactory*)SQLITE4_ATOMIC_LOAD_PTR(&pMkr->pNext);
+  }
   xFactory = pMkr ? pMkr->xFactory : 0;
-  sqlite4_mutex_leave(pEnv->pFactoryMutex);
   if( xFactory==0 ){
     return SQLITE4_ERROR;
   }
   rc = xFactory(pEnv, &pNew, zUri, flags);
+  if( rc==SQLITE4_OK && pNew
+   && (flags & (SQLITE4_KVOPEN_TEMPORARY|SQLITE4_KVOPEN_NO_TRANSACTIONS))==0
+  ){
+    i64 nRowCache = sqlite4_uri_int64(zUri, "rowcache", 0);
+    if( nRowCache>0 ) rc = kvcacheOpen(pEnv, pNew, nRowCache, &pNew);
+  }
   *ppKVStore = pNew;
   if( pNew ){
     sqlite4_randomness(pEnv, sizeof(pNew->kvId), &pNew->kvId);
@@ -147,6 +1291,7 @@ int sqlite4KVStoreReplace(
   const KVByteArray *pKey, KVSize nKey,
   const KVByteArray *pData, KVSize nData
 ){
+  int rc;
   if( p->fTrace ){
     char zKey[52], zData[52];
     binToHex(zKey, sizeof(zKey), pKey, nKey);
@@ -154,7 +1299,8 @@ int sqlite4KVStoreReplace(
     kvTrace(p, "xReplace(%d,%s,%d,%s,%d)",
            p->kvId, zKey, (int)nKey, zData, (int)nData);
   }
-  return p->pStoreVfunc->xReplace(p,pKey,nKey,pData,nData);
+  KVPROFILE(rc, p->pStoreVfunc->xReplace(p,pKey,nKey,pData,nData), nOther);
+  return rc;
 }
 int sqlite4KVStoreOpenCursor(KVStore *p, KVCursor **ppKVCursor){
   KVCursor *pCur;
@@ -178,7 +1324,7 @@ int sqlite4KVCursorSeek(
 ){
   int rc;
   assert( dir==0 || dir==(+1) || dir==(-1) || dir==(-2) );  
-  rc = p->pStoreVfunc->xSeek(p,pKey,nKey,dir);
+  KVPROFILE(rc, p->pStoreVfunc->xSeek(p,pKey,nKey,dir), nSeek);
   if( p->fTrace ){
     char zKey[52];
     binToHex(zKey, sizeof(zKey), pKey, nKey);
@@ -189,19 +1335,19 @@ int sqlite4KVCursorSeek(
 }
 int sqlite4KVCursorNext(KVCursor *p){
   int rc;
-  rc = p->pStoreVfunc->xNext(p);
+  KVPROFILE(rc, p->pStoreVfunc->xNext(p), nNext);
   kvTrace(p->pStore, "xNext(%d) -> %s", p->curId, kvErrName(rc));
   return rc;
 }
 int sqlite4KVCursorPrev(KVCursor *p){
   int rc;
-  rc = p->pStoreVfunc->xPrev(p);
+  KVPROFILE(rc, p->pStoreVfunc->xPrev(p), nNext);
   kvTrace(p->pStore, "xPrev(%d) -> %s", p->curId, kvErrName(rc));
   return rc;
 }
 int sqlite4KVCursorDelete(KVCursor *p){
   int rc;
-  rc = p->pStoreVfunc->xDelete(p);
+  KVPROFILE(rc, p->pStoreVfunc->xDelete(p), nOther);
   kvTrace(p->pStore, "xDelete(%d) -> %s", p->curId, kvErrName(rc));
   return rc;
 }
@@ -213,7 +1359,7 @@ int sqlite4KVCursorReset(KVCursor *p){
 }
 int sqlite4KVCursorKey(KVCursor *p, const KVByteArray **ppKey, KVSize *pnKey){
   int rc;
-  rc = p->pStoreVfunc->xKey(p, ppKey, pnKey);
+  KVPROFILE(rc, p->pStoreVfunc->xKey(p, ppKey, pnKey), nOther);
   if( p->fTrace ){
     if( rc==SQLITE4_OK ){
       char zKey[52];
@@ -233,7 +1379,7 @@ int sqlite4KVCursorData(
   KVSize *pnData
 ){
   int rc;
-  rc = p->pStoreVfunc->xData(p, ofst, n, ppData, pnData);
+  KVPROFILE(rc, p->pStoreVfunc->xData(p, ofst, n, ppData, pnData), nOther);
   if( p->fTrace ){
     if( rc==SQLITE4_OK ){
       char zData[52];
@@ -257,6 +1403,33 @@ int sqlite4KVCursorClose(KVCursor *p){
   }
   return rc;
 }
+int sqlite4KVCursorSeekBatch(
+  KVCursor *p,
+  int nProbe,
+  const KVByteArray *const *apKey,
+  const KVSize *anKey,
+  int (*xVisit)(void*, int, int),
+  void *pCtx
+){
+  const KVStoreMethods *pMethods = p->pStoreVfunc;
+  int rc = SQLITE4_OK;
+  int i;
+  if( pMethods->iVersion>=2 && pMethods->xSeekBatch ){
+    KVPROFILE(rc,
+        pMethods->xSeekBatch(p, nProbe, apKey, anKey, xVisit, pCtx), nSeek
+    );
+  }else{
+    for(i=0; rc==SQLITE4_OK && i<nProbe; i++){
+      KVPROFILE(rc, pMethods->xSeek(p, apKey[i], anKey[i], +1), nSeek);
+      if( rc==SQLITE4_OK || rc==SQLITE4_INEXACT || rc==SQLITE4_NOTFOUND ){
+        rc = xVisit(pCtx, i, rc);
+      }
+    }
+  }
+  kvTrace(p->pStore, "xSeekBatch(%d,%d) -> %s",
+          p->curId, nProbe, kvErrName(rc));
+  return rc;
+}
 int sqlite4KVStoreBegin(KVStore *p, int iLevel){
   //printf("---->sqlite4KVStoreBegin(%p, %d), kvId=%d\n", p, iLevel, p->kvId);
   
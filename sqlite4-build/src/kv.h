@@ -122,6 +122,17 @@
 ** functioning normally, including responding correctly to subsequent
 ** xNext and xPrev calls.
 ** 
+** The optional xSeekBatch method, present in version 2 and later of the
+** method table, moves a cursor to each of nProbe keys in turn as if by an
+** xSeek with a positive dir, and invokes the xVisit callback after each
+** seek with the index of the key and the return code the xSeek would have
+** produced.  The keys are passed in ascending order, so a search may start
+** from the position the previous one reached instead of from the root.
+** xVisit may read the entry with xKey and xData and move the cursor with
+** xNext.  If xVisit returns anything other than SQLITE4_OK, xSeekBatch
+** stops and returns that value.  If a store does not implement xSeekBatch,
+** each key is sought using xSeek instead.
+** 
 ** The xGetMethod method allows a key-value store to implement custom PRAGMA 
 ** commands, or override existing built-in PRAGMAs. Each time the user prepares
 ** a PRAGMA statement, the xGetMethod method of the corresponding key-value
@@ -160,6 +171,32 @@ typedef sqlite4_kvsize KVSize;
 
 int sqlite4OpenBtree(sqlite4_env*, KVStore**, const char *, unsigned);
 int sqlite4KVStoreOpenMem(sqlite4_env*, KVStore**, const char *, unsigned);
+
+/* Write-ahead log and snapshots for the in-memory store (kvmemlog.c) */
+typedef struct KVMemLog KVMemLog;
+int sqlite4KVMemLogOpen(sqlite4_env*, const char *zUri, KVMemLog**);
+int sqlite4KVMemLogSnapshotOpen(KVMemLog*, sqlite4_int64*, unsigned int*);
+int sqlite4KVMemLogSnapshotRead(KVMemLog*,
+    const KVByteArray**, KVSize*, const KVByteArray**, KVSize*);
+void sqlite4KVMemLogSnapshotClose(KVMemLog*);
+int sqlite4KVMemLogReplay(KVMemLog*, void*,
+    int(*)(void*,const KVByteArray*,KVSize,const KVByteArray*,KVSize),
+    unsigned int*);
+int sqlite4KVMemLogAppend(KVMemLog*,
+    const KVByteArray*, KVSize, const KVByteArray*, KVSize);
+void sqlite4KVMemLogAbort(KVMemLog*);
+int sqlite4KVMemLogCommit(KVMemLog*, unsigned int iMeta);
+int sqlite4KVMemLogWantSnapshot(KVMemLog*);
+int sqlite4KVMemLogSnapshotBegin(KVMemLog*, sqlite4_int64 nEntry);
+int sqlite4KVMemLogSnapshotWrite(KVMemLog*,
+    const KVByteArray*, KVSize, const KVByteArray*, KVSize);
+int sqlite4KVMemLogSnapshotEnd(KVMemLog*, int rc);
+int sqlite4KVMemLogSynchronous(KVMemLog*, int eSync);
+int sqlite4KVMemLogClose(KVMemLog*);
+
+/* Read-only store served from a memory-mapped sorted file (kvmap.c) */
+int sqlite4KVStoreOpenMap(sqlite4_env*, KVStore**, const char *, unsigned);
+int sqlite4KVMapWrite(KVStore*, const char *zFile);
 int sqlite4KVStoreOpenBdb(sqlite4_env*, KVStore**, const char *, unsigned);
 int sqlite4KVStoreOpenBdbMem(sqlite4_env*, KVStore**, const char *, unsigned);
 //int sqlite4KVStoreOpenLsm(sqlite4_env*, KVStore**, const char *, unsigned);
@@ -194,6 +231,17 @@ int sqlite4KVCursorData(
   KVSize *pnData
 );
 int sqlite4KVCursorClose(KVCursor *p);
+int sqlite4KVCursorSeekBatch(
+  KVCursor *p,
+  int nProbe,
+  const KVByteArray *const *apKey,
+  const KVSize *anKey,
+  int (*xVisit)(void*, int, int),
+  void *pCtx
+);
+int sqlite4KVCursorBatchAdd(KVCursor **pp, const KVByteArray*, KVSize);
+int sqlite4KVCursorBatchRun(KVCursor *p);
+void sqlite4KVCursorBatchClear(KVCursor *p);
 int sqlite4KVStoreBegin(KVStore *p, int iLevel);
 int sqlite4KVStoreCommitPhaseOne(KVStore *p, int iLevel);
 int sqlite4KVStoreCommitPhaseOneXID(KVStore *p, int iLevel, void * xid);
@@ -209,6 +257,25 @@ int sqlite4KVStorePutMeta(sqlite4*, KVStore *p, int, int, unsigned int*);
 int sqlite4KVStorePutSchema(KVStore *p, unsigned int iVal);
 int sqlite4KVStoreGetSchema(KVStore *p, unsigned int *piVal);
 
+i64 sqlite4KVStoreCacheStatus(KVStore *p, int op, int resetFlag);
+
 #ifdef SQLITE4_DEBUG
   void sqlite4KVStoreDump(KVStore *p);
 #endif
+
+/*
+** While sqlite4KVProfile is not NULL, the wrappers around the xReplace,
+** xSeek, xNext, xPrev, xDelete, xKey and xData methods add the number of
+** cycles spent in each call and the number of calls made to the object it
+** points to.  Used by EXPLAIN PROFILE and EXPLAIN ANALYZE.
+*/
+typedef struct KVProfile KVProfile;
+struct KVProfile {
+  u64 nCycle;             /* Cycles spent in KV store calls */
+  u64 nSeek;              /* Number of xSeek calls */
+  u64 nNext;              /* Number of xNext and xPrev calls */
+  u64 nOther;             /* Number of other calls */
+};
+#ifdef SQLITE4_TLS
+extern SQLITE4_TLS KVProfile *sqlite4KVProfile;
+#endif
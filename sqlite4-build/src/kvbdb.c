@@ -191,6 +191,7 @@ int init_bdb_dict(bdb_dict_t ** a_bdb_dict_pp)
               free((void*)pNew);
               return SQLITE4_NOMEM;
            }
+           sqlite4MutexTag(pNewMutex, "kvbdb.dict");
            pNew->mutexp = pNewMutex;
 		}
 		
@@ -323,6 +324,7 @@ bdb_dict_node_t * acquire_locked_dict_node
           return NULL;
        }
        // assign the new mutex to new node
+       sqlite4MutexTag(pNewMutex, "kvbdb.node");
        pNew->mutexp = pNewMutex;
 	}
     
@@ -3727,6 +3729,7 @@ int sqlite4KVStoreOpenBdb(
 	    //printf("Error creating s_env_mutexp: %s\n", db_strerror(ret));
         return SQLITE4_ERROR;
       } 
+      sqlite4MutexTag(mutexp, "kvbdb.env");
       s_env_mutexp = mutexp;      
     }
     //printf("----------> s_env_mutexp == %p\n", s_env_mutexp);
@@ -3743,6 +3746,7 @@ int sqlite4KVStoreOpenBdb(
 	    //printf("Error creating s_db_mutexp: %s\n", db_strerror(ret));
         return SQLITE4_ERROR;
       } 
+      sqlite4MutexTag(mutexp, "kvbdb.db");
       s_db_mutexp = mutexp;      
     }
     //printf("----------> s_db_mutexp == %p\n", s_db_mutexp);
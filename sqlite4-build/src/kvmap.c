@@ -0,0 +1,870 @@
+/*
+** 2026 October 19
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file implements a read-only key/value store that serves a sorted
+** file through a memory mapping.  It is meant for large, static reference
+** data: opening the store only maps the file, whatever its size, and the
+** pages read are shared through the page cache by every process that has
+** the same file open.
+**
+** The store is selected with the "kv=map" URI parameter, for example
+** "file:rates.db?kv=map".  The file is written from the content of any
+** other store using SQLITE4_KVCTRL_MAP_WRITE.  Any attempt to write to
+** the store fails with SQLITE4_READONLY.
+**
+** The file starts with a 64-byte header:
+**
+**     8 bytes    magic string "KVMAPFIL"
+**     4 bytes    version number
+**     4 bytes    meta value (see xPutMeta)
+**     8 bytes    number of entries
+**     8 bytes    offset of the block index
+**     4 bytes    number of blocks
+**     4 bytes    reserved
+**     8 bytes    size of the file
+**    12 bytes    reserved
+**     8 bytes    checksum of the preceding 56 bytes
+**
+** Entries follow the header in key order, grouped into blocks of about
+** KVMAP_BLOCKSIZE bytes.  Each entry is:
+**
+**     varint nPrefix, varint nSuffix, varint nData, suffix, data
+**
+** where the key is the first nPrefix bytes of the previous key in the
+** same block followed by the nSuffix bytes of suffix.  nPrefix is 0 for
+** the first entry of a block.  The block index follows the last block.
+** It holds a 16-byte record for each block, an 8-byte offset of the block
+** in the file, the 4-byte offset of its first key within the area that
+** follows the records and the 4-byte size of that key, followed by the
+** first keys themselves.  Fixed-size integers are big-endian.
+**
+** A seek binary-searches the first keys of the block index and then scans
+** a single block.  Values are returned as pointers into the mapping.  Keys
+** are rebuilt in a buffer owned by the cursor, as prefix compression means
+** that they are not stored whole.
+*/
+#include "sqliteInt.h"
+
+#include <stdio.h>
+
+#if SQLITE4_OS_WIN
+# include <windows.h>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#define KVMAP_VERSION        1
+#define KVMAP_HDRSIZE       64     /* Size of the file header */
+#define KVMAP_IDXRECORD     16     /* Size of a block index record */
+#define KVMAP_BLOCKSIZE   4096     /* Target size of a block */
+
+/* Forward declarations of object names */
+typedef struct KVMap KVMap;
+typedef struct KVMapCursor KVMapCursor;
+
+/*
+** An open sorted file.
+*/
+struct KVMap {
+  KVStore base;               /* Base class, must be first */
+  const u8 *aMap;             /* The mapping of the whole file */
+  i64 nMap;                   /* Size of aMap[] in bytes */
+  unsigned int iMeta;         /* Meta value from the file header */
+  int nBlock;                 /* Number of blocks */
+  const u8 *aIndex;           /* Block index records */
+  const u8 *aFirst;           /* First keys of the blocks */
+  i64 nFirst;                 /* Size of aFirst[] in bytes */
+  i64 iIndex;                 /* Offset of the block index (end of data) */
+#if SQLITE4_OS_WIN
+  HANDLE hMap;                /* File mapping object */
+#endif
+};
+
+/*
+** A cursor open on a KVMap.  If iBlock is negative, the cursor does not
+** point to an entry.
+*/
+struct KVMapCursor {
+  KVCursor base;              /* Base class, must be first */
+  KVMap *pMap;                /* The store this cursor belongs to */
+  int iBlock;                 /* Block holding the current entry, or -1 */
+  i64 iEntry;                 /* Offset of the current entry */
+  i64 iNext;                  /* Offset of the entry that follows it */
+  KVByteArray *aKey;          /* Key of the current entry */
+  KVSize nKey;                /* Size of aKey[] in bytes */
+  KVSize nKeyAlloc;           /* Allocated size of aKey[] */
+  const KVByteArray *aData;   /* Value of the current entry, in the mapping */
+  KVSize nData;               /* Size of aData[] in bytes */
+};
+
+/*
+** Read and write fixed-size big-endian integers.
+*/
+static void kvmapPut32(u8 *a, u32 v){
+  a[0] = (u8)(v>>24);
+  a[1] = (u8)(v>>16);
+  a[2] = (u8)(v>>8);
+  a[3] = (u8)v;
+}
+static u32 kvmapGet32(const u8 *a){
+  return ((u32)a[0]<<24) | ((u32)a[1]<<16) | ((u32)a[2]<<8) | (u32)a[3];
+}
+static void kvmapPut64(u8 *a, u64 v){
+  kvmapPut32(a, (u32)(v>>32));
+  kvmapPut32(&a[4], (u32)v);
+}
+static u64 kvmapGet64(const u8 *a){
+  return ((u64)kvmapGet32(a)<<32) | kvmapGet32(&a[4]);
+}
+
+/*
+** Compute the checksum of the first 56 bytes of a file header.
+*/
+static u64 kvmapChecksum(const u8 *a){
+  u32 s1 = 1;
+  u32 s2 = 0;
+  int i;
+  for(i=0; i<KVMAP_HDRSIZE-8; i+=4){
+    s1 += kvmapGet32(&a[i]);
+    s2 += s1;
+  }
+  return ((u64)s1<<32) | s2;
+}
+
+/*
+** Compare two keys in the same way as memcmp(), shorter keys sorting
+** before longer keys that they are a prefix of.
+*/
+static int kvmapKeyCompare(
+  const KVByteArray *aKey1, KVSize nKey1,
+  const KVByteArray *aKey2, KVSize nKey2
+){
+  int c = memcmp(aKey1, aKey2, nKey1<nKey2 ? nKey1 : nKey2);
+  if( c==0 ) c = (nKey1<nKey2) ? -1 : (nKey1>nKey2);
+  return c;
+}
+
+/*
+** Return the offset of block iBlock, or of the end of the block.
+*/
+static i64 kvmapBlockStart(KVMap *p, int iBlock){
+  return (i64)kvmapGet64(&p->aIndex[iBlock*KVMAP_IDXRECORD]);
+}
+static i64 kvmapBlockEnd(KVMap *p, int iBlock){
+  return iBlock+1<p->nBlock ? kvmapBlockStart(p, iBlock+1) : p->iIndex;
+}
+
+/*
+** Move cursor pCur to the entry at offset iOff of block iBlock.  Unless
+** iOff is the start of the block, the cursor must point to the entry
+** that precedes it.
+*/
+static int kvmapDecode(KVMapCursor *pCur, int iBlock, i64 iOff){
+  KVMap *p = pCur->pMap;
+  i64 iEnd = kvmapBlockEnd(p, iBlock);
+  sqlite4_uint64 nPrefix, nSuffix, nData;
+  const u8 *a = &p->aMap[iOff];
+  int nMax = (int)(iEnd-iOff < 27 ? iEnd-iOff : 27);
+  int n, i = 0;
+
+  n = sqlite4GetVarint64(&a[i], nMax-i, &nPrefix);
+  i += n;
+  if( n ){ n = sqlite4GetVarint64(&a[i], nMax-i, &nSuffix); i += n; }
+  if( n ){ n = sqlite4GetVarint64(&a[i], nMax-i, &nData); i += n; }
+  if( n==0
+   || nPrefix>(sqlite4_uint64)pCur->nKey
+   || nSuffix+nData>(sqlite4_uint64)(iEnd-iOff-i)
+   || (iOff==kvmapBlockStart(p, iBlock) && nPrefix!=0)
+  ){
+    pCur->iBlock = -1;
+    return SQLITE4_CORRUPT;
+  }
+  if( nPrefix+nSuffix>(sqlite4_uint64)pCur->nKeyAlloc ){
+    KVSize nNew = (KVSize)(nPrefix+nSuffix)*2 + 64;
+    KVByteArray *aNew = sqlite4_realloc(pCur->base.pEnv, pCur->aKey, nNew);
+    if( aNew==0 ){
+      pCur->iBlock = -1;
+      return SQLITE4_NOMEM;
+    }
+    pCur->aKey = aNew;
+    pCur->nKeyAlloc = nNew;
+  }
+  memcpy(&pCur->aKey[nPrefix], &a[i], (size_t)nSuffix);
+  pCur->nKey = (KVSize)(nPrefix+nSuffix);
+  pCur->aData = &a[i+nSuffix];
+  pCur->nData = (KVSize)nData;
+  pCur->iBlock = iBlock;
+  pCur->iEntry = iOff;
+  pCur->iNext = iOff + i + nSuffix + nData;
+  return SQLITE4_OK;
+}
+
+/*
+** Move cursor pCur to the first entry of block iBlock.
+*/
+static int kvmapFirst(KVMapCursor *pCur, int iBlock){
+  pCur->nKey = 0;
+  return kvmapDecode(pCur, iBlock, kvmapBlockStart(pCur->pMap, iBlock));
+}
+
+/*
+** Move cursor pCur to the entry of block iBlock that is followed by the
+** entry at offset iNext (or by the end of the block).  The block is
+** decoded from its start, as each key depends on the one before.
+*/
+static int kvmapSeekBefore(KVMapCursor *pCur, int iBlock, i64 iNext){
+  int rc = kvmapFirst(pCur, iBlock);
+  while( rc==SQLITE4_OK && pCur->iNext<iNext ){
+    rc = kvmapDecode(pCur, iBlock, pCur->iNext);
+  }
+  return rc;
+}
+
+/*
+** Create a new cursor object.
+*/
+static int kvmapOpenCursor(KVStore *pKVStore, KVCursor **ppKVCursor){
+  KVMap *p = (KVMap*)pKVStore;
+  KVMapCursor *pCur;
+  pCur = sqlite4_malloc(p->base.pEnv, sizeof(*pCur));
+  if( pCur==0 ){
+    *ppKVCursor = 0;
+    return SQLITE4_NOMEM;
+  }
+  memset(pCur, 0, sizeof(*pCur));
+  pCur->pMap = p;
+  pCur->iBlock = -1;
+  pCur->base.pStore = pKVStore;
+  pCur->base.pStoreVfunc = pKVStore->pStoreVfunc;
+  pCur->base.pEnv = p->base.pEnv;
+  *ppKVCursor = (KVCursor*)pCur;
+  return SQLITE4_OK;
+}
+
+/*
+** Reset a cursor
+*/
+static int kvmapReset(KVCursor *pKVCursor){
+  KVMapCursor *pCur = (KVMapCursor*)pKVCursor;
+  pCur->iBlock = -1;
+  return SQLITE4_OK;
+}
+
+/*
+** Destroy a cursor object
+*/
+static int kvmapCloseCursor(KVCursor *pKVCursor){
+  KVMapCursor *pCur = (KVMapCursor*)pKVCursor;
+  if( pCur ){
+    sqlite4_env *pEnv = pCur->base.pEnv;
+    sqlite4_free(pEnv, pCur->aKey);
+    sqlite4_free(pEnv, pCur);
+  }
+  return SQLITE4_OK;
+}
+
+/*
+** Search for the entry with key aKey[0..nKey-1], or if there is none, the
+** entry before it (dir<0) or after it (dir>0).  The return values are as
+** for the xSeek method of any other store.
+*/
+static int kvmapSeek(
+  KVCursor *pKVCursor,
+  const KVByteArray *aKey,
+  KVSize nKey,
+  int dir
+){
+  KVMapCursor *pCur = (KVMapCursor*)pKVCursor;
+  KVMap *p = pCur->pMap;
+  int iLo = 0;
+  int iHi = p->nBlock-1;
+  int iBlock = -1;
+  i64 iLast = -1;              /* Offset of last entry less than aKey */
+  i64 iEnd;
+  int rc;
+
+  pCur->iBlock = -1;
+  if( p->nBlock==0 ) return SQLITE4_NOTFOUND;
+
+  /* Find the last block whose first key is not greater than aKey */
+  while( iLo<=iHi ){
+    int iMid = (iLo+iHi)/2;
+    const u8 *aRec = &p->aIndex[iMid*KVMAP_IDXRECORD];
+    int c = kvmapKeyCompare(&p->aFirst[kvmapGet32(&aRec[8])],
+                            kvmapGet32(&aRec[12]), aKey, nKey);
+    if( c<=0 ){
+      iBlock = iMid;
+      iLo = iMid+1;
+    }else{
+      iHi = iMid-1;
+    }
+  }
+  if( iBlock<0 ){
+    if( dir<=0 ) return SQLITE4_NOTFOUND;
+    rc = kvmapFirst(pCur, 0);
+    return rc==SQLITE4_OK ? SQLITE4_INEXACT : rc;
+  }
+
+  /* Scan the block */
+  iEnd = kvmapBlockEnd(p, iBlock);
+  rc = kvmapFirst(pCur, iBlock);
+  while( rc==SQLITE4_OK ){
+    int c = kvmapKeyCompare(pCur->aKey, pCur->nKey, aKey, nKey);
+    if( c==0 ) return SQLITE4_OK;
+    if( c>0 ){
+      if( dir>0 ) return SQLITE4_INEXACT;
+      if( dir==0 || iLast<0 ){
+        pCur->iBlock = -1;
+        return SQLITE4_NOTFOUND;
+      }
+      rc = kvmapSeekBefore(pCur, iBlock, pCur->iEntry);
+      return rc==SQLITE4_OK ? SQLITE4_INEXACT : rc;
+    }
+    iLast = pCur->iEntry;
+    if( pCur->iNext>=iEnd ) break;
+    rc = kvmapDecode(pCur, iBlock, pCur->iNext);
+  }
+  if( rc!=SQLITE4_OK ) return rc;
+
+  /* Every key in the block is less than aKey */
+  if( dir<0 ) return SQLITE4_INEXACT;
+  if( dir>0 && iBlock+1<p->nBlock ){
+    rc = kvmapFirst(pCur, iBlock+1);
+    return rc==SQLITE4_OK ? SQLITE4_INEXACT : rc;
+  }
+  pCur->iBlock = -1;
+  return SQLITE4_NOTFOUND;
+}
+
+/*
+** Move a cursor to the next entry.
+*/
+static int kvmapNextEntry(KVCursor *pKVCursor){
+  KVMapCursor *pCur = (KVMapCursor*)pKVCursor;
+  KVMap *p = pCur->pMap;
+  int iBlock = pCur->iBlock;
+  if( iBlock<0 ) return SQLITE4_NOTFOUND;
+  if( pCur->iNext<kvmapBlockEnd(p, iBlock) ){
+    return kvmapDecode(pCur, iBlock, pCur->iNext);
+  }
+  if( iBlock+1<p->nBlock ) return kvmapFirst(pCur, iBlock+1);
+  pCur->iBlock = -1;
+  return SQLITE4_NOTFOUND;
+}
+
+/*
+** Move a cursor to the previous entry.
+*/
+static int kvmapPrevEntry(KVCursor *pKVCursor){
+  KVMapCursor *pCur = (KVMapCursor*)pKVCursor;
+  KVMap *p = pCur->pMap;
+  int iBlock = pCur->iBlock;
+  if( iBlock<0 ) return SQLITE4_NOTFOUND;
+  if( pCur->iEntry>kvmapBlockStart(p, iBlock) ){
+    return kvmapSeekBefore(pCur, iBlock, pCur->iEntry);
+  }
+  if( iBlock>0 ){
+    return kvmapSeekBefore(pCur, iBlock-1, kvmapBlockEnd(p, iBlock-1));
+  }
+  pCur->iBlock = -1;
+  return SQLITE4_NOTFOUND;
+}
+
+/*
+** Return the key of the entry the cursor is pointing to.
+*/
+static int kvmapKey(
+  KVCursor *pKVCursor,         /* The cursor whose key is desired */
+  const KVByteArray **paKey,   /* Make this point to the key */
+  KVSize *pN                   /* Make this point to the size of the key */
+){
+  KVMapCursor *pCur = (KVMapCursor*)pKVCursor;
+  if( pCur->iBlock<0 ){
+    *paKey = 0;
+    *pN = 0;
+    return SQLITE4_DONE;
+  }
+  *paKey = pCur->aKey;
+  *pN = pCur->nKey;
+  return SQLITE4_OK;
+}
+
+/*
+** Return the data of the entry the cursor is pointing to.
+*/
+static int kvmapData(
+  KVCursor *pKVCursor,         /* The cursor from which to take the data */
+  KVSize ofst,                 /* Offset into the data to begin reading */
+  KVSize n,                    /* Number of bytes requested */
+  const KVByteArray **paData,  /* Pointer to the data written here */
+  KVSize *pNData               /* Number of bytes delivered */
+){
+  KVMapCursor *pCur = (KVMapCursor*)pKVCursor;
+  if( pCur->iBlock<0 ){
+    *paData = 0;
+    *pNData = 0;
+    return SQLITE4_DONE;
+  }
+  if( ofst>pCur->nData ) ofst = pCur->nData;
+  *paData = pCur->aData + ofst;
+  *pNData = pCur->nData - ofst;
+  return SQLITE4_OK;
+}
+
+/*
+** The store cannot be written.
+*/
+static int kvmapReplace(
+  KVStore *pKVStore,
+  const KVByteArray *aKey, KVSize nKey,
+  const KVByteArray *aData, KVSize nData
+){
+  return SQLITE4_READONLY;
+}
+static int kvmapDelete(KVCursor *pKVCursor){
+  return SQLITE4_READONLY;
+}
+static int kvmapPutMeta(KVStore *pKVStore, unsigned int iVal){
+  return SQLITE4_READONLY;
+}
+
+/*
+** Only read transactions (level 1) may be opened.  As the content never
+** changes, committing or rolling back just sets the transaction level.
+*/
+static int kvmapBegin(KVStore *pKVStore, int iLevel){
+  if( iLevel>=2 ) return SQLITE4_READONLY;
+  pKVStore->iTransLevel = iLevel;
+  return SQLITE4_OK;
+}
+static int kvmapCommitPhaseOne(KVStore *pKVStore, int iLevel){
+  return SQLITE4_OK;
+}
+static int kvmapCommitPhaseOneXID(KVStore *pKVStore, int iLevel, void *xid){
+  return SQLITE4_OK;
+}
+static int kvmapCommitPhaseTwo(KVStore *pKVStore, int iLevel){
+  pKVStore->iTransLevel = iLevel;
+  return SQLITE4_OK;
+}
+static int kvmapRollback(KVStore *pKVStore, int iLevel){
+  pKVStore->iTransLevel = iLevel;
+  return SQLITE4_OK;
+}
+static int kvmapRevert(KVStore *pKVStore, int iLevel){
+  return SQLITE4_OK;
+}
+
+/*
+** Unmap the file and free the store.
+*/
+static int kvmapClose(KVStore *pKVStore){
+  KVMap *p = (KVMap*)pKVStore;
+  if( p==0 ) return SQLITE4_OK;
+#if SQLITE4_OS_WIN
+  if( p->aMap ) UnmapViewOfFile((LPCVOID)p->aMap);
+  if( p->hMap ) CloseHandle(p->hMap);
+#else
+  if( p->aMap ) munmap((void*)p->aMap, (size_t)p->nMap);
+#endif
+  sqlite4_free(p->base.pEnv, p);
+  return SQLITE4_OK;
+}
+
+/*
+** The content never changes, so SQLITE4_KVCTRL_DATA_VERSION always
+** reports the same version.
+*/
+static int kvmapControl(KVStore *pKVStore, int op, void *pArg){
+  if( op==SQLITE4_KVCTRL_DATA_VERSION ){
+    *(sqlite4_uint64*)pArg = 0;
+    return SQLITE4_OK;
+  }
+  return SQLITE4_NOTFOUND;
+}
+
+static int kvmapGetMeta(KVStore *pKVStore, unsigned int *piVal){
+  KVMap *p = (KVMap*)pKVStore;
+  *piVal = p->iMeta;
+  return SQLITE4_OK;
+}
+
+/* Virtual methods for the sorted-file storage engine */
+static const KVStoreMethods kvmapMethods = {
+  1,                        /* iVersion */
+  sizeof(KVStoreMethods),   /* szSelf */
+  kvmapReplace,             /* xReplace */
+  kvmapOpenCursor,          /* xOpenCursor */
+  kvmapSeek,                /* xSeek */
+  kvmapNextEntry,           /* xNext */
+  kvmapPrevEntry,           /* xPrev */
+  kvmapDelete,              /* xDelete */
+  kvmapKey,                 /* xKey */
+  kvmapData,                /* xData */
+  kvmapReset,               /* xReset */
+  kvmapCloseCursor,         /* xCloseCursor */
+  kvmapBegin,               /* xBegin */
+  kvmapCommitPhaseOne,      /* xCommitPhaseOne */
+  kvmapCommitPhaseOneXID,   /* xCommitPhaseOneXID */
+  kvmapCommitPhaseTwo,      /* xCommitPhaseTwo */
+  kvmapRollback,            /* xRollback */
+  kvmapRevert,              /* xRevert */
+  kvmapClose,               /* xClose */
+  kvmapControl,             /* xControl */
+  kvmapGetMeta,             /* xGetMeta */
+  kvmapPutMeta,             /* xPutMeta */
+  0                         /* xGetMethod */
+};
+
+/*
+** Map the whole of file zFile into memory, read-only.
+*/
+static int kvmapMapFile(KVMap *p, const char *zFile){
+#if SQLITE4_OS_WIN
+  HANDLE h;
+  LARGE_INTEGER sz;
+  int rc = SQLITE4_OK;
+  h = CreateFileA(zFile, GENERIC_READ, FILE_SHARE_READ|FILE_SHARE_DELETE, 0,
+                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+  if( h==INVALID_HANDLE_VALUE ) return SQLITE4_CANTOPEN;
+  if( !GetFileSizeEx(h, &sz) ){
+    rc = SQLITE4_IOERR;
+  }else if( sz.QuadPart<KVMAP_HDRSIZE ){
+    rc = SQLITE4_NOTADB;
+  }else{
+    p->nMap = sz.QuadPart;
+    p->hMap = CreateFileMappingA(h, 0, PAGE_READONLY, 0, 0, 0);
+    if( p->hMap==0 ) rc = SQLITE4_IOERR;
+  }
+  if( rc==SQLITE4_OK ){
+    p->aMap = (const u8*)MapViewOfFile(p->hMap, FILE_MAP_READ, 0, 0, 0);
+    if( p->aMap==0 ) rc = SQLITE4_IOERR;
+  }
+  CloseHandle(h);
+  return rc;
+#else
+  struct stat st;
+  void *pMap;
+  int fd;
+  int rc = SQLITE4_OK;
+  fd = open(zFile, O_RDONLY);
+  if( fd<0 ) return SQLITE4_CANTOPEN;
+  if( fstat(fd, &st) ){
+    rc = SQLITE4_IOERR;
+  }else if( st.st_size<KVMAP_HDRSIZE ){
+    rc = SQLITE4_NOTADB;
+  }else{
+    pMap = mmap(0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if( pMap==MAP_FAILED ){
+      rc = SQLITE4_IOERR;
+    }else{
+      p->aMap = (const u8*)pMap;
+      p->nMap = (i64)st.st_size;
+    }
+  }
+  close(fd);
+  return rc;
+#endif
+}
+
+/*
+** Check the file header and locate the block index.  Each record of the
+** index is checked too: block offsets must start at the end of the header,
+** increase strictly and lie before the index, and each first key must lie
+** within the file.  Otherwise SQLITE4_CORRUPT is returned, as cursors
+** trust these values when they decode a block.
+*/
+static int kvmapReadHeader(KVMap *p){
+  const u8 *aHdr = p->aMap;
+  i64 nEnd;
+  i64 iPrev;
+  int i;
+  if( memcmp(aHdr, "KVMAPFIL", 8)
+   || kvmapGet32(&aHdr[8])!=KVMAP_VERSION
+   || kvmapGet64(&aHdr[56])!=kvmapChecksum(aHdr)
+   || (i64)kvmapGet64(&aHdr[40])!=p->nMap
+  ){
+    return SQLITE4_NOTADB;
+  }
+  p->iMeta = kvmapGet32(&aHdr[12]);
+  p->iIndex = (i64)kvmapGet64(&aHdr[24]);
+  p->nBlock = (int)kvmapGet32(&aHdr[32]);
+  if( p->iIndex<KVMAP_HDRSIZE || p->iIndex>p->nMap || p->nBlock<0 ){
+    return SQLITE4_CORRUPT;
+  }
+  nEnd = p->iIndex + (i64)p->nBlock*KVMAP_IDXRECORD;
+  if( nEnd>p->nMap ) return SQLITE4_CORRUPT;
+  p->aIndex = &p->aMap[p->iIndex];
+  p->aFirst = &p->aMap[nEnd];
+  p->nFirst = p->nMap - nEnd;
+  iPrev = KVMAP_HDRSIZE-1;
+  for(i=0; i<p->nBlock; i++){
+    const u8 *aRec = &p->aIndex[i*KVMAP_IDXRECORD];
+    i64 iStart = (i64)kvmapGet64(aRec);
+    if( (i==0 && iStart!=KVMAP_HDRSIZE)
+     || iStart<=iPrev
+     || iStart>=p->iIndex
+     || (i64)kvmapGet32(&aRec[8])+kvmapGet32(&aRec[12])>p->nFirst
+    ){
+      return SQLITE4_CORRUPT;
+    }
+    iPrev = iStart;
+  }
+  return SQLITE4_OK;
+}
+
+/*
+** Open the sorted file named by URI filename zName and return a new
+** store that serves its content.
+*/
+int sqlite4KVStoreOpenMap(
+  sqlite4_env *pEnv,              /* Runtime environment */
+  KVStore **ppKVStore,            /* OUT: Write the new KVStore here */
+  const char *zName,              /* Name of the file */
+  unsigned openFlags              /* Flags */
+){
+  KVMap *pNew;
+  int rc;
+
+  *ppKVStore = 0;
+  if( zName==0 || zName[0]==0 ) return SQLITE4_CANTOPEN;
+  pNew = sqlite4_malloc(pEnv, sizeof(*pNew));
+  if( pNew==0 ) return SQLITE4_NOMEM;
+  memset(pNew, 0, sizeof(*pNew));
+  pNew->base.pStoreVfunc = &kvmapMethods;
+  pNew->base.pEnv = pEnv;
+  rc = kvmapMapFile(pNew, zName);
+  if( rc==SQLITE4_OK ) rc = kvmapReadHeader(pNew);
+  if( rc!=SQLITE4_OK ){
+    kvmapClose((KVStore*)pNew);
+    return rc;
+  }
+  *ppKVStore = (KVStore*)pNew;
+  return SQLITE4_OK;
+}
+
+/*
+** State of the writer used by sqlite4KVMapWrite().
+*/
+typedef struct KVMapWriter KVMapWriter;
+struct KVMapWriter {
+  sqlite4_env *pEnv;          /* Run-time environment */
+  FILE *pFile;                /* File being written */
+  i64 iOff;                   /* Bytes written to pFile so far */
+  i64 iBlock;                 /* Offset of the current block */
+  u8 *aPrev;                  /* Previous key written to the current block */
+  KVSize nPrev;               /* Size of aPrev[] in bytes */
+  KVSize nPrevAlloc;          /* Allocated size of aPrev[] */
+  u8 *aIndex;                 /* Block index records */
+  int nBlock;                 /* Number of records in aIndex[] */
+  int nBlockAlloc;            /* Allocated records in aIndex[] */
+  u8 *aFirst;                 /* First keys of the blocks */
+  i64 nFirst;                 /* Size of aFirst[] in bytes */
+  i64 nFirstAlloc;            /* Allocated size of aFirst[] */
+};
+
+/*
+** Write n bytes to the file.
+*/
+static int kvmapWrite(KVMapWriter *w, const void *a, i64 n){
+  if( n>0 && fwrite(a, 1, (size_t)n, w->pFile)!=(size_t)n ){
+    return SQLITE4_IOERR;
+  }
+  w->iOff += n;
+  return SQLITE4_OK;
+}
+
+/*
+** Start a new block whose first key is aKey/nKey.
+*/
+static int kvmapWriterNewBlock(KVMapWriter *w, const u8 *aKey, KVSize nKey){
+  u8 *aRec;
+  if( w->nBlock==w->nBlockAlloc ){
+    int nNew = w->nBlockAlloc ? w->nBlockAlloc*2 : 256;
+    u8 *aNew = sqlite4_realloc(w->pEnv, w->aIndex, nNew*KVMAP_IDXRECORD);
+    if( aNew==0 ) return SQLITE4_NOMEM;
+    w->aIndex = aNew;
+    w->nBlockAlloc = nNew;
+  }
+  if( w->nFirst+nKey>w->nFirstAlloc ){
+    i64 nNew = w->nFirstAlloc ? w->nFirstAlloc*2 : 16384;
+    u8 *aNew;
+    while( nNew<w->nFirst+nKey ) nNew *= 2;
+    if( nNew>0xffffffff ) return SQLITE4_TOOBIG;
+    aNew = sqlite4_realloc(w->pEnv, w->aFirst, (int)nNew);
+    if( aNew==0 ) return SQLITE4_NOMEM;
+    w->aFirst = aNew;
+    w->nFirstAlloc = nNew;
+  }
+  aRec = &w->aIndex[w->nBlock*KVMAP_IDXRECORD];
+  kvmapPut64(aRec, (u64)w->iOff);
+  kvmapPut32(&aRec[8], (u32)w->nFirst);
+  kvmapPut32(&aRec[12], (u32)nKey);
+  memcpy(&w->aFirst[w->nFirst], aKey, nKey);
+  w->nFirst += nKey;
+  w->nBlock++;
+  w->iBlock = w->iOff;
+  w->nPrev = 0;
+  return SQLITE4_OK;
+}
+
+/*
+** Append an entry to the file.
+*/
+static int kvmapWriterAdd(
+  KVMapWriter *w,
+  const u8 *aKey, KVSize nKey,
+  const u8 *aData, KVSize nData
+){
+  u8 aHdr[27];
+  int nHdr;
+  KVSize nPrefix = 0;
+  int rc = SQLITE4_OK;
+
+  if( w->nBlock==0 || w->iOff-w->iBlock>=KVMAP_BLOCKSIZE ){
+    rc = kvmapWriterNewBlock(w, aKey, nKey);
+  }else{
+    while( nPrefix<nKey && nPrefix<w->nPrev && aKey[nPrefix]==w->aPrev[nPrefix] ){
+      nPrefix++;
+    }
+  }
+  if( rc==SQLITE4_OK && nKey>w->nPrevAlloc ){
+    KVSize nNew = nKey*2 + 64;
+    u8 *aNew = sqlite4_realloc(w->pEnv, w->aPrev, nNew);
+    if( aNew==0 ) return SQLITE4_NOMEM;
+    w->aPrev = aNew;
+    w->nPrevAlloc = nNew;
+  }
+  if( rc==SQLITE4_OK ){
+    nHdr = sqlite4PutVarint64(aHdr, nPrefix);
+    nHdr += sqlite4PutVarint64(&aHdr[nHdr], nKey-nPrefix);
+    nHdr += sqlite4PutVarint64(&aHdr[nHdr], nData);
+    rc = kvmapWrite(w, aHdr, nHdr);
+  }
+  if( rc==SQLITE4_OK ) rc = kvmapWrite(w, &aKey[nPrefix], nKey-nPrefix);
+  if( rc==SQLITE4_OK ) rc = kvmapWrite(w, aData, nData);
+  if( rc==SQLITE4_OK ){
+    memcpy(&w->aPrev[nPrefix], &aKey[nPrefix], nKey-nPrefix);
+    w->nPrev = nKey;
+  }
+  return rc;
+}
+
+/*
+** Write the entire content of store pSrc to file zFile in the format read
+** by sqlite4KVStoreOpenMap().  The file is written under a temporary name
+** and renamed into place once complete, so processes that have the old
+** file open keep reading it.
+*/
+int sqlite4KVMapWrite(KVStore *pSrc, const char *zFile){
+  sqlite4_env *pEnv = pSrc->pEnv;
+  KVMapWriter w;
+  KVCursor *pCur = 0;
+  char *zTmp;
+  unsigned int iMeta = 0;
+  i64 nEntry = 0;
+  int bTrans = 0;
+  int rc;
+
+  memset(&w, 0, sizeof(w));
+  w.pEnv = pEnv;
+  zTmp = sqlite4_mprintf(pEnv, "%s-tmp", zFile);
+  if( zTmp==0 ) return SQLITE4_NOMEM;
+  w.pFile = fopen(zTmp, "wb");
+  if( w.pFile==0 ){
+    sqlite4_free(pEnv, zTmp);
+    return SQLITE4_CANTOPEN;
+  }
+
+  /* Leave room for the header, which is written last */
+  {
+    u8 aZero[KVMAP_HDRSIZE];
+    memset(aZero, 0, sizeof(aZero));
+    rc = kvmapWrite(&w, aZero, KVMAP_HDRSIZE);
+  }
+
+  /* Copy every entry of pSrc, in key order, within a read transaction */
+  if( rc==SQLITE4_OK && pSrc->iTransLevel==0 ){
+    rc = sqlite4KVStoreBegin(pSrc, 1);
+    bTrans = (rc==SQLITE4_OK);
+  }
+  if( rc==SQLITE4_OK && pSrc->pStoreVfunc->xGetMeta ){
+    rc = pSrc->pStoreVfunc->xGetMeta(pSrc, &iMeta);
+  }
+  if( rc==SQLITE4_OK ) rc = sqlite4KVStoreOpenCursor(pSrc, &pCur);
+  if( rc==SQLITE4_OK ){
+    rc = sqlite4KVCursorSeek(pCur, (const KVByteArray*)"", 0, +1);
+    while( rc==SQLITE4_OK || rc==SQLITE4_INEXACT ){
+      const KVByteArray *aKey;
+      const KVByteArray *aData;
+      KVSize nKey;
+      KVSize nData;
+      rc = sqlite4KVCursorKey(pCur, &aKey, &nKey);
+      if( rc==SQLITE4_OK ) rc = sqlite4KVCursorData(pCur, 0, -1, &aData, &nData);
+      if( rc==SQLITE4_OK ) rc = kvmapWriterAdd(&w, aKey, nKey, aData, nData);
+      if( rc!=SQLITE4_OK ) break;
+      nEntry++;
+      rc = sqlite4KVCursorNext(pCur);
+    }
+    if( rc==SQLITE4_NOTFOUND ) rc = SQLITE4_OK;
+  }
+  sqlite4KVCursorClose(pCur);
+  if( bTrans ){
+    sqlite4KVStoreCommitPhaseOne(pSrc, 0);
+    sqlite4KVStoreCommitPhaseTwo(pSrc, 0);
+  }
+
+  /* Append the block index and write the header */
+  if( rc==SQLITE4_OK ){
+    u8 aHdr[KVMAP_HDRSIZE];
+    i64 iIndex = w.iOff;
+    rc = kvmapWrite(&w, w.aIndex, (i64)w.nBlock*KVMAP_IDXRECORD);
+    if( rc==SQLITE4_OK ) rc = kvmapWrite(&w, w.aFirst, w.nFirst);
+    if( rc==SQLITE4_OK ){
+      memset(aHdr, 0, sizeof(aHdr));
+      memcpy(aHdr, "KVMAPFIL", 8);
+      kvmapPut32(&aHdr[8], KVMAP_VERSION);
+      kvmapPut32(&aHdr[12], iMeta);
+      kvmapPut64(&aHdr[16], (u64)nEntry);
+      kvmapPut64(&aHdr[24], (u64)iIndex);
+      kvmapPut32(&aHdr[32], (u32)w.nBlock);
+      kvmapPut64(&aHdr[40], (u64)w.iOff);
+      kvmapPut64(&aHdr[56], kvmapChecksum(aHdr));
+      if( fseek(w.pFile, 0, SEEK_SET)
+       || fwrite(aHdr, 1, KVMAP_HDRSIZE, w.pFile)!=KVMAP_HDRSIZE
+       || fflush(w.pFile)
+      ){
+        rc = SQLITE4_IOERR;
+      }
+    }
+  }
+  if( fclose(w.pFile) && rc==SQLITE4_OK ) rc = SQLITE4_IOERR;
+  if( rc==SQLITE4_OK ){
+#if SQLITE4_OS_WIN
+    if( !MoveFileExA(zTmp, zFile, MOVEFILE_REPLACE_EXISTING) ){
+      rc = SQLITE4_IOERR;
+    }
+#else
+    if( rename(zTmp, zFile) ) rc = SQLITE4_IOERR;
+#endif
+  }
+  if( rc!=SQLITE4_OK ) remove(zTmp);
+
+  sqlite4_free(pEnv, zTmp);
+  sqlite4_free(pEnv, w.aPrev);
+  sqlite4_free(pEnv, w.aIndex);
+  sqlite4_free(pEnv, w.aFirst);
+  return rc;
+}
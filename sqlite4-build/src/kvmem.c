@@ -73,6 +73,8 @@ struct KVMem {
   int nCursor;          /* Number of outstanding cursors */
   int iMagicKVMemBase;  /* Magic number of sanity */
   unsigned int iMeta;   /* Schema cookie value */
+  KVMemLog *pLog;       /* Write-ahead log, or NULL if not durable */
+  int bLogged;          /* True if pLog holds the committing transaction */
 };
 #define SQLITE4_KVMEMBASE_MAGIC  0xbfcd47d0
 
@@ -437,9 +439,172 @@ static void kvmemRemoveNode(KVMem *p, KVMemNode *pOld){
   kvmemNodeUnref(p->base.pEnv, pOld);
 }
 
+/*
+** Return the node with key aKey[0..nKey-1], or NULL if there is none.
+*/
+static KVMemNode *kvmemFind(KVMem *p, const KVByteArray *aKey, KVSize nKey){
+  KVMemNode *pNode = p->pRoot;
+  while( pNode ){
+    int c = kvmemKeyCompare(aKey, nKey, pNode->aKey, pNode->nKey);
+    if( c==0 ) break;
+    pNode = c<0 ? pNode->pBefore : pNode->pAfter;
+  }
+  return pNode;
+}
+
 /*
 ** End of low-level access routines
 ***************************************************************************
+** Durability.  These routines connect the tree to the write-ahead log and
+** snapshot file implemented in kvmemlog.c.
+*/
+
+/*
+** Copy the changes made by the write transaction being committed, as
+** recorded in the apLog[] lists, into a new frame of the write-ahead log.
+** A row may be listed at more than one level.  Each copy carries the
+** row's current content, so replaying the duplicates is harmless.
+*/
+static int kvmemLogChanges(KVMem *p){
+  int rc = SQLITE4_OK;
+  int i;
+  sqlite4KVMemLogAbort(p->pLog);
+  for(i=0; rc==SQLITE4_OK && i<p->base.iTransLevel-1; i++){
+    KVMemChng *pChng;
+    for(pChng=p->apLog[i]; rc==SQLITE4_OK && pChng; pChng=pChng->pNext){
+      KVMemNode *pNode = pChng->pNode;
+      KVMemData *pData = pNode->pData;
+      rc = sqlite4KVMemLogAppend(p->pLog, pNode->aKey, pNode->nKey,
+                                 pData ? pData->a : 0, pData ? pData->n : 0);
+    }
+  }
+  p->bLogged = (rc==SQLITE4_OK);
+  return rc;
+}
+
+/*
+** Write a snapshot of the tree, allowing the write-ahead log to be
+** emptied.  No write transaction may be open.
+*/
+static int kvmemSnapshot(KVMem *p){
+  KVMemNode *pNode;
+  sqlite4_int64 nEntry = 0;
+  int rc;
+  assert( p->base.iTransLevel<2 );
+  for(pNode=kvmemFirst(p->pRoot); pNode; pNode=kvmemNext(pNode)){
+    if( pNode->pData ) nEntry++;
+  }
+  rc = sqlite4KVMemLogSnapshotBegin(p->pLog, nEntry);
+  for(pNode=kvmemFirst(p->pRoot); rc==SQLITE4_OK && pNode;
+      pNode=kvmemNext(pNode)){
+    KVMemData *pData = pNode->pData;
+    if( pData ){
+      rc = sqlite4KVMemLogSnapshotWrite(p->pLog, pNode->aKey, pNode->nKey,
+                                        pData->a, pData->n);
+    }
+  }
+  return sqlite4KVMemLogSnapshotEnd(p->pLog, rc);
+}
+
+/*
+** Build a balanced tree from the next nEntry entries of the snapshot being
+** loaded, which arrive in key order.  The left subtree is built first, then
+** its parent is read, then the right subtree, so no sorting or rebalancing
+** is needed.
+*/
+static KVMemNode *kvmemLoadTree(KVMem *p, sqlite4_int64 nEntry, int *pRc){
+  sqlite4_env *pEnv = p->base.pEnv;
+  KVMemNode *pBefore;
+  KVMemNode *pNode = 0;
+  const KVByteArray *aKey, *aData;
+  KVSize nKey, nData;
+
+  if( nEntry<=0 || *pRc!=SQLITE4_OK ) return 0;
+  pBefore = kvmemLoadTree(p, (nEntry-1)/2, pRc);
+  if( *pRc==SQLITE4_OK ){
+    *pRc = sqlite4KVMemLogSnapshotRead(p->pLog, &aKey, &nKey, &aData, &nData);
+  }
+  if( *pRc==SQLITE4_OK ){
+    pNode = sqlite4_malloc(pEnv, sizeof(*pNode)+nKey-2);
+    if( pNode ){
+      memset(pNode, 0, sizeof(*pNode));
+      memcpy(pNode->aKey, aKey, nKey);
+      pNode->nKey = nKey;
+      pNode->nRef = 1;
+      pNode->pData = kvmemDataNew(pEnv, aData, nData);
+      if( pNode->pData==0 ){
+        sqlite4_free(pEnv, pNode);
+        pNode = 0;
+      }
+    }
+    if( pNode==0 ) *pRc = SQLITE4_NOMEM;
+  }
+  if( pNode==0 ){
+    kvmemClearTree(pEnv, pBefore);
+    return 0;
+  }
+  pNode->pBefore = pBefore;
+  if( pBefore ) pBefore->pUp = pNode;
+  pNode->pAfter = kvmemLoadTree(p, nEntry-1-(nEntry-1)/2, pRc);
+  if( pNode->pAfter ) pNode->pAfter->pUp = pNode;
+  if( *pRc!=SQLITE4_OK ){
+    kvmemClearTree(pEnv, pNode);
+    return 0;
+  }
+  kvmemRecomputeHeight(pNode);
+  return pNode;
+}
+
+static int kvmemReplace(KVStore*,
+    const KVByteArray*, KVSize, const KVByteArray*, KVSize);
+
+/*
+** Apply one change from the write-ahead log during recovery.
+*/
+static int kvmemReplayEntry(
+  void *pCtx,
+  const KVByteArray *aKey, KVSize nKey,
+  const KVByteArray *aData, KVSize nData
+){
+  KVMem *p = (KVMem*)pCtx;
+  KVMemNode *pNode;
+  if( aData ){
+    return kvmemReplace(&p->base, aKey, nKey, aData, nData);
+  }
+  pNode = kvmemFind(p, aKey, nKey);
+  if( pNode ) kvmemRemoveNode(p, pNode);
+  return SQLITE4_OK;
+}
+
+/*
+** Restore the content of a durable store from its snapshot and log.
+**
+** The log is replayed with transactions turned off, so that changes are
+** applied directly to the tree without building rollback lists.
+*/
+static int kvmemRecover(KVMem *p){
+  unsigned openFlags = p->openFlags;
+  sqlite4_int64 nEntry;
+  int rc;
+
+  rc = sqlite4KVMemLogSnapshotOpen(p->pLog, &nEntry, &p->iMeta);
+  if( rc==SQLITE4_OK ){
+    p->pRoot = kvmemLoadTree(p, nEntry, &rc);
+  }
+  sqlite4KVMemLogSnapshotClose(p->pLog);
+  if( rc==SQLITE4_OK ){
+    p->openFlags |= SQLITE4_KVOPEN_NO_TRANSACTIONS;
+    p->base.iTransLevel = 2;
+    rc = sqlite4KVMemLogReplay(p->pLog, (void*)p, kvmemReplayEntry, &p->iMeta);
+    p->base.iTransLevel = 0;
+    p->openFlags = openFlags;
+  }
+  return rc;
+}
+
+/*
+** End of durability routines
+***************************************************************************
 ** Interface routines follow
 */
   
@@ -484,8 +649,11 @@ static int kvmemBegin(KVStore *pKVStore, int iLevel){
 ** level when this routine is called.
 **
 ** Commit is divided into two phases.  A rollback is still possible after
-** phase one completes.  In this implementation, phase one is a no-op since
-** phase two cannot fail.
+** phase one completes.  In this implementation, phase one is a no-op
+** unless the store is durable, in which case it prepares the write-ahead
+** log frame for an outermost write transaction, so that running out of
+** memory can still be handled by rolling back.  Phase two then writes the
+** frame to the log.
 **
 ** After this routine returns successfully, the transaction level will be 
 ** equal to iLevel.
@@ -493,24 +661,37 @@ static int kvmemBegin(KVStore *pKVStore, int iLevel){
 static int kvmemCommitPhaseOne(KVStore *pKVStore, int iLevel){
   //printf("----->kvmemCommitPhaseOne( %p, %d )\n", pKVStore, iLevel);
 
+  KVMem *p = (KVMem*)pKVStore;
+  if( p->pLog && iLevel<2 && p->base.iTransLevel>=2 ){
+    return kvmemLogChanges(p);
+  }
   return SQLITE4_OK;
 }
 
 static int kvmemCommitPhaseOneXID(KVStore *pKVStore, int iLevel, void * xid){
   //printf("----->kvmemCommitPhaseOneXID( %p, %d, %p )\n", pKVStore, iLevel, xid);
 
-  return SQLITE4_OK;
+  return kvmemCommitPhaseOne(pKVStore, iLevel);
 }
 
 static int kvmemCommitPhaseTwo(KVStore *pKVStore, int iLevel){
   //printf("----->kvmemCommitPhaseTwo( %p, %d )\n", pKVStore, iLevel);
 
   KVMem *p = (KVMem*)pKVStore;
+  int bLog = 0;
+  int rc = SQLITE4_OK;
   assert( p->iMagicKVMemBase==SQLITE4_KVMEMBASE_MAGIC );
   assert( iLevel>=0 );
   assert( iLevel<p->base.iTransLevel );
   assertUpPointers(p->pRoot);
   if( !kvmemTransactional(p) ) return SQLITE4_OK;
+  if( p->pLog && iLevel<2 && p->base.iTransLevel>=2 ){
+    if( !p->bLogged ){
+      rc = kvmemLogChanges(p);
+      if( rc!=SQLITE4_OK ) return rc;
+    }
+    bLog = 1;
+  }
   while( p->base.iTransLevel>iLevel && p->base.iTransLevel>1 ){
     KVMemChng *pChng, *pNext;
 
@@ -547,7 +728,17 @@ static int kvmemCommitPhaseTwo(KVStore *pKVStore, int iLevel){
   }
   assertUpPointers(p->pRoot);
   p->base.iTransLevel = iLevel;
-  return SQLITE4_OK;
+
+  /* The transaction is committed in memory whatever happens to the log.
+  ** If a snapshot fails, the log still holds everything. */
+  if( bLog ){
+    p->bLogged = 0;
+    rc = sqlite4KVMemLogCommit(p->pLog, p->iMeta);
+    if( rc==SQLITE4_OK && sqlite4KVMemLogWantSnapshot(p->pLog) ){
+      kvmemSnapshot(p);
+    }
+  }
+  return rc;
 }
 
 /*
@@ -565,6 +756,10 @@ static int kvmemRollback(KVStore *pKVStore, int iLevel){
   assert( p->iMagicKVMemBase==SQLITE4_KVMEMBASE_MAGIC );
   assert( iLevel>=0 );
   if( !kvmemTransactional(p) ) return SQLITE4_OK;
+  if( p->pLog && iLevel<2 ){
+    sqlite4KVMemLogAbort(p->pLog);
+    p->bLogged = 0;
+  }
   while( p->base.iTransLevel>iLevel && p->base.iTransLevel>1 ){
     KVMemChng *pChng, *pNext;
     for(pChng=p->apLog[p->base.iTransLevel-2]; pChng; pChng=pNext){
@@ -765,47 +960,56 @@ static int kvmemPrevEntry(KVCursor *pKVCursor){
 }
 
 /*
-** Seek a cursor.
+** Search the subtree rooted at pNode for the node that matches aKey as
+** closely as possible in the given direction, as described for xSeek.
+** Return the node, or NULL if there is none.  *pRc is set to SQLITE4_OK
+** for an exact match and to SQLITE4_INEXACT otherwise.
 */
-static int kvmemSeek(
-  KVCursor *pKVCursor, 
+static KVMemNode *kvmemSearch(
+  KVMemNode *pNode,
   const KVByteArray *aKey,
   KVSize nKey,
-  int direction
+  int direction,
+  int *pRc
 ){
-  KVMemCursor *pCur;
-  KVMemNode *pNode;
   KVMemNode *pBest = 0;
   int c;
-  int rc = SQLITE4_NOTFOUND;
-
-  kvmemReset(pKVCursor);
-  pCur = (KVMemCursor*)pKVCursor;
-  assert( pCur->iMagicKVMemCur==SQLITE4_KVMEMCUR_MAGIC );
 
-  pNode = pCur->pOwner->pRoot;
+  *pRc = SQLITE4_NOTFOUND;
   while( pNode ){
     c = kvmemKeyCompare(aKey, nKey, pNode->aKey, pNode->nKey);
     if( c==0 ){
       pBest = pNode;
-      rc = SQLITE4_OK;
+      *pRc = SQLITE4_OK;
       pNode = 0;
     }else if( c>0 ){
       if( direction<0 ){
         pBest = pNode;
-        rc = SQLITE4_INEXACT;
+        *pRc = SQLITE4_INEXACT;
       }
       pNode = pNode->pAfter;
     }else{
       if( direction>0 ){
         pBest = pNode;
-        rc = SQLITE4_INEXACT;
+        *pRc = SQLITE4_INEXACT;
       }
       pNode = pNode->pBefore;
     }
   }
-  kvmemNodeUnref(pCur->base.pEnv, pCur->pNode);
-  kvmemDataUnref(pCur->base.pEnv, pCur->pData);
+  return pBest;
+}
+
+/*
+** Point cursor pCur at node pBest, found by a search in the given
+** direction that returned rc.  Return the result of the seek.
+*/
+static int kvmemSeekResult(
+  KVMemCursor *pCur,
+  KVMemNode *pBest,
+  int rc,
+  int direction
+){
+  KVCursor *pKVCursor = (KVCursor*)pCur;
   if( pBest ){
     pCur->pNode = kvmemNodeRef(pBest);
     pCur->pData = kvmemDataRef(pBest->pData);
@@ -834,6 +1038,113 @@ static int kvmemSeek(
   return rc;
 }
 
+/*
+** Seek a cursor.
+*/
+static int kvmemSeek(
+  KVCursor *pKVCursor, 
+  const KVByteArray *aKey,
+  KVSize nKey,
+  int direction
+){
+  KVMemCursor *pCur;
+  KVMemNode *pBest;
+  int rc;
+
+  kvmemReset(pKVCursor);
+  pCur = (KVMemCursor*)pKVCursor;
+  assert( pCur->iMagicKVMemCur==SQLITE4_KVMEMCUR_MAGIC );
+
+  pBest = kvmemSearch(pCur->pOwner->pRoot, aKey, nKey, direction, &rc);
+  return kvmemSeekResult(pCur, pBest, rc, direction);
+}
+
+/*
+** Seek cursor pCur, which points to node pFrom, to the smallest entry
+** greater than or equal to aKey, as xSeek does for a positive direction.
+**
+** Instead of starting at the root, the search climbs from pFrom only as
+** far as the smallest subtree known to hold the result, so a key close to
+** pFrom is found in a few steps.  If aKey is greater than the key of
+** pFrom, the climb stops on reaching the left child of a node with a key
+** greater than or equal to aKey: every entry to the left of that subtree
+** is smaller than pFrom, so the result is in the subtree or is the parent
+** node.  If aKey is not greater than the key of pFrom, pFrom is the
+** result if the entry before it is smaller than aKey.
+*/
+static int kvmemSeekFrom(
+  KVMemCursor *pCur,
+  KVMemNode *pFrom,
+  const KVByteArray *aKey,
+  KVSize nKey
+){
+  KVMemNode *pNode = pFrom;
+  KVMemNode *pBest;
+  int rc;
+  int c;
+
+  c = kvmemKeyCompare(aKey, nKey, pFrom->aKey, pFrom->nKey);
+  if( c<=0 ){
+    KVMemNode *pPrev = kvmemPrev(pFrom);
+    if( pPrev==0 || kvmemKeyCompare(aKey, nKey, pPrev->aKey, pPrev->nKey)>0 ){
+      pBest = pFrom;
+      rc = c==0 ? SQLITE4_OK : SQLITE4_INEXACT;
+    }else{
+      pBest = kvmemSearch(pCur->pOwner->pRoot, aKey, nKey, +1, &rc);
+    }
+  }else{
+    KVMemNode *pUp;
+    while( (pUp = pNode->pUp)!=0 && (pNode==pUp->pAfter
+        || kvmemKeyCompare(aKey, nKey, pUp->aKey, pUp->nKey)>0)
+    ){
+      pNode = pUp;
+    }
+    pBest = kvmemSearch(pNode, aKey, nKey, +1, &rc);
+    if( pBest==0 && pUp ){
+      pBest = pUp;
+      c = kvmemKeyCompare(aKey, nKey, pUp->aKey, pUp->nKey);
+      rc = c==0 ? SQLITE4_OK : SQLITE4_INEXACT;
+    }
+  }
+
+  /* pFrom is referenced by the cursor, so it stays valid until here */
+  kvmemReset((KVCursor*)pCur);
+  return kvmemSeekResult(pCur, pBest, rc, +1);
+}
+
+/*
+** Seek a cursor to each of nProbe keys in ascending order, calling xVisit
+** after each seek.  Each search after the first starts from the entry the
+** previous one (and any xNext calls made by xVisit) left the cursor on.
+** The first starts from the root, as the entry the cursor points to when
+** this is called may no longer be part of the tree.
+*/
+static int kvmemSeekBatch(
+  KVCursor *pKVCursor,
+  int nProbe,
+  const KVByteArray *const *apKey,
+  const KVSize *anKey,
+  int (*xVisit)(void*, int, int),
+  void *pCtx
+){
+  KVMemCursor *pCur = (KVMemCursor*)pKVCursor;
+  int rc = SQLITE4_OK;
+  int i;
+
+  assert( pCur->iMagicKVMemCur==SQLITE4_KVMEMCUR_MAGIC );
+  for(i=0; rc==SQLITE4_OK && i<nProbe; i++){
+    if( i>0 && pCur->pNode ){
+      rc = kvmemSeekFrom(pCur, pCur->pNode, apKey[i], anKey[i]);
+    }else{
+      rc = kvmemSeek(pKVCursor, apKey[i], anKey[i], +1);
+    }
+    if( rc==SQLITE4_OK || rc==SQLITE4_INEXACT || rc==SQLITE4_NOTFOUND ){
+      rc = xVisit(pCtx, i, rc);
+    }
+  }
+  return rc;
+}
+
 /*
 ** Delete the entry that the cursor is pointing to.
 **
@@ -931,6 +1242,7 @@ static int kvmemClose(KVStore *pKVStore){
   
   KVMem *p = (KVMem*)pKVStore;
   sqlite4_env *pEnv;
+  int rc;
   if( p==0 ) return SQLITE4_OK;
   assert( p->iMagicKVMemBase==SQLITE4_KVMEMBASE_MAGIC );
   assert( p->nCursor==0 );
@@ -939,14 +1251,40 @@ static int kvmemClose(KVStore *pKVStore){
     kvmemCommitPhaseOne(pKVStore, 0);
     kvmemCommitPhaseTwo(pKVStore, 0);
   }
+  rc = sqlite4KVMemLogClose(p->pLog);
   sqlite4_free(pEnv, p->apLog);
   kvmemClearTree(pEnv, p->pRoot);
   memset(p, 0, sizeof(*p));
   sqlite4_free(pEnv, p);
-  return SQLITE4_OK;
+  return rc;
 }
 
+/*
+** A durable store supports SQLITE4_KVCTRL_SYNCHRONOUS, which sets the
+** synchronous level of the write-ahead log, and SQLITE4_KVCTRL_SNAPSHOT,
+** which writes a snapshot and empties the log.
+**
+** Every store supports SQLITE4_KVCTRL_DATA_VERSION. An in-memory store
+** belongs to the connection that opened it, so the version never changes.
+*/
 static int kvmemControl(KVStore *pKVStore, int op, void *pArg){
+  KVMem *p = (KVMem*)pKVStore;
+  if( op==SQLITE4_KVCTRL_DATA_VERSION ){
+    *(sqlite4_uint64*)pArg = 0;
+    return SQLITE4_OK;
+  }
+  if( p->pLog ){
+    switch( op ){
+      case SQLITE4_KVCTRL_SYNCHRONOUS: {
+        int *peSync = (int*)pArg;
+        *peSync = sqlite4KVMemLogSynchronous(p->pLog, *peSync);
+        return SQLITE4_OK;
+      }
+      case SQLITE4_KVCTRL_SNAPSHOT:
+        if( p->base.iTransLevel>=2 ) return SQLITE4_BUSY;
+        return kvmemSnapshot(p);
+    }
+  }
   return SQLITE4_NOTFOUND;
 }
 
@@ -964,7 +1302,7 @@ static int kvmemPutMeta(KVStore *pKVStore, unsigned int iVal){
 
 /* Virtual methods for the in-memory storage engine */
 static const KVStoreMethods kvmemMethods = {
-  1,                        /* iVersion */
+  2,                        /* iVersion */
   sizeof(KVStoreMethods),   /* szSelf */
   kvmemReplace,             /* xReplace */
   kvmemOpenCursor,          /* xOpenCursor */
@@ -985,11 +1323,18 @@ static const KVStoreMethods kvmemMethods = {
   kvmemClose,               /* xClose */
   kvmemControl,             /* xControl */
   kvmemGetMeta,             /* xGetMeta */
-  kvmemPutMeta              /* xPutMeta */
+  kvmemPutMeta,             /* xPutMeta */
+  0,                        /* xGetMethod */
+  kvmemSeekBatch            /* xSeekBatch */
 };
 
 /*
 ** Create a new in-memory storage engine and return a pointer to it.
+**
+** If the URI filename zName has the "durable=1" parameter and the store is
+** neither temporary nor opened without transactions, the content is
+** restored from, and committed changes written to, files on disk.  See
+** kvmemlog.c for details.
 */
 int sqlite4KVStoreOpenMem(
   sqlite4_env *pEnv,              /* Runtime environment */
@@ -1006,6 +1351,18 @@ int sqlite4KVStoreOpenMem(
   pNew->base.pEnv = pEnv;
   pNew->iMagicKVMemBase = SQLITE4_KVMEMBASE_MAGIC;
   pNew->openFlags = openFlags;
+  if( (openFlags & SQLITE4_KVOPEN_TEMPORARY)==0
+   && kvmemTransactional(pNew)
+   && zName && zName[0] && strcmp(zName, ":memory:")!=0
+  ){
+    int rc = sqlite4KVMemLogOpen(pEnv, zName, &pNew->pLog);
+    if( rc==SQLITE4_OK && pNew->pLog ) rc = kvmemRecover(pNew);
+    if( rc!=SQLITE4_OK ){
+      kvmemClose((KVStore*)pNew);
+      *ppKVStore = 0;
+      return rc;
+    }
+  }
   *ppKVStore = (KVStore*)pNew;
   return SQLITE4_OK;
 }
@@ -0,0 +1,906 @@
+/*
+** 2026 October 19
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file implements an optional write-ahead log and snapshot file that
+** make the in-memory key/value store in kvmem.c durable.  Every committed
+** write transaction is appended to the log, and from time to time the whole
+** content of the store is written to a snapshot so that the log can be
+** emptied.  When the store is reopened the snapshot is loaded and only the
+** part of the log written since is replayed.
+**
+** Durability is requested with the "durable=1" URI parameter, for example
+** "file:data.db?durable=1".  It applies only to persistent, transactional
+** stores.  The following parameters are also recognized:
+**
+**   sync=off|normal|full   When the log is synced to disk.  OFF keeps
+**                          committed transactions in memory and writes
+**                          them once "group" bytes have accumulated.  NORMAL
+**                          writes each transaction as it commits and syncs
+**                          once "group" bytes have been written.  FULL
+**                          writes and syncs every commit.  The default is
+**                          NORMAL.  The level may be changed later using
+**                          SQLITE4_KVCTRL_SYNCHRONOUS.
+**
+**   group=N                The group flush size in bytes.  Default 1MB.
+**
+**   snapshot=N             Write a snapshot when the log has grown past N
+**                          bytes and past the size of the previous snapshot,
+**                          so that the cost of snapshots stays proportional
+**                          to the volume of changes.  0 disables automatic
+**                          snapshots; SQLITE4_KVCTRL_SNAPSHOT still works.
+**                          Default 64MB.
+**
+** The log and snapshot are named by appending "-log" and "-snap" to the
+** database name.  Each file starts with a 16-byte header: an 8-byte magic
+** string, a 4-byte version number and 4 reserved bytes.  The rest of the
+** file is a sequence of frames:
+**
+**     4 bytes    payload size N
+**     8 bytes    checksum of the payload
+**     N bytes    payload
+**
+** The payload of a log frame is one committed transaction:
+**
+**     8 bytes    commit sequence number
+**     4 bytes    meta value (see xPutMeta) as of the commit
+**     entries    varint nKey, key, varint nData+1 (0 for a delete), data
+**
+** The first frame of a snapshot holds the sequence number of the last
+** commit included, the meta value, and the number of entries as an 8-byte
+** integer.  The frames that follow hold about 1MB of entries each, in key
+** order, each entry being a varint nKey, the key, a varint nData and the
+** data.  Fixed-size integers are big-endian.
+**
+** Frames are only written whole, but a crash may leave a partly written
+** frame at the end of the log.  During replay, a frame that is incomplete
+** or fails its checksum marks the end of the log, which is truncated
+** there.  A new snapshot is written to "-snap-tmp", synced and renamed over
+** "-snap" before the log is truncated, and log frames already included in
+** the snapshot are skipped by sequence number, so a crash at any point
+** leaves a usable pair of files.
+**
+** The log file is locked while it is open, so a second attempt to open the
+** same database, from this process or another, fails with SQLITE4_BUSY.
+*/
+#include "sqliteInt.h"
+
+#include <stdio.h>
+
+#if SQLITE4_OS_WIN
+# include <windows.h>
+# include <io.h>
+# define kvlogSeek(F,N,W)  _fseeki64(F,N,W)
+# define kvlogTell(F)      _ftelli64(F)
+#else
+# include <fcntl.h>
+# include <sys/file.h>
+# include <unistd.h>
+# define kvlogSeek(F,N,W)  fseeko(F,(off_t)(N),W)
+# define kvlogTell(F)      ((i64)ftello(F))
+#endif
+
+#define KVMEMLOG_VERSION           1
+#define KVMEMLOG_HDRSIZE          16     /* Size of the file header */
+#define KVMEMLOG_FRAMEHDR         12     /* Size of a frame header */
+#define KVMEMLOG_COMMITHDR        12     /* Sequence number and meta value */
+#define KVMEMLOG_SNAPHDR          20     /* First frame of a snapshot */
+#define KVMEMLOG_SNAPFRAME   (1<<20)     /* Target snapshot frame size */
+#define KVMEMLOG_MAXFRAME  0x7fffff00    /* Largest frame written or read */
+
+#define KVMEMLOG_DEFAULT_GROUP     (1<<20)
+#define KVMEMLOG_DEFAULT_SNAPSHOT  ((i64)64<<20)
+
+/*
+** An open write-ahead log and the associated snapshot file.
+*/
+struct KVMemLog {
+  sqlite4_env *pEnv;          /* Run-time environment */
+  char *zLog;                 /* Name of the log file */
+  char *zSnap;                /* Name of the snapshot file */
+  char *zSnapTmp;             /* Name of a snapshot while it is written */
+  FILE *pLog;                 /* Log file, opened for appending */
+  int eSync;                  /* 0, 1 or 2 for OFF, NORMAL or FULL */
+  int rcErr;                  /* Error from a failed log write, or OK */
+  i64 nGroup;                 /* Group flush size in bytes */
+  i64 nSnapshot;              /* Automatic snapshot threshold, or 0 */
+  i64 nLogSize;               /* Size of the log including aBuf[] */
+  i64 nSnapSize;              /* Size of the most recent snapshot */
+  i64 nUnsynced;              /* Bytes written to the log since last sync */
+  u64 iCommit;                /* Sequence number of the last commit */
+  unsigned int iMeta;         /* Meta value as of the last commit */
+  u8 *aBuf;                   /* Log frames not yet written */
+  int nBuf;                   /* Bytes of aBuf[] in use */
+  int nAlloc;                 /* Bytes allocated for aBuf[] */
+  int iPending;               /* Offset of the unsealed frame, or -1 */
+  FILE *pSnap;                /* Snapshot being read or written */
+  i64 nSnapLeft;              /* Bytes of pSnap not yet read */
+  u8 *aFrame;                 /* Snapshot frame being read or written */
+  int nFrame;                 /* Bytes of aFrame[] in use */
+  int iFrame;                 /* Read offset within aFrame[] */
+  int nFrameAlloc;            /* Bytes allocated for aFrame[] */
+};
+
+/*
+** Read and write fixed-size big-endian integers.
+*/
+static void kvlogPut32(u8 *a, u32 v){
+  a[0] = (u8)(v>>24);
+  a[1] = (u8)(v>>16);
+  a[2] = (u8)(v>>8);
+  a[3] = (u8)v;
+}
+static u32 kvlogGet32(const u8 *a){
+  return ((u32)a[0]<<24) | ((u32)a[1]<<16) | ((u32)a[2]<<8) | (u32)a[3];
+}
+static void kvlogPut64(u8 *a, u64 v){
+  kvlogPut32(a, (u32)(v>>32));
+  kvlogPut32(&a[4], (u32)v);
+}
+static u64 kvlogGet64(const u8 *a){
+  return ((u64)kvlogGet32(a)<<32) | kvlogGet32(&a[4]);
+}
+
+/*
+** Compute the checksum of a[0..n-1].  This is a Fletcher-style sum over
+** 32-bit little-endian words, which compilers turn into plain loads on
+** the common platforms, so checksumming runs at close to memory speed.
+*/
+static void kvlogChecksum(const u8 *a, int n, u32 *aCksum){
+  u32 s1 = 1;
+  u32 s2 = 0;
+  int i;
+  for(i=0; i+4<=n; i+=4){
+    s1 += (u32)a[i] | ((u32)a[i+1]<<8) | ((u32)a[i+2]<<16) | ((u32)a[i+3]<<24);
+    s2 += s1;
+  }
+  for(; i<n; i++){
+    s1 += a[i];
+    s2 += s1;
+  }
+  aCksum[0] = s1;
+  aCksum[1] = s2;
+}
+
+/*
+** Fill in the header of the frame at aFrame[], which has a payload of
+** nPayload bytes.
+*/
+static void kvlogSealFrame(u8 *aFrame, int nPayload){
+  u32 aCksum[2];
+  kvlogChecksum(&aFrame[KVMEMLOG_FRAMEHDR], nPayload, aCksum);
+  kvlogPut32(aFrame, (u32)nPayload);
+  kvlogPut32(&aFrame[4], aCksum[0]);
+  kvlogPut32(&aFrame[8], aCksum[1]);
+}
+
+/*
+** Write a file header, or check one read from a file.
+*/
+static void kvlogFileHeader(u8 *aHdr, const char *zMagic){
+  memcpy(aHdr, zMagic, 8);
+  kvlogPut32(&aHdr[8], KVMEMLOG_VERSION);
+  kvlogPut32(&aHdr[12], 0);
+}
+static int kvlogCheckHeader(const u8 *aHdr, const char *zMagic){
+  return memcmp(aHdr, zMagic, 8)==0 && kvlogGet32(&aHdr[8])==KVMEMLOG_VERSION;
+}
+
+/*
+** Make sure that *pa, which currently has *pnAlloc bytes allocated, is
+** at least nNeed bytes in size.
+*/
+static int kvlogReserve(sqlite4_env *pEnv, u8 **pa, int *pnAlloc, i64 nNeed){
+  if( nNeed>*pnAlloc ){
+    i64 nNew = *pnAlloc ? *pnAlloc : 4096;
+    u8 *aNew;
+    if( nNeed>KVMEMLOG_MAXFRAME ) return SQLITE4_TOOBIG;
+    while( nNew<nNeed ) nNew *= 2;
+    if( nNew>KVMEMLOG_MAXFRAME ) nNew = nNeed;
+    aNew = (u8*)sqlite4_realloc(pEnv, *pa, (sqlite4_size_t)nNew);
+    if( aNew==0 ) return SQLITE4_NOMEM;
+    *pa = aNew;
+    *pnAlloc = (int)nNew;
+  }
+  return SQLITE4_OK;
+}
+
+/*
+** Append an entry to a frame.  If bLog is true, aData==0 is a delete and
+** the data size is stored plus one, as in log frames.  The caller has made
+** sure there is room.
+*/
+static int kvlogPutEntry(
+  u8 *a,
+  int bLog,
+  const KVByteArray *aKey, KVSize nKey,
+  const KVByteArray *aData, KVSize nData
+){
+  int i = sqlite4PutVarint64(a, (u64)nKey);
+  memcpy(&a[i], aKey, nKey);
+  i += nKey;
+  if( bLog ){
+    i += sqlite4PutVarint64(&a[i], aData ? (u64)nData+1 : 0);
+  }else{
+    i += sqlite4PutVarint64(&a[i], (u64)nData);
+  }
+  if( aData ){
+    memcpy(&a[i], aData, nData);
+    i += nData;
+  }
+  return i;
+}
+
+/*
+** Decode the entry at offset *pi of the n-byte frame payload a[], and
+** advance *pi past it.  bLog is as for kvlogPutEntry().  Return
+** SQLITE4_CORRUPT if the entry runs past the end of the payload.
+*/
+static int kvlogGetEntry(
+  const u8 *a, int n, int *pi,
+  int bLog,
+  const KVByteArray **paKey, KVSize *pnKey,
+  const KVByteArray **paData, KVSize *pnData
+){
+  int i = *pi;
+  int k;
+  u64 v;
+
+  k = sqlite4GetVarint64(&a[i], n-i, &v);
+  if( k==0 || v>(u64)(n-i-k) ) return SQLITE4_CORRUPT;
+  i += k;
+  *paKey = &a[i];
+  *pnKey = (KVSize)v;
+  i += (int)v;
+  k = sqlite4GetVarint64(&a[i], n-i, &v);
+  if( k==0 ) return SQLITE4_CORRUPT;
+  i += k;
+  if( bLog && v==0 ){
+    *paData = 0;
+    *pnData = 0;
+  }else{
+    if( bLog ) v--;
+    if( v>(u64)(n-i) ) return SQLITE4_CORRUPT;
+    *paData = &a[i];
+    *pnData = (KVSize)v;
+    i += (int)v;
+  }
+  *pi = i;
+  return SQLITE4_OK;
+}
+
+/*
+** Read the next frame from file f, of which *pnLeft bytes remain, into
+** *pa.  The payload is stored at offset KVMEMLOG_FRAMEHDR and its size
+** written to *pnPayload.  Return SQLITE4_DONE at the end of the file, or
+** SQLITE4_CORRUPT if the frame is incomplete or fails its checksum.
+*/
+static int kvlogReadFrame(
+  sqlite4_env *pEnv,
+  FILE *f,
+  i64 *pnLeft,
+  u8 **pa, int *pnAlloc,
+  int *pnPayload
+){
+  u8 aHdr[KVMEMLOG_FRAMEHDR];
+  u32 aCksum[2];
+  u32 nPayload;
+  int rc;
+
+  if( *pnLeft<=0 ) return SQLITE4_DONE;
+  if( *pnLeft<KVMEMLOG_FRAMEHDR
+   || fread(aHdr, 1, KVMEMLOG_FRAMEHDR, f)!=KVMEMLOG_FRAMEHDR
+  ){
+    return ferror(f) ? SQLITE4_IOERR : SQLITE4_CORRUPT;
+  }
+  nPayload = kvlogGet32(aHdr);
+  if( nPayload>(u64)(*pnLeft-KVMEMLOG_FRAMEHDR) ) return SQLITE4_CORRUPT;
+  rc = kvlogReserve(pEnv, pa, pnAlloc, (i64)nPayload+KVMEMLOG_FRAMEHDR);
+  if( rc!=SQLITE4_OK ) return rc;
+  if( fread(&(*pa)[KVMEMLOG_FRAMEHDR], 1, nPayload, f)!=nPayload ){
+    return ferror(f) ? SQLITE4_IOERR : SQLITE4_CORRUPT;
+  }
+  kvlogChecksum(&(*pa)[KVMEMLOG_FRAMEHDR], (int)nPayload, aCksum);
+  if( aCksum[0]!=kvlogGet32(&aHdr[4]) || aCksum[1]!=kvlogGet32(&aHdr[8]) ){
+    return SQLITE4_CORRUPT;
+  }
+  memcpy(*pa, aHdr, KVMEMLOG_FRAMEHDR);
+  *pnLeft -= (i64)nPayload + KVMEMLOG_FRAMEHDR;
+  *pnPayload = (int)nPayload;
+  return SQLITE4_OK;
+}
+
+/*
+** Operating system helpers.  The files are accessed through stdio; these
+** add the operations stdio does not provide.
+*/
+static i64 kvlogFileSize(FILE *f){
+  i64 n;
+  if( kvlogSeek(f, 0, SEEK_END) ) return -1;
+  n = kvlogTell(f);
+  if( kvlogSeek(f, 0, SEEK_SET) ) return -1;
+  return n;
+}
+static int kvlogLock(FILE *f){
+#if SQLITE4_OS_WIN
+  /* Lock a byte beyond any real data so that reads are not blocked */
+  HANDLE h = (HANDLE)_get_osfhandle(_fileno(f));
+  if( !LockFile(h, 0, 1, 1, 0) ) return SQLITE4_BUSY;
+#else
+  if( flock(fileno(f), LOCK_EX|LOCK_NB) ) return SQLITE4_BUSY;
+#endif
+  return SQLITE4_OK;
+}
+static int kvlogSync(FILE *f){
+  if( fflush(f) ) return SQLITE4_IOERR;
+#if SQLITE4_OS_WIN
+  if( _commit(_fileno(f)) ) return SQLITE4_IOERR;
+#else
+  if( fsync(fileno(f)) ) return SQLITE4_IOERR;
+#endif
+  return SQLITE4_OK;
+}
+static int kvlogTruncate(FILE *f, i64 nByte){
+  if( fflush(f) ) return SQLITE4_IOERR;
+#if SQLITE4_OS_WIN
+  if( _chsize_s(_fileno(f), nByte) ) return SQLITE4_IOERR;
+#else
+  if( ftruncate(fileno(f), (off_t)nByte) ) return SQLITE4_IOERR;
+#endif
+  return SQLITE4_OK;
+}
+static int kvlogRename(const char *zFrom, const char *zTo){
+#if SQLITE4_OS_WIN
+  if( !MoveFileExA(zFrom, zTo, MOVEFILE_REPLACE_EXISTING|MOVEFILE_WRITE_THROUGH) ){
+    return SQLITE4_IOERR;
+  }
+#else
+  if( rename(zFrom, zTo) ) return SQLITE4_IOERR;
+#endif
+  return SQLITE4_OK;
+}
+
+/*
+** Sync the directory containing file zPath, so that a rename is durable.
+** Errors are ignored, as not every file-system supports this.
+*/
+static void kvlogSyncDir(sqlite4_env *pEnv, const char *zPath){
+#if !SQLITE4_OS_WIN
+  int n = sqlite4Strlen30(zPath);
+  char *zDir;
+  int fd;
+  while( n>0 && zPath[n-1]!='/' ) n--;
+  zDir = sqlite4_mprintf(pEnv, "%.*s", n, zPath);
+  if( zDir ){
+    fd = open(n>0 ? zDir : ".", O_RDONLY);
+    if( fd>=0 ){
+      fsync(fd);
+      close(fd);
+    }
+    sqlite4_free(pEnv, zDir);
+  }
+#endif
+}
+
+/*
+** Write the buffered log frames to the log file.
+*/
+static int kvlogWrite(KVMemLog *p){
+  assert( p->iPending<0 );
+  if( p->nBuf>0 ){
+    if( fwrite(p->aBuf, 1, p->nBuf, p->pLog)!=(size_t)p->nBuf ){
+      return SQLITE4_IOERR;
+    }
+    p->nUnsynced += p->nBuf;
+    p->nBuf = 0;
+  }
+  return SQLITE4_OK;
+}
+
+/*
+** Sync the log file.
+*/
+static int kvlogSyncLog(KVMemLog *p){
+  int rc = kvlogSync(p->pLog);
+  if( rc==SQLITE4_OK ) p->nUnsynced = 0;
+  return rc;
+}
+
+/*
+** Parse the value of a "sync" URI parameter.  Return -1 if it is not
+** recognized.
+*/
+static int kvlogSyncLevel(const char *z){
+  if( sqlite4_stricmp(z, "off")==0 || strcmp(z, "0")==0 ) return 0;
+  if( sqlite4_stricmp(z, "normal")==0 || strcmp(z, "1")==0 ) return 1;
+  if( sqlite4_stricmp(z, "full")==0 || strcmp(z, "2")==0 ) return 2;
+  return -1;
+}
+
+/*
+** Open the log for the database with URI filename zUri.  If durability was
+** not requested by the URI, set *ppLog to NULL and return SQLITE4_OK.
+**
+** Otherwise, open and lock the log file, creating it if necessary.  The
+** caller must then load the snapshot and replay the log before committing
+** anything.
+*/
+int sqlite4KVMemLogOpen(
+  sqlite4_env *pEnv,              /* Runtime environment */
+  const char *zUri,               /* URI filename of the database */
+  KVMemLog **ppLog                /* OUT: The new log, or NULL */
+){
+  KVMemLog *p;
+  const char *zSync;
+  int eSync = 1;
+  i64 nSize;
+  int rc = SQLITE4_OK;
+
+  *ppLog = 0;
+  if( !sqlite4_uri_boolean(zUri, "durable", 0) ) return SQLITE4_OK;
+  zSync = sqlite4_uri_parameter(zUri, "sync");
+  if( zSync ){
+    eSync = kvlogSyncLevel(zSync);
+    if( eSync<0 ) return SQLITE4_ERROR;
+  }
+
+  p = (KVMemLog*)sqlite4_malloc(pEnv, sizeof(*p));
+  if( p==0 ) return SQLITE4_NOMEM;
+  memset(p, 0, sizeof(*p));
+  p->pEnv = pEnv;
+  p->eSync = eSync;
+  p->iPending = -1;
+  p->nGroup = sqlite4_uri_int64(zUri, "group", KVMEMLOG_DEFAULT_GROUP);
+  p->nSnapshot = sqlite4_uri_int64(zUri, "snapshot", KVMEMLOG_DEFAULT_SNAPSHOT);
+  if( p->nGroup<0 ) p->nGroup = 0;
+  if( p->nSnapshot<0 ) p->nSnapshot = 0;
+  p->zLog = sqlite4_mprintf(pEnv, "%s-log", zUri);
+  p->zSnap = sqlite4_mprintf(pEnv, "%s-snap", zUri);
+  p->zSnapTmp = sqlite4_mprintf(pEnv, "%s-snap-tmp", zUri);
+  if( p->zLog==0 || p->zSnap==0 || p->zSnapTmp==0 ){
+    rc = SQLITE4_NOMEM;
+  }
+
+  /* Append mode creates the file if it is missing without truncating an
+  ** existing one.  Every write to the log is an append in any case.  The
+  ** stream is unbuffered because whole frames are written from aBuf[]. */
+  if( rc==SQLITE4_OK ){
+    p->pLog = fopen(p->zLog, "ab");
+    if( p->pLog==0 ) rc = SQLITE4_CANTOPEN;
+  }
+  if( rc==SQLITE4_OK ){
+    setvbuf(p->pLog, 0, _IONBF, 0);
+    rc = kvlogLock(p->pLog);
+  }
+  if( rc==SQLITE4_OK ){
+    nSize = kvlogFileSize(p->pLog);
+    if( nSize<0 ){
+      rc = SQLITE4_IOERR;
+    }else if( nSize<KVMEMLOG_HDRSIZE ){
+      /* A new log, or one whose creation was interrupted */
+      u8 aHdr[KVMEMLOG_HDRSIZE];
+      kvlogFileHeader(aHdr, "KVMEMLOG");
+      rc = kvlogTruncate(p->pLog, 0);
+      if( rc==SQLITE4_OK
+       && fwrite(aHdr, 1, KVMEMLOG_HDRSIZE, p->pLog)!=KVMEMLOG_HDRSIZE
+      ){
+        rc = SQLITE4_IOERR;
+      }
+      if( rc==SQLITE4_OK ) rc = kvlogSyncLog(p);
+    }
+  }
+
+  if( rc!=SQLITE4_OK ){
+    sqlite4KVMemLogClose(p);
+    return rc;
+  }
+  p->nLogSize = KVMEMLOG_HDRSIZE;
+  *ppLog = p;
+  return SQLITE4_OK;
+}
+
+/*
+** Open the snapshot file for reading and return the number of entries it
+** holds in *pnEntry and the meta value in *piMeta.  If there is no
+** snapshot, set both to zero.  The entries are then read, in key order,
+** using sqlite4KVMemLogSnapshotRead(), and the file is closed with
+** sqlite4KVMemLogSnapshotClose().
+*/
+int sqlite4KVMemLogSnapshotOpen(
+  KVMemLog *p,
+  i64 *pnEntry,
+  unsigned int *piMeta
+){
+  u8 aHdr[KVMEMLOG_HDRSIZE];
+  const u8 *a;
+  int nPayload;
+  int rc;
+
+  assert( p->pSnap==0 );
+  *pnEntry = 0;
+  *piMeta = 0;
+  p->pSnap = fopen(p->zSnap, "rb");
+  if( p->pSnap==0 ) return SQLITE4_OK;
+  p->nSnapSize = kvlogFileSize(p->pSnap);
+  p->nSnapLeft = p->nSnapSize - KVMEMLOG_HDRSIZE;
+  if( p->nSnapSize<KVMEMLOG_HDRSIZE
+   || fread(aHdr, 1, KVMEMLOG_HDRSIZE, p->pSnap)!=KVMEMLOG_HDRSIZE
+   || !kvlogCheckHeader(aHdr, "KVMEMSNP")
+  ){
+    return SQLITE4_CORRUPT;
+  }
+  rc = kvlogReadFrame(p->pEnv, p->pSnap, &p->nSnapLeft,
+                      &p->aFrame, &p->nFrameAlloc, &nPayload);
+  if( rc==SQLITE4_DONE || (rc==SQLITE4_OK && nPayload!=KVMEMLOG_SNAPHDR) ){
+    rc = SQLITE4_CORRUPT;
+  }
+  if( rc==SQLITE4_OK ){
+    a = &p->aFrame[KVMEMLOG_FRAMEHDR];
+    p->iCommit = kvlogGet64(a);
+    p->iMeta = kvlogGet32(&a[8]);
+    *pnEntry = (i64)kvlogGet64(&a[12]);
+    *piMeta = p->iMeta;
+    p->iFrame = p->nFrame = 0;
+  }
+  return rc;
+}
+
+/*
+** Read the next entry from the snapshot.  The key and data remain valid
+** until the next call.
+*/
+int sqlite4KVMemLogSnapshotRead(
+  KVMemLog *p,
+  const KVByteArray **paKey, KVSize *pnKey,
+  const KVByteArray **paData, KVSize *pnData
+){
+  if( p->iFrame>=p->nFrame ){
+    int nPayload;
+    int rc = kvlogReadFrame(p->pEnv, p->pSnap, &p->nSnapLeft,
+                            &p->aFrame, &p->nFrameAlloc, &nPayload);
+    if( rc==SQLITE4_DONE ) rc = SQLITE4_CORRUPT;
+    if( rc!=SQLITE4_OK ) return rc;
+    p->iFrame = KVMEMLOG_FRAMEHDR;
+    p->nFrame = KVMEMLOG_FRAMEHDR + nPayload;
+  }
+  return kvlogGetEntry(p->aFrame, p->nFrame, &p->iFrame, 0,
+                       paKey, pnKey, paData, pnData);
+}
+
+/*
+** Close a snapshot opened by sqlite4KVMemLogSnapshotOpen().
+*/
+void sqlite4KVMemLogSnapshotClose(KVMemLog *p){
+  if( p->pSnap ){
+    fclose(p->pSnap);
+    p->pSnap = 0;
+  }
+}
+
+/*
+** Replay the log.  xApply is invoked for each change committed after the
+** snapshot was taken, in commit order, with aData==0 for a delete.  The
+** meta value as of the last commit is written to *piMeta.
+**
+** Replay stops at the first frame that is incomplete or fails its
+** checksum, which is the point where the log was interrupted by a crash.
+** The log is truncated there so that new frames follow the last good one.
+*/
+int sqlite4KVMemLogReplay(
+  KVMemLog *p,
+  void *pCtx,
+  int (*xApply)(void*, const KVByteArray*, KVSize, const KVByteArray*, KVSize),
+  unsigned int *piMeta
+){
+  u8 aHdr[KVMEMLOG_HDRSIZE];
+  u8 *a = 0;
+  int nAlloc = 0;
+  i64 nSize;
+  i64 nLeft;
+  FILE *f;
+  int rc = SQLITE4_OK;
+
+  f = fopen(p->zLog, "rb");
+  if( f==0 ) return SQLITE4_CANTOPEN;
+  nSize = kvlogFileSize(f);
+  nLeft = nSize - KVMEMLOG_HDRSIZE;
+  if( nSize<KVMEMLOG_HDRSIZE
+   || fread(aHdr, 1, KVMEMLOG_HDRSIZE, f)!=KVMEMLOG_HDRSIZE
+   || !kvlogCheckHeader(aHdr, "KVMEMLOG")
+  ){
+    rc = SQLITE4_CORRUPT;
+  }
+
+  while( rc==SQLITE4_OK ){
+    const u8 *aPayload;
+    int nPayload;
+    u64 iCommit;
+    int i;
+
+    rc = kvlogReadFrame(p->pEnv, f, &nLeft, &a, &nAlloc, &nPayload);
+    if( rc==SQLITE4_DONE || rc==SQLITE4_CORRUPT ){
+      rc = SQLITE4_OK;
+      break;
+    }
+    if( rc!=SQLITE4_OK ) break;
+    aPayload = &a[KVMEMLOG_FRAMEHDR];
+    if( nPayload<KVMEMLOG_COMMITHDR ){
+      rc = SQLITE4_CORRUPT;
+      break;
+    }
+    iCommit = kvlogGet64(aPayload);
+    if( iCommit<=p->iCommit ) continue;
+    for(i=KVMEMLOG_COMMITHDR; rc==SQLITE4_OK && i<nPayload; ){
+      const KVByteArray *aKey, *aData;
+      KVSize nKey, nData;
+      rc = kvlogGetEntry(aPayload, nPayload, &i, 1,
+                         &aKey, &nKey, &aData, &nData);
+      if( rc==SQLITE4_OK ) rc = xApply(pCtx, aKey, nKey, aData, nData);
+    }
+    p->iCommit = iCommit;
+    p->iMeta = kvlogGet32(&aPayload[8]);
+  }
+  fclose(f);
+  sqlite4_free(p->pEnv, a);
+
+  if( rc==SQLITE4_OK ){
+    p->nLogSize = nSize - nLeft;
+    if( nLeft>0 ){
+      rc = kvlogTruncate(p->pLog, p->nLogSize);
+      if( rc==SQLITE4_OK ) rc = kvlogSyncLog(p);
+    }
+    *piMeta = p->iMeta;
+  }
+  return rc;
+}
+
+/*
+** Start a new frame for the transaction being committed.
+*/
+static int kvlogBeginFrame(KVMemLog *p){
+  int rc;
+  assert( p->iPending<0 );
+  rc = kvlogReserve(p->pEnv, &p->aBuf, &p->nAlloc,
+                    (i64)p->nBuf + KVMEMLOG_FRAMEHDR + KVMEMLOG_COMMITHDR);
+  if( rc==SQLITE4_OK ){
+    p->iPending = p->nBuf;
+    p->nBuf += KVMEMLOG_FRAMEHDR + KVMEMLOG_COMMITHDR;
+  }
+  return rc;
+}
+
+/*
+** Add a change to the frame for the transaction being committed.  aData
+** is NULL if the entry was deleted.
+**
+** If an earlier write to the log failed, that error is returned and the
+** transaction should be rolled back, as it could not be made durable.
+*/
+int sqlite4KVMemLogAppend(
+  KVMemLog *p,
+  const KVByteArray *aKey, KVSize nKey,
+  const KVByteArray *aData, KVSize nData
+){
+  int rc = p->rcErr;
+  if( rc==SQLITE4_OK && p->iPending<0 ) rc = kvlogBeginFrame(p);
+  if( rc==SQLITE4_OK ){
+    rc = kvlogReserve(p->pEnv, &p->aBuf, &p->nAlloc,
+                      (i64)p->nBuf + nKey + nData + 18);
+  }
+  if( rc==SQLITE4_OK ){
+    p->nBuf += kvlogPutEntry(&p->aBuf[p->nBuf], 1, aKey, nKey, aData, nData);
+  }
+  return rc;
+}
+
+/*
+** Discard the frame for the transaction being committed, if any.
+*/
+void sqlite4KVMemLogAbort(KVMemLog *p){
+  if( p->iPending>=0 ){
+    p->nBuf = p->iPending;
+    p->iPending = -1;
+  }
+}
+
+/*
+** The transaction whose changes were passed to sqlite4KVMemLogAppend() has
+** committed, leaving the meta value iMeta.  Seal its frame and write or
+** sync the log as required by the synchronous level.  A transaction that
+** changed nothing but the meta value is logged too.
+**
+** An error here is remembered and returned by later calls to
+** sqlite4KVMemLogAppend(), so nothing more is committed until the store
+** is reopened, which recovers every transaction before the failed one.
+*/
+int sqlite4KVMemLogCommit(KVMemLog *p, unsigned int iMeta){
+  u8 *aFrame;
+  int rc;
+
+  if( p->rcErr ) return p->rcErr;
+  if( p->iPending<0 ){
+    if( iMeta==p->iMeta ) return SQLITE4_OK;
+    rc = kvlogBeginFrame(p);
+    if( rc!=SQLITE4_OK ) return rc;
+  }
+  aFrame = &p->aBuf[p->iPending];
+  p->iCommit++;
+  p->iMeta = iMeta;
+  kvlogPut64(&aFrame[KVMEMLOG_FRAMEHDR], p->iCommit);
+  kvlogPut32(&aFrame[KVMEMLOG_FRAMEHDR+8], iMeta);
+  kvlogSealFrame(aFrame, p->nBuf - p->iPending - KVMEMLOG_FRAMEHDR);
+  p->nLogSize += p->nBuf - p->iPending;
+  p->iPending = -1;
+
+  switch( p->eSync ){
+    case 0:
+      rc = SQLITE4_OK;
+      if( p->nBuf>=p->nGroup ) rc = kvlogWrite(p);
+      break;
+    case 1:
+      rc = kvlogWrite(p);
+      if( rc==SQLITE4_OK && p->nUnsynced>=p->nGroup ) rc = kvlogSyncLog(p);
+      break;
+    default:
+      rc = kvlogWrite(p);
+      if( rc==SQLITE4_OK ) rc = kvlogSyncLog(p);
+      break;
+  }
+  p->rcErr = rc;
+  return rc;
+}
+
+/*
+** Return true if the log has grown enough that a snapshot should be
+** written.
+*/
+int sqlite4KVMemLogWantSnapshot(KVMemLog *p){
+  return p->nSnapshot>0
+      && p->nLogSize>=p->nSnapshot
+      && p->nLogSize>=p->nSnapSize;
+}
+
+/*
+** Write the buffered snapshot entries as a frame.
+*/
+static int kvlogSnapshotFlush(KVMemLog *p){
+  if( p->nFrame>KVMEMLOG_FRAMEHDR ){
+    kvlogSealFrame(p->aFrame, p->nFrame - KVMEMLOG_FRAMEHDR);
+    if( fwrite(p->aFrame, 1, p->nFrame, p->pSnap)!=(size_t)p->nFrame ){
+      return SQLITE4_IOERR;
+    }
+  }
+  p->nFrame = KVMEMLOG_FRAMEHDR;
+  return SQLITE4_OK;
+}
+
+/*
+** Begin writing a snapshot of nEntry entries.  The entries are passed in
+** key order to sqlite4KVMemLogSnapshotWrite(), and then
+** sqlite4KVMemLogSnapshotEnd() must be called, whether or not an error
+** occurred.  No transaction may be in the middle of committing.
+*/
+int sqlite4KVMemLogSnapshotBegin(KVMemLog *p, i64 nEntry){
+  u8 aHdr[KVMEMLOG_HDRSIZE];
+  u8 *a;
+  int rc;
+
+  assert( p->iPending<0 && p->pSnap==0 );
+  p->pSnap = fopen(p->zSnapTmp, "wb");
+  if( p->pSnap==0 ) return SQLITE4_CANTOPEN;
+  kvlogFileHeader(aHdr, "KVMEMSNP");
+  if( fwrite(aHdr, 1, KVMEMLOG_HDRSIZE, p->pSnap)!=KVMEMLOG_HDRSIZE ){
+    return SQLITE4_IOERR;
+  }
+  rc = kvlogReserve(p->pEnv, &p->aFrame, &p->nFrameAlloc,
+                    KVMEMLOG_SNAPFRAME + KVMEMLOG_FRAMEHDR);
+  if( rc!=SQLITE4_OK ) return rc;
+  a = &p->aFrame[KVMEMLOG_FRAMEHDR];
+  kvlogPut64(a, p->iCommit);
+  kvlogPut32(&a[8], p->iMeta);
+  kvlogPut64(&a[12], (u64)nEntry);
+  p->nFrame = KVMEMLOG_FRAMEHDR + KVMEMLOG_SNAPHDR;
+  return kvlogSnapshotFlush(p);
+}
+
+/*
+** Add an entry to the snapshot being written.
+*/
+int sqlite4KVMemLogSnapshotWrite(
+  KVMemLog *p,
+  const KVByteArray *aKey, KVSize nKey,
+  const KVByteArray *aData, KVSize nData
+){
+  int rc = kvlogReserve(p->pEnv, &p->aFrame, &p->nFrameAlloc,
+                        (i64)p->nFrame + nKey + nData + 18);
+  if( rc==SQLITE4_OK ){
+    p->nFrame += kvlogPutEntry(&p->aFrame[p->nFrame], 0,
+                               aKey, nKey, aData, nData);
+    if( p->nFrame>=KVMEMLOG_SNAPFRAME ) rc = kvlogSnapshotFlush(p);
+  }
+  return rc;
+}
+
+/*
+** Finish writing a snapshot.  If rc is SQLITE4_OK, make the snapshot
+** durable, install it in place of the previous one, and empty the log.
+** Otherwise discard it.  Return the final error code.
+**
+** The snapshot includes every committed transaction, so frames buffered
+** but not yet written under sync=off are discarded too.
+*/
+int sqlite4KVMemLogSnapshotEnd(KVMemLog *p, int rc){
+  i64 nSize = 0;
+
+  if( p->pSnap ){
+    if( rc==SQLITE4_OK ) rc = kvlogSnapshotFlush(p);
+    if( rc==SQLITE4_OK ){
+      nSize = kvlogTell(p->pSnap);
+      rc = kvlogSync(p->pSnap);
+    }
+    if( fclose(p->pSnap) && rc==SQLITE4_OK ) rc = SQLITE4_IOERR;
+    p->pSnap = 0;
+    p->nFrame = 0;
+  }
+  if( rc==SQLITE4_OK ) rc = kvlogRename(p->zSnapTmp, p->zSnap);
+  if( rc!=SQLITE4_OK ){
+    remove(p->zSnapTmp);
+    /* Do not try again until the log has doubled in size */
+    p->nSnapSize = p->nLogSize*2;
+    return rc;
+  }
+  kvlogSyncDir(p->pEnv, p->zSnap);
+  p->nSnapSize = nSize;
+
+  /* Frames left in the log have sequence numbers no greater than the
+  ** snapshot's and are skipped by replay, so failing to truncate the log
+  ** is harmless beyond the space it uses. */
+  p->nBuf = 0;
+  p->nLogSize = KVMEMLOG_HDRSIZE;
+  rc = kvlogTruncate(p->pLog, KVMEMLOG_HDRSIZE);
+  if( rc==SQLITE4_OK ) rc = kvlogSyncLog(p);
+  return rc;
+}
+
+/*
+** Query or change the synchronous level.  If eSync is 0, 1 or 2, set the
+** level to OFF, NORMAL or FULL.  Return the current level.
+*/
+int sqlite4KVMemLogSynchronous(KVMemLog *p, int eSync){
+  if( eSync>=0 && eSync<=2 ) p->eSync = eSync;
+  return p->eSync;
+}
+
+/*
+** Write and sync any buffered frames and close the log.
+*/
+int sqlite4KVMemLogClose(KVMemLog *p){
+  sqlite4_env *pEnv;
+  int rc = SQLITE4_OK;
+  if( p==0 ) return SQLITE4_OK;
+  pEnv = p->pEnv;
+  sqlite4KVMemLogSnapshotClose(p);
+  if( p->pLog ){
+    sqlite4KVMemLogAbort(p);
+    if( p->rcErr==SQLITE4_OK ){
+      rc = kvlogWrite(p);
+      if( rc==SQLITE4_OK && p->nUnsynced>0 ) rc = kvlogSyncLog(p);
+    }
+    if( fclose(p->pLog) && rc==SQLITE4_OK ) rc = SQLITE4_IOERR;
+  }
+  sqlite4_free(pEnv, p->zLog);
+  sqlite4_free(pEnv, p->zSnap);
+  sqlite4_free(pEnv, p->zSnapTmp);
+  sqlite4_free(pEnv, p->aBuf);
+  sqlite4_free(pEnv, p->aFrame);
+  sqlite4_free(pEnv, p);
+  return rc;
+}
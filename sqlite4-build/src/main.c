@@ -160,6 +160,25 @@ int sqlite4_db_config(sqlite4 *db, int op, ...){
       rc = setupLookaside(db, pBuf, sz, cnt);
       break;
     }
+    case SQLITE4_DBCONFIG_LOCK_RETRY:
+    case SQLITE4_DBCONFIG_LOCK_BACKOFF:
+    case SQLITE4_DBCONFIG_SEEK_BATCH: {
+      int iVal = va_arg(ap, int);
+      int *pRes = va_arg(ap, int*);
+      int *piSetting;
+      if( op==SQLITE4_DBCONFIG_LOCK_RETRY ){
+        piSetting = &db->nLockRetry;
+      }else if( op==SQLITE4_DBCONFIG_LOCK_BACKOFF ){
+        piSetting = &db->nLockBackoff;
+      }else{
+        piSetting = &db->nSeekBatch;
+        if( iVal>SQLITE4_MAX_SEEKBATCH ) iVal = SQLITE4_MAX_SEEKBATCH;
+      }
+      if( iVal>=0 ) *piSetting = iVal;
+      if( pRes ) *pRes = *piSetting;
+      rc = SQLITE4_OK;
+      break;
+    }
     default: {
       static const struct {
         int op;      /* The opcode */
@@ -365,6 +384,10 @@ int sqlite4_close(sqlite4 *db, unsigned int flags){
   if( !sqlite4SafetyCheckSickOrOk(db) ){
     return SQLITE4_MISUSE_BKPT;
   }
+  if( db->pPoolConn ){
+    /* Pooled connections are closed by the pool. */
+    return SQLITE4_MISUSE_BKPT;
+  }
   sqlite4_mutex_enter(db->mutex);
 
   /* Force xDestroy calls on all virtual tables */
@@ -510,9 +533,14 @@ const char *sqlite4ErrStr(int rc){
 
 /*
 ** Cause any pending operation to stop at its earliest opportunity.
+**
+** This may be called from a signal handler, so it must not take any
+** mutex. Asynchronous jobs notice the change to db->iInterrupt when they
+** are next taken from the run queue.
 */
 void sqlite4_interrupt(sqlite4 *db){
   db->u1.isInterrupted = 1;
+  SQLITE4_ATOMIC_INCR_INT(&db->iInterrupt);
 }
 
 
@@ -812,6 +840,8 @@ static const int aHardLimit[] = {
   SQLITE4_MAX_LIKE_PATTERN_LENGTH,
   SQLITE4_MAX_VARIABLE_NUMBER,
   SQLITE4_MAX_TRIGGER_DEPTH,
+  SQLITE4_MAX_WORKER_THREADS,
+  SQLITE4_MAX_SORTER_SIZE,
 };
 
 /*
@@ -847,6 +877,12 @@ static const int aHardLimit[] = {
 #if SQLITE4_MAX_TRIGGER_DEPTH<1
 # error SQLITE4_MAX_TRIGGER_DEPTH must be at least 1
 #endif
+#if SQLITE4_MAX_WORKER_THREADS<0 || SQLITE4_MAX_WORKER_THREADS>50
+# error SQLITE4_MAX_WORKER_THREADS must be between 0 and 50
+#endif
+#if SQLITE4_MAX_SORTER_SIZE<1
+# error SQLITE4_MAX_SORTER_SIZE must be at least 1
+#endif
 
 
 /*
@@ -880,7 +916,9 @@ int sqlite4_limit(sqlite4 *db, int limitId, int newLimit){
                                                SQLITE4_MAX_LIKE_PATTERN_LENGTH );
   assert( aHardLimit[SQLITE4_LIMIT_VARIABLE_NUMBER]==SQLITE4_MAX_VARIABLE_NUMBER);
   assert( aHardLimit[SQLITE4_LIMIT_TRIGGER_DEPTH]==SQLITE4_MAX_TRIGGER_DEPTH );
-  assert( SQLITE4_LIMIT_TRIGGER_DEPTH==(SQLITE4_N_LIMIT-1) );
+  assert( aHardLimit[SQLITE4_LIMIT_WORKER_THREADS]==SQLITE4_MAX_WORKER_THREADS );
+  assert( aHardLimit[SQLITE4_LIMIT_SORTER_SIZE]==SQLITE4_MAX_SORTER_SIZE );
+  assert( SQLITE4_LIMIT_SORTER_SIZE==(SQLITE4_N_LIMIT-1) );
 
 
   if( limitId<0 || limitId>=SQLITE4_N_LIMIT ){
@@ -1137,6 +1175,7 @@ static int openDatabase(
       db = 0;
       goto opendb_out;
     }
+    sqlite4MutexTag(db->mutex, "db.mutex");
   }
   sqlite4_mutex_enter(db->mutex);
   db->nDb = 2;
@@ -1145,8 +1184,12 @@ static int openDatabase(
 
   assert( sizeof(db->aLimit)==sizeof(aHardLimit) );
   memcpy(db->aLimit, aHardLimit, sizeof(db->aLimit));
+  db->aLimit[SQLITE4_LIMIT_WORKER_THREADS] = SQLITE4_DEFAULT_WORKER_THREADS;
+  db->aLimit[SQLITE4_LIMIT_SORTER_SIZE] = SQLITE4_DEFAULT_SORTER_SIZE;
   db->nextAutovac = -1;
   db->nextPagesize = 0;
+  db->nLockRetry = SQLITE4_DEFAULT_LOCK_RETRY;
+  db->nLockBackoff = SQLITE4_DEFAULT_LOCK_BACKOFF;
   db->flags |=  SQLITE4_AutoIndex
                  | SQLITE4_EnableTrigger
                  | SQLITE4_ForeignKeys
@@ -1402,9 +1445,15 @@ int sqlite4_kvstore_control(
     }
   }
 
-  /* If the named key-value store was located, invoke its xControl() method. */
+  /* If the named key-value store was located, invoke its xControl() method.
+  ** SQLITE4_KVCTRL_MAP_WRITE works the same way for every store, using
+  ** only the cursor methods, so it is handled here.  */
   if( pKV ){
-    rc = pKV->pStoreVfunc->xControl(pKV, op, pArg);
+    if( op==SQLITE4_KVCTRL_MAP_WRITE ){
+      rc = sqlite4KVMapWrite(pKV, (const char*)pArg);
+    }else{
+      rc = pKV->pStoreVfunc->xControl(pKV, op, pArg);
+    }
   }
 
   sqlite4_mutex_leave(db->mutex);
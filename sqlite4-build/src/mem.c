@@ -722,6 +722,11 @@ sqlite4_mm *sqlite4_mm_new(sqlite4_mm_type eType, ...){
       pMM = mmStatsNew(p);
       break;
     }
+    case SQLITE4_MM_THREADCACHE: {
+      sqlite4_mm *p = va_arg(ap, sqlite4_mm*);
+      pMM = sqlite4MMThreadCacheNew(p);
+      break;
+    }
     default: {
       pMM = 0;
       break;
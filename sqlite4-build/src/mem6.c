@@ -0,0 +1,574 @@
+/*
+** 2026-10-18
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file contains the implementation of the SQLITE4_MM_THREADCACHE
+** memory allocator object.  It is created by:
+**
+**     sqlite4_mm_new(SQLITE4_MM_THREADCACHE, sqlite4_mm *pBase);
+**
+** and installed using sqlite4_env_config(SQLITE4_ENVCONFIG_SETMM).  If
+** pBase is NULL, the SQLITE4_MM_SYSTEM allocator is used.  pBase must be
+** threadsafe.
+**
+** Requests of up to MMTC_MAX_CACHED bytes are rounded up to one of
+** MMTC_NCLASS size classes.  Each thread that allocates memory is bound
+** to its own MmtcCache object, which holds one free-list per size class.
+** Allocation and deallocation of blocks owned by the calling thread's
+** cache take no locks.
+**
+** A block freed by a thread other than the one that allocated it is
+** pushed onto the owning cache's "remote" list, which is the only part
+** of a cache protected by a mutex.  The owner moves remote blocks onto
+** its own free-lists the next time one of those lists runs dry.
+**
+** When a cache free-list grows beyond its limit (about MMTC_CACHE_BYTES),
+** half of it is moved to a global pool in a single step.  Caches that
+** run dry refill from the global pool in batches before carving new
+** blocks from MMTC_CHUNK byte chunks obtained from pBase.  When a thread
+** exits, its free-lists are returned to the global pool and the cache
+** object is kept for reuse by the next new thread.
+**
+** Chunks are only returned to pBase when the allocator is destroyed.
+** Requests larger than MMTC_MAX_CACHED bytes are passed through to pBase.
+*/
+#include "sqliteInt.h"
+
+/*
+** Parameters for the thread-caching allocator.
+*/
+#ifndef SQLITE4_MMTC_CHUNK
+# define SQLITE4_MMTC_CHUNK       (128*1024)
+#endif
+#ifndef SQLITE4_MMTC_CACHE_BYTES
+# define SQLITE4_MMTC_CACHE_BYTES (64*1024)
+#endif
+#define MMTC_CHUNK        SQLITE4_MMTC_CHUNK
+#define MMTC_CACHE_BYTES  SQLITE4_MMTC_CACHE_BYTES
+#define MMTC_MAX_CACHED   32768     /* Largest cached allocation size */
+#define MMTC_NCLASS       40        /* Number of size classes */
+#define MMTC_LARGE        MMTC_NCLASS /* iClass value for pass-through */
+
+#if MMTC_CHUNK<2*(MMTC_MAX_CACHED+64)
+# error "SQLITE4_MMTC_CHUNK is too small"
+#endif
+
+typedef struct MmtcBlock MmtcBlock;
+typedef struct MmtcCache MmtcCache;
+typedef struct MmtcChunk MmtcChunk;
+typedef union MmtcHdr MmtcHdr;
+struct mmThreadCache;
+
+/*
+** Thread primitives.  The allocator sits underneath sqlite4_mutex (which
+** allocates its own memory), so it uses the native primitives directly.
+*/
+#if SQLITE4_THREADSAFE>0 && defined(SQLITE4_MUTEX_PTHREADS)
+#include <pthread.h>
+typedef pthread_mutex_t MmtcMutex;
+typedef pthread_key_t MmtcTls;
+# define mmtcMutexInit(X)   pthread_mutex_init(X, 0)
+# define mmtcMutexFree(X)   pthread_mutex_destroy(X)
+# define mmtcMutexEnter(X)  pthread_mutex_lock(X)
+# define mmtcMutexLeave(X)  pthread_mutex_unlock(X)
+# define mmtcTlsGet(P)      ((MmtcCache*)pthread_getspecific((P)->tls))
+# define mmtcTlsSet(P,X)    pthread_setspecific((P)->tls, (void*)(X))
+
+#elif SQLITE4_THREADSAFE>0 && defined(SQLITE4_MUTEX_W32)
+#include <windows.h>
+typedef CRITICAL_SECTION MmtcMutex;
+typedef DWORD MmtcTls;
+# define mmtcMutexInit(X)   InitializeCriticalSection(X)
+# define mmtcMutexFree(X)   DeleteCriticalSection(X)
+# define mmtcMutexEnter(X)  EnterCriticalSection(X)
+# define mmtcMutexLeave(X)  LeaveCriticalSection(X)
+# define mmtcTlsGet(P)      ((MmtcCache*)FlsGetValue((P)->tls))
+# define mmtcTlsSet(P,X)    FlsSetValue((P)->tls, (PVOID)(X))
+
+#else
+typedef int MmtcMutex;
+typedef MmtcCache *MmtcTls;
+# define mmtcMutexInit(X)
+# define mmtcMutexFree(X)
+# define mmtcMutexEnter(X)
+# define mmtcMutexLeave(X)
+# define mmtcTlsGet(P)      ((P)->tls)
+# define mmtcTlsSet(P,X)    ((P)->tls = (X))
+#endif
+
+/*
+** Every allocation is preceded by one of these.  The union keeps the
+** allocation itself 8-byte aligned on 32-bit systems.
+*/
+union MmtcHdr {
+  struct {
+    MmtcCache *pOwner;        /* Cache that handed out this block */
+    int iClass;               /* Size class, or MMTC_LARGE */
+  } s;
+  i64 aAlign[2];
+};
+
+/* A free block.  Overlays the allocation that follows the MmtcHdr. */
+struct MmtcBlock {
+  MmtcBlock *pNext;           /* Next block on the same list */
+};
+
+/* Header of each chunk obtained from pBase */
+struct MmtcChunk {
+  MmtcChunk *pNext;           /* Next chunk belonging to the allocator */
+};
+
+/*
+** Per-thread cache.  Only the thread the cache is bound to accesses
+** fields other than pRemote, which is protected by the mutex.
+*/
+struct MmtcCache {
+  struct mmThreadCache *pMM;  /* Allocator this cache belongs to */
+  MmtcCache *pNext;           /* Next cache in mmThreadCache.pAll list */
+  MmtcCache *pNextIdle;       /* Next cache in mmThreadCache.pIdle list */
+  MmtcMutex mutex;            /* Mutex protecting pRemote */
+  MmtcBlock *pRemote;         /* Blocks freed by other threads */
+  u8 *pCarve;                 /* Next unused byte of current chunk */
+  u8 *pCarveEnd;              /* One byte past end of current chunk */
+  MmtcBlock *aFree[MMTC_NCLASS];  /* Free-list for each size class */
+  int anFree[MMTC_NCLASS];        /* Number of entries on each aFree[] */
+};
+
+/*
+** The allocator object.  The mutex protects pAll, pIdle, pChunk and the
+** global pool (aPool[] and anPool[]).  The remaining fields are constant.
+*/
+struct mmThreadCache {
+  sqlite4_mm base;            /* Base class.  Must be first. */
+  sqlite4_mm *pBase;          /* Underlying allocator */
+  MmtcTls tls;                /* Thread-local pointer to bound MmtcCache */
+  MmtcMutex mutex;            /* Mutex protecting global state */
+  MmtcCache *pAll;            /* All caches created by this allocator */
+  MmtcCache *pIdle;           /* Caches not bound to any thread */
+  MmtcChunk *pChunk;          /* All chunks obtained from pBase */
+  MmtcBlock *aPool[MMTC_NCLASS];  /* Global pool, one list per class */
+  int anPool[MMTC_NCLASS];        /* Number of entries on each aPool[] */
+  int aSize[MMTC_NCLASS];         /* Allocation size for each class */
+  int anMax[MMTC_NCLASS];         /* Cache free-list limit for each class */
+};
+
+#define mmtcHdr(pAlloc)    (&((MmtcHdr*)(pAlloc))[-1])
+#define mmtcBlock(pHdr)    ((MmtcBlock*)&((MmtcHdr*)(pHdr))[1])
+
+/*
+** Return the size class for a request of n bytes, where n is no greater
+** than MMTC_MAX_CACHED.  Requests of up to 128 bytes are rounded to a
+** multiple of 16.  Above that there are four classes for each power of two.
+*/
+static int mmtcClass(sqlite4_size_t n){
+  int iLog;
+  if( n<=128 ) return n ? (int)((n-1)>>4) : 0;
+  n--;
+  for(iLog=7; (n>>(iLog+1))!=0; iLog++);
+  return 8 + (iLog-7)*4 + (int)((n>>(iLog-2)) & 3);
+}
+
+/*
+** Return the allocation size of class iClass.  This is the inverse of
+** mmtcClass().
+*/
+static int mmtcClassSize(int iClass){
+  int iLog;
+  if( iClass<8 ) return (iClass+1)*16;
+  iLog = 7 + (iClass-8)/4;
+  return (1<<iLog) + ((iClass-8)%4 + 1)*(1<<(iLog-2));
+}
+
+/*
+** Move all blocks on the remote list of pCache onto its free-lists.
+*/
+static void mmtcDrainRemote(MmtcCache *pCache){
+  MmtcBlock *pList;
+  mmtcMutexEnter(&pCache->mutex);
+  pList = pCache->pRemote;
+  pCache->pRemote = 0;
+  mmtcMutexLeave(&pCache->mutex);
+  while( pList ){
+    MmtcBlock *pNext = pList->pNext;
+    int iClass = mmtcHdr(pList)->s.iClass;
+    pList->pNext = pCache->aFree[iClass];
+    pCache->aFree[iClass] = pList;
+    pCache->anFree[iClass]++;
+    pList = pNext;
+  }
+}
+
+/*
+** Move all but the first nKeep blocks on free-list iClass of pCache to
+** the global pool.
+*/
+static void mmtcRelease(
+  struct mmThreadCache *p,
+  MmtcCache *pCache,
+  int iClass,
+  int nKeep
+){
+  MmtcBlock *pFirst;
+  MmtcBlock *pLast;
+  int n = pCache->anFree[iClass] - nKeep;
+
+  if( n<=0 ) return;
+  if( nKeep==0 ){
+    pFirst = pCache->aFree[iClass];
+    pCache->aFree[iClass] = 0;
+  }else{
+    MmtcBlock *pSplit = pCache->aFree[iClass];
+    int i;
+    for(i=1; i<nKeep; i++) pSplit = pSplit->pNext;
+    pFirst = pSplit->pNext;
+    pSplit->pNext = 0;
+  }
+  for(pLast=pFirst; pLast->pNext; pLast=pLast->pNext);
+  pCache->anFree[iClass] = nKeep;
+
+  mmtcMutexEnter(&p->mutex);
+  pLast->pNext = p->aPool[iClass];
+  p->aPool[iClass] = pFirst;
+  p->anPool[iClass] += n;
+  mmtcMutexLeave(&p->mutex);
+}
+
+/*
+** Carve a new block of class iClass from the current chunk of pCache,
+** obtaining a new chunk from pBase if required.  The new block is added
+** to the cache free-list.  Return SQLITE4_OK on success, or SQLITE4_NOMEM
+** if a new chunk is required and cannot be allocated.
+*/
+static int mmtcCarve(struct mmThreadCache *p, MmtcCache *pCache, int iClass){
+  int nReq = sizeof(MmtcHdr) + p->aSize[iClass];
+  MmtcHdr *pHdr;
+  MmtcBlock *pBlock;
+
+  if( (int)(pCache->pCarveEnd - pCache->pCarve)<nReq ){
+    MmtcChunk *pChunk;
+    int nAvail;
+
+    /* Use what is left of the current chunk for smaller classes. */
+    nAvail = (int)(pCache->pCarveEnd - pCache->pCarve) - (int)sizeof(MmtcHdr);
+    while( nAvail>=16 ){
+      int iFit = mmtcClass(nAvail);
+      if( p->aSize[iFit]>nAvail ) iFit--;
+      pHdr = (MmtcHdr*)pCache->pCarve;
+      pHdr->s.iClass = iFit;
+      pBlock = mmtcBlock(pHdr);
+      pBlock->pNext = pCache->aFree[iFit];
+      pCache->aFree[iFit] = pBlock;
+      pCache->anFree[iFit]++;
+      pCache->pCarve += sizeof(MmtcHdr) + p->aSize[iFit];
+      nAvail -= sizeof(MmtcHdr) + p->aSize[iFit];
+    }
+
+    pChunk = (MmtcChunk*)sqlite4_mm_malloc(p->pBase, MMTC_CHUNK);
+    if( pChunk==0 ) return SQLITE4_NOMEM;
+    mmtcMutexEnter(&p->mutex);
+    pChunk->pNext = p->pChunk;
+    p->pChunk = pChunk;
+    mmtcMutexLeave(&p->mutex);
+    pCache->pCarve = ((u8*)pChunk) + sizeof(MmtcHdr);
+    pCache->pCarveEnd = ((u8*)pChunk) + MMTC_CHUNK;
+  }
+
+  pHdr = (MmtcHdr*)pCache->pCarve;
+  pHdr->s.iClass = iClass;
+  pBlock = mmtcBlock(pHdr);
+  pBlock->pNext = pCache->aFree[iClass];
+  pCache->aFree[iClass] = pBlock;
+  pCache->anFree[iClass]++;
+  pCache->pCarve += nReq;
+  return SQLITE4_OK;
+}
+
+/*
+** Free-list iClass of pCache is empty.  Refill it from the remote list,
+** the global pool or a chunk, in that order of preference.
+*/
+static int mmtcRefill(struct mmThreadCache *p, MmtcCache *pCache, int iClass){
+  if( pCache->pRemote ){
+    mmtcDrainRemote(pCache);
+    if( pCache->aFree[iClass] ) return SQLITE4_OK;
+  }
+
+  if( p->anPool[iClass] ){
+    MmtcBlock *pFirst;
+    MmtcBlock *pLast = 0;
+    int n = 0;
+    mmtcMutexEnter(&p->mutex);
+    pFirst = p->aPool[iClass];
+    if( pFirst ){
+      int nBatch = p->anMax[iClass]/2;
+      for(pLast=pFirst, n=1; n<nBatch && pLast->pNext; n++){
+        pLast = pLast->pNext;
+      }
+      p->aPool[iClass] = pLast->pNext;
+      p->anPool[iClass] -= n;
+    }
+    mmtcMutexLeave(&p->mutex);
+    if( pFirst ){
+      pLast->pNext = 0;
+      pCache->aFree[iClass] = pFirst;
+      pCache->anFree[iClass] = n;
+      return SQLITE4_OK;
+    }
+  }
+
+  return mmtcCarve(p, pCache, iClass);
+}
+
+/*
+** Return the cache bound to the calling thread, creating or adopting
+** one if there is none.  Return NULL if a cache cannot be allocated.
+*/
+static MmtcCache *mmtcBind(struct mmThreadCache *p){
+  MmtcCache *pCache;
+
+  mmtcMutexEnter(&p->mutex);
+  pCache = p->pIdle;
+  if( pCache ){
+    p->pIdle = pCache->pNextIdle;
+    pCache->pNextIdle = 0;
+  }
+  mmtcMutexLeave(&p->mutex);
+
+  if( pCache==0 ){
+    pCache = (MmtcCache*)sqlite4_mm_malloc(p->pBase, sizeof(MmtcCache));
+    if( pCache==0 ) return 0;
+    memset(pCache, 0, sizeof(MmtcCache));
+    pCache->pMM = p;
+    mmtcMutexInit(&pCache->mutex);
+    mmtcMutexEnter(&p->mutex);
+    pCache->pNext = p->pAll;
+    p->pAll = pCache;
+    mmtcMutexLeave(&p->mutex);
+  }
+
+  mmtcTlsSet(p, pCache);
+  return pCache;
+}
+
+/*
+** Called when a thread bound to cache pArg exits.  Return the contents
+** of its free-lists to the global pool and make the cache available to
+** other threads.
+*/
+static void mmtcThreadExit(void *pArg){
+  MmtcCache *pCache = (MmtcCache*)pArg;
+  struct mmThreadCache *p;
+  int i;
+
+  if( pCache==0 ) return;
+  p = pCache->pMM;
+  mmtcDrainRemote(pCache);
+  for(i=0; i<MMTC_NCLASS; i++){
+    mmtcRelease(p, pCache, i, 0);
+  }
+  mmtcMutexEnter(&p->mutex);
+  pCache->pNextIdle = p->pIdle;
+  p->pIdle = pCache;
+  mmtcMutexLeave(&p->mutex);
+}
+
+#if SQLITE4_THREADSAFE>0 && defined(SQLITE4_MUTEX_W32) \
+ && !defined(SQLITE4_MUTEX_PTHREADS)
+static VOID WINAPI mmtcFlsCallback(PVOID pArg){
+  mmtcThreadExit((void*)pArg);
+}
+#endif
+
+/*
+** Allocate a request too large to be cached directly from pBase.
+*/
+static void *mmtcMallocLarge(struct mmThreadCache *p, sqlite4_size_t iSz){
+  MmtcHdr *pHdr;
+  pHdr = (MmtcHdr*)sqlite4_mm_malloc(p->pBase, iSz + sizeof(MmtcHdr));
+  if( pHdr==0 ) return 0;
+  pHdr->s.pOwner = 0;
+  pHdr->s.iClass = MMTC_LARGE;
+  return (void*)&pHdr[1];
+}
+
+static void *mmtcMalloc(sqlite4_mm *pMM, sqlite4_size_t iSz){
+  struct mmThreadCache *p = (struct mmThreadCache*)pMM;
+  MmtcCache *pCache;
+  MmtcBlock *pBlock;
+  int iClass;
+
+  if( iSz>MMTC_MAX_CACHED ) return mmtcMallocLarge(p, iSz);
+  iClass = mmtcClass(iSz);
+  pCache = mmtcTlsGet(p);
+  if( pCache==0 && (pCache = mmtcBind(p))==0 ) return 0;
+  if( pCache->aFree[iClass]==0 && mmtcRefill(p, pCache, iClass) ) return 0;
+
+  pBlock = pCache->aFree[iClass];
+  pCache->aFree[iClass] = pBlock->pNext;
+  pCache->anFree[iClass]--;
+  mmtcHdr(pBlock)->s.pOwner = pCache;
+  return (void*)pBlock;
+}
+
+static void mmtcFree(sqlite4_mm *pMM, void *pOld){
+  struct mmThreadCache *p = (struct mmThreadCache*)pMM;
+  MmtcHdr *pHdr;
+  MmtcCache *pOwner;
+  MmtcBlock *pBlock;
+  int iClass;
+
+  if( pOld==0 ) return;
+  pHdr = mmtcHdr(pOld);
+  iClass = pHdr->s.iClass;
+  if( iClass==MMTC_LARGE ){
+    sqlite4_mm_free(p->pBase, pHdr);
+    return;
+  }
+
+  pBlock = (MmtcBlock*)pOld;
+  pOwner = pHdr->s.pOwner;
+  if( pOwner==mmtcTlsGet(p) ){
+    pBlock->pNext = pOwner->aFree[iClass];
+    pOwner->aFree[iClass] = pBlock;
+    if( ++pOwner->anFree[iClass]>p->anMax[iClass] ){
+      mmtcRelease(p, pOwner, iClass, p->anMax[iClass]/2);
+    }
+  }else{
+    mmtcMutexEnter(&pOwner->mutex);
+    pBlock->pNext = pOwner->pRemote;
+    pOwner->pRemote = pBlock;
+    mmtcMutexLeave(&pOwner->mutex);
+  }
+}
+
+static sqlite4_size_t mmtcMsize(sqlite4_mm *pMM, void *pOld){
+  struct mmThreadCache *p = (struct mmThreadCache*)pMM;
+  MmtcHdr *pHdr;
+  if( pOld==0 ) return 0;
+  pHdr = mmtcHdr(pOld);
+  if( pHdr->s.iClass==MMTC_LARGE ){
+    return sqlite4_mm_msize(p->pBase, pHdr) - sizeof(MmtcHdr);
+  }
+  return p->aSize[pHdr->s.iClass];
+}
+
+static void *mmtcRealloc(sqlite4_mm *pMM, void *pOld, sqlite4_size_t iSz){
+  struct mmThreadCache *p = (struct mmThreadCache*)pMM;
+  sqlite4_size_t nOld;
+  void *pNew;
+  int iClass;
+
+  if( pOld==0 ) return mmtcMalloc(pMM, iSz);
+  iClass = mmtcHdr(pOld)->s.iClass;
+  if( iClass==MMTC_LARGE ){
+    if( iSz>MMTC_MAX_CACHED ){
+      MmtcHdr *pHdr;
+      pHdr = sqlite4_mm_realloc(p->pBase, mmtcHdr(pOld), iSz+sizeof(MmtcHdr));
+      return pHdr ? (void*)&pHdr[1] : 0;
+    }
+  }else if( iSz<=p->aSize[iClass] && iSz>p->aSize[iClass]/2 ){
+    return pOld;
+  }
+
+  pNew = mmtcMalloc(pMM, iSz);
+  if( pNew ){
+    nOld = mmtcMsize(pMM, pOld);
+    memcpy(pNew, pOld, (size_t)(nOld<iSz ? nOld : iSz));
+    mmtcFree(pMM, pOld);
+  }
+  return pNew;
+}
+
+/*
+** Destroy the allocator.  All memory obtained from it, and the pBase
+** allocator, are released.
+*/
+static void mmtcFinal(sqlite4_mm *pMM){
+  struct mmThreadCache *p = (struct mmThreadCache*)pMM;
+  sqlite4_mm *pBase = p->pBase;
+  MmtcCache *pCache;
+  MmtcChunk *pChunk;
+
+#if SQLITE4_THREADSAFE>0 && defined(SQLITE4_MUTEX_PTHREADS)
+  pthread_key_delete(p->tls);
+#elif SQLITE4_THREADSAFE>0 && defined(SQLITE4_MUTEX_W32)
+  FlsFree(p->tls);
+#endif
+
+  pCache = p->pAll;
+  while( pCache ){
+    MmtcCache *pNext = pCache->pNext;
+    mmtcMutexFree(&pCache->mutex);
+    sqlite4_mm_free(pBase, pCache);
+    pCache = pNext;
+  }
+  pChunk = p->pChunk;
+  while( pChunk ){
+    MmtcChunk *pNext = pChunk->pNext;
+    sqlite4_mm_free(pBase, pChunk);
+    pChunk = pNext;
+  }
+  mmtcMutexFree(&p->mutex);
+  sqlite4_mm_free(pBase, p);
+  sqlite4_mm_destroy(pBase);
+}
+
+static const sqlite4_mm_methods mmtcMethods = {
+  /* iVersion */    1,
+  /* xMalloc  */    mmtcMalloc,
+  /* xRealloc */    mmtcRealloc,
+  /* xFree    */    mmtcFree,
+  /* xMsize   */    mmtcMsize,
+  /* xMember  */    0,
+  /* xBenign  */    0,
+  /* xStat    */    0,
+  /* xCtrl    */    0,
+  /* xFinal   */    mmtcFinal
+};
+
+/*
+** Allocate a new thread-caching allocator on top of pBase.
+*/
+sqlite4_mm *sqlite4MMThreadCacheNew(sqlite4_mm *pBase){
+  struct mmThreadCache *p;
+  int i;
+
+  if( pBase==0 ) pBase = &sqlite4MMSystem;
+  p = (struct mmThreadCache*)sqlite4_mm_malloc(pBase, sizeof(*p));
+  if( p==0 ) return 0;
+  memset(p, 0, sizeof(*p));
+
+#if SQLITE4_THREADSAFE>0 && defined(SQLITE4_MUTEX_PTHREADS)
+  if( pthread_key_create(&p->tls, mmtcThreadExit) ){
+    sqlite4_mm_free(pBase, p);
+    return 0;
+  }
+#elif SQLITE4_THREADSAFE>0 && defined(SQLITE4_MUTEX_W32)
+  p->tls = FlsAlloc(mmtcFlsCallback);
+  if( p->tls==FLS_OUT_OF_INDEXES ){
+    sqlite4_mm_free(pBase, p);
+    return 0;
+  }
+#endif
+
+  p->base.pMethods = &mmtcMethods;
+  p->pBase = pBase;
+  mmtcMutexInit(&p->mutex);
+  for(i=0; i<MMTC_NCLASS; i++){
+    int nMax;
+    p->aSize[i] = mmtcClassSize(i);
+    assert( mmtcClass(p->aSize[i])==i );
+    nMax = MMTC_CACHE_BYTES / (p->aSize[i] + (int)sizeof(MmtcHdr));
+    p->anMax[i] = nMax<4 ? 4 : nMax;
+  }
+  assert( p->aSize[MMTC_NCLASS-1]==MMTC_MAX_CACHED );
+  return &p->base;
+}
@@ -31,6 +31,10 @@ int sqlite4MutexInit(sqlite4_env *pEnv){
     }
     pEnv->mutex.pMutexEnv = pEnv;
   }
+  if( pEnv->bMutexProf && pEnv->pMutexProf==0 ){
+    rc = sqlite4MutexProfileInstall(pEnv);
+    if( rc ) return rc;
+  }
   rc = pEnv->mutex.xMutexInit(pEnv->mutex.pMutexEnv);
   return rc;
 }
@@ -64,6 +64,7 @@
 #define sqlite4MutexAlloc(X,Y)    ((sqlite4_mutex*)8)
 #define sqlite4MutexInit(E)       SQLITE4_OK
 #define sqlite4MutexEnd(E)
+#define sqlite4MutexTag(X,Y)
 #define MUTEX_LOGIC(X)
 #else
 #define MUTEX_LOGIC(X)            X
@@ -0,0 +1,488 @@
+/*
+** 2026-10-18
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file contains the mutex contention profiler.  If an environment
+** is configured with SQLITE4_ENVCONFIG_MUTEXPROF, sqlite4MutexInit()
+** replaces its mutex methods (normally those in mutex_unix.c) with the
+** wrappers in this file.  Each dynamic mutex is then allocated as a
+** ProfMutex holding the real mutex plus its own counters.  Apart from
+** nBusy, the counters are only modified by the thread holding the mutex,
+** so recording them requires no extra locking.  They are read and written
+** using relaxed atomic operations (and nBusy is incremented atomically)
+** so that sqlite4_env_mutex_status() can read them while other threads
+** hold the mutex.  Resetting the counters of a live mutex does not write
+** them; it records a baseline that is subtracted from later readings.
+**
+** Mutexes are grouped into allocation sites by type and by the tag
+** assigned with sqlite4MutexTag().  When a mutex is freed its counters
+** are added to its site.  sqlite4_env_mutex_status() reports the sum of
+** a site and all of its live mutexes.
+**
+** Static mutexes are not profiled.
+*/
+#include "sqliteInt.h"
+
+#ifndef SQLITE4_MUTEX_OMIT
+
+#if SQLITE4_OS_WIN
+# include <windows.h>
+#else
+# include <time.h>
+#endif
+
+/*
+** Relaxed atomic operations on 64-bit counters.  Without compiler support
+** the counters are accessed directly, so readings taken while other
+** threads are using a mutex may be inaccurate.
+*/
+#if defined(__GNUC__) && defined(__ATOMIC_RELAXED)
+# define profLoad(P)    __atomic_load_n((P), __ATOMIC_RELAXED)
+# define profStore(P,V) __atomic_store_n((P), (V), __ATOMIC_RELAXED)
+# define profIncr(P)    __atomic_fetch_add((P), 1, __ATOMIC_RELAXED)
+#elif defined(_MSC_VER) && SQLITE4_OS_WIN
+# define profLoad(P) \
+    ((u64)InterlockedCompareExchange64((LONG64 volatile*)(P), 0, 0))
+# define profStore(P,V) \
+    InterlockedExchange64((LONG64 volatile*)(P), (LONG64)(V))
+# define profIncr(P)    InterlockedIncrement64((LONG64 volatile*)(P))
+#else
+# define profLoad(P)    (*(P))
+# define profStore(P,V) (*(P) = (V))
+# define profIncr(P)    ((*(P))++)
+#endif
+
+/* Add V to a counter that only the calling thread modifies */
+#define profAdd(P,V) profStore(P, profLoad(P) + (V))
+
+typedef struct ProfCounters ProfCounters;
+typedef struct ProfMutex ProfMutex;
+typedef struct ProfSite ProfSite;
+
+/* Statistics recorded for a single mutex or allocation site */
+struct ProfCounters {
+  u64 nEnter;                     /* Successful acquisitions */
+  u64 nContended;                 /* Acquisitions that had to wait */
+  u64 nBusy;                      /* Failed xMutexTry() calls */
+  u64 nWaitNs;                    /* Total wait time */
+  u64 nHoldNs;                    /* Total hold time */
+  u64 aWait[SQLITE4_MUTEX_NHIST]; /* Wait time histogram */
+  u64 aHold[SQLITE4_MUTEX_NHIST]; /* Hold time histogram */
+};
+
+/* An allocation site */
+struct ProfSite {
+  const char *zTag;               /* Tag, or NULL for untagged mutexes */
+  int eType;                      /* SQLITE4_MUTEX_FAST or _RECURSIVE */
+  int nAlloc;                     /* Mutexes allocated at this site */
+  int nLive;                      /* Mutexes not yet freed */
+  ProfCounters c;                 /* Totals of freed mutexes */
+};
+
+/* A profiled mutex */
+struct ProfMutex {
+  sqlite4_mutex base;             /* Base class.  Must be first */
+  sqlite4_mutex *pReal;           /* Underlying mutex */
+  MutexProfile *pProf;            /* Profiler this mutex belongs to */
+  int iSite;                      /* Index of site in pProf->aSite[] */
+  int nDepth;                     /* Recursion depth while held */
+  u64 iEnterNs;                   /* Time of outermost enter */
+  ProfMutex *pNext;               /* Next live mutex */
+  ProfMutex *pPrev;               /* Previous live mutex */
+  ProfCounters c;                 /* Counters for this mutex */
+  ProfCounters cBase;             /* Value of c at last reset */
+};
+
+/*
+** Profiler state for an environment.  The pLock mutex, which is not
+** itself profiled, protects pList, nSite, aSite[] and the cBase field
+** of each live mutex.
+*/
+struct MutexProfile {
+  sqlite4_env *pEnv;              /* Environment being profiled */
+  sqlite4_mutex_methods real;     /* Wrapped mutex implementation */
+  sqlite4_mutex *pLock;           /* Mutex protecting the fields below */
+  ProfMutex *pList;               /* All live profiled mutexes */
+  int nSite;                      /* Number of entries in aSite[] */
+  int nSiteAlloc;                 /* Allocated size of aSite[] */
+  ProfSite *aSite;                /* Allocation sites */
+};
+
+/*
+** Return a monotonic timestamp in nanoseconds.
+*/
+static u64 profNow(void){
+#if SQLITE4_OS_WIN
+  static LARGE_INTEGER freq;
+  LARGE_INTEGER t;
+  if( freq.QuadPart==0 ) QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&t);
+  return (u64)((double)t.QuadPart * 1.0e9 / (double)freq.QuadPart);
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (u64)ts.tv_sec*1000000000 + (u64)ts.tv_nsec;
+#endif
+}
+
+/*
+** Return the histogram bucket for an interval of nNs nanoseconds.
+*/
+static int profBucket(u64 nNs){
+  u64 nUs = nNs/1000;
+  int i;
+  if( nUs==0 ) return 0;
+  for(i=1; i<SQLITE4_MUTEX_NHIST-1 && nUs>=4; i++) nUs >>= 2;
+  return i;
+}
+
+/*
+** Copy the counters of live mutex pFrom, which other threads may be
+** updating, into *pTo.
+*/
+static void profSnapshot(ProfCounters *pTo, ProfCounters *pFrom){
+  int i;
+  pTo->nEnter = profLoad(&pFrom->nEnter);
+  pTo->nContended = profLoad(&pFrom->nContended);
+  pTo->nBusy = profLoad(&pFrom->nBusy);
+  pTo->nWaitNs = profLoad(&pFrom->nWaitNs);
+  pTo->nHoldNs = profLoad(&pFrom->nHoldNs);
+  for(i=0; i<SQLITE4_MUTEX_NHIST; i++){
+    pTo->aWait[i] = profLoad(&pFrom->aWait[i]);
+    pTo->aHold[i] = profLoad(&pFrom->aHold[i]);
+  }
+}
+
+/*
+** Add the counters of live mutex p, less the baseline recorded when they
+** were last reset, to those in pTo.
+*/
+static void profAccumulate(ProfCounters *pTo, ProfMutex *p){
+  ProfCounters c;
+  int i;
+  profSnapshot(&c, &p->c);
+  pTo->nEnter += c.nEnter - p->cBase.nEnter;
+  pTo->nContended += c.nContended - p->cBase.nContended;
+  pTo->nBusy += c.nBusy - p->cBase.nBusy;
+  pTo->nWaitNs += c.nWaitNs - p->cBase.nWaitNs;
+  pTo->nHoldNs += c.nHoldNs - p->cBase.nHoldNs;
+  for(i=0; i<SQLITE4_MUTEX_NHIST; i++){
+    pTo->aWait[i] += c.aWait[i] - p->cBase.aWait[i];
+    pTo->aHold[i] += c.aHold[i] - p->cBase.aHold[i];
+  }
+}
+
+/*
+** Return the index of the site for mutexes of type eType tagged zTag,
+** creating it if required.  If a new site cannot be allocated, return
+** the untagged site for eType, which always exists.  The caller must
+** hold pProf->pLock.
+*/
+static int profFindSite(
+  sqlite4_env *pEnv,
+  MutexProfile *pProf,
+  int eType,
+  const char *zTag
+){
+  int i;
+  for(i=0; i<pProf->nSite; i++){
+    ProfSite *pSite = &pProf->aSite[i];
+    if( pSite->eType==eType && (pSite->zTag==zTag
+     || (pSite->zTag && zTag && strcmp(pSite->zTag, zTag)==0))
+    ){
+      return i;
+    }
+  }
+  if( pProf->nSite>=pProf->nSiteAlloc ){
+    int nNew = pProf->nSiteAlloc*2 + 8;
+    ProfSite *aNew;
+    aNew = sqlite4Realloc(pEnv, pProf->aSite, nNew*(int)sizeof(ProfSite));
+    if( aNew==0 ) return eType;
+    pProf->aSite = aNew;
+    pProf->nSiteAlloc = nNew;
+  }
+  i = pProf->nSite++;
+  memset(&pProf->aSite[i], 0, sizeof(ProfSite));
+  pProf->aSite[i].zTag = zTag;
+  pProf->aSite[i].eType = eType;
+  return i;
+}
+
+/*
+** Initialize the profiler and the wrapped mutex implementation.  This
+** may be called more than once.
+*/
+static int profMutexInit(void *pMutexEnv){
+  sqlite4_env *pEnv = (sqlite4_env*)pMutexEnv;
+  MutexProfile *pProf = pEnv->pMutexProf;
+  int rc;
+
+  rc = pProf->real.xMutexInit(pProf->real.pMutexEnv);
+  if( rc==SQLITE4_OK && pProf->pLock==0 ){
+    pProf->pLock = pProf->real.xMutexAlloc(
+        pProf->real.pMutexEnv, SQLITE4_MUTEX_FAST
+    );
+    if( pProf->pLock==0 ) return SQLITE4_NOMEM;
+
+    /* Sites 0 and 1 are the untagged SQLITE4_MUTEX_FAST and
+    ** SQLITE4_MUTEX_RECURSIVE sites respectively. */
+    profFindSite(pEnv, pProf, SQLITE4_MUTEX_FAST, 0);
+    profFindSite(pEnv, pProf, SQLITE4_MUTEX_RECURSIVE, 0);
+    if( pProf->nSite!=2 ) return SQLITE4_NOMEM;
+  }
+  return rc;
+}
+
+/*
+** Shut down the profiler and the wrapped implementation, and restore
+** the original mutex methods.
+*/
+static int profMutexEnd(void *pMutexEnv){
+  sqlite4_env *pEnv = (sqlite4_env*)pMutexEnv;
+  MutexProfile *pProf = pEnv->pMutexProf;
+  int rc;
+
+  if( pProf->pLock ) pProf->real.xMutexFree(pProf->pLock);
+  rc = pProf->real.xMutexEnd(pProf->real.pMutexEnv);
+  pEnv->mutex = pProf->real;
+  pEnv->pMutexProf = 0;
+  sqlite4_free(pEnv, pProf->aSite);
+  sqlite4_free(pEnv, pProf);
+  return rc;
+}
+
+static sqlite4_mutex *profMutexAlloc(void *pMutexEnv, int iType){
+  sqlite4_env *pEnv = (sqlite4_env*)pMutexEnv;
+  MutexProfile *pProf = pEnv->pMutexProf;
+  sqlite4_mutex *pReal;
+  ProfMutex *p;
+
+  pReal = pProf->real.xMutexAlloc(pProf->real.pMutexEnv, iType);
+  if( pReal==0 || iType>SQLITE4_MUTEX_RECURSIVE ) return pReal;
+
+  p = (ProfMutex*)sqlite4MallocZero(pEnv, sizeof(ProfMutex));
+  if( p==0 ){
+    pProf->real.xMutexFree(pReal);
+    return 0;
+  }
+  p->base.pMutexMethods = &pEnv->mutex;
+  p->pReal = pReal;
+  p->pProf = pProf;
+
+  pProf->real.xMutexEnter(pProf->pLock);
+  p->iSite = iType;
+  pProf->aSite[iType].nAlloc++;
+  pProf->aSite[iType].nLive++;
+  p->pNext = pProf->pList;
+  if( p->pNext ) p->pNext->pPrev = p;
+  pProf->pList = p;
+  pProf->real.xMutexLeave(pProf->pLock);
+  return (sqlite4_mutex*)p;
+}
+
+static void profMutexFree(sqlite4_mutex *pMutex){
+  ProfMutex *p = (ProfMutex*)pMutex;
+  MutexProfile *pProf = p->pProf;
+  sqlite4_env *pEnv = pProf->pEnv;
+  ProfSite *pSite;
+
+  pProf->real.xMutexEnter(pProf->pLock);
+  if( p->pNext ) p->pNext->pPrev = p->pPrev;
+  if( p->pPrev ){
+    p->pPrev->pNext = p->pNext;
+  }else{
+    pProf->pList = p->pNext;
+  }
+  pSite = &pProf->aSite[p->iSite];
+  pSite->nLive--;
+  profAccumulate(&pSite->c, p);
+  pProf->real.xMutexLeave(pProf->pLock);
+
+  pProf->real.xMutexFree(p->pReal);
+  sqlite4_free(pEnv, p);
+}
+
+/*
+** Record a successful acquisition of p, after waiting nWaitNs
+** nanoseconds if bContended is true.  The caller holds p.
+*/
+static void profEntered(ProfMutex *p, int bContended, u64 nWaitNs){
+  profAdd(&p->c.nEnter, 1);
+  if( bContended ){
+    profAdd(&p->c.nContended, 1);
+    profAdd(&p->c.nWaitNs, nWaitNs);
+    profAdd(&p->c.aWait[profBucket(nWaitNs)], 1);
+  }
+  if( p->nDepth++==0 ) p->iEnterNs = profNow();
+}
+
+static void profMutexEnter(sqlite4_mutex *pMutex){
+  ProfMutex *p = (ProfMutex*)pMutex;
+  const sqlite4_mutex_methods *pReal = &p->pProf->real;
+  if( pReal->xMutexTry(p->pReal)==SQLITE4_OK ){
+    profEntered(p, 0, 0);
+  }else{
+    u64 iStart = profNow();
+    pReal->xMutexEnter(p->pReal);
+    profEntered(p, 1, profNow() - iStart);
+  }
+}
+
+static int profMutexTry(sqlite4_mutex *pMutex){
+  ProfMutex *p = (ProfMutex*)pMutex;
+  int rc = p->pProf->real.xMutexTry(p->pReal);
+  if( rc==SQLITE4_OK ){
+    profEntered(p, 0, 0);
+  }else{
+    /* Not holding the mutex, so other threads may update nBusy too. */
+    profIncr(&p->c.nBusy);
+  }
+  return rc;
+}
+
+static void profMutexLeave(sqlite4_mutex *pMutex){
+  ProfMutex *p = (ProfMutex*)pMutex;
+  assert( p->nDepth>0 );
+  if( --p->nDepth==0 ){
+    u64 nHoldNs = profNow() - p->iEnterNs;
+    profAdd(&p->c.nHoldNs, nHoldNs);
+    profAdd(&p->c.aHold[profBucket(nHoldNs)], 1);
+  }
+  p->pProf->real.xMutexLeave(p->pReal);
+}
+
+static int profMutexHeld(sqlite4_mutex *pMutex){
+  ProfMutex *p = (ProfMutex*)pMutex;
+  const sqlite4_mutex_methods *pReal = &p->pProf->real;
+  return pReal->xMutexHeld==0 || pReal->xMutexHeld(p->pReal);
+}
+static int profMutexNotheld(sqlite4_mutex *pMutex){
+  ProfMutex *p = (ProfMutex*)pMutex;
+  const sqlite4_mutex_methods *pReal = &p->pProf->real;
+  return pReal->xMutexNotheld==0 || pReal->xMutexNotheld(p->pReal);
+}
+
+/*
+** Wrap the mutex methods of pEnv with the profiler.  Called by
+** sqlite4MutexInit() before the mutex subsystem is initialized.
+*/
+int sqlite4MutexProfileInstall(sqlite4_env *pEnv){
+  MutexProfile *pProf;
+
+  assert( pEnv->pMutexProf==0 && pEnv->mutex.xMutexAlloc!=0 );
+  pProf = (MutexProfile*)sqlite4MallocZero(pEnv, sizeof(MutexProfile));
+  if( pProf==0 ) return SQLITE4_NOMEM;
+  pProf->pEnv = pEnv;
+  pProf->real = pEnv->mutex;
+  pEnv->pMutexProf = pProf;
+
+  pEnv->mutex.xMutexInit = profMutexInit;
+  pEnv->mutex.xMutexEnd = profMutexEnd;
+  pEnv->mutex.xMutexAlloc = profMutexAlloc;
+  pEnv->mutex.xMutexFree = profMutexFree;
+  pEnv->mutex.xMutexEnter = profMutexEnter;
+  pEnv->mutex.xMutexTry = profMutexTry;
+  pEnv->mutex.xMutexLeave = profMutexLeave;
+  pEnv->mutex.xMutexHeld = profMutexHeld;
+  pEnv->mutex.xMutexNotheld = profMutexNotheld;
+  pEnv->mutex.pMutexEnv = (void*)pEnv;
+  return SQLITE4_OK;
+}
+
+/*
+** Assign pMutex to the allocation site named zTag.  zTag must remain
+** valid for the life of the environment.  This is a no-op unless pMutex
+** is a profiled mutex.
+*/
+void sqlite4MutexTag(sqlite4_mutex *pMutex, const char *zTag){
+  if( pMutex && pMutex->pMutexMethods->xMutexEnter==profMutexEnter ){
+    ProfMutex *p = (ProfMutex*)pMutex;
+    MutexProfile *pProf = p->pProf;
+    sqlite4_env *pEnv = pProf->pEnv;
+    int eType = pProf->aSite[p->iSite].eType;
+    int iSite;
+
+    pProf->real.xMutexEnter(pProf->pLock);
+    iSite = profFindSite(pEnv, pProf, eType, zTag);
+    pProf->aSite[p->iSite].nAlloc--;
+    pProf->aSite[p->iSite].nLive--;
+    pProf->aSite[iSite].nAlloc++;
+    pProf->aSite[iSite].nLive++;
+    p->iSite = iSite;
+    pProf->real.xMutexLeave(pProf->pLock);
+  }
+}
+
+/*
+** Query the mutex profile.  See sqlite.h.in for details.
+*/
+int sqlite4_env_mutex_status(
+  sqlite4_env *pEnv,
+  int iSite,
+  sqlite4_mutex_status *pStatus,
+  int resetFlag
+){
+  MutexProfile *pProf;
+  int rc = SQLITE4_OK;
+
+  if( pEnv==0 ) pEnv = sqlite4_env_default();
+  pProf = pEnv->pMutexProf;
+  if( pProf==0 || pProf->pLock==0 ) return SQLITE4_MISUSE;
+
+  pProf->real.xMutexEnter(pProf->pLock);
+  if( iSite<0 || iSite>=pProf->nSite ){
+    rc = SQLITE4_NOTFOUND;
+  }else{
+    ProfSite *pSite = &pProf->aSite[iSite];
+    ProfCounters c;
+    ProfMutex *p;
+
+    c = pSite->c;
+    for(p=pProf->pList; p; p=p->pNext){
+      if( p->iSite==iSite ) profAccumulate(&c, p);
+    }
+
+    memset(pStatus, 0, sizeof(*pStatus));
+    pStatus->zTag = pSite->zTag;
+    pStatus->eType = pSite->eType;
+    pStatus->nAlloc = pSite->nAlloc;
+    pStatus->nLive = pSite->nLive;
+    pStatus->nEnter = c.nEnter;
+    pStatus->nContended = c.nContended;
+    pStatus->nBusy = c.nBusy;
+    pStatus->nWaitNs = c.nWaitNs;
+    pStatus->nHoldNs = c.nHoldNs;
+    memcpy(pStatus->aWait, c.aWait, sizeof(c.aWait));
+    memcpy(pStatus->aHold, c.aHold, sizeof(c.aHold));
+
+    if( resetFlag ){
+      memset(&pSite->c, 0, sizeof(ProfCounters));
+      for(p=pProf->pList; p; p=p->pNext){
+        if( p->iSite==iSite ) profSnapshot(&p->cBase, &p->c);
+      }
+    }
+  }
+  pProf->real.xMutexLeave(pProf->pLock);
+  return rc;
+}
+
+#else /* SQLITE4_MUTEX_OMIT */
+
+int sqlite4_env_mutex_status(
+  sqlite4_env *pEnv,
+  int iSite,
+  sqlite4_mutex_status *pStatus,
+  int resetFlag
+){
+  return SQLITE4_MISUSE;
+}
+
+#endif /* SQLITE4_MUTEX_OMIT */
@@ -19,6 +19,7 @@
 
 #if SQLITE4_OS_UNIX
 #include <sys/time.h>
+#include <unistd.h>
 #endif
 
 /*
@@ -60,6 +61,36 @@ int sqlite4OsCurrentTime(sqlite4_env *pEnv, sqlite4_uint64 *pTimeOut){
   return rc;
 }
 
+/*
+** Set *piOut to the current wall-clock time in microseconds. This is
+** used to measure elapsed time, so unlike sqlite4OsCurrentTime() the
+** epoch is not specified and the fake time used by tests is ignored.
+** Return SQLITE4_ERROR if no clock is available.
+*/
+int sqlite4OsMicroseconds(sqlite4_uint64 *piOut){
+  int rc = SQLITE4_ERROR;
+  *piOut = 0;
+#if SQLITE4_OS_UNIX
+  {
+    struct timeval sNow;
+    if( gettimeofday(&sNow, 0)==0 ){
+      *piOut = 1000000*(sqlite4_uint64)sNow.tv_sec + sNow.tv_usec;
+      rc = SQLITE4_OK;
+    }
+  }
+#endif
+#if SQLITE4_OS_WIN
+  {
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    *piOut = ((((sqlite4_uint64)ft.dwHighDateTime)<<32)
+                + (sqlite4_uint64)ft.dwLowDateTime) / 10;
+    rc = SQLITE4_OK;
+  }
+#endif
+  return rc;
+}
+
 /*
 ** Write nByte bytes of randomness into zBufOut[].  This is used to initialize
 ** the PRNGs.  nByte will always be 8.
@@ -90,6 +121,20 @@ int sqlite4OsRandomness(sqlite4_env *pEnv, int nByte, unsigned char *zBufOut){
   return SQLITE4_OK;
 }
 
+/*
+** Suspend the calling thread for at least nMicro microseconds.
+*/
+int sqlite4OsSleep(sqlite4_env *pEnv, int nMicro){
+  UNUSED_PARAMETER(pEnv);
+#if SQLITE4_OS_UNIX
+  usleep(nMicro);
+#endif
+#if SQLITE4_OS_WIN
+  Sleep((nMicro+999)/1000);
+#endif
+  return SQLITE4_OK;
+}
+
 /*
 ** This function is a wrapper around the OS specific implementation of
 ** sqlite4_os_init(). The purpose of the wrapper is to provide the
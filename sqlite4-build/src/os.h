@@ -78,5 +78,7 @@
 int sqlite4OsInit(sqlite4_env*);
 int sqlite4OsRandomness(sqlite4_env*, int, unsigned char*);
 int sqlite4OsCurrentTime(sqlite4_env*, sqlite4_uint64*);
+int sqlite4OsMicroseconds(sqlite4_uint64*);
+int sqlite4OsSleep(sqlite4_env*, int);
 
 #endif /* _SQLITE4_OS_H_ */
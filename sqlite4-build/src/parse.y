@@ -119,7 +119,17 @@ explain ::= .           { sqlite4BeginParse(pParse, 0); }
 %ifndef SQLITE4_OMIT_EXPLAIN
 explain ::= EXPLAIN.              { sqlite4BeginParse(pParse, 1); }
 explain ::= EXPLAIN QUERY PLAN.   { sqlite4BeginParse(pParse, 2); }
+explain ::= EXPLAIN PROFILE.      { sqlite4BeginParse(pParse, 3); }
+explain ::= EXPLAIN ANALYZE.      { sqlite4BeginParse(pParse, 4); }
 %endif  SQLITE4_OMIT_EXPLAIN
+
+// "EXPLAIN ANALYZE ..." is EXPLAIN ANALYZE applied to the statement that
+// follows, not EXPLAIN applied to an ANALYZE statement.  Giving ANALYZE
+// a higher precedence than EXPLAIN resolves the conflict that way.
+//
+%nonassoc EXPLAIN.
+%nonassoc ANALYZE.
+
 cmdx ::= cmd.           { sqlite4FinishCoding(pParse); }
 
 ///////////////////// Begin and end transactions. ////////////////////////////
@@ -207,7 +217,7 @@ id(A) ::= INDEXED(X).    {A = X;}
 %fallback ID
   ABORT ACTION AFTER ANALYZE ASC ATTACH BEFORE BEGIN BY CASCADE CAST COLUMNKW
   CONFLICT DATABASE DEFERRED DESC DETACH EACH END EXCLUSIVE EXPLAIN FAIL FOR
-  IGNORE IMMEDIATE INITIALLY INSTEAD LIKE_KW MATCH NO PLAN
+  IGNORE IMMEDIATE INITIALLY INSTEAD LIKE_KW MATCH NO PLAN PROFILE
   QUERY KEY OF OFFSET PRAGMA RAISE RELEASE REPLACE RESTRICT ROW ROLLBACK
   SAVEPOINT TEMP TRIGGER VIEW VIRTUAL
 %ifdef SQLITE4_OMIT_COMPOUND_SELECT
@@ -0,0 +1,459 @@
+/*
+** 2026-10-18
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file contains the implementation of the sqlite4_pool_*()
+** interfaces. A pool keeps open connections to a single URI, each with
+** its storage engine resolved, its key-value store open, its schema
+** loaded and a set of statements prepared, so that a request handler
+** can check out a ready connection instead of opening a new one.
+**
+** Idle connections are kept on a singly linked list, so that checkout
+** and checkin are constant time. Each connection points to its PoolConn
+** object through sqlite4.pPoolConn, which is also how sqlite4_close()
+** recognizes (and refuses to close) a pooled connection.
+*/
+#include "sqliteInt.h"
+
+/*
+** A connection belonging to a pool.
+*/
+struct PoolConn {
+  sqlite4 *db;                    /* The connection */
+  sqlite4_pool *pPool;            /* Pool this connection belongs to */
+  int nStmt;                      /* Allocated size of apStmt[] */
+  sqlite4_stmt **apStmt;          /* Pool statements prepared so far */
+  PoolConn *pNext;                /* Next idle connection */
+};
+
+/*
+** A connection pool. All fields following "mutex" are protected by it.
+*/
+struct sqlite4_pool {
+  sqlite4_env *pEnv;              /* Run-time environment */
+  char *zUri;                     /* URI to open */
+  int nConn;                      /* Number of idle connections to keep */
+  sqlite4_mutex *mutex;           /* Mutex protecting the fields below */
+  int nSql;                       /* Number of pool statements */
+  char **azSql;                   /* SQL text of pool statements */
+  PoolConn *pIdle;                /* List of idle connections */
+  int nIdle;                      /* Number of entries on pIdle */
+  int nInUse;                     /* Number of checked out connections */
+  int mxIdle;                     /* Highest value of nIdle */
+  int mxInUse;                    /* Highest value of nInUse */
+  int nCheckout;                  /* Number of checkouts */
+  int nMiss;                      /* Checkouts that opened a connection */
+  int nReset;                     /* Checkins that reset the connection */
+};
+
+/*
+** Prepare pool statement iStmt, whose SQL text is zSql, on connection p
+** unless it has been prepared already. The caller must own p, either by
+** having checked it out or by holding the pool mutex while p is idle.
+*/
+static int poolPrepare(PoolConn *p, int iStmt, const char *zSql){
+  sqlite4_env *pEnv = p->pPool->pEnv;
+  if( iStmt>=p->nStmt ){
+    int nNew = iStmt + 8;
+    sqlite4_stmt **aNew;
+    aNew = (sqlite4_stmt**)sqlite4_realloc(pEnv, p->apStmt,
+                                           nNew*sizeof(sqlite4_stmt*));
+    if( aNew==0 ) return SQLITE4_NOMEM;
+    memset(&aNew[p->nStmt], 0, (nNew-p->nStmt)*sizeof(sqlite4_stmt*));
+    p->apStmt = aNew;
+    p->nStmt = nNew;
+  }
+  if( p->apStmt[iStmt]==0 ){
+    return sqlite4_prepare(p->db, zSql, -1, &p->apStmt[iStmt], 0);
+  }
+  return SQLITE4_OK;
+}
+
+/*
+** Return true if pStmt is one of the pool statements of connection p.
+*/
+static int poolIsStmt(PoolConn *p, sqlite4_stmt *pStmt){
+  int i;
+  for(i=0; i<p->nStmt; i++){
+    if( p->apStmt[i]==pStmt ) return 1;
+  }
+  return 0;
+}
+
+/*
+** Close pooled connection p and free it. Any statements still open on
+** the connection are finalized first, so that sqlite4_close() does not
+** fail with SQLITE4_BUSY and leak the connection. Return the result of
+** sqlite4_close().
+*/
+static int poolConnClose(PoolConn *p){
+  sqlite4_env *pEnv = p->pPool->pEnv;
+  sqlite4_stmt *pStmt;
+  int rc;
+
+  while( (pStmt = sqlite4_next_stmt(p->db, 0))!=0 ){
+    sqlite4_finalize(pStmt);
+  }
+  sqlite4_free(pEnv, p->apStmt);
+  p->db->pPoolConn = 0;
+  rc = sqlite4_close(p->db, 0);
+  assert( rc==SQLITE4_OK );
+  sqlite4_free(pEnv, p);
+  return rc;
+}
+
+/*
+** Open a new connection for pool pPool and prepare the first nSql pool
+** statements (whose text is azSql) on it.
+*/
+static int poolConnOpen(
+  sqlite4_pool *pPool,
+  int nSql,
+  char **azSql,
+  PoolConn **ppConn
+){
+  PoolConn *p;
+  int rc;
+  int i;
+
+  *ppConn = 0;
+  p = (PoolConn*)sqlite4_malloc(pPool->pEnv, sizeof(PoolConn));
+  if( p==0 ) return SQLITE4_NOMEM;
+  memset(p, 0, sizeof(PoolConn));
+  p->pPool = pPool;
+
+  rc = sqlite4_open(pPool->pEnv, pPool->zUri, &p->db, 0);
+  if( rc==SQLITE4_OK ){
+    /* Load the schema now rather than on first use. */
+    rc = sqlite4_exec(p->db, "SELECT 1 FROM sqlite_master LIMIT 0", 0, 0);
+  }
+  for(i=0; rc==SQLITE4_OK && i<nSql; i++){
+    rc = poolPrepare(p, i, azSql[i]);
+  }
+  if( rc!=SQLITE4_OK ){
+    if( p->db ){
+      poolConnClose(p);
+    }else{
+      sqlite4_free(pPool->pEnv, p);
+    }
+    return rc;
+  }
+  p->db->pPoolConn = p;
+  *ppConn = p;
+  return SQLITE4_OK;
+}
+
+/*
+** Create a new connection pool.
+*/
+int sqlite4_pool_open(
+  sqlite4_env *pEnv,
+  const char *zUri,
+  int nConn,
+  sqlite4_pool **ppPool
+){
+  sqlite4_pool *pPool;
+  int nUri;
+  int rc = SQLITE4_OK;
+  int i;
+
+  *ppPool = 0;
+  if( pEnv==0 ) pEnv = sqlite4_env_default();
+#ifndef SQLITE4_OMIT_AUTOINIT
+  rc = sqlite4_initialize(pEnv);
+  if( rc ) return rc;
+#endif
+  if( zUri==0 || nConn<0 ) return SQLITE4_MISUSE_BKPT;
+
+  nUri = sqlite4Strlen30(zUri);
+  pPool = (sqlite4_pool*)sqlite4_malloc(pEnv, sizeof(sqlite4_pool)+nUri+1);
+  if( pPool==0 ) return SQLITE4_NOMEM;
+  memset(pPool, 0, sizeof(sqlite4_pool));
+  pPool->pEnv = pEnv;
+  pPool->zUri = (char*)&pPool[1];
+  memcpy(pPool->zUri, zUri, nUri+1);
+  pPool->nConn = nConn;
+  if( pEnv->bCoreMutex ){
+    pPool->mutex = sqlite4MutexAlloc(pEnv, SQLITE4_MUTEX_FAST);
+    if( pPool->mutex==0 ){
+      sqlite4_free(pEnv, pPool);
+      return SQLITE4_NOMEM;
+    }
+    sqlite4MutexTag(pPool->mutex, "pool.mutex");
+  }
+
+  for(i=0; rc==SQLITE4_OK && i<nConn; i++){
+    PoolConn *p;
+    rc = poolConnOpen(pPool, 0, 0, &p);
+    if( rc==SQLITE4_OK ){
+      p->pNext = pPool->pIdle;
+      pPool->pIdle = p;
+      pPool->nIdle++;
+    }
+  }
+  pPool->mxIdle = pPool->nIdle;
+
+  if( rc!=SQLITE4_OK ){
+    sqlite4_pool_close(pPool);
+    return rc;
+  }
+  *ppPool = pPool;
+  return SQLITE4_OK;
+}
+
+/*
+** Add a statement to the set prepared on every pooled connection.
+*/
+int sqlite4_pool_prepare(sqlite4_pool *pPool, const char *zSql, int *piStmt){
+  sqlite4_env *pEnv = pPool->pEnv;
+  char **azNew;
+  char *zCopy;
+  PoolConn *p;
+  int iStmt;
+  int rc = SQLITE4_OK;
+
+  *piStmt = -1;
+  zCopy = sqlite4_mprintf(pEnv, "%s", zSql);
+  if( zCopy==0 ) return SQLITE4_NOMEM;
+
+  sqlite4_mutex_enter(pPool->mutex);
+  azNew = (char**)sqlite4_realloc(pEnv, pPool->azSql,
+                                  (pPool->nSql+1)*sizeof(char*));
+  if( azNew==0 ){
+    rc = SQLITE4_NOMEM;
+  }else{
+    pPool->azSql = azNew;
+    iStmt = pPool->nSql;
+    for(p=pPool->pIdle; p && rc==SQLITE4_OK; p=p->pNext){
+      rc = poolPrepare(p, iStmt, zCopy);
+    }
+    if( rc==SQLITE4_OK ){
+      azNew[iStmt] = zCopy;
+      pPool->nSql++;
+      *piStmt = iStmt;
+    }else{
+      for(p=pPool->pIdle; p; p=p->pNext){
+        if( iStmt<p->nStmt ){
+          sqlite4_finalize(p->apStmt[iStmt]);
+          p->apStmt[iStmt] = 0;
+        }
+      }
+    }
+  }
+  sqlite4_mutex_leave(pPool->mutex);
+
+  if( rc!=SQLITE4_OK ) sqlite4_free(pEnv, zCopy);
+  return rc;
+}
+
+/*
+** Check out a connection.
+*/
+int sqlite4_pool_checkout(sqlite4_pool *pPool, sqlite4 **pDb){
+  PoolConn *p;
+  int rc = SQLITE4_OK;
+
+  sqlite4_mutex_enter(pPool->mutex);
+  pPool->nCheckout++;
+  p = pPool->pIdle;
+  if( p ){
+    pPool->pIdle = p->pNext;
+    pPool->nIdle--;
+  }else{
+    /* Open a new connection without holding the mutex. It is given a
+    ** copy of azSql[], as the array may be reallocated meanwhile. The
+    ** strings themselves are not freed until the pool is closed. */
+    int nSql = pPool->nSql;
+    char **azSql = 0;
+    pPool->nMiss++;
+    if( nSql>0 ){
+      azSql = (char**)sqlite4_malloc(pPool->pEnv, nSql*sizeof(char*));
+      if( azSql ) memcpy(azSql, pPool->azSql, nSql*sizeof(char*));
+    }
+    sqlite4_mutex_leave(pPool->mutex);
+    if( nSql>0 && azSql==0 ){
+      rc = SQLITE4_NOMEM;
+    }else{
+      rc = poolConnOpen(pPool, nSql, azSql, &p);
+    }
+    sqlite4_free(pPool->pEnv, azSql);
+    sqlite4_mutex_enter(pPool->mutex);
+  }
+  if( p ){
+    p->pNext = 0;
+    pPool->nInUse++;
+    if( pPool->nInUse>pPool->mxInUse ) pPool->mxInUse = pPool->nInUse;
+  }
+  sqlite4_mutex_leave(pPool->mutex);
+
+  *pDb = p ? p->db : 0;
+  return rc;
+}
+
+/*
+** Return a checked out connection to its pool.
+*/
+int sqlite4_pool_checkin(sqlite4_pool *pPool, sqlite4 *db){
+  PoolConn *p;
+  sqlite4_stmt *pStmt;
+  sqlite4_stmt *pNext;
+  int bReset = 0;
+  int bDiscard = 0;
+  int rc = SQLITE4_OK;
+  int i;
+
+  if( db==0 || (p = db->pPoolConn)==0 || p->pPool!=pPool ){
+    return SQLITE4_MISUSE_BKPT;
+  }
+
+  /* Return the connection to its initial state. Pool statements are
+  ** reset, and statements prepared by the application finalized.  */
+  for(pStmt=sqlite4_next_stmt(db, 0); pStmt; pStmt=pNext){
+    pNext = sqlite4_next_stmt(db, pStmt);
+    if( sqlite4_stmt_busy(pStmt) ) bReset = 1;
+    if( poolIsStmt(p, pStmt) ){
+      sqlite4_reset(pStmt);
+    }else{
+      sqlite4_finalize(pStmt);
+    }
+  }
+  for(i=0; i<p->nStmt; i++){
+    if( p->apStmt[i] ) sqlite4_clear_bindings(p->apStmt[i]);
+  }
+
+  /* Roll back any open transaction. If this fails, the state of the
+  ** connection is unknown, so it is closed instead of being reused.  */
+  if( db->pSavepoint ){
+    bReset = 1;
+    if( sqlite4_exec(db, "ROLLBACK", 0, 0)!=SQLITE4_OK || db->pSavepoint ){
+      bDiscard = 1;
+    }
+  }
+
+  sqlite4_mutex_enter(pPool->mutex);
+  pPool->nInUse--;
+  pPool->nReset += bReset;
+  if( bDiscard==0 && pPool->nIdle<pPool->nConn ){
+    p->pNext = pPool->pIdle;
+    pPool->pIdle = p;
+    pPool->nIdle++;
+    if( pPool->nIdle>pPool->mxIdle ) pPool->mxIdle = pPool->nIdle;
+    p = 0;
+  }
+  sqlite4_mutex_leave(pPool->mutex);
+
+  if( p ) rc = poolConnClose(p);
+  return rc;
+}
+
+/*
+** Return pool statement iStmt of pooled connection db.
+*/
+sqlite4_stmt *sqlite4_pool_stmt(sqlite4 *db, int iStmt){
+  PoolConn *p;
+  sqlite4_pool *pPool;
+  char *zSql = 0;
+
+  if( db==0 || (p = db->pPoolConn)==0 || iStmt<0 ) return 0;
+  if( iStmt<p->nStmt && p->apStmt[iStmt] ) return p->apStmt[iStmt];
+
+  /* The statement was added after this connection was checked out. */
+  pPool = p->pPool;
+  sqlite4_mutex_enter(pPool->mutex);
+  if( iStmt<pPool->nSql ) zSql = pPool->azSql[iStmt];
+  sqlite4_mutex_leave(pPool->mutex);
+  if( zSql==0 || poolPrepare(p, iStmt, zSql)!=SQLITE4_OK ) return 0;
+  return p->apStmt[iStmt];
+}
+
+/*
+** Close a connection pool.
+*/
+int sqlite4_pool_close(sqlite4_pool *pPool){
+  sqlite4_env *pEnv;
+  int rc = SQLITE4_OK;
+  int i;
+
+  if( pPool==0 ) return SQLITE4_OK;
+  pEnv = pPool->pEnv;
+  sqlite4_mutex_enter(pPool->mutex);
+  if( pPool->nInUse>0 ){
+    sqlite4_mutex_leave(pPool->mutex);
+    return SQLITE4_BUSY;
+  }
+  sqlite4_mutex_leave(pPool->mutex);
+
+  while( pPool->pIdle ){
+    PoolConn *p = pPool->pIdle;
+    int rc2;
+    pPool->pIdle = p->pNext;
+    rc2 = poolConnClose(p);
+    if( rc==SQLITE4_OK ) rc = rc2;
+  }
+  for(i=0; i<pPool->nSql; i++){
+    sqlite4_free(pEnv, pPool->azSql[i]);
+  }
+  sqlite4_free(pEnv, pPool->azSql);
+  sqlite4_mutex_free(pPool->mutex);
+  sqlite4_free(pEnv, pPool);
+  return rc;
+}
+
+/*
+** Query connection pool statistics.
+*/
+int sqlite4_pool_status(
+  sqlite4_pool *pPool,
+  int op,
+  int *pCur,
+  int *pHiwtr,
+  int resetFlg
+){
+  int rc = SQLITE4_OK;
+  sqlite4_mutex_enter(pPool->mutex);
+  switch( op ){
+    case SQLITE4_POOLSTATUS_IDLE: {
+      *pCur = pPool->nIdle;
+      *pHiwtr = pPool->mxIdle;
+      if( resetFlg ) pPool->mxIdle = pPool->nIdle;
+      break;
+    }
+    case SQLITE4_POOLSTATUS_INUSE: {
+      *pCur = pPool->nInUse;
+      *pHiwtr = pPool->mxInUse;
+      if( resetFlg ) pPool->mxInUse = pPool->nInUse;
+      break;
+    }
+    case SQLITE4_POOLSTATUS_CHECKOUT: {
+      *pCur = pPool->nCheckout;
+      *pHiwtr = 0;
+      if( resetFlg ) pPool->nCheckout = 0;
+      break;
+    }
+    case SQLITE4_POOLSTATUS_MISS: {
+      *pCur = pPool->nMiss;
+      *pHiwtr = 0;
+      if( resetFlg ) pPool->nMiss = 0;
+      break;
+    }
+    case SQLITE4_POOLSTATUS_RESET: {
+      *pCur = pPool->nReset;
+      *pHiwtr = 0;
+      if( resetFlg ) pPool->nReset = 0;
+      break;
+    }
+    default: {
+      rc = SQLITE4_ERROR;
+    }
+  }
+  sqlite4_mutex_leave(pPool->mutex);
+  return rc;
+}
@@ -841,6 +841,23 @@ void sqlite4Pragma(
     sqlite4_db_release_memory(db);
   }else
 
+  /*
+  **  PRAGMA threads
+  **  PRAGMA threads = N
+  **
+  ** Query or change the maximum number of auxiliary worker threads that
+  ** may be used to sort index keys or to evaluate simple aggregate
+  ** queries. See SQLITE4_LIMIT_WORKER_THREADS.
+  */
+  if( sqlite4_stricmp(zPragma, "threads")==0 ){
+    if( zRight ){
+      sqlite4_limit(db, SQLITE4_LIMIT_WORKER_THREADS, sqlite4Atoi(zRight));
+    }
+    returnSingleInt(pParse, "threads",
+        sqlite4_limit(db, SQLITE4_LIMIT_WORKER_THREADS, -1)
+    );
+  }else
+
   /*
   **  PRAGMA schema_version
   */
@@ -549,19 +549,32 @@ static int sqlite4Prepare(
        "addr", "opcode", "p1", "p2", "p3", "p4", "p5", "comment",
        "selectid", "order", "from", "detail"
     };
-    int iFirst, mx;
+    static const char * const azProfileName[] = {
+       "addr", "opcode", "p1", "p2", "p3", "p4", "count", "cycles", "kvcycles"
+    };
+    static const char * const azAnalyzeName[] = {
+       "selectid", "order", "from", "detail", "est_rows", "rows_in",
+       "rows_out", "kv_seeks", "kv_nexts", "time_us"
+    };
+    const char * const *azName;
+    int nName;
     if( pParse->explain==2 ){
-      sqlite4VdbeSetNumCols(pParse->pVdbe, 4);
-      iFirst = 8;
-      mx = 12;
+      azName = &azColName[8];
+      nName = 4;
+    }else if( pParse->explain==3 ){
+      azName = azProfileName;
+      nName = 9;
+    }else if( pParse->explain==4 ){
+      azName = azAnalyzeName;
+      nName = 10;
     }else{
-      sqlite4VdbeSetNumCols(pParse->pVdbe, 8);
-      iFirst = 0;
-      mx = 8;
+      azName = azColName;
+      nName = 8;
     }
-    for(i=iFirst; i<mx; i++){
-      sqlite4VdbeSetColName(pParse->pVdbe, i-iFirst, COLNAME_NAME,
-                            azColName[i], SQLITE4_STATIC);
+    sqlite4VdbeSetNumCols(pParse->pVdbe, nName);
+    for(i=0; i<nName; i++){
+      sqlite4VdbeSetColName(pParse->pVdbe, i, COLNAME_NAME,
+                            azName[i], SQLITE4_STATIC);
     }
   }
 #endif
@@ -58,11 +58,30 @@
 ** primitives are constant time.  The cost of DESTROY is O(N).
 ** There is an added cost of O(N) when switching between TEST and
 ** SMALLEST primitives.
+**
+** Most keys inserted into a RowSet are the primary keys of tables with
+** an INTEGER PRIMARY KEY or an implicit rowid: a table number followed
+** by a single non-negative integer. Such keys are not stored as
+** RowSetEntry objects. Instead the integer is split into a high part
+** (all but the least significant 16 bits) and a low part, as in a
+** "roaring" bitmap. The low parts of all keys that share a table number
+** and high part are stored in a single container, which is either a
+** sorted array of 16-bit values or, once it holds more than
+** ROWSET_ARRAY_MAX values, a bitmap of 65536 bits. INSERT appends such
+** keys to an array of pending values. The pending values are sorted and
+** merged into the containers when the batch number changes or on the
+** first SMALLEST. TEST is then a binary search of the containers
+** followed by a binary search of an array or a bit test, and SMALLEST
+** walks the containers in order, merging them with any other keys.
 */
 #include "sqliteInt.h"
+#include "vdbeInt.h"
 
 typedef struct RowSetEntry RowSetEntry;
 typedef struct RowSetChunk RowSetChunk;
+typedef struct RowSetInt RowSetInt;
+typedef struct RowSetContainer RowSetContainer;
+typedef struct RowSetInts RowSetInts;
 
 /*
 ** Target size for allocation chunks.
@@ -107,11 +126,69 @@ struct RowSet {
   struct RowSetEntry *pLast;     /* Last entry on the pEntry list */
   struct RowSetEntry *pTree;     /* Binary tree of entries */
   u8 *aSpace;                    /* Space for new entries */
+  RowSetInts *pInts;             /* Integer keys, or NULL */
   u16 nSpace;                    /* Number of bytes in buffer aSpace */
   u8 isSorted;                   /* True if pEntry is sorted */
   u8 iBatch;                     /* Current insert batch */
 };
 
+/*
+** Maximum number of values in an array container. A container with more
+** values than this is converted to a bitmap of ROWSET_BITMAP_WORDS
+** 64-bit words, which uses the same amount of memory.
+*/
+#define ROWSET_ARRAY_MAX     4096
+#define ROWSET_BITMAP_WORDS  1024
+
+/*
+** Maximum size of an integer key: a 9 byte varint table number followed
+** by the key encoding of an integer of up to 18 digits.
+*/
+#define ROWSET_MAX_INTKEY    24
+
+/*
+** An integer key: table number iTab and integer value iVal.
+*/
+struct RowSetInt {
+  u64 iTab;                       /* Table number */
+  u64 iVal;                       /* Integer value */
+};
+
+/*
+** A container holding the low 16 bits of each value with table number
+** iTab and high part iHigh. Unless isBitmap is set, u.aVal[] is a sorted
+** array of nVal values with space for nAlloc. Otherwise u.aBit[] is a
+** bitmap with nVal bits set.
+*/
+struct RowSetContainer {
+  u64 iTab;                       /* Table number */
+  u64 iHigh;                      /* Value with the low 16 bits removed */
+  int nVal;                       /* Number of values in container */
+  int nAlloc;                     /* Allocated size of u.aVal[] */
+  u8 isBitmap;                    /* True if u.aBit[] is in use */
+  union {
+    u16 *aVal;                    /* Sorted array of values */
+    u64 *aBit;                    /* Bitmap of values */
+  } u;
+};
+
+/*
+** The integer keys of a RowSet.
+*/
+struct RowSetInts {
+  RowSetContainer *aCont;         /* Containers sorted by (iTab, iHigh) */
+  int nCont;                      /* Number of entries in aCont[] */
+  RowSetInt *aPend;               /* Keys not yet added to a container */
+  int nPend;                      /* Number of entries in aPend[] */
+  int nPendAlloc;                 /* Allocated size of aPend[] */
+  u8 isPendSorted;                /* True if aPend[] is sorted */
+  u8 isReading;                   /* True once SMALLEST has been used */
+  int iCont;                      /* SMALLEST: current container */
+  int iPos;                       /* SMALLEST: array index or bit number */
+  int nKey;                       /* SMALLEST: size of aKey[], or 0 */
+  u8 aKey[ROWSET_MAX_INTKEY];     /* SMALLEST: current key */
+};
+
 /*
 ** Turn bulk memory into a RowSet object.  N bytes of memory
 ** are available at pSpace.  The db pointer is used as a memory context
@@ -134,12 +211,26 @@ RowSet *sqlite4RowSetInit(sqlite4 *db, void *pSpace, unsigned int N){
   p->pLast = 0;
   p->pTree = 0;
   p->aSpace = 0;
+  p->pInts = 0;
   p->nSpace = 0;
   p->isSorted = 1;
   p->iBatch = 0;
   return p;
 }
 
+/*
+** Free the integer keys of a RowSet.
+*/
+static void rowsetIntsFree(sqlite4 *db, RowSetInts *pInts){
+  int i;
+  for(i=0; i<pInts->nCont; i++){
+    sqlite4DbFree(db, pInts->aCont[i].u.aVal);
+  }
+  sqlite4DbFree(db, pInts->aCont);
+  sqlite4DbFree(db, pInts->aPend);
+  sqlite4DbFree(db, pInts);
+}
+
 /*
 ** Deallocate all chunks from a RowSet.  This frees all memory that
 ** the RowSet has allocated over its lifetime.  This routine is
@@ -147,6 +238,7 @@ RowSet *sqlite4RowSetInit(sqlite4 *db, void *pSpace, unsigned int N){
 */
 void sqlite4RowSetClear(RowSet *p){
   struct RowSetChunk *pChunk, *pNextChunk;
+  if( p->pInts ) rowsetIntsFree(p->db, p->pInts);
   for(pChunk=p->pChunk; pChunk; pChunk = pNextChunk){
     pNextChunk = pChunk->pNextChunk;
     sqlite4DbFree(p->db, pChunk);
@@ -179,6 +271,390 @@ static int rowsetEntryCmp(RowSetEntry *pLeft, RowSetEntry *pRight){
   return rowsetEntryKeyCmp(pLeft, pRight->aKey, pRight->nKey);
 }
 
+/*
+** If key aKey/nKey is a table number followed by the key encoding of a
+** non-negative integer of at most 18 digits, set *piTab and *piVal and
+** return 1. Otherwise return 0.
+**
+** Only canonical encodings are accepted, so that rowsetIntEncode()
+** reproduces the original key exactly. The integer encoding is a byte
+** 0x17+E followed by at most E base-100 digits D, each stored as 2*D
+** with the low bit set on all but the last. The first and last digits
+** are never zero. Zero is the single byte 0x15.
+*/
+static int rowsetIntKey(const u8 *aKey, int nKey, u64 *piTab, u64 *piVal){
+  u64 v = 0;
+  int n, e, nDigit, i;
+
+  n = sqlite4GetVarint64(aKey, nKey, piTab);
+  if( n==0 || n>=nKey || sqlite4VarintLen(*piTab)!=n ) return 0;
+  aKey += n;
+  nKey -= n;
+  if( aKey[0]==0x15 ){
+    if( nKey!=1 ) return 0;
+    *piVal = 0;
+    return 1;
+  }
+  e = (int)aKey[0] - 0x17;
+  nDigit = nKey - 1;
+  if( e<1 || e>9 || nDigit<1 || nDigit>e ) return 0;
+  for(i=1; i<=nDigit; i++){
+    int d = aKey[i] >> 1;
+    if( d>99 || (aKey[i] & 0x01)!=(i<nDigit) ) return 0;
+    v = v*100 + d;
+  }
+  if( (aKey[1]>>1)==0 || (aKey[nDigit]>>1)==0 ) return 0;
+  for(i=nDigit; i<e; i++) v *= 100;
+  *piVal = v;
+  return 1;
+}
+
+/*
+** Write the key for table number iTab and integer iVal into aKey[],
+** which must be at least ROWSET_MAX_INTKEY bytes in size. Return the
+** number of bytes written.
+*/
+static int rowsetIntEncode(u8 *aKey, u64 iTab, u64 iVal){
+  int n = sqlite4PutVarint64(aKey, iTab);
+  return n + sqlite4VdbeEncodeIntKey(&aKey[n], (i64)iVal);
+}
+
+static int rowsetIntCmp(const RowSetInt *pA, const RowSetInt *pB){
+  if( pA->iTab!=pB->iTab ) return (pA->iTab<pB->iTab) ? -1 : 1;
+  if( pA->iVal!=pB->iVal ) return (pA->iVal<pB->iVal) ? -1 : 1;
+  return 0;
+}
+
+/*
+** Append an integer key to the pending keys of RowSet p.
+*/
+static void rowsetIntInsert(RowSet *p, u64 iTab, u64 iVal){
+  RowSetInts *pInts = p->pInts;
+  RowSetInt *pNew;
+
+  if( pInts==0 ){
+    pInts = (RowSetInts*)sqlite4DbMallocZero(p->db, sizeof(RowSetInts));
+    if( pInts==0 ) return;
+    pInts->isPendSorted = 1;
+    p->pInts = pInts;
+  }
+  assert( pInts->isReading==0 );  /* Fires if INSERT after SMALLEST */
+  if( pInts->nPend>=pInts->nPendAlloc ){
+    int nNew = pInts->nPendAlloc ? pInts->nPendAlloc*2 : 64;
+    RowSetInt *aNew = (RowSetInt*)sqlite4DbRealloc(
+        p->db, pInts->aPend, nNew*sizeof(RowSetInt)
+    );
+    if( aNew==0 ) return;
+    pInts->aPend = aNew;
+    pInts->nPendAlloc = nNew;
+  }
+  pNew = &pInts->aPend[pInts->nPend++];
+  pNew->iTab = iTab;
+  pNew->iVal = iVal;
+  if( pInts->nPend>1 && rowsetIntCmp(&pNew[-1], pNew)>0 ){
+    pInts->isPendSorted = 0;
+  }
+}
+
+/*
+** Sort the pending keys using a bottom-up merge sort.
+*/
+static void rowsetIntSort(sqlite4 *db, RowSetInts *pInts){
+  int n = pInts->nPend;
+  RowSetInt *aIn = pInts->aPend;
+  RowSetInt *aOut;
+  int w;
+
+  aOut = (RowSetInt*)sqlite4DbMallocRaw(db, n*sizeof(RowSetInt));
+  if( aOut==0 ) return;
+  for(w=1; w<n; w*=2){
+    int i;
+    for(i=0; i<n; i+=2*w){
+      int iA = i;
+      int iB = SQLITE4_MIN(i+w, n);
+      int iEndA = iB;
+      int iEndB = SQLITE4_MIN(i+2*w, n);
+      int iOut = i;
+      while( iA<iEndA && iB<iEndB ){
+        if( rowsetIntCmp(&aIn[iB], &aIn[iA])<0 ){
+          aOut[iOut++] = aIn[iB++];
+        }else{
+          aOut[iOut++] = aIn[iA++];
+        }
+      }
+      while( iA<iEndA ) aOut[iOut++] = aIn[iA++];
+      while( iB<iEndB ) aOut[iOut++] = aIn[iB++];
+    }
+    {
+      RowSetInt *aTmp = aIn;
+      aIn = aOut;
+      aOut = aTmp;
+    }
+  }
+  if( aIn!=pInts->aPend ){
+    memcpy(pInts->aPend, aIn, n*sizeof(RowSetInt));
+    aOut = aIn;
+  }
+  sqlite4DbFree(db, aOut);
+  pInts->isPendSorted = 1;
+}
+
+/*
+** Return the container for table number iTab and high part iHigh, or
+** NULL if there is no such container.
+*/
+static RowSetContainer *rowsetIntFind(RowSetInts *pInts, u64 iTab, u64 iHigh){
+  int iLo = 0;
+  int iHi = pInts->nCont-1;
+  while( iLo<=iHi ){
+    int iMid = (iLo+iHi)/2;
+    RowSetContainer *pCont = &pInts->aCont[iMid];
+    if( pCont->iTab==iTab && pCont->iHigh==iHigh ) return pCont;
+    if( pCont->iTab<iTab || (pCont->iTab==iTab && pCont->iHigh<iHigh) ){
+      iLo = iMid+1;
+    }else{
+      iHi = iMid-1;
+    }
+  }
+  return 0;
+}
+
+/*
+** Convert array container pCont to a bitmap.
+*/
+static void rowsetIntToBitmap(sqlite4 *db, RowSetContainer *pCont){
+  u64 *aBit;
+  int i;
+  assert( pCont->isBitmap==0 );
+  aBit = (u64*)sqlite4DbMallocZero(db, ROWSET_BITMAP_WORDS*sizeof(u64));
+  if( aBit==0 ) return;
+  for(i=0; i<pCont->nVal; i++){
+    u16 v = pCont->u.aVal[i];
+    aBit[v>>6] |= ((u64)1)<<(v & 63);
+  }
+  sqlite4DbFree(db, pCont->u.aVal);
+  pCont->u.aBit = aBit;
+  pCont->nAlloc = 0;
+  pCont->isBitmap = 1;
+}
+
+/*
+** Add the low 16 bits of the n sorted values in aNew[] to container
+** pCont. Duplicates are ignored.
+*/
+static void rowsetIntAdd(
+  sqlite4 *db,
+  RowSetContainer *pCont,
+  const RowSetInt *aNew,
+  int n
+){
+  int i;
+  if( pCont->isBitmap==0 && pCont->nVal+n>ROWSET_ARRAY_MAX ){
+    rowsetIntToBitmap(db, pCont);
+    if( pCont->isBitmap==0 ) return;
+  }
+  if( pCont->isBitmap ){
+    for(i=0; i<n; i++){
+      u16 v = (u16)(aNew[i].iVal & 0xffff);
+      u64 m = ((u64)1)<<(v & 63);
+      if( (pCont->u.aBit[v>>6] & m)==0 ){
+        pCont->u.aBit[v>>6] |= m;
+        pCont->nVal++;
+      }
+    }
+  }else{
+    u16 *aOld = pCont->u.aVal;
+    u16 *aOut;
+    int nOld = pCont->nVal;
+    int iOld = 0;
+    int nOut = 0;
+
+    aOut = (u16*)sqlite4DbMallocRaw(db, (nOld+n)*sizeof(u16));
+    if( aOut==0 ) return;
+    for(i=0; i<n || iOld<nOld; ){
+      u16 v;
+      if( i>=n || (iOld<nOld && aOld[iOld]<=(u16)(aNew[i].iVal & 0xffff)) ){
+        v = aOld[iOld++];
+      }else{
+        v = (u16)(aNew[i++].iVal & 0xffff);
+      }
+      if( nOut==0 || aOut[nOut-1]!=v ) aOut[nOut++] = v;
+    }
+    sqlite4DbFree(db, aOld);
+    pCont->u.aVal = aOut;
+    pCont->nVal = nOut;
+    pCont->nAlloc = nOld+n;
+  }
+}
+
+/*
+** Add all pending keys to containers.
+*/
+static void rowsetIntFlush(RowSet *p){
+  RowSetInts *pInts = p->pInts;
+  sqlite4 *db = p->db;
+  RowSetInt *aPend;
+  int nPend;
+  int nNew = 0;                   /* Number of containers to create */
+  int i, j;
+
+  if( pInts==0 || pInts->nPend==0 ) return;
+  if( pInts->isPendSorted==0 ) rowsetIntSort(db, pInts);
+  aPend = pInts->aPend;
+  nPend = pInts->nPend;
+
+  /* Add each group of keys with the same table number and high part to
+  ** its container, if it already exists. Count the others. */
+  for(i=0; i<nPend; i=j){
+    u64 iTab = aPend[i].iTab;
+    u64 iHigh = aPend[i].iVal>>16;
+    RowSetContainer *pCont;
+    for(j=i+1; j<nPend && aPend[j].iTab==iTab && (aPend[j].iVal>>16)==iHigh;){
+      j++;
+    }
+    pCont = rowsetIntFind(pInts, iTab, iHigh);
+    if( pCont ){
+      rowsetIntAdd(db, pCont, &aPend[i], j-i);
+    }else{
+      nNew++;
+    }
+  }
+
+  /* Merge new containers for the remaining groups into aCont[]. */
+  if( nNew ){
+    int nCont = pInts->nCont + nNew;
+    RowSetContainer *aOld = pInts->aCont;
+    RowSetContainer *aCont;
+    int iOld = 0;
+    int iOut = 0;
+
+    aCont = (RowSetContainer*)sqlite4DbMallocRaw(
+        db, nCont*sizeof(RowSetContainer)
+    );
+    if( aCont==0 ){
+      pInts->nPend = 0;
+      return;
+    }
+    for(i=0; i<nPend; i=j){
+      u64 iTab = aPend[i].iTab;
+      u64 iHigh = aPend[i].iVal>>16;
+      RowSetContainer *pNew;
+      for(j=i+1; j<nPend && aPend[j].iTab==iTab && (aPend[j].iVal>>16)==iHigh;){
+        j++;
+      }
+      if( rowsetIntFind(pInts, iTab, iHigh) ) continue;
+      while( iOld<pInts->nCont
+          && (aOld[iOld].iTab<iTab
+           || (aOld[iOld].iTab==iTab && aOld[iOld].iHigh<iHigh))
+      ){
+        aCont[iOut++] = aOld[iOld++];
+      }
+      pNew = &aCont[iOut++];
+      memset(pNew, 0, sizeof(RowSetContainer));
+      pNew->iTab = iTab;
+      pNew->iHigh = iHigh;
+      rowsetIntAdd(db, pNew, &aPend[i], j-i);
+    }
+    while( iOld<pInts->nCont ) aCont[iOut++] = aOld[iOld++];
+    assert( iOut==nCont );
+    sqlite4DbFree(db, aOld);
+    pInts->aCont = aCont;
+    pInts->nCont = nCont;
+  }
+  pInts->nPend = 0;
+}
+
+/*
+** Return true if table number iTab and integer iVal have been added
+** to a container.
+*/
+static int rowsetIntTest(RowSetInts *pInts, u64 iTab, u64 iVal){
+  RowSetContainer *pCont = rowsetIntFind(pInts, iTab, iVal>>16);
+  u16 v = (u16)(iVal & 0xffff);
+  if( pCont==0 ) return 0;
+  if( pCont->isBitmap ){
+    return (pCont->u.aBit[v>>6] >> (v & 63)) & 1;
+  }else{
+    int iLo = 0;
+    int iHi = pCont->nVal-1;
+    while( iLo<=iHi ){
+      int iMid = (iLo+iHi)/2;
+      u16 x = pCont->u.aVal[iMid];
+      if( x==v ) return 1;
+      if( x<v ){
+        iLo = iMid+1;
+      }else{
+        iHi = iMid-1;
+      }
+    }
+  }
+  return 0;
+}
+
+/*
+** Move the SMALLEST cursor of pInts to the first value at or after
+** container iCont, position iPos, and store its key in pInts->aKey[].
+** Set pInts->nKey to 0 if there is no such value.
+*/
+static void rowsetIntSeek(RowSetInts *pInts){
+  pInts->nKey = 0;
+  while( pInts->iCont<pInts->nCont ){
+    RowSetContainer *pCont = &pInts->aCont[pInts->iCont];
+    int iPos = pInts->iPos;
+    if( pCont->isBitmap ){
+      while( iPos<ROWSET_BITMAP_WORDS*64 ){
+        u64 w = pCont->u.aBit[iPos>>6] >> (iPos & 63);
+        if( w==0 ){
+          iPos = (iPos|63) + 1;
+        }else{
+          while( (w & 1)==0 ){ w >>= 1; iPos++; }
+          break;
+        }
+      }
+      if( iPos<ROWSET_BITMAP_WORDS*64 ){
+        pInts->iPos = iPos;
+        pInts->nKey = rowsetIntEncode(
+            pInts->aKey, pCont->iTab, (pCont->iHigh<<16) | (u64)iPos
+        );
+        return;
+      }
+    }else if( iPos<pCont->nVal ){
+      pInts->nKey = rowsetIntEncode(
+          pInts->aKey, pCont->iTab, (pCont->iHigh<<16) | pCont->u.aVal[iPos]
+      );
+      return;
+    }
+    pInts->iCont++;
+    pInts->iPos = 0;
+  }
+}
+
+/*
+** Prepare the integer keys of RowSet p for SMALLEST, if this has not
+** already been done.
+*/
+static void rowsetIntStartRead(RowSet *p){
+  RowSetInts *pInts = p->pInts;
+  if( pInts && pInts->isReading==0 ){
+    rowsetIntFlush(p);
+    pInts->isReading = 1;
+    pInts->iCont = 0;
+    pInts->iPos = 0;
+    rowsetIntSeek(pInts);
+  }
+}
+
+/*
+** Return true if the smallest element of RowSet p is the current
+** integer key rather than the first entry of the p->pEntry list.
+*/
+static int rowsetIntIsSmallest(RowSet *p){
+  RowSetInts *pInts = p->pInts;
+  return pInts && pInts->nKey
+      && (p->pEntry==0
+          || rowsetEntryKeyCmp(p->pEntry, pInts->aKey, pInts->nKey)>0);
+}
+
 
 /*
 ** Insert a new database key into a RowSet.
@@ -190,8 +666,14 @@ void sqlite4RowSetInsert(RowSet *p, u8 *aKey, int nKey){
   int nByte;                   /* Space (in bytes) required by new entry */
   struct RowSetEntry *pEntry;  /* The new entry */
   struct RowSetEntry *pLast;   /* The last prior entry */
+  u64 iTab, iVal;              /* Decoded integer key */
   assert( p!=0 );
 
+  if( rowsetIntKey(aKey, nKey, &iTab, &iVal) ){
+    rowsetIntInsert(p, iTab, iVal);
+    return;
+  }
+
   nByte = ROUND8(sizeof(RowSetEntry) + nKey);
 
   if( nByte>(ROWSET_BYTES_PER_CHUNK/4) ){
@@ -215,7 +697,7 @@ void sqlite4RowSetInsert(RowSet *p, u8 *aKey, int nKey){
 
   pLast = p->pLast;
   if( pLast ){
-    if( p->isSorted && rowsetEntryCmp(pEntry, pLast)<0 ){
+    if( p->isSorted && rowsetEntryCmp(pEntry, pLast)<=0 ){
       p->isSorted = 0;
     }
     pLast->pRight = pEntry;
@@ -413,15 +895,25 @@ static void rowSetToList(RowSet *p){
 */
 int sqlite4RowSetNext(RowSet *p){
   rowSetToList(p);
-  assert( p->pEntry );
-  p->pEntry = p->pEntry->pRight;
-  return (p->pEntry!=0);
+  rowsetIntStartRead(p);
+  if( rowsetIntIsSmallest(p) ){
+    p->pInts->iPos++;
+    rowsetIntSeek(p->pInts);
+  }else{
+    assert( p->pEntry );
+    p->pEntry = p->pEntry->pRight;
+  }
+  return (p->pEntry!=0 || (p->pInts && p->pInts->nKey));
 }
 
 const u8 *sqlite4RowSetRead(RowSet *p, int *pnKey){
   const u8 *aRet = 0;
   rowSetToList(p);
-  if( p->pEntry ){
+  rowsetIntStartRead(p);
+  if( rowsetIntIsSmallest(p) ){
+    *pnKey = p->pInts->nKey;
+    aRet = p->pInts->aKey;
+  }else if( p->pEntry ){
     *pnKey = p->pEntry->nKey;
     aRet = p->pEntry->aKey;
   }
@@ -434,6 +926,7 @@ const u8 *sqlite4RowSetRead(RowSet *p, int *pnKey){
 */
 int sqlite4RowSetTest(RowSet *pRowSet, u8 iBatch, u8 *aKey, int nKey){
   struct RowSetEntry *p;
+  u64 iTab, iVal;
   if( iBatch!=pRowSet->iBatch ){
     if( pRowSet->pEntry ){
       rowSetToList(pRowSet);
@@ -441,8 +934,12 @@ int sqlite4RowSetTest(RowSet *pRowSet, u8 iBatch, u8 *aKey, int nKey){
       pRowSet->pEntry = 0;
       pRowSet->pLast = 0;
     }
+    rowsetIntFlush(pRowSet);
     pRowSet->iBatch = iBatch;
   }
+  if( rowsetIntKey(aKey, nKey, &iTab, &iVal) ){
+    return pRowSet->pInts ? rowsetIntTest(pRowSet->pInts, iTab, iVal) : 0;
+  }
   p = pRowSet->pTree;
   while( p ){
     int res = rowsetEntryKeyCmp(p, aKey, nKey);
@@ -847,13 +847,50 @@ static const char *selectOpName(int id){
 ** is determined by the zUsage argument.
 */
 static void explainTempTable(Parse *pParse, const char *zUsage){
-  if( pParse->explain==2 ){
+  if( ExplainQueryPlan(pParse) ){
     Vdbe *v = pParse->pVdbe;
     char *zMsg = sqlite4MPrintf(pParse->db, "USE TEMP B-TREE FOR %s", zUsage);
     sqlite4VdbeAddOp4(v, OP_Explain, pParse->iSelectId, 0, 0, zMsg, P4_DYNAMIC);
   }
 }
 
+/*
+** This function is a no-op unless an EXPLAIN ANALYZE command is being
+** processed.  Otherwise, it describes the ORDER BY sort that was coded by
+** generateSortTail() immediately after the OP_Explain instruction at
+** addrExplain.  pushOntoSorter() numbers each row it inserts into sorter
+** cursor iTab using an OP_Sequence instruction, which is used to count rows
+** into the sort.  Rows out are counted by the first instruction of the
+** loop that follows the OP_Sort or OP_SorterSort.
+*/
+static void explainSortStatus(Parse *pParse, int iTab, int addrExplain){
+  if( ExplainAnalyze(pParse) ){
+    Vdbe *v = pParse->pVdbe;
+    int iEnd = sqlite4VdbeCurrentAddr(v);
+    int addrIn = -1;
+    int addrOut = -1;
+    int i;
+    for(i=addrExplain-1; i>=0 && addrIn<0; i--){
+      VdbeOp *pOp = sqlite4VdbeGetOp(v, i);
+      if( pOp->opcode==OP_Sequence && pOp->p1==iTab ) addrIn = i;
+    }
+    for(i=addrExplain; i<iEnd && addrOut<0; i++){
+      VdbeOp *pOp = sqlite4VdbeGetOp(v, i);
+      if( (pOp->opcode==OP_Sort || pOp->opcode==OP_SorterSort)
+       && pOp->p1==iTab
+      ){
+        addrOut = i+1;
+      }
+    }
+    sqlite4VdbeScanStatus(v, addrExplain, addrIn, addrOut, -1);
+    if( addrIn>=0 ){
+      /* The OP_Sequence, OP_MakeKey and OP_Insert that add a row */
+      sqlite4VdbeScanStatusRange(v, addrExplain, addrIn, addrIn+3);
+    }
+    sqlite4VdbeScanStatusRange(v, addrExplain, addrExplain, iEnd);
+  }
+}
+
 /*
 ** Assign expression b to lvalue a. A second, no-op, version of this macro
 ** is provided when SQLITE4_OMIT_EXPLAIN is defined. This allows the code
@@ -866,6 +903,7 @@ static void explainTempTable(Parse *pParse, const char *zUsage){
 #else
 /* No-op versions of the explainXXX() functions and macros. */
 # define explainTempTable(y,z)
+# define explainSortStatus(x,y,z)
 # define explainSetInteger(y,z)
 #endif
 
@@ -892,7 +930,7 @@ static void explainComposite(
   int bUseTmp                     /* True if a temp table was used */
 ){
   assert( op==TK_UNION || op==TK_EXCEPT || op==TK_INTERSECT || op==TK_ALL );
-  if( pParse->explain==2 ){
+  if( ExplainQueryPlan(pParse) ){
     Vdbe *v = pParse->pVdbe;
     char *zMsg = sqlite4MPrintf(
         pParse->db, "COMPOUND SUBQUERIES %d AND %d %s(%s)", iSub1, iSub2,
@@ -3625,6 +3663,82 @@ static void updateAccumulator(Parse *pParse, AggInfo *pAggInfo){
   sqlite4ExprCacheClear(pParse);
 }
 
+/*
+** Query p is an aggregate query without a GROUP BY clause. If it is of
+** the form:
+**
+**   SELECT <aggregate list> FROM <table>
+**
+** where each aggregate is one of the built-in count(), sum(), avg(), min()
+** or max() functions applied to either nothing (count(*)) or a column of
+** the table, code an OP_ParallelAgg instruction that may be used to
+** compute the aggregates using worker threads, and return its address.
+** The caller must set the jump target of the instruction to the first
+** instruction following the serial implementation of the query, which
+** the OP_ParallelAgg falls through to if it cannot be used at runtime.
+**
+** If query p is not of the form above, or if worker threads are disabled
+** (SQLITE4_LIMIT_WORKER_THREADS is zero) when it is prepared, return 0.
+** The serial implementation is then the only code generated.
+*/
+static int codeParallelAgg(Parse *pParse, Select *p, AggInfo *pAggInfo){
+  sqlite4 *db = pParse->db;
+  Vdbe *v = pParse->pVdbe;
+  SrcList *pTabList = p->pSrc;
+  Table *pTab;
+  int *aiAgg;
+  int iCsr;
+  int iDb;
+  int addr;
+  int i;
+
+  if( db->aLimit[SQLITE4_LIMIT_WORKER_THREADS]<=0 ) return 0;
+  if( p->pWhere || pTabList->nSrc!=1 || pTabList->a[0].pSelect ) return 0;
+  pTab = pTabList->a[0].pTab;
+  if( pTab==0 || IsVirtual(pTab) || IsKvstore(pTab) || pTab->pSelect ){
+    return 0;
+  }
+  if( pAggInfo->nAccumulator>0 || pAggInfo->nFunc==0 ) return 0;
+
+  aiAgg = (int *)sqlite4DbMallocRaw(db, sizeof(int)*4*pAggInfo->nFunc);
+  if( aiAgg==0 ) return 0;
+  for(i=0; i<pAggInfo->nFunc; i++){
+    AggInfoFunc *pF = &pAggInfo->aFunc[i];
+    ExprList *pList = pF->pExpr->x.pList;
+    int eOp = sqlite4ParallelAggOp(pF->pFunc);
+    int iCol = -1;
+
+    if( eOp==0 || pF->iDistinct>=0 ) break;
+    if( pList ){
+      Expr *pArg = pList->a[0].pExpr;
+      if( pList->nExpr!=1 ) break;
+      if( pArg->op!=TK_AGG_COLUMN && pArg->op!=TK_COLUMN ) break;
+      if( pArg->iTable!=pTabList->a[0].iCursor || pArg->iColumn<0 ) break;
+      iCol = pArg->iColumn;
+      if( pTab->aCol[iCol].pDflt ) break;
+    }else if( eOp!=PARAGG_COUNT ){
+      break;
+    }
+    aiAgg[i*4] = eOp;
+    aiAgg[i*4+1] = iCol;
+    aiAgg[i*4+2] = (iCol>=0 && pTab->aCol[iCol].affinity==SQLITE4_AFF_REAL);
+    aiAgg[i*4+3] = pF->iMem;
+  }
+  if( i<pAggInfo->nFunc ){
+    sqlite4DbFree(db, aiAgg);
+    return 0;
+  }
+
+  iCsr = pParse->nTab++;
+  iDb = sqlite4SchemaToIndex(db, pTab->pSchema);
+  sqlite4CodeVerifySchema(pParse, iDb);
+  sqlite4OpenPrimaryKey(pParse, iCsr, iDb, pTab, OP_OpenRead);
+  addr = sqlite4VdbeAddOp4(v, OP_ParallelAgg, iCsr, 0, pAggInfo->nFunc,
+                           (char *)aiAgg, P4_INTARRAY);
+  sqlite4VdbeAddOp1(v, OP_Close, iCsr);
+  return addr;
+}
+
 /*
 ** Generate code for the SELECT statement given in the p argument.  
 **
@@ -4149,9 +4263,13 @@ int sqlite4Select(
         int nGroup = pGroupBy->nExpr;
         int regKey = ++pParse->nMem;
         int regRecord = 0;
+        int addrExplain;          /* Start of sort for EXPLAIN ANALYZE */
+        int addrInsert;           /* OP_Insert into the sorting index */
+        int addrSort;             /* OP_SorterSort */
 
         groupBySort = 1;
 
+        addrExplain = sqlite4VdbeCurrentAddr(v);
         explainTempTable(pParse, 
             isDistinct && !(p->selFlags&SF_Distinct)?"DISTINCT":"GROUP BY");
 
@@ -4191,19 +4309,30 @@ int sqlite4Select(
 
         /* Insert the key/value into the sorting index and end the loop
         ** generated by where.c code.  */
-        sqlite4VdbeAddOp3(
+        addrInsert = sqlite4VdbeAddOp3(
             v, OP_Insert, sAggInfo.sortingIdx, regRecord, regKey
         );
         sqlite4WhereEnd(pWInfo);
 
         sqlite4VdbeAddOp2(v, OP_Null, 0, regKey);
-        sqlite4VdbeAddOp2(v, OP_SorterSort, sAggInfo.sortingIdx, addrEnd);
+        addrSort = sqlite4VdbeAddOp2(
+            v, OP_SorterSort, sAggInfo.sortingIdx, addrEnd
+        );
         VdbeComment((v, "GROUP BY sort"));
         sAggInfo.useSortingIdx = 1;
         sqlite4ExprCacheClear(pParse);
 
         j1 = sqlite4VdbeAddOp3(v, OP_GrpCompare, sAggInfo.sortingIdx, 0,regKey);
         addrTopOfLoop = j1;
+
+        /* For EXPLAIN ANALYZE, the OP_Explain is run once for each row 
+        ** inserted into the sorting index and OP_GrpCompare once for each 
+        ** row read back out of it.  */
+        if( ExplainAnalyze(pParse) ){
+          sqlite4VdbeScanStatus(v, addrExplain, addrExplain, j1, -1);
+          sqlite4VdbeScanStatusRange(v, addrExplain, addrExplain, addrInsert+1);
+          sqlite4VdbeScanStatusRange(v, addrExplain, addrSort, addrSort+1);
+        }
       }
 
       /* Generate code that runs whenever the GROUP BY changes.
@@ -4284,6 +4413,7 @@ int sqlite4Select(
     } /* endif pGroupBy.  Begin aggregate queries without GROUP BY: */
     else {
       ExprList *pDel = 0;
+      int addrParallel = 0;       /* OP_ParallelAgg instruction, if any */
       {
         /* Check if the query is of one of the following forms:
         **
@@ -4327,6 +4457,9 @@ int sqlite4Select(
         ** of output.
         */
         resetAccumulator(pParse, &sAggInfo);
+        if( flag==0 ){
+          addrParallel = codeParallelAgg(pParse, p, &sAggInfo);
+        }
         pWInfo = sqlite4WhereBegin(pParse, pTabList, pWhere, pMinMax, 0,flag,0);
         if( pWInfo==0 ){
           sqlite4ExprListDelete(db, pDel);
@@ -4340,6 +4473,7 @@ int sqlite4Select(
         }
         sqlite4WhereEnd(pWInfo);
         finalizeAggFunctions(pParse, &sAggInfo);
+        if( addrParallel ) sqlite4VdbeJumpHere(v, addrParallel);
       }
 
       pOrderBy = 0;
@@ -4360,8 +4494,10 @@ int sqlite4Select(
   ** and send them to the callback one by one.
   */
   if( pOrderBy ){
+    int addrExplain = sqlite4VdbeCurrentAddr(v);
     explainTempTable(pParse, "ORDER BY");
     generateSortTail(pParse, p, v, pEList->nExpr, pDest);
+    explainSortStatus(pParse, pOrderBy->iECursor, addrExplain);
   }
 
   /* Jump here to skip this query
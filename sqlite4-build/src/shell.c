@@ -1055,6 +1055,21 @@ static int display_stats(
     iHiwtr = iCur = -1;
     sqlite4_db_status(db, SQLITE4_DBSTATUS_STMT_USED, &iCur, &iHiwtr, bReset);
     fprintf(pArg->out, "Statement Heap/Lookaside Usage:      %d bytes\n", iCur); 
+    iHiwtr = iCur = -1;
+    sqlite4_db_status(db, SQLITE4_DBSTATUS_CACHE_USED, &iCur, &iHiwtr, bReset);
+    fprintf(pArg->out, "Row Cache Heap Usage:                %d bytes\n", iCur); 
+    iHiwtr = iCur = -1;
+    sqlite4_db_status(db, SQLITE4_DBSTATUS_CACHE_HIT, &iCur, &iHiwtr, bReset);
+    fprintf(pArg->out, "Row Cache Hits:                      %d\n", iCur);
+    iHiwtr = iCur = -1;
+    sqlite4_db_status(db, SQLITE4_DBSTATUS_CACHE_MISS, &iCur, &iHiwtr, bReset);
+    fprintf(pArg->out, "Row Cache Misses:                    %d\n", iCur);
+    iHiwtr = iCur = -1;
+    sqlite4_db_status(db, SQLITE4_DBSTATUS_LOCK_RETRY, &iCur, &iHiwtr, bReset);
+    fprintf(pArg->out, "Retries after deadlock:              %d (max %d)\n", iCur, iHiwtr);
+    iHiwtr = iCur = -1;
+    sqlite4_db_status(db, SQLITE4_DBSTATUS_LOCK_BACKOFF, &iCur, &iHiwtr, bReset);
+    fprintf(pArg->out, "Time waited before retries:          %d ms\n", iCur);
   }
 
   if( pArg && pArg->out && db && pStmt ){
@@ -1064,6 +1079,8 @@ static int display_stats(
     fprintf(pArg->out, "Sort Operations:                     %d\n", iCur);
     iCur = sqlite4_stmt_status(pStmt, SQLITE4_STMTSTATUS_AUTOINDEX, bReset);
     fprintf(pArg->out, "Autoindex Inserts:                   %d\n", iCur);
+    iCur = sqlite4_stmt_status(pStmt, SQLITE4_STMTSTATUS_LOCK_RETRY, bReset);
+    fprintf(pArg->out, "Retries after deadlock:              %d\n", iCur);
   }
 
   return 0;
@@ -1304,6 +1321,7 @@ static char zHelp[] =
   "                         list     Values delimited by .separator string\n"
   "                         tabs     Tab-separated values\n"
   "                         tcl      TCL list elements\n"
+  ".mutexstats ?reset?    Show mutex statistics (requires -mutexprof)\n"
   ".nullvalue STRING      Use STRING in place of NULL values\n"
   ".output FILENAME       Send output to FILENAME\n"
   ".output stdout         Send output to the screen\n"
@@ -1881,6 +1899,42 @@ static int do_meta_command(char *zLine, struct callback_data *p){
     }
   }else
 
+  if( c=='m' && n>1 && strncmp(azArg[0], "mutexstats", n)==0 && nArg<3 ){
+    int bReset = nArg==2 && strcmp(azArg[1], "reset")==0;
+    int iSite;
+    sqlite4_mutex_status st;
+    rc = sqlite4_env_mutex_status(0, 0, &st, 0);
+    if( rc!=SQLITE4_OK ){
+      fprintf(stderr, "Error: mutex profiling not enabled (use -mutexprof)\n");
+      rc = 1;
+    }
+    for(iSite=0; rc==0; iSite++){
+      int j;
+      if( sqlite4_env_mutex_status(0, iSite, &st, bReset)!=SQLITE4_OK ) break;
+      if( st.nAlloc==0 ) continue;
+      fprintf(p->out, "%-20s %-9s alloc=%d live=%d\n",
+          st.zTag ? st.zTag : "(untagged)",
+          st.eType==SQLITE4_MUTEX_RECURSIVE ? "recursive" : "fast",
+          st.nAlloc, st.nLive
+      );
+      fprintf(p->out, "  enter=%llu contended=%llu busy=%llu"
+          " wait=%lluus hold=%lluus\n",
+          (unsigned long long)st.nEnter, (unsigned long long)st.nContended,
+          (unsigned long long)st.nBusy, (unsigned long long)st.nWaitNs/1000,
+          (unsigned long long)st.nHoldNs/1000
+      );
+      fprintf(p->out, "  wait histogram:");
+      for(j=0; j<SQLITE4_MUTEX_NHIST; j++){
+        fprintf(p->out, " %llu", (unsigned long long)st.aWait[j]);
+      }
+      fprintf(p->out, "\n  hold histogram:");
+      for(j=0; j<SQLITE4_MUTEX_NHIST; j++){
+        fprintf(p->out, " %llu", (unsigned long long)st.aHold[j]);
+      }
+      fprintf(p->out, "\n");
+    }
+  }else
+
   if( c=='n' && strncmp(azArg[0], "nullvalue", n)==0 && nArg==2 ) {
     sqlite4_snprintf(p->nullvalue, sizeof(p->nullvalue),
                      "%.*s", (int)ArraySize(p->nullvalue)-1, azArg[1]);
@@ -2554,6 +2608,7 @@ static const char zOptions[] =
   "   -interactive         force interactive I/O\n"
   "   -line                set output mode to 'line'\n"
   "   -list                set output mode to 'list'\n"
+  "   -mutexprof           profile mutex contention (see .mutexstats)\n"
   "   -nullvalue TEXT      set text string for NULL values. Default ''\n"
   "   -separator SEP       set output field separator. Default: '|'\n"
   "   -stats               print memory stats before each finalize\n"
@@ -2670,6 +2725,11 @@ int main(int argc, char **argv){
       ** we do the actual processing of arguments later in a second pass.
       */
       stdin_is_interactive = 0;
+    }else if( strcmp(z,"-mutexprof")==0 ){
+      /* Must be configured before the environment is initialized.  The
+      ** shell normally runs without mutexes, so enable them too. */
+      sqlite4_env_config(0, SQLITE4_ENVCONFIG_SERIALIZED);
+      sqlite4_env_config(0, SQLITE4_ENVCONFIG_MUTEXPROF, 1);
     }else if( strcmp(z,"-heap")==0 ){
 #if defined(SQLITE4_ENABLE_MEMSYS3) || defined(SQLITE4_ENABLE_MEMSYS5)
       int j, c;
@@ -2761,6 +2821,8 @@ int main(int argc, char **argv){
       stdin_is_interactive = 1;
     }else if( strcmp(z,"-batch")==0 ){
       stdin_is_interactive = 0;
+    }else if( strcmp(z,"-mutexprof")==0 ){
+      /* Handled in the first pass */
     }else if( strcmp(z,"-heap")==0 ){
       i++;
 #ifdef SQLITE4_ENABLE_MULTIPLEX
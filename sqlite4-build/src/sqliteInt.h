@@ -110,6 +110,39 @@
 # define SQLITE4_PTR_TO_INT(X)  ((int)(X))
 #endif
 
+/*
+** Load a pointer with acquire semantics, or store one with release
+** semantics.  These allow a linked list that is only modified while
+** holding a mutex to be read without it, provided that each new element
+** is fully initialized before it is linked in and that unlinked elements
+** are not freed while readers may still hold them.  For MSVC on x86 and
+** x64, volatile accesses already have these semantics.
+*/
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+# define SQLITE4_ATOMIC_LOAD_PTR(PP) \
+    ((void*)__atomic_load_n((void**)(PP), __ATOMIC_ACQUIRE))
+# define SQLITE4_ATOMIC_STORE_PTR(PP,V) \
+    __atomic_store_n((void**)(PP), (void*)(V), __ATOMIC_RELEASE)
+#else
+# define SQLITE4_ATOMIC_LOAD_PTR(PP)    (*(void*volatile*)(PP))
+# define SQLITE4_ATOMIC_STORE_PTR(PP,V) (*(void*volatile*)(PP) = (void*)(V))
+#endif
+
+/*
+** Load or increment an integer counter without taking a mutex.  The
+** increment is lock-free, so it may be used from a signal handler.
+** Without GCC atomics it is a plain volatile increment, which is only
+** safe if there is a single writer.
+*/
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+# define SQLITE4_ATOMIC_LOAD_INT(P) __atomic_load_n((P), __ATOMIC_ACQUIRE)
+# define SQLITE4_ATOMIC_INCR_INT(P) \
+    ((void)__atomic_fetch_add((P), 1, __ATOMIC_RELEASE))
+#else
+# define SQLITE4_ATOMIC_LOAD_INT(P) (*(volatile int*)(P))
+# define SQLITE4_ATOMIC_INCR_INT(P) ((void)((*(volatile int*)(P))++))
+#endif
+
 /*
 ** The SQLITE4_THREADSAFE macro must be defined as 0, 1, or 2.
 ** 0 means mutexes are permanently disable and the library is never
@@ -129,6 +162,28 @@
 #endif
 #endif
 
+/*
+** SQLITE4_TLS is the storage class used for variables that have a
+** separate value in each thread.  It is left undefined if the compiler
+** provides no such storage class, in which case features that depend
+** on it are disabled.
+**
+** With GCC, the initial-exec model is used so that reading the variable
+** from position-independent code is a single load and not a call to
+** __tls_get_addr().  SQLite uses only a few bytes of thread-local storage,
+** which the dynamic loader reserves space for even if the library is
+** loaded by dlopen().
+*/
+#if !defined(SQLITE4_TLS)
+# if SQLITE4_THREADSAFE==0
+#  define SQLITE4_TLS
+# elif defined(_MSC_VER)
+#  define SQLITE4_TLS __declspec(thread)
+# elif defined(__GNUC__)
+#  define SQLITE4_TLS __thread __attribute__((tls_model("initial-exec")))
+# endif
+#endif
+
 /*
 ** Powersafe overwrite is on by default.  But can be turned off using
 ** the -DSQLITE4_POWERSAFE_OVERWRITE=0 command-line option.
@@ -598,10 +653,14 @@ typedef struct KeyInfo KeyInfo;
 typedef struct Lookaside Lookaside;
 typedef struct LookasideSlot LookasideSlot;
 typedef struct Module Module;
+typedef struct MutexProfile MutexProfile;
 typedef struct NameContext NameContext;
 typedef struct Parse Parse;
 typedef struct ParseYColCache ParseYColCache;
+typedef struct PoolConn PoolConn;
+typedef struct AsyncPool AsyncPool;
 typedef struct RowSet RowSet;
+typedef struct SQLiteThread SQLiteThread;
 typedef struct Savepoint Savepoint;
 typedef struct Select Select;
 typedef struct Sqlite4InitInfo Sqlite4InitInfo;
@@ -733,7 +792,7 @@ struct Schema {
 ** The number of different kinds of things that can be limited
 ** using the sqlite4_limit() interface.
 */
-#define SQLITE4_N_LIMIT (SQLITE4_LIMIT_TRIGGER_DEPTH+1)
+#define SQLITE4_N_LIMIT (SQLITE4_LIMIT_SORTER_SIZE+1)
 
 /*
 ** Lookaside malloc is a set of fixed-size buffers that can be used
@@ -848,6 +907,7 @@ struct sqlite4 {
     volatile int isInterrupted; /* True if sqlite4_interrupt has been called */
     double notUsed1;            /* Spacer */
   } u1;
+  int iInterrupt;               /* Number of sqlite4_interrupt() calls */
   Lookaside lookaside;          /* Lookaside malloc configuration */
 #ifndef SQLITE4_OMIT_AUTHORIZATION
   Authorizer *pAuth;            /* Head of authorizer callback stack */
@@ -871,7 +931,15 @@ struct sqlite4 {
   int nSavepoint;               /* Number of open savepoints */
   int nStatement;               /* Number of nested statement-transactions  */
   i64 nDeferredCons;            /* Net deferred constraints this transaction. */
+  int nLockRetry;               /* Max retries of a statement on SQLITE4_LOCKED */
+  int nLockBackoff;             /* Delay before the first retry, in us */
+  int nLockRetryTotal;          /* Retries made, for SQLITE4_DBSTATUS_LOCK_RETRY */
+  int mxLockRetry;              /* Most retries needed by one sqlite4_step() */
+  i64 nLockBackoffTotal;        /* Total delay before retries, in us */
+  int nSeekBatch;               /* Outer rows looked ahead over by SeekBatch */
+  u32 iStepGen;                 /* See sqlite4VdbeNewStepGen() */
   int *pnBytesFreed;            /* If not NULL, increment this in DbFree() */
+  PoolConn *pPoolConn;          /* Connection pool entry, or NULL */
 
 #ifdef SQLITE4_ENABLE_UNLOCK_NOTIFY
   /* The following variables are all protected by the STATIC_MASTER 
@@ -965,6 +1033,16 @@ struct sqlite4 {
 #define SQLITE4_FUNC_COUNT    0x20 /* Built-in count(*) aggregate */
 #define SQLITE4_FUNC_COALESCE 0x40 /* Built-in coalesce() or ifnull() func */
 
+/*
+** Values returned by sqlite4ParallelAggOp(). These identify the built-in
+** aggregates that OP_ParallelAgg is able to evaluate.
+*/
+#define PARAGG_COUNT   1           /* count(*) or count(X) */
+#define PARAGG_SUM     2           /* sum(X) */
+#define PARAGG_AVG     3           /* avg(X) */
+#define PARAGG_MIN     4           /* min(X) */
+#define PARAGG_MAX     5           /* max(X) */
+
 /*
 ** The following three macros, FUNCTION(), LIKEFUNC() and AGGREGATE() are
 ** used to create the initializers for the FuncDef structures.
@@ -2209,7 +2287,7 @@ struct Parse {
   Vdbe *pReprepare;    /* VM being reprepared (sqlite4Reprepare()) */
   int nAlias;          /* Number of aliased result set columns */
   int *aAlias;         /* Register used to hold aliased result */
-  u8 explain;          /* True if the EXPLAIN flag is found on the query */
+  u8 explain;          /* EXPLAIN 1: plain 2: QUERY PLAN 3: PROFILE 4: ANALYZE */
   Token sNameToken;    /* Token with unqualified schema object name */
   Token sLastToken;    /* The last token parsed */
   const char *zTail;   /* All SQL text past the last semicolon parsed */
@@ -2238,6 +2316,16 @@ struct Parse {
   #define IN_DECLARE_VTAB (pParse->declareVtab)
 #endif
 
+/*
+** True if OP_Explain instructions describing the query plan should be
+** coded.  EXPLAIN ANALYZE reports on the same steps as EXPLAIN QUERY PLAN.
+** ExplainAnalyze() is true if, in addition, the code generators should
+** describe the instructions belonging to each step using
+** sqlite4VdbeScanStatus() and sqlite4VdbeScanStatusRange().
+*/
+#define ExplainQueryPlan(P) ((P)->explain==2 || (P)->explain==4)
+#define ExplainAnalyze(P)   ((P)->explain==4)
+
 /*
 ** An instance of the following structure can be declared on a stack and used
 ** to save the Parse.zAuthContext value so that it can be restored later.
@@ -2255,6 +2343,7 @@ struct AuthContext {
 #define OPFLAG_USEKEY        0x04    /* Optimize OP_EncodeData using key content */
 #define OPFLAG_SEQCOUNT      0x08    /* Append sequence number to key */
 #define OPFLAG_CLEARCACHE    0x10    /* Clear pseudo-table cache in OP_Column */
+#define OPFLAG_KVREF         0x20    /* OP_Column may refer to KV cursor memory */
 
 /*
  * Each trigger present in the database schema is stored as an instance of
@@ -2389,12 +2478,21 @@ typedef struct {
 
 /*
 ** A pluggable storage engine
+**
+** The sqlite4_env.pFactory list is only modified while holding
+** sqlite4_env.pFactoryMutex, but sqlite4KVStoreOpen() reads it without
+** the mutex using SQLITE4_ATOMIC_LOAD_PTR().  For this reason a factory
+** removed by SQLITE4_ENVCONFIG_KVSTORE_POP is not freed immediately.
+** Instead it is moved to the sqlite4_env.pRetiredFactory list (linked
+** by pRetired, so that a concurrent reader's pNext chain is unchanged)
+** and freed by sqlite4_shutdown().
 */
 typedef struct KVFactory {
   struct KVFactory *pNext;       /* Next in list of all storage engines */
   const char *zName;             /* Name of this factory */
   sqlite4_kvfactory xFactory;    /* Function to make an sqlite4_kvstore obj */
   int isPerm;                    /* True if a built-in.  Cannot be popped */
+  struct KVFactory *pRetired;    /* Next in list of popped factories */
 } KVFactory;
 
 /*
@@ -2418,6 +2516,7 @@ struct sqlite4_env {
   KVFactory *pFactory;              /* List of factories */
   int (*xRandomness)(sqlite4_env*, int, unsigned char*);
   int (*xCurrentTime)(sqlite4_env*, sqlite4_uint64*);
+  int nAsyncThread;                 /* Worker threads for sqlite4_async */
   /* The above might be initialized to non-zero.  The following need to always
   ** initially be zero, however. */
   int isInit;                       /* True after initialization has finished */
@@ -2431,6 +2530,10 @@ struct sqlite4_env {
   sqlite4_uint64 nowValue[4];       /* sqlite4_env_status() current values */
   sqlite4_uint64 mxValue[4];        /* sqlite4_env_status() max values */
   FuncDefTable aGlobalFuncs;        /* Lookup table of global functions */
+  int bMutexProf;                   /* True to profile mutex contention */
+  MutexProfile *pMutexProf;         /* Mutex profiler state, or NULL */
+  KVFactory *pRetiredFactory;       /* Popped factories awaiting shutdown */
+  AsyncPool *pAsync;                /* Asynchronous execution worker pool */
 };
 
 /*
@@ -2489,6 +2592,11 @@ int sqlite4WalkSelectFrom(Walker*, Select*);
 */
 extern sqlite4_mm sqlite4MMSystem;
 
+/*
+** Constructor for the SQLITE4_MM_THREADCACHE allocator (mem6.c)
+*/
+sqlite4_mm *sqlite4MMThreadCacheNew(sqlite4_mm*);
+
 /*
 ** The SQLITE4_*_BKPT macros are substitutes for the error codes with
 ** the same name but without the _BKPT suffix.  These macros invoke
@@ -2591,6 +2699,8 @@ const sqlite4_mem_methods *sqlite4MemGetMemsys5(void);
   sqlite4_mutex *sqlite4MutexAlloc(sqlite4_env*,int);
   int sqlite4MutexInit(sqlite4_env*);
   int sqlite4MutexEnd(sqlite4_env*);
+  int sqlite4MutexProfileInstall(sqlite4_env*);
+  void sqlite4MutexTag(sqlite4_mutex*, const char*);
 #endif
 
 void sqlite4StatusAdd(sqlite4_env*, int, sqlite4_int64);
@@ -2691,6 +2801,13 @@ int sqlite4RowSetNext(RowSet *);
 const u8 *sqlite4RowSetRead(RowSet *, int *);
 int sqlite4RowSetTest(RowSet *, u8, u8 *, int);
 
+int sqlite4ThreadCreate(sqlite4_env*, SQLiteThread**, void*(*)(void*), void*);
+int sqlite4ThreadJoin(SQLiteThread*, void**);
+
+int sqlite4AsyncInit(sqlite4_env*);
+void sqlite4AsyncEnd(sqlite4_env*);
+int sqlite4AsyncStarted(sqlite4_env*);
+
 void sqlite4CreateView(Parse*,Token*,Token*,Token*,Select*,int,int);
 
 #if !defined(SQLITE4_OMIT_VIEW) || !defined(SQLITE4_OMIT_VIRTUALTABLE)
@@ -3004,6 +3121,7 @@ void sqlite4DeleteIndexSamples(sqlite4*,Index*);
 void sqlite4DefaultRowEst(Index*);
 void sqlite4RegisterLikeFunctions(sqlite4*, int);
 int sqlite4IsLikeFunction(sqlite4*,Expr*,int*,char*);
+int sqlite4ParallelAggOp(FuncDef*);
 void sqlite4SchemaClear(sqlite4_env*,Schema*);
 Schema *sqlite4SchemaGet(sqlite4*);
 int sqlite4SchemaToIndex(sqlite4 *db, Schema *);
@@ -3029,6 +3147,7 @@ void sqlite4OpenIndex(Parse*, int iCur, int iDb, Index*, int);
 int sqlite4OpenAllIndexes(Parse *, Table *, int, int);
 void sqlite4CloseAllIndexes(Parse *, Table *, int);
 Index *sqlite4FindPrimaryKey(Table *, int *);
+char *sqlite4NotUniqueMessage(sqlite4 *, Index *);
 
 /*
 ** The interface to the LEMON-generated parser
@@ -206,3 +206,94 @@
 #ifndef SQLITE4_MAX_TRIGGER_DEPTH
 # define SQLITE4_MAX_TRIGGER_DEPTH 1000
 #endif
+
+/*
+** Maximum number of auxiliary worker threads that a single statement may
+** start, and the default value of the SQLITE4_LIMIT_WORKER_THREADS limit.
+** Worker threads are used to sort index keys when building an index. If
+** SQLITE4_MAX_WORKER_THREADS is 0, all work is done by the calling thread.
+*/
+#ifndef SQLITE4_MAX_WORKER_THREADS
+# define SQLITE4_MAX_WORKER_THREADS 8
+#endif
+#ifndef SQLITE4_DEFAULT_WORKER_THREADS
+# define SQLITE4_DEFAULT_WORKER_THREADS 0
+#endif
+#if SQLITE4_DEFAULT_WORKER_THREADS>SQLITE4_MAX_WORKER_THREADS
+# undef SQLITE4_MAX_WORKER_THREADS
+# define SQLITE4_MAX_WORKER_THREADS SQLITE4_DEFAULT_WORKER_THREADS
+#endif
+
+/*
+** Maximum number of bytes of index entries buffered in memory by an index
+** build or a bulk load before they are sorted and written out, and the
+** default value of the SQLITE4_LIMIT_SORTER_SIZE limit.
+*/
+#ifndef SQLITE4_MAX_SORTER_SIZE
+# define SQLITE4_MAX_SORTER_SIZE 2147483647
+#endif
+#ifndef SQLITE4_DEFAULT_SORTER_SIZE
+# define SQLITE4_DEFAULT_SORTER_SIZE (64*1024*1024)
+#endif
+#if SQLITE4_DEFAULT_SORTER_SIZE>SQLITE4_MAX_SORTER_SIZE
+# undef SQLITE4_MAX_SORTER_SIZE
+# define SQLITE4_MAX_SORTER_SIZE SQLITE4_DEFAULT_SORTER_SIZE
+#endif
+
+/*
+** Default number of worker threads in the pool that runs statements
+** submitted with sqlite4_async_submit(). This can be changed at run-time
+** using SQLITE4_ENVCONFIG_ASYNCTHREADS.
+*/
+#ifndef SQLITE4_DEFAULT_ASYNC_THREADS
+# define SQLITE4_DEFAULT_ASYNC_THREADS 4
+#endif
+
+/*
+** When a statement fails with SQLITE4_LOCKED because the storage engine
+** chose it as a deadlock victim, and it can be undone without discarding
+** the work of earlier statements, it is rolled back and run again up to
+** SQLITE4_DEFAULT_LOCK_RETRY times. The first retry is made after about
+** SQLITE4_DEFAULT_LOCK_BACKOFF microseconds, and the delay doubles with
+** each further retry up to SQLITE4_MAX_LOCK_BACKOFF. The first two can be
+** changed at run-time using SQLITE4_DBCONFIG_LOCK_RETRY and
+** SQLITE4_DBCONFIG_LOCK_BACKOFF.
+*/
+#ifndef SQLITE4_DEFAULT_LOCK_RETRY
+# define SQLITE4_DEFAULT_LOCK_RETRY 10
+#endif
+#ifndef SQLITE4_DEFAULT_LOCK_BACKOFF
+# define SQLITE4_DEFAULT_LOCK_BACKOFF 100
+#endif
+#ifndef SQLITE4_MAX_LOCK_BACKOFF
+# define SQLITE4_MAX_LOCK_BACKOFF 100000
+#endif
+
+/*
+** The largest number of rows of an outer loop that OP_SeekBatch looks
+** ahead over (see SQLITE4_DBCONFIG_SEEK_BATCH). For each key sought, up to
+** SQLITE4_MAX_SEEKBATCH_RUN entries of at most SQLITE4_MAX_SEEKBATCH_ROW
+** bytes each (key plus value) are kept in memory.
+*/
+#ifndef SQLITE4_MAX_SEEKBATCH
+# define SQLITE4_MAX_SEEKBATCH 4096
+#endif
+#ifndef SQLITE4_MAX_SEEKBATCH_RUN
+# define SQLITE4_MAX_SEEKBATCH_RUN 8
+#endif
+#ifndef SQLITE4_MAX_SEEKBATCH_ROW
+# define SQLITE4_MAX_SEEKBATCH_ROW 4096
+#endif
+
+/*
+** A database opened with the "rowcache=N" URI parameter keeps up to N
+** recently read rows in memory, but no more than SQLITE4_MAX_ROWCACHE.
+** Rows whose key and value together are larger than
+** SQLITE4_MAX_ROWCACHE_ROW bytes are not cached.
+*/
+#ifndef SQLITE4_MAX_ROWCACHE
+# define SQLITE4_MAX_ROWCACHE 1048576
+#endif
+#ifndef SQLITE4_MAX_ROWCACHE_ROW
+# define SQLITE4_MAX_ROWCACHE_ROW 4096
+#endif
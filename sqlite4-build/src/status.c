@@ -107,12 +107,17 @@ int sqlite4_db_status(
 
     /* 
     ** Return an approximation for the amount of memory currently used
-    ** by all pagers associated with the given database connection.  The
-    ** highwater mark is meaningless and is returned as zero.
+    ** by the hot-row caches of all databases associated with the given
+    ** database connection.  The highwater mark is meaningless and is
+    ** returned as zero.
     */
     case SQLITE4_DBSTATUS_CACHE_USED: {
-      int totalUsed = 0;
-      *pCurrent = totalUsed;
+      i64 totalUsed = 0;
+      int i;
+      for(i=0; i<db->nDb; i++){
+        totalUsed += sqlite4KVStoreCacheStatus(db->aDb[i].pKV, op, 0);
+      }
+      *pCurrent = (int)totalUsed;
       *pHighwater = 0;
       break;
     }
@@ -180,15 +185,41 @@ int sqlite4_db_status(
     }
 
     /*
-    ** Set *pCurrent to the total cache hits or misses encountered by all
-    ** pagers the database handle is connected to. *pHighwater is always set 
-    ** to zero.
+    ** Set *pCurrent to the total hot-row cache hits or misses encountered
+    ** by all databases the database handle is connected to. *pHighwater
+    ** is always set to zero.
     */
     case SQLITE4_DBSTATUS_CACHE_HIT:
     case SQLITE4_DBSTATUS_CACHE_MISS: {
-      int nRet = 0;
+      i64 nRet = 0;
+      int i;
+      for(i=0; i<db->nDb; i++){
+        nRet += sqlite4KVStoreCacheStatus(db->aDb[i].pKV, op, resetFlag);
+      }
+      *pHighwater = 0;
+      *pCurrent = (int)nRet;
+      break;
+    }
+
+    /*
+    ** Statements retried after SQLITE4_LOCKED, and the time spent waiting
+    ** before those retries. Both counters are cleared by resetFlag.
+    */
+    case SQLITE4_DBSTATUS_LOCK_RETRY: {
+      *pCurrent = db->nLockRetryTotal;
+      *pHighwater = db->mxLockRetry;
+      if( resetFlag ){
+        db->nLockRetryTotal = 0;
+        db->mxLockRetry = 0;
+      }
+      break;
+    }
+    case SQLITE4_DBSTATUS_LOCK_BACKOFF: {
+      *pCurrent = (int)(db->nLockBackoffTotal / 1000);
       *pHighwater = 0;
-      *pCurrent = nRet;
+      if( resetFlag ){
+        db->nLockBackoffTotal = 0;
+      }
       break;
     }
 
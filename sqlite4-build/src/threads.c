@@ -0,0 +1,221 @@
+/*
+** 2026-10-18
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file presents a simple cross-platform threading interface for
+** use internally by SQLite.
+**
+** A "thread" can be created using sqlite4ThreadCreate().  This thread
+** runs independently of its creator until it is joined using
+** sqlite4ThreadJoin(), at which point it terminates.
+**
+** Threads do not have to be real.  It could be that the work of the
+** "thread" is done by the main thread at either the sqlite4ThreadCreate()
+** or sqlite4ThreadJoin() call.  This is, in fact, what happens in
+** single threaded systems, or if the system is unable to create another
+** thread.  Nothing in SQLite depends on multiple threads actually
+** running concurrently.
+**
+** The task function of a thread must not call back into SQLite in a way
+** that requires a database connection mutex. Such functions are expected
+** to work on memory that is otherwise unused while the thread runs.
+*/
+#include "sqliteInt.h"
+
+#if SQLITE4_MAX_WORKER_THREADS>0 && SQLITE4_THREADSAFE>0 \
+ && defined(SQLITE4_MUTEX_PTHREADS)
+/******************************** Unix Pthreads *************************/
+#define SQLITE4_THREADS_IMPLEMENTED 1
+#include <pthread.h>
+
+/* A running thread */
+struct SQLiteThread {
+  sqlite4_env *pEnv;            /* Environment used to allocate this object */
+  pthread_t tid;                /* Thread ID */
+  int done;                     /* Set to true when thread finishes */
+  void *pOut;                   /* Result returned by the thread */
+  void *(*xTask)(void*);        /* The thread routine */
+  void *pIn;                    /* Argument to the thread */
+};
+
+/* Create a new thread */
+int sqlite4ThreadCreate(
+  sqlite4_env *pEnv,        /* Environment to allocate the thread object in */
+  SQLiteThread **ppThread,  /* OUT: Write the thread object here */
+  void *(*xTask)(void*),    /* Routine to run in a separate thread */
+  void *pIn                 /* Argument passed into xTask() */
+){
+  SQLiteThread *p;
+  int rc;
+
+  assert( ppThread!=0 );
+  assert( xTask!=0 );
+  *ppThread = 0;
+  p = sqlite4_malloc(pEnv, sizeof(*p));
+  if( p==0 ) return SQLITE4_NOMEM;
+  memset(p, 0, sizeof(*p));
+  p->pEnv = pEnv;
+  p->xTask = xTask;
+  p->pIn = pIn;
+  rc = pthread_create(&p->tid, 0, xTask, pIn);
+  if( rc ){
+    /* If a new thread cannot be started, run the task synchronously */
+    p->done = 1;
+    p->pOut = xTask(pIn);
+  }
+  *ppThread = p;
+  return SQLITE4_OK;
+}
+
+/* Get the results of the thread */
+int sqlite4ThreadJoin(SQLiteThread *p, void **ppOut){
+  int rc;
+
+  assert( ppOut!=0 );
+  if( NEVER(p==0) ) return SQLITE4_NOMEM;
+  if( p->done ){
+    *ppOut = p->pOut;
+    rc = SQLITE4_OK;
+  }else{
+    rc = pthread_join(p->tid, ppOut) ? SQLITE4_ERROR : SQLITE4_OK;
+  }
+  sqlite4_free(p->pEnv, p);
+  return rc;
+}
+
+#endif /* SQLITE4_MUTEX_PTHREADS */
+/******************************** End Unix Pthreads *************************/
+
+
+/********************************* Win32 Threads ****************************/
+#if SQLITE4_MAX_WORKER_THREADS>0 && SQLITE4_THREADSAFE>0 \
+ && defined(SQLITE4_MUTEX_W32)
+
+#define SQLITE4_THREADS_IMPLEMENTED 1
+#include <windows.h>
+#include <process.h>
+
+/* A running thread */
+struct SQLiteThread {
+  sqlite4_env *pEnv;            /* Environment used to allocate this object */
+  void *tid;                    /* The thread handle */
+  unsigned id;                  /* The thread identifier */
+  void *(*xTask)(void*);        /* The routine to run as a thread */
+  void *pIn;                    /* Argument to xTask */
+  void *pResult;                /* Result of xTask */
+};
+
+/* Thread procedure Win32 compatibility shim */
+static unsigned __stdcall sqlite4ThreadProc(
+  void *pArg  /* IN: Pointer to the SQLiteThread structure */
+){
+  SQLiteThread *p = (SQLiteThread *)pArg;
+
+  assert( p!=0 );
+  assert( p->xTask!=0 );
+  p->pResult = p->xTask(p->pIn);
+  _endthreadex(0);
+  return 0; /* NOT REACHED */
+}
+
+/* Start a new thread */
+int sqlite4ThreadCreate(
+  sqlite4_env *pEnv,        /* Environment to allocate the thread object in */
+  SQLiteThread **ppThread,  /* OUT: Write the thread object here */
+  void *(*xTask)(void*),    /* Routine to run in a separate thread */
+  void *pIn                 /* Argument passed into xTask() */
+){
+  SQLiteThread *p;
+
+  assert( ppThread!=0 );
+  assert( xTask!=0 );
+  *ppThread = 0;
+  p = sqlite4_malloc(pEnv, sizeof(*p));
+  if( p==0 ) return SQLITE4_NOMEM;
+  memset(p, 0, sizeof(*p));
+  p->pEnv = pEnv;
+  p->xTask = xTask;
+  p->pIn = pIn;
+  p->tid = (void*)_beginthreadex(0, 0, sqlite4ThreadProc, p, 0, &p->id);
+  if( p->tid==0 ){
+    /* If a new thread cannot be started, run the task synchronously */
+    p->xTask = 0;
+    p->pResult = xTask(pIn);
+  }
+  *ppThread = p;
+  return SQLITE4_OK;
+}
+
+/* Get the results of the thread */
+int sqlite4ThreadJoin(SQLiteThread *p, void **ppOut){
+  DWORD rc;
+
+  assert( ppOut!=0 );
+  if( NEVER(p==0) ) return SQLITE4_NOMEM;
+  if( p->xTask==0 ){
+    rc = WAIT_OBJECT_0;
+  }else{
+    rc = WaitForSingleObject((HANDLE)p->tid, INFINITE);
+    CloseHandle((HANDLE)p->tid);
+  }
+  *ppOut = p->pResult;
+  sqlite4_free(p->pEnv, p);
+  return (rc==WAIT_OBJECT_0) ? SQLITE4_OK : SQLITE4_ERROR;
+}
+
+#endif /* SQLITE4_MUTEX_W32 */
+/******************************** End Win32 Threads *************************/
+
+
+/********************************* Single-Threaded **************************/
+#ifndef SQLITE4_THREADS_IMPLEMENTED
+/*
+** This implementation does not actually create a new thread.  It does the
+** work of the thread in the main thread, when the thread is created.
+*/
+
+/* A running thread */
+struct SQLiteThread {
+  sqlite4_env *pEnv;            /* Environment used to allocate this object */
+  void *pOut;                   /* Result returned by the task */
+};
+
+/* Create a new thread */
+int sqlite4ThreadCreate(
+  sqlite4_env *pEnv,        /* Environment to allocate the thread object in */
+  SQLiteThread **ppThread,  /* OUT: Write the thread object here */
+  void *(*xTask)(void*),    /* Routine to run in a separate thread */
+  void *pIn                 /* Argument passed into xTask() */
+){
+  SQLiteThread *p;
+
+  assert( ppThread!=0 );
+  assert( xTask!=0 );
+  *ppThread = 0;
+  p = sqlite4_malloc(pEnv, sizeof(*p));
+  if( p==0 ) return SQLITE4_NOMEM;
+  p->pEnv = pEnv;
+  p->pOut = xTask(pIn);
+  *ppThread = p;
+  return SQLITE4_OK;
+}
+
+/* Get the results of the thread */
+int sqlite4ThreadJoin(SQLiteThread *p, void **ppOut){
+  assert( ppOut!=0 );
+  if( NEVER(p==0) ) return SQLITE4_NOMEM;
+  *ppOut = p->pOut;
+  sqlite4_free(p->pEnv, p);
+  return SQLITE4_OK;
+}
+
+#endif /* !defined(SQLITE4_THREADS_IMPLEMENTED) */
+/****************************** End Single-Threaded *************************/
@@ -300,7 +300,7 @@ int sqlite4VdbeMemTranslate(Mem *pMem, u8 desiredEnc){
     }
 
     sqlite4VdbeMemRelease(pMem);
-    pMem->flags &= ~(MEM_Static|MEM_Dyn|MEM_Ephem);
+    pMem->flags &= ~(MEM_Static|MEM_Dyn|MEM_Ephem|MEM_KVRef);
     pMem->enc = desiredEnc;
     pMem->flags |= (MEM_Term|MEM_Dyn);
     pMem->z = (char*)buf.p;
@@ -210,6 +210,7 @@ static VdbeCursor *allocateCursor(
 
   assert( iCur<p->nCursor );
   if( p->apCsr[iCur] ){
+    sqlite4VdbeCursorRelease(p->apCsr[iCur], 1);
     sqlite4VdbeFreeCursor(p->apCsr[iCur]);
     p->apCsr[iCur] = 0;
   }
@@ -221,10 +222,25 @@ static VdbeCursor *allocateCursor(
     pCx->nField = nField;
     pCx->rowChnged = 1;
     sqlite4_buffer_init(&pCx->sSeekKey, p->db->pEnv->pMM);
+    sqlite4_buffer_init(&pCx->sBatchFirst, p->db->pEnv->pMM);
+    sqlite4_buffer_init(&pCx->sBatchLast, p->db->pEnv->pMM);
   }
   return pCx;
 }
 
+/*
+** Compare key aKey/nKey with the key in buffer pBuf, as memcmp() would.
+*/
+static int vdbeBatchKeyCmp(
+  const KVByteArray *aKey, KVSize nKey,
+  sqlite4_buffer *pBuf
+){
+  int n = (nKey<pBuf->n) ? nKey : pBuf->n;
+  int c = memcmp(aKey, pBuf->p, n);
+  if( c==0 ) c = nKey - pBuf->n;
+  return c;
+}
+
 /*
 ** Try to convert a value into a numeric representation if we can
 ** do so without loss of information.  In other words, if the string
@@ -440,7 +456,7 @@ static int assertFlagsOk(Mem *p){
 #endif
 
 
-#ifdef VDBE_PROFILE
+#if defined(VDBE_PROFILE) || !defined(SQLITE4_OMIT_EXPLAIN)
 
 /* 
 ** hwtime.h contains inline assembler code for implementing 
@@ -463,6 +479,78 @@ static int assertFlagsOk(Mem *p){
 #define CHECK_FOR_INTERRUPT \
    if( db->u1.isInterrupted ) goto abort_due_to_interrupt;
 
+/*
+** If the compiler supports taking the address of a label (GCC and clang
+** do), sqlite4VdbeExec() uses computed-goto dispatch.  Once an opcode
+** is finished, the next one is started by jumping through a table of
+** label addresses, OPCODE_LABEL_INITIALIZER from opcodes.h, instead of
+** going back around the main loop and through the switch statement.  This
+** skips the per-instruction checks that are only needed for progress
+** callbacks and test builds, and the range check of the switch.
+**
+** Debugging and profiling builds, which do extra work around every
+** instruction, always use the switch statement.  Define
+** SQLITE4_OMIT_COMPUTED_GOTO to use it in all builds.
+*/
+#if defined(__GNUC__) && !defined(SQLITE4_OMIT_COMPUTED_GOTO) \
+ && !defined(SQLITE4_DEBUG) && !defined(VDBE_PROFILE)
+# define VDBE_THREADED 1
+# define VDBE_OP_LABEL(X) vdbe_op_##X:
+#else
+# define VDBE_OP_LABEL(X)
+#endif
+
+#ifndef SQLITE4_OMIT_EXPLAIN
+/*
+** Start timing instruction pc, which has opcode "opcode", for EXPLAIN
+** PROFILE or EXPLAIN ANALYZE.  Instructions that belong to a trigger
+** sub-program (those run while p->pFrame is set) are only counted against
+** their opcode.
+*/
+static void vdbeProfileStart(Vdbe *p, VdbeProfile *pProf, int pc, u8 opcode){
+  pProf->iAddr = p->pFrame ? -1 : pc;
+  pProf->opcode = opcode;
+  pProf->kvStart = pProf->kv;
+  pProf->bActive = 1;
+  pProf->tStart = sqlite4Hwtime();
+}
+
+/*
+** Add the time taken and KV store calls made by an instruction to the
+** counters in pCnt.
+*/
+static void vdbeProfileAdd(
+  VdbeProfileCounter *pCnt,
+  u64 nCycle,
+  const KVProfile *pKV
+){
+  pCnt->nExec++;
+  pCnt->nCycle += nCycle;
+  pCnt->nKVCycle += pKV->nCycle;
+  pCnt->nKVSeek += pKV->nSeek;
+  pCnt->nKVNext += pKV->nNext;
+}
+
+/*
+** Stop timing the instruction passed to the most recent call to
+** vdbeProfileStart() and add the time taken to its counters.
+*/
+static void vdbeProfileEnd(VdbeProfile *pProf){
+  if( pProf->bActive ){
+    u64 nCycle = sqlite4Hwtime() - pProf->tStart;
+    KVProfile kv;
+    kv.nCycle = pProf->kv.nCycle - pProf->kvStart.nCycle;
+    kv.nSeek = pProf->kv.nSeek - pProf->kvStart.nSeek;
+    kv.nNext = pProf->kv.nNext - pProf->kvStart.nNext;
+    vdbeProfileAdd(&pProf->aOpcode[pProf->opcode], nCycle, &kv);
+    if( pProf->iAddr>=0 ){
+      vdbeProfileAdd(&pProf->aOp[pProf->iAddr], nCycle, &kv);
+    }
+    pProf->bActive = 0;
+  }
+}
+#endif
+
 /*
 ** Transfer error message text from an sqlite4_vtab.zErrMsg (text stored
 ** in memory obtained from sqlite4_malloc) into a Vdbe.zErrMsg (text stored
@@ -544,10 +632,26 @@ int sqlite4VdbeExec(
 #ifdef VDBE_PROFILE
   u64 start;                 /* CPU clock count at start of opcode */
   int origPc;                /* Program counter at start of opcode */
+#endif
+#ifdef VDBE_THREADED
+  static const void *const aOpLabel[] = OPCODE_LABEL_INITIALIZER;
+  int bThreaded = 1;         /* False to run every opcode through the loop */
+#endif
+#ifndef SQLITE4_OMIT_EXPLAIN
+  VdbeProfile *pProf = p->pProfile;  /* EXPLAIN PROFILE/ANALYZE counters */
+# ifdef SQLITE4_TLS
+  KVProfile *pKVSave = 0;    /* Saved value of sqlite4KVProfile */
+# endif
 #endif
   /*** INSERT STACK UNION HERE ***/
 
   assert( p->magic==VDBE_MAGIC_RUN );  /* sqlite4_step() verifies this */
+#if !defined(SQLITE4_OMIT_EXPLAIN) && defined(SQLITE4_TLS)
+  if( pProf ){
+    pKVSave = sqlite4KVProfile;
+    sqlite4KVProfile = &pProf->kv;
+  }
+#endif
   if( p->rc==SQLITE4_NOMEM ){
     /* This happens if a malloc() inside a call to sqlite4_column_text() or
     ** sqlite4_column_text16() failed.  */
@@ -555,13 +659,24 @@ int sqlite4VdbeExec(
   }
   assert( p->rc==SQLITE4_OK || p->rc==SQLITE4_BUSY );
   p->rc = SQLITE4_OK;
-  assert( p->explain==0 );
+  assert( p->explain==0 || p->pProfile );
   p->pResultSet = 0;
   CHECK_FOR_INTERRUPT;
   sqlite4VdbeIOTraceSql(p);
 #ifndef SQLITE4_OMIT_PROGRESS_CALLBACK
   checkProgress = db->xProgress!=0;
 #endif
+#ifdef VDBE_THREADED
+# ifndef SQLITE4_OMIT_PROGRESS_CALLBACK
+  if( checkProgress ) bThreaded = 0;
+# endif
+# ifdef SQLITE4_TEST
+  if( sqlite4_interrupt_count>0 ) bThreaded = 0;
+# endif
+# ifndef SQLITE4_OMIT_EXPLAIN
+  if( pProf ) bThreaded = 0;
+# endif
+#endif
 #ifdef SQLITE4_DEBUG
   sqlite4BeginBenignMalloc(db->pEnv);
   if( p->pc==0  && (db->flags & SQLITE4_VdbeListing)!=0 ){
@@ -582,6 +697,9 @@ int sqlite4VdbeExec(
     start = sqlite4Hwtime();
 #endif
     pOp = &aOp[pc];
+#ifndef SQLITE4_OMIT_EXPLAIN
+    if( pProf ) vdbeProfileStart(p, pProf, pc, pOp->opcode);
+#endif
 
     /* Only allow tracing if SQLITE4_DEBUG is defined.
     */
@@ -676,6 +794,9 @@ int sqlite4VdbeExec(
     }
 #endif
   
+#ifdef VDBE_THREADED
+vdbe_op_switch:
+#endif
     switch( pOp->opcode ){
 
 /*****************************************************************************
@@ -701,6 +822,11 @@ int sqlite4VdbeExec(
 ** Keywords include: in1, in2, in3, out2_prerelease, out2, out3.  See
 ** the mkopcodeh.awk script for additional information.
 **
+** Each "case OP_" line that is not within an #if block is preceded by a
+** VDBE_OP_LABEL() line for the same opcode.  These define the labels that
+** computed-goto dispatch jumps to.  Cases within an #if block do not have
+** them and are always dispatched through this switch.
+**
 ** Documentation about VDBE opcodes is generated by scanning this file
 ** for lines of that contain "Opcode:".  That line and all subsequent
 ** comment lines are used in the generation of the opcode.html documentation
@@ -720,6 +846,7 @@ int sqlite4VdbeExec(
 ** the one at index P2 from the beginning of
 ** the program.
 */
+VDBE_OP_LABEL(Goto)
 case OP_Goto: {             /* jump */
   CHECK_FOR_INTERRUPT;
   pc = pOp->p2 - 1;
@@ -731,6 +858,7 @@ case OP_Goto: {             /* jump */
 ** Write the current address onto register P1
 ** and then jump to address P2.
 */
+VDBE_OP_LABEL(Gosub)
 case OP_Gosub: {            /* jump */
   assert( pOp->p1>0 && pOp->p1<=p->nMem );
   pIn1 = &aMem[pOp->p1];
@@ -747,6 +875,7 @@ case OP_Gosub: {            /* jump */
 **
 ** Jump to the next instruction after the address in register P1.
 */
+VDBE_OP_LABEL(Return)
 case OP_Return: {           /* in1 */
   pIn1 = &aMem[pOp->p1];
   assert( pIn1->flags & MEM_Int );
@@ -758,6 +887,7 @@ case OP_Return: {           /* in1 */
 **
 ** Swap the program counter with the value in register P1.
 */
+VDBE_OP_LABEL(Yield)
 case OP_Yield: {            /* in1 */
   int pcDest;
   pIn1 = &aMem[pOp->p1];
@@ -776,6 +906,7 @@ case OP_Yield: {            /* in1 */
 ** parameter P1, P2, and P4 as if this were a Halt instruction.  If the
 ** value in register P3 is not NULL, then this routine is a no-op.
 */
+VDBE_OP_LABEL(HaltIfNull)
 case OP_HaltIfNull: {      /* in3 */
   pIn3 = &aMem[pOp->p3];
   if( (pIn3->flags & MEM_Null)==0 ) break;
@@ -801,6 +932,7 @@ case OP_HaltIfNull: {      /* in3 */
 ** every program.  So a jump past the last instruction of the program
 ** is the same as executing Halt.
 */
+VDBE_OP_LABEL(Halt)
 case OP_Halt: {
   if( pOp->p1==SQLITE4_OK && p->pFrame ){
     /* Halt the sub-program. Return control to the parent frame. */
@@ -852,6 +984,7 @@ case OP_Halt: {
 **
 ** The 32-bit integer value P1 is written into register P2.
 */
+VDBE_OP_LABEL(Integer)
 case OP_Integer: {         /* out2-prerelease */
   pOut->u.num = sqlite4_num_from_int64((i64)pOp->p1);
   MemSetTypeFlag(pOut, MEM_Int);
@@ -864,6 +997,7 @@ case OP_Integer: {         /* out2-prerelease */
 ** register P2. Set the register flags to MEM_Int if P1 is non-zero,
 ** or MEM_Real otherwise.
 */
+VDBE_OP_LABEL(Num)
 case OP_Num: {            /* out2-prerelease */
   pOut->flags = (pOp->p1 ? MEM_Int : MEM_Real);
   pOut->u.num = *(pOp->p4.pNum);
@@ -875,6 +1009,7 @@ case OP_Num: {            /* out2-prerelease */
 ** P4 points to a nul terminated UTF-8 string. This opcode is transformed 
 ** into an OP_String before it is executed for the first time.
 */
+VDBE_OP_LABEL(String8)
 case OP_String8: {         /* same as TK_STRING, out2-prerelease */
   assert( pOp->p4.z!=0 );
   pOp->opcode = OP_String;
@@ -909,6 +1044,7 @@ case OP_String8: {         /* same as TK_STRING, out2-prerelease */
 **
 ** The string value P4 of length P1 (bytes) is stored in register P2.
 */
+VDBE_OP_LABEL(String)
 case OP_String: {          /* out2-prerelease */
   assert( pOp->p4.z!=0 );
   pOut->flags = MEM_Str|MEM_Static|MEM_Term;
@@ -926,6 +1062,7 @@ case OP_String: {          /* out2-prerelease */
 ** is less than P2 (typically P3 is zero) then only register P2 is
 ** set to NULL
 */
+VDBE_OP_LABEL(Null)
 case OP_Null: {           /* out2-prerelease */
   int cnt;
   cnt = pOp->p3-pOp->p2;
@@ -947,6 +1084,7 @@ case OP_Null: {           /* out2-prerelease */
 ** P4 points to a blob of data P1 bytes long.  Store this
 ** blob in register P2.
 */
+VDBE_OP_LABEL(Blob)
 case OP_Blob: {                /* out2-prerelease */
   assert( pOp->p1 <= SQLITE4_MAX_LENGTH );
   sqlite4VdbeMemSetStr(pOut, pOp->p4.z, pOp->p1, 0, 0, 0);
@@ -962,6 +1100,7 @@ case OP_Blob: {                /* out2-prerelease */
 ** If the parameter is named, then its name appears in P4 and P3==1.
 ** The P4 value is used by sqlite4_bind_parameter_name().
 */
+VDBE_OP_LABEL(Variable)
 case OP_Variable: {            /* out2-prerelease */
   Mem *pVar;       /* Value being transferred */
 
@@ -983,6 +1122,7 @@ case OP_Variable: {            /* out2-prerelease */
 ** left holding a NULL.  It is an error for register ranges
 ** P1..P1+P3-1 and P2..P2+P3-1 to overlap.
 */
+VDBE_OP_LABEL(Move)
 case OP_Move: {
   char *zMalloc;   /* Holding variable for allocated memory */
   int n;           /* Number of registers left to copy */
@@ -1011,6 +1151,9 @@ case OP_Move: {
     }
 #endif
     pIn1->zMalloc = zMalloc;
+    if( pOut->flags & MEM_KVRef ){
+      Deephemeralize(pOut);
+    }
     REGISTER_TRACE(p2++, pOut);
     pIn1++;
     pOut++;
@@ -1025,6 +1168,7 @@ case OP_Move: {
 ** This instruction makes a deep copy of the value.  A duplicate
 ** is made of any string or blob constant.  See also OP_SCopy.
 */
+VDBE_OP_LABEL(Copy)
 case OP_Copy: {             /* in1, out2 */
   pIn1 = &aMem[pOp->p1];
   pOut = &aMem[pOp->p2];
@@ -1046,12 +1190,19 @@ case OP_Copy: {             /* in1, out2 */
 ** Thus the program must guarantee that the original will not change
 ** during the lifetime of the copy.  Use OP_Copy to make a complete
 ** copy.
+**
+** If register P1 refers directly to the row of a KV cursor (see
+** OPFLAG_KVREF on OP_Column), a complete copy is made regardless.
 */
+VDBE_OP_LABEL(SCopy)
 case OP_SCopy: {            /* in1, out2 */
   pIn1 = &aMem[pOp->p1];
   pOut = &aMem[pOp->p2];
   assert( pOut!=pIn1 );
   sqlite4VdbeMemShallowCopy(pOut, pIn1, MEM_Ephem);
+  if( pOut->flags & MEM_KVRef ){
+    Deephemeralize(pOut);
+  }
 #ifdef SQLITE4_DEBUG
   if( pOut->pScopyFrom==0 ) pOut->pScopyFrom = pIn1;
 #endif
@@ -1067,10 +1218,11 @@ case OP_SCopy: {            /* in1, out2 */
 ** structure to provide access to the top P1 values as the result
 ** row.
 */
+VDBE_OP_LABEL(ResultRow)
 case OP_ResultRow: {
   Mem *pMem;
   int i;
-  assert( p->nResColumn==pOp->p2 );
+  assert( p->nResColumn==pOp->p2 || p->explain );
   assert( pOp->p1>0 );
   assert( pOp->p1+pOp->p2<=p->nMem+1 );
   assert( p->nFkConstraint==0 );
@@ -1133,6 +1285,7 @@ case OP_ResultRow: {
 ** if P3 is the same register as P2, the implementation is able
 ** to avoid a memcpy().
 */
+VDBE_OP_LABEL(Concat)
 case OP_Concat: {           /* same as TK_CONCAT, in1, in2, out3 */
   i64 nByte;
 
@@ -1200,10 +1353,15 @@ case OP_Concat: {           /* same as TK_CONCAT, in1, in2, out3 */
 ** If the value in register P2 is zero the result is NULL.
 ** If either operand is NULL, the result is NULL.
 */
+VDBE_OP_LABEL(Add)
 case OP_Add:                   /* same as TK_PLUS, in1, in2, out3 */
+VDBE_OP_LABEL(Subtract)
 case OP_Subtract:              /* same as TK_MINUS, in1, in2, out3 */
+VDBE_OP_LABEL(Multiply)
 case OP_Multiply:              /* same as TK_STAR, in1, in2, out3 */
+VDBE_OP_LABEL(Divide)
 case OP_Divide:                /* same as TK_SLASH, in1, in2, out3 */
+VDBE_OP_LABEL(Remainder)
 case OP_Remainder: {           /* same as TK_REM, in1, in2, out3 */
   int flags;      /* Combined MEM_* flags from both inputs */
   i64 iA;         /* Integer value of left operand */
@@ -1296,6 +1454,7 @@ arithmetic_result_is_null:
 ** to retrieve the collation sequence set by this opcode is not available
 ** publicly, only to user functions defined in func.c.
 */
+VDBE_OP_LABEL(CollSeq)
 case OP_CollSeq: {
   assert( pOp->p4type==P4_COLLSEQ );
   break;
@@ -1303,6 +1462,7 @@ case OP_CollSeq: {
 
 /* Opcode: Mifunction P1
 */
+VDBE_OP_LABEL(KVMethod)
 case OP_KVMethod: {
   assert( pOp[1].opcode==OP_Function );
   break;
@@ -1310,6 +1470,7 @@ case OP_KVMethod: {
 
 /* Opcode: Mifunction P1
 */
+VDBE_OP_LABEL(Mifunction)
 case OP_Mifunction: {
   pc++;
   pOp++;
@@ -1332,6 +1493,7 @@ case OP_Mifunction: {
 **
 ** See also: AggStep and AggFinal
 */
+VDBE_OP_LABEL(Function)
 case OP_Function: {
   int i;
   Mem *pArg;
@@ -1466,9 +1628,13 @@ case OP_Function: {
 ** Store the result in register P3.
 ** If either input is NULL, the result is NULL.
 */
+VDBE_OP_LABEL(BitAnd)
 case OP_BitAnd:                 /* same as TK_BITAND, in1, in2, out3 */
+VDBE_OP_LABEL(BitOr)
 case OP_BitOr:                  /* same as TK_BITOR, in1, in2, out3 */
+VDBE_OP_LABEL(ShiftLeft)
 case OP_ShiftLeft:              /* same as TK_LSHIFT, in1, in2, out3 */
+VDBE_OP_LABEL(ShiftRight)
 case OP_ShiftRight: {           /* same as TK_RSHIFT, in1, in2, out3 */
   i64 iA;
   u64 uA;
@@ -1526,6 +1692,7 @@ case OP_ShiftRight: {           /* same as TK_RSHIFT, in1, in2, out3 */
 **
 ** To force any register to be an integer, just add 0.
 */
+VDBE_OP_LABEL(AddImm)
 case OP_AddImm: {            /* in1 */
   pIn1 = &aMem[pOp->p1];
   memAboutToChange(p, pIn1);
@@ -1541,6 +1708,7 @@ case OP_AddImm: {            /* in1 */
 ** without data loss, then jump immediately to P2, or if P2==0
 ** raise an SQLITE4_MISMATCH exception.
 */
+VDBE_OP_LABEL(MustBeInt)
 case OP_MustBeInt: {            /* jump, in1 */
   pIn1 = &aMem[pOp->p1];
   applyAffinity(pIn1, SQLITE4_AFF_NUMERIC, encoding);
@@ -1648,6 +1816,7 @@ case OP_ToNumeric: {                  /* same as TK_TO_NUMERIC, in1 */
 **
 ** A NULL value is not changed by this routine.  It remains NULL.
 */
+VDBE_OP_LABEL(ToInt)
 case OP_ToInt: {                  /* same as TK_TO_INT, in1 */
   pIn1 = &aMem[pOp->p1];
   if( (pIn1->flags & MEM_Null)==0 ){
@@ -1748,11 +1917,17 @@ case OP_ToReal: {                  /* same as TK_TO_REAL, in1 */
 ** the content of register P3 is greater than or equal to the content of
 ** register P1.  See the Lt opcode for additional information.
 */
+VDBE_OP_LABEL(Eq)
 case OP_Eq:               /* same as TK_EQ, jump, in1, in3 */
+VDBE_OP_LABEL(Ne)
 case OP_Ne:               /* same as TK_NE, jump, in1, in3 */
+VDBE_OP_LABEL(Lt)
 case OP_Lt:               /* same as TK_LT, jump, in1, in3 */
+VDBE_OP_LABEL(Le)
 case OP_Le:               /* same as TK_LE, jump, in1, in3 */
+VDBE_OP_LABEL(Gt)
 case OP_Gt:               /* same as TK_GT, jump, in1, in3 */
+VDBE_OP_LABEL(Ge)
 case OP_Ge: {             /* same as TK_GE, jump, in1, in3 */
   int res;            /* Result of the comparison of pIn1 against pIn3 */
   char affinity;      /* Affinity to use for comparison */
@@ -1833,6 +2008,7 @@ case OP_Ge: {             /* same as TK_GE, jump, in1, in3 */
 ** OP_Halt, or OP_ResultRow.  Typically the OP_Permutation should occur
 ** immediately prior to the OP_Compare.
 */
+VDBE_OP_LABEL(Permutation)
 case OP_Permutation: {
   assert( pOp->p4type==P4_INTARRAY );
   assert( pOp->p4.ai );
@@ -1854,6 +2030,7 @@ case OP_Permutation: {
 ** NULLs are less than numbers, numbers are less than strings,
 ** and strings are less than blobs.
 */
+VDBE_OP_LABEL(Compare)
 case OP_Compare: {
   int n;
   int i;
@@ -1906,6 +2083,7 @@ case OP_Compare: {
 ** in the most recent OP_Compare instruction the P1 vector was less than
 ** equal to, or greater than the P2 vector, respectively.
 */
+VDBE_OP_LABEL(Jump)
 case OP_Jump: {             /* jump */
   if( iCompare<0 ){
     pc = pOp->p1 - 1;
@@ -1935,7 +2113,9 @@ case OP_Jump: {             /* jump */
 ** even if the other input is NULL.  A NULL and false or two NULLs
 ** give a NULL output.
 */
+VDBE_OP_LABEL(And)
 case OP_And:              /* same as TK_AND, in1, in2, out3 */
+VDBE_OP_LABEL(Or)
 case OP_Or: {             /* same as TK_OR, in1, in2, out3 */
   int v1;    /* Left operand:  0==FALSE, 1==TRUE, 2==UNKNOWN or NULL */
   int v2;    /* Right operand: 0==FALSE, 1==TRUE, 2==UNKNOWN or NULL */
@@ -1975,6 +2155,7 @@ case OP_Or: {             /* same as TK_OR, in1, in2, out3 */
 ** boolean complement in register P2.  If the value in register P1 is 
 ** NULL, then a NULL is stored in P2.
 */
+VDBE_OP_LABEL(Not)
 case OP_Not: {                /* same as TK_NOT, in1, out2 */
   pIn1 = &aMem[pOp->p1];
   pOut = &aMem[pOp->p2];
@@ -1992,6 +2173,7 @@ case OP_Not: {                /* same as TK_NOT, in1, out2 */
 ** ones-complement of the P1 value into register P2.  If P1 holds
 ** a NULL then store a NULL in P2.
 */
+VDBE_OP_LABEL(BitNot)
 case OP_BitNot: {             /* same as TK_BITNOT, in1, out2 */
   pIn1 = &aMem[pOp->p1];
   pOut = &aMem[pOp->p2];
@@ -2010,6 +2192,7 @@ case OP_BitNot: {             /* same as TK_BITNOT, in1, out2 */
 **
 ** See also: JumpOnce
 */
+VDBE_OP_LABEL(Once)
 case OP_Once: {             /* jump */
   assert( pOp->p1<p->nOnceFlag );
   if( p->aOnceFlag[pOp->p1] ){
@@ -2032,7 +2215,9 @@ case OP_Once: {             /* jump */
 ** is considered false if it has a numeric value of zero.  If the value
 ** in P1 is NULL then take the jump if P3 is zero.
 */
+VDBE_OP_LABEL(If)
 case OP_If:                 /* jump, in1 */
+VDBE_OP_LABEL(IfNot)
 case OP_IfNot: {            /* jump, in1 */
   int c;
   pIn1 = &aMem[pOp->p1];
@@ -2054,6 +2239,7 @@ case OP_IfNot: {            /* jump, in1 */
 ** in an array of a single register. If any registers in the array are
 ** NULL, jump to instruction P2.
 */
+VDBE_OP_LABEL(IsNull)
 case OP_IsNull: {            /* same as TK_ISNULL, jump, in1 */
   Mem *pEnd;
   pIn1 = &aMem[pOp->p1];
@@ -2073,6 +2259,7 @@ case OP_IsNull: {            /* same as TK_ISNULL, jump, in1 */
 **
 ** Jump to P2 if the value in register P1 is not NULL.  
 */
+VDBE_OP_LABEL(NotNull)
 case OP_NotNull: {            /* same as TK_NOTNULL, jump, in1 */
   pIn1 = &aMem[pOp->p1];
   if( (pIn1->flags & MEM_Null)==0 ){
@@ -2099,7 +2286,14 @@ case OP_NotNull: {            /* same as TK_NOTNULL, jump, in1 */
 ** then the cache of the cursor is reset prior to extracting the column.
 ** The first OP_Column against a pseudo-table after the value of the content
 ** register has changed should have this bit set.
+**
+** If the OPFLAG_KVREF bit is set on P5, then a text or blob value may be
+** left pointing directly into the row held by the storage engine cursor
+** instead of being copied into register P3. This is only safe if P3 is
+** not read after cursor P1 advances to its next row. If P1 is moved by
+** any other means, register P3 is given a private copy of its value first.
 */
+VDBE_OP_LABEL(Column)
 case OP_Column: {
   int p1;                   /* Index of VdbeCursor to decode */
   int mxField;              /* Maximum column number */
@@ -2126,7 +2320,8 @@ case OP_Column: {
   }
   if( rc==SQLITE4_OK ){
     pDefault = (pOp->p4type==P4_MEM) ? pOp->p4.pMem : 0;
-    rc = sqlite4VdbeDecoderGetColumn(pC->pDecoder, pOp->p2, pDefault, pDest);
+    rc = sqlite4VdbeDecoderGetColumn(pC->pDecoder, pOp->p2, pDefault, pDest,
+                                     (pOp->p5 & OPFLAG_KVREF)!=0);
   }else{
     sqlite4VdbeMemSetNull(pDest);
   }
@@ -2156,7 +2351,9 @@ case OP_Column: {
 ** to content in the previously generated key in order to make the encoding
 ** smaller.
 */
+VDBE_OP_LABEL(MakeKey)
 case OP_MakeKey:
+VDBE_OP_LABEL(MakeRecord)
 case OP_MakeRecord: {
   VdbeCursor *pC;        /* The cursor for OP_MakeKey */
   Mem *pData0;           /* First field to be combined into the record */
@@ -2252,6 +2449,7 @@ case OP_MakeRecord: {
 ** string indicates the column affinity that should be used for the nth
 ** memory cell in the range.
 */
+VDBE_OP_LABEL(Affinity)
 case OP_Affinity: {
   const char *zAffinity;   /* The affinity to be applied */
   Mem *pEnd;
@@ -2276,6 +2474,7 @@ case OP_Affinity: {
 ** Store the number of entries (an integer value) in the table or index 
 ** opened by cursor P1 in register P2
 */
+VDBE_OP_LABEL(Count)
 case OP_Count: {         /* out2-prerelease */
   i64 nEntry;
   VdbeCursor *pC;
@@ -2306,6 +2505,7 @@ case OP_Count: {         /* out2-prerelease */
 **     RELEASE          1      <name of savepoint to release>
 **     ROLLBACK TO      2      <name of savepoint to rollback>
 */
+VDBE_OP_LABEL(Savepoint)
 case OP_Savepoint: {
   int iSave;
   Savepoint *pSave;               /* Savepoint object operated upon */
@@ -2415,6 +2615,7 @@ case OP_Savepoint: {
 ** entire transaction. If no error is encountered, the statement transaction
 ** will automatically commit when the VDBE halts.
 */
+VDBE_OP_LABEL(Transaction)
 case OP_Transaction: {
   Db *pDb;
   KVStore *pKV;
@@ -2458,6 +2659,7 @@ case OP_Transaction: {
 ** must be started or there must be an open cursor) before
 ** executing this instruction.
 */
+VDBE_OP_LABEL(ReadCookie)
 case OP_ReadCookie: {               /* out2-prerelease */
   unsigned int iMeta;
   KVStore *pKV;
@@ -2480,6 +2682,7 @@ case OP_ReadCookie: {               /* out2-prerelease */
 **
 ** A transaction must be started before executing this opcode.
 */
+VDBE_OP_LABEL(SetCookie)
 case OP_SetCookie: {       /* in3 */
   Db *pDb;
   i64 v;
@@ -2519,6 +2722,7 @@ case OP_SetCookie: {       /* in3 */
 ** to be executed (to establish a read lock) before this opcode is
 ** invoked.
 */
+VDBE_OP_LABEL(VerifyCookie)
 case OP_VerifyCookie: {
   unsigned int iMeta;
   int iGen;
@@ -2608,7 +2812,9 @@ case OP_VerifyCookie: {
 **
 ** See also OpenRead.
 */
+VDBE_OP_LABEL(OpenRead)
 case OP_OpenRead:
+VDBE_OP_LABEL(OpenWrite)
 case OP_OpenWrite: {
   int nField;
   KeyInfo *pKeyInfo;
@@ -2694,7 +2900,9 @@ case OP_OpenWrite: {
 ** by this opcode will be used for automatically created transient
 ** indices in joins.
 */
+VDBE_OP_LABEL(OpenAutoindex)
 case OP_OpenAutoindex: 
+VDBE_OP_LABEL(OpenEphemeral)
 case OP_OpenEphemeral: {
   VdbeCursor *pCx;
 
@@ -2720,6 +2928,7 @@ case OP_OpenEphemeral: {
 ** a transient index that is specifically designed to sort large
 ** tables using an external merge-sort algorithm.
 */
+VDBE_OP_LABEL(SorterOpen)
 case OP_SorterOpen: {
   /* VdbeCursor *pCx; */
   pOp->opcode = OP_OpenEphemeral;
@@ -2732,8 +2941,12 @@ case OP_SorterOpen: {
 ** Close a cursor previously opened as P1.  If P1 is not
 ** currently open, this instruction is a no-op.
 */
+VDBE_OP_LABEL(Close)
 case OP_Close: {
   assert( pOp->p1>=0 && pOp->p1<p->nCursor );
+  if( p->apCsr[pOp->p1] ){
+    rc = sqlite4VdbeCursorRelease(p->apCsr[pOp->p1], 1);
+  }
   sqlite4VdbeFreeCursor(p->apCsr[pOp->p1]);
   p->apCsr[pOp->p1] = 0;
   break;
@@ -2755,6 +2968,7 @@ case OP_Close: {
 ** row does not exist in the PRIMARY KEY table, then the
 ** sqlite3VdbeCursorMoveto() routine will throw an SQLITE4_CORRUPT error.
 */
+VDBE_OP_LABEL(SeekPk)
 case OP_SeekPk: {
   KVByteArray *aKey;              /* Key data from cursor pIdx */
   KVSize nKey;                    /* Size of aKey[] in bytes */
@@ -2766,6 +2980,12 @@ case OP_SeekPk: {
   pPk = p->apCsr[pOp->p1];
   pIdx = p->apCsr[pOp->p3];
 
+  /* Cursor pPk is only ever moved by this opcode once per iteration of
+  ** the loop over pIdx, so registers that refer to its current row are
+  ** dead at this point.  */
+  rc = sqlite4VdbeCursorRelease(pPk, 0);
+  if( rc!=SQLITE4_OK ) break;
+
   if( pIdx->pFts ){
     rc = sqlite4Fts5Pk(pIdx->pFts, pPk->iRoot, &aKey, &nKey);
     if( rc==SQLITE4_OK ){
@@ -2839,9 +3059,13 @@ case OP_SeekPk: {
 **
 ** See also: Found, NotFound, Distinct, SeekGt, SeekGe, SeekLt
 */
+VDBE_OP_LABEL(SeekLt)
 case OP_SeekLt:         /* jump, in3 */
+VDBE_OP_LABEL(SeekLe)
 case OP_SeekLe:         /* jump, in3 */
+VDBE_OP_LABEL(SeekGe)
 case OP_SeekGe:         /* jump, in3 */
+VDBE_OP_LABEL(SeekGt)
 case OP_SeekGt: {       /* jump, in3 */
   int op;                         /* Copy of pOp->opcode (the op-code) */
   VdbeCursor *pC;                 /* Cursor P1 */
@@ -2855,6 +3079,8 @@ case OP_SeekGt: {       /* jump, in3 */
   pC = p->apCsr[pOp->p1];
   pC->nullRow = 0;
   pC->sSeekKey.n = 0;
+  rc = sqlite4VdbeCursorRelease(pC, 1);
+  if( rc!=SQLITE4_OK ) break;
   pC->rowChnged = 1;
 
   assert( pOp->p1>=0 && pOp->p1<p->nCursor );
@@ -2931,6 +3157,160 @@ case OP_SeekGt: {       /* jump, in3 */
   }
   break;
 }
+
+/* Opcode: SeekBatch P1 P2 P3 P4 *
+**
+** Cursor P1 is sought by the inner loop of a join using keys computed
+** from the current row of cursor P3, over which the enclosing loop
+** iterates. P4 is an integer, the number of a second cursor open on the
+** same table as P3.
+**
+** If seek batching is disabled (see SQLITE4_DBCONFIG_SEEK_BATCH), if the
+** statement may write to the database, or if the batch of cursor P1 is
+** still valid and was filled by looking ahead over a range of rows of P3
+** that includes its current row, jump to P2.
+**
+** Otherwise, empty the batch of cursor P1, move cursor P4 to the current
+** row of P3 and fall through. The code that follows computes the key
+** for each row of P4 in turn, adds it to the batch with SeekBatchAdd,
+** and moves P4 on using SeekBatchNext.
+*/
+VDBE_OP_LABEL(SeekBatch)
+case OP_SeekBatch: {    /* jump */
+  VdbeCursor *pC;                 /* Cursor P1 */
+  VdbeCursor *pOuter;             /* Cursor P3 */
+  VdbeCursor *pLook;              /* Cursor P4 */
+  const KVByteArray *aKey;        /* Key of current row of P3 */
+  KVSize nKey;                    /* Size of aKey[] in bytes */
+
+  assert( pOp->p1>=0 && pOp->p1<p->nCursor );
+  assert( pOp->p3>=0 && pOp->p3<p->nCursor );
+  assert( pOp->p4type==P4_INT32 && pOp->p4.i>=0 && pOp->p4.i<p->nCursor );
+  pC = p->apCsr[pOp->p1];
+  pOuter = p->apCsr[pOp->p3];
+  pLook = p->apCsr[pOp->p4.i];
+  assert( pC!=0 && pOuter!=0 && pLook!=0 );
+
+  /* If a statement has been stepped from within this one (by a user
+  ** function, for example), the database may have changed.  */
+  if( db->iStepGen!=p->iStepGen ){
+    p->iBatchGen++;
+    p->iStepGen = db->iStepGen;
+  }
+
+  if( db->nSeekBatch<=0 || p->readOnly==0
+   || pOuter->nullRow || pOuter->sSeekKey.n
+  ){
+    sqlite4KVCursorBatchClear(pC->pKVCur);
+    pC->nBatchRow = 0;
+    pc = pOp->p2 - 1;
+    break;
+  }
+  rc = sqlite4KVCursorKey(pOuter->pKVCur, &aKey, &nKey);
+  if( rc!=SQLITE4_OK ) break;
+  if( pC->iBatchGen==p->iBatchGen && pC->nBatchRow>0 ){
+    int c1 = vdbeBatchKeyCmp(aKey, nKey, &pC->sBatchFirst);
+    int c2 = vdbeBatchKeyCmp(aKey, nKey, &pC->sBatchLast);
+    if( (c1>=0 && c2<=0) || (c1<=0 && c2>=0) ){
+      pc = pOp->p2 - 1;
+      break;
+    }
+  }
+
+  rc = sqlite4VdbeCursorRelease(pC, 1);
+  if( rc!=SQLITE4_OK ) break;
+  sqlite4KVCursorBatchClear(pC->pKVCur);
+  pC->rowChnged = 1;
+  pC->nBatchRow = 0;
+  rc = sqlite4_buffer_set(&pC->sBatchFirst, aKey, nKey);
+  if( rc!=SQLITE4_OK ) break;
+
+  rc = sqlite4VdbeCursorRelease(pLook, 1);
+  if( rc!=SQLITE4_OK ) break;
+  pLook->nullRow = 0;
+  pLook->rowChnged = 1;
+  pLook->sSeekKey.n = 0;
+  rc = sqlite4KVCursorSeek(pLook->pKVCur, aKey, nKey, 0);
+  if( rc==SQLITE4_NOTFOUND ){
+    rc = SQLITE4_OK;
+    pc = pOp->p2 - 1;
+  }
+  break;
+}
+
+/* Opcode: SeekBatchAdd P1 P2 * * *
+**
+** Register P2 holds a key constructed by MakeKey for cursor P1. Add it
+** to the batch of keys that cursor P1 will seek for.
+*/
+VDBE_OP_LABEL(SeekBatchAdd)
+case OP_SeekBatchAdd: {
+  VdbeCursor *pC;
+
+  assert( pOp->p1>=0 && pOp->p1<p->nCursor );
+  pC = p->apCsr[pOp->p1];
+  assert( pC!=0 );
+  pIn2 = &aMem[pOp->p2];
+  assert( pIn2->flags & MEM_Blob );
+  rc = sqlite4KVCursorBatchAdd(
+      &pC->pKVCur, (const KVByteArray*)pIn2->z, pIn2->n
+  );
+  break;
+}
+
+/* Opcode: SeekBatchNext P1 P2 P3 * P5
+**
+** Cursor P1 is the second cursor used by the SeekBatch opcode that
+** fills the batch of cursor P3. If fewer than SQLITE4_DBCONFIG_SEEK_BATCH
+** rows have been looked ahead over, advance cursor P1 and, if it
+** still points to a valid row, jump to P2. The cursor is moved to the
+** previous row if P5 is non-zero, or to the next otherwise.
+**
+** Otherwise, seek for all keys in the batch of cursor P3 in key order,
+** so that the seeks that follow are answered from memory.
+*/
+VDBE_OP_LABEL(SeekBatchNext)
+case OP_SeekBatchNext: {
+  VdbeCursor *pLook;              /* Cursor P1 */
+  VdbeCursor *pC;                 /* Cursor P3 */
+  const KVByteArray *aKey;
+  KVSize nKey;
+
+  assert( pOp->p1>=0 && pOp->p1<p->nCursor );
+  assert( pOp->p3>=0 && pOp->p3<p->nCursor );
+  pLook = p->apCsr[pOp->p1];
+  pC = p->apCsr[pOp->p3];
+  assert( pLook!=0 && pC!=0 );
+
+  rc = sqlite4KVCursorKey(pLook->pKVCur, &aKey, &nKey);
+  if( rc==SQLITE4_OK ){
+    rc = sqlite4_buffer_set(&pC->sBatchLast, aKey, nKey);
+  }
+  if( rc!=SQLITE4_OK ) break;
+  pC->nBatchRow++;
+
+  if( pC->nBatchRow<db->nSeekBatch ){
+    if( pOp->p5 ){
+      rc = sqlite4VdbePrevious(pLook);
+    }else{
+      rc = sqlite4VdbeNext(pLook);
+    }
+    if( rc==SQLITE4_OK ){
+      pc = pOp->p2 - 1;
+      break;
+    }
+    if( rc!=SQLITE4_NOTFOUND ) break;
+  }
+
+  rc = sqlite4KVCursorBatchRun(pC->pKVCur);
+  if( rc!=SQLITE4_OK ){
+    pC->nBatchRow = 0;
+    break;
+  }
+  pC->iBatchGen = p->iBatchGen;
+  pC->rowChnged = 1;
+  break;
+}
  
 
 /* Opcode: Found P1 P2 P3 P4 *
@@ -2971,12 +3351,15 @@ case OP_SeekGt: {       /* jump, in3 */
 **
 ** See also: Found, NotFound, IsUnique
 */
+VDBE_OP_LABEL(NotExists)
 case OP_NotExists: {    /* jump, in3 */
   pOp->p4.i = 1;
   pOp->p4type = P4_INT32;
   /* Fall through into OP_NotFound */
 }
+VDBE_OP_LABEL(NotFound)
 case OP_NotFound:       /* jump, in3 */
+VDBE_OP_LABEL(Found)
 case OP_Found: {        /* jump, in3 */
   int alreadyExists;
   VdbeCursor *pC;
@@ -2995,6 +3378,8 @@ case OP_Found: {        /* jump, in3 */
   assert( pOp->p4type==P4_INT32 );
   pC = p->apCsr[pOp->p1];
   pC->sSeekKey.n = 0;
+  rc = sqlite4VdbeCursorRelease(pC, 1);
+  if( rc!=SQLITE4_OK ) break;
   pC->rowChnged = 1;
   assert( pC!=0 );
   pIn3 = &aMem[pOp->p3];
@@ -3046,6 +3431,7 @@ case OP_Found: {        /* jump, in3 */
 ** and the PRIMARY KEY values from the index entry causing the UNIQUE
 ** constraint to fail.
 */
+VDBE_OP_LABEL(IsUnique)
 case OP_IsUnique: {        /* jump, in3 */
   VdbeCursor *pC;
   Mem *pProbe;
@@ -3063,6 +3449,8 @@ case OP_IsUnique: {        /* jump, in3 */
 
   pProbe = &aMem[pOp->p3];
   pC = p->apCsr[pOp->p1];
+  rc = sqlite4VdbeCursorRelease(pC, 1);
+  if( rc!=SQLITE4_OK ) break;
   pC->rowChnged = 1;
   pOut = (pOp->p4.i==0 ? 0 : &aMem[pOp->p4.i]);
   bPk = (pC->pKeyInfo->nPK==0);
@@ -3114,6 +3502,7 @@ case OP_IsUnique: {        /* jump, in3 */
 ** The sequence number on the cursor is incremented after this
 ** instruction.  
 */
+VDBE_OP_LABEL(Sequence)
 case OP_Sequence: {           /* out2-prerelease */
   assert( pOp->p1>=0 && pOp->p1<p->nCursor );
   assert( p->apCsr[pOp->p1]!=0 );
@@ -3131,6 +3520,7 @@ case OP_Sequence: {           /* out2-prerelease */
 ** frame that holds a lower bound for the new rowid.  In other words, the
 ** new rowid must be no less than reg[P3]+1.
 */
+VDBE_OP_LABEL(NewRowid)
 case OP_NewRowid: {           /* out2-prerelease */
   i64 v;                   /* The new rowid */
   VdbeCursor *pC;          /* Cursor of table to get the new rowid */
@@ -3216,6 +3606,7 @@ case OP_NewRowid: {           /* out2-prerelease */
 **   * the largest index number still visible in the database using the 
 **     LEFAST query mode used by OP_NewRowid in database P2.
 */
+VDBE_OP_LABEL(NewIdxid)
 case OP_NewIdxid: {          /* in1 */
   u64 iMax;
   i64 i1;
@@ -3269,12 +3660,15 @@ case OP_NewIdxid: {          /* in1 */
 **
 ** P1 must not be pseudo-table. It has to be a real table.
 */
+VDBE_OP_LABEL(Delete)
 case OP_Delete: {
   VdbeCursor *pC;
   assert( pOp->p1>=0 && pOp->p1<p->nCursor );
   pC = p->apCsr[pOp->p1];
   assert( pC!=0 );
   assert( pC->sSeekKey.n==0 );
+  rc = sqlite4VdbeCursorRelease(pC, 1);
+  if( rc!=SQLITE4_OK ) break;
   pC->rowChnged = 1;
   rc = sqlite4KVCursorDelete(pC->pKVCur);
   if( pOp->p2 & OPFLAG_NCHANGE ) p->nChange++;
@@ -3288,6 +3682,7 @@ case OP_Delete: {
 ** Then the VMs internal change counter resets to 0.
 ** This is used by trigger programs.
 */
+VDBE_OP_LABEL(ResetCount)
 case OP_ResetCount: {
   sqlite4VdbeSetChanges(db, p->nChange);
   p->nChange = 0;
@@ -3308,6 +3703,7 @@ case OP_ResetCount: {
 ** key of P1 (minus the sequence number) and fall through to the next
 ** instruction.
 */
+VDBE_OP_LABEL(GrpCompare)
 case OP_GrpCompare: {
   VdbeCursor *pC;                 /* Cursor P1 */
   KVByteArray const *aKey;        /* Key from cursor P1 */
@@ -3361,8 +3757,11 @@ case OP_GrpCompare: {
 ** the blob copied into register P2 is the first field of the index-key
 ** only.
 */
+VDBE_OP_LABEL(SorterData)
 case OP_SorterData:
+VDBE_OP_LABEL(RowKey)
 case OP_RowKey:
+VDBE_OP_LABEL(RowData)
 case OP_RowData: {
   VdbeCursor *pC;
   KVCursor *pCrsr;
@@ -3419,6 +3818,7 @@ case OP_RowData: {
 ** Finally, the key belonging to the current row of cursor P1 is copied
 ** into register P2.
 */
+VDBE_OP_LABEL(AnalyzeKey)
 case OP_AnalyzeKey: {
   VdbeCursor *pC;
   const KVByteArray *pNew;
@@ -3480,6 +3880,7 @@ case OP_AnalyzeKey: {
 ** be a separate OP_VRowid opcode for use with virtual tables, but this
 ** one opcode now works for both table types.
 */
+VDBE_OP_LABEL(Rowid)
 case OP_Rowid: {                 /* out2-prerelease */
   VdbeCursor *pC;
   i64 v;
@@ -3523,6 +3924,7 @@ case OP_Rowid: {                 /* out2-prerelease */
 ** that occur while the cursor is on the null row will always
 ** write a NULL.
 */
+VDBE_OP_LABEL(NullRow)
 case OP_NullRow: {
   VdbeCursor *pC;
 
@@ -3542,6 +3944,7 @@ case OP_NullRow: {
 ** If P2 is 0 or if the table or index is not empty, fall through
 ** to the following instruction.
 */
+VDBE_OP_LABEL(Last)
 case OP_Last: {        /* jump */
   VdbeCursor *pC;
 
@@ -3571,8 +3974,10 @@ case OP_Last: {        /* jump */
 ** regression tests can determine whether or not the optimizer is
 ** correctly optimizing out sorts.
 */
+VDBE_OP_LABEL(SorterSort)
 case OP_SorterSort:    /* jump */
   pOp->opcode = OP_Sort;
+VDBE_OP_LABEL(Sort)
 case OP_Sort: {        /* jump */
 #ifdef SQLITE4_TEST
   sqlite4_sort_count++;
@@ -3589,6 +3994,7 @@ case OP_Sort: {        /* jump */
 ** If P2 is 0 or if the table or index is not empty, fall through
 ** to the following instruction.
 */
+VDBE_OP_LABEL(Rewind)
 case OP_Rewind: {        /* jump */
   VdbeCursor *pC;
   int doJump;
@@ -3644,9 +4050,12 @@ case OP_Rewind: {        /* jump */
 ** If P5 is positive and the jump is taken, then event counter
 ** number P5-1 in the prepared statement is incremented.
 */
+VDBE_OP_LABEL(SorterNext)
 case OP_SorterNext:    /* jump */
   pOp->opcode = OP_Next;
+VDBE_OP_LABEL(Prev)
 case OP_Prev:          /* jump */
+VDBE_OP_LABEL(Next)
 case OP_Next: {        /* jump */
   VdbeCursor *pC;
 
@@ -3659,6 +4068,8 @@ case OP_Next: {        /* jump */
   }
   assert( pOp->opcode!=OP_Next || pOp->p4.xAdvance==sqlite4VdbeNext );
   assert( pOp->opcode!=OP_Prev || pOp->p4.xAdvance==sqlite4VdbePrevious );
+  rc = sqlite4VdbeCursorRelease(pC, 0);
+  if( rc!=SQLITE4_OK ) break;
   rc = pOp->p4.xAdvance(pC);
   if( rc==SQLITE4_OK ){
     pc = pOp->p2 - 1;
@@ -3688,6 +4099,7 @@ case OP_Next: {        /* jump */
 ** If the OPFLAG_NCHANGE flag of P5 is set, then the row change count is
 ** incremented (otherwise not).
 */
+VDBE_OP_LABEL(Insert)
 case OP_Insert: {
   VdbeCursor *pC;
   Mem *pKey;
@@ -3727,11 +4139,100 @@ case OP_Insert: {
   break;
 }
 
+/* Opcode: SorterInsert P1 P2 P3 * P5
+**
+** Register P3 holds the key and register P2 holds the data (or P2 is 0
+** if there is no data) for an entry in the index open on cursor P1.
+** Instead of writing the entry to the index, add it to an in-memory
+** buffer associated with the cursor. The buffered entries are written
+** to the index by a subsequent SorterWrite. If the buffer grows larger
+** than SQLITE4_LIMIT_SORTER_SIZE bytes, its contents are sorted and
+** written to the index immediately, as a single run, and the buffer
+** emptied. The index must be empty when the first entry is added.
+**
+** If P5 is non-zero, then the entry is subject to a UNIQUE constraint,
+** unless one or more of its indexed column values is NULL. No two such
+** entries may share the same set of indexed column values (i.e. the same
+** key once the PRIMARY KEY fields have been removed from the end of it).
+*/
+VDBE_OP_LABEL(SorterInsert)
+case OP_SorterInsert: {
+  VdbeCursor *pC;
+  Mem *pKey;
+  Mem *pData;
+  int nPrefix;
+
+  pC = p->apCsr[pOp->p1];
+  pKey = &aMem[pOp->p3];
+  pData = pOp->p2 ? &aMem[pOp->p2] : 0;
+
+  assert( pOp->p1>=0 && pOp->p1<p->nCursor );
+  assert( pC && pC->pKeyInfo );
+  assert( pKey->flags & MEM_Blob );
+  assert( pData==0 || (pData->flags & MEM_Blob) );
+
+  nPrefix = 0;
+  if( pOp->p5 ){
+    int nField = pC->pKeyInfo->nField - pC->pKeyInfo->nPK;
+    if( !sqlite4VdbeKeyHasNull((u8 *)pKey->z, pKey->n, nField) ){
+      nPrefix = sqlite4VdbeShortKey((u8 *)pKey->z, pKey->n, nField, 0);
+    }
+  }
+  rc = sqlite4VdbeSorterInsert(db, &pC->pSorter, 
+      (u8 *)pKey->z, pKey->n,
+      (u8 *)(pData ? pData->z : 0), (pData ? pData->n : 0), nPrefix
+  );
+  if( rc==SQLITE4_OK 
+   && sqlite4VdbeSorterSize(pC->pSorter)>=db->aLimit[SQLITE4_LIMIT_SORTER_SIZE]
+  ){
+    int bDup;
+    assert( pC->pKVCur );
+    rc = sqlite4VdbeCursorRelease(pC, 1);
+    if( rc==SQLITE4_OK ){
+      rc = sqlite4VdbeSorterFlush(db, pC->pSorter, pC->pKVCur, 0, &bDup);
+      pC->rowChnged = 1;
+    }
+  }
+  break;
+}
+
+/* Opcode: SorterWrite P1 P2 * * *
+**
+** Sort the entries buffered by SorterInsert instructions on cursor P1
+** and write them to the index in key order, then jump to P2. Sorting
+** may use up to SQLITE4_LIMIT_WORKER_THREADS auxiliary threads.
+**
+** If two entries inserted with a non-zero P5 violate the UNIQUE
+** constraint, control falls through to the next instruction. In this
+** case the index may contain runs written by earlier SorterInsert
+** instructions, so the statement must be aborted.
+*/
+VDBE_OP_LABEL(SorterWrite)
+case OP_SorterWrite: {     /* jump */
+  VdbeCursor *pC;
+  int bDup;
+
+  pC = p->apCsr[pOp->p1];
+  assert( pOp->p1>=0 && pOp->p1<p->nCursor );
+  assert( pC && pC->pKVCur && pC->pKVCur->pStore );
+
+  rc = sqlite4VdbeCursorRelease(pC, 1);
+  if( rc==SQLITE4_OK ){
+    rc = sqlite4VdbeSorterFlush(db, pC->pSorter, pC->pKVCur, 0, &bDup);
+    pC->rowChnged = 1;
+    if( rc==SQLITE4_OK && bDup==0 ) pc = pOp->p2 - 1;
+  }
+  sqlite4VdbeSorterFree(db, pC->pSorter);
+  pC->pSorter = 0;
+  break;
+}
+
 /* Opcode: IdxDelete P1 * P3 * *
 **
 ** P1 is a cursor open on a database index. P3 contains a key suitable for
 ** the index. Delete P3 from P1 if it is present.
 */
+VDBE_OP_LABEL(IdxDelete)
 case OP_IdxDelete: {
   VdbeCursor *pC;
   Mem *pKey;
@@ -3743,7 +4244,10 @@ case OP_IdxDelete: {
   assert( pC && pC->pKVCur && pC->pKVCur->pStore );
   assert( pKey->flags & MEM_Blob );
 
-  rc = sqlite4KVCursorSeek(pC->pKVCur, (u8 *)pKey->z, pKey->n, 0);
+  rc = sqlite4VdbeCursorRelease(pC, 1);
+  if( rc==SQLITE4_OK ){
+    rc = sqlite4KVCursorSeek(pC->pKVCur, (u8 *)pKey->z, pKey->n, 0);
+  }
   if( rc==SQLITE4_OK ){
     rc = sqlite4KVCursorDelete(pC->pKVCur);
   }else if( rc==SQLITE4_NOTFOUND ){
@@ -3763,6 +4267,7 @@ case OP_IdxDelete: {
 **
 ** See also: Rowkey
 */
+VDBE_OP_LABEL(IdxRowkey)
 case OP_IdxRowkey: {              /* out2-prerelease */
   KVByteArray const *aKey;        /* Key data from cursor pIdx */
   KVSize nKey;                    /* Size of aKey[] in bytes */
@@ -3815,9 +4320,13 @@ case OP_IdxRowkey: {              /* out2-prerelease */
 ** instruction. The comparison is done using memcmp(), except that if P3
 ** is a prefix of the P1 key they are considered equal.
 */
+VDBE_OP_LABEL(IdxLT)
 case OP_IdxLT:          /* jump */
+VDBE_OP_LABEL(IdxLE)
 case OP_IdxLE:          /* jump */
+VDBE_OP_LABEL(IdxGE)
 case OP_IdxGE:          /* jump */
+VDBE_OP_LABEL(IdxGT)
 case OP_IdxGT: {        /* jump */
   VdbeCursor *pC;                 /* Cursor P1 */
   KVByteArray const *aKey;        /* Key from cursor P1 */
@@ -3863,6 +4372,7 @@ case OP_IdxGT: {        /* jump */
 **
 ** See also: Destroy
 */
+VDBE_OP_LABEL(Clear)
 case OP_Clear: {
   KVCursor *pCur;
   KVByteArray const *aKey;
@@ -3898,6 +4408,7 @@ case OP_Clear: {
 ** This opcode invokes the parser to create a new virtual machine,
 ** then runs the new virtual machine.  It is thus a re-entrant opcode.
 */
+VDBE_OP_LABEL(ParseSchema)
 case OP_ParseSchema: {
   int iDb;
   const char *zMaster;
@@ -3955,6 +4466,7 @@ case OP_LoadAnalysis: {
 ** is dropped in order to keep the internal representation of the
 ** schema consistent with what is on disk.
 */
+VDBE_OP_LABEL(DropTable)
 case OP_DropTable: {
   sqlite4UnlinkAndDeleteTable(db, pOp->p1, pOp->p4.z);
   break;
@@ -3967,6 +4479,7 @@ case OP_DropTable: {
 ** is dropped in order to keep the internal representation of the
 ** schema consistent with what is on disk.
 */
+VDBE_OP_LABEL(DropIndex)
 case OP_DropIndex: {
   sqlite4UnlinkAndDeleteIndex(db, pOp->p1, pOp->p4.z);
   break;
@@ -3979,6 +4492,7 @@ case OP_DropIndex: {
 ** is dropped in order to keep the internal representation of the
 ** schema consistent with what is on disk.
 */
+VDBE_OP_LABEL(DropTrigger)
 case OP_DropTrigger: {
   sqlite4UnlinkAndDeleteTrigger(db, pOp->p1, pOp->p4.z);
   break;
@@ -3993,6 +4507,7 @@ case OP_DropTrigger: {
 **
 ** TODO: Optimization similar to SQLite 3 using P4.
 */
+VDBE_OP_LABEL(RowSetTest)
 case OP_RowSetTest: {        /* in1, in3, jump */
   int iSet;
   pIn1 = &aMem[pOp->p1];
@@ -4013,6 +4528,7 @@ case OP_RowSetTest: {        /* in1, in3, jump */
 **
 ** Read the blob value from register P2 and store it in RowSet object P1.
 */
+VDBE_OP_LABEL(RowSetAdd)
 case OP_RowSetAdd: {         /* in1, in3 */
   pIn1 = &aMem[pOp->p1];
   if( (pIn1->flags & MEM_RowSet)==0 ){
@@ -4031,6 +4547,7 @@ case OP_RowSetAdd: {         /* in1, in3 */
 ** Or, if MemSet P1 is already empty, leave P3 unchanged and jump to 
 ** instruction P2.
 */
+VDBE_OP_LABEL(RowSetRead)
 case OP_RowSetRead: {       /* in1 */
   const u8 *aKey;
   int nKey;
@@ -4174,6 +4691,9 @@ case OP_Param: {           /* out2-prerelease */
   pIn = &pFrame->aMem[pOp->p1 + pFrame->aOp[pFrame->pc].p1];   
   assert( memIsValid(pIn) );
   sqlite4VdbeMemShallowCopy(pOut, pIn, MEM_Ephem);
+  if( pOut->flags & MEM_KVRef ){
+    Deephemeralize(pOut);
+  }
   break;
 }
 
@@ -4255,6 +4775,7 @@ case OP_MemMax: {        /* in2 */
 ** It is illegal to use this instruction on a register that does
 ** not contain an integer.  An assertion fault will result if you try.
 */
+VDBE_OP_LABEL(IfPos)
 case OP_IfPos: {        /* jump, in1 */
   i64 i1;
   pIn1 = &aMem[pOp->p1];
@@ -4273,6 +4794,7 @@ case OP_IfPos: {        /* jump, in1 */
 ** It is illegal to use this instruction on a register that does
 ** not contain an integer.  An assertion fault will result if you try.
 */
+VDBE_OP_LABEL(IfNeg)
 case OP_IfNeg: {        /* jump, in1 */
   i64 i1;
   pIn1 = &aMem[pOp->p1];
@@ -4292,6 +4814,7 @@ case OP_IfNeg: {        /* jump, in1 */
 ** It is illegal to use this instruction on a register that does
 ** not contain an integer.  An assertion fault will result if you try.
 */
+VDBE_OP_LABEL(IfZero)
 case OP_IfZero: {        /* jump, in1 */
   i64 i1;
   pIn1 = &aMem[pOp->p1];
@@ -4315,6 +4838,7 @@ case OP_IfZero: {        /* jump, in1 */
 ** The P5 arguments are taken from register P2 and its
 ** successors.
 */
+VDBE_OP_LABEL(AggStep)
 case OP_AggStep: {
   int n;
   int i;
@@ -4376,6 +4900,7 @@ case OP_AggStep: {
 ** P4 argument is only needed for the degenerate case where
 ** the step function was not previously called.
 */
+VDBE_OP_LABEL(AggFinal)
 case OP_AggFinal: {
   Mem *pMem;
   assert( pOp->p1>0 && pOp->p1<=p->nMem );
@@ -4395,6 +4920,41 @@ case OP_AggFinal: {
   break;
 }
 
+/* Opcode: ParallelAgg P1 P2 P3 P4 *
+**
+** Evaluate P3 simple aggregates over all rows of the table that cursor
+** P1 is open on, using up to SQLITE4_LIMIT_WORKER_THREADS auxiliary
+** threads. P4 is an array of 4*P3 integers. For each aggregate, the four
+** integers are:
+**
+**   * A PARAGG_* value identifying the aggregate function,
+**   * The index of the table column aggregated, or -1 for count(*),
+**   * True if the column has REAL affinity, and
+**   * The register in which to store the final result.
+**
+** If the results are computed, jump to P2. Otherwise, if the limit on
+** worker threads is zero or a value is encountered that cannot be
+** handled, fall through to the next instruction, which should begin
+** a serial implementation of the same query. The output registers are
+** not modified in this case.
+*/
+VDBE_OP_LABEL(ParallelAgg)
+case OP_ParallelAgg: {     /* jump */
+  VdbeCursor *pC;
+  int bDone;
+
+  assert( pOp->p1>=0 && pOp->p1<p->nCursor );
+  assert( pOp->p4type==P4_INTARRAY );
+  pC = p->apCsr[pOp->p1];
+  assert( pC && pC->pKVCur );
+
+  rc = sqlite4VdbeParallelAgg(p, pC, pOp->p3, pOp->p4.ai, &bDone);
+  if( rc==SQLITE4_OK && bDone ){
+    pc = pOp->p2 - 1;
+  }
+  break;
+}
+
 #ifndef SQLITE4_OMIT_PRAGMA
 /* Opcode: JournalMode P1 P2 P3 * P5
 **
@@ -4422,6 +4982,7 @@ case OP_JournalMode: {    /* out2-prerelease */
 ** If P1 is 0, then all SQL statements become expired. If P1 is non-zero,
 ** then only the currently executing statement is affected. 
 */
+VDBE_OP_LABEL(Expire)
 case OP_Expire: {
   if( !pOp->p1 ){
     sqlite4ExpirePreparedStatements(db);
@@ -4837,6 +5398,7 @@ case OP_Trace: {
 ** of the fts index to update. If it is zero, then the root page of the 
 ** index is available as part of the Fts5Info structure.
 */
+VDBE_OP_LABEL(FtsUpdate)
 case OP_FtsUpdate: {
   Fts5Info *pInfo;                /* Description of fts5 index to update */
   Mem *pKey;                      /* Primary key of indexed row */
@@ -4864,6 +5426,7 @@ case OP_FtsUpdate: {
 ** This opcode is used by the integrity-check procedure that verifies that
 ** the contents of an fts5 index and its corresponding table match.
 */
+VDBE_OP_LABEL(FtsCksum)
 case OP_FtsCksum: {
   Fts5Info *pInfo;                /* Description of fts5 index to update */
   Mem *pKey;                      /* Primary key of row */
@@ -4902,6 +5465,7 @@ case OP_FtsCksum: {
 ** leave the cursor pointing at the first match and fall through to the
 ** next instruction.
 */
+VDBE_OP_LABEL(FtsOpen)
 case OP_FtsOpen: {          /* jump */
   Fts5Info *pInfo;                /* Description of fts5 index to update */
   VdbeCursor *pCur;
@@ -4930,6 +5494,7 @@ case OP_FtsOpen: {          /* jump */
 ** if there is no next entry, set the cursor to point to EOF and fall through
 ** to the next instruction.
 */
+VDBE_OP_LABEL(FtsNext)
 case OP_FtsNext: {
   VdbeCursor *pCsr;
 
@@ -4945,6 +5510,7 @@ case OP_FtsNext: {
 ** P1 is an FTS cursor that points to a valid entry (not EOF). Copy the PK 
 ** blob for the current entry to register P2.
 */
+VDBE_OP_LABEL(FtsPk)
 case OP_FtsPk: {
   assert( 0 );
   break;
@@ -4956,10 +5522,11 @@ case OP_FtsPk: {
 ** destination.
 */
 /*
-** The magic Explain opcode are only inserted when explain==2 (which
-** is to say when the EXPLAIN QUERY PLAN syntax is used.)
+** The magic Explain opcode are only inserted when explain==2 or 4 (which
+** is to say when the EXPLAIN QUERY PLAN or EXPLAIN ANALYZE syntax is used.)
 ** This opcode records information from the optimizer.  It is the
-** the same as a no-op.  This opcode never appears in a real VM program.
+** the same as a no-op.  The only programs that run it are those prepared
+** with EXPLAIN ANALYZE, which count the number of times it is executed.
 */
 default: {          /* This is really OP_Noop and OP_Explain */
   assert( pOp->opcode==OP_Noop || pOp->opcode==OP_Explain );
@@ -4985,6 +5552,9 @@ default: {          /* This is really OP_Noop and OP_Explain */
 #endif
     }
 #endif
+#ifndef SQLITE4_OMIT_EXPLAIN
+    if( pProf ) vdbeProfileEnd(pProf);
+#endif
 
     /* The following code adds nothing to the actual functionality
     ** of the program.  It is only here for testing and debugging.
@@ -5006,6 +5576,24 @@ default: {          /* This is really OP_Noop and OP_Explain */
     }
 #endif  /* SQLITE4_DEBUG */
 #endif  /* NDEBUG */
+
+#ifdef VDBE_THREADED
+    /* Start the next opcode directly. This must do everything that the
+    ** top of the loop does in this build, other than the checks that
+    ** bThreaded has ruled out. */
+    if( rc==SQLITE4_OK && bThreaded && db->mallocFailed==0 ){
+      pOp = &aOp[++pc];
+      assert( pc>=0 && pc<p->nOp );
+      if( pOp->opflags & OPFLG_OUT2_PRERELEASE ){
+        assert( pOp->p2>0 );
+        assert( pOp->p2<=p->nMem );
+        pOut = &aMem[pOp->p2];
+        VdbeMemRelease(pOut);
+        pOut->flags = MEM_Int;
+      }
+      goto *aOpLabel[pOp->opcode];
+    }
+#endif
   }  /* The end of the for(;;) loop the loops through opcodes */
 
   /* If we reach this point, it means that execution is finished with
@@ -5028,6 +5616,15 @@ vdbe_error_halt:
   ** release the mutexes on btrees that were acquired at the
   ** top. */
 vdbe_return:
+#ifndef SQLITE4_OMIT_EXPLAIN
+  if( pProf ){
+    /* Instructions that jump here are still being timed */
+    vdbeProfileEnd(pProf);
+# ifdef SQLITE4_TLS
+    sqlite4KVProfile = pKVSave;
+# endif
+  }
+#endif
   return rc;
 
   /* Jump to here if a string or blob larger than SQLITE4_MAX_LENGTH
@@ -208,6 +208,7 @@ void sqlite4VdbeCountChanges(Vdbe*);
 sqlite4 *sqlite4VdbeDb(Vdbe*);
 void sqlite4VdbeSetSql(Vdbe*, const char *z, int n);
 void sqlite4VdbeSwap(Vdbe*,Vdbe*);
+u32 sqlite4VdbeNewStepGen(sqlite4*);
 VdbeOp *sqlite4VdbeTakeOpArray(Vdbe*, int*, int*);
 sqlite4_value *sqlite4VdbeGetValue(Vdbe*, int, u8);
 void sqlite4VdbeSetVarmask(Vdbe*, int);
@@ -215,6 +216,13 @@ void sqlite4VdbeSetVarmask(Vdbe*, int);
   char *sqlite4VdbeExpandSql(Vdbe*, const char*);
 #endif
 sqlite4_value *sqlite4ColumnValue(sqlite4_stmt *pStmt, int iCol);
+#ifndef SQLITE4_OMIT_EXPLAIN
+  void sqlite4VdbeScanStatus(Vdbe*, int, int, int, i64);
+  void sqlite4VdbeScanStatusRange(Vdbe*, int, int, int);
+#else
+# define sqlite4VdbeScanStatus(a,b,c,d,e)
+# define sqlite4VdbeScanStatusRange(a,b,c,d)
+#endif
 
 #ifndef SQLITE4_OMIT_TRIGGER
 void sqlite4VdbeLinkSubProgram(Vdbe *, SubProgram *);
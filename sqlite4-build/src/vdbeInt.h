@@ -60,12 +60,16 @@ struct VdbeCursor {
   Bool nullRow;         /* True if pointing to a row with no data */
   Bool rowChnged;       /* True if row has changed out from under pDecoder */
   i64 seqCount;         /* Sequence counter */
-  VdbeSorter *pSorter;  /* Sorter object for OP_SorterOpen cursors */
+  VdbeSorter *pSorter;  /* Keys buffered by OP_SorterInsert */
   Fts5Cursor *pFts;     /* Fts5 cursor object (or NULL) */
   RowDecoder *pDecoder;              /* Decoder for row content */
   sqlite4_vtab_cursor *pVtabCursor;  /* The cursor for a virtual table */
   const sqlite4_module *pModule;     /* Module for cursor pVtabCursor */
   sqlite4_buffer sSeekKey;           /* Key for deferred seek */
+  u32 iBatchGen;                     /* Vdbe.iBatchGen when batch was filled */
+  int nBatchRow;                     /* Outer rows covered by the batch */
+  sqlite4_buffer sBatchFirst;        /* First outer key covered by batch */
+  sqlite4_buffer sBatchLast;         /* Last outer key covered by batch */
 };
 
 /* Methods for the VdbeCursor object */
@@ -74,6 +78,7 @@ int sqlite4VdbeSeekEnd(VdbeCursor*, int);
 int sqlite4VdbeNext(VdbeCursor*);
 int sqlite4VdbePrevious(VdbeCursor*);
 int sqlite4VdbeCursorMoveto(VdbeCursor *);
+int sqlite4VdbeCursorRelease(VdbeCursor *, int);
 
 
 /*
@@ -182,6 +187,7 @@ struct Mem {
 #define MEM_Static    0x0800   /* Mem.z points to a static string */
 #define MEM_Ephem     0x1000   /* Mem.z points to an ephemeral string */
 #define MEM_Agg       0x2000   /* Mem.z points to an agg function context */
+#define MEM_KVRef     0x4000   /* MEM_Ephem and Mem.z points into a KV row */
 
 /*
 ** Clear any existing type flags from a Mem and replace them with f
@@ -252,6 +258,78 @@ struct Explain {
   char zBase[100];   /* Initial space */
 };
 
+/*
+** Counters accumulated by EXPLAIN PROFILE and EXPLAIN ANALYZE for a single
+** instruction, or for all instructions that use the same opcode.  Cycle
+** counts are in the units returned by sqlite4Hwtime().  nCycle includes
+** nKVCycle, the part of the time spent inside KV store methods.
+*/
+typedef struct VdbeProfileCounter VdbeProfileCounter;
+struct VdbeProfileCounter {
+  u64 nExec;              /* Number of times executed */
+  u64 nCycle;             /* Total cycles spent executing */
+  u64 nKVCycle;           /* Cycles spent in KV store calls */
+  u64 nKVSeek;            /* KV store xSeek calls */
+  u64 nKVNext;            /* KV store xNext and xPrev calls */
+};
+
+/*
+** The state of a statement prepared with EXPLAIN PROFILE or EXPLAIN
+** ANALYZE.  The first call to sqlite4_step() runs the statement to
+** completion with the counters below enabled, discarding any result rows.
+** That call and those that follow then return the rows of the report.
+**
+** For EXPLAIN PROFILE, there is one row for each instruction in the main
+** program (aOp[]) followed by one row for each opcode that was executed at
+** least once (aOpcode[]), in descending order of cycles spent.  Instructions
+** executed within trigger sub-programs are only counted in aOpcode[].  For
+** EXPLAIN ANALYZE, there is one row for each OP_Explain instruction in the
+** main program.  See sqlite4VdbeProfile() for details.
+**
+** While the statement runs, sqlite4KVProfile points to kv (see kv.c).  Its
+** value is sampled when each instruction starts and ends to attribute KV
+** store calls to that instruction.
+*/
+typedef struct VdbeProfile VdbeProfile;
+struct VdbeProfile {
+  KVProfile kv;           /* Totals for KV store calls */
+  KVProfile kvStart;      /* Value of kv when current op started */
+  u64 tStart;             /* sqlite4Hwtime() when current op started */
+  int iAddr;              /* Address of current op, or -1 */
+  u8 opcode;              /* Opcode of current op */
+  u8 bActive;             /* True while an op is being timed */
+  u8 bListing;            /* True once the statement has run */
+  u64 nRunCycle;          /* sqlite4Hwtime() cycles the whole run took */
+  u64 nRunUs;             /* Wall-clock microseconds the whole run took */
+  int iRow;               /* Next row of the listing to return */
+  int nOpcode;            /* Number of entries in aiOpcode[] */
+  u8 aiOpcode[256];       /* Opcodes listed, in listing order */
+  VdbeProfileCounter aOpcode[256];  /* Counters for each opcode */
+  VdbeProfileCounter aOp[1];        /* Counters for each instruction */
+};
+
+/*
+** EXPLAIN ANALYZE reports one row for each OP_Explain instruction in the
+** main program.  Code generators add an instance of the following object
+** to Vdbe.aScan[] for those that describe a loop, sort or subquery, using
+** sqlite4VdbeScanStatus() and sqlite4VdbeScanStatusRange().  After the
+** statement has run, the number of times each of the instructions at addrIn
+** and addrOut was executed gives the rows into and out of the loop, and the
+** counters for the instructions in aRange[] are added up to give the time
+** spent and KV store calls made by the loop itself.
+*/
+typedef struct VdbeScan VdbeScan;
+struct VdbeScan {
+  int addrExplain;        /* Address of the OP_Explain instruction */
+  int addrIn;             /* Executed once for each row in, or -1 */
+  int addrOut;            /* Executed once for each row out, or -1 */
+  i64 nEst;               /* Planner estimate of rows out, or -1 */
+  int nRange;             /* Number of entries used in aRange[] */
+  struct VdbeScanRange {
+    int iStart, iEnd;       /* Instructions iStart to iEnd-1 */
+  } aRange[4];
+};
+
 /*
 ** An instance of the virtual machine.  This structure contains the complete
 ** state of the virtual machine.
@@ -294,7 +372,7 @@ struct Vdbe {
   int pc;                 /* The program counter */
   int rc;                 /* Value to return */
   u8 errorAction;         /* Recovery action to do in case of an error */
-  u8 explain;             /* True if EXPLAIN present on SQL command */
+  u8 explain;             /* Value of Parse.explain for this statement */
   u8 changeCntOn;         /* True to update the change-counter */
   u8 expired;             /* True if the VM needs to be recompiled */
   u8 runOnlyOnce;         /* Automatically expire on reset */
@@ -302,9 +380,12 @@ struct Vdbe {
   u8 inVtabMethod;        /* See comments above */
   u8 needSavepoint;       /* True if a change might abort and needs savepoint */
   u8 readOnly;            /* True for read-only statements */
+  u8 batchRow;            /* Result row not yet consumed by step_batch() */
+  u32 iStepGen;           /* Value of db->iStepGen after latest step */
+  u32 iBatchGen;          /* Incremented when seek batches may be stale */
   int nChange;            /* Number of db changes made since last reset */
   yDbMask stmtTransMask;  /* db->aDb[] entries that have a subtransaction */
-  int aCounter[3];        /* Counters used by sqlite4_stmt_status() */
+  int aCounter[4];        /* Counters used by sqlite4_stmt_status() */
 #ifndef SQLITE4_OMIT_TRACE
   u64 startTime;          /* Time when query started - used for profiling */
 #endif
@@ -318,6 +399,11 @@ struct Vdbe {
 #ifdef SQLITE4_ENABLE_TREE_EXPLAIN
   Explain *pExplain;      /* The explainer */
   char *zExplain;         /* Explanation of data structures */
+#endif
+#ifndef SQLITE4_OMIT_EXPLAIN
+  VdbeProfile *pProfile;  /* EXPLAIN PROFILE/ANALYZE counters, or NULL */
+  VdbeScan *aScan;        /* Loops described for EXPLAIN ANALYZE */
+  int nScan;              /* Number of entries in aScan[] */
 #endif
   VdbeFrame *pFrame;      /* Parent frame */
   VdbeFrame *pDelFrame;   /* List of frame objects to free on VM reset */
@@ -357,8 +443,11 @@ int sqlite4VdbeDecoderGetColumn(
   RowDecoder *pDecoder,        /* The decoder for the whole string */
   int iVal,                    /* Index of the value to decode.  First is 0 */
   Mem *pDefault,               /* The default value.  Often NULL */
-  Mem *pOut                    /* Write the result here */
+  Mem *pOut,                   /* Write the result here */
+  int bRef                     /* True to refer to row memory if possible */
 );
+int sqlite4VdbeDecoderRelease(RowDecoder *pDecoder, int bPreserve);
+int sqlite4VdbeDecodeNumericField(const u8*, int, int, sqlite4_num*);
 int sqlite4VdbeEncodeData(
   sqlite4 *db,                /* The database connection */
   Mem *aIn,                   /* Array of values to encode */
@@ -370,9 +459,14 @@ int sqlite4VdbeEncodeData(
 int sqlite4VdbeEncodeIntKey(u8 *aBuf,sqlite4_int64 v);
 int sqlite4VdbeDecodeNumericKey(const KVByteArray*, KVSize, sqlite4_num*);
 int sqlite4VdbeShortKey(const u8 *, int, int, int *);
+int sqlite4VdbeKeyHasNull(const u8 *, int, int);
 int sqlite4MemCompare(Mem*, Mem*, const CollSeq*,int*);
 int sqlite4VdbeExec(Vdbe*);
 int sqlite4VdbeList(Vdbe*);
+#ifndef SQLITE4_OMIT_EXPLAIN
+int sqlite4VdbeProfile(Vdbe*);
+void sqlite4VdbeProfileFree(Vdbe*);
+#endif
 int sqlite4VdbeHalt(Vdbe*);
 int sqlite4VdbeChangeEncoding(Mem *, int);
 int sqlite4VdbeMemTooBig(Mem*);
@@ -437,5 +531,15 @@ int sqlite4VdbeMemTranslate(Mem*, u8);
 #endif
 int sqlite4VdbeMemHandleBom(Mem *pMem);
 
+int sqlite4VdbeSorterInsert(sqlite4*, VdbeSorter**,
+                            const u8*, int, const u8*, int, int);
+int sqlite4VdbeSorterCount(VdbeSorter*);
+i64 sqlite4VdbeSorterSize(VdbeSorter*);
+void sqlite4VdbeSorterTruncate(sqlite4*, VdbeSorter*, int);
+int sqlite4VdbeSorterFlush(sqlite4*, VdbeSorter*, KVCursor*, int, int*);
+void sqlite4VdbeSorterFree(sqlite4*, VdbeSorter*);
+
+int sqlite4VdbeParallelAgg(Vdbe*, VdbeCursor*, int, const int*, int*);
+
 
 #endif /* !defined(_VDBEINT_H_) */
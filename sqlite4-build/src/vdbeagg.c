@@ -0,0 +1,391 @@
+/*
+** 2026-10-18
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file contains code used by OP_ParallelAgg to evaluate simple
+** aggregate queries of the form:
+**
+**   SELECT count(*), sum(x), min(y), ... FROM tbl;
+**
+** using auxiliary worker threads.
+**
+** KV cursors and the record decoder may only be used by the thread that
+** holds the database connection mutex. So the calling thread scans the
+** table and copies the data record of each row into a batch buffer. Each
+** batch (a contiguous range of the table's keys) is handed to a worker
+** thread, which decodes the aggregated columns and computes a partial
+** result for each aggregate. Partial results are merged in key order as
+** the workers are joined, so that min() and max() return the same value
+** as the serial code when two values compare equal.
+**
+** If a value is encountered that the workers cannot handle exactly as the
+** built-in aggregate functions would (for example a text value passed to
+** sum()), the partial results are abandoned and the caller falls back to
+** the ordinary row-by-row implementation.
+*/
+#include "sqliteInt.h"
+#include "vdbeInt.h"
+
+typedef struct AggAccum AggAccum;
+typedef struct AggBatch AggBatch;
+
+/*
+** Maximum number of rows in a single batch.
+*/
+#ifndef SQLITE4_PARALLEL_AGG_BATCH
+# define SQLITE4_PARALLEL_AGG_BATCH 16384
+#endif
+
+/*
+** Partial result for a single aggregate.
+*/
+struct AggAccum {
+  i64 nCount;                     /* Rows counted, or values summed */
+  sqlite4_num sum;                /* Sum of values (sum() and avg()) */
+  u8 approx;                      /* True if a non-integer was summed */
+  u8 bBest;                       /* True once best is valid */
+  u8 bBestReal;                   /* True if best is a real value */
+  sqlite4_num best;               /* Current min() or max() value */
+};
+
+/*
+** A batch of rows and the partial results computed from them.
+**
+** The data record for row i occupies bytes aiOfst[i] to aiOfst[i+1]-1 of
+** aBuf[]. Array aiOfst[] has space for SQLITE4_PARALLEL_AGG_BATCH+1
+** entries.
+*/
+struct AggBatch {
+  u8 *aBuf;                       /* Buffer containing data records */
+  int nBuf;                       /* Bytes of aBuf[] used */
+  int nBufAlloc;                  /* Allocated size of aBuf[] */
+  int *aiOfst;                    /* Offset of each record in aBuf[] */
+  int nRow;                       /* Number of rows in batch */
+  int nAgg;                       /* Number of aggregates */
+  const int *aiAgg;               /* Aggregate descriptions (see vdbe.c) */
+  AggAccum *aAcc;                 /* Array of nAgg partial results */
+  int bFallback;                  /* Set if the batch cannot be handled */
+  SQLiteThread *pThread;          /* Thread processing this batch, if any */
+};
+
+/*
+** Add the value of type eType (an SQLITE4_* datatype) to accumulator pAcc
+** for an aggregate of type eOp. Return non-zero if the value cannot be
+** handled by this module.
+*/
+static int aggAccumStep(
+  AggAccum *pAcc,
+  int eOp,
+  int eType,
+  int bReal,
+  sqlite4_num num
+){
+  if( eType==SQLITE4_NULL ) return 0;
+  if( eOp==PARAGG_COUNT ){
+    pAcc->nCount++;
+    return 0;
+  }
+  if( eType!=SQLITE4_INTEGER && eType!=SQLITE4_FLOAT ) return 1;
+  if( bReal ) eType = SQLITE4_FLOAT;
+  if( eOp==PARAGG_SUM || eOp==PARAGG_AVG ){
+    pAcc->nCount++;
+    pAcc->sum = sqlite4_num_add(pAcc->sum, num);
+    if( eType!=SQLITE4_INTEGER ) pAcc->approx = 1;
+  }else{
+    int cmp;
+    assert( eOp==PARAGG_MIN || eOp==PARAGG_MAX );
+    cmp = pAcc->bBest ? sqlite4_num_compare(pAcc->best, num) - 2 : 0;
+    if( pAcc->bBest==0
+     || (eOp==PARAGG_MAX && cmp<0) || (eOp==PARAGG_MIN && cmp>0)
+    ){
+      pAcc->bBest = 1;
+      pAcc->bBestReal = (eType==SQLITE4_FLOAT);
+      pAcc->best = num;
+    }
+  }
+  return 0;
+}
+
+/*
+** Merge partial result pFrom, computed from rows that follow those used
+** to compute pTo, into pTo.
+*/
+static void aggAccumMerge(AggAccum *pTo, AggAccum *pFrom, int eOp){
+  if( eOp==PARAGG_MIN || eOp==PARAGG_MAX ){
+    if( pFrom->bBest ){
+      aggAccumStep(pTo, eOp,
+          pFrom->bBestReal ? SQLITE4_FLOAT : SQLITE4_INTEGER, 0, pFrom->best
+      );
+    }
+  }else{
+    pTo->nCount += pFrom->nCount;
+    pTo->sum = sqlite4_num_add(pTo->sum, pFrom->sum);
+    pTo->approx |= pFrom->approx;
+  }
+}
+
+/*
+** The main routine for a worker thread. Compute the partial results for
+** all rows of the batch passed as the only argument.
+*/
+static void *aggBatchMain(void *pCtx){
+  AggBatch *pBatch = (AggBatch *)pCtx;
+  int iRow;
+  int i;
+
+  memset(pBatch->aAcc, 0, sizeof(AggAccum)*pBatch->nAgg);
+  for(i=0; i<pBatch->nAgg; i++){
+    pBatch->aAcc[i].sum = sqlite4_num_from_int64(0);
+  }
+  for(iRow=0; iRow<pBatch->nRow && pBatch->bFallback==0; iRow++){
+    const u8 *a = &pBatch->aBuf[pBatch->aiOfst[iRow]];
+    int n = pBatch->aiOfst[iRow+1] - pBatch->aiOfst[iRow];
+    for(i=0; i<pBatch->nAgg; i++){
+      const int *aiAgg = &pBatch->aiAgg[i*4];
+      sqlite4_num num = {0, 0, 0, 0};
+      int eType;
+      if( aiAgg[1]<0 ){
+        eType = SQLITE4_INTEGER;           /* count(*) */
+      }else{
+        eType = sqlite4VdbeDecodeNumericField(a, n, aiAgg[1], &num);
+      }
+      if( eType==0 || aggAccumStep(&pBatch->aAcc[i], aiAgg[0], eType,
+                                   aiAgg[2], num)
+      ){
+        pBatch->bFallback = 1;
+        break;
+      }
+    }
+  }
+  return 0;
+}
+
+/*
+** Start a worker thread to process batch pBatch.
+*/
+static int aggBatchStart(sqlite4 *db, AggBatch *pBatch){
+  pBatch->aiOfst[pBatch->nRow] = pBatch->nBuf;
+  return sqlite4ThreadCreate(db->pEnv, &pBatch->pThread, aggBatchMain,
+                             (void *)pBatch);
+}
+
+/*
+** Wait for the thread processing pBatch, if any, to finish. Then merge
+** its partial results into aAcc[] and reset the batch so that it may be
+** reused.
+*/
+static int aggBatchFinish(AggBatch *pBatch, AggAccum *aAcc, int *pbFallback){
+  int rc = SQLITE4_OK;
+  if( pBatch->pThread ){
+    void *pOut;
+    int i;
+    rc = sqlite4ThreadJoin(pBatch->pThread, &pOut);
+    pBatch->pThread = 0;
+    if( pBatch->bFallback ) *pbFallback = 1;
+    for(i=0; i<pBatch->nAgg; i++){
+      aggAccumMerge(&aAcc[i], &pBatch->aAcc[i], pBatch->aiAgg[i*4]);
+    }
+  }
+  pBatch->nRow = 0;
+  pBatch->nBuf = 0;
+  return rc;
+}
+
+/*
+** Append a copy of data record a[0..n-1] to batch pBatch.
+*/
+static int aggBatchAppend(sqlite4 *db, AggBatch *pBatch, const u8 *a, int n){
+  if( pBatch->nBuf+n>pBatch->nBufAlloc ){
+    int nNew = (pBatch->nBufAlloc ? pBatch->nBufAlloc*2 : 4096);
+    u8 *aNew;
+    while( nNew<pBatch->nBuf+n ) nNew = nNew*2;
+    aNew = (u8 *)sqlite4DbRealloc(db, pBatch->aBuf, nNew);
+    if( aNew==0 ) return SQLITE4_NOMEM;
+    pBatch->aBuf = aNew;
+    pBatch->nBufAlloc = nNew;
+  }
+  pBatch->aiOfst[pBatch->nRow++] = pBatch->nBuf;
+  if( n>0 ) memcpy(&pBatch->aBuf[pBatch->nBuf], a, n);
+  pBatch->nBuf += n;
+  return SQLITE4_OK;
+}
+
+/*
+** Write the final value of each aggregate into its output register.
+** Or, if this cannot be done exactly as the built-in finalizers would,
+** set *pbFallback and leave the registers unmodified.
+*/
+static void aggFinalize(
+  Mem *aMem,
+  AggAccum *aAcc,
+  int nAgg,
+  const int *aiAgg,
+  int *pbFallback
+){
+  int i;
+
+  /* Check for integer overflow in sum() before modifying any registers */
+  for(i=0; i<nAgg; i++){
+    AggAccum *pAcc = &aAcc[i];
+    if( aiAgg[i*4]==PARAGG_SUM && pAcc->nCount>0 && pAcc->approx==0 ){
+      int bLossy;
+      sqlite4_num_to_int64(pAcc->sum, &bLossy);
+      if( bLossy ){
+        /* Let the serial code report the integer overflow */
+        *pbFallback = 1;
+        return;
+      }
+    }
+  }
+
+  for(i=0; i<nAgg; i++){
+    AggAccum *pAcc = &aAcc[i];
+    Mem *pOut = &aMem[aiAgg[i*4+3]];
+    switch( aiAgg[i*4] ){
+      case PARAGG_COUNT:
+        sqlite4VdbeMemSetInt64(pOut, pAcc->nCount);
+        break;
+      case PARAGG_SUM:
+        if( pAcc->nCount==0 ){
+          sqlite4VdbeMemSetNull(pOut);
+        }else if( pAcc->approx ){
+          sqlite4VdbeMemSetNum(pOut, pAcc->sum, MEM_Real);
+        }else{
+          sqlite4VdbeMemSetInt64(pOut, sqlite4_num_to_int64(pAcc->sum, 0));
+        }
+        break;
+      case PARAGG_AVG:
+        if( pAcc->nCount==0 ){
+          sqlite4VdbeMemSetNull(pOut);
+        }else{
+          sqlite4VdbeMemSetNum(pOut, sqlite4_num_div(
+                pAcc->sum, sqlite4_num_from_int64(pAcc->nCount)
+          ), MEM_Real);
+        }
+        break;
+      default:
+        if( pAcc->bBest==0 ){
+          sqlite4VdbeMemSetNull(pOut);
+        }else{
+          sqlite4VdbeMemSetNum(pOut, pAcc->best,
+              pAcc->bBestReal ? MEM_Real : MEM_Int
+          );
+        }
+        break;
+    }
+  }
+}
+
+/*
+** Evaluate the nAgg aggregates described by aiAgg[] over all rows of the
+** table that cursor pC is open on, using worker threads. See the
+** description of OP_ParallelAgg for the format of aiAgg[].
+**
+** If successful, the result of each aggregate is written to its output
+** register in p->aMem[] and *pbDone is set to true. If the aggregates
+** cannot be evaluated here (no worker threads are configured, or a value
+** is found that the workers do not handle), *pbDone is set to false and
+** the output registers are not modified.
+*/
+int sqlite4VdbeParallelAgg(
+  Vdbe *p,                        /* The VM */
+  VdbeCursor *pC,                 /* Cursor open on table to scan */
+  int nAgg,                       /* Number of aggregates */
+  const int *aiAgg,               /* Aggregate descriptions */
+  int *pbDone                     /* OUT: True if results were computed */
+){
+  sqlite4 *db = p->db;
+  int nBatch;                     /* Number of entries in aBatch[] */
+  AggBatch *aBatch;               /* Array of batches */
+  AggAccum *aAcc;                 /* Merged partial results */
+  int iBatch = 0;                 /* Batch currently being filled */
+  int bFallback = 0;              /* True to use the serial code */
+  int rc;
+  int rc2;
+  int i;
+
+  *pbDone = 0;
+  nBatch = db->aLimit[SQLITE4_LIMIT_WORKER_THREADS];
+  if( nBatch<=0 ) return SQLITE4_OK;
+
+  aBatch = (AggBatch *)sqlite4DbMallocZero(db,
+      (sizeof(AggBatch) + sizeof(AggAccum)*nAgg) * nBatch
+    + sizeof(AggAccum)*nAgg
+  );
+  if( aBatch==0 ) return SQLITE4_NOMEM;
+  aAcc = (AggAccum *)&aBatch[nBatch];
+  for(i=0; i<nAgg; i++){
+    aAcc[i].sum = sqlite4_num_from_int64(0);
+  }
+
+  rc = SQLITE4_OK;
+  for(i=0; i<nBatch && rc==SQLITE4_OK; i++){
+    aBatch[i].nAgg = nAgg;
+    aBatch[i].aiAgg = aiAgg;
+    aBatch[i].aAcc = &aAcc[nAgg * (i+1)];
+    aBatch[i].aiOfst = (int *)sqlite4DbMallocRaw(db,
+        sizeof(int) * (SQLITE4_PARALLEL_AGG_BATCH+1)
+    );
+    if( aBatch[i].aiOfst==0 ) rc = SQLITE4_NOMEM;
+  }
+
+  /* Scan the table. Each time a batch is full, start a thread to process
+  ** it and move on to the next. Before a batch is refilled, wait for the
+  ** thread processing its previous contents and merge the results.  */
+  if( rc==SQLITE4_OK ){
+    rc = sqlite4VdbeSeekEnd(pC, +1);
+  }
+  while( rc==SQLITE4_OK && bFallback==0 ){
+    const KVByteArray *aData;
+    KVSize nData;
+    AggBatch *pBatch = &aBatch[iBatch];
+
+    rc = sqlite4KVCursorData(pC->pKVCur, 0, -1, &aData, &nData);
+    if( rc==SQLITE4_OK ){
+      rc = aggBatchAppend(db, pBatch, aData, nData);
+    }
+    if( rc==SQLITE4_OK && pBatch->nRow==SQLITE4_PARALLEL_AGG_BATCH ){
+      rc = aggBatchStart(db, pBatch);
+      iBatch = (iBatch+1) % nBatch;
+      if( rc==SQLITE4_OK ){
+        rc = aggBatchFinish(&aBatch[iBatch], aAcc, &bFallback);
+      }
+    }
+    if( rc==SQLITE4_OK ){
+      rc = sqlite4VdbeNext(pC);
+    }
+  }
+  if( rc==SQLITE4_NOTFOUND ){
+    rc = SQLITE4_OK;
+    if( aBatch[iBatch].nRow>0 ){
+      rc = aggBatchStart(db, &aBatch[iBatch]);
+    }
+  }
+
+  /* Wait for all threads, merging results in the order in which the
+  ** batches were filled.  */
+  for(i=1; i<=nBatch; i++){
+    rc2 = aggBatchFinish(&aBatch[(iBatch+i) % nBatch], aAcc, &bFallback);
+    if( rc==SQLITE4_OK ) rc = rc2;
+  }
+
+  if( rc==SQLITE4_OK ){
+    aggFinalize(p->aMem, aAcc, nAgg, aiAgg, &bFallback);
+    *pbDone = !bFallback;
+  }
+
+  for(i=0; i<nBatch; i++){
+    sqlite4DbFree(db, aBatch[i].aBuf);
+    sqlite4DbFree(db, aBatch[i].aiOfst);
+  }
+  sqlite4DbFree(db, aBatch);
+  return rc;
+}
@@ -325,6 +325,16 @@ static int sqlite4Step(Vdbe *p){
   int rc;
 
   assert(p);
+#ifndef SQLITE4_OMIT_EXPLAIN
+  if( p->pProfile && p->pProfile->bListing ){
+    /* An EXPLAIN PROFILE or ANALYZE statement that has finished running and
+    ** is returning its results.  The VM has already halted, so this must be
+    ** handled before the automatic reset below.  */
+    rc = sqlite4VdbeProfile(p);
+    p->db->errCode = rc;
+    return rc;
+  }
+#endif
   if( p->magic!=VDBE_MAGIC_RUN ){
     /* We used to require that sqlite4_reset() be called before retrying
     ** sqlite4_step() after any error or after SQLITE4_DONE.  But beginning
@@ -386,8 +396,17 @@ static int sqlite4Step(Vdbe *p){
     if( p->readOnly==0 ) db->writeVdbeCnt++;
     p->pc = 0;
   }
+
+  /* If any other statement has been stepped since this one last was, the
+  ** database may have been modified. Discard any seek batches read by
+  ** OP_SeekBatch.  */
+  if( p->iStepGen!=db->iStepGen ) p->iBatchGen++;
+  p->iStepGen = sqlite4VdbeNewStepGen(db);
+
 #ifndef SQLITE4_OMIT_EXPLAIN
-  if( p->explain ){
+  if( p->explain>=3 ){
+    rc = sqlite4VdbeProfile(p);
+  }else if( p->explain ){
     rc = sqlite4VdbeList(p);
   }else
 #endif /* SQLITE4_OMIT_EXPLAIN */
@@ -552,28 +571,73 @@ int sqlite4_txn_commit(sqlite4 * db) // iLevel == 0 or 1 ?
 
 
 /*
-** This is the top-level implementation of sqlite4_step().  Call
-** sqlite4Step() to do most of the work.  If a schema error occurs,
-** call sqlite4Reprepare() and try again.
+** Statement v has just failed with SQLITE4_LOCKED, the storage engine
+** having chosen it as the victim of a deadlock. nSavepoint is the number
+** of open savepoints when it started and nRetry the number of times it
+** has already been retried. Return true if it should be run again.
+**
+** Only a statement that ran alone in an automatic transaction, which has
+** been rolled back, is retried. Within an explicit transaction, rolling
+** back a statement transaction is not enough: some storage engines
+** (kvwt) abort the whole transaction when they report a deadlock, so
+** the earlier statements of the transaction may have been undone too.
+** Before returning true, sleep for the backoff interval: the initial
+** delay doubled for each earlier retry, less a random part of up to half
+** of it.
 */
-int sqlite4_step(sqlite4_stmt *pStmt){
+static int vdbeLockRetry(Vdbe *v, int nSavepoint, int nRetry){
+  sqlite4 *db = v->db;
+  i64 nDelay;
+  u32 iRand;
+
+  if( nRetry>=db->nLockRetry ) return 0;
+  if( nSavepoint>0 || db->nSavepoint>0 || db->activeVdbeCnt>0 ) return 0;
+
+  nDelay = (i64)db->nLockBackoff << (nRetry<20 ? nRetry : 20);
+  if( nDelay>SQLITE4_MAX_LOCK_BACKOFF ) nDelay = SQLITE4_MAX_LOCK_BACKOFF;
+  sqlite4_randomness(db->pEnv, sizeof(iRand), &iRand);
+  nDelay -= iRand % (nDelay/2 + 1);
+  if( nDelay>0 ) sqlite4OsSleep(db->pEnv, (int)nDelay);
+
+  db->nLockRetryTotal++;
+  db->nLockBackoffTotal += nDelay;
+  v->aCounter[SQLITE4_STMTSTATUS_LOCK_RETRY-1]++;
+  return 1;
+}
+
+/*
+** Call sqlite4Step() to run statement v until it produces a row or
+** finishes.  If a schema error occurs, call sqlite4Reprepare() and try
+** again.  If the statement is chosen as a deadlock victim before it
+** returns its first row, it may be run again from the start - see
+** vdbeLockRetry().  The database connection mutex must be held.
+*/
+static int vdbeStepWithRetry(Vdbe *v){
   int rc = SQLITE4_OK;      /* Result from sqlite4Step() */
   int rc2 = SQLITE4_OK;     /* Result from sqlite4Reprepare() */
-  Vdbe *v = (Vdbe*)pStmt;  /* the prepared statement */
   int cnt = 0;             /* Counter to prevent infinite loop of reprepares */
-  sqlite4 *db;             /* The database connection */
-
-  if( vdbeSafetyNotNull(v) ){
-    return SQLITE4_MISUSE_BKPT;
-  }
-  db = v->db;
-  sqlite4_mutex_enter(db->mutex);
-  while( (rc = sqlite4Step(v))==SQLITE4_SCHEMA
-         && cnt++ < SQLITE4_MAX_SCHEMA_RETRY
-         && (rc2 = rc = sqlite4Reprepare(v))==SQLITE4_OK ){
-    sqlite4_reset(pStmt);
-    assert( v->expired==0 );
+  int nRetry = 0;          /* Number of retries after SQLITE4_LOCKED */
+  sqlite4 *db = v->db;     /* The database connection */
+  int nSavepoint = db->nSavepoint;
+  int bFresh = (v->magic!=VDBE_MAGIC_RUN || v->pc<0);
+
+  assert( sqlite4_mutex_held(db->mutex) );
+  while( 1 ){
+    while( (rc = sqlite4Step(v))==SQLITE4_SCHEMA
+           && cnt++ < SQLITE4_MAX_SCHEMA_RETRY
+           && (rc2 = rc = sqlite4Reprepare(v))==SQLITE4_OK ){
+      sqlite4_reset((sqlite4_stmt*)v);
+      assert( v->expired==0 );
+    }
+    if( rc!=SQLITE4_LOCKED || rc2!=SQLITE4_OK || bFresh==0
+     || vdbeLockRetry(v, nSavepoint, nRetry)==0
+    ){
+      break;
+    }
+    nRetry++;
+    sqlite4_reset((sqlite4_stmt*)v);
   }
+  if( nRetry>db->mxLockRetry ) db->mxLockRetry = nRetry;
   if( rc2!=SQLITE4_OK && ALWAYS(db->pErr) ){
     /* This case occurs after failing to recompile an sql statement. 
     ** The error message from the SQL compiler has already been loaded 
@@ -593,8 +657,165 @@ int sqlite4_step(sqlite4_stmt *pStmt){
       v->rc = rc = SQLITE4_NOMEM;
     }
   }
+  return sqlite4ApiExit(db, rc);
+}
+
+/*
+** This is the top-level implementation of sqlite4_step().
+*/
+int sqlite4_step(sqlite4_stmt *pStmt){
+  int rc;                  /* Result from vdbeStepWithRetry() */
+  Vdbe *v = (Vdbe*)pStmt;  /* the prepared statement */
+  sqlite4 *db;             /* The database connection */
+
+  if( vdbeSafetyNotNull(v) ){
+    return SQLITE4_MISUSE_BKPT;
+  }
+  db = v->db;
+  sqlite4_mutex_enter(db->mutex);
+  v->batchRow = 0;
+  rc = vdbeStepWithRetry(v);
+  sqlite4_mutex_leave(db->mutex);
+  return rc;
+}
+
+/*
+** Return the datatype that value pVal is stored as by sqlite4_step_batch()
+** in a column with representation eType.
+*/
+static int batchStoreType(int eType, sqlite4_value *pVal){
+  return (eType ? eType : sqlite4_value_type(pVal));
+}
+
+/*
+** If values of type eStore are packed into the aData[] buffer of a batch
+** column, return a pointer to the representation of pVal and set *pn to
+** its size in bytes. Otherwise, return NULL and set *pn to -1.
+*/
+static const void *batchArenaValue(int eStore, sqlite4_value *pVal, int *pn){
+  const void *z = 0;
+  *pn = -1;
+  if( eStore==SQLITE4_TEXT ){
+    z = sqlite4_value_text(pVal, pn);
+  }else if( eStore==SQLITE4_BLOB ){
+    z = sqlite4_value_blob(pVal, pn);
+  }else{
+    return 0;
+  }
+  if( z==0 ) *pn = 0;
+  return z;
+}
+
+/*
+** Return true if the text and blob values of the current result row of
+** statement v fit into the space remaining in the aData[] buffers of the
+** nCol columns described by aCol[], after iRow rows have been stored.
+*/
+static int batchRowFits(
+  Vdbe *v,
+  int iRow,
+  int nCol,
+  sqlite4_batch_column *aCol
+){
+  int i;
+  for(i=0; i<nCol; i++){
+    sqlite4_batch_column *p = &aCol[i];
+    sqlite4_value *pVal = (sqlite4_value*)&v->pResultSet[i];
+    int n;
+    if( p->eType==SQLITE4_NULL ) continue;
+    batchArenaValue(batchStoreType(p->eType, pVal), pVal, &n);
+    if( n>0 && n>p->nData - p->aOffset[iRow] ) return 0;
+  }
+  return 1;
+}
+
+/*
+** Store the current result row of statement v as row iRow of the nCol
+** columnar buffers described by aCol[]. batchRowFits() must have
+** returned true for the row.
+*/
+static void batchStoreRow(
+  Vdbe *v,
+  int iRow,
+  int nCol,
+  sqlite4_batch_column *aCol
+){
+  int i;
+  for(i=0; i<nCol; i++){
+    sqlite4_batch_column *p = &aCol[i];
+    sqlite4_value *pVal = (sqlite4_value*)&v->pResultSet[i];
+    int eType;
+    int eStore;
+    const void *z;
+    int n;
+
+    if( p->eType==SQLITE4_NULL ) continue;
+    eType = sqlite4_value_type(pVal);
+    eStore = batchStoreType(p->eType, pVal);
+    if( p->aNull ) p->aNull[iRow] = (eType==SQLITE4_NULL);
+    if( p->aType ) p->aType[iRow] = (unsigned char)eType;
+
+    z = batchArenaValue(eStore, pVal, &n);
+    if( n>=0 ){
+      if( n>0 ) memcpy(&p->aData[p->aOffset[iRow]], z, n);
+      p->aOffset[iRow+1] = p->aOffset[iRow] + n;
+    }else{
+      if( p->aOffset ) p->aOffset[iRow+1] = p->aOffset[iRow];
+      if( eStore==SQLITE4_INTEGER ){
+        p->aInt[iRow] = sqlite4_value_int64(pVal);
+      }else if( eStore==SQLITE4_FLOAT ){
+        p->aReal[iRow] = sqlite4_value_double(pVal);
+      }
+    }
+  }
+}
+
+/*
+** Step statement pStmt until up to nRow rows have been produced, storing
+** their values in the columnar buffers described by aCol[]. See the
+** documentation of sqlite4_step_batch() in sqlite.h.in for details.
+*/
+int sqlite4_step_batch(
+  sqlite4_stmt *pStmt,      /* Statement to evaluate */
+  int nRow,                 /* Maximum number of rows to return */
+  int nCol,                 /* Number of entries in aCol[] */
+  sqlite4_batch_column *aCol,
+  int *pnRow                /* OUT: Number of rows returned */
+){
+  Vdbe *v = (Vdbe*)pStmt;   /* The prepared statement */
+  sqlite4 *db;              /* The database connection */
+  int rc = SQLITE4_ROW;     /* Return code */
+  int iRow = 0;             /* Number of rows stored so far */
+  int i;
+
+  *pnRow = 0;
+  if( vdbeSafetyNotNull(v) || nRow<0 || nCol<0 || nCol>v->nResColumn ){
+    return SQLITE4_MISUSE_BKPT;
+  }
+  for(i=0; i<nCol; i++){
+    if( aCol[i].eType!=SQLITE4_NULL && aCol[i].aOffset ) aCol[i].aOffset[0] = 0;
+  }
+
+  db = v->db;
+  sqlite4_mutex_enter(db->mutex);
+  while( iRow<nRow ){
+    if( v->batchRow==0 ){
+      rc = vdbeStepWithRetry(v);
+      if( rc!=SQLITE4_ROW ) break;
+    }
+    if( batchRowFits(v, iRow, nCol, aCol)==0 ){
+      v->batchRow = 1;
+      if( iRow==0 ) rc = SQLITE4_BATCHFULL;
+      break;
+    }
+    batchStoreRow(v, iRow, nCol, aCol);
+    v->batchRow = 0;
+    iRow++;
+  }
   rc = sqlite4ApiExit(db, rc);
   sqlite4_mutex_leave(db->mutex);
+
+  *pnRow = iRow;
   return rc;
 }
 
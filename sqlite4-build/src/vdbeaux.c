@@ -19,6 +19,10 @@
 
 #include <stdio.h>
 
+#ifndef SQLITE4_OMIT_EXPLAIN
+# include "hwtime.h"
+#endif
+
 
 /*
 ** Create a new virtual database engine.
@@ -75,6 +79,20 @@ void sqlite4VdbeSwap(Vdbe *pA, Vdbe *pB){
   pB->zSql = zTmp;
 }
 
+/*
+** Begin a new step generation for connection db and return its number.
+**
+** Each statement records the generation in which it was last stepped.
+** If the generation has moved on when it is next stepped, the database
+** may have been modified in between, so the seek batches read by its
+** OP_SeekBatch instructions are discarded.  This must be called before
+** each step, and by any code that writes to the database without running
+** a VDBE program (sqlite4_bulkload_finish(), for example).
+*/
+u32 sqlite4VdbeNewStepGen(sqlite4 *db){
+  return ++db->iStepGen;
+}
+
 #ifdef SQLITE4_DEBUG
 /*
 ** Turn tracing on or off
@@ -920,7 +938,13 @@ static char *displayP4(Op *pOp, char *zTemp, int nTemp){
     case P4_INTARRAY: {
       int i, j, n, cSep = '(';
       i = sqlite4_snprintf(zTemp, nTemp, "intarray");
-      n = pOp->opcode==OP_Permutation ? pOp->p1 : 0;
+      if( pOp->opcode==OP_Permutation ){
+        n = pOp->p1;
+      }else if( pOp->opcode==OP_ParallelAgg ){
+        n = pOp->p3*4;
+      }else{
+        n = 0;
+      }
       for(j=0; j<n; j++){
         i += sqlite4_snprintf(zTemp+i, nTemp-i,"%c%d",cSep, pOp->p4.ai[j]);
         cSep = ',';
@@ -1244,6 +1268,322 @@ int sqlite4VdbeList(
   }
   return rc;
 }
+
+/*
+** Free the EXPLAIN PROFILE or ANALYZE counters attached to VM p, if any.
+*/
+void sqlite4VdbeProfileFree(Vdbe *p){
+  sqlite4DbFree(p->db, p->pProfile);
+  p->pProfile = 0;
+}
+
+/*
+** Fill in the VdbeProfile.aiOpcode[] array with the opcodes that were
+** executed at least once, ordered by the number of cycles spent on each,
+** largest first.
+*/
+static void vdbeProfileSort(VdbeProfile *pProf){
+  int i, j;
+  pProf->nOpcode = 0;
+  for(i=0; i<256; i++){
+    u64 nCycle = pProf->aOpcode[i].nCycle;
+    if( pProf->aOpcode[i].nExec==0 ) continue;
+    for(j=pProf->nOpcode; j>0; j--){
+      if( pProf->aOpcode[pProf->aiOpcode[j-1]].nCycle>=nCycle ) break;
+      pProf->aiOpcode[j] = pProf->aiOpcode[j-1];
+    }
+    pProf->aiOpcode[j] = (u8)i;
+    pProf->nOpcode++;
+  }
+}
+
+/*
+** Record, for EXPLAIN ANALYZE, the loop, sort or subquery described by the
+** OP_Explain instruction at addrExplain.  Each row into the loop executes
+** the instruction at addrIn once, and each row out of it the instruction
+** at addrOut.  Either may be -1 if there is no such instruction.  nEst is
+** the number of rows the planner expects the loop to return each time it
+** runs, or -1 if there is no estimate.
+*/
+void sqlite4VdbeScanStatus(
+  Vdbe *p,                  /* VM being constructed */
+  int addrExplain,          /* Address of the OP_Explain instruction */
+  int addrIn,               /* Executed once for each row in */
+  int addrOut,              /* Executed once for each row out */
+  i64 nEst                  /* Planner estimate of rows out, or -1 */
+){
+  VdbeScan *aNew;
+  aNew = (VdbeScan*)sqlite4DbRealloc(
+      p->db, p->aScan, (p->nScan+1)*sizeof(VdbeScan)
+  );
+  if( aNew ){
+    VdbeScan *pScan = &aNew[p->nScan++];
+    memset(pScan, 0, sizeof(VdbeScan));
+    pScan->addrExplain = addrExplain;
+    pScan->addrIn = addrIn;
+    pScan->addrOut = addrOut;
+    pScan->nEst = nEst;
+    p->aScan = aNew;
+  }
+}
+
+/*
+** Add instructions iStart to iEnd-1 to those whose time and KV store calls
+** are reported against the OP_Explain instruction at addrExplain.  This
+** is a no-op if sqlite4VdbeScanStatus() has not been called for
+** addrExplain, if the range is empty or if there are already as many
+** ranges as the VdbeScan object can hold.
+*/
+void sqlite4VdbeScanStatusRange(
+  Vdbe *p,                  /* VM being constructed */
+  int addrExplain,          /* Address of the OP_Explain instruction */
+  int iStart,               /* First instruction in range */
+  int iEnd                  /* One past the last instruction in range */
+){
+  int i;
+  for(i=p->nScan-1; i>=0; i--){
+    VdbeScan *pScan = &p->aScan[i];
+    if( pScan->addrExplain==addrExplain ){
+      if( iEnd>iStart && pScan->nRange<ArraySize(pScan->aRange) ){
+        pScan->aRange[pScan->nRange].iStart = iStart;
+        pScan->aRange[pScan->nRange].iEnd = iEnd;
+        pScan->nRange++;
+      }
+      break;
+    }
+  }
+}
+
+/*
+** Convert nCycle, a count of sqlite4Hwtime() cycles, to wall-clock
+** microseconds. The rate used is that measured over the whole run of the
+** statement. Return -1 if the run could not be timed.
+*/
+static i64 vdbeProfileMicroseconds(VdbeProfile *pProf, u64 nCycle){
+  if( pProf->nRunCycle==0 ) return -1;
+  return (i64)((double)nCycle * (double)pProf->nRunUs
+                 / (double)pProf->nRunCycle + 0.5);
+}
+
+/*
+** Return true if instruction iAddr is within one of the ranges of any of
+** the first nScan entries in p->aScan[].
+*/
+static int vdbeScanOwner(Vdbe *p, int iAddr, int nScan){
+  int i, j;
+  for(i=0; i<nScan; i++){
+    VdbeScan *pScan = &p->aScan[i];
+    for(j=0; j<pScan->nRange; j++){
+      if( iAddr>=pScan->aRange[j].iStart && iAddr<pScan->aRange[j].iEnd ){
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+/*
+** Set the values in pMem[0..9] to the EXPLAIN ANALYZE row for the
+** OP_Explain instruction at iAddr:
+**
+**   selectid, order, from, detail:  As for EXPLAIN QUERY PLAN.
+**   est_rows:  Planner estimate of the rows returned each time the loop
+**              runs.
+**   rows_in:   Rows visited by the loop, summed over all runs.  For a
+**              subquery, the number of times it was run.
+**   rows_out:  Rows that the loop passed on, summed over all runs.
+**   kv_seeks, kv_nexts, time_us:  KV store xSeek calls, xNext and xPrev
+**              calls and wall-clock microseconds spent in the instructions
+**              that belong to the loop itself, not counting any loops or
+**              subqueries nested within it.
+**
+** Time is measured in sqlite4Hwtime() cycles, which have a much finer
+** resolution than the wall clock, and converted to microseconds using the
+** rate measured over the whole run of the statement.
+**
+** The last six columns are NULL where they do not apply or were not
+** recorded by the code generator.  time_us is also NULL if there is no
+** cycle counter or wall clock on this platform.
+**
+** Code generators describe inner loops and subqueries before the loops
+** that contain them, so an instruction that appears in the ranges of more
+** than one entry of p->aScan[] belongs to the first of them.
+*/
+static void vdbeAnalyzeRow(Vdbe *p, int iAddr, Mem *pMem){
+  VdbeProfile *pProf = p->pProfile;
+  Op *pOp = &p->aOp[iAddr];
+  VdbeScan *pScan = 0;
+  int iScan;
+  int i;
+
+  assert( pOp->opcode==OP_Explain );
+  for(iScan=0; iScan<p->nScan; iScan++){
+    if( p->aScan[iScan].addrExplain==iAddr ){
+      pScan = &p->aScan[iScan];
+      break;
+    }
+  }
+
+  sqlite4VdbeMemSetInt64(&pMem[0], pOp->p1);             /* selectid */
+  sqlite4VdbeMemSetInt64(&pMem[1], pOp->p2);             /* order */
+  sqlite4VdbeMemSetInt64(&pMem[2], pOp->p3);             /* from */
+  sqlite4VdbeMemSetStr(&pMem[3], pOp->p4.z, -1,          /* detail */
+                       SQLITE4_UTF8, SQLITE4_TRANSIENT, 0);
+  for(i=4; i<10; i++) sqlite4VdbeMemSetNull(&pMem[i]);
+  if( pScan ){
+    VdbeProfileCounter sum;
+    i64 nUs;
+    memset(&sum, 0, sizeof(sum));
+    for(i=0; i<pScan->nRange; i++){
+      int j;
+      for(j=pScan->aRange[i].iStart; j<pScan->aRange[i].iEnd; j++){
+        VdbeProfileCounter *pCnt = &pProf->aOp[j];
+        if( vdbeScanOwner(p, j, iScan) ) continue;
+        sum.nCycle += pCnt->nCycle;
+        sum.nKVSeek += pCnt->nKVSeek;
+        sum.nKVNext += pCnt->nKVNext;
+      }
+    }
+    if( pScan->nEst>=0 ){
+      sqlite4VdbeMemSetInt64(&pMem[4], pScan->nEst);
+    }
+    if( pScan->addrIn>=0 ){
+      sqlite4VdbeMemSetInt64(&pMem[5], (i64)pProf->aOp[pScan->addrIn].nExec);
+    }
+    if( pScan->addrOut>=0 ){
+      sqlite4VdbeMemSetInt64(&pMem[6], (i64)pProf->aOp[pScan->addrOut].nExec);
+    }
+    /* KV store calls cannot be counted without thread-local storage */
+#ifdef SQLITE4_TLS
+    sqlite4VdbeMemSetInt64(&pMem[7], (i64)sum.nKVSeek);
+    sqlite4VdbeMemSetInt64(&pMem[8], (i64)sum.nKVNext);
+#endif
+    nUs = vdbeProfileMicroseconds(pProf, sum.nCycle);
+    if( nUs>=0 ) sqlite4VdbeMemSetInt64(&pMem[9], nUs);
+  }
+}
+
+/*
+** This routine is used in place of sqlite4VdbeExec() for statements
+** prepared with EXPLAIN PROFILE (p->explain==3) or EXPLAIN ANALYZE
+** (p->explain==4).
+**
+** The first call runs the statement to completion with the counters in
+** p->pProfile enabled, discarding any result rows.  That call and those
+** that follow each return one row of the report.  For EXPLAIN PROFILE
+** there is one row for each instruction of the main program, then one for
+** each opcode executed, with a NULL address and operands.  For EXPLAIN
+** ANALYZE there is one row for each OP_Explain instruction, as described
+** for vdbeAnalyzeRow().  Once all rows have been returned the counters are
+** freed, so that the next call to sqlite4_step() resets the statement and
+** runs it again.
+*/
+int sqlite4VdbeProfile(
+  Vdbe *p                   /* The VDBE */
+){
+  sqlite4 *db = p->db;                 /* The database connection */
+  VdbeProfile *pProf = p->pProfile;    /* Counters */
+  VdbeProfileCounter *pCnt;            /* Counters for the current row */
+  Mem *pMem = &p->aMem[1];             /* First Mem of result set */
+  int rc;                              /* Return code */
+  int i;                               /* Row of the listing */
+
+  assert( p->explain==3 || p->explain==4 );
+
+  if( pProf==0 ){
+    int nByte = sizeof(VdbeProfile) + (p->nOp-1)*sizeof(VdbeProfileCounter);
+    pProf = (VdbeProfile *)sqlite4DbMallocZero(db, nByte);
+    if( pProf==0 ){
+      p->rc = SQLITE4_NOMEM;
+      return SQLITE4_ERROR;
+    }
+    p->pProfile = pProf;
+  }
+
+  if( pProf->bListing==0 ){
+    u64 tStart, tEnd;
+    u64 cStart;
+    int rcTime;
+    assert( p->magic==VDBE_MAGIC_RUN );
+    rcTime = sqlite4OsMicroseconds(&tStart);
+    cStart = sqlite4Hwtime();
+    do{
+      db->vdbeExecCnt++;
+      rc = sqlite4VdbeExec(p);
+      db->vdbeExecCnt--;
+    }while( rc==SQLITE4_ROW );
+    if( rc!=SQLITE4_DONE ) return rc;
+    pProf->nRunCycle = sqlite4Hwtime() - cStart;
+    if( rcTime==SQLITE4_OK && sqlite4OsMicroseconds(&tEnd)==SQLITE4_OK ){
+      pProf->nRunUs = tEnd - tStart;
+    }else{
+      pProf->nRunCycle = 0;
+    }
+    vdbeProfileSort(pProf);
+    pProf->bListing = 1;
+  }
+
+  releaseMemArray(pMem, p->nResColumn);
+  p->pResultSet = 0;
+
+  if( p->explain==4 ){
+    /* For EXPLAIN ANALYZE, iRow is the address at which to start looking
+    ** for the next OP_Explain instruction. */
+    for(i=pProf->iRow; i<p->nOp && p->aOp[i].opcode!=OP_Explain; i++);
+    if( i>=p->nOp ){
+      sqlite4VdbeProfileFree(p);
+      p->rc = SQLITE4_OK;
+      return SQLITE4_DONE;
+    }
+    pProf->iRow = i+1;
+    vdbeAnalyzeRow(p, i, pMem);
+  }else{
+    i = pProf->iRow++;
+    if( i>=p->nOp+pProf->nOpcode ){
+      sqlite4VdbeProfileFree(p);
+      p->rc = SQLITE4_OK;
+      return SQLITE4_DONE;
+    }
+
+    if( i<p->nOp ){
+      Op *pOp = &p->aOp[i];
+      char zP4[150];
+      pCnt = &pProf->aOp[i];
+      sqlite4VdbeMemSetInt64(&pMem[0], i);                 /* addr */
+      sqlite4VdbeMemSetStr(&pMem[1], sqlite4OpcodeName(pOp->opcode), -1,
+                           SQLITE4_UTF8, SQLITE4_STATIC, 0); /* opcode */
+      sqlite4VdbeMemSetInt64(&pMem[2], pOp->p1);           /* p1 */
+      sqlite4VdbeMemSetInt64(&pMem[3], pOp->p2);           /* p2 */
+      sqlite4VdbeMemSetInt64(&pMem[4], pOp->p3);           /* p3 */
+      sqlite4VdbeMemSetStr(&pMem[5], displayP4(pOp, zP4, sizeof(zP4)), -1,
+                           SQLITE4_UTF8, SQLITE4_TRANSIENT, 0); /* p4 */
+    }else{
+      int op = pProf->aiOpcode[i - p->nOp];
+      int j;
+      pCnt = &pProf->aOpcode[op];
+      sqlite4VdbeMemSetNull(&pMem[0]);
+      sqlite4VdbeMemSetStr(&pMem[1], sqlite4OpcodeName(op), -1,
+                           SQLITE4_UTF8, SQLITE4_STATIC, 0);
+      for(j=2; j<=5; j++) sqlite4VdbeMemSetNull(&pMem[j]);
+    }
+    sqlite4VdbeMemSetInt64(&pMem[6], (i64)pCnt->nExec);    /* count */
+    sqlite4VdbeMemSetInt64(&pMem[7], (i64)pCnt->nCycle);   /* cycles */
+#ifdef SQLITE4_TLS
+    sqlite4VdbeMemSetInt64(&pMem[8], (i64)pCnt->nKVCycle); /* kvcycles */
+#else
+    /* KV store time cannot be measured without thread-local storage */
+    sqlite4VdbeMemSetNull(&pMem[8]);
+#endif
+  }
+  if( db->mallocFailed ){
+    p->rc = SQLITE4_NOMEM;
+    return SQLITE4_ERROR;
+  }
+
+  p->pResultSet = pMem;
+  p->rc = SQLITE4_OK;
+  return SQLITE4_ROW;
+}
 #endif /* SQLITE4_OMIT_EXPLAIN */
 
 #ifdef SQLITE4_DEBUG
@@ -1361,6 +1701,7 @@ void sqlite4VdbeRewind(Vdbe *p){
   p->errorAction = OE_Abort;
   p->magic = VDBE_MAGIC_RUN;
   p->nChange = 0;
+  p->batchRow = 0;
   p->cacheCtr = 1;
   p->minWriteFileFormat = 255;
   p->stmtTransMask = 0;
@@ -1576,6 +1917,9 @@ static void Cleanup(Vdbe *p){
   sqlite4DbFree(db, p->zErrMsg);
   p->zErrMsg = 0;
   p->pResultSet = 0;
+#ifndef SQLITE4_OMIT_EXPLAIN
+  sqlite4VdbeProfileFree(p);
+#endif
 }
 
 /*
@@ -2219,6 +2563,10 @@ void sqlite4VdbeDeleteObject(sqlite4 *db, Vdbe *p){
 #if defined(SQLITE4_ENABLE_TREE_EXPLAIN)
   sqlite4DbFree(db, p->zExplain);
   sqlite4DbFree(db, p->pExplain);
+#endif
+#ifndef SQLITE4_OMIT_EXPLAIN
+  sqlite4DbFree(db, p->pProfile);
+  sqlite4DbFree(db, p->aScan);
 #endif
   sqlite4DbFree(db, p);
 }
@@ -37,6 +37,9 @@ struct RowDecoder {
   KVSize n;                   /* Bytes of content in a[] */
   KVSize nKey;                /* Bytes of key content */
   int mxCol;                  /* Maximum number of columns */
+  Mem **apRef;                /* Registers that point into a[] or aKey[] */
+  int nRef;                   /* Number of entries in apRef[] */
+  int nRefAlloc;              /* Allocated size of apRef[] */
 };
 
 /*
@@ -71,6 +74,7 @@ int sqlite4VdbeDecoderCreate(
 */
 int sqlite4VdbeDecoderDestroy(RowDecoder *p){
   if( p ){
+    sqlite4DbFree(p->db, p->apRef);
     sqlite4DbFree(p->db, p);
   }
   return SQLITE4_OK;
@@ -87,6 +91,10 @@ static int decoderFetchData(RowDecoder *p){
     return rc;
   }
   if( pCur->rowChnged ){
+    if( p->nRef ){
+      rc = sqlite4VdbeDecoderRelease(p, 1);
+      if( rc ) return rc;
+    }
     p->a = 0;
     p->aKey = 0;
     pCur->rowChnged = 0;
@@ -119,6 +127,93 @@ static int decoderFetchKey(RowDecoder *p){
   return sqlite4KVCursorKey(pCur->pKVCur, &p->aKey, &p->nKey);
 }
 
+/*
+** Return true if the string or blob held by pMem lies within the n bytes
+** starting at a[].
+*/
+static int decoderRefersTo(Mem *pMem, const KVByteArray *a, KVSize n){
+  const KVByteArray *z = (const KVByteArray *)pMem->z;
+  return (a!=0 && z>=a && z+pMem->n<=a+n);
+}
+
+/*
+** Set pOut to the n byte text (if enc!=0) or blob (if enc==0) value at z,
+** which is part of the key or data of the row the decoder currently
+** points to. Instead of copying the value, pOut is made to refer to it
+** directly. The register is marked MEM_Ephem|MEM_KVRef and remembered so
+** that sqlite4VdbeDecoderRelease() can deal with it before the underlying
+** KV cursor is moved.
+**
+** If the register cannot be remembered (an OOM condition), a private copy
+** of the value is taken instead.
+*/
+static int decoderMemSetRef(
+  RowDecoder *p,                  /* The decoder */
+  const KVByteArray *z,           /* Value content */
+  int n,                          /* Size of z[] in bytes */
+  u8 enc,                         /* SQLITE4_UTF8 for text, 0 for blob */
+  Mem *pOut                       /* Write the value here */
+){
+  int i;
+
+  for(i=0; i<p->nRef && p->apRef[i]!=pOut; i++);
+  if( i==p->nRef ){
+    if( p->nRef==p->nRefAlloc ){
+      int nNew = (p->nRefAlloc ? p->nRefAlloc*2 : 8);
+      Mem **apNew = sqlite4DbRealloc(p->db, p->apRef, nNew*sizeof(Mem*));
+      if( apNew==0 ){
+        return sqlite4VdbeMemSetStr(pOut, (const char *)z, n, enc,
+                                    SQLITE4_TRANSIENT, 0);
+      }
+      p->apRef = apNew;
+      p->nRefAlloc = nNew;
+    }
+    p->apRef[p->nRef++] = pOut;
+  }
+  sqlite4VdbeMemSetStr(pOut, (const char *)z, n, enc, SQLITE4_STATIC, 0);
+  pOut->flags = (pOut->flags & ~MEM_Static) | MEM_Ephem | MEM_KVRef;
+  return SQLITE4_OK;
+}
+
+/*
+** This routine must be called before the KV cursor that the decoder reads
+** from is moved, and before the decoder discards its cached row. Each
+** register that still refers to memory belonging to the current row (see
+** decoderMemSetRef()) is either given a private copy of its value (if
+** bPreserve is true) or abandoned (if bPreserve is false).
+**
+** Registers are only abandoned when the caller knows that they will not be
+** read again, for example because the cursor is being advanced to the next
+** row of a loop. In debug builds such registers are marked as MEM_Invalid
+** so that any later attempt to use them trips an assert(). Release builds
+** set them to NULL, so that they never point at memory the KV cursor has
+** reused.
+*/
+int sqlite4VdbeDecoderRelease(RowDecoder *p, int bPreserve){
+  int rc = SQLITE4_OK;
+  int i;
+
+  for(i=0; i<p->nRef; i++){
+    Mem *pMem = p->apRef[i];
+    if( (pMem->flags & (MEM_Ephem|MEM_KVRef))==(MEM_Ephem|MEM_KVRef)
+     && (decoderRefersTo(pMem, p->a, p->n)
+      || decoderRefersTo(pMem, p->aKey, p->nKey))
+    ){
+      if( bPreserve ){
+        if( sqlite4VdbeMemMakeWriteable(pMem) ) rc = SQLITE4_NOMEM;
+      }else{
+#ifdef SQLITE4_DEBUG
+        pMem->flags = MEM_Invalid;
+#else
+        pMem->flags = MEM_Null;
+#endif
+      }
+    }
+  }
+  p->nRef = 0;
+  return rc;
+}
+
 /*
 ** Decode a blob from a key.  The blob-key is in a[0] through a[n-1].
 ** xorMask is either 0x00 for ascending order or 0xff for descending.
@@ -318,11 +413,16 @@ int sqlite4VdbeDecodeNumericKey(
 ** of the key.  If affReal is true, then force numeric values to be floating
 ** point.  Write the result in pOut.  Or return non-zero if there is an
 ** error.
+**
+** If bRef is true, text and blob values that are stored in the key without
+** transformation are not copied. Instead, pOut is left pointing into the
+** key itself (see decoderMemSetRef()).
 */
 static int decoderFromKey(
   RowDecoder *p,           /* The current key/value pair */
   int affReal,             /* True to coerce numbers to floating point */
   sqlite4_int64 iOfst,     /* Offset of value in the key */
+  int bRef,                /* True to refer to the key instead of copying */
   Mem *pOut                /* Write the results here */
 ){
   int rc;
@@ -350,8 +450,12 @@ static int decoderFromKey(
 
     case 0x24: {                /* Text (ascending index) */
       for(i=iOfst; i<n && a[i]!=0; i++){}
-      rc = sqlite4VdbeMemSetStr(pOut, &a[iOfst], i-iOfst,
-                                SQLITE4_UTF8, SQLITE4_TRANSIENT, 0);
+      if( bRef && i>iOfst ){
+        rc = decoderMemSetRef(p, &a[iOfst], i-iOfst, SQLITE4_UTF8, pOut);
+      }else{
+        rc = sqlite4VdbeMemSetStr(pOut, &a[iOfst], i-iOfst,
+                                  SQLITE4_UTF8, SQLITE4_TRANSIENT, 0);
+      }
       break;
     }
     case 0xDB: {                /* Text (descending index) */
@@ -377,8 +481,12 @@ static int decoderFromKey(
     }
 
     case 0x26: {                /* Blob-final (ascending) */
-      rc = sqlite4VdbeMemSetStr(pOut, &a[iOfst], n-iOfst, 0,
-                                SQLITE4_TRANSIENT, 0);
+      if( bRef && n>iOfst ){
+        rc = decoderMemSetRef(p, &a[iOfst], n-iOfst, 0, pOut);
+      }else{
+        rc = sqlite4VdbeMemSetStr(pOut, &a[iOfst], n-iOfst, 0,
+                                  SQLITE4_TRANSIENT, 0);
+      }
       break;
     }
     case 0xD9: {                /* Blob-final (descending) */
@@ -418,12 +526,20 @@ static int decoderFromKey(
 ** The key is referenced only if the iVal-th column in the value is either
 ** the 22 or 23 header code which indicates that the value is stored in the
 ** key instead.
+**
+** If bRef is true and the value is a non-empty UTF-8 string or a blob that
+** can be used exactly as stored, pOut is set to point directly into the
+** row held by the KV cursor instead of receiving a copy. The caller must
+** ensure that such a register is not used after the cursor moves, unless
+** the register has been preserved by sqlite4VdbeDecoderRelease(). bRef
+** may only be set if the decoder is associated with a VdbeCursor.
 */
 int sqlite4VdbeDecoderGetColumn(
   RowDecoder *p,             /* The decoder for the whole string */
   int iVal,                    /* Index of the value to decode.  First is 0 */
   Mem *pDefault,               /* The default value.  Often NULL */
-  Mem *pOut                    /* Write the result here */
+  Mem *pOut,                   /* Write the result here */
+  int bRef                     /* True to refer to row memory if possible */
 ){
   u32 size;                    /* Size of a field */
   sqlite4_uint64 ofst;         /* Offset to the payload */
@@ -438,6 +554,7 @@ int sqlite4VdbeDecoderGetColumn(
 
   sqlite4VdbeMemSetNull(pOut);
   assert( iVal<=p->mxCol );
+  assert( bRef==0 || p->pCur!=0 );
   rc = decoderFetchData(p);
   if( rc ) return rc;
   if( p->a==0 ) return SQLITE4_OK;
@@ -503,8 +620,13 @@ int sqlite4VdbeDecoderGetColumn(
       if( size==0 ){
         sqlite4VdbeMemSetStr(pOut, "", 0, SQLITE4_UTF8, SQLITE4_TRANSIENT, 0);
       }else if( p->a[ofst]>0x02 ){
-        sqlite4VdbeMemSetStr(pOut, (char*)(p->a+ofst), size, 
-                             SQLITE4_UTF8, SQLITE4_TRANSIENT, 0);
+        if( bRef ){
+          rc = decoderMemSetRef(p, p->a+ofst, size, SQLITE4_UTF8, pOut);
+          if( rc ) return rc;
+        }else{
+          sqlite4VdbeMemSetStr(pOut, (char*)(p->a+ofst), size, 
+                               SQLITE4_UTF8, SQLITE4_TRANSIENT, 0);
+        }
       }else{
         static const u8 enc[] = {SQLITE4_UTF8,SQLITE4_UTF16LE,SQLITE4_UTF16BE };
         sqlite4VdbeMemSetStr(pOut, (char*)(p->a+ofst+1), size-1, 
@@ -512,7 +634,11 @@ int sqlite4VdbeDecoderGetColumn(
       }
     }else if( cclass==2 ){
       unsigned int k = (type - 24)/4;
-      return decoderFromKey(p, (k&1)!=0, k/2, pOut);
+      return decoderFromKey(p, (k&1)!=0, k/2, bRef, pOut);
+    }else if( bRef && size>0 ){
+      rc = decoderMemSetRef(p, p->a+ofst, size, 0, pOut);
+      if( rc ) return rc;
+      pOut->enc = ENC(p->db);
     }else{
       sqlite4VdbeMemSetStr(pOut, (char*)(p->a+ofst), size, 0,
                            SQLITE4_TRANSIENT, 0);
@@ -531,6 +657,99 @@ int sqlite4VdbeDecoderGetColumn(
   return SQLITE4_OK; 
 }
 
+/*
+** Find the iVal'th column of the data record in a[0..n-1] and, if it is
+** a number, store its value in *pNum. Return the fundamental datatype
+** of the column (SQLITE4_NULL, SQLITE4_INTEGER, SQLITE4_FLOAT, SQLITE4_TEXT
+** or SQLITE4_BLOB), or 0 if the record is corrupt or the value is stored
+** in the key rather than the data record.
+**
+** This is a cut-down version of sqlite4VdbeDecoderGetColumn() that does
+** not use a Mem object or the database connection, so it may be called
+** by auxiliary threads. As there is no default value, a column that is
+** beyond the end of the record is reported as NULL.
+*/
+int sqlite4VdbeDecodeNumericField(
+  const u8 *a,                 /* The data record */
+  int n,                       /* Size of a[] in bytes */
+  int iVal,                    /* Index of the value to decode */
+  sqlite4_num *pNum            /* OUT: Numeric value */
+){
+  sqlite4_uint64 ofst;         /* Offset to the payload */
+  sqlite4_uint64 type;         /* Datatype */
+  sqlite4_uint64 size;         /* Size of a field */
+  int iHdr;                    /* Offset into the header */
+  int endHdr;                  /* First byte past header */
+  int sz;                      /* Size of a varint */
+  int i;                       /* Loop counter */
+
+  iHdr = sqlite4GetVarint64(a, n, &ofst);
+  if( iHdr==0 ) return 0;
+  ofst += iHdr;
+  endHdr = ofst;
+  if( endHdr>n ) return 0;
+  for(i=0; iHdr<endHdr; i++){
+    sz = sqlite4GetVarint64(a+iHdr, n-iHdr, &type);
+    if( sz==0 ) return 0;
+    iHdr += sz;
+    if( type>=22 ){  /* STRING, BLOB, KEY, and TYPED */
+      int cclass = (type-22)%4;
+      if( i==iVal ){
+        if( cclass==2 ) return 0;
+        return (cclass==0 ? SQLITE4_TEXT : SQLITE4_BLOB);
+      }
+      if( cclass==3 ){
+        sqlite4_uint64 subtype;
+        sz = sqlite4GetVarint64(a+iHdr, n-iHdr, &subtype);
+        if( sz==0 ) return 0;
+        iHdr += sz;
+      }
+      size = (cclass==2 ? 0 : (type-22)/4);
+    }else if( type<=2 ){
+      size = 0;
+    }else if( type<=10 ){
+      size = type - 2;
+    }else{
+      size = type - 9;
+    }
+    if( i<iVal ){
+      ofst += size;
+      continue;
+    }
+    if( ofst+size>(sqlite4_uint64)n ) return 0;
+    if( type==0 ){
+      return SQLITE4_NULL;
+    }else if( type<=2 ){
+      *pNum = sqlite4_num_from_int64(type-1);
+      return SQLITE4_INTEGER;
+    }else if( type<=10 ){
+      int iByte;
+      sqlite4_int64 v = ((char*)a)[ofst];
+      for(iByte=1; iByte<size; iByte++){
+        v = v*256 + a[ofst+iByte];
+      }
+      *pNum = sqlite4_num_from_int64(v);
+      return SQLITE4_INTEGER;
+    }else{
+      sqlite4_num num = {0, 0, 0, 0};
+      sqlite4_uint64 x;
+      int e;
+
+      sz = sqlite4GetVarint64(a+ofst, n-ofst, &x);
+      e = (int)x;
+      sz += sqlite4GetVarint64(a+ofst+sz, n-(ofst+sz), &x);
+      if( sz!=size ) return 0;
+      num.m = x;
+      num.e = (e >> 2);
+      if( e & 0x02 ) num.e = -1 * num.e;
+      if( e & 0x01 ) num.sign = 1;
+      *pNum = num;
+      return SQLITE4_FLOAT;
+    }
+  }
+  return SQLITE4_NULL;
+}
+
 /*
 ** Return the number of bytes needed to represent a 64-bit signed integer.
 */
@@ -1000,6 +1219,20 @@ int sqlite4VdbeShortKey(
   return (p - aKey);
 }
 
+/*
+** Variables aKey/nKey contain an encoded index key. Return true if any
+** of the first nField fields of the key is NULL, or false otherwise.
+*/
+int sqlite4VdbeKeyHasNull(const u8 *aKey, int nKey, int nField){
+  int iOff = sqlite4VdbeShortKey(aKey, nKey, 0, 0);
+  int i;
+  for(i=0; i<nField && iOff<nKey; i++){
+    if( aKey[iOff]==0x05 || aKey[iOff]==0xFA ) return 1;
+    iOff = sqlite4VdbeShortKey(aKey, nKey, i+1, 0);
+  }
+  return 0;
+}
+
 /*
 ** Generate a database key from one or more data values.
 **
@@ -38,6 +38,8 @@ int sqlite4VdbeSeekEnd(VdbeCursor *pC, int iEnd){
   KVByteArray aProbe[16];
 
   assert( iEnd==(+1) || iEnd==(-1) || iEnd==(-2) );  
+  rc = sqlite4VdbeCursorRelease(pC, 1);
+  if( rc!=SQLITE4_OK ) return rc;
   if( pC->iRoot==KVSTORE_ROOT ){
     if( iEnd>0 ){
       rc = sqlite4KVCursorSeek(pCur, (const KVByteArray *)"\00", 1, iEnd);
@@ -79,6 +81,8 @@ int sqlite4VdbeNext(VdbeCursor *pC){
   int rc;
   sqlite4_uint64 iTabno;
 
+  rc = sqlite4VdbeCursorRelease(pC, 1);
+  if( rc!=SQLITE4_OK ) return rc;
   rc = sqlite4KVCursorNext(pCur);
   if( rc==SQLITE4_OK && pC->iRoot!=KVSTORE_ROOT ){
     rc = sqlite4KVCursorKey(pCur, &aKey, &nKey);
@@ -103,6 +107,8 @@ int sqlite4VdbePrevious(VdbeCursor *pC){
   int rc;
   sqlite4_uint64 iTabno;
 
+  rc = sqlite4VdbeCursorRelease(pC, 1);
+  if( rc!=SQLITE4_OK ) return rc;
   rc = sqlite4KVCursorPrev(pCur);
   if( rc==SQLITE4_OK && pC->iRoot!=KVSTORE_ROOT ){
     rc = sqlite4KVCursorKey(pCur, &aKey, &nKey);
@@ -136,7 +142,13 @@ void sqlite4VdbeFreeCursor(VdbeCursor *pCx){
     sqlite4VdbeDecoderDestroy(pCx->pDecoder);
     pCx->pDecoder = 0;
   }
+  if( pCx->pSorter ){
+    sqlite4VdbeSorterFree(pCx->db, pCx->pSorter);
+    pCx->pSorter = 0;
+  }
   sqlite4_buffer_clear(&pCx->sSeekKey);
+  sqlite4_buffer_clear(&pCx->sBatchFirst);
+  sqlite4_buffer_clear(&pCx->sBatchLast);
 #ifndef SQLITE4_OMIT_VIRTUALTABLE
   if( pCx->pVtabCursor ){
     sqlite4_vtab_cursor *pVtabCursor = pCx->pVtabCursor;
@@ -161,6 +173,8 @@ int sqlite4VdbeCursorMoveto(VdbeCursor *pPk){
   int rc = SQLITE4_OK;            /* Return code */
   if( pPk->sSeekKey.n!=0 ){
     assert( pPk->pKeyInfo->nPK==0 );
+    rc = sqlite4VdbeCursorRelease(pPk, 1);
+    if( rc!=SQLITE4_OK ) return rc;
     rc = sqlite4KVCursorSeek(pPk->pKVCur, pPk->sSeekKey.p, pPk->sSeekKey.n, 0);
     if( rc==SQLITE4_NOTFOUND ){
       rc = SQLITE4_CORRUPT_BKPT;
@@ -171,3 +185,19 @@ int sqlite4VdbeCursorMoveto(VdbeCursor *pPk){
   }
   return rc;
 }
+
+/*
+** The KV cursor belonging to VDBE cursor pC is about to be moved. Deal
+** with any registers that still refer to the row it currently points to
+** (see OPFLAG_KVREF). If bPreserve is true, each such register is given a
+** private copy of its value. Otherwise, the caller guarantees that the
+** registers will not be read again and they are simply abandoned.
+**
+** Routines in this file that move the cursor always preserve registers.
+** The OP_Next, OP_Prev and OP_SeekPk opcodes, which only ever move to the
+** next row of a loop, call this function with bPreserve==0 first.
+*/
+int sqlite4VdbeCursorRelease(VdbeCursor *pC, int bPreserve){
+  if( pC->pDecoder==0 ) return SQLITE4_OK;
+  return sqlite4VdbeDecoderRelease(pC->pDecoder, bPreserve);
+}
@@ -65,7 +65,7 @@ int sqlite4VdbeChangeEncoding(Mem *pMem, int desiredEnc){
 ** be discarded.  
 **
 ** This function sets the MEM_Dyn flag and clears any xDel callback.
-** It also clears MEM_Ephem and MEM_Static. If the preserve flag is 
+** It also clears MEM_Ephem, MEM_KVRef and MEM_Static. If the preserve flag is 
 ** not set, Mem.n is zeroed.
 */
 int sqlite4VdbeMemGrow(Mem *pMem, int n, int preserve){
@@ -100,7 +100,7 @@ int sqlite4VdbeMemGrow(Mem *pMem, int n, int preserve){
   if( pMem->z==0 ){
     pMem->flags = MEM_Null;
   }else{
-    pMem->flags &= ~(MEM_Ephem|MEM_Static);
+    pMem->flags &= ~(MEM_Ephem|MEM_KVRef|MEM_Static);
   }
   pMem->xDel = 0;
   return (pMem->z ? SQLITE4_OK : SQLITE4_NOMEM);
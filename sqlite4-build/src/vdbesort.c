@@ -0,0 +1,450 @@
+/*
+** 2026-10-18
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+**
+** This file contains code for the VdbeSorter object, used to collect
+** key/data pairs in memory and write them to a KVStore in key order.
+** It is used by OP_SorterInsert and OP_SorterWrite to build indexes, and
+** by the bulk-load interface. Callers that collect more than
+** SQLITE4_LIMIT_SORTER_SIZE bytes of entries write them out as a sorted
+** run using sqlite4VdbeSorterFlush() and continue with an empty sorter.
+**
+** Sorting may be done using auxiliary worker threads. The array of
+** entries is divided into one partition per thread. Each partition is
+** sorted by its own thread, then the sorted runs are merged in pairs,
+** with each pair merged by a separate thread, until a single run remains.
+** The worker threads only ever compare and copy pointers to entries that
+** were allocated before they were started, so they do not need to hold
+** the database connection mutex.
+*/
+#include "sqliteInt.h"
+#include "vdbeInt.h"
+
+typedef struct SorterEntry SorterEntry;
+typedef struct SorterTask SorterTask;
+
+/*
+** Partitions smaller than this are not worth starting a thread for.
+*/
+#ifndef SQLITE4_SORTER_MIN_PARTITION
+# define SQLITE4_SORTER_MIN_PARTITION 4096
+#endif
+
+/*
+** A single key/data pair. The nKey byte key is stored immediately after
+** the structure, followed by the nData bytes of data.
+**
+** If nPrefix is non-zero, no two entries may share the same first nPrefix
+** bytes of key. See sorterSort().
+*/
+struct SorterEntry {
+  int nKey;                       /* Size of key in bytes */
+  int nData;                      /* Size of data in bytes */
+  int nPrefix;                    /* Size of unique key prefix, or 0 */
+};
+#define sorterEntryKey(p)  ((u8 *)&(p)[1])
+#define sorterEntryData(p) (&sorterEntryKey(p)[(p)->nKey])
+
+/*
+** The sorter object.
+*/
+struct VdbeSorter {
+  SorterEntry **apEntry;          /* Entries, in insert or key order */
+  int nEntry;                     /* Number of valid entries in apEntry[] */
+  int nAlloc;                     /* Allocated size of apEntry[] */
+  i64 nByte;                      /* Total size of all entries in bytes */
+  int nRun;                       /* Number of runs already written */
+  int bDup;                       /* True once a UNIQUE conflict is found */
+};
+
+/*
+** A unit of work for a worker thread. If iMid is zero, entries
+** apIn[0..iEnd-1] are sorted in place, using apOut[] as temporary space.
+** Otherwise, the sorted runs apIn[0..iMid-1] and apIn[iMid..iEnd-1] are
+** merged into apOut[0..iEnd-1].
+*/
+struct SorterTask {
+  SorterEntry **apIn;             /* Input entries */
+  SorterEntry **apOut;            /* Output (or temporary) space */
+  int iMid;                       /* Start of second run, or 0 */
+  int iEnd;                       /* Number of entries */
+  SQLiteThread *pThread;          /* Thread running this task, if any */
+};
+
+/*
+** Compare the keys of two entries using memcmp() semantics.
+*/
+static int sorterCompare(SorterEntry *p1, SorterEntry *p2){
+  int n = (p1->nKey < p2->nKey ? p1->nKey : p2->nKey);
+  int res = memcmp(sorterEntryKey(p1), sorterEntryKey(p2), n);
+  if( res==0 ) res = p1->nKey - p2->nKey;
+  return res;
+}
+
+/*
+** Merge sorted runs apIn[0..iMid-1] and apIn[iMid..iEnd-1] into apOut[].
+** If two entries are equal, the one from the first run is output first.
+*/
+static void sorterMerge(
+  SorterEntry **apIn, int iMid, int iEnd,
+  SorterEntry **apOut
+){
+  int i1 = 0;
+  int i2 = iMid;
+  int iOut = 0;
+  while( i1<iMid || i2<iEnd ){
+    if( i2>=iEnd || (i1<iMid && sorterCompare(apIn[i1], apIn[i2])<=0) ){
+      apOut[iOut++] = apIn[i1++];
+    }else{
+      apOut[iOut++] = apIn[i2++];
+    }
+  }
+}
+
+/*
+** Sort the n entries in apEntry[] into key order using a stable bottom-up
+** merge sort. Array apTmp[] must have space for n entries.
+*/
+static void sorterSortRun(SorterEntry **apEntry, SorterEntry **apTmp, int n){
+  SorterEntry **apIn = apEntry;
+  SorterEntry **apOut = apTmp;
+  int nRun;
+
+  for(nRun=1; nRun<n; nRun*=2){
+    SorterEntry **apSwap;
+    int i;
+    for(i=0; i<n; i+=nRun*2){
+      int iMid = (i+nRun<n ? nRun : n-i);
+      int iEnd = (i+nRun*2<n ? nRun*2 : n-i);
+      sorterMerge(&apIn[i], iMid, iEnd, &apOut[i]);
+    }
+    apSwap = apIn;
+    apIn = apOut;
+    apOut = apSwap;
+  }
+  if( apIn!=apEntry ){
+    memcpy(apEntry, apIn, sizeof(SorterEntry *)*n);
+  }
+}
+
+/*
+** The main routine for a worker thread.
+*/
+static void *sorterTaskMain(void *pCtx){
+  SorterTask *pTask = (SorterTask *)pCtx;
+  if( pTask->iMid==0 ){
+    sorterSortRun(pTask->apIn, pTask->apOut, pTask->iEnd);
+  }else{
+    sorterMerge(pTask->apIn, pTask->iMid, pTask->iEnd, pTask->apOut);
+  }
+  return 0;
+}
+
+/*
+** Run the nTask tasks in array aTask[]. All but the last are run by
+** worker threads. The last is run by the calling thread.
+*/
+static int sorterRunTasks(sqlite4 *db, SorterTask *aTask, int nTask){
+  int rc = SQLITE4_OK;
+  int i;
+
+  for(i=0; i<nTask-1 && rc==SQLITE4_OK; i++){
+    rc = sqlite4ThreadCreate(
+        db->pEnv, &aTask[i].pThread, sorterTaskMain, (void *)&aTask[i]
+    );
+  }
+  if( rc==SQLITE4_OK ){
+    sorterTaskMain((void *)&aTask[nTask-1]);
+  }
+  for(i=0; i<nTask; i++){
+    if( aTask[i].pThread ){
+      void *pOut;
+      int rc2 = sqlite4ThreadJoin(aTask[i].pThread, &pOut);
+      if( rc==SQLITE4_OK ) rc = rc2;
+      aTask[i].pThread = 0;
+    }
+  }
+  return rc;
+}
+
+/*
+** Add a copy of the key/data pair to the sorter *pp, allocating the sorter
+** first if *pp is NULL.
+**
+** If nPrefix is non-zero, it is the number of bytes at the start of the
+** key that must be unique amongst all entries that have a non-zero nPrefix.
+*/
+int sqlite4VdbeSorterInsert(
+  sqlite4 *db,                    /* Database handle */
+  VdbeSorter **pp,                /* IN/OUT: Sorter object */
+  const u8 *aKey, int nKey,       /* Key to add */
+  const u8 *aData, int nData,     /* Data to add */
+  int nPrefix                     /* Size of unique prefix of key, or 0 */
+){
+  VdbeSorter *p = *pp;
+  SorterEntry *pEntry;
+
+  assert( nPrefix>=0 && nPrefix<=nKey );
+  if( p==0 ){
+    p = (VdbeSorter *)sqlite4DbMallocZero(db, sizeof(VdbeSorter));
+    if( p==0 ) return SQLITE4_NOMEM;
+    *pp = p;
+  }
+  if( p->bDup ) return SQLITE4_OK;
+  if( p->nEntry>=p->nAlloc ){
+    int nNew = p->nAlloc ? p->nAlloc*2 : 64;
+    SorterEntry **apNew;
+    apNew = sqlite4DbRealloc(db, p->apEntry, sizeof(SorterEntry *)*nNew);
+    if( apNew==0 ) return SQLITE4_NOMEM;
+    p->apEntry = apNew;
+    p->nAlloc = nNew;
+  }
+
+  pEntry = (SorterEntry *)sqlite4DbMallocRaw(db,
+      sizeof(SorterEntry) + nKey + nData
+  );
+  if( pEntry==0 ) return SQLITE4_NOMEM;
+  pEntry->nKey = nKey;
+  pEntry->nData = nData;
+  pEntry->nPrefix = nPrefix;
+  memcpy(sorterEntryKey(pEntry), aKey, nKey);
+  if( nData ) memcpy(sorterEntryData(pEntry), aData, nData);
+  p->apEntry[p->nEntry++] = pEntry;
+  p->nByte += sizeof(SorterEntry) + nKey + nData;
+  return SQLITE4_OK;
+}
+
+/*
+** Return the number of entries in the sorter.
+*/
+int sqlite4VdbeSorterCount(VdbeSorter *p){
+  return p ? p->nEntry : 0;
+}
+
+/*
+** Return the number of bytes of key and data buffered by the sorter,
+** including per-entry overhead.
+*/
+i64 sqlite4VdbeSorterSize(VdbeSorter *p){
+  return p ? p->nByte : 0;
+}
+
+/*
+** Discard all but the first nEntry entries added to the sorter.
+*/
+void sqlite4VdbeSorterTruncate(sqlite4 *db, VdbeSorter *p, int nEntry){
+  if( p ){
+    while( p->nEntry>nEntry ){
+      SorterEntry *pEntry = p->apEntry[--p->nEntry];
+      p->nByte -= sizeof(SorterEntry) + pEntry->nKey + pEntry->nData;
+      sqlite4DbFree(db, pEntry);
+    }
+  }
+}
+
+/*
+** Sort the entries in the sorter into key order. Up to
+** db->aLimit[SQLITE4_LIMIT_WORKER_THREADS] worker threads are used.
+**
+** If pbDup is not NULL, *pbDup is set to true if the sorter contains
+** two entries with the same non-zero nPrefix that also share the same
+** first nPrefix bytes of key, or to false otherwise.
+*/
+static int sorterSort(sqlite4 *db, VdbeSorter *p, int *pbDup){
+  SorterEntry **apTmp;
+  SorterTask *aTask;
+  int nTask;
+  int rc = SQLITE4_OK;
+  int i;
+
+  if( pbDup ) *pbDup = 0;
+  if( p==0 || p->nEntry<2 ) return SQLITE4_OK;
+
+  apTmp = (SorterEntry **)sqlite4DbMallocRaw(db,
+      sizeof(SorterEntry *)*p->nEntry
+  );
+  if( apTmp==0 ) return SQLITE4_NOMEM;
+
+  nTask = db->aLimit[SQLITE4_LIMIT_WORKER_THREADS] + 1;
+  if( nTask>p->nEntry/SQLITE4_SORTER_MIN_PARTITION ){
+    nTask = p->nEntry/SQLITE4_SORTER_MIN_PARTITION;
+  }
+  if( nTask<=1 ){
+    sorterSortRun(p->apEntry, apTmp, p->nEntry);
+  }else{
+    aTask = (SorterTask *)sqlite4DbMallocZero(db, sizeof(SorterTask)*nTask);
+    if( aTask==0 ){
+      rc = SQLITE4_NOMEM;
+    }else{
+      SorterEntry **apIn = p->apEntry;
+      SorterEntry **apOut = apTmp;
+      int *aiStart;               /* Start of each run. aiStart[nRun]==nEntry */
+      int nRun = nTask;
+
+      /* Sort one partition of the array with each thread */
+      aiStart = (int *)sqlite4StackAllocRaw(db, sizeof(int)*(nTask+1));
+      if( aiStart==0 ){
+        rc = SQLITE4_NOMEM;
+      }else{
+        for(i=0; i<=nTask; i++){
+          aiStart[i] = (int)(((i64)p->nEntry * i) / nTask);
+        }
+        for(i=0; i<nTask; i++){
+          aTask[i].apIn = &apIn[aiStart[i]];
+          aTask[i].apOut = &apOut[aiStart[i]];
+          aTask[i].iMid = 0;
+          aTask[i].iEnd = aiStart[i+1] - aiStart[i];
+        }
+        rc = sorterRunTasks(db, aTask, nTask);
+      }
+
+      /* Merge pairs of runs until only one remains */
+      while( rc==SQLITE4_OK && nRun>1 ){
+        SorterEntry **apSwap;
+        int nPair = nRun/2;
+        for(i=0; i<nPair; i++){
+          int iStart = aiStart[i*2];
+          aTask[i].apIn = &apIn[iStart];
+          aTask[i].apOut = &apOut[iStart];
+          aTask[i].iMid = aiStart[i*2+1] - iStart;
+          aTask[i].iEnd = aiStart[i*2+2] - iStart;
+        }
+        if( nRun & 1 ){
+          int iStart = aiStart[nRun-1];
+          memcpy(&apOut[iStart], &apIn[iStart],
+              sizeof(SorterEntry *)*(p->nEntry - iStart)
+          );
+        }
+        rc = sorterRunTasks(db, aTask, nPair);
+        for(i=0; i<=nRun; i+=2){
+          aiStart[i/2] = aiStart[i];
+        }
+        if( nRun & 1 ) aiStart[nPair+1] = p->nEntry;
+        nRun = (nRun+1)/2;
+        apSwap = apIn;
+        apIn = apOut;
+        apOut = apSwap;
+      }
+      if( rc==SQLITE4_OK && apIn!=p->apEntry ){
+        memcpy(p->apEntry, apIn, sizeof(SorterEntry *)*p->nEntry);
+      }
+      sqlite4StackFree(db, aiStart);
+      sqlite4DbFree(db, aTask);
+    }
+  }
+  sqlite4DbFree(db, apTmp);
+
+  if( rc==SQLITE4_OK && pbDup ){
+    for(i=1; i<p->nEntry; i++){
+      SorterEntry *pPrev = p->apEntry[i-1];
+      SorterEntry *pEntry = p->apEntry[i];
+      if( pEntry->nPrefix
+       && pEntry->nPrefix==pPrev->nPrefix
+       && 0==memcmp(sorterEntryKey(pPrev), sorterEntryKey(pEntry),
+                    pEntry->nPrefix)
+      ){
+        *pbDup = 1;
+        break;
+      }
+    }
+  }
+  return rc;
+}
+
+/*
+** Check whether or not an entry that conflicts with pEntry on its unique
+** prefix is already present in the key-value store that cursor pCur is
+** open on. Set *pbFound to true if it is. This uses the same probe as
+** OP_IsUnique.
+*/
+static int sorterEntryExists(KVCursor *pCur, SorterEntry *pEntry, int *pbFound){
+  const u8 *aProbe = sorterEntryKey(pEntry);
+  int nShort = pEntry->nPrefix;
+  int bPk = (nShort==pEntry->nKey);
+  const KVByteArray *aKey;
+  KVSize nKey;
+  int rc;
+
+  *pbFound = 0;
+  rc = sqlite4KVCursorSeek(pCur, aProbe, nShort, !bPk);
+  if( rc==SQLITE4_OK ){
+    *pbFound = 1;
+  }else if( rc==SQLITE4_NOTFOUND ){
+    rc = SQLITE4_OK;
+  }else if( rc==SQLITE4_INEXACT ){
+    rc = sqlite4KVCursorKey(pCur, &aKey, &nKey);
+    if( rc==SQLITE4_OK && nKey>=nShort && memcmp(aProbe, aKey, nShort)==0 ){
+      *pbFound = 1;
+    }
+  }
+  return rc;
+}
+
+/*
+** Sort the entries in the sorter and write them, as a single run in key
+** order, to the key-value store that cursor pCur is open on. The sorter
+** is left empty.
+**
+** Before anything is written, entries with a non-zero nPrefix are checked
+** against each other and, if bProbe is true or a previous run has been
+** written by this sorter, against the contents of the key-value store.
+** If a conflicting entry is found, nothing is written and *pbDup is set
+** to true. Once this has happened, later calls to this function and to
+** sqlite4VdbeSorterInsert() are no-ops that continue to report the
+** conflict.
+*/
+int sqlite4VdbeSorterFlush(
+  sqlite4 *db,                    /* Database handle */
+  VdbeSorter *p,                  /* Sorter to flush */
+  KVCursor *pCur,                 /* Cursor to probe and write with */
+  int bProbe,                     /* True if the store may hold entries */
+  int *pbDup                      /* OUT: True if a conflict is found */
+){
+  int rc = SQLITE4_OK;
+  int i;
+
+  *pbDup = 0;
+  if( p==0 ) return SQLITE4_OK;
+  if( p->bDup==0 ){
+    rc = sorterSort(db, p, &p->bDup);
+  }
+  if( bProbe || p->nRun>0 ){
+    for(i=0; rc==SQLITE4_OK && p->bDup==0 && i<p->nEntry; i++){
+      if( p->apEntry[i]->nPrefix ){
+        rc = sorterEntryExists(pCur, p->apEntry[i], &p->bDup);
+      }
+    }
+  }
+  for(i=0; rc==SQLITE4_OK && p->bDup==0 && i<p->nEntry; i++){
+    SorterEntry *pEntry = p->apEntry[i];
+    rc = sqlite4KVStoreReplace(pCur->pStore,
+        sorterEntryKey(pEntry), pEntry->nKey,
+        sorterEntryData(pEntry), pEntry->nData
+    );
+  }
+  if( rc==SQLITE4_OK ){
+    p->nRun++;
+    *pbDup = p->bDup;
+  }
+  sqlite4VdbeSorterTruncate(db, p, 0);
+  return rc;
+}
+
+/*
+** Free a sorter object and all entries it contains.
+*/
+void sqlite4VdbeSorterFree(sqlite4 *db, VdbeSorter *p){
+  if( p ){
+    sqlite4VdbeSorterTruncate(db, p, 0);
+    sqlite4DbFree(db, p->apEntry);
+    sqlite4DbFree(db, p);
+  }
+}
@@ -91,6 +91,11 @@ struct WhereLevel {
   u8 iFrom;             /* Which entry in the FROM clause */
   u8 op, p5;            /* Opcode and P5 of the opcode that ends the loop */
   int p1, p2;           /* Operands of the opcode used to ends the loop */
+  int addrExplain;      /* OP_Explain describing this loop, or -1 */
+  int addrStart;        /* First instruction coded by codeOneLoopStart() */
+  int addrVisit;        /* EXPLAIN ANALYZE: run once for each row visited */
+  int addrPass;         /* EXPLAIN ANALYZE: run once for each row passed on */
+  int iBatchCur;        /* Lookahead cursor for OP_SeekBatch, or -1 */
   union {               /* Information that depends on pWLoop->wsFlags */
     struct {
       int nIn;              /* Number of entries in aInLoop[] */
@@ -2200,6 +2205,8 @@ static void constructAutomaticIndex(
   Bitmask idxCols;            /* Bitmap of columns used for indexing */
   Bitmask extraCols;          /* Bitmap of additional columns */
   u8 sentWarning = 0;         /* True if a warnning has been issued */
+  int addrExplain = -1;       /* OP_Explain for EXPLAIN ANALYZE, or -1 */
+  int addrInsert;             /* OP_Insert that adds a row to the index */
 
   /* Generate code to skip over the creation and initialization of the
   ** transient index on 2nd and subsequent iterations of the loop. */
@@ -2207,6 +2214,16 @@ static void constructAutomaticIndex(
   assert( v!=0 );
   addrInit = sqlite4CodeOnce(pParse);
 
+  /* EXPLAIN ANALYZE reports on building the index as a separate step */
+  if( ExplainAnalyze(pParse) ){
+    char *zMsg = sqlite4MPrintf(pParse->db, "BUILD AUTOMATIC INDEX ON %s",
+        pSrc->pTab->zName
+    );
+    addrExplain = sqlite4VdbeAddOp4(v, OP_Explain, pParse->iSelectId, 0,
+        pLevel->iFrom, zMsg, P4_DYNAMIC
+    );
+  }
+
   /* Count the number of columns that will be added to the index
   ** and used to match WHERE clause constraints */
   nColumn = 0;
@@ -2328,12 +2345,20 @@ static void constructAutomaticIndex(
   regKey = regRecord + 1;
   sqlite4EncodeIndexKey(pParse, 0, iPkCsr, pIdx, pLevel->iIdxCur, 1, regKey);
   sqlite4EncodeIndexValue(pParse, iPkCsr, pIdx, regRecord);
-  sqlite4VdbeAddOp3(v, OP_Insert, pLevel->iIdxCur, regRecord, regKey);
+  addrInsert = sqlite4VdbeAddOp3(v, OP_Insert, pLevel->iIdxCur, regRecord,
+      regKey
+  );
   /* sqlite4VdbeChangeP5(v, OPFLAG_USESEEKRESULT); */
   sqlite4VdbeAddOp2(v, OP_Next, pLevel->iTabCur, addrTop+1);
   sqlite4VdbeChangeP5(v, SQLITE4_STMTSTATUS_AUTOINDEX);
   sqlite4VdbeJumpHere(v, addrTop);
   sqlite4ReleaseTempRange(pParse, regRecord, 2);
+  if( addrExplain>=0 ){
+    sqlite4VdbeScanStatus(v, addrExplain, addrTop+1, addrInsert, -1);
+    sqlite4VdbeScanStatusRange(v, addrExplain,
+        addrExplain, sqlite4VdbeCurrentAddr(v)
+    );
+  }
   
   /* Jump here when skipping the initialization */
   sqlite4VdbeJumpHere(v, addrInit);
@@ -3212,9 +3237,11 @@ static char *explainIndexRange(sqlite4 *db, WhereLoop *pLoop, Table *pTab){
 
 /*
 ** This function is a no-op unless currently processing an EXPLAIN QUERY PLAN
-** command. If the query being compiled is an EXPLAIN QUERY PLAN, a single
-** record is added to the output to describe the table scan strategy in 
-** pLevel.
+** or EXPLAIN ANALYZE command. If the query being compiled is an EXPLAIN 
+** QUERY PLAN, a single record is added to the output to describe the table
+** scan strategy in pLevel, and its address stored in pLevel->addrExplain.
+** EXPLAIN ANALYZE also describes loops that use the multi-index OR
+** strategy, so that the rows visited by each can be reported.
 */
 static void explainOneScan(
   Parse *pParse,                  /* Parse context */
@@ -3224,7 +3251,7 @@ static void explainOneScan(
   int iFrom,                      /* Value for "from" column of output */
   u16 wctrlFlags                  /* Flags passed to sqlite4WhereBegin() */
 ){
-  if( pParse->explain==2 ){
+  if( ExplainQueryPlan(pParse) ){
     struct SrcListItem *pItem = &pTabList->a[pLevel->iFrom];
     Vdbe *v = pParse->pVdbe;      /* VM being constructed */
     sqlite4 *db = pParse->db;     /* Database handle */
@@ -3236,7 +3263,18 @@ static void explainOneScan(
 
     pLoop = pLevel->pWLoop;
     flags = pLoop->wsFlags;
-    if( (flags&WHERE_MULTI_OR) || (wctrlFlags&WHERE_ONETABLE_ONLY) ) return;
+    if( wctrlFlags&WHERE_ONETABLE_ONLY ) return;
+    if( (flags&WHERE_MULTI_OR) ){
+      if( !ExplainAnalyze(pParse) ) return;
+      zMsg = sqlite4MPrintf(db, "SEARCH TABLE %s%s%s VIA MULTI-INDEX OR",
+          pItem->zName, pItem->zAlias ? " AS " : "",
+          pItem->zAlias ? pItem->zAlias : ""
+      );
+      pLevel->addrExplain = sqlite4VdbeAddOp4(
+          v, OP_Explain, iId, iLevel, iFrom, zMsg, P4_DYNAMIC
+      );
+      return;
+    }
 
     isSearch = (flags&(WHERE_BTM_LIMIT|WHERE_TOP_LIMIT))!=0
             || ((flags&WHERE_VIRTUALTABLE)==0 && (pLoop->u.btree.nEq>0))
@@ -3282,7 +3320,9 @@ static void explainOneScan(
     }
 #endif
     zMsg = sqlite4MAppendf(db, zMsg, "%s", zMsg);
-    sqlite4VdbeAddOp4(v, OP_Explain, iId, iLevel, iFrom, zMsg, P4_DYNAMIC);
+    pLevel->addrExplain = sqlite4VdbeAddOp4(
+        v, OP_Explain, iId, iLevel, iFrom, zMsg, P4_DYNAMIC
+    );
   }
 }
 #else
@@ -3314,6 +3354,149 @@ static int findMatchExpr(
 }
 
 
+/*
+** Return true if table pTab is an ordinary table stored in the KV store.
+*/
+static int whereIsPlainTable(Table *pTab){
+  return (pTab->tabFlags & TF_Ephemeral)==0 && pTab->pSelect==0
+      && !IsVirtual(pTab) && !IsKvstore(pTab);
+}
+
+/*
+** Return true if the seeks made by loop iLevel of the join described by
+** pWInfo may be batched by looking ahead over the rows of the loop that
+** encloses it (see OP_SeekBatch). This is so if SQLITE4_DBCONFIG_SEEK_BATCH
+** is set, the enclosing loop scans the PRIMARY KEY of an ordinary table,
+** and loop iLevel seeks an index using only == constraints whose right-hand
+** sides are plain columns of the enclosing table.
+*/
+static int whereSeekBatchOk(WhereInfo *pWInfo, int iLevel){
+  WhereLevel *pLevel = &pWInfo->a[iLevel];
+  WhereLevel *pOuter = &pWInfo->a[iLevel-1];
+  WhereLoop *pLoop = pLevel->pWLoop;
+  WhereLoop *pOuterLoop = pOuter->pWLoop;
+  SrcList *pTabList = pWInfo->pTabList;
+  int iOuterCur = pTabList->a[pOuter->iFrom].iCursor;
+  int j;
+
+  assert( iLevel>0 );
+  if( pWInfo->pParse->db->nSeekBatch<=0 ) return 0;
+  if( pWInfo->okOnePass ) return 0;
+  if( pWInfo->wctrlFlags & (WHERE_ORDERBY_MIN|WHERE_OMIT_OPEN_CLOSE) ){
+    return 0;
+  }
+  if( !whereIsPlainTable(pTabList->a[pLevel->iFrom].pTab)
+   || !whereIsPlainTable(pTabList->a[pOuter->iFrom].pTab)
+  ){
+    return 0;
+  }
+
+  /* The enclosing loop must scan the PRIMARY KEY index */
+  if( (pOuterLoop->wsFlags & WHERE_INDEXED)==0
+   || (pOuterLoop->wsFlags & (WHERE_ONEROW|WHERE_COLUMN_IN|WHERE_COLUMN_NULL
+                             |WHERE_MULTI_OR|WHERE_AUTO_INDEX))
+   || pOuterLoop->u.btree.pIndex->eIndexType!=SQLITE4_INDEX_PRIMARYKEY
+  ){
+    return 0;
+  }
+
+  /* Loop iLevel must seek a forward scan of an index using == only */
+  if( (pLoop->wsFlags & WHERE_INDEXED)==0
+   || (pLoop->wsFlags & (WHERE_BOTH_LIMIT|WHERE_COLUMN_IN|WHERE_COLUMN_NULL
+                        |WHERE_MULTI_OR|WHERE_AUTO_INDEX))
+   || pLoop->u.btree.pIndex->eIndexType==SQLITE4_INDEX_FTS5
+   || pLoop->u.btree.nEq==0
+   || (pWInfo->revMask>>iLevel)&1
+  ){
+    return 0;
+  }
+  for(j=0; j<pLoop->u.btree.nEq; j++){
+    WhereTerm *pTerm = pLoop->aLTerm[j];
+    Expr *pRight;
+    if( pTerm==0 || (pTerm->eOperator & WO_EQ)==0 ) return 0;
+    pRight = pTerm->pExpr->pRight;
+    if( pRight==0 || pRight->op!=TK_COLUMN
+     || pRight->iTable!=iOuterCur || pRight->iColumn<0
+    ){
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/*
+** Generate code to fill the seek batch of the index cursor of loop iLevel
+** (see OP_SeekBatch), which must be one for which whereSeekBatchOk() was
+** true. Nothing is coded unless the enclosing loop iterates over its
+** table cursor directly.
+**
+** The key of each of the next rows of the enclosing loop is computed
+** the same way as codeAllEqualityTerms() computes the key for the
+** current row, reading from the lookahead cursor pLevel->iBatchCur instead
+** of from the table cursor.
+*/
+static void codeSeekBatch(WhereInfo *pWInfo, int iLevel){
+  Parse *pParse = pWInfo->pParse;
+  Vdbe *v = pParse->pVdbe;
+  WhereLevel *pLevel = &pWInfo->a[iLevel];
+  WhereLevel *pOuter = &pWInfo->a[iLevel-1];
+  WhereLoop *pLoop = pLevel->pWLoop;
+  Table *pOuterTab = pWInfo->pTabList->a[pOuter->iFrom].pTab;
+  int nEq = pLoop->u.btree.nEq;
+  int iOuterCur = pOuter->iTabCur;
+  int iLook = pLevel->iBatchCur;
+  int addrSkip;                   /* Label jumped to by OP_SeekBatch */
+  int addrNoKey;                  /* Jump here if a key value is NULL */
+  int addrLoop;                   /* Top of the lookahead loop */
+  int regBase;                    /* First register of key values */
+  int regKey;                     /* Register holding the encoded key */
+  char *zAff;                     /* Affinity string for the key values */
+  int j;
+
+  if( (pOuter->op!=OP_Next && pOuter->op!=OP_Prev) || pOuter->p1!=iOuterCur ){
+    return;
+  }
+  zAff = sqlite4DbStrDup(pParse->db,
+      sqlite4IndexAffinityStr(v, pLoop->u.btree.pIndex)
+  );
+  if( zAff==0 ){
+    pParse->db->mallocFailed = 1;
+    return;
+  }
+
+  addrSkip = sqlite4VdbeMakeLabel(v);
+  addrNoKey = sqlite4VdbeMakeLabel(v);
+  regBase = sqlite4GetTempRange(pParse, nEq);
+  regKey = sqlite4GetTempReg(pParse);
+  sqlite4ExprCachePush(pParse);
+  sqlite4VdbeAddOp4Int(v, OP_SeekBatch, pLevel->iIdxCur, addrSkip,
+                       iOuterCur, iLook);
+  addrLoop = sqlite4VdbeCurrentAddr(v);
+  for(j=0; j<nEq; j++){
+    Expr *pRight = pLoop->aLTerm[j]->pExpr->pRight;
+    sqlite4ExprCodeGetColumnOfTable(v, pOuterTab, iLook, pRight->iColumn,
+                                    regBase+j);
+    sqlite4VdbeAddOp2(v, OP_IsNull, regBase+j, addrNoKey);
+    if( sqlite4CompareAffinity(pRight, zAff[j])==SQLITE4_AFF_NONE ){
+      zAff[j] = SQLITE4_AFF_NONE;
+    }
+    if( sqlite4ExprNeedsNoAffinityChange(pRight, zAff[j]) ){
+      zAff[j] = SQLITE4_AFF_NONE;
+    }
+  }
+  codeApplyAffinity(pParse, regBase, nEq, zAff);
+  sqlite4VdbeAddOp4Int(v, OP_MakeKey, regBase, nEq, regKey, pLevel->iIdxCur);
+  sqlite4VdbeAddOp2(v, OP_SeekBatchAdd, pLevel->iIdxCur, regKey);
+  sqlite4VdbeResolveLabel(v, addrNoKey);
+  sqlite4VdbeAddOp3(v, OP_SeekBatchNext, iLook, addrLoop, pLevel->iIdxCur);
+  sqlite4VdbeChangeP5(v, pOuter->op==OP_Prev);
+  sqlite4VdbeResolveLabel(v, addrSkip);
+  sqlite4ExprCachePop(pParse, 1);
+  sqlite4ReleaseTempReg(pParse, regKey);
+  sqlite4ReleaseTempRange(pParse, regBase, nEq);
+  sqlite4DbFree(pParse->db, zAff);
+}
+
 /*
 ** Generate code for the start of the iLevel-th loop in the WHERE clause
 ** implementation described by pWInfo.
@@ -3351,6 +3534,7 @@ static Bitmask codeOneLoopStart(
   bRev = (pWInfo->revMask>>iLevel)&1;
   omitTable = (pLoop->wsFlags & WHERE_IDX_ONLY)!=0 
            && (pWInfo->wctrlFlags & WHERE_FORCE_TABLE)==0;
+  pLevel->addrStart = sqlite4VdbeCurrentAddr(v);
   VdbeNoopComment((v, "Begin Join Loop %d", iLevel));
 
   /* Create labels for the "break" and "continue" instructions
@@ -3564,6 +3748,7 @@ static Bitmask codeOneLoopStart(
     ** and store the values of those terms in an array of registers
     ** starting at regBase.
     */
+    if( pLevel->iBatchCur>=0 ) codeSeekBatch(pWInfo, iLevel);
     regBase = codeAllEqualityTerms(pParse,pLevel,bRev,nExtraReg,&zStartAff);
     assert( (regBase+nEq+nExtraReg-1)<=pParse->nMem );
     zEndAff = sqlite4DbStrDup(pParse->db, zStartAff);
@@ -3957,6 +4142,13 @@ static Bitmask codeOneLoopStart(
   }
   newNotReady = notReady & ~getMask(&pWInfo->sMaskSet, iCur);
 
+  /* For EXPLAIN ANALYZE, mark the point that is reached once for each row
+  ** visited by the loop, before any of the tests below are applied.
+  */
+  if( ExplainAnalyze(pParse) ){
+    pLevel->addrVisit = sqlite4VdbeAddOp0(v, OP_Noop);
+  }
+
   /* Insert code to test every subexpression that can be completely
   ** computed using the current set of tables.
   **
@@ -4037,6 +4229,11 @@ static Bitmask codeOneLoopStart(
   }
   sqlite4ReleaseTempReg(pParse, iReleaseReg);
 
+  /* And the point reached once for each row that passes all of them */
+  if( ExplainAnalyze(pParse) ){
+    pLevel->addrPass = sqlite4VdbeAddOp0(v, OP_Noop);
+  }
+
   return newNotReady;
 }
 
@@ -6030,6 +6227,7 @@ WhereInfo *sqlite4WhereBegin(
     pTab = pTabItem->pTab;
     iDb = sqlite4SchemaToIndex(db, pTab->pSchema);
     pLoop = pLevel->pWLoop;
+    pLevel->iBatchCur = -1;
     if( (pTab->tabFlags & TF_Ephemeral)!=0 || pTab->pSelect ){
       /* Do nothing */
     }else
@@ -6071,6 +6269,15 @@ WhereInfo *sqlite4WhereBegin(
         }
       }
     }
+    if( ii>0 && whereSeekBatchOk(pWInfo, ii) ){
+      /* Open a second cursor on the table of the enclosing loop, used to
+      ** look ahead over its rows when batching the seeks of this one.  */
+      Table *pOuterTab = pTabList->a[pWInfo->a[ii-1].iFrom].pTab;
+      pLevel->iBatchCur = pParse->nTab++;
+      sqlite4OpenPrimaryKey(pParse, pLevel->iBatchCur,
+          sqlite4SchemaToIndex(db, pOuterTab->pSchema), pOuterTab, OP_OpenRead
+      );
+    }
     sqlite4CodeVerifySchema(pParse, iDb);
     notReady &= ~getMask(&pWInfo->sMaskSet, pTabItem->iCursor);
   }
@@ -6084,6 +6291,7 @@ WhereInfo *sqlite4WhereBegin(
   notReady = ~(Bitmask)0;
   for(ii=0; ii<nTabList; ii++){
     pLevel = &pWInfo->a[ii];
+    pLevel->addrExplain = -1;
     explainOneScan(pParse, pTabList, pLevel, ii, pLevel->iFrom, wctrlFlags);
     notReady = codeOneLoopStart(pWInfo, ii, notReady);
     pWInfo->iContinue = pLevel->addrCont;
@@ -6118,6 +6326,7 @@ void sqlite4WhereEnd(WhereInfo *pWInfo){
   */
   sqlite4ExprCacheClear(pParse);
   for(i=pWInfo->nLevel-1; i>=0; i--){
+    int addrEnd = sqlite4VdbeCurrentAddr(v);
     pLevel = &pWInfo->a[i];
     pLoop = pLevel->pWLoop;
     sqlite4VdbeResolveLabel(v, pLevel->addrCont);
@@ -6155,6 +6364,21 @@ void sqlite4WhereEnd(WhereInfo *pWInfo){
       }
       sqlite4VdbeJumpHere(v, addr);
     }
+
+    /* For EXPLAIN ANALYZE, report the rows visited and passed on by the
+    ** loop, and the time spent in the code that starts and ends it.  */
+    if( ExplainAnalyze(pParse) && pLevel->addrExplain>=0 ){
+      int addrExplain = pLevel->addrExplain;
+      sqlite4VdbeScanStatus(v, addrExplain, pLevel->addrVisit,
+          pLevel->addrPass, (i64)whereCostToInt(pLoop->nOut)
+      );
+      sqlite4VdbeScanStatusRange(v, addrExplain,
+          pLevel->addrStart, pLevel->addrPass+1
+      );
+      sqlite4VdbeScanStatusRange(v, addrExplain,
+          addrEnd, sqlite4VdbeCurrentAddr(v)
+      );
+    }
   }
 
   /* The "break" point is here, just past the end of the outer loop.
@@ -6184,6 +6408,9 @@ void sqlite4WhereEnd(WhereInfo *pWInfo){
           sqlite4VdbeAddOp1(v, OP_Close, pLevel->iIdxCur);
         }
       }
+      if( pLevel->iBatchCur>=0 ){
+        sqlite4VdbeAddOp1(v, OP_Close, pLevel->iBatchCur);
+      }
     }
 
     /* If this scan uses an index, make VDBE code substitutions to read data
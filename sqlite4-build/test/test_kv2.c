@@ -19,6 +19,8 @@ static struct KVWrapGlobal {
   sqlite4_kvfactory xFactory;
   int nStep;                      /* Total number of successful next/prev */
   int nSeek;                      /* Total number of calls to xSeek */
+  int nLocked;                    /* Fail this many xReplace calls */
+  int nCommit;                    /* Write transactions committed */
 } kvwg = {0};
 
 typedef struct KVWrap KVWrap;
@@ -27,6 +29,7 @@ typedef struct KVWrapCsr KVWrapCsr;
 struct KVWrap {
   KVStore base;                   /* Base class, must be first */
   KVStore *pReal;                 /* "Real" KVStore object */
+  int nCommit;                    /* Write transactions committed by this */
 };
 
 struct KVWrapCsr {
@@ -53,8 +56,13 @@ static int kvwrapCommitPhaseOne(KVStore *pKVStore, int iLevel){
 static int kvwrapCommitPhaseTwo(KVStore *pKVStore, int iLevel){
   int rc;
   KVWrap *p = (KVWrap *)pKVStore;
+  int bWrite = (p->base.iTransLevel>=2);
   rc = p->pReal->pStoreVfunc->xCommitPhaseTwo(p->pReal, iLevel);
   p->base.iTransLevel = p->pReal->iTransLevel;
+  if( rc==SQLITE4_OK && bWrite && iLevel<2 ){
+    kvwg.nCommit++;
+    p->nCommit++;
+  }
   return rc;
 }
 
@@ -80,6 +88,11 @@ static int kvwrapReplace(
   const KVByteArray *aData, KVSize nData
 ){
   KVWrap *p = (KVWrap *)pKVStore;
+  if( kvwg.nLocked>0 ){
+    /* Simulate the storage engine choosing this write as a deadlock victim */
+    kvwg.nLocked--;
+    return SQLITE4_LOCKED;
+  }
   return p->pReal->pStoreVfunc->xReplace(p->pReal, aKey, nKey, aData, nData);
 }
 
@@ -228,10 +241,18 @@ static int kvwrapClose(KVStore *pKVStore){
 
 /*
 ** Invoke the xControl() method of the underlying KVStore object.
+**
+** SQLITE4_KVCTRL_DATA_VERSION reports changes as if all wrapped stores
+** were connections to a single database: the version changes each time
+** a write transaction is committed through any other wrapped store.
 */
 static int kvwrapControl(KVStore *pKVStore, int op, void *pArg){
   KVWrap *p = (KVWrap *)pKVStore;
-  return p->pReal->pStoreVfunc->xControl(p->pReal, op, pArg);
+  int rc = p->pReal->pStoreVfunc->xControl(p->pReal, op, pArg);
+  if( rc==SQLITE4_OK && op==SQLITE4_KVCTRL_DATA_VERSION ){
+    *(sqlite4_uint64*)pArg += (kvwg.nCommit - p->nCommit);
+  }
+  return rc;
 }
 
 static int kvwrapGetMeta(KVStore *pKVStore, unsigned int *piVal){
@@ -252,6 +273,7 @@ static int kvwrapGetMethod(
   void (**pxDestroy)(void *)
 ){
   KVWrap *p = (KVWrap *)pKVStore;
+  if( p->pReal->pStoreVfunc->xGetMethod==0 ) return SQLITE4_NOTFOUND;
   return p->pReal->pStoreVfunc->xGetMethod(
       p->pReal, zMethod, ppArg, pxFunc, pxDestroy
   );
@@ -280,6 +302,7 @@ static int newFileStorage(
     kvwrapCloseCursor,
     kvwrapBegin,
     kvwrapCommitPhaseOne,
+    0,
     kvwrapCommitPhaseTwo,
     kvwrapRollback,
     kvwrapRevert,
@@ -378,6 +401,18 @@ static int kvwrap_reset_cmd(Tcl_Interp *interp, int objc, Tcl_Obj **objv){
   return TCL_OK;
 }
 
+static int kvwrap_locked_cmd(Tcl_Interp *interp, int objc, Tcl_Obj **objv){
+  if( objc!=2 && objc!=3 ){
+    Tcl_WrongNumArgs(interp, 2, objv, "?NREPLACE?");
+    return TCL_ERROR;
+  }
+  if( objc==3 ){
+    if( Tcl_GetIntFromObj(interp, objv[2], &kvwg.nLocked) ) return TCL_ERROR;
+  }
+
+  Tcl_SetObjResult(interp, Tcl_NewIntObj(kvwg.nLocked));
+  return TCL_OK;
+}
 
 /*
 ** TCLCMD:    kvwrap SUB-COMMAND
@@ -396,6 +431,7 @@ static int kvwrap_command(
     { "step",      kvwrap_step_cmd },
     { "seek",      kvwrap_seek_cmd },
     { "reset",     kvwrap_reset_cmd },
+    { "locked",    kvwrap_locked_cmd },
     { "uninstall", kvwrap_uninstall_cmd },
   };
   int iSub;
@@ -152,6 +152,7 @@ const char *sqlite4TestErrorName(int rc){
     case SQLITE4_ROW:                zName = "SQLITE4_ROW";               break;
     case SQLITE4_DONE:               zName = "SQLITE4_DONE";              break;
     case SQLITE4_INEXACT:            zName = "SQLITE4_INEXACT";           break;
+    case SQLITE4_BATCHFULL:          zName = "SQLITE4_BATCHFULL";         break;
     case SQLITE4_IOERR_READ:         zName = "SQLITE4_IOERR_READ";        break;
     case SQLITE4_IOERR_SHORT_READ:   zName = "SQLITE4_IOERR_SHORT_READ";  break;
     case SQLITE4_IOERR_WRITE:        zName = "SQLITE4_IOERR_WRITE";       break;
@@ -3099,6 +3100,480 @@ static int test_step(
   return TCL_OK;
 }
 
+/*
+** Usage: sqlite4_step_batch STMT NROW NDATA
+**
+** Call sqlite4_step_batch() to fetch up to NROW rows from STMT. Each
+** column is stored with its own datatype, and text and blob values are
+** packed into a buffer of NDATA bytes per column. Return a list made of
+** the result code followed by the values of the rows returned.
+*/
+static int test_step_batch(
+  void * clientData,
+  Tcl_Interp *interp,
+  int objc,
+  Tcl_Obj *CONST objv[]
+){
+  sqlite4_stmt *pStmt;
+  sqlite4_batch_column *aCol;
+  Tcl_Obj *pRet;
+  int nRow;
+  int nData;
+  int nCol;
+  int nOut = 0;
+  int rc;
+  int i, j;
+
+  if( objc!=4 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "STMT NROW NDATA");
+    return TCL_ERROR;
+  }
+  if( getStmtPointer(interp, Tcl_GetString(objv[1]), &pStmt) ) return TCL_ERROR;
+  if( Tcl_GetIntFromObj(interp, objv[2], &nRow) ) return TCL_ERROR;
+  if( Tcl_GetIntFromObj(interp, objv[3], &nData) ) return TCL_ERROR;
+
+  nCol = sqlite4_column_count(pStmt);
+  aCol = (sqlite4_batch_column *)ckalloc(sizeof(sqlite4_batch_column)*(nCol+1));
+  memset(aCol, 0, sizeof(sqlite4_batch_column)*(nCol+1));
+  for(i=0; i<nCol; i++){
+    aCol[i].aType = (unsigned char *)ckalloc(nRow+1);
+    aCol[i].aInt = (sqlite4_int64 *)ckalloc(sizeof(sqlite4_int64)*(nRow+1));
+    aCol[i].aReal = (double *)ckalloc(sizeof(double)*(nRow+1));
+    aCol[i].aOffset = (int *)ckalloc(sizeof(int)*(nRow+1));
+    aCol[i].aData = (char *)ckalloc(nData+1);
+    aCol[i].nData = nData;
+  }
+
+  rc = sqlite4_step_batch(pStmt, nRow, nCol, aCol, &nOut);
+
+  pRet = Tcl_NewObj();
+  Tcl_ListObjAppendElement(interp, pRet, Tcl_NewStringObj(t1ErrorName(rc), -1));
+  for(j=0; j<nOut; j++){
+    for(i=0; i<nCol; i++){
+      sqlite4_batch_column *p = &aCol[i];
+      Tcl_Obj *pVal;
+      switch( p->aType[j] ){
+        case SQLITE4_INTEGER:
+          pVal = Tcl_NewWideIntObj(p->aInt[j]);
+          break;
+        case SQLITE4_FLOAT:
+          pVal = Tcl_NewDoubleObj(p->aReal[j]);
+          break;
+        case SQLITE4_TEXT:
+          pVal = Tcl_NewStringObj(&p->aData[p->aOffset[j]],
+                                  p->aOffset[j+1] - p->aOffset[j]);
+          break;
+        case SQLITE4_BLOB:
+          pVal = Tcl_NewByteArrayObj((unsigned char *)&p->aData[p->aOffset[j]],
+                                     p->aOffset[j+1] - p->aOffset[j]);
+          break;
+        default:
+          pVal = Tcl_NewObj();
+          break;
+      }
+      Tcl_ListObjAppendElement(interp, pRet, pVal);
+    }
+  }
+
+  for(i=0; i<nCol; i++){
+    ckfree((char *)aCol[i].aType);
+    ckfree((char *)aCol[i].aInt);
+    ckfree((char *)aCol[i].aReal);
+    ckfree((char *)aCol[i].aOffset);
+    ckfree(aCol[i].aData);
+  }
+  ckfree((char *)aCol);
+  Tcl_SetObjResult(interp, pRet);
+  return TCL_OK;
+}
+
+/*
+** Usage: sqlite4_bulkload DB TABLE ROWS
+**
+** Load the rows in list ROWS into table TABLE using a bulk-load handle.
+** Each row is a list of column values. Integer values are bound using
+** sqlite4_bulkload_bind_int64(), empty strings are bound as NULL and all
+** other values are bound as text. Return a list containing the index of
+** each row rejected by sqlite4_bulkload_append() and the corresponding
+** result code, followed by the result of sqlite4_bulkload_finish().
+*/
+static int test_bulkload(
+  void * clientData,
+  Tcl_Interp *interp,
+  int objc,
+  Tcl_Obj *CONST objv[]
+){
+  sqlite4 *db;
+  sqlite4_bulkload *pLoad;
+  Tcl_Obj **apRow;
+  Tcl_Obj *pRet;
+  int nRow;
+  int rc;
+  int i, j;
+
+  if( objc!=4 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "DB TABLE ROWS");
+    return TCL_ERROR;
+  }
+  if( getDbPointer(interp, Tcl_GetString(objv[1]), &db) ) return TCL_ERROR;
+  if( Tcl_ListObjGetElements(interp, objv[3], &nRow, &apRow) ){
+    return TCL_ERROR;
+  }
+
+  rc = sqlite4_bulkload_begin(db, 0, Tcl_GetString(objv[2]), &pLoad);
+  if( rc!=SQLITE4_OK ){
+    Tcl_SetResult(interp, (char *)t1ErrorName(rc), 0);
+    return TCL_OK;
+  }
+
+  pRet = Tcl_NewObj();
+  for(i=0; i<nRow; i++){
+    Tcl_Obj **apVal;
+    int nVal;
+    if( Tcl_ListObjGetElements(interp, apRow[i], &nVal, &apVal) ){
+      sqlite4_bulkload_abort(pLoad);
+      Tcl_DecrRefCount(pRet);
+      return TCL_ERROR;
+    }
+    for(j=0; j<nVal; j++){
+      Tcl_WideInt iVal;
+      int nByte;
+      const char *zVal = Tcl_GetStringFromObj(apVal[j], &nByte);
+      if( nByte==0 ){
+        sqlite4_bulkload_bind_null(pLoad, j+1);
+      }else if( TCL_OK==Tcl_GetWideIntFromObj(0, apVal[j], &iVal) ){
+        sqlite4_bulkload_bind_int64(pLoad, j+1, iVal);
+      }else{
+        sqlite4_bulkload_bind_text(pLoad, j+1, zVal, nByte,
+            SQLITE4_TRANSIENT, 0
+        );
+      }
+    }
+    rc = sqlite4_bulkload_append(pLoad);
+    if( rc!=SQLITE4_OK ){
+      Tcl_ListObjAppendElement(interp, pRet, Tcl_NewIntObj(i));
+      Tcl_ListObjAppendElement(interp, pRet,
+          Tcl_NewStringObj(t1ErrorName(rc), -1)
+      );
+    }
+  }
+  rc = sqlite4_bulkload_finish(pLoad);
+  Tcl_ListObjAppendElement(interp, pRet, Tcl_NewStringObj(t1ErrorName(rc), -1));
+  Tcl_SetObjResult(interp, pRet);
+  return TCL_OK;
+}
+
+/*
+** Usage: sqlite4_pool_open URI NCONN
+**        sqlite4_pool_prepare POOL SQL
+**        sqlite4_pool_checkout POOL
+**        sqlite4_pool_checkin POOL DB
+**        sqlite4_pool_stmt DB ISTMT
+**        sqlite4_pool_status POOL OP RESETFLAG
+**        sqlite4_pool_close POOL
+**
+** Test the sqlite4_pool_*() interfaces. Connection pools, connections and
+** statements are identified by pointer strings. sqlite4_pool_open,
+** sqlite4_pool_prepare and sqlite4_pool_checkout return the new object or
+** statement index, and throw an error if the call fails. Other commands
+** return the name of the result code, except sqlite4_pool_stmt, which
+** returns a statement, and sqlite4_pool_status, which returns the current
+** and highest values. OP is one of IDLE, INUSE, CHECKOUT, MISS or RESET.
+*/
+static int test_pool(
+  void * clientData,
+  Tcl_Interp *interp,
+  int objc,
+  Tcl_Obj *CONST objv[]
+){
+  const char *zCmd = (const char *)clientData;
+  sqlite4_pool *pPool = 0;
+  char zBuf[50];
+  int rc = SQLITE4_OK;
+
+  if( strcmp(zCmd, "open")==0 ){
+    int nConn;
+    if( objc!=3 ){
+      Tcl_WrongNumArgs(interp, 1, objv, "URI NCONN");
+      return TCL_ERROR;
+    }
+    if( Tcl_GetIntFromObj(interp, objv[2], &nConn) ) return TCL_ERROR;
+    rc = sqlite4_pool_open(0, Tcl_GetString(objv[1]), nConn, &pPool);
+    if( rc==SQLITE4_OK ){
+      if( sqlite4TestMakePointerStr(interp, zBuf, pPool) ) return TCL_ERROR;
+      Tcl_SetResult(interp, zBuf, TCL_VOLATILE);
+      return TCL_OK;
+    }
+  }else if( strcmp(zCmd, "stmt")==0 ){
+    sqlite4 *db;
+    sqlite4_stmt *pStmt;
+    int iStmt;
+    if( objc!=3 ){
+      Tcl_WrongNumArgs(interp, 1, objv, "DB ISTMT");
+      return TCL_ERROR;
+    }
+    if( getDbPointer(interp, Tcl_GetString(objv[1]), &db) ) return TCL_ERROR;
+    if( Tcl_GetIntFromObj(interp, objv[2], &iStmt) ) return TCL_ERROR;
+    pStmt = sqlite4_pool_stmt(db, iStmt);
+    if( pStmt ){
+      if( sqlite4TestMakePointerStr(interp, zBuf, pStmt) ) return TCL_ERROR;
+      Tcl_SetResult(interp, zBuf, TCL_VOLATILE);
+    }
+    return TCL_OK;
+  }else{
+    if( objc<2 ){
+      Tcl_WrongNumArgs(interp, 1, objv, "POOL ...");
+      return TCL_ERROR;
+    }
+    pPool = (sqlite4_pool *)sqlite4TestTextToPtr(Tcl_GetString(objv[1]));
+
+    if( strcmp(zCmd, "prepare")==0 ){
+      int iStmt;
+      if( objc!=3 ){
+        Tcl_WrongNumArgs(interp, 1, objv, "POOL SQL");
+        return TCL_ERROR;
+      }
+      rc = sqlite4_pool_prepare(pPool, Tcl_GetString(objv[2]), &iStmt);
+      if( rc==SQLITE4_OK ){
+        Tcl_SetObjResult(interp, Tcl_NewIntObj(iStmt));
+        return TCL_OK;
+      }
+    }else if( strcmp(zCmd, "checkout")==0 ){
+      sqlite4 *db;
+      if( objc!=2 ){
+        Tcl_WrongNumArgs(interp, 1, objv, "POOL");
+        return TCL_ERROR;
+      }
+      rc = sqlite4_pool_checkout(pPool, &db);
+      if( rc==SQLITE4_OK ){
+        if( sqlite4TestMakePointerStr(interp, zBuf, db) ) return TCL_ERROR;
+        Tcl_SetResult(interp, zBuf, TCL_VOLATILE);
+        return TCL_OK;
+      }
+    }else if( strcmp(zCmd, "checkin")==0 ){
+      sqlite4 *db;
+      if( objc!=3 ){
+        Tcl_WrongNumArgs(interp, 1, objv, "POOL DB");
+        return TCL_ERROR;
+      }
+      if( getDbPointer(interp, Tcl_GetString(objv[2]), &db) ) return TCL_ERROR;
+      rc = sqlite4_pool_checkin(pPool, db);
+      Tcl_SetResult(interp, (char *)t1ErrorName(rc), 0);
+      return TCL_OK;
+    }else if( strcmp(zCmd, "status")==0 ){
+      static const char *azOp[] = {
+        "IDLE", "INUSE", "CHECKOUT", "MISS", "RESET", 0
+      };
+      int aOp[] = {
+        SQLITE4_POOLSTATUS_IDLE, SQLITE4_POOLSTATUS_INUSE,
+        SQLITE4_POOLSTATUS_CHECKOUT, SQLITE4_POOLSTATUS_MISS,
+        SQLITE4_POOLSTATUS_RESET
+      };
+      int iOp;
+      int bReset;
+      int iCur = 0;
+      int iHiwtr = 0;
+      Tcl_Obj *pRet;
+      if( objc!=4 ){
+        Tcl_WrongNumArgs(interp, 1, objv, "POOL OP RESETFLAG");
+        return TCL_ERROR;
+      }
+      if( Tcl_GetIndexFromObj(interp, objv[2], azOp, "op", 0, &iOp) ){
+        return TCL_ERROR;
+      }
+      if( Tcl_GetBooleanFromObj(interp, objv[3], &bReset) ) return TCL_ERROR;
+      rc = sqlite4_pool_status(pPool, aOp[iOp], &iCur, &iHiwtr, bReset);
+      if( rc==SQLITE4_OK ){
+        pRet = Tcl_NewObj();
+        Tcl_ListObjAppendElement(interp, pRet, Tcl_NewIntObj(iCur));
+        Tcl_ListObjAppendElement(interp, pRet, Tcl_NewIntObj(iHiwtr));
+        Tcl_SetObjResult(interp, pRet);
+        return TCL_OK;
+      }
+    }else{
+      assert( strcmp(zCmd, "close")==0 );
+      if( objc!=2 ){
+        Tcl_WrongNumArgs(interp, 1, objv, "POOL");
+        return TCL_ERROR;
+      }
+      rc = sqlite4_pool_close(pPool);
+      Tcl_SetResult(interp, (char *)t1ErrorName(rc), 0);
+      return TCL_OK;
+    }
+  }
+
+  Tcl_SetResult(interp, (char *)t1ErrorName(rc), 0);
+  return TCL_ERROR;
+}
+
+/*
+** Batch buffers of a job submitted by [sqlite4_async_submit]. A pointer
+** to this object is the job's xBatch argument.
+*/
+typedef struct AsyncTestBuf AsyncTestBuf;
+struct AsyncTestBuf {
+  int nCol;
+  sqlite4_batch_column *aCol;
+};
+
+static void asyncTestBufFree(AsyncTestBuf *p){
+  int i;
+  for(i=0; i<p->nCol; i++){
+    ckfree((char *)p->aCol[i].aType);
+    ckfree((char *)p->aCol[i].aInt);
+    ckfree((char *)p->aCol[i].aReal);
+    ckfree((char *)p->aCol[i].aOffset);
+    ckfree(p->aCol[i].aData);
+  }
+  ckfree((char *)p->aCol);
+  ckfree((char *)p);
+}
+
+/*
+** Usage: sqlite4_async_queue_open
+**        sqlite4_async_queue_close QUEUE
+**        sqlite4_async_submit STMT NROW QUEUE
+**        sqlite4_async_poll QUEUE WAIT
+**        sqlite4_async_result JOB
+**        sqlite4_async_next JOB
+**        sqlite4_async_finish JOB
+**
+** Test the sqlite4_async_*() interfaces using a completion queue of the
+** default environment. Queues and jobs are identified by pointer strings.
+** sqlite4_async_queue_open and sqlite4_async_submit return the new object
+** and throw an error if the call fails. sqlite4_async_poll returns a job,
+** or an empty string if no batch is ready. sqlite4_async_result returns
+** the name of the result code of the most recent batch followed by the
+** integer value of the first column of each row in it. Other commands
+** return the name of the result code.
+*/
+static int test_async(
+  void * clientData,
+  Tcl_Interp *interp,
+  int objc,
+  Tcl_Obj *CONST objv[]
+){
+  const char *zCmd = (const char *)clientData;
+  sqlite4_async_queue *pQueue;
+  sqlite4_async *pJob;
+  char zBuf[50];
+  int rc = SQLITE4_OK;
+
+  if( strcmp(zCmd, "queue_open")==0 ){
+    if( objc!=1 ){
+      Tcl_WrongNumArgs(interp, 1, objv, "");
+      return TCL_ERROR;
+    }
+    rc = sqlite4_async_queue_open(0, &pQueue);
+    if( rc==SQLITE4_OK ){
+      if( sqlite4TestMakePointerStr(interp, zBuf, pQueue) ) return TCL_ERROR;
+      Tcl_SetResult(interp, zBuf, TCL_VOLATILE);
+      return TCL_OK;
+    }
+  }else if( strcmp(zCmd, "submit")==0 ){
+    sqlite4_stmt *pStmt;
+    AsyncTestBuf *pBuf;
+    int nRow;
+    int i;
+    if( objc!=4 ){
+      Tcl_WrongNumArgs(interp, 1, objv, "STMT NROW QUEUE");
+      return TCL_ERROR;
+    }
+    if( getStmtPointer(interp, Tcl_GetString(objv[1]), &pStmt) ){
+      return TCL_ERROR;
+    }
+    if( Tcl_GetIntFromObj(interp, objv[2], &nRow) ) return TCL_ERROR;
+    pQueue = (sqlite4_async_queue *)sqlite4TestTextToPtr(
+        Tcl_GetString(objv[3])
+    );
+
+    pBuf = (AsyncTestBuf *)ckalloc(sizeof(AsyncTestBuf));
+    pBuf->nCol = sqlite4_column_count(pStmt);
+    pBuf->aCol = (sqlite4_batch_column *)ckalloc(
+        sizeof(sqlite4_batch_column)*(pBuf->nCol+1)
+    );
+    memset(pBuf->aCol, 0, sizeof(sqlite4_batch_column)*(pBuf->nCol+1));
+    for(i=0; i<pBuf->nCol; i++){
+      sqlite4_batch_column *p = &pBuf->aCol[i];
+      p->aType = (unsigned char *)ckalloc(nRow+1);
+      p->aInt = (sqlite4_int64 *)ckalloc(sizeof(sqlite4_int64)*(nRow+1));
+      p->aReal = (double *)ckalloc(sizeof(double)*(nRow+1));
+      p->aOffset = (int *)ckalloc(sizeof(int)*(nRow+1));
+      p->aData = (char *)ckalloc(1001);
+      p->nData = 1000;
+    }
+
+    rc = sqlite4_async_submit(
+        pStmt, nRow, pBuf->nCol, pBuf->aCol, 0, (void *)pBuf, pQueue, &pJob
+    );
+    if( rc==SQLITE4_OK ){
+      if( sqlite4TestMakePointerStr(interp, zBuf, pJob) ) return TCL_ERROR;
+      Tcl_SetResult(interp, zBuf, TCL_VOLATILE);
+      return TCL_OK;
+    }
+    asyncTestBufFree(pBuf);
+  }else if( strcmp(zCmd, "poll")==0 ){
+    int bWait;
+    if( objc!=3 ){
+      Tcl_WrongNumArgs(interp, 1, objv, "QUEUE WAIT");
+      return TCL_ERROR;
+    }
+    pQueue = (sqlite4_async_queue *)sqlite4TestTextToPtr(
+        Tcl_GetString(objv[1])
+    );
+    if( Tcl_GetBooleanFromObj(interp, objv[2], &bWait) ) return TCL_ERROR;
+    pJob = sqlite4_async_poll(pQueue, bWait);
+    if( pJob ){
+      if( sqlite4TestMakePointerStr(interp, zBuf, pJob) ) return TCL_ERROR;
+      Tcl_SetResult(interp, zBuf, TCL_VOLATILE);
+    }
+    return TCL_OK;
+  }else{
+    if( objc!=2 ){
+      Tcl_WrongNumArgs(interp, 1, objv,
+          strcmp(zCmd, "queue_close")==0 ? "QUEUE" : "JOB"
+      );
+      return TCL_ERROR;
+    }
+    pJob = (sqlite4_async *)sqlite4TestTextToPtr(Tcl_GetString(objv[1]));
+
+    if( strcmp(zCmd, "queue_close")==0 ){
+      pQueue = (sqlite4_async_queue *)pJob;
+      rc = sqlite4_async_queue_close(pQueue);
+    }else if( strcmp(zCmd, "result")==0 ){
+      AsyncTestBuf *pBuf;
+      Tcl_Obj *pRet;
+      int nOut;
+      int j;
+      rc = sqlite4_async_result(pJob, &nOut, (void **)&pBuf);
+      pRet = Tcl_NewObj();
+      Tcl_ListObjAppendElement(interp, pRet,
+          Tcl_NewStringObj(t1ErrorName(rc), -1)
+      );
+      for(j=0; j<nOut && pBuf->nCol>0; j++){
+        Tcl_ListObjAppendElement(interp, pRet,
+            Tcl_NewWideIntObj(pBuf->aCol[0].aInt[j])
+        );
+      }
+      Tcl_SetObjResult(interp, pRet);
+      return TCL_OK;
+    }else if( strcmp(zCmd, "next")==0 ){
+      rc = sqlite4_async_next(pJob);
+    }else{
+      AsyncTestBuf *pBuf;
+      assert( strcmp(zCmd, "finish")==0 );
+      sqlite4_async_result(pJob, 0, (void **)&pBuf);
+      rc = sqlite4_async_finish(pJob);
+      asyncTestBufFree(pBuf);
+    }
+    Tcl_SetResult(interp, (char *)t1ErrorName(rc), 0);
+    return TCL_OK;
+  }
+
+  Tcl_SetResult(interp, (char *)t1ErrorName(rc), 0);
+  return TCL_ERROR;
+}
+
 static int test_stmt_sql(
   void * clientData,
   Tcl_Interp *interp,
@@ -3646,10 +4121,12 @@ static int test_limit(
     { "SQLITE4_LIMIT_LIKE_PATTERN_LENGTH", SQLITE4_LIMIT_LIKE_PATTERN_LENGTH  },
     { "SQLITE4_LIMIT_VARIABLE_NUMBER",     SQLITE4_LIMIT_VARIABLE_NUMBER      },
     { "SQLITE4_LIMIT_TRIGGER_DEPTH",       SQLITE4_LIMIT_TRIGGER_DEPTH        },
+    { "SQLITE4_LIMIT_WORKER_THREADS",      SQLITE4_LIMIT_WORKER_THREADS       },
+    { "SQLITE4_LIMIT_SORTER_SIZE",         SQLITE4_LIMIT_SORTER_SIZE          },
     
     /* Out of range test cases */
     { "SQLITE4_LIMIT_TOOSMALL",            -1,                               },
-    { "SQLITE4_LIMIT_TOOBIG",              SQLITE4_LIMIT_TRIGGER_DEPTH+1      },
+    { "SQLITE4_LIMIT_TOOBIG",              SQLITE4_LIMIT_SORTER_SIZE+1        },
   };
   int i, id;
   int val;
@@ -3678,6 +4155,226 @@ static int test_limit(
   return TCL_OK;  
 }
 
+/*
+** tclcmd:   sqlite4_db_config DB OPTION VALUE
+**
+** Set an integer option of database connection DB using sqlite4_db_config()
+** and return its new value. If VALUE is negative the option is left
+** unchanged. OPTION is LOCK_RETRY, LOCK_BACKOFF or SEEK_BATCH.
+*/
+static int test_db_config(
+  ClientData clientData, /* Unused */
+  Tcl_Interp *interp,    /* The TCL interpreter that invoked this command */
+  int objc,              /* Number of arguments */
+  Tcl_Obj *CONST objv[]  /* Command arguments */
+){
+  sqlite4 *db;
+  int rc;
+  static const struct {
+     char *zName;
+     int op;
+  } aOp[] = {
+    { "LOCK_RETRY",   SQLITE4_DBCONFIG_LOCK_RETRY   },
+    { "LOCK_BACKOFF", SQLITE4_DBCONFIG_LOCK_BACKOFF },
+    { "SEEK_BATCH",   SQLITE4_DBCONFIG_SEEK_BATCH   },
+  };
+  int i, op;
+  int val;
+  int res = 0;
+  const char *zOp;
+
+  if( objc!=4 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "DB OPTION VALUE");
+    return TCL_ERROR;
+  }
+  if( getDbPointer(interp, Tcl_GetString(objv[1]), &db) ) return TCL_ERROR;
+  zOp = Tcl_GetString(objv[2]);
+  if( strncmp(zOp, "SQLITE4_DBCONFIG_", 17)==0 ) zOp += 17;
+  for(i=0; i<sizeof(aOp)/sizeof(aOp[0]); i++){
+    if( strcmp(zOp, aOp[i].zName)==0 ){
+      op = aOp[i].op;
+      break;
+    }
+  }
+  if( i>=sizeof(aOp)/sizeof(aOp[0]) ){
+    Tcl_AppendResult(interp, "unknown option: ", zOp, (char*)0);
+    return TCL_ERROR;
+  }
+  if( Tcl_GetIntFromObj(interp, objv[3], &val) ) return TCL_ERROR;
+  rc = sqlite4_db_config(db, op, val, &res);
+  if( rc!=SQLITE4_OK ){
+    Tcl_SetResult(interp, (char *)t1ErrorName(rc), TCL_STATIC);
+    return TCL_ERROR;
+  }
+  Tcl_SetObjResult(interp, Tcl_NewIntObj(res));
+  return TCL_OK;
+}
+
+/*
+** tclcmd:   sqlite4_kvstore_map_write DB FILENAME
+**
+** Write the content of the main database of DB to file FILENAME in the
+** format read by the "map" storage engine, using SQLITE4_KVCTRL_MAP_WRITE.
+** Return the name of the result code.
+*/
+static int test_kvstore_map_write(
+  ClientData clientData, /* Unused */
+  Tcl_Interp *interp,    /* The TCL interpreter that invoked this command */
+  int objc,              /* Number of arguments */
+  Tcl_Obj *CONST objv[]  /* Command arguments */
+){
+  sqlite4 *db;
+  int rc;
+
+  if( objc!=3 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "DB FILENAME");
+    return TCL_ERROR;
+  }
+  if( getDbPointer(interp, Tcl_GetString(objv[1]), &db) ) return TCL_ERROR;
+  rc = sqlite4_kvstore_control(
+      db, "main", SQLITE4_KVCTRL_MAP_WRITE, (void*)Tcl_GetString(objv[2])
+  );
+  Tcl_SetResult(interp, (char *)t1ErrorName(rc), TCL_STATIC);
+  return TCL_OK;
+}
+
+/*
+** tclcmd:   sqlite4_kvstore_snapshot DB
+**
+** Invoke SQLITE4_KVCTRL_SNAPSHOT on the main database of DB. Return the
+** name of the result code.
+*/
+static int test_kvstore_snapshot(
+  ClientData clientData, /* Unused */
+  Tcl_Interp *interp,    /* The TCL interpreter that invoked this command */
+  int objc,              /* Number of arguments */
+  Tcl_Obj *CONST objv[]  /* Command arguments */
+){
+  sqlite4 *db;
+  int rc;
+
+  if( objc!=2 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "DB");
+    return TCL_ERROR;
+  }
+  if( getDbPointer(interp, Tcl_GetString(objv[1]), &db) ) return TCL_ERROR;
+  rc = sqlite4_kvstore_control(db, "main", SQLITE4_KVCTRL_SNAPSHOT, 0);
+  Tcl_SetResult(interp, (char *)t1ErrorName(rc), TCL_STATIC);
+  return TCL_OK;
+}
+
+/*
+** tclcmd:   sqlite4_rowset DB SCRIPT
+**
+** Create a RowSet, run the commands in list SCRIPT against it, then
+** delete it. Each key is a table number followed by the key encoding of
+** an integer, as for a table with an INTEGER PRIMARY KEY. The commands
+** are:
+**
+**   insert TAB INT ?N? ?STEP?
+**       Insert the keys for integers INT, INT+STEP, ... (N in all, default
+**       1) in table number TAB.
+**
+**   test BATCH TAB INT ?N? ?STEP?
+**       Test for each key, as for OP_RowSetTest, then insert it. Append
+**       the number of keys that were found to the result.
+**
+**   read ?N?
+**       Read and remove up to N keys (default all) in sorted order. Append
+**       the table number and integer of each to the result.
+*/
+static int test_rowset(
+  ClientData clientData, /* Unused */
+  Tcl_Interp *interp,    /* The TCL interpreter that invoked this command */
+  int objc,              /* Number of arguments */
+  Tcl_Obj *CONST objv[]  /* Command arguments */
+){
+  sqlite4 *db;
+  RowSet *pSet;
+  i64 aSpace[16];
+  Tcl_Obj **apCmd;
+  int nCmd;
+  Tcl_Obj *pRes;
+  int i;
+  int rc = TCL_OK;
+
+  if( objc!=3 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "DB SCRIPT");
+    return TCL_ERROR;
+  }
+  if( getDbPointer(interp, Tcl_GetString(objv[1]), &db) ) return TCL_ERROR;
+  if( Tcl_ListObjGetElements(interp, objv[2], &nCmd, &apCmd) ){
+    return TCL_ERROR;
+  }
+
+  pSet = sqlite4RowSetInit(db, aSpace, sizeof(aSpace));
+  pRes = Tcl_NewObj();
+  Tcl_IncrRefCount(pRes);
+  for(i=0; rc==TCL_OK && i<nCmd; ){
+    const char *zCmd = Tcl_GetString(apCmd[i++]);
+    if( strcmp(zCmd, "insert")==0 || strcmp(zCmd, "test")==0 ){
+      int bTest = (zCmd[0]=='t');
+      int nArg = 2 + bTest;
+      int iBatch = 0;
+      Tcl_WideInt iTab, iVal;
+      int n = 1;
+      int iStep = 1;
+      int nFound = 0;
+      int j;
+
+      if( i+nArg>nCmd
+       || (bTest && Tcl_GetIntFromObj(interp, apCmd[i++], &iBatch))
+       || Tcl_GetWideIntFromObj(interp, apCmd[i++], &iTab)
+       || Tcl_GetWideIntFromObj(interp, apCmd[i++], &iVal)
+      ){
+        rc = TCL_ERROR;
+        break;
+      }
+      if( i<nCmd && Tcl_GetIntFromObj(0, apCmd[i], &n)==TCL_OK ){
+        i++;
+        if( i<nCmd && Tcl_GetIntFromObj(0, apCmd[i], &iStep)==TCL_OK ) i++;
+      }
+      for(j=0; j<n; j++){
+        u8 aKey[32];
+        int nKey = sqlite4PutVarint64(aKey, (u64)iTab);
+        nKey += sqlite4VdbeEncodeIntKey(&aKey[nKey], iVal + (i64)j*iStep);
+        if( bTest ){
+          nFound += sqlite4RowSetTest(pSet, (u8)iBatch, aKey, nKey);
+        }
+        sqlite4RowSetInsert(pSet, aKey, nKey);
+      }
+      if( bTest ){
+        Tcl_ListObjAppendElement(interp, pRes, Tcl_NewIntObj(nFound));
+      }
+    }else if( strcmp(zCmd, "read")==0 ){
+      int n = -1;
+      const u8 *aKey;
+      int nKey;
+      if( i<nCmd && Tcl_GetIntFromObj(0, apCmd[i], &n)==TCL_OK ) i++;
+      while( n!=0 && (aKey = sqlite4RowSetRead(pSet, &nKey))!=0 ){
+        u64 iTab;
+        sqlite4_num num;
+        int nTab = sqlite4GetVarint64(aKey, nKey, &iTab);
+        sqlite4VdbeDecodeNumericKey(&aKey[nTab], nKey-nTab, &num);
+        Tcl_ListObjAppendElement(interp, pRes, Tcl_NewWideIntObj((Tcl_WideInt)iTab));
+        Tcl_ListObjAppendElement(interp, pRes,
+            Tcl_NewWideIntObj(sqlite4_num_to_int64(num, 0))
+        );
+        sqlite4RowSetNext(pSet);
+        if( n>0 ) n--;
+      }
+    }else{
+      Tcl_AppendResult(interp, "unknown rowset command: ", zCmd, (char*)0);
+      rc = TCL_ERROR;
+    }
+  }
+  sqlite4RowSetClear(pSet);
+
+  if( rc==TCL_OK ) Tcl_SetObjResult(interp, pRes);
+  Tcl_DecrRefCount(pRes);
+  return rc;
+}
+
 
 #ifdef SQLITE4_ENABLE_UNLOCK_NOTIFY
 static void test_unlock_notify_cb(void **aArg, int nArg){
@@ -4237,6 +4934,22 @@ int Sqlitetest1_Init(Tcl_Interp *interp){
      { "sqlite4_reset",                 test_reset         ,0 },
      { "sqlite4_changes",               test_changes       ,0 },
      { "sqlite4_step",                  test_step          ,0 },
+     { "sqlite4_step_batch",            test_step_batch    ,0 },
+     { "sqlite4_bulkload",              test_bulkload      ,0 },
+     { "sqlite4_pool_open",             test_pool, (void*)"open" },
+     { "sqlite4_pool_prepare",          test_pool, (void*)"prepare" },
+     { "sqlite4_pool_checkout",         test_pool, (void*)"checkout" },
+     { "sqlite4_pool_checkin",          test_pool, (void*)"checkin" },
+     { "sqlite4_pool_stmt",             test_pool, (void*)"stmt" },
+     { "sqlite4_pool_status",           test_pool, (void*)"status" },
+     { "sqlite4_pool_close",            test_pool, (void*)"close" },
+     { "sqlite4_async_queue_open",      test_async, (void*)"queue_open" },
+     { "sqlite4_async_queue_close",     test_async, (void*)"queue_close" },
+     { "sqlite4_async_submit",          test_async, (void*)"submit" },
+     { "sqlite4_async_poll",            test_async, (void*)"poll" },
+     { "sqlite4_async_result",          test_async, (void*)"result" },
+     { "sqlite4_async_next",            test_async, (void*)"next" },
+     { "sqlite4_async_finish",          test_async, (void*)"finish" },
      { "sqlite4_stmt_sql",              test_stmt_sql      ,0 },
      { "sqlite4_next_stmt",             test_next_stmt     ,0 },
      { "sqlite4_stmt_readonly",         test_stmt_readonly ,0 },
@@ -4246,6 +4959,10 @@ int Sqlitetest1_Init(Tcl_Interp *interp){
      { "sqlite4_db_release_memory",     test_db_release_memory,  0},
 
      { "sqlite4_limit",                 test_limit,                 0},
+     { "sqlite4_db_config",             test_db_config,             0},
+     { "sqlite4_kvstore_map_write",     test_kvstore_map_write,     0},
+     { "sqlite4_kvstore_snapshot",      test_kvstore_snapshot,      0},
+     { "sqlite4_rowset",                test_rowset,                0},
 
      { "optimization_control",          optimization_control,0},
 #if SQLITE4_OS_WIN
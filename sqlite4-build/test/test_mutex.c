@@ -312,15 +312,17 @@ static int test_alloc_mutex(
 }
 
 /*
-** sqlite4_env_config OPTION
+** sqlite4_env_config OPTION ?VALUE?
 **
 ** OPTION can be either one of the keywords:
 **
 **            SQLITE4_CONFIG_SINGLETHREAD
 **            SQLITE4_CONFIG_MULTITHREAD
 **            SQLITE4_CONFIG_SERIALIZED
+**            SQLITE4_ENVCONFIG_MUTEXPROF
 **
-** Or OPTION can be an raw integer.
+** Or OPTION can be an raw integer. If VALUE is present, it is passed to
+** sqlite4_env_config() as an integer argument.
 */
 static int test_config(
   void * clientData,
@@ -335,14 +337,19 @@ static int test_config(
     {"singlethread", SQLITE4_ENVCONFIG_SINGLETHREAD},
     {"multithread",  SQLITE4_ENVCONFIG_MULTITHREAD},
     {"serialized",   SQLITE4_ENVCONFIG_SERIALIZED},
+    {"mutexprof",    SQLITE4_ENVCONFIG_MUTEXPROF},
     {0, 0}
   };
   int s = sizeof(struct ConfigOption);
   int i;
+  int iVal = 0;
   int rc;
 
-  if( objc!=2 ){
-    Tcl_WrongNumArgs(interp, 1, objv, "");
+  if( objc!=2 && objc!=3 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "OPTION ?VALUE?");
+    return TCL_ERROR;
+  }
+  if( objc==3 && Tcl_GetIntFromObj(interp, objv[2], &iVal) ){
     return TCL_ERROR;
   }
 
@@ -354,11 +361,102 @@ static int test_config(
     i = aOpt[i].iValue;
   }
 
-  rc = sqlite4_env_config(0, i);
+  if( objc==3 ){
+    rc = sqlite4_env_config(0, i, iVal);
+  }else{
+    rc = sqlite4_env_config(0, i);
+  }
   Tcl_SetResult(interp, (char *)sqlite4TestErrorName(rc), TCL_VOLATILE);
   return TCL_OK;
 }
 
+/*
+** sqlite4_threadsafe
+**
+** Return the thread-safety setting of the default environment.
+*/
+static int test_threadsafe(
+  void * clientData,
+  Tcl_Interp *interp,
+  int objc,
+  Tcl_Obj *CONST objv[]
+){
+  if( objc!=1 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "");
+    return TCL_ERROR;
+  }
+  Tcl_SetObjResult(interp, Tcl_NewIntObj(sqlite4_threadsafe(0)));
+  return TCL_OK;
+}
+
+/*
+** sqlite4_env_mutex_status SITE ?RESET?
+**
+** Return the mutex profile of allocation site SITE of the default
+** environment as a list of names and values, suitable for [array set].
+** If sqlite4_env_mutex_status() fails, return the name of the error code
+** instead.
+*/
+static int test_env_mutex_status(
+  void * clientData,
+  Tcl_Interp *interp,
+  int objc,
+  Tcl_Obj *CONST objv[]
+){
+  sqlite4_mutex_status s;
+  Tcl_Obj *pRet;
+  Tcl_Obj *pWait;
+  Tcl_Obj *pHold;
+  int iSite;
+  int bReset = 0;
+  int rc;
+  int i;
+
+  if( objc!=2 && objc!=3 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "SITE ?RESET?");
+    return TCL_ERROR;
+  }
+  if( Tcl_GetIntFromObj(interp, objv[1], &iSite)
+   || (objc==3 && Tcl_GetBooleanFromObj(interp, objv[2], &bReset))
+  ){
+    return TCL_ERROR;
+  }
+
+  rc = sqlite4_env_mutex_status(0, iSite, &s, bReset);
+  if( rc!=SQLITE4_OK ){
+    Tcl_SetResult(interp, (char *)sqlite4TestErrorName(rc), TCL_VOLATILE);
+    return TCL_OK;
+  }
+
+  pWait = Tcl_NewObj();
+  pHold = Tcl_NewObj();
+  for(i=0; i<SQLITE4_MUTEX_NHIST; i++){
+    Tcl_ListObjAppendElement(interp, pWait, Tcl_NewWideIntObj(s.aWait[i]));
+    Tcl_ListObjAppendElement(interp, pHold, Tcl_NewWideIntObj(s.aHold[i]));
+  }
+
+  pRet = Tcl_NewObj();
+#define APPEND(zName, pObj) \
+  Tcl_ListObjAppendElement(interp, pRet, Tcl_NewStringObj(zName, -1)); \
+  Tcl_ListObjAppendElement(interp, pRet, pObj)
+  APPEND("tag", Tcl_NewStringObj(s.zTag ? s.zTag : "", -1));
+  APPEND("type", Tcl_NewStringObj(
+      s.eType==SQLITE4_MUTEX_FAST ? "fast" : "recursive", -1
+  ));
+  APPEND("nalloc", Tcl_NewIntObj(s.nAlloc));
+  APPEND("nlive", Tcl_NewIntObj(s.nLive));
+  APPEND("nenter", Tcl_NewWideIntObj(s.nEnter));
+  APPEND("ncontended", Tcl_NewWideIntObj(s.nContended));
+  APPEND("nbusy", Tcl_NewWideIntObj(s.nBusy));
+  APPEND("waitns", Tcl_NewWideIntObj(s.nWaitNs));
+  APPEND("holdns", Tcl_NewWideIntObj(s.nHoldNs));
+  APPEND("wait", pWait);
+  APPEND("hold", pHold);
+#undef APPEND
+  Tcl_SetObjResult(interp, pRet);
+  return TCL_OK;
+}
+
 static sqlite4 *getDbPointer(Tcl_Interp *pInterp, Tcl_Obj *pObj){
   sqlite4 *db;
   Tcl_CmdInfo info;
@@ -410,6 +508,27 @@ static int test_leave_db_mutex(
   return TCL_OK;
 }
 
+static int test_try_db_mutex(
+  void * clientData,
+  Tcl_Interp *interp,
+  int objc,
+  Tcl_Obj *CONST objv[]
+){
+  sqlite4 *db;
+  int rc;
+  if( objc!=2 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "DB");
+    return TCL_ERROR;
+  }
+  db = getDbPointer(interp, objv[1]);
+  if( !db ){
+    return TCL_ERROR;
+  }
+  rc = sqlite4_mutex_try(sqlite4_db_mutex(db));
+  Tcl_SetResult(interp, (char *)sqlite4TestErrorName(rc), TCL_VOLATILE);
+  return TCL_OK;
+}
+
 int Sqlitetest_mutex_Init(Tcl_Interp *interp){
   static struct {
     char *zName;
@@ -418,9 +537,12 @@ int Sqlitetest_mutex_Init(Tcl_Interp *interp){
     { "sqlite4_shutdown",        (Tcl_ObjCmdProc*)test_shutdown },
     { "sqlite4_initialize",      (Tcl_ObjCmdProc*)test_initialize },
     { "sqlite4_env_config",      (Tcl_ObjCmdProc*)test_config },
+    { "sqlite4_threadsafe",      (Tcl_ObjCmdProc*)test_threadsafe },
+    { "sqlite4_env_mutex_status",(Tcl_ObjCmdProc*)test_env_mutex_status },
 
     { "enter_db_mutex",          (Tcl_ObjCmdProc*)test_enter_db_mutex },
     { "leave_db_mutex",          (Tcl_ObjCmdProc*)test_leave_db_mutex },
+    { "try_db_mutex",            (Tcl_ObjCmdProc*)test_try_db_mutex },
 
     { "alloc_dealloc_mutex",     (Tcl_ObjCmdProc*)test_alloc_mutex },
     { "install_mutex_counters",  (Tcl_ObjCmdProc*)test_install_mutex_counters },
@@ -594,6 +594,376 @@ static int blocking_prepare_proc(
 ** End of implementation of [sqlite4_blocking_step].
 ************************************************************************/
 
+/*************************************************************************
+** Implementation of [sqlite4_mm_threadcache_test].
+**
+** The Tcl mutex and condition APIs are no-ops unless Tcl is built with
+** TCL_THREADS, so pthreads are used directly.
+*/
+#if SQLITE4_OS_UNIX
+#include <pthread.h>
+
+/*
+** State shared by the threads of one [sqlite4_mm_threadcache_test] run.
+*/
+typedef struct MmtcTest MmtcTest;
+struct MmtcTest {
+  sqlite4_mm *pMM;                /* SQLITE4_MM_THREADCACHE allocator */
+  sqlite4_mm *pStats;             /* Its SQLITE4_MM_STATS base, or NULL */
+  int nAlloc;                     /* Number of allocations per step */
+  int szAlloc;                    /* Size of each allocation */
+  void **apOld;                   /* Allocations made by the first thread */
+  void **apNew;                   /* Allocations made by the second thread */
+  int nSame;                      /* Entries of apNew[] also in apOld[] */
+  sqlite4_int64 nUnit;            /* Change in allocations from pStats */
+
+  /* Used by the "exit" test */
+  pthread_mutex_t mutex;          /* Protects eHold, aSwap[] and nError */
+  pthread_cond_t cond;            /* Signalled when eHold changes */
+  int eHold;                      /* 1 while holding a cache, 2 to release */
+
+  /* Used by the "stress" test */
+  void *aSwap[64];                /* Allocations passed between threads */
+  int nIter;                      /* Iterations per thread */
+  int nError;                     /* Corrupt or undersized allocations */
+};
+
+/*
+** Allocate p->nAlloc blocks of p->szAlloc bytes into apOut[].
+*/
+static void mmtcTestAlloc(MmtcTest *p, void **apOut){
+  int i;
+  for(i=0; i<p->nAlloc; i++){
+    apOut[i] = sqlite4_mm_malloc(p->pMM, p->szAlloc);
+  }
+}
+
+/*
+** Free all blocks in p->apOld[].
+*/
+static void mmtcTestFreeOld(MmtcTest *p){
+  int i;
+  for(i=0; i<p->nAlloc; i++){
+    sqlite4_mm_free(p->pMM, p->apOld[i]);
+  }
+}
+
+/*
+** Set p->nSame to the number of entries in p->apNew[] that are also in
+** p->apOld[].
+*/
+static void mmtcTestCompare(MmtcTest *p){
+  int i, j;
+  p->nSame = 0;
+  for(i=0; i<p->nAlloc; i++){
+    for(j=0; j<p->nAlloc; j++){
+      if( p->apNew[i]==p->apOld[j] ){
+        p->nSame++;
+        break;
+      }
+    }
+  }
+}
+
+static sqlite4_int64 mmtcTestUnits(MmtcTest *p){
+  return sqlite4_mm_stat(p->pStats, SQLITE4_MMSTAT_UNITS, 0);
+}
+
+static Tcl_ThreadCreateType mmtcTestFreeThread(ClientData pArg){
+  mmtcTestFreeOld((MmtcTest*)pArg);
+  TCL_THREAD_CREATE_RETURN;
+}
+
+static Tcl_ThreadCreateType mmtcTestAllocFreeThread(ClientData pArg){
+  MmtcTest *p = (MmtcTest*)pArg;
+  mmtcTestAlloc(p, p->apOld);
+  mmtcTestFreeOld(p);
+  TCL_THREAD_CREATE_RETURN;
+}
+
+/*
+** Return an allocation size in a different size class to p->szAlloc.
+*/
+static int mmtcTestOtherSize(MmtcTest *p){
+  return p->szAlloc>1000 ? 16 : 4000;
+}
+
+/*
+** Take the cache of the thread that last exited, then wait until told to
+** exit. This keeps blocks left in that cache away from other threads.
+*/
+static Tcl_ThreadCreateType mmtcTestHoldThread(ClientData pArg){
+  MmtcTest *p = (MmtcTest*)pArg;
+  sqlite4_mm_free(p->pMM, sqlite4_mm_malloc(p->pMM, mmtcTestOtherSize(p)));
+  pthread_mutex_lock(&p->mutex);
+  p->eHold = 1;
+  pthread_cond_broadcast(&p->cond);
+  while( p->eHold!=2 ) pthread_cond_wait(&p->cond, &p->mutex);
+  pthread_mutex_unlock(&p->mutex);
+  TCL_THREAD_CREATE_RETURN;
+}
+
+/*
+** Allocate p->apNew[] in a thread with a new cache. A block of another
+** size is allocated first, so that the cache and the chunk it is carved
+** from are not counted in p->nUnit.
+*/
+static Tcl_ThreadCreateType mmtcTestAllocNewThread(ClientData pArg){
+  MmtcTest *p = (MmtcTest*)pArg;
+  sqlite4_int64 nUnit;
+  sqlite4_mm_free(p->pMM, sqlite4_mm_malloc(p->pMM, mmtcTestOtherSize(p)));
+  nUnit = mmtcTestUnits(p);
+  mmtcTestAlloc(p, p->apNew);
+  p->nUnit = mmtcTestUnits(p) - nUnit;
+  TCL_THREAD_CREATE_RETURN;
+}
+
+/*
+** Run xProc in a new thread and wait for it to exit.
+*/
+static int mmtcTestRun(Tcl_ThreadCreateProc xProc, MmtcTest *p){
+  Tcl_ThreadId id;
+  int res;
+  if( Tcl_CreateThread(&id, xProc, (ClientData)p,
+        TCL_THREAD_STACK_DEFAULT, TCL_THREAD_JOINABLE)!=TCL_OK
+  ){
+    return TCL_ERROR;
+  }
+  return Tcl_JoinThread(id, &res);
+}
+
+/*
+** The "remote" test. This thread allocates blocks, then a second thread
+** frees them all, which puts them on the remote list of this thread's
+** cache. The blocks this thread allocates next must be the same ones,
+** taken back from the remote list without any new memory from pBase.
+*/
+static Tcl_ThreadCreateType mmtcTestRemoteThread(ClientData pArg){
+  MmtcTest *p = (MmtcTest*)pArg;
+  sqlite4_int64 nUnit;
+  mmtcTestAlloc(p, p->apOld);
+  if( mmtcTestRun(mmtcTestFreeThread, p)==TCL_OK ){
+    nUnit = mmtcTestUnits(p);
+    mmtcTestAlloc(p, p->apNew);
+    p->nUnit = mmtcTestUnits(p) - nUnit;
+    mmtcTestCompare(p);
+  }
+  for(nUnit=0; nUnit<p->nAlloc; nUnit++){
+    sqlite4_mm_free(p->pMM, p->apNew[nUnit]);
+  }
+  TCL_THREAD_CREATE_RETURN;
+}
+
+/*
+** Body of each thread of the "stress" test. Allocate blocks of assorted
+** sizes, some of them too large to be cached, and fill each with a byte
+** pattern. Most are freed by the same thread, the others are swapped
+** into p->aSwap[] and freed, or reallocated, by whichever thread takes
+** them out. Each block is checked before it is freed.
+*/
+static Tcl_ThreadCreateType mmtcTestStressThread(ClientData pArg){
+  MmtcTest *p = (MmtcTest*)pArg;
+  unsigned int iRand = (unsigned int)SQLITE4_PTR_TO_INT(&iRand);
+  void *apLocal[32];
+  int nError = 0;
+  int i;
+
+  memset(apLocal, 0, sizeof(apLocal));
+  for(i=0; i<p->nIter; i++){
+    int iSlot;
+    int sz;
+    u8 *pNew;
+    u8 *pOld;
+
+    iRand = iRand*1103515245 + 12345;
+    sz = (iRand>>8) % 600 + sizeof(int) + 1;
+    if( (iRand>>20)%64==0 ) sz = 40000 + sz;
+    pNew = (u8*)sqlite4_mm_malloc(p->pMM, sz);
+    if( pNew==0 ) continue;
+    if( sqlite4_mm_msize(p->pMM, pNew)<sz ) nError++;
+    memset(pNew, sz & 0xff, sz);
+    ((int*)pNew)[0] = sz;
+
+    iSlot = (iRand>>4) % (ArraySize(apLocal) + ArraySize(p->aSwap));
+    if( iSlot<ArraySize(apLocal) ){
+      pOld = (u8*)apLocal[iSlot];
+      apLocal[iSlot] = pNew;
+    }else{
+      iSlot -= ArraySize(apLocal);
+      pthread_mutex_lock(&p->mutex);
+      pOld = (u8*)p->aSwap[iSlot];
+      p->aSwap[iSlot] = pNew;
+      pthread_mutex_unlock(&p->mutex);
+    }
+
+    if( pOld ){
+      int szOld = ((int*)pOld)[0];
+      int j;
+      for(j=sizeof(int); j<szOld; j++){
+        if( pOld[j]!=(szOld & 0xff) ){
+          nError++;
+          break;
+        }
+      }
+      if( (iRand>>12)%4==0 ){
+        pOld = (u8*)sqlite4_mm_realloc(p->pMM, pOld, szOld*2);
+        if( pOld && pOld[szOld-1]!=(szOld & 0xff) ) nError++;
+      }
+      sqlite4_mm_free(p->pMM, pOld);
+    }
+  }
+  for(i=0; i<ArraySize(apLocal); i++){
+    sqlite4_mm_free(p->pMM, apLocal[i]);
+  }
+
+  pthread_mutex_lock(&p->mutex);
+  p->nError += nError;
+  pthread_mutex_unlock(&p->mutex);
+  TCL_THREAD_CREATE_RETURN;
+}
+
+/*
+** Usage: sqlite4_mm_threadcache_test remote N SIZE
+**        sqlite4_mm_threadcache_test exit N SIZE
+**        sqlite4_mm_threadcache_test stress NTHREAD NITER
+**
+** Test an SQLITE4_MM_THREADCACHE allocator, created for the purpose and
+** not used by the library, from several threads.
+**
+** "remote" allocates N blocks of SIZE bytes in one thread and frees them
+** in a second thread, so that they are put on the remote list of the
+** first thread's cache. The first thread then allocates N more.
+**
+** "exit" allocates and frees N blocks of SIZE bytes in a thread that then
+** exits, which returns them to the global pool. A second thread takes the
+** exited thread's cache and holds it while a third allocates N more.
+**
+** For both, the result is the number of the second set of blocks that
+** were also in the first, followed by the number of allocations made
+** from the underlying allocator while the second set was allocated.
+**
+** "stress" runs NTHREAD threads of NITER iterations each, passing blocks
+** between them at random. The result is the number of corrupt or
+** undersized blocks found.
+*/
+static int sqlite4_mm_threadcache_test(
+  ClientData clientData,
+  Tcl_Interp *interp,
+  int objc,
+  Tcl_Obj *CONST objv[]
+){
+  const char *azTest[] = { "remote", "exit", "stress", 0 };
+  MmtcTest t;
+  int iTest;
+  int nArg1, nArg2;
+  int rc = TCL_OK;
+  int i;
+
+  if( objc!=4 ){
+    Tcl_WrongNumArgs(interp, 1, objv, "TEST N SIZE");
+    return TCL_ERROR;
+  }
+  if( Tcl_GetIndexFromObj(interp, objv[1], azTest, "test", 0, &iTest)
+   || Tcl_GetIntFromObj(interp, objv[2], &nArg1)
+   || Tcl_GetIntFromObj(interp, objv[3], &nArg2)
+  ){
+    return TCL_ERROR;
+  }
+
+  memset(&t, 0, sizeof(t));
+  if( iTest==2 ){
+    t.pMM = sqlite4_mm_new(SQLITE4_MM_THREADCACHE, (sqlite4_mm*)0);
+  }else{
+    t.pStats = sqlite4_mm_new(SQLITE4_MM_STATS, sqlite4_mm_new(SQLITE4_MM_SYSTEM));
+    t.pMM = sqlite4_mm_new(SQLITE4_MM_THREADCACHE, t.pStats);
+    t.nAlloc = nArg1;
+    t.szAlloc = nArg2;
+    t.apOld = (void**)ckalloc(sizeof(void*)*nArg1*2);
+    t.apNew = &t.apOld[nArg1];
+  }
+  if( t.pMM==0 ){
+    Tcl_AppendResult(interp, "failed to create allocator", (char*)0);
+    return TCL_ERROR;
+  }
+  pthread_mutex_init(&t.mutex, 0);
+  pthread_cond_init(&t.cond, 0);
+
+  switch( iTest ){
+    case 0:       /* remote */
+      rc = mmtcTestRun(mmtcTestRemoteThread, &t);
+      break;
+
+    case 1: {     /* exit */
+      Tcl_ThreadId idHold;
+      rc = mmtcTestRun(mmtcTestAllocFreeThread, &t);
+      if( rc==TCL_OK ){
+        rc = Tcl_CreateThread(&idHold, mmtcTestHoldThread, (ClientData)&t,
+            TCL_THREAD_STACK_DEFAULT, TCL_THREAD_JOINABLE);
+      }
+      if( rc==TCL_OK ){
+        int res;
+        pthread_mutex_lock(&t.mutex);
+        while( t.eHold!=1 ) pthread_cond_wait(&t.cond, &t.mutex);
+        pthread_mutex_unlock(&t.mutex);
+        rc = mmtcTestRun(mmtcTestAllocNewThread, &t);
+        pthread_mutex_lock(&t.mutex);
+        t.eHold = 2;
+        pthread_cond_broadcast(&t.cond);
+        pthread_mutex_unlock(&t.mutex);
+        Tcl_JoinThread(idHold, &res);
+      }
+      if( rc==TCL_OK ){
+        mmtcTestCompare(&t);
+        /* The blocks in apNew[] belong to the cache of a thread that has
+        ** exited. Free them from a thread that will also exit. */
+        memcpy(t.apOld, t.apNew, sizeof(void*)*t.nAlloc);
+        rc = mmtcTestRun(mmtcTestFreeThread, &t);
+      }
+      break;
+    }
+
+    case 2: {     /* stress */
+      Tcl_ThreadId aId[16];
+      int nThread = nArg1<ArraySize(aId) ? nArg1 : ArraySize(aId);
+      t.nIter = nArg2;
+      for(i=0; i<nThread; i++){
+        if( Tcl_CreateThread(&aId[i], mmtcTestStressThread, (ClientData)&t,
+              TCL_THREAD_STACK_DEFAULT, TCL_THREAD_JOINABLE)!=TCL_OK
+        ){
+          break;
+        }
+      }
+      nThread = i;
+      for(i=0; i<nThread; i++){
+        int res;
+        Tcl_JoinThread(aId[i], &res);
+      }
+      for(i=0; i<ArraySize(t.aSwap); i++){
+        sqlite4_mm_free(t.pMM, t.aSwap[i]);
+      }
+      break;
+    }
+  }
+  pthread_cond_destroy(&t.cond);
+  pthread_mutex_destroy(&t.mutex);
+
+  if( rc!=TCL_OK ){
+    Tcl_AppendResult(interp, "failed to run thread", (char*)0);
+  }else if( iTest==2 ){
+    Tcl_SetObjResult(interp, Tcl_NewIntObj(t.nError));
+  }else{
+    Tcl_Obj *pRes = Tcl_NewObj();
+    Tcl_ListObjAppendElement(interp, pRes, Tcl_NewIntObj(t.nSame));
+    Tcl_ListObjAppendElement(interp, pRes, Tcl_NewWideIntObj(t.nUnit));
+    Tcl_SetObjResult(interp, pRes);
+  }
+
+  sqlite4_mm_destroy(t.pMM);
+  if( t.apOld ) ckfree((char*)t.apOld);
+  return rc;
+}
+#endif /* SQLITE4_OS_UNIX */
+
 /*
 ** Register commands with the TCL interpreter.
 */
@@ -606,6 +976,10 @@ int SqlitetestThread_Init(Tcl_Interp *interp){
       "sqlite4_blocking_prepare", blocking_prepare_proc, (void *)1, 0);
   Tcl_CreateObjCommand(interp, 
       "sqlite4_nonblocking_prepare", blocking_prepare_proc, 0, 0);
+#endif
+#if SQLITE4_OS_UNIX
+  Tcl_CreateObjCommand(interp, 
+      "sqlite4_mm_threadcache_test", sqlite4_mm_threadcache_test, 0, 0);
 #endif
   return TCL_OK;
 }
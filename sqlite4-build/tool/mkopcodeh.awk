@@ -31,6 +31,14 @@
 # properties apply to that opcode.  Set corresponding flags using the
 # OPFLG_INITIALIZER macro.
 #
+# Finally, an OPCODE_LABEL_INITIALIZER macro is generated for builds that
+# use computed-goto dispatch in sqlite4VdbeExec().  It lists, in opcode
+# order, the address of the label "vdbe_op_aaaa" that vdbe.c places in
+# front of each "case OP_aaaa:" line.  Opcodes whose case lies within an
+# #if block of vdbe.c, and unused opcode values, are given the label
+# "vdbe_op_switch" instead so that they are dispatched through the
+# switch statement.
+#
 
 
 # Remember the TK_ values from the parse.h file
@@ -38,6 +46,14 @@
   tk[$2] = 0+$3
 }
 
+# Track the depth of #if blocks in the vdbe.c file
+/^# *if/ {
+  depth++
+}
+/^# *endif/ {
+  depth--
+}
+
 # Scan for "case OP_aaaa:" lines in the vdbe.c file
 /^case OP_/ {
   name = $2
@@ -51,6 +67,7 @@
   in3[name] = 0
   out2[name] = 0
   out3[name] = 0
+  cond[name] = depth
   for(i=3; i<NF; i++){
     if($i=="same" && $(i+1)=="as"){
       sym = $(i+2)
@@ -87,8 +104,10 @@ END {
   print "/* Automatically generated.  Do not edit */"
   print "/* See the mkopcodeh.awk script for details */"
   op["OP_Noop"] = -1;
+  cond["OP_Noop"] = 1;
   order[n_op++] = "OP_Noop";
   op["OP_Explain"] = -1;
+  cond["OP_Explain"] = 1;
   order[n_op++] = "OP_Explain";
   for(i=0; i<n_op; i++){
     name = order[i];
@@ -124,9 +143,14 @@ END {
   #  bit 2:     output to p1.  release p1 before opcode runs
   #
   for(i=0; i<=max; i++) bv[i] = 0;
+  for(i=0; i<=max; i++) lbl[i] = "vdbe_op_switch";
   for(i=0; i<n_op; i++){
     name = order[i];
     x = op[name]
+    if( !cond[name] ){
+      lbl[x] = name
+      sub("OP_","vdbe_op_",lbl[x])
+    }
     a0 = a1 = a2 = a3 = a4 = a5 = a6 = a7 = 0
     # a7 = a9 = a10 = a11 = a12 = a13 = a14 = a15 = 0
     if( jump[name] ) a0 = 1;
@@ -158,4 +182,11 @@ END {
     if( i%8==7 ) printf("\\\n");
   }
   print "}"
+  print ""
+  print "/* Labels in sqlite4VdbeExec() for computed-goto dispatch */"
+  print "#define OPCODE_LABEL_INITIALIZER {\\"
+  for(i=0; i<=max; i++){
+    printf "  &&%s,\\\n", lbl[i]
+  }
+  print "}"
 }
@@ -226,9 +226,12 @@ foreach file {
    mem2.c
    mem3.c
    mem5.c
+   mem6.c
    mutex.c
    mutex_noop.c
+   mutex_prof.c
    mutex_w32.c
+   threads.c
    malloc.c
    printf.c
    random.c
@@ -244,9 +247,11 @@ foreach file {
 
    vdbemem.c
    vdbeaux.c
+   vdbeagg.c
    vdbeapi.c
    vdbecodec.c
    vdbecursor.c
+   vdbesort.c
    vdbetrace.c
    vdbe.c
 
@@ -255,6 +260,7 @@ foreach file {
    expr.c
    alter.c
    analyze.c
+   async.c
    attach.c
    auth.c
    build.c
@@ -263,7 +269,11 @@ foreach file {
    func.c
    fkey.c
    insert.c
+   bulkload.c
+   kvmemlog.c
+   kvmap.c
    legacy.c
+   pool.c
    pragma.c
    prepare.c
    select.c
@@ -0,0 +1,254 @@
+/*
+** Asynchronous statement execution throughput test for SQLite.
+**
+** A number of connections (by default 16) are opened on in-memory
+** databases, each holding the same table of rows. Many short point
+** queries are then run against them, first synchronously from a single
+** thread using sqlite4_step(), and then by keeping one query in flight
+** on every connection using sqlite4_async_submit() and a completion
+** queue, as an event loop would. The asynchronous round is repeated for
+** each worker thread count in a list (by default 1, 2, 4 and 8).
+**
+** For each round the query rate and the median, 99th percentile and
+** maximum latency from submission to completion are reported.
+**
+** To compile, first build the library, then:
+**
+**     gcc -O2 speedtestasync.c libsqlite4.a -I. -lpthread -lm -ldl
+**
+** Then run:
+**
+**     ./a.out ?-threads N,N,...? ?-conns N? ?-queries N? ?-rows N?
+*/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include "sqlite4.h"
+
+static int nConn = 16;            /* Connections, one query in flight each */
+static int nQuery = 100000;       /* Queries per round */
+static int nRow = 1000;           /* Rows in each table */
+static sqlite4_env *pTemplate;    /* Uninitialized copy of default env */
+
+static double wallTime(void){
+#if defined(_MSC_VER)
+  LARGE_INTEGER f, t;
+  QueryPerformanceFrequency(&f);
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart / (double)f.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return (double)tv.tv_sec + (double)tv.tv_usec/1000000.0;
+#endif
+}
+
+/*
+** One connection and the query that runs on it.
+*/
+typedef struct Conn Conn;
+struct Conn {
+  sqlite4 *db;
+  sqlite4_stmt *pStmt;            /* SELECT b FROM t WHERE a=? */
+  sqlite4_int64 aVal[1];          /* Batch buffer */
+  sqlite4_batch_column col;       /* Batch column */
+  double tSubmit;                 /* Time the current query was submitted */
+};
+
+static int cmpDouble(const void *a, const void *b){
+  double x = *(const double*)a;
+  double y = *(const double*)b;
+  return x<y ? -1 : x>y;
+}
+
+static void report(const char *zRound, double tElapsed, double *aLatency){
+  qsort(aLatency, nQuery, sizeof(double), cmpDouble);
+  printf("%-10s queries=%-7d %9.0f queries/s"
+         "  p50=%7.1fus p99=%8.1fus max=%9.1fus\n",
+      zRound, nQuery, nQuery/tElapsed,
+      aLatency[nQuery/2]*1e6, aLatency[(int)(nQuery*0.99)]*1e6,
+      aLatency[nQuery-1]*1e6
+  );
+}
+
+static void fatal(const char *zMsg, int rc){
+  fprintf(stderr, "%s failed (%d)\n", zMsg, rc);
+  exit(1);
+}
+
+/*
+** Open and populate the connections.
+*/
+static Conn *openConns(sqlite4_env *pEnv){
+  Conn *aConn = (Conn*)calloc(nConn, sizeof(Conn));
+  int i, j;
+  for(i=0; i<nConn; i++){
+    Conn *p = &aConn[i];
+    sqlite4_stmt *pIns;
+    int rc = sqlite4_open(pEnv, "file:async?kv=temp", &p->db, 0);
+    if( rc ) fatal("sqlite4_open", rc);
+    rc = sqlite4_exec(p->db, "CREATE TABLE t(a PRIMARY KEY, b); BEGIN", 0, 0);
+    if( rc ) fatal("CREATE TABLE", rc);
+    sqlite4_prepare(p->db, "INSERT INTO t VALUES(?, ?)", -1, &pIns, 0);
+    for(j=0; j<nRow; j++){
+      sqlite4_bind_int(pIns, 1, j);
+      sqlite4_bind_int(pIns, 2, j*2);
+      sqlite4_step(pIns);
+      sqlite4_reset(pIns);
+    }
+    sqlite4_finalize(pIns);
+    sqlite4_exec(p->db, "COMMIT", 0, 0);
+    rc = sqlite4_prepare(p->db, "SELECT b FROM t WHERE a=?", -1, &p->pStmt, 0);
+    if( rc ) fatal("sqlite4_prepare", rc);
+    p->col.eType = SQLITE4_INTEGER;
+    p->col.aInt = p->aVal;
+  }
+  return aConn;
+}
+
+static void closeConns(Conn *aConn){
+  int i;
+  for(i=0; i<nConn; i++){
+    sqlite4_finalize(aConn[i].pStmt);
+    sqlite4_close(aConn[i].db, 0);
+  }
+  free(aConn);
+}
+
+/*
+** Run all queries synchronously on the calling thread.
+*/
+static void runSync(double *aLatency){
+  Conn *aConn = openConns(0);
+  double tStart = wallTime();
+  int i;
+  for(i=0; i<nQuery; i++){
+    Conn *p = &aConn[i % nConn];
+    double t = wallTime();
+    sqlite4_bind_int(p->pStmt, 1, i % nRow);
+    if( sqlite4_step(p->pStmt)!=SQLITE4_ROW ) fatal("sqlite4_step", 0);
+    sqlite4_reset(p->pStmt);
+    aLatency[i] = wallTime() - t;
+  }
+  report("sync", wallTime() - tStart, aLatency);
+  closeConns(aConn);
+}
+
+/*
+** Submit the next query on connection p.
+*/
+static void submitQuery(Conn *p, sqlite4_async_queue *pQueue, int iQuery){
+  sqlite4_async *pJob;
+  int rc;
+  sqlite4_bind_int(p->pStmt, 1, iQuery % nRow);
+  p->tSubmit = wallTime();
+  rc = sqlite4_async_submit(p->pStmt, 1, 1, &p->col, 0, p, pQueue, &pJob);
+  if( rc ) fatal("sqlite4_async_submit", rc);
+}
+
+/*
+** Run all queries using sqlite4_async_submit(), keeping one query in
+** flight on each connection.
+*/
+static void runAsync(int nThread, double *aLatency){
+  sqlite4_env *pEnv;
+  sqlite4_async_queue *pQueue;
+  sqlite4_async *pJob;
+  Conn *aConn;
+  double tStart;
+  int nSubmit = 0;
+  int nDone = 0;
+  char zRound[32];
+  int rc;
+
+  /* Worker threads are started on first use, so each round uses a
+  ** fresh environment. */
+  pEnv = (sqlite4_env*)malloc(sqlite4_env_size());
+  sqlite4_env_config(pEnv, SQLITE4_ENVCONFIG_INIT, pTemplate);
+  sqlite4_env_config(pEnv, SQLITE4_ENVCONFIG_ASYNCTHREADS, nThread);
+  aConn = openConns(pEnv);
+  rc = sqlite4_async_queue_open(pEnv, &pQueue);
+  if( rc ) fatal("sqlite4_async_queue_open", rc);
+
+  tStart = wallTime();
+  while( nSubmit<nConn && nSubmit<nQuery ){
+    submitQuery(&aConn[nSubmit], pQueue, nSubmit);
+    nSubmit++;
+  }
+  while( (pJob = sqlite4_async_poll(pQueue, 1))!=0 ){
+    Conn *p;
+    int nOut;
+    rc = sqlite4_async_result(pJob, &nOut, (void**)&p);
+    if( rc!=SQLITE4_ROW || nOut!=1 ) fatal("query", rc);
+    aLatency[nDone++] = wallTime() - p->tSubmit;
+    sqlite4_async_finish(pJob);
+    sqlite4_reset(p->pStmt);
+    if( nSubmit<nQuery ){
+      submitQuery(p, pQueue, nSubmit);
+      nSubmit++;
+    }
+  }
+  sprintf(zRound, "async/%d", nThread);
+  report(zRound, wallTime() - tStart, aLatency);
+
+  sqlite4_async_queue_close(pQueue);
+  closeConns(aConn);
+  sqlite4_shutdown(pEnv);
+  free(pEnv);
+}
+
+static void usage(const char *zArgv0){
+  fprintf(stderr,
+      "Usage: %s ?-threads N,N,...? ?-conns N? ?-queries N? ?-rows N?\n",
+      zArgv0
+  );
+  exit(1);
+}
+
+int main(int argc, char **argv){
+  const char *zThreads = "1,2,4,8";
+  const char *z;
+  double *aLatency;
+  int i;
+
+  for(i=1; i<argc; i++){
+    if( i+1>=argc ) usage(argv[0]);
+    if( strcmp(argv[i], "-threads")==0 ){
+      zThreads = argv[++i];
+    }else if( strcmp(argv[i], "-conns")==0 ){
+      nConn = atoi(argv[++i]);
+    }else if( strcmp(argv[i], "-queries")==0 ){
+      nQuery = atoi(argv[++i]);
+    }else if( strcmp(argv[i], "-rows")==0 ){
+      nRow = atoi(argv[++i]);
+    }else{
+      usage(argv[0]);
+    }
+  }
+  if( nConn<1 || nQuery<1 || nRow<1 ) usage(argv[0]);
+
+  /* The template must be copied before the default environment is
+  ** initialized by the first round. */
+  pTemplate = (sqlite4_env*)malloc(sqlite4_env_size());
+  sqlite4_env_config(pTemplate, SQLITE4_ENVCONFIG_INIT, sqlite4_env_default());
+
+  aLatency = (double*)calloc(nQuery, sizeof(double));
+  runSync(aLatency);
+  for(z=zThreads; *z; ){
+    int nThread = atoi(z);
+    if( nThread<0 ) usage(argv[0]);
+    runAsync(nThread, aLatency);
+    while( *z && *z!=',' ) z++;
+    if( *z==',' ) z++;
+  }
+  free(aLatency);
+  free(pTemplate);
+  return 0;
+}
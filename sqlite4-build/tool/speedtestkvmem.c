@@ -0,0 +1,174 @@
+/*
+** Durable in-memory store speed test for SQLite.
+**
+** A table is filled in a database opened on the in-memory storage engine
+** with the "durable=1" URI parameter, so that every commit is appended to
+** a write-ahead log. The insert rate is reported. The database is then
+** closed and reopened twice: first restoring its content by replaying the
+** whole log, and then, after SQLITE4_KVCTRL_SNAPSHOT has written a
+** snapshot, by loading the snapshot alone. The time taken by each reopen
+** is reported, and the row count is checked after each.
+**
+** The restart figures quoted for this feature were measured with
+** "-rows 10000000".
+**
+** To compile, first build the library, then:
+**
+**     gcc -O2 speedtestkvmem.c libsqlite4.a -I. -lpthread -lm -ldl
+**
+** Then run:
+**
+**     ./a.out ?-rows N? ?-batch N? ?-sync off|normal|full? FILENAME
+**
+** FILENAME-log and FILENAME-snap are created, replacing any existing files
+** of those names.
+*/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include "sqlite4.h"
+
+static int nRow = 1000000;        /* Rows inserted */
+static int nBatch = 1000;         /* Rows per transaction */
+
+static double wallTime(void){
+#if defined(_MSC_VER)
+  LARGE_INTEGER f, t;
+  QueryPerformanceFrequency(&f);
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart / (double)f.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return (double)tv.tv_sec + (double)tv.tv_usec/1000000.0;
+#endif
+}
+
+static void fatal(const char *zMsg, int rc){
+  fprintf(stderr, "%s failed (%d)\n", zMsg, rc);
+  exit(1);
+}
+
+static void usage(const char *zArgv0){
+  fprintf(stderr,
+      "Usage: %s ?-rows N? ?-batch N? ?-sync off|normal|full? FILENAME\n",
+      zArgv0
+  );
+  exit(1);
+}
+
+/*
+** Open the database, reporting the time taken.
+*/
+static sqlite4 *openDb(const char *zUri, const char *zLabel){
+  sqlite4 *db;
+  double t = wallTime();
+  int rc = sqlite4_open(0, zUri, &db, 0);
+  if( rc ) fatal("sqlite4_open", rc);
+  t = wallTime() - t;
+  printf("%-24s %8.3fs\n", zLabel, t);
+  return db;
+}
+
+/*
+** Check that the table holds the expected number of rows.
+*/
+static void checkCount(sqlite4 *db){
+  sqlite4_stmt *pStmt;
+  int rc = sqlite4_prepare(db, "SELECT count(*) FROM t", -1, &pStmt, 0);
+  if( rc ) fatal("sqlite4_prepare", rc);
+  if( sqlite4_step(pStmt)!=SQLITE4_ROW ) fatal("sqlite4_step", 0);
+  if( sqlite4_column_int(pStmt, 0)!=nRow ){
+    fprintf(stderr, "expected %d rows, found %d\n",
+        nRow, sqlite4_column_int(pStmt, 0)
+    );
+    exit(1);
+  }
+  sqlite4_finalize(pStmt);
+}
+
+int main(int argc, char **argv){
+  const char *zFile = 0;
+  const char *zSync = "normal";
+  char *zUri;
+  char *zName;
+  sqlite4 *db;
+  sqlite4_stmt *pStmt;
+  double t;
+  int i;
+  int rc;
+
+  for(i=1; i<argc; i++){
+    if( i+1>=argc ){
+      if( argv[i][0]=='-' || zFile ) usage(argv[0]);
+      zFile = argv[i];
+    }else if( strcmp(argv[i], "-rows")==0 ){
+      nRow = atoi(argv[++i]);
+    }else if( strcmp(argv[i], "-batch")==0 ){
+      nBatch = atoi(argv[++i]);
+    }else if( strcmp(argv[i], "-sync")==0 ){
+      zSync = argv[++i];
+    }else{
+      usage(argv[0]);
+    }
+  }
+  if( zFile==0 || nRow<1 || nBatch<1 ) usage(argv[0]);
+
+  zName = (char*)malloc(strlen(zFile) + 20);
+  sprintf(zName, "%s-log", zFile);
+  remove(zName);
+  sprintf(zName, "%s-snap", zFile);
+  remove(zName);
+  free(zName);
+
+  /* Automatic snapshots are turned off so that the first reopen replays
+  ** the whole log. */
+  zUri = (char*)malloc(strlen(zFile) + strlen(zSync) + 64);
+  sprintf(zUri, "file:%s?durable=1&snapshot=0&sync=%s", zFile, zSync);
+
+  db = openDb(zUri, "open (empty)");
+  rc = sqlite4_exec(db, "CREATE TABLE t(a PRIMARY KEY, b)", 0, 0);
+  if( rc ) fatal("CREATE TABLE", rc);
+  rc = sqlite4_prepare(db, "INSERT INTO t VALUES(?, ?)", -1, &pStmt, 0);
+  if( rc ) fatal("sqlite4_prepare", rc);
+  t = wallTime();
+  for(i=0; i<nRow; i++){
+    if( (i % nBatch)==0 ) sqlite4_exec(db, "BEGIN", 0, 0);
+    sqlite4_bind_int(pStmt, 1, i);
+    sqlite4_bind_text(pStmt, 2, "abcdefghijklmnopqrstuvwxyz", -1,
+                      SQLITE4_STATIC, 0);
+    sqlite4_step(pStmt);
+    rc = sqlite4_reset(pStmt);
+    if( rc ) fatal("INSERT", rc);
+    if( (i % nBatch)==nBatch-1 || i==nRow-1 ){
+      rc = sqlite4_exec(db, "COMMIT", 0, 0);
+      if( rc ) fatal("COMMIT", rc);
+    }
+  }
+  sqlite4_finalize(pStmt);
+  t = wallTime() - t;
+  printf("%-24s %8.3fs %12.0f rows/s\n", "insert", t, nRow/t);
+  sqlite4_close(db, 0);
+
+  db = openDb(zUri, "reopen (log replay)");
+  checkCount(db);
+  t = wallTime();
+  rc = sqlite4_kvstore_control(db, "main", SQLITE4_KVCTRL_SNAPSHOT, 0);
+  if( rc ) fatal("SQLITE4_KVCTRL_SNAPSHOT", rc);
+  printf("%-24s %8.3fs\n", "snapshot", wallTime() - t);
+  sqlite4_close(db, 0);
+
+  db = openDb(zUri, "reopen (snapshot)");
+  checkCount(db);
+  sqlite4_close(db, 0);
+
+  free(zUri);
+  return 0;
+}
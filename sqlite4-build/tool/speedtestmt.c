@@ -0,0 +1,259 @@
+/*
+** Multi-threaded memory allocator performance test for SQLite.
+**
+** Each of N threads opens its own in-memory database, INSERTs a number
+** of rows using bound parameters and then SELECTs them back several
+** times.  The whole run is timed once for the chosen sqlite4_mm
+** allocator, which is installed in the default environment before any
+** other SQLite call is made.  Allocators:
+**
+**     system       SQLITE4_MM_SYSTEM (the system malloc, as memsys1)
+**     serial       The system malloc behind a single global mutex.  This
+**                  stands in for the global-mutex heaps (memsys3 and
+**                  memsys5), which are not available as sqlite4_mm
+**                  objects.
+**     threadcache  SQLITE4_MM_THREADCACHE over SQLITE4_MM_SYSTEM
+**
+** To compile, first build the library, then:
+**
+**     gcc -O2 speedtestmt.c libsqlite4.a -I. -lpthread -lm -ldl
+**
+** Then run:
+**
+**     ./a.out ?-mm NAME? ?-threads N? ?-rows N? ?-select N?
+*/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#include <sys/time.h>
+#endif
+
+#include "sqlite4.h"
+
+static int nRow = 100000;         /* Rows inserted by each thread */
+static int nSelect = 5;           /* Number of SELECT passes per thread */
+
+/*
+** Portable mutex, thread and wall-clock helpers.
+*/
+#if defined(_MSC_VER)
+static CRITICAL_SECTION serialMutex;
+#define serialInit()     InitializeCriticalSection(&serialMutex)
+#define serialEnter()    EnterCriticalSection(&serialMutex)
+#define serialLeave()    LeaveCriticalSection(&serialMutex)
+typedef HANDLE Thread;
+static unsigned __stdcall threadProc(void*);
+#define threadStart(pT, pArg) \
+  (*(pT) = (HANDLE)_beginthreadex(0, 0, threadProc, (pArg), 0, 0))
+#define threadJoin(T)    (WaitForSingleObject((T), INFINITE), CloseHandle(T))
+static double wallTime(void){
+  LARGE_INTEGER f, t;
+  QueryPerformanceFrequency(&f);
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart / (double)f.QuadPart;
+}
+#else
+static pthread_mutex_t serialMutex = PTHREAD_MUTEX_INITIALIZER;
+#define serialInit()
+#define serialEnter()    pthread_mutex_lock(&serialMutex)
+#define serialLeave()    pthread_mutex_unlock(&serialMutex)
+typedef pthread_t Thread;
+static void *threadProc(void*);
+#define threadStart(pT, pArg) pthread_create((pT), 0, threadProc, (pArg))
+#define threadJoin(T)    pthread_join((T), 0)
+static double wallTime(void){
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return (double)tv.tv_sec + (double)tv.tv_usec/1000000.0;
+}
+#endif
+
+/*
+** The "serial" allocator.  Every call is forwarded to SQLITE4_MM_SYSTEM
+** while holding serialMutex.
+*/
+static void *serialMalloc(sqlite4_mm *pMM, sqlite4_size_t n){
+  void *p;
+  serialEnter();
+  p = sqlite4_mm_malloc(0, n);
+  serialLeave();
+  return p;
+}
+static void *serialRealloc(sqlite4_mm *pMM, void *pOld, sqlite4_size_t n){
+  void *p;
+  serialEnter();
+  p = sqlite4_mm_realloc(0, pOld, n);
+  serialLeave();
+  return p;
+}
+static void serialFree(sqlite4_mm *pMM, void *pOld){
+  serialEnter();
+  sqlite4_mm_free(0, pOld);
+  serialLeave();
+}
+static sqlite4_size_t serialMsize(sqlite4_mm *pMM, void *pOld){
+  sqlite4_size_t n;
+  serialEnter();
+  n = sqlite4_mm_msize(0, pOld);
+  serialLeave();
+  return n;
+}
+static const sqlite4_mm_methods serialMethods = {
+  1, serialMalloc, serialRealloc, serialFree, serialMsize, 0, 0, 0, 0, 0
+};
+static sqlite4_mm serialMM = { &serialMethods };
+
+/*
+** Per-thread state.
+*/
+typedef struct ThreadCtx ThreadCtx;
+struct ThreadCtx {
+  int iThread;                    /* Thread number */
+  int rc;                         /* Error code, or SQLITE4_OK */
+  sqlite4_int64 nSum;             /* Checksum of SELECT results */
+};
+
+static int execOrFail(sqlite4 *db, const char *zSql){
+  int rc = sqlite4_exec(db, zSql, 0, 0);
+  if( rc!=SQLITE4_OK ){
+    fprintf(stderr, "%s: %s\n", zSql, sqlite4_errmsg(db));
+  }
+  return rc;
+}
+
+static int runThread(ThreadCtx *pCtx){
+  sqlite4 *db = 0;
+  sqlite4_stmt *pStmt = 0;
+  char zText[64];
+  int rc;
+  int i;
+
+  rc = sqlite4_open(0, ":memory:", &db, 0);
+  if( rc==SQLITE4_OK ){
+    rc = execOrFail(db, "CREATE TABLE t1(a INTEGER PRIMARY KEY, b TEXT, c)");
+  }
+  if( rc==SQLITE4_OK ) rc = execOrFail(db, "BEGIN");
+  if( rc==SQLITE4_OK ){
+    rc = sqlite4_prepare(db, "INSERT INTO t1 VALUES(?, ?, ?)", -1, &pStmt, 0);
+  }
+  for(i=0; rc==SQLITE4_OK && i<nRow; i++){
+    int n = sprintf(zText, "thread %d row %d %x", pCtx->iThread, i, i*7919);
+    sqlite4_bind_int64(pStmt, 1, i);
+    sqlite4_bind_text(pStmt, 2, zText, n, SQLITE4_TRANSIENT, 0);
+    sqlite4_bind_double(pStmt, 3, i*0.5);
+    rc = sqlite4_step(pStmt);
+    if( rc==SQLITE4_DONE ) rc = sqlite4_reset(pStmt);
+  }
+  sqlite4_finalize(pStmt);
+  pStmt = 0;
+  if( rc==SQLITE4_OK ) rc = execOrFail(db, "COMMIT");
+
+  for(i=0; rc==SQLITE4_OK && i<nSelect; i++){
+    rc = sqlite4_prepare(db, "SELECT a, b, c FROM t1", -1, &pStmt, 0);
+    while( rc==SQLITE4_OK && sqlite4_step(pStmt)==SQLITE4_ROW ){
+      int nByte;
+      sqlite4_column_text(pStmt, 1, &nByte);
+      pCtx->nSum += sqlite4_column_int64(pStmt, 0) + nByte;
+    }
+    if( rc==SQLITE4_OK ) rc = sqlite4_finalize(pStmt);
+    pStmt = 0;
+  }
+
+  if( rc!=SQLITE4_OK && db ){
+    fprintf(stderr, "thread %d: %s\n", pCtx->iThread, sqlite4_errmsg(db));
+  }
+  sqlite4_close(db, 0);
+  return rc;
+}
+
+#if defined(_MSC_VER)
+static unsigned __stdcall threadProc(void *pArg){
+  ThreadCtx *pCtx = (ThreadCtx*)pArg;
+  pCtx->rc = runThread(pCtx);
+  return 0;
+}
+#else
+static void *threadProc(void *pArg){
+  ThreadCtx *pCtx = (ThreadCtx*)pArg;
+  pCtx->rc = runThread(pCtx);
+  return 0;
+}
+#endif
+
+static void usage(const char *zArgv0){
+  fprintf(stderr,
+      "Usage: %s ?-mm system|serial|threadcache? ?-threads N? ?-rows N?"
+      " ?-select N?\n", zArgv0
+  );
+  exit(1);
+}
+
+int main(int argc, char **argv){
+  const char *zMM = "threadcache";
+  sqlite4_mm *pMM = 0;
+  int nThread = 4;
+  ThreadCtx *aCtx;
+  Thread *aThread;
+  double tStart, tElapsed;
+  sqlite4_int64 nSum = 0;
+  int rc = 0;
+  int i;
+
+  for(i=1; i<argc; i++){
+    if( i+1>=argc ) usage(argv[0]);
+    if( strcmp(argv[i], "-mm")==0 ){
+      zMM = argv[++i];
+    }else if( strcmp(argv[i], "-threads")==0 ){
+      nThread = atoi(argv[++i]);
+    }else if( strcmp(argv[i], "-rows")==0 ){
+      nRow = atoi(argv[++i]);
+    }else if( strcmp(argv[i], "-select")==0 ){
+      nSelect = atoi(argv[++i]);
+    }else{
+      usage(argv[0]);
+    }
+  }
+  if( nThread<1 ) usage(argv[0]);
+
+  if( strcmp(zMM, "system")==0 ){
+    pMM = sqlite4_mm_new(SQLITE4_MM_SYSTEM);
+  }else if( strcmp(zMM, "serial")==0 ){
+    serialInit();
+    pMM = &serialMM;
+  }else if( strcmp(zMM, "threadcache")==0 ){
+    pMM = sqlite4_mm_new(SQLITE4_MM_THREADCACHE, (sqlite4_mm*)0);
+  }else{
+    usage(argv[0]);
+  }
+  if( pMM==0 || sqlite4_env_config(0, SQLITE4_ENVCONFIG_SETMM, pMM) ){
+    fprintf(stderr, "cannot install allocator \"%s\"\n", zMM);
+    return 1;
+  }
+
+  aCtx = (ThreadCtx*)calloc(nThread, sizeof(ThreadCtx));
+  aThread = (Thread*)calloc(nThread, sizeof(Thread));
+  tStart = wallTime();
+  for(i=0; i<nThread; i++){
+    aCtx[i].iThread = i;
+    threadStart(&aThread[i], &aCtx[i]);
+  }
+  for(i=0; i<nThread; i++){
+    threadJoin(aThread[i]);
+    if( aCtx[i].rc!=SQLITE4_OK ) rc = 1;
+    nSum += aCtx[i].nSum;
+  }
+  tElapsed = wallTime() - tStart;
+
+  printf("mm=%s threads=%d rows=%d select=%d: %.3f s (checksum %lld)\n",
+      zMM, nThread, nRow, nSelect, tElapsed, (long long)nSum
+  );
+  free(aCtx);
+  free(aThread);
+  return rc;
+}
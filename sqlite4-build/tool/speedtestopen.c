@@ -0,0 +1,213 @@
+/*
+** Multi-threaded connection open latency test for SQLite.
+**
+** For each thread count in a list (by default 1, 2, 4, 8, 16, 32 and
+** 64), that many threads each open and close a database connection a
+** number of times.  The connections use a plugin-style KVStore factory
+** named "bench", which is pushed onto the factory stack underneath a
+** number of unrelated factories so that the lookup in
+** sqlite4KVStoreOpen() walks a realistic registry.  The "bench" factory
+** forwards to the built-in in-memory store.
+**
+** For each thread count the total open rate and the median, 99th
+** percentile and maximum latency of sqlite4_open() are reported.
+**
+** To compile, first build the library, then:
+**
+**     gcc -O2 speedtestopen.c libsqlite4.a -I. -lpthread -lm -ldl
+**
+** Then run:
+**
+**     ./a.out ?-threads N,N,...? ?-opens N? ?-factories N?
+*/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#include <sys/time.h>
+#endif
+
+#include "sqlite4.h"
+
+static int nOpen = 2000;          /* Opens performed by each thread */
+static int nFactory = 8;          /* Unrelated factories above "bench" */
+static sqlite4_kvfactory xMemFactory;
+
+/*
+** Portable thread and wall-clock helpers.
+*/
+#if defined(_MSC_VER)
+typedef HANDLE Thread;
+static unsigned __stdcall threadProc(void*);
+#define threadStart(pT, pArg) \
+  (*(pT) = (HANDLE)_beginthreadex(0, 0, threadProc, (pArg), 0, 0))
+#define threadJoin(T)    (WaitForSingleObject((T), INFINITE), CloseHandle(T))
+static double wallTime(void){
+  LARGE_INTEGER f, t;
+  QueryPerformanceFrequency(&f);
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart / (double)f.QuadPart;
+}
+#else
+typedef pthread_t Thread;
+static void *threadProc(void*);
+#define threadStart(pT, pArg) pthread_create((pT), 0, threadProc, (pArg))
+#define threadJoin(T)    pthread_join((T), 0)
+static double wallTime(void){
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return (double)tv.tv_sec + (double)tv.tv_usec/1000000.0;
+}
+#endif
+
+/*
+** The "bench" factory.
+*/
+static int benchFactory(
+  sqlite4_env *pEnv,
+  sqlite4_kvstore **ppKVStore,
+  const char *zName,
+  unsigned flags
+){
+  return xMemFactory(pEnv, ppKVStore, zName, flags);
+}
+
+/*
+** Per-thread state.
+*/
+typedef struct ThreadCtx ThreadCtx;
+struct ThreadCtx {
+  int iThread;                    /* Thread number */
+  int rc;                         /* Error code, or SQLITE4_OK */
+  double *aLatency;               /* OUT: Latency of each open in seconds */
+};
+
+static int runThread(ThreadCtx *pCtx){
+  int rc = SQLITE4_OK;
+  int i;
+  for(i=0; rc==SQLITE4_OK && i<nOpen; i++){
+    sqlite4 *db = 0;
+    double t = wallTime();
+    rc = sqlite4_open(0, "file:bench?kv=bench", &db, 0);
+    pCtx->aLatency[i] = wallTime() - t;
+    if( rc!=SQLITE4_OK ){
+      fprintf(stderr, "thread %d: open failed (%d)\n", pCtx->iThread, rc);
+    }
+    sqlite4_close(db, 0);
+  }
+  return rc;
+}
+
+#if defined(_MSC_VER)
+static unsigned __stdcall threadProc(void *pArg){
+  ThreadCtx *pCtx = (ThreadCtx*)pArg;
+  pCtx->rc = runThread(pCtx);
+  return 0;
+}
+#else
+static void *threadProc(void *pArg){
+  ThreadCtx *pCtx = (ThreadCtx*)pArg;
+  pCtx->rc = runThread(pCtx);
+  return 0;
+}
+#endif
+
+static int cmpDouble(const void *a, const void *b){
+  double x = *(const double*)a;
+  double y = *(const double*)b;
+  return x<y ? -1 : x>y;
+}
+
+/*
+** Run one round with nThread threads.  Return non-zero on error.
+*/
+static int runRound(int nThread){
+  ThreadCtx *aCtx;
+  Thread *aThread;
+  double *aLatency;
+  double tStart, tElapsed;
+  int nTotal = nThread*nOpen;
+  int rc = 0;
+  int i;
+
+  aCtx = (ThreadCtx*)calloc(nThread, sizeof(ThreadCtx));
+  aThread = (Thread*)calloc(nThread, sizeof(Thread));
+  aLatency = (double*)calloc(nTotal, sizeof(double));
+  tStart = wallTime();
+  for(i=0; i<nThread; i++){
+    aCtx[i].iThread = i;
+    aCtx[i].aLatency = &aLatency[i*nOpen];
+    threadStart(&aThread[i], &aCtx[i]);
+  }
+  for(i=0; i<nThread; i++){
+    threadJoin(aThread[i]);
+    if( aCtx[i].rc!=SQLITE4_OK ) rc = 1;
+  }
+  tElapsed = wallTime() - tStart;
+
+  qsort(aLatency, nTotal, sizeof(double), cmpDouble);
+  printf("threads=%-3d opens=%-7d %9.0f opens/s"
+         "  p50=%7.1fus p99=%8.1fus max=%9.1fus\n",
+      nThread, nTotal, nTotal/tElapsed,
+      aLatency[nTotal/2]*1e6, aLatency[(int)(nTotal*0.99)]*1e6,
+      aLatency[nTotal-1]*1e6
+  );
+  free(aCtx);
+  free(aThread);
+  free(aLatency);
+  return rc;
+}
+
+static void usage(const char *zArgv0){
+  fprintf(stderr,
+      "Usage: %s ?-threads N,N,...? ?-opens N? ?-factories N?\n", zArgv0
+  );
+  exit(1);
+}
+
+int main(int argc, char **argv){
+  const char *zThreads = "1,2,4,8,16,32,64";
+  const char *z;
+  int rc = 0;
+  int i;
+
+  for(i=1; i<argc; i++){
+    if( i+1>=argc ) usage(argv[0]);
+    if( strcmp(argv[i], "-threads")==0 ){
+      zThreads = argv[++i];
+    }else if( strcmp(argv[i], "-opens")==0 ){
+      nOpen = atoi(argv[++i]);
+    }else if( strcmp(argv[i], "-factories")==0 ){
+      nFactory = atoi(argv[++i]);
+    }else{
+      usage(argv[0]);
+    }
+  }
+  if( nOpen<1 ) usage(argv[0]);
+
+  sqlite4_env_config(0, SQLITE4_ENVCONFIG_KVSTORE_GET, "temp", &xMemFactory);
+  if( xMemFactory==0 ){
+    fprintf(stderr, "cannot find the \"temp\" factory\n");
+    return 1;
+  }
+  sqlite4_env_config(0, SQLITE4_ENVCONFIG_KVSTORE_PUSH, "bench", benchFactory);
+  for(i=0; i<nFactory; i++){
+    char zName[32];
+    sprintf(zName, "unused%d", i);
+    sqlite4_env_config(0, SQLITE4_ENVCONFIG_KVSTORE_PUSH, zName, benchFactory);
+  }
+
+  for(z=zThreads; rc==0 && *z; ){
+    int nThread = atoi(z);
+    if( nThread<1 ) usage(argv[0]);
+    rc = runRound(nThread);
+    while( *z && *z!=',' ) z++;
+    if( *z==',' ) z++;
+  }
+  return rc;
+}
@@ -0,0 +1,141 @@
+/*
+** RowSet performance test for SQLite.
+**
+** A table with an INTEGER PRIMARY KEY and two indexed columns is filled
+** with a number of rows (by default 2,000,000). The following statements
+** are then timed. Each pushes most of the table's keys through a RowSet:
+**
+**   1. SELECT count(*) FROM t WHERE b<? OR c<?
+**      The OR is evaluated by scanning both indexes. The key of each
+**      row found is tested against, and added to, a RowSet
+**      (OP_RowSetTest) so that rows matching both terms are counted
+**      once.
+**
+**   2. UPDATE t SET d=d+1 WHERE b<?
+**      The keys of the rows to update are collected in a RowSet
+**      (OP_RowSetAdd) and then read back in sorted order
+**      (OP_RowSetRead).
+**
+**   3. DELETE FROM t WHERE c<?
+**      As for UPDATE.
+**
+** The ? values are chosen so that each statement visits roughly 3/4 of
+** the rows. The b and c values are random, so the keys arrive at the
+** RowSet in random order.
+**
+** To compile, first build the library, then:
+**
+**     gcc -O2 speedtestrowset.c libsqlite4.a -I. -lpthread -lm -ldl
+**
+** Then run:
+**
+**     ./a.out ?-rows N?
+*/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include "sqlite4.h"
+
+static double wallTime(void){
+#if defined(_MSC_VER)
+  LARGE_INTEGER f, t;
+  QueryPerformanceFrequency(&f);
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart / (double)f.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return (double)tv.tv_sec + (double)tv.tv_usec/1000000.0;
+#endif
+}
+
+static void fatal(sqlite4 *db, const char *zSql){
+  fprintf(stderr, "%s: %s\n", zSql, sqlite4_errmsg(db));
+  exit(1);
+}
+
+/*
+** Run zSql, which must return at most one row with a single integer
+** column, and print the time taken and the result.
+*/
+static void timeSql(sqlite4 *db, const char *zSql){
+  sqlite4_stmt *pStmt;
+  sqlite4_int64 iRes = 0;
+  double t;
+  int rc;
+
+  if( sqlite4_prepare(db, zSql, -1, &pStmt, 0) ) fatal(db, zSql);
+  t = wallTime();
+  while( (rc = sqlite4_step(pStmt))==SQLITE4_ROW ){
+    iRes = sqlite4_column_int64(pStmt, 0);
+  }
+  t = wallTime() - t;
+  if( rc!=SQLITE4_DONE ) fatal(db, zSql);
+  sqlite4_finalize(pStmt);
+  printf("%8.3fs  %-48s %lld\n", t, zSql, iRes);
+}
+
+static void usage(const char *zArgv0){
+  fprintf(stderr, "Usage: %s ?-rows N?\n", zArgv0);
+  exit(1);
+}
+
+int main(int argc, char **argv){
+  sqlite4 *db;
+  sqlite4_stmt *pIns;
+  int nRow = 2000000;
+  int nLimit;
+  char zSql[128];
+  double t;
+  int i;
+
+  for(i=1; i<argc; i++){
+    if( i+1>=argc ) usage(argv[0]);
+    if( strcmp(argv[i], "-rows")==0 ){
+      nRow = atoi(argv[++i]);
+    }else{
+      usage(argv[0]);
+    }
+  }
+  if( nRow<1 ) usage(argv[0]);
+  nLimit = nRow/2;
+
+  if( sqlite4_open(0, "file:rowset?kv=temp", &db, 0) ) return 1;
+  t = wallTime();
+  sqlite4_exec(db, "CREATE TABLE t(a INTEGER PRIMARY KEY, b, c, d);"
+                   "BEGIN", 0, 0);
+  if( sqlite4_prepare(db, "INSERT INTO t VALUES(?, ?, ?, 0)", -1, &pIns, 0) ){
+    fatal(db, "INSERT");
+  }
+  srand(1);
+  for(i=1; i<=nRow; i++){
+    sqlite4_bind_int(pIns, 1, i);
+    sqlite4_bind_int(pIns, 2, rand() % nRow);
+    sqlite4_bind_int(pIns, 3, rand() % nRow);
+    sqlite4_step(pIns);
+    sqlite4_reset(pIns);
+  }
+  sqlite4_finalize(pIns);
+  sqlite4_exec(db, "COMMIT;"
+                   "CREATE INDEX tb ON t(b);"
+                   "CREATE INDEX tc ON t(c)", 0, 0);
+  printf("%8.3fs  populate %d rows\n", wallTime() - t, nRow);
+
+  sprintf(zSql, "SELECT count(*) FROM t WHERE b<%d OR c<%d", nLimit, nLimit);
+  timeSql(db, zSql);
+  sprintf(zSql, "UPDATE t SET d=d+1 WHERE b<%d", nRow/4*3);
+  timeSql(db, zSql);
+  sprintf(zSql, "DELETE FROM t WHERE c<%d", nRow/4*3);
+  timeSql(db, zSql);
+  timeSql(db, "SELECT count(*) FROM t");
+
+  sqlite4_close(db, 0);
+  return 0;
+}
@@ -0,0 +1,138 @@
+/*
+** Virtual machine dispatch speed test for SQLite.
+**
+** A table of rows is created in an in-memory database and a set of
+** queries is run over it many times. Each query is a full scan chosen so
+** that most of its time goes to dispatching and running simple opcodes
+** (Column, comparisons, arithmetic, ResultRow and Next) rather than to
+** the storage engine or to sorting. For each query the time taken and
+** the number of rows scanned per second are reported.
+**
+** To measure the effect of computed-goto dispatch, build the library
+** twice: normally and with -DSQLITE4_OMIT_COMPUTED_GOTO. Link this
+** program against each and compare the results.
+**
+** To compile, first build the library, then:
+**
+**     gcc -O2 speedtestvdbe.c libsqlite4.a -I. -lpthread -lm -ldl
+**
+** Then run:
+**
+**     ./a.out ?-rows N? ?-repeat N?
+*/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include "sqlite4.h"
+
+static int nRow = 100000;         /* Rows in the table */
+static int nRepeat = 20;          /* Times each query is run */
+
+/*
+** The queries. Each scans the whole table.
+*/
+static const char *azQuery[] = {
+  /* Column -> ResultRow */
+  "SELECT a, b, c, d FROM t",
+  /* Column -> comparison, no rows returned */
+  "SELECT a FROM t WHERE b<0",
+  /* Column -> comparison -> Column -> comparison */
+  "SELECT a FROM t WHERE b>=0 AND c<0",
+  /* Column -> arithmetic -> ResultRow */
+  "SELECT a+b*c-d FROM t",
+  /* Column -> comparison -> Column -> ResultRow, about half the rows */
+  "SELECT b, c FROM t WHERE d>c",
+};
+
+static double wallTime(void){
+#if defined(_MSC_VER)
+  LARGE_INTEGER f, t;
+  QueryPerformanceFrequency(&f);
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart / (double)f.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return (double)tv.tv_sec + (double)tv.tv_usec/1000000.0;
+#endif
+}
+
+static void fatal(const char *zMsg, int rc){
+  fprintf(stderr, "%s failed (%d)\n", zMsg, rc);
+  exit(1);
+}
+
+static void usage(const char *zArgv0){
+  fprintf(stderr, "Usage: %s ?-rows N? ?-repeat N?\n", zArgv0);
+  exit(1);
+}
+
+int main(int argc, char **argv){
+  sqlite4 *db;
+  sqlite4_stmt *pStmt;
+  double tTotal = 0.0;
+  int i, j;
+  int rc;
+
+  for(i=1; i<argc; i++){
+    if( i+1>=argc ) usage(argv[0]);
+    if( strcmp(argv[i], "-rows")==0 ){
+      nRow = atoi(argv[++i]);
+    }else if( strcmp(argv[i], "-repeat")==0 ){
+      nRepeat = atoi(argv[++i]);
+    }else{
+      usage(argv[0]);
+    }
+  }
+  if( nRow<1 || nRepeat<1 ) usage(argv[0]);
+
+  rc = sqlite4_open(0, "file:vdbe?kv=temp", &db, 0);
+  if( rc ) fatal("sqlite4_open", rc);
+  rc = sqlite4_exec(db,
+      "CREATE TABLE t(a PRIMARY KEY, b, c, d); BEGIN", 0, 0
+  );
+  if( rc ) fatal("CREATE TABLE", rc);
+  rc = sqlite4_prepare(db, "INSERT INTO t VALUES(?, ?, ?, ?)", -1, &pStmt, 0);
+  if( rc ) fatal("sqlite4_prepare", rc);
+  for(i=0; i<nRow; i++){
+    sqlite4_bind_int(pStmt, 1, i);
+    sqlite4_bind_int(pStmt, 2, i % 1000);
+    sqlite4_bind_int(pStmt, 3, (i * 7) % 1000);
+    sqlite4_bind_int(pStmt, 4, (i * 13) % 1000);
+    sqlite4_step(pStmt);
+    sqlite4_reset(pStmt);
+  }
+  sqlite4_finalize(pStmt);
+  rc = sqlite4_exec(db, "COMMIT", 0, 0);
+  if( rc ) fatal("COMMIT", rc);
+
+  for(i=0; i<(int)(sizeof(azQuery)/sizeof(azQuery[0])); i++){
+    double t;
+    int nOut = 0;
+    rc = sqlite4_prepare(db, azQuery[i], -1, &pStmt, 0);
+    if( rc ) fatal("sqlite4_prepare", rc);
+    t = wallTime();
+    for(j=0; j<nRepeat; j++){
+      while( sqlite4_step(pStmt)==SQLITE4_ROW ) nOut++;
+      rc = sqlite4_reset(pStmt);
+      if( rc ) fatal("sqlite4_step", rc);
+    }
+    t = wallTime() - t;
+    tTotal += t;
+    printf("%-40s %8.3fs %12.0f rows/s  (%d out)\n",
+        azQuery[i], t, (double)nRow*nRepeat/t, nOut/nRepeat
+    );
+    sqlite4_finalize(pStmt);
+  }
+  printf("%-40s %8.3fs\n", "TOTAL", tTotal);
+
+  sqlite4_close(db, 0);
+  return 0;
+}